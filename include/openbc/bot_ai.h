@@ -0,0 +1,156 @@
+#ifndef OPENBC_BOT_AI_H
+#define OPENBC_BOT_AI_H
+
+#include "openbc/types.h"
+#include "openbc/opcodes.h"
+#include "openbc/ship_data.h"
+#include "openbc/ship_state.h"
+
+/*
+ * Time-sliced AI for server-owned ships (bot fill / PvE).
+ *
+ * Each tick is split in two phases:
+ *
+ *   think  -- target selection, state changes and weapon fire. Bots that
+ *             are due (every think_interval ticks, or at once when their
+ *             target dies) join a FIFO work queue; the tick drains it
+ *             until max_decisions or budget_us is hit and leaves the rest
+ *             for the next tick.
+ *   act    -- every bot, every tick: steer toward the target's live
+ *             position with bc_ship_turn_toward / bc_ship_set_speed.
+ *             O(bots), no searches.
+ *
+ * Perception is a cached contact list (position, team, visibility)
+ * rebuilt every perceive_interval ticks, so a decision is one linear
+ * scan over a compact array instead of a walk over live ship state.
+ *
+ * The module owns no ships: callers register bc_ship_state_t pointers
+ * (bots and other contacts) and keep them alive while registered.
+ * Weapon fire is reported through a callback carrying the packet built
+ * by bc_combat_fire_phaser / bc_combat_fire_torpedo; relaying it and
+ * applying damage is the caller's job, exactly as for client fire.
+ */
+
+#define BC_BOT_MAX           32
+#define BC_BOT_MAX_CONTACTS  (BC_MAX_PLAYERS + BC_BOT_MAX)
+
+/* Bot behaviour states (mirrors the seeded battle AI in the tests) */
+#define BC_BOT_IDLE      0   /* no hostile contact: hold position */
+#define BC_BOT_APPROACH  1   /* close to weapons range at full speed */
+#define BC_BOT_ENGAGE    2   /* in range: slow down and fire */
+#define BC_BOT_EVADE     3   /* shields low: run until they recover */
+
+typedef struct {
+    int  think_interval;     /* ticks between decisions per bot (>= 1)     */
+    int  perceive_interval;  /* ticks between contact cache rebuilds       */
+    int  max_decisions;      /* decisions per tick (0 = unlimited)         */
+    u32  budget_us;          /* think time per tick (0 = decisions cap only) */
+    f32  engage_range;       /* enter ENGAGE / fire phasers inside this    */
+    f32  torpedo_range;      /* fire torpedoes inside this                 */
+    f32  evade_shield_frac;  /* EVADE below this fraction of max shields   */
+    f32  resume_shield_frac; /* back to APPROACH above this                */
+} bc_bot_cfg_t;
+
+/* Defaults: a 30 Hz server re-plans each bot 6x per second and spends at
+ * most 2 ms per tick thinking (6% of the 33 ms tick). */
+#define BC_BOT_DEFAULT_THINK_INTERVAL    5
+#define BC_BOT_DEFAULT_PERCEIVE_INTERVAL 3
+#define BC_BOT_DEFAULT_MAX_DECISIONS     8
+#define BC_BOT_DEFAULT_BUDGET_US         2000
+#define BC_BOT_DEFAULT_ENGAGE_RANGE      80.0f
+#define BC_BOT_DEFAULT_TORPEDO_RANGE     150.0f
+#define BC_BOT_DEFAULT_EVADE_FRAC        0.25f
+#define BC_BOT_DEFAULT_RESUME_FRAC       0.5f
+
+typedef struct {
+    bc_ship_state_t       *ship;
+    const bc_ship_class_t *cls;
+    u8         state;         /* BC_BOT_* */
+    const bc_ship_state_t *target;  /* registered contact, NULL = none */
+    f32        target_dist;   /* distance at the last decision */
+    f32        speed_frac;    /* of cls->max_speed, applied by act */
+    u32        next_think;    /* tick at which the bot is queued again */
+    bool       queued;
+} bc_bot_t;
+
+/* One cached contact (rebuilt by perception, read by decisions) */
+typedef struct {
+    const bc_ship_state_t *ship;
+    bc_vec3_t  pos;
+    i32        object_id;
+    u8         team_id;
+    bool       targetable;    /* alive and not fully cloaked */
+} bc_bot_contact_t;
+
+typedef struct {
+    u32  ticks;
+    u32  decisions;           /* total decisions run */
+    u32  deferred;            /* total bot-ticks left in the queue at tick end */
+    u32  perceptions;         /* contact cache rebuilds */
+    u32  phasers_fired;
+    u32  torpedoes_fired;
+    u32  tick_us_last;        /* act + think time of the last tick */
+    u32  tick_us_max;
+    u64  tick_us_total;
+} bc_bot_stats_t;
+
+/* Fire notification: pkt is the BeamFire / TorpedoFire message. */
+typedef void (*bc_bot_fire_fn)(void *user, int bot,
+                               const bc_ship_state_t *target,
+                               bool torpedo, const u8 *pkt, int len);
+
+/* Microsecond clock; tests inject a fake one to exercise the budget. */
+typedef u32 (*bc_bot_clock_fn)(void);
+
+typedef struct {
+    bc_bot_cfg_t     cfg;
+    bc_bot_t         bots[BC_BOT_MAX];
+    int              bot_count;
+
+    /* Registered contacts (bots included) and their cached snapshot */
+    const bc_ship_state_t *contact_ships[BC_BOT_MAX_CONTACTS];
+    int              contact_count;
+    bc_bot_contact_t cache[BC_BOT_MAX_CONTACTS];
+    int              cache_count;
+    bool             cache_stale;   /* contact set changed since rebuild */
+    u32              cache_tick;    /* tick of the last rebuild */
+
+    /* Think queue (ring of bot indices) */
+    u8               queue[BC_BOT_MAX];
+    int              queue_head;
+    int              queue_len;
+
+    u32              tick;
+    bc_bot_fire_fn   on_fire;
+    void            *fire_user;
+    bc_bot_clock_fn  clock_us;
+    bc_bot_stats_t   stats;
+} bc_bot_world_t;
+
+/* Fill cfg with the defaults above. */
+void bc_bot_cfg_defaults(bc_bot_cfg_t *cfg);
+
+/* Reset the world (no bots, no contacts, zero stats). cfg may be NULL
+ * for defaults. Uses bc_us_now unless clock_us is replaced afterwards. */
+void bc_bot_world_init(bc_bot_world_t *w, const bc_bot_cfg_t *cfg);
+
+/* Register a non-bot contact (e.g. a player's ship). Returns false if
+ * the table is full; re-registering is a no-op. */
+bool bc_bot_add_contact(bc_bot_world_t *w, const bc_ship_state_t *ship);
+
+/* Forget a contact. Bots targeting it drop it and re-plan next tick. */
+void bc_bot_remove_contact(bc_bot_world_t *w, const bc_ship_state_t *ship);
+
+/* Hand a ship to the AI (also registers it as a contact). First
+ * decisions are staggered across think_interval ticks.
+ * Returns the bot index, or -1 if full. */
+int bc_bot_add(bc_bot_world_t *w, bc_ship_state_t *ship,
+               const bc_ship_class_t *cls);
+
+/* Release a bot (swap-remove: the last bot takes its index). */
+void bc_bot_remove(bc_bot_world_t *w, int bot);
+
+/* Run one tick: think within the budget, then act for every bot. */
+void bc_bot_world_tick(bc_bot_world_t *w, f32 dt);
+
+#endif /* OPENBC_BOT_AI_H */
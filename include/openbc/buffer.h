@@ -3,6 +3,8 @@
 
 #include "openbc/types.h"
 
+#include <string.h>
+
 /*
  * TGBufferStream equivalent -- position-tracked byte buffer.
  *
@@ -47,6 +49,59 @@ bool bc_buf_write_f32(bc_buffer_t *buf, f32 val);
 bool bc_buf_write_bytes(bc_buffer_t *buf, const u8 *src, size_t len);
 bool bc_buf_write_bit(bc_buffer_t *buf, bool val);
 
+/* --- Reserve-then-write fast path ---
+ *
+ * For messages whose size is known up front: bc_buf_reserve checks room
+ * for the whole message once, then the bc_buf_put_* stores write without
+ * further checks. Puts must stay within what was reserved. Like the
+ * checked writes, they leave the WriteBit group state alone.
+ */
+static inline bool bc_buf_reserve(const bc_buffer_t *buf, size_t len)
+{
+    return buf->pos <= buf->capacity && len <= buf->capacity - buf->pos;
+}
+
+static inline void bc_buf_put_u8(bc_buffer_t *buf, u8 val)
+{
+    buf->data[buf->pos++] = val;
+}
+
+static inline void bc_buf_put_u16(bc_buffer_t *buf, u16 val)
+{
+    u8 *p = buf->data + buf->pos;
+    p[0] = (u8)val;
+    p[1] = (u8)(val >> 8);
+    buf->pos += 2;
+}
+
+static inline void bc_buf_put_u32(bc_buffer_t *buf, u32 val)
+{
+    u8 *p = buf->data + buf->pos;
+    p[0] = (u8)val;
+    p[1] = (u8)(val >> 8);
+    p[2] = (u8)(val >> 16);
+    p[3] = (u8)(val >> 24);
+    buf->pos += 4;
+}
+
+static inline void bc_buf_put_i32(bc_buffer_t *buf, i32 val)
+{
+    bc_buf_put_u32(buf, (u32)val);
+}
+
+static inline void bc_buf_put_f32(bc_buffer_t *buf, f32 val)
+{
+    u32 bits;
+    memcpy(&bits, &val, 4);
+    bc_buf_put_u32(buf, bits);
+}
+
+static inline void bc_buf_put_bytes(bc_buffer_t *buf, const u8 *src, size_t len)
+{
+    memcpy(buf->data + buf->pos, src, len);
+    buf->pos += len;
+}
+
 /* --- Read primitives --- */
 bool bc_buf_read_u8(bc_buffer_t *buf, u8 *out);
 bool bc_buf_read_u16(bc_buffer_t *buf, u16 *out);
@@ -72,10 +127,16 @@ bool bc_buf_read_bit(bc_buffer_t *buf, bool *out);
  *   Used for: position deltas, impact positions.
  */
 
-/* Encode/decode a float to/from 16-bit logarithmic format */
+/* Encode/decode a float to/from 16-bit logarithmic format. Decode reads
+ * a 128 KB magnitude table built on first use; encode is a fixed set of
+ * compares. Both are bit-exact with the original threshold walk. */
 u16 bc_cf16_encode(f32 value);
 f32 bc_cf16_decode(u16 encoded);
 
+/* The same over arrays: out[i] = encode/decode(in[i]) */
+void bc_cf16_encode_many(const f32 *values, u16 *out, size_t count);
+void bc_cf16_decode_many(const u16 *encoded, f32 *out, size_t count);
+
 /* Write/read CompressedFloat16 to/from buffer */
 bool bc_buf_write_cf16(bc_buffer_t *buf, f32 value);
 bool bc_buf_read_cf16(bc_buffer_t *buf, f32 *out);
@@ -88,4 +149,14 @@ bool bc_buf_read_cv3(bc_buffer_t *buf, f32 *x, f32 *y, f32 *z);
 bool bc_buf_write_cv4(bc_buffer_t *buf, f32 x, f32 y, f32 z);
 bool bc_buf_read_cv4(bc_buffer_t *buf, f32 *x, f32 *y, f32 *z);
 
+/* Unchecked stores for reserved room (see bc_buf_reserve): 2, 3, 5 bytes */
+void bc_buf_put_cf16(bc_buffer_t *buf, f32 value);
+void bc_buf_put_cv3(bc_buffer_t *buf, f32 x, f32 y, f32 z);
+void bc_buf_put_cv4(bc_buffer_t *buf, f32 x, f32 y, f32 z);
+
+/* count CV4s from/to packed xyz triples (3 * count floats). Room is checked
+ * once for the whole run: nothing is written or consumed if it falls short. */
+bool bc_buf_write_cv4_many(bc_buffer_t *buf, const f32 *xyz, size_t count);
+bool bc_buf_read_cv4_many(bc_buffer_t *buf, f32 *xyz, size_t count);
+
 #endif /* OPENBC_BUFFER_H */
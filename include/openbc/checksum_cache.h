@@ -0,0 +1,71 @@
+#ifndef OPENBC_CHECKSUM_CACHE_H
+#define OPENBC_CHECKSUM_CACHE_H
+
+#include "openbc/types.h"
+#include "openbc/sha256.h"
+
+/*
+ * Memo of checksum responses that already passed validation.
+ *
+ * Every client installed from the same media sends byte-identical 0x21
+ * responses, so after the first join each round is a repeat. The cache
+ * remembers accepted payloads by SHA-256 of (round index, payload bytes);
+ * a hit lets the handshake skip parsing and the manifest walk entirely.
+ * Only accepted responses are stored -- failures always take the full
+ * path, so a hit can never let a mismatched install through.
+ *
+ * Capacity is fixed at init; when full the least recently used entry is
+ * replaced. Entries are only valid against the manifest they were checked
+ * against: call bc_checksum_cache_clear whenever the manifest changes.
+ */
+
+#define BC_CSCACHE_DEFAULT_ENTRIES  64
+#define BC_CSCACHE_MAX_ENTRIES    4096
+
+typedef struct {
+    u8  key[BC_SHA256_SIZE];
+    i32 lru_prev;     /* toward most recently used; -1 at head */
+    i32 lru_next;     /* toward least recently used; -1 at tail */
+    i32 chain;        /* next entry in the same bucket; -1 ends */
+} bc_cscache_entry_t;
+
+typedef struct {
+    bc_cscache_entry_t *entries;   /* capacity slots, first count in use */
+    i32 *buckets;                  /* bucket_mask + 1 chain heads */
+    int  capacity;                 /* 0 = disabled */
+    int  count;
+    u32  bucket_mask;
+    i32  lru_head;                 /* most recently used */
+    i32  lru_tail;                 /* least recently used, evicted first */
+    u32  hits;
+    u32  misses;
+    u32  evictions;
+} bc_checksum_cache_t;
+
+/* Allocate room for capacity entries (clamped to BC_CSCACHE_MAX_ENTRIES).
+ * capacity <= 0 yields a disabled cache that never hits. Returns false on
+ * allocation failure, leaving the cache disabled. */
+bool bc_checksum_cache_init(bc_checksum_cache_t *c, int capacity);
+void bc_checksum_cache_free(bc_checksum_cache_t *c);
+
+/* Drop every entry (manifest changed). Counters are kept. */
+void bc_checksum_cache_clear(bc_checksum_cache_t *c);
+
+static inline bool bc_checksum_cache_enabled(const bc_checksum_cache_t *c)
+{
+    return c->capacity > 0;
+}
+
+/* Cache key for one response: round is 0..3 or 0xFF for the final round. */
+void bc_checksum_cache_key(u8 round, const u8 *payload, int len,
+                           u8 key[BC_SHA256_SIZE]);
+
+/* True if key was stored; a hit becomes the most recently used entry. */
+bool bc_checksum_cache_lookup(bc_checksum_cache_t *c,
+                              const u8 key[BC_SHA256_SIZE]);
+
+/* Remember key as validated, evicting the LRU entry when full. */
+void bc_checksum_cache_insert(bc_checksum_cache_t *c,
+                              const u8 key[BC_SHA256_SIZE]);
+
+#endif /* OPENBC_CHECKSUM_CACHE_H */
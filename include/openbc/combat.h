@@ -189,4 +189,52 @@ void bc_repair_tick(bc_ship_state_t *ship,
 void bc_repair_auto_queue(bc_ship_state_t *ship,
                            const bc_ship_class_t *cls);
 
+/* --- Kernel table --- */
+
+/* The server calls damage, shield recharge and repair through a table of
+ * these, so a module can install different rules once at load instead of
+ * undoing the built-in results from event handlers. Signatures match the
+ * built-in functions above. */
+typedef void (*bc_damage_fn)(bc_ship_state_t *target,
+                             const bc_ship_class_t *cls,
+                             f32 damage, f32 damage_radius,
+                             bc_vec3_t impact_dir,
+                             bool area_effect,
+                             f32 search_radius);
+typedef void (*bc_shield_tick_fn)(bc_ship_state_t *ship,
+                                  const bc_ship_class_t *cls,
+                                  f32 power_level, f32 dt);
+typedef void (*bc_repair_tick_fn)(bc_ship_state_t *ship,
+                                  const bc_ship_class_t *cls,
+                                  f32 dt);
+
+typedef struct {
+    bc_damage_fn       apply_damage;
+    bc_shield_tick_fn  shield_tick;
+    bc_repair_tick_fn  repair_tick;
+} bc_combat_kernels_t;
+
+/* bc_combat_apply_damage, bc_combat_shield_tick, bc_repair_tick */
+extern const bc_combat_kernels_t bc_combat_default_kernels;
+
+/* The HP a kernel call can move, saved before calling a replacement kernel
+ * so the engine can journal what it did if it did not record it itself. */
+typedef struct {
+    f32  hull_hp;
+    f32  shield_hp[BC_MAX_SHIELD_FACINGS];
+    f32  subsystem_hp[BC_MAX_SUBSYSTEMS];
+    bool alive;
+    u8   event_count;            /* journal events before the call */
+    u8   events_dropped;
+} bc_combat_health_t;
+
+void bc_combat_health_save(bc_combat_health_t *h, const bc_ship_state_t *ship);
+
+/* Journal every difference between `before` and the ship now, as the
+ * built-in kernels would have. Change bits are merged (a kernel that
+ * journaled loses nothing); events are only added if the kernel recorded
+ * none, so a journaling kernel's events are not doubled. */
+void bc_combat_journal_diff(bc_ship_state_t *ship, const bc_ship_class_t *cls,
+                            const bc_combat_health_t *before);
+
 #endif /* OPENBC_COMBAT_H */
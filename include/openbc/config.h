@@ -63,6 +63,10 @@ typedef struct {
     /* [data] */
     char registry[256];       /* Ship data directory; empty = auto-detect */
     char manifest_path[256];  /* Hash manifest JSON; empty = auto-detect */
+    char registry_cache[256]; /* Compiled registry cache file; empty = off */
+    int  checksum_cache;      /* Validated checksum responses kept; 0 = off */
+    bool live_reload;         /* Reload registry/manifest when they change */
+    int  reload_poll;         /* Seconds between change scans; 0 = events only */
     char mod_packs[OBC_CFG_MOD_PACKS_MAX][256];
     int  mod_pack_count;
 
@@ -75,6 +79,24 @@ typedef struct {
     /* [master] */
     int heartbeat_interval;   /* Seconds */
 
+    /* [interest] -- unreliable StateUpdate relay thinning */
+    bool   interest_enabled;
+    double interest_near;     /* Game units; full update rate inside */
+    double interest_far;      /* Game units; min_rate at or beyond */
+    double interest_min_rate; /* 0..1 fraction of updates relayed when far/cloaked */
+
+    /* [jobs] -- background worker pool for module jobs */
+    int job_workers;          /* Worker threads; 0 = pool disabled */
+    int job_max_running;      /* Per-module jobs executing at once */
+    int job_max_queued;       /* Per-module jobs submitted but not yet delivered */
+
+    /* [bots] -- server-owned AI ships */
+    int  bot_count;           /* Bots spawned at startup; 0 = none */
+    char bot_ship[32];        /* Ship class name; empty = first registry class */
+    int  bot_think_interval;  /* Ticks between decisions per bot */
+    int  bot_max_decisions;   /* Decisions per tick; 0 = unlimited */
+    int  bot_budget_us;       /* Think time per tick; 0 = decisions cap only */
+
     /* [[modules]] */
     obc_module_cfg_t modules[OBC_CFG_MODULES_MAX];
     int              module_count;
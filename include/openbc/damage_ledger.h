@@ -0,0 +1,50 @@
+#ifndef OPENBC_DAMAGE_LEDGER_H
+#define OPENBC_DAMAGE_LEDGER_H
+
+#include "openbc/types.h"
+
+/*
+ * Per-victim damage ledger used for kill-time score attribution.
+ *
+ * Each victim keeps a short list of (attacker, shield, hull) contributions
+ * sorted by attacker slot, so storage is O(victims * BC_LEDGER_MAX_ATTACKERS)
+ * instead of a dense victim x attacker matrix, and kill processing walks only
+ * the attackers that actually hit. The stock cap covers every other human
+ * in a stock game, so stock scoring is exact.
+ *
+ * On larger servers the list can fill: a new attacker then evicts the
+ * existing entry with the smallest |shield + hull|, and that attacker's
+ * damage against this victim scores nothing at the kill (logged at debug
+ * level). The cap also bounds the ScoreChange extras list, which is why
+ * it is not sized to peer capacity. The newcomer, including the one whose
+ * hit is the kill, is always kept.
+ */
+
+#define BC_LEDGER_MAX_ATTACKERS  8
+
+typedef struct {
+    u8  attacker;       /* Peer slot of the attacker */
+    f32 shield_damage;
+    f32 hull_damage;
+} bc_damage_ledger_entry_t;
+
+typedef struct {
+    bc_damage_ledger_entry_t entries[BC_LEDGER_MAX_ATTACKERS];
+    int count;
+} bc_damage_ledger_t;
+
+/* Drop every contribution against this victim. */
+void bc_ledger_clear(bc_damage_ledger_t *l);
+
+/* Accumulate damage from attacker (values may be negative: team damage). */
+void bc_ledger_add(bc_damage_ledger_t *l, int attacker,
+                   f32 shield_damage, f32 hull_damage);
+
+/* Remove one attacker's contribution (attacker disconnected). */
+void bc_ledger_forget(bc_damage_ledger_t *l, int attacker);
+
+/* Look up an attacker's entry. Returns NULL if it has none. */
+const bc_damage_ledger_entry_t *bc_ledger_find(const bc_damage_ledger_t *l,
+                                               int attacker);
+
+#endif /* OPENBC_DAMAGE_LEDGER_H */
@@ -0,0 +1,93 @@
+#ifndef OPENBC_DATA_RELOAD_H
+#define OPENBC_DATA_RELOAD_H
+
+#include "openbc/types.h"
+#include "openbc/job_pool.h"
+#include "openbc/manifest.h"
+#include "openbc/ship_data.h"
+
+/*
+ * Live reload of the ship registry and the hash manifest.
+ *
+ * A change is noticed by file events (inotify on Linux), by a periodic
+ * fingerprint scan, or on request (SIGHUP). Everything that touches the
+ * disk -- fingerprinting, JSON parsing, the registry cache -- runs as one
+ * background job; the game thread only swaps pointers, at the start of a
+ * tick (bc_reload_tick), and never waits for the job.
+ *
+ * Registry generations: g_registry is replaced, never modified. A ship
+ * keeps the generation it spawned with (bc_peer_t.registry) until it
+ * respawns; a replaced generation is freed once no ship refers to it.
+ * The manifest has no such users and is replaced outright, which also
+ * empties the validated checksum cache.
+ *
+ * Only sources that loaded at startup are reloaded. A load that fails
+ * (say, a file caught half-written) keeps the current data and is retried
+ * when the files change again.
+ */
+
+#define BC_RELOAD_JOB_GROUP   (BC_JOB_MAX_GROUPS - 1)   /* modules use 0.. */
+#define BC_RELOAD_SETTLE      0.5f   /* seconds of quiet after a file event */
+
+typedef struct {
+    char registry[512];         /* registry dir or monolith JSON; "" = none */
+    bool registry_is_dir;
+    char registry_cache[512];   /* dirs load through this cache; "" = off */
+    char manifest[512];         /* hash manifest JSON; "" = none */
+} bc_reload_src_t;
+
+/* One fingerprint/load pass; owned by the worker while the job runs */
+typedef struct {
+    bool force;                 /* reload even if fingerprints match */
+    bool baseline;              /* record fingerprints only */
+    u64  registry_stamp;        /* in: last seen; out: current */
+    u64  manifest_stamp;
+    bool registry_changed;
+    bool manifest_changed;
+    bc_game_registry_t *registry;   /* new generation, NULL = none */
+    bc_manifest_t manifest;
+    bool manifest_ok;
+} bc_reload_job_t;
+
+typedef struct {
+    bc_reload_src_t src;
+    bc_job_pool_t  *pool;       /* NULL = reload unavailable */
+    int   watch_fd;             /* inotify descriptor; -1 = none */
+    f32   poll_interval;        /* seconds; 0 = no periodic scan */
+    f32   poll_timer;
+    f32   settle_timer;         /* > 0: file events seen, waiting */
+    bool  pending;              /* a pass is due once the worker is free */
+    bool  force;                /* ...and must reload even if unchanged */
+    bool  busy;                 /* job in flight */
+    bool  ready;                /* job finished, publish next tick */
+    bc_reload_job_t job;
+    u64   registry_stamp;
+    u64   manifest_stamp;
+
+    bc_game_registry_t **retired;   /* replaced, still used by a ship */
+    int   retired_count;
+    int   retired_cap;
+
+    u32   reloads;              /* generations published */
+    u32   failures;             /* changed sources that failed to load */
+} bc_reload_t;
+
+/* Set up reload of src through pool. watch enables file events (where
+ * supported) plus a scan every poll_secs (0 = events only). Without
+ * watch, only bc_reload_request triggers a reload. Submits a baseline
+ * fingerprint job. Returns false if pool is NULL; r is then inert. */
+bool bc_reload_init(bc_reload_t *r, const bc_reload_src_t *src,
+                    bc_job_pool_t *pool, bool watch, int poll_secs);
+
+/* Reload every source on the next chance, even if unchanged. */
+void bc_reload_request(bc_reload_t *r);
+
+/* Game thread, at a tick boundary: publish a finished reload, free
+ * generations no ship uses any more, and start a scan when one is due. */
+void bc_reload_tick(bc_reload_t *r, f32 dt);
+
+/* Cancel the job in flight and free every retired generation. The
+ * current g_registry is left to the caller. */
+void bc_reload_shutdown(bc_reload_t *r);
+
+#endif /* OPENBC_DATA_RELOAD_H */
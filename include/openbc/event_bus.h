@@ -26,6 +26,14 @@ typedef struct obc_engine_api obc_engine_api_t;
 /* Maximum length of an event name (including NUL terminator). */
 #define OBC_EVENT_NAME_MAX    64
 
+/*
+ * Interned event identifier. obc_event_register() maps a name to a small
+ * integer once; the *_id calls then skip name hashing and comparison.
+ * IDs are valid until the next obc_event_bus_init/shutdown.
+ */
+typedef int obc_event_id_t;
+#define OBC_EVENT_ID_INVALID  (-1)
+
 /*
  * Event context passed to every handler.
  *
@@ -36,12 +44,14 @@ typedef struct obc_engine_api obc_engine_api_t;
  *   - Call engine API functions to mutate game state
  */
 typedef struct obc_event_ctx {
-    const char *event_name;     /* Event identifier (e.g. "ship_killed")          */
+    const char *event_name;     /* Event identifier (e.g. "ship_killed"); bus-owned */
     int         sender_slot;    /* Player slot that triggered this; -1 if engine.
                                  * Caller-asserted: the bus does NOT validate it. */
     const void *event_data;     /* Read-only typed payload; cast by event_name     */
     bool        cancelled;      /* One-way latch: once true, further dispatch stops. */
     bool        suppress_relay; /* One-way latch: once true, later handlers cannot clear. */
+    int         post_count;     /* Posts merged into this dispatch (see
+                                 * obc_event_post); 0 for a direct fire.    */
 } obc_event_ctx_t;
 
 /* Handler function type. api is the same table received at module load. */
@@ -104,4 +114,99 @@ obc_event_result_t obc_event_fire(const obc_engine_api_t *api,
                                    int                     sender_slot,
                                    const void             *data);
 
+/* --- Interned-ID API ------------------------------------------------------- */
+
+/*
+ * Intern event_name and return its ID, creating the event (with no
+ * subscribers) if needed. Registering the same name again returns the same
+ * ID. Returns OBC_EVENT_ID_INVALID for invalid names or when
+ * OBC_EVENT_MAX_EVENTS is reached.
+ */
+obc_event_id_t obc_event_register(const char *event_name);
+
+/* Name of an interned event, or NULL if id is invalid. */
+const char *obc_event_id_name(obc_event_id_t id);
+
+/* Same semantics as the name-based calls above. Invalid IDs are rejected
+ * (-1 / no-op / empty result). */
+int  obc_event_subscribe_id(obc_event_id_t id, obc_event_handler_fn fn,
+                            int priority);
+void obc_event_unsubscribe_id(obc_event_id_t id, obc_event_handler_fn fn);
+obc_event_result_t obc_event_fire_id(const obc_engine_api_t *api,
+                                      obc_event_id_t          id,
+                                      int                     sender_slot,
+                                      const void             *data);
+
+/* --- Deferred queue -------------------------------------------------------- */
+
+/*
+ * obc_event_post() copies the payload into a bounded per-tick queue instead
+ * of dispatching immediately; obc_event_queue_drain() (called once per tick
+ * by the server) fires everything queued, in post order. Events posted by
+ * handlers during a drain are dispatched by the next drain, so a cascade
+ * becomes one hop per tick instead of recursion.
+ *
+ * With OBC_EVENT_POST_COALESCE, a post whose (event, sender_slot) key is
+ * already pending (and was also posted with COALESCE) replaces that entry's
+ * payload instead of adding a new one: handlers see the latest payload at
+ * the first post's queue position, with ctx->post_count holding the number
+ * of posts merged.
+ *
+ * Memory is fixed: OBC_EVENT_QUEUE_MAX entries and OBC_EVENT_QUEUE_BYTES of
+ * payload per tick. Posts that do not fit are dropped and counted.
+ * Posts to events with no subscribers are discarded up front.
+ */
+#define OBC_EVENT_QUEUE_MAX       256
+#define OBC_EVENT_QUEUE_BYTES     16384
+#define OBC_EVENT_POST_MAX_DATA   512
+
+#define OBC_EVENT_POST_COALESCE   0x1
+
+/* obc_event_post return values */
+#define OBC_EVENT_POST_QUEUED     1    /* new queue entry */
+#define OBC_EVENT_POST_MERGED     0    /* coalesced, or no subscribers */
+#define OBC_EVENT_POST_DROPPED   (-1)  /* invalid, too large, or queue full */
+
+typedef struct obc_event_queue_stats {
+    unsigned posted;      /* accepted posts (queued + merged) */
+    unsigned coalesced;   /* posts merged into a pending entry */
+    unsigned skipped;     /* posts to events without subscribers */
+    unsigned dropped;     /* invalid, oversized, or overflow */
+    unsigned dispatched;  /* entries fired by drains */
+    int      depth;       /* entries pending now */
+    int      peak_depth;  /* high-water mark of entries per tick */
+} obc_event_queue_stats_t;
+
+/* Queue data (data_len bytes, copied; data may be NULL when data_len is
+ * 0) for dispatch at the next drain. flags: OBC_EVENT_POST_COALESCE. */
+int obc_event_post(obc_event_id_t id, int sender_slot,
+                   const void *data, int data_len, int flags);
+
+/* Fire every entry pending at the time of the call. Returns the number of
+ * entries dispatched. api is forwarded to handlers. */
+int obc_event_queue_drain(const obc_engine_api_t *api);
+
+/* Snapshot of the queue counters (cumulative since bus init). */
+void obc_event_queue_stats(obc_event_queue_stats_t *out);
+
+/* --- Subscriber presence --------------------------------------------------- */
+
+/*
+ * One flag per interned ID: true while the event has at least one active
+ * subscriber. Maintained by subscribe/unsubscribe (deferred changes take
+ * effect when the current fire completes) and cleared by init/shutdown.
+ * Read-only outside the bus.
+ */
+extern bool obc_event_subscribed[OBC_EVENT_MAX_EVENTS];
+
+/*
+ * Cheap guard for engine call sites: test this before building an event
+ * payload so an event nobody listens to costs one load and a branch.
+ * Invalid IDs report false.
+ */
+static inline bool obc_event_has_subscribers(obc_event_id_t id)
+{
+    return id >= 0 && id < OBC_EVENT_MAX_EVENTS && obc_event_subscribed[id];
+}
+
 #endif /* OPENBC_EVENT_BUS_H */
@@ -0,0 +1,74 @@
+#ifndef OPENBC_EVENT_TYPES_H
+#define OPENBC_EVENT_TYPES_H
+
+/*
+ * Payload structs for the events the engine fires (ctx->event_data).
+ *
+ * Module-visible and standalone: plain int/float/pointer fields only, so a
+ * module can include it without the engine's internal headers. Pointers in
+ * a payload are valid for the duration of the handler call only.
+ *
+ * Slots are peer slots (1..N; 0 is the dedicated server, -1 = none/engine).
+ */
+
+/* Kill method constants for ship_kill() and obc_kill_event_t.method. */
+#define OBC_KILL_WEAPON       0
+#define OBC_KILL_COLLISION    1
+#define OBC_KILL_SELF_DESTRUCT 2
+#define OBC_KILL_EXPLOSION    3
+#define OBC_KILL_ENVIRONMENT  4
+
+/* Damage source constants for obc_damage_event_t.source. */
+#define OBC_DAMAGE_BEAM       0
+#define OBC_DAMAGE_TORPEDO    1
+#define OBC_DAMAGE_COLLISION  2
+
+/* "chat", "team_chat" -- fired before the message is echoed.
+ * cancelled or suppress_relay drops the echo. */
+typedef struct {
+    int         slot;
+    int         team_only;    /* 1 for team_chat */
+    const char *message;      /* NUL-terminated, sanitized text */
+} obc_chat_event_t;
+
+/* "beam_fire", "torpedo_fire" -- fired before the visual is relayed.
+ * suppress_relay skips the relay; cancelled skips server-side damage. */
+typedef struct {
+    int shooter_slot;
+    int target_slot;          /* -1 if no lock or target is not a player */
+    int shooter_id;           /* network object IDs */
+    int target_id;            /* -1 if no lock */
+} obc_weapon_fire_event_t;
+
+/* "ship_damaged" -- fired after damage is applied and scored and any kill
+ * it caused has been handled (a lethal hit fires after "ship_killed"). */
+typedef struct {
+    int   target_slot;
+    int   attacker_slot;      /* -1 for environmental / unattributed */
+    int   source;             /* OBC_DAMAGE_* */
+    float shield_damage;      /* shield HP removed by this hit */
+    float hull_damage;        /* hull HP removed by this hit */
+    float hull_remaining;
+} obc_damage_event_t;
+
+/* "ship_killed" -- fired after the kill is scored. */
+typedef struct {
+    int victim_slot;
+    int killer_slot;          /* -1 if no killer (self-destruct, collision
+                               * with a non-player, ...) */
+    int method;               /* OBC_KILL_* */
+} obc_kill_event_t;
+
+/* "player_connected", "player_disconnected", "new_player_in_game",
+ * "ship_respawned" */
+typedef struct {
+    int         slot;
+    const char *name;         /* may be empty before the name is known */
+} obc_player_event_t;
+
+/* "game_ended" */
+typedef struct {
+    int reason;               /* end-game reason code sent to clients */
+} obc_game_end_event_t;
+
+#endif /* OPENBC_EVENT_TYPES_H */
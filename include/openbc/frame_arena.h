@@ -0,0 +1,74 @@
+#ifndef OPENBC_FRAME_ARENA_H
+#define OPENBC_FRAME_ARENA_H
+
+#include "openbc/types.h"
+
+#include <stdarg.h>
+
+/*
+ * Bump arena for per-tick scratch memory.
+ *
+ * Allocation is a pointer bump; there is no per-allocation free. The owner
+ * resets the whole arena at a fixed point (the server: after the outbox
+ * flush), so memory from bc_arena_alloc is valid until then and must not
+ * be kept across ticks. mark/release give nested users (a handler that
+ * builds a temporary list) a way to hand back their tail early.
+ *
+ * With poison on, fresh allocations are filled with BC_ARENA_FRESH and
+ * released or reset bytes with BC_ARENA_DEAD, so reads of uninitialised
+ * or stale scratch memory show up as obvious patterns instead of leftover
+ * data. Poison defaults on unless NDEBUG is defined.
+ *
+ * Storage is supplied by the caller; the arena never touches the heap.
+ */
+
+#define BC_ARENA_ALIGN  16
+#define BC_ARENA_FRESH  0xCD
+#define BC_ARENA_DEAD   0xDD
+
+#ifdef NDEBUG
+#  define BC_ARENA_POISON_DEFAULT  false
+#else
+#  define BC_ARENA_POISON_DEFAULT  true
+#endif
+
+/* Server frame arena size */
+#define BC_FRAME_ARENA_SIZE  (256 * 1024)
+
+typedef struct {
+    u8     *base;
+    size_t  cap;
+    size_t  used;
+    size_t  peak;        /* high-water mark of used, over all frames */
+    size_t  last_frame;  /* used at the most recent reset */
+    u32     frames;      /* resets */
+    u32     failed;      /* allocations refused (arena full) */
+    bool    poison;
+} bc_arena_t;
+
+void bc_arena_init(bc_arena_t *a, void *buf, size_t cap);
+
+/* size bytes aligned to BC_ARENA_ALIGN, or NULL if size is 0 or the arena
+ * is full. Not zeroed. */
+void *bc_arena_alloc(bc_arena_t *a, size_t size);
+
+/* As bc_arena_alloc with an explicit power-of-two alignment. */
+void *bc_arena_alloc_align(bc_arena_t *a, size_t size, size_t align);
+
+/* vsnprintf into the arena. Returns NULL if the result does not fit. */
+char *bc_arena_printf(bc_arena_t *a, const char *fmt, ...);
+char *bc_arena_vprintf(bc_arena_t *a, const char *fmt, va_list ap);
+
+/* Current position, for a later bc_arena_release. */
+static inline size_t bc_arena_mark(const bc_arena_t *a)
+{
+    return a->used;
+}
+
+/* Free everything allocated since mark. */
+void bc_arena_release(bc_arena_t *a, size_t mark);
+
+/* Free everything; records last_frame and counts the frame. */
+void bc_arena_reset(bc_arena_t *a);
+
+#endif /* OPENBC_FRAME_ARENA_H */
@@ -122,9 +122,9 @@ typedef struct {
 } bc_checksum_file_t;
 
 /* Parsed checksum response */
-#define BC_CHECKSUM_MAX_RESP_FILES  256
-#define BC_CHECKSUM_MAX_RESP_SUBDIRS 8
-#define BC_CHECKSUM_MAX_SUB_FILES   128
+#define BC_CHECKSUM_MAX_RESP_FILES  BC_MANIFEST_MAX_DIR_FILES
+#define BC_CHECKSUM_MAX_RESP_SUBDIRS BC_MANIFEST_MAX_SUBDIRS
+#define BC_CHECKSUM_MAX_SUB_FILES   BC_MANIFEST_MAX_SUBDIR_FILES
 
 typedef struct {
     int file_count;
@@ -0,0 +1,66 @@
+#ifndef OPENBC_INTEREST_H
+#define OPENBC_INTEREST_H
+
+#include "openbc/types.h"
+#include "openbc/opcodes.h"
+#include "openbc/ship_state.h"
+#include "openbc/movement.h"
+
+/*
+ * Interest management for unreliable StateUpdate relay.
+ *
+ * Each (observer, subject) pair gets a relevance weight in [min_rate, 1]
+ * per update, derived from the server-tracked distance between the two
+ * ships and the subject's cloak state. A priority accumulator turns that
+ * weight into a relay rate: weight 1.0 relays every update, 0.25 relays
+ * one in four. Updates that reset client-side baselines (absolute position,
+ * cloak state) are always relayed so thinned observers never drift.
+ *
+ * Reliable messages (fire events, effects, lifecycle) never go through
+ * this filter.
+ */
+
+/* Dirty bits that must always reach every observer (see
+ * docs/wire-formats/stateupdate-wire-format/03-dirty-flags.md). */
+#define BC_INTEREST_KEYFRAME_MASK  (BC_DIRTY_POS_ABS | BC_DIRTY_CLOAK)
+
+typedef struct {
+    bool enabled;
+    f32  near_dist;   /* at or inside: full rate (weight 1.0)           */
+    f32  far_dist;    /* at or beyond: min_rate                          */
+    f32  min_rate;    /* floor weight for far or fully cloaked subjects  */
+} bc_interest_cfg_t;
+
+typedef struct {
+    /* accum[observer][subject], always in [0, 1) between calls */
+    f32 accum[BC_MAX_PLAYERS][BC_MAX_PLAYERS];
+} bc_interest_t;
+
+/* Defaults: near covers the longest stock weapon range, so combat-range
+ * traffic is unchanged; beyond far_dist ships update at 1/4 rate. */
+#define BC_INTEREST_DEFAULT_NEAR      300.0f
+#define BC_INTEREST_DEFAULT_FAR      1200.0f
+#define BC_INTEREST_DEFAULT_MIN_RATE    0.25f
+
+/* Fill cfg with the defaults above (enabled). */
+void bc_interest_cfg_defaults(bc_interest_cfg_t *cfg);
+
+/* Zero all accumulators. */
+void bc_interest_init(bc_interest_t *st);
+
+/* Forget accumulated priority for a slot in both roles (join/leave). */
+void bc_interest_reset_slot(bc_interest_t *st, int slot);
+
+/* Relevance weight of subject's updates to observer, in [min_rate, 1].
+ * observer may be NULL (no ship: spectating / dead) -> 1.0. */
+f32 bc_interest_weight(const bc_interest_cfg_t *cfg,
+                       const bc_ship_state_t *observer,
+                       const bc_ship_state_t *subject);
+
+/* Advance the (observer, subject) accumulator by weight and decide whether
+ * this update is relayed. Always true when disabled or when dirty carries
+ * a BC_INTEREST_KEYFRAME_MASK bit. */
+bool bc_interest_should_relay(bc_interest_t *st, const bc_interest_cfg_t *cfg,
+                              int observer, int subject, f32 weight, u8 dirty);
+
+#endif /* OPENBC_INTEREST_H */
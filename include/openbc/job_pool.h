@@ -0,0 +1,104 @@
+#ifndef OPENBC_JOB_POOL_H
+#define OPENBC_JOB_POOL_H
+
+#include "openbc/types.h"
+
+/*
+ * Background job pool: a fixed set of worker threads that run blocking work
+ * (file I/O, compression, directory scans) off the game thread.
+ *
+ * Threading contract:
+ *   - bc_job_submit / cancel / poll / group calls are game-thread only.
+ *   - run() executes on a worker; it must not touch game state or the
+ *     engine API except bc_job_cancel_requested() for its own ID.
+ *   - done() executes on the game thread, from bc_job_poll(), exactly once
+ *     per accepted job -- also for jobs cancelled before they started.
+ *
+ * Workers push finished jobs onto a lock-free intrusive MPSC queue; the
+ * game thread pops it in bc_job_poll() without taking the pool lock.
+ * Pending jobs sit in a FIFO under a mutex; a worker takes the oldest job
+ * whose group is below its running limit, so one group (module) with a
+ * backlog cannot occupy every worker or every job slot.
+ *
+ * Job IDs carry a generation like timer IDs: 0 and negative values are
+ * never valid, and a stale ID never cancels a recycled slot.
+ */
+
+#define BC_JOB_MAX          128   /* job slots (outstanding jobs) */
+#define BC_JOB_INDEX_BITS   7     /* log2(BC_JOB_MAX) */
+#define BC_JOB_MAX_WORKERS  8
+#define BC_JOB_MAX_GROUPS   32
+
+/* Server defaults ([jobs] in server.toml) */
+#define BC_JOB_DEFAULT_WORKERS       2
+#define BC_JOB_DEFAULT_MAX_RUNNING   1
+#define BC_JOB_DEFAULT_MAX_QUEUED    16
+
+/* done() status */
+#define BC_JOB_DONE       0
+#define BC_JOB_CANCELLED  1   /* cancel requested before run() returned;
+                               * run() may not have been called at all */
+
+typedef void (*bc_job_run_fn)(void *arg, int job_id);
+typedef void (*bc_job_done_fn)(void *arg, int job_id, int status);
+
+typedef struct {
+    u32  submitted;
+    u32  completed;     /* delivered with BC_JOB_DONE */
+    u32  cancelled;     /* delivered with BC_JOB_CANCELLED */
+    u32  rejected;      /* no free slot, group over its queue limit, bad args */
+    int  outstanding;   /* accepted, not yet delivered */
+    int  outstanding_peak;
+} bc_job_stats_t;
+
+typedef struct bc_job_pool bc_job_pool_t;
+
+/* Start `workers` threads (clamped to 1..BC_JOB_MAX_WORKERS). Every group
+ * starts with the default limits. Returns NULL if no thread could start. */
+bc_job_pool_t *bc_job_pool_create(int workers);
+
+/* Cancel everything, wait for running jobs, deliver all completions, join
+ * the workers and free the pool. NULL is a no-op. */
+void bc_job_pool_destroy(bc_job_pool_t *pool);
+
+int bc_job_pool_workers(const bc_job_pool_t *pool);
+
+/* Per-group limits: at most max_running jobs executing at once and at most
+ * max_queued accepted but undelivered. Values < 1 are treated as 1. */
+void bc_job_group_limit(bc_job_pool_t *pool, int group,
+                        int max_running, int max_queued);
+
+/* Queue run(arg) for group. Returns the job ID, or -1 if run is NULL, the
+ * group is out of range or over max_queued, or all slots are in use.
+ * done may be NULL. */
+int bc_job_submit(bc_job_pool_t *pool, int group,
+                  bc_job_run_fn run, bc_job_done_fn done, void *arg);
+
+/* Request cancellation. A pending job never runs; a running job sees
+ * bc_job_cancel_requested() turn true. Either way done() reports
+ * BC_JOB_CANCELLED; a job whose run() had already returned still reports
+ * BC_JOB_DONE. Returns false for unknown, delivered or stale IDs. */
+bool bc_job_cancel(bc_job_pool_t *pool, int job_id);
+
+/* Worker-safe: true once cancellation of job_id has been requested. Only
+ * meaningful for the caller's own job, from inside its run(). */
+bool bc_job_cancel_requested(const bc_job_pool_t *pool, int job_id);
+
+/* Cancel every job of group, wait until none of them is running, then
+ * deliver that group's completions. Other groups' completions are left
+ * for the next bc_job_poll. Used before unloading the group's code. */
+void bc_job_cancel_group(bc_job_pool_t *pool, int group);
+
+/* Deliver up to max completions (0 = all available) by calling done() on
+ * the game thread. Returns the number delivered. */
+int bc_job_poll(bc_job_pool_t *pool, int max);
+
+void bc_job_stats(const bc_job_pool_t *pool, bc_job_stats_t *out);
+
+/* Slot index of a valid ID (for callers keeping side tables). */
+static inline int bc_job_index(int job_id)
+{
+    return job_id & (BC_JOB_MAX - 1);
+}
+
+#endif /* OPENBC_JOB_POOL_H */
@@ -3,10 +3,22 @@
 
 #include "openbc/types.h"
 #include <stddef.h>
+#include <stdio.h>
 
 /* Minimal DOM-style JSON parser -- just enough for manifest verification.
  * No unicode escape handling, no number exponents, no deeply nested edge cases.
- * Designed for machine-generated JSON from our own manifest tool. */
+ * Designed for machine-generated JSON from our own manifest tool.
+ *
+ * Two allocation modes share the accessors below:
+ *   json_parse         heap mode: every node and string is its own
+ *                      allocation and the source text may be discarded.
+ *   json_parse_insitu  arena mode: nodes and member vectors come from one
+ *                      chunked arena per document and strings are unescaped
+ *                      in place inside the (mutable) source text, which must
+ *                      outlive the tree. json_load_file reads the file into
+ *                      that same arena, so the document owns its text.
+ * json_free releases either kind; for an arena document that is a walk over
+ * a handful of chunks instead of the tree. */
 
 typedef enum {
     JSON_NULL,
@@ -19,6 +31,11 @@ typedef enum {
 
 typedef struct json_value json_value_t;
 
+/* json_value_t.arena */
+#define JSON_ARENA_NONE  0   /* heap node */
+#define JSON_ARENA_ROOT  1   /* root of an arena document: json_free releases it */
+#define JSON_ARENA_NODE  2   /* inside an arena document: json_free is a no-op */
+
 /* Object member (key-value pair) */
 typedef struct {
     char         *key;
@@ -27,6 +44,7 @@ typedef struct {
 
 struct json_value {
     json_type_t type;
+    u8          arena;   /* internal: JSON_ARENA_* */
     union {
         bool          boolean;
         double        number;
@@ -45,7 +63,17 @@ struct json_value {
 /* Parse a JSON string into a value tree.  Returns NULL on parse error. */
 json_value_t *json_parse(const char *text);
 
-/* Free a value tree. */
+/* Parse text in place. Strings and keys point into text, so text is
+ * modified and must stay alive (and unchanged) until json_free. Returns NULL
+ * on parse error; text contents are then unspecified. */
+json_value_t *json_parse_insitu(char *text);
+
+/* Read a whole file and parse it in place within one arena document.
+ * Returns NULL if the file cannot be read, is empty, or does not parse. */
+json_value_t *json_load_file(const char *path);
+
+/* Free a value tree (either mode). Only the root of an arena document
+ * releases anything. */
 void json_free(json_value_t *val);
 
 /* Accessors -- return NULL / 0 / false on type mismatch or missing key. */
@@ -57,4 +85,106 @@ double          json_number(const json_value_t *val);
 bool            json_bool(const json_value_t *val);
 int             json_int(const json_value_t *val);
 
+/* --- Streaming reader ---
+ *
+ * Pull-style tokenizer over the same grammar, for loaders that copy values
+ * straight into fixed structs: no tree is built, and a file source is read
+ * through a small window, so memory stays constant whatever the file size.
+ *
+ *   json_reader_t r;
+ *   if (!json_reader_open(&r, path)) ...;
+ *   if (json_reader_begin_object(&r)) {
+ *       while (json_reader_key(&r)) {
+ *           if (strcmp(r.str, "hull_hp") == 0) json_reader_number(&r, &hp);
+ *           else json_reader_skip(&r);
+ *       }
+ *   }
+ *   bool ok = json_reader_ok(&r);
+ *   json_reader_close(&r);
+ *
+ * After json_reader_key, the caller consumes exactly one value for that key
+ * (a typed read, a begin_* or a skip). Typed reads that find a different
+ * type consume the value anyway and return false, so a mismatch behaves
+ * like a missing key. Errors are sticky: once malformed input is seen every
+ * call fails and json_reader_ok returns false. */
+
+#define JSON_READER_WINDOW     4096
+#define JSON_READER_MAX_DEPTH  64
+
+typedef enum {
+    JSON_TOK_END,           /* the top-level value is complete */
+    JSON_TOK_ERROR,
+    JSON_TOK_OBJECT,        /* { */
+    JSON_TOK_OBJECT_END,    /* } */
+    JSON_TOK_ARRAY,         /* [ */
+    JSON_TOK_ARRAY_END,     /* ] */
+    JSON_TOK_KEY,           /* str */
+    JSON_TOK_STRING,        /* str */
+    JSON_TOK_NUMBER,        /* number */
+    JSON_TOK_BOOL,          /* boolean */
+    JSON_TOK_NULL,
+} json_tok_t;
+
+typedef struct {
+    /* Current token's payload. str is NUL-terminated and valid until the
+     * next call that reads a token. */
+    char       *str;
+    size_t      str_len;
+    double      number;
+    bool        boolean;
+    int         line;       /* 1-based, for error messages */
+
+    /* Internal */
+    FILE       *file;
+    const char *src;        /* window (file) or whole text (memory) */
+    size_t      src_len;
+    size_t      at;
+    size_t      str_cap;
+    u8          state;
+    bool        error;
+    int         depth;
+    u8          stack[JSON_READER_MAX_DEPTH];
+    char        window[JSON_READER_WINDOW];
+} json_reader_t;
+
+/* Read from a NUL-terminated string (not copied; must outlive the reader). */
+void json_reader_init(json_reader_t *r, const char *text);
+
+/* Read from a file through a fixed window. Returns false if it cannot be
+ * opened (nothing to close then). */
+bool json_reader_open(json_reader_t *r, const char *path);
+
+/* Release the file and string buffer; needed after json_reader_init too. */
+void json_reader_close(json_reader_t *r);
+
+/* Next raw token. */
+json_tok_t json_reader_next(json_reader_t *r);
+
+/* Consume the next value whole (scalars, or a container to its end). */
+bool json_reader_skip(json_reader_t *r);
+
+/* Consume the next value; true and positioned inside if it is an object /
+ * array, otherwise the value is skipped and false is returned. */
+bool json_reader_begin_object(json_reader_t *r);
+bool json_reader_begin_array(json_reader_t *r);
+
+/* Inside an object: true with the key in r->str, or false once the
+ * closing } has been consumed (or on error). */
+bool json_reader_key(json_reader_t *r);
+
+/* Inside an array: true if another element follows (read it next), false
+ * once the closing ] has been consumed (or on error). */
+bool json_reader_item(json_reader_t *r);
+
+/* Typed reads of the next value. out is left untouched on a mismatch. */
+bool json_reader_number(json_reader_t *r, double *out);
+bool json_reader_bool(json_reader_t *r, bool *out);
+bool json_reader_string(json_reader_t *r, char *dst, size_t dst_size);  /* truncates */
+
+/* No malformed input seen so far. */
+static inline bool json_reader_ok(const json_reader_t *r)
+{
+    return !r->error;
+}
+
 #endif /* OPENBC_JSON_PARSE_H */
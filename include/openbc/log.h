@@ -46,4 +46,8 @@ void bc_log_packet_trace(const bc_packet_t *pkt, int slot, const char *label);
  * Wraps GetTickCount() on Windows, clock_gettime(CLOCK_MONOTONIC) on POSIX. */
 u32 bc_ms_now(void);
 
+/* Monotonic microsecond clock (wraps every ~71 minutes; use differences).
+ * For per-tick CPU budgets; QueryPerformanceCounter on Windows. */
+u32 bc_us_now(void);
+
 #endif /* OPENBC_LOG_H */
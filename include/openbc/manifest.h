@@ -12,12 +12,22 @@
  *
  * Structure mirrors the JSON: 4 checksum directories, each with files
  * and optional subdirectories (e.g. scripts/ships/Hardpoints/).
+ *
+ * Every files/subdirs array is sorted by name_hash with duplicates
+ * removed (the first listed entry wins), so lookups are a binary search.
+ * All of them live in one block sized to the loaded data; release it with
+ * bc_manifest_free.
+ *
+ * A checksum response carries at most BC_MANIFEST_MAX_DIR_FILES files per
+ * directory, BC_MANIFEST_MAX_SUBDIRS subdirectories and
+ * BC_MANIFEST_MAX_SUBDIR_FILES files in each. A manifest asking for more
+ * could never be satisfied by any client, so bc_manifest_load refuses it.
  */
 
-#define BC_MANIFEST_MAX_DIRS       4
-#define BC_MANIFEST_MAX_FILES    256
-#define BC_MANIFEST_MAX_SUBDIRS    8
-#define BC_MANIFEST_MAX_SUB_FILES 128
+#define BC_MANIFEST_MAX_DIRS          4
+#define BC_MANIFEST_MAX_DIR_FILES     256
+#define BC_MANIFEST_MAX_SUBDIRS       8
+#define BC_MANIFEST_MAX_SUBDIR_FILES  128
 
 /* A single file entry: name hash + content hash */
 typedef struct {
@@ -27,18 +37,18 @@ typedef struct {
 
 /* A subdirectory within a checksum directory */
 typedef struct {
-    u32                 name_hash;
-    bc_manifest_file_t  files[BC_MANIFEST_MAX_SUB_FILES];
-    int                 file_count;
+    u32                   name_hash;
+    bc_manifest_file_t   *files;         /* sorted by name_hash */
+    int                   file_count;
 } bc_manifest_subdir_t;
 
 /* A top-level checksum directory (one per round) */
 typedef struct {
     u32                   dir_name_hash;
     bool                  recursive;
-    bc_manifest_file_t    files[BC_MANIFEST_MAX_FILES];
+    bc_manifest_file_t   *files;         /* sorted by name_hash */
     int                   file_count;
-    bc_manifest_subdir_t  subdirs[BC_MANIFEST_MAX_SUBDIRS];
+    bc_manifest_subdir_t *subdirs;       /* sorted by name_hash */
     int                   subdir_count;
 } bc_manifest_dir_t;
 
@@ -47,16 +57,28 @@ typedef struct {
     u32               version_hash;
     bc_manifest_dir_t dirs[BC_MANIFEST_MAX_DIRS];
     int               dir_count;
+    void             *storage;          /* backs every files/subdirs array */
+    size_t            storage_size;
 } bc_manifest_t;
 
 /* Load a manifest from a JSON file on disk.
  * Returns true on success, fills 'manifest'.
- * On failure, returns false and prints error to stderr. */
+ * On failure (including a directory over the response limits above),
+ * returns false and logs the error.
+ * 'manifest' is overwritten, not freed: free a loaded one first. */
 bool bc_manifest_load(bc_manifest_t *manifest, const char *path);
 
+/* Release a loaded manifest's storage and zero it. */
+void bc_manifest_free(bc_manifest_t *manifest);
+
 /* Print a summary of the loaded manifest (for startup diagnostics). */
 void bc_manifest_print_summary(const bc_manifest_t *manifest);
 
+/* Look up a file by name_hash in a sorted, duplicate-free file array.
+ * Returns pointer to the file entry, or NULL if not found. */
+const bc_manifest_file_t *bc_manifest_find_in(
+    const bc_manifest_file_t *files, int count, u32 name_hash);
+
 /* Look up a file by name_hash within a manifest directory.
  * Returns pointer to the file entry, or NULL if not found. */
 const bc_manifest_file_t *bc_manifest_find_file(
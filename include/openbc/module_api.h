@@ -16,13 +16,16 @@
  *   - A module should check api_version >= MIN_REQUIRED at load time.
  *
  * This header is intentionally standalone: it only includes the event bus
- * (for obc_event_handler_fn / obc_event_ctx_t) and the two public ship
- * headers that define the opaque data types exposed through the API.
+ * (for obc_event_handler_fn / obc_event_ctx_t), the engine event payloads
+ * and the two public ship headers that define the opaque data types
+ * exposed through the API.
  */
 
 #include "openbc/event_bus.h"
+#include "openbc/event_types.h"
 #include "openbc/ship_state.h"
 #include "openbc/ship_data.h"
+#include "openbc/combat.h"
 
 /* -------------------------------------------------------------------------
  * Cross-platform DLL export macro.
@@ -45,6 +48,8 @@
 
 typedef bc_ship_state_t obc_ship_state_t;
 typedef bc_ship_class_t obc_ship_class_t;
+typedef bc_ship_view_t  obc_ship_view_t;
+typedef bc_combat_kernels_t obc_combat_kernels_t;
 
 /* -------------------------------------------------------------------------
  * obc_module_t  --  per-module handle.
@@ -65,6 +70,39 @@ typedef struct obc_module {
     void (*shutdown)(const struct obc_engine_api *api, struct obc_module *self);
 } obc_module_t;
 
+/* -------------------------------------------------------------------------
+ * Background jobs  --  see job_submit.
+ *
+ * obc_job_fn runs on an engine worker thread: it may do file I/O, heavy
+ * computation and the like, but must not call any api function except
+ * job_cancelled.  obc_job_done_fn runs later on the game thread with the
+ * full api available.
+ * ---------------------------------------------------------------------- */
+
+#define OBC_JOB_DONE       0   /* run() returned normally */
+#define OBC_JOB_CANCELLED  1   /* job_cancel was called; run() may not have run */
+
+typedef void (*obc_job_fn)(void *arg, int job_id);
+typedef void (*obc_job_done_fn)(const struct obc_engine_api *api, void *arg,
+                                int job_id, int status);
+
+/* -------------------------------------------------------------------------
+ * Packet hooks  --  see packet_hook_add.
+ *
+ * An obc_packet_hook_fn sees an inbound game message (data[0] is the
+ * opcode) before the engine handles it and returns one of the verdicts
+ * below.  To rewrite, edit data in place and/or lower *len (never raise
+ * it) and return OBC_PACKET_REWRITE.
+ * ---------------------------------------------------------------------- */
+
+#define OBC_PACKET_PASS     0
+#define OBC_PACKET_DROP     1   /* engine discards the message */
+#define OBC_PACKET_REWRITE  2   /* data / *len were changed */
+
+typedef int (*obc_packet_hook_fn)(const struct obc_engine_api *api, int slot,
+                                  unsigned char *data, int *len,
+                                  void *user_data);
+
 /* -------------------------------------------------------------------------
  * obc_engine_api_t  --  the complete engine interface.
  *
@@ -309,6 +347,12 @@ typedef struct obc_engine_api {
     /* Data Registry (read-only ship class data)                           */
     /* ------------------------------------------------------------------ */
 
+    /*
+     * A data reload (SIGHUP, or [data] live_reload) can replace the
+     * registry between ticks. Class pointers from these calls stay valid
+     * until the next tick -- look them up again instead of caching them.
+     */
+
     /* Look up ship class by species ID.  Returns NULL if not in registry. */
     const obc_ship_class_t *(*ship_class_by_species)(int species_id);
 
@@ -335,6 +379,135 @@ typedef struct obc_engine_api {
      * is recommended when adding a batch of new functionality.
      */
 
+    /* ------------------------------------------------------------------ */
+    /* Event System (interned IDs)                                         */
+    /* ------------------------------------------------------------------ */
+
+    /*
+     * Intern event_name once (typically at module load) and use the ID on
+     * hot paths: the *_id calls skip the name lookup entirely.
+     * Returns OBC_EVENT_ID_INVALID for invalid names or a full event table.
+     * Same ID for the same name for the lifetime of the server.
+     */
+    obc_event_id_t (*event_register)(const char *event_name);
+
+    /* Same semantics as event_subscribe / event_unsubscribe / event_fire. */
+    int  (*event_subscribe_id)(obc_event_id_t id, obc_event_handler_fn fn,
+                                int priority);
+    void (*event_unsubscribe_id)(obc_event_id_t id, obc_event_handler_fn fn);
+    obc_event_result_t (*event_fire_id)(obc_event_id_t id, int sender_slot,
+                                         const void *data);
+
+    /*
+     * Returns 1 if the event has at least one subscriber, else 0.  Lets a
+     * module skip building a payload nobody will read.  Deferred
+     * (in-handler) subscribe/unsubscribe show up once the fire completes.
+     */
+    int  (*event_has_subscribers)(obc_event_id_t id);
+
+    /*
+     * Queue an event for dispatch at the start of the next module tick
+     * (just before game_tick).  data_len bytes are copied, so data may be
+     * a stack buffer.  With OBC_EVENT_POST_COALESCE, a later post with the
+     * same (id, sender_slot) replaces the queued payload instead of adding
+     * an entry; handlers see the merge count in ctx->post_count.
+     * Returns OBC_EVENT_POST_QUEUED, OBC_EVENT_POST_MERGED (coalesced, or
+     * no subscribers) or OBC_EVENT_POST_DROPPED (queue full / bad args).
+     */
+    int  (*event_post)(obc_event_id_t id, int sender_slot,
+                       const void *data, int data_len, int flags);
+
+    /* ------------------------------------------------------------------ */
+    /* Background jobs                                                      */
+    /* ------------------------------------------------------------------ */
+
+    /*
+     * Run run(arg) on a worker thread; done(api, arg, id, status) follows
+     * on the game thread at the start of a later tick, exactly once per
+     * accepted job (done may be NULL).  Each module has its own limits on
+     * jobs running at once and jobs outstanding ([jobs] in server.toml).
+     * Returns a job ID, or -1 if the pool is disabled, the module is at
+     * its limit, or run is NULL.  Jobs still outstanding when the module
+     * unloads are cancelled and waited for before its shutdown callback.
+     */
+    int  (*job_submit)(const obc_module_t *self, obc_job_fn run,
+                       obc_job_done_fn done, void *arg);
+
+    /* Request cancellation of one of self's jobs; done() will report
+     * OBC_JOB_CANCELLED.  Returns 1 if the job was still outstanding,
+     * else 0 (also for another module's job, which is left alone). */
+    int  (*job_cancel)(const obc_module_t *self, int job_id);
+
+    /* Thread-safe: 1 once job_cancel was called for job_id.  Long-running
+     * run() functions should poll this and return early. */
+    int  (*job_cancelled)(int job_id);
+
+    /* ------------------------------------------------------------------ */
+    /* Frame scratch memory                                                 */
+    /* ------------------------------------------------------------------ */
+
+    /*
+     * Per-tick scratch memory: size bytes, 16-byte aligned, not zeroed.
+     * Valid until the end of the current server tick (after outgoing
+     * packets are flushed); never free it and never keep the pointer.
+     * Returns NULL if size <= 0 or the arena is exhausted.  Game thread
+     * only (not from job run functions).
+     */
+    void       *(*frame_alloc)(int size);
+
+    /* printf into frame memory; same lifetime.  NULL if it does not fit. */
+    const char *(*frame_printf)(const char *fmt, ...);
+
+    /* ------------------------------------------------------------------ */
+    /* Fleet snapshot                                                       */
+    /* ------------------------------------------------------------------ */
+
+    /*
+     * Every player ship as one read-only array in ascending slot order,
+     * dead ships included (alive = 0).  *count receives the length.  The
+     * engine builds it at most once per tick and every module shares it;
+     * changes made later in the same tick show up next tick.  Valid until
+     * the end of the current tick -- do not keep the pointer.
+     */
+    const obc_ship_view_t *(*ships_snapshot)(int *count);
+
+    /* ------------------------------------------------------------------ */
+    /* Packet hooks                                                         */
+    /* ------------------------------------------------------------------ */
+
+    /*
+     * Call fn for inbound game messages whose opcode is one of the count
+     * bytes in opcodes[], from peers past the checksum handshake.  Hooks
+     * run in priority order (lower first) on the reassembled payload
+     * without a copy; data is valid only during the call.  Opcodes no
+     * hook asked for cost the engine a single bit test.  Returns a hook
+     * ID, or -1 on bad arguments or when all hook slots are in use.
+     */
+    int  (*packet_hook_add)(const unsigned char *opcodes, int count,
+                            obc_packet_hook_fn fn, int priority,
+                            void *user_data);
+
+    /* Remove a hook.  No-op for invalid IDs.  Safe from inside a hook. */
+    void (*packet_hook_remove)(int hook_id);
+
+    /* ------------------------------------------------------------------ */
+    /* Combat kernels                                                       */
+    /* ------------------------------------------------------------------ */
+
+    /* Copy the kernels the engine currently uses (the built-in ones unless
+     * a module replaced them) -- e.g. to call the previous kernel from a
+     * replacement. */
+    void (*combat_kernels_get)(obc_combat_kernels_t *out);
+
+    /*
+     * Replace the damage, shield recharge and/or repair kernels for every
+     * ship; NULL members keep the current kernel.  Only allowed from
+     * obc_module_load, before any ship exists.  Returns 0, or -1 if k is
+     * NULL or loading has finished.
+     */
+    int  (*combat_kernels_set)(const obc_module_t *self,
+                               const obc_combat_kernels_t *k);
+
 } obc_engine_api_t;
 
 /* -------------------------------------------------------------------------
@@ -360,11 +533,4 @@ typedef int (*obc_module_load_fn)(const obc_engine_api_t *api,
 
 #define OBC_MODULE_ENTRY_SYMBOL "obc_module_load"
 
-/* Kill method constants for ship_kill(). */
-#define OBC_KILL_WEAPON       0
-#define OBC_KILL_COLLISION    1
-#define OBC_KILL_SELF_DESTRUCT 2
-#define OBC_KILL_EXPLOSION    3
-#define OBC_KILL_ENVIRONMENT  4
-
 #endif /* OPENBC_MODULE_API_H */
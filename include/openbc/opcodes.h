@@ -149,8 +149,14 @@
 /* === Connection Constants === */
 #define BC_DEFAULT_PORT            0x5655  /* 22101 decimal */
 #define BC_GAMESPY_PORT            0x5656  /* 22102 decimal */
-/* Peer array size: slot 0 = dedicated server, slots 1-8 = up to 8 human players. */
-#define BC_MAX_PLAYERS             9
+/* Peer slots: slot 0 = dedicated server, slots 1.. = human players.
+ * BC_STOCK_PEER_SLOTS is the stock table (dedi + 8 humans) and the default.
+ * BC_MAX_PLAYERS is the compile-time ceiling: modded servers may size the
+ * peer table up to it at startup ([server].max_players). Per-slot arrays
+ * are dimensioned by BC_MAX_PLAYERS; loops walk the live peer list instead.
+ * Each slot owns 2^18 object IDs, so the object-ID space is not the limit. */
+#define BC_STOCK_PEER_SLOTS        9
+#define BC_MAX_PLAYERS             64
 /* Stock MissionInit (0x35) reports playerLimit as max human players (0x08). */
 #define BC_MISSION_INIT_PLAYER_LIMIT 8
 
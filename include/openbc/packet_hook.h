@@ -0,0 +1,80 @@
+#ifndef OPENBC_PACKET_HOOK_H
+#define OPENBC_PACKET_HOOK_H
+
+#include "openbc/types.h"
+
+/*
+ * Opcode-filtered hooks on inbound game messages.
+ *
+ * Each hook subscribes to a set of opcodes (a 256-bit mask). The table
+ * keeps the union of all masks, so the dispatcher pays one bit test per
+ * message and does no hook work at all for opcodes nobody asked for.
+ *
+ * Hooks run in priority order (lower first; equal priorities in add order)
+ * on the complete, possibly reassembled payload -- no copy. A hook may:
+ *   - pass:    leave the message alone;
+ *   - rewrite: edit the bytes in place and/or shorten *len (never grow it;
+ *              the buffer belongs to the receive path). Later hooks and
+ *              the engine see the new bytes, including a changed opcode;
+ *   - drop:    the engine discards the message; later hooks do not run.
+ *
+ * Adding or removing hooks from inside a hook is allowed; removal takes
+ * effect at once, an added hook first runs on the next message.
+ */
+
+#define BC_PACKET_HOOK_MAX  32
+
+/* Hook verdicts */
+#define BC_PACKET_PASS     0
+#define BC_PACKET_DROP     1
+#define BC_PACKET_REWRITE  2
+
+typedef int (*bc_packet_hook_fn)(void *user, int slot, u8 *data, int *len);
+
+typedef struct {
+    int                id;        /* 0 = removed, awaiting compaction */
+    int                priority;
+    bc_packet_hook_fn  fn;
+    void              *user;
+    u64                mask[4];
+} bc_packet_hook_t;
+
+typedef struct {
+    u32  seen;          /* messages that reached at least one hook */
+    u32  dropped;
+    u32  rewritten;
+    u32  bad_length;    /* rewrites to len < 1 or > original: dropped */
+} bc_packet_hook_stats_t;
+
+typedef struct {
+    bc_packet_hook_t        hooks[BC_PACKET_HOOK_MAX];   /* by priority */
+    int                     count;
+    u64                     mask[4];     /* union of live hook masks */
+    int                     next_id;
+    int                     running;     /* bc_packet_hook_run depth */
+    bool                    dirty;       /* removed entries to compact */
+    bc_packet_hook_stats_t  stats;
+} bc_packet_hooks_t;
+
+void bc_packet_hooks_init(bc_packet_hooks_t *h);
+
+/* Register fn for the count opcodes in opcodes[]. Returns a hook ID (> 0),
+ * or -1 if fn is NULL, count < 1 or the table is full. */
+int bc_packet_hook_add(bc_packet_hooks_t *h, const u8 *opcodes, int count,
+                       int priority, bc_packet_hook_fn fn, void *user);
+
+/* Unregister. Returns false for unknown IDs. */
+bool bc_packet_hook_remove(bc_packet_hooks_t *h, int id);
+
+/* True if any hook subscribes to opcode. */
+static inline bool bc_packet_hook_wanted(const bc_packet_hooks_t *h, u8 opcode)
+{
+    return (h->mask[opcode >> 6] >> (opcode & 63)) & 1;
+}
+
+/* Run the hooks subscribed to data[0]. *len may shrink on rewrite.
+ * Returns BC_PACKET_DROP, BC_PACKET_REWRITE (some hook changed the
+ * message) or BC_PACKET_PASS. */
+int bc_packet_hook_run(bc_packet_hooks_t *h, int slot, u8 *data, int *len);
+
+#endif /* OPENBC_PACKET_HOOK_H */
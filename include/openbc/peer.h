@@ -9,10 +9,15 @@
 #include "openbc/ship_state.h"
 
 /*
- * Peer management -- tracks connected clients in a fixed-size slot array.
+ * Peer management -- tracks connected clients in a slot table sized at
+ * startup (BC_STOCK_PEER_SLOTS by default, up to BC_MAX_PLAYERS).
  *
- * BC supports up to 6 players. Each peer progresses through states:
+ * Each peer progresses through states:
  *   EMPTY -> CONNECTING -> CHECKSUMMING -> LOBBY -> IN_GAME -> (disconnect)
+ *
+ * Per-tick loops should walk active[0..active_count) (ascending slot order,
+ * non-empty slots only, slot 0 = dedi included when reserved) rather than
+ * every slot up to capacity. Address lookup is O(1) via addr_index.
  */
 
 typedef enum {
@@ -66,6 +71,8 @@ typedef struct {
     /* Server-authoritative ship state (Phase E) */
     bc_ship_state_t     ship;            /* Server-tracked ship HP, position, etc. */
     int                 class_index;     /* Index into registry->ships[] (-1 = none) */
+    const bc_game_registry_t *registry;  /* Generation class_index refers to;
+                                          * NULL = current (see data_reload.h) */
     bool                has_ship;        /* True after ObjCreateTeam parsed */
     u8                  subsys_rr_idx;   /* Round-robin index for 0x20 health broadcasts */
     u32                 last_fire_time[BC_MAX_PHASER_BANKS];  /* Anti-cheat: last fire ms */
@@ -75,16 +82,41 @@ typedef struct {
 
     /* Respawn */
     f32                 respawn_timer;  /* Countdown to respawn (0 = not waiting) */
-    int                 respawn_class;  /* Ship class for respawn (-1 = none) */
+    int                 respawn_species; /* Ship species for respawn (-1 = none);
+                                           * a species, not an index, so it
+                                           * survives a registry reload */
 } bc_peer_t;
 
+/* Open-addressed address->slot index; power of two, >= 2 * BC_MAX_PLAYERS
+ * so probe chains stay short even with every slot occupied. */
+#define BC_PEER_ADDR_BUCKETS  128
+
 typedef struct {
-    bc_peer_t peers[BC_MAX_PLAYERS];
-    int       count;  /* Number of non-empty peers */
+    bc_peer_t *peers;     /* capacity entries, allocated by bc_peers_init */
+    int        capacity;  /* Slot count including slot 0 (dedi) */
+    int        count;     /* Number of non-empty peers */
+    bool       dedicated; /* Slot 0 reserved by bc_peers_reserve_dedicated */
+
+    /* Non-empty slots in ascending order (dense iteration list) */
+    u8         active[BC_MAX_PLAYERS];
+    int        active_count;
+
+    /* Remote address -> slot, linear probing, -1 = empty bucket */
+    i16        addr_index[BC_PEER_ADDR_BUCKETS];
 } bc_peer_mgr_t;
 
-/* Initialize peer manager (all slots empty) */
-void bc_peers_init(bc_peer_mgr_t *mgr);
+/* Initialize peer manager with capacity slots (clamped to
+ * 1..BC_MAX_PLAYERS), all empty. Returns false if allocation fails.
+ * mgr must be zeroed or previously initialized; re-initializing releases
+ * the previous table. */
+bool bc_peers_init(bc_peer_mgr_t *mgr, int capacity);
+
+/* Release the slot table. Safe on a zeroed or already-freed manager. */
+void bc_peers_free(bc_peer_mgr_t *mgr);
+
+/* Mark slot 0 as the dedicated server's own pseudo-peer (state LOBBY,
+ * no address). Counts toward count and appears in active[]. */
+void bc_peers_reserve_dedicated(bc_peer_mgr_t *mgr, const char *name);
 
 /* Find a peer by address. Returns slot index, or -1 if not found. */
 int bc_peers_find(const bc_peer_mgr_t *mgr, const bc_addr_t *addr);
@@ -95,8 +127,8 @@ int bc_peers_add(bc_peer_mgr_t *mgr, const bc_addr_t *addr);
 /* Remove a peer (set slot to EMPTY). */
 void bc_peers_remove(bc_peer_mgr_t *mgr, int slot);
 
-/* Check for timed-out peers. Removes peers with no activity for timeout_ms.
- * Returns number of peers removed. */
+/* Check for timed-out peers. Removes peers with no activity for timeout_ms;
+ * a reserved dedicated slot never times out. Returns number removed. */
 int bc_peers_timeout(bc_peer_mgr_t *mgr, u32 now_ms, u32 timeout_ms);
 
 #endif /* OPENBC_PEER_H */
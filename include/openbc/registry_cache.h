@@ -0,0 +1,101 @@
+#ifndef OPENBC_REGISTRY_CACHE_H
+#define OPENBC_REGISTRY_CACHE_H
+
+#include "openbc/types.h"
+#include "openbc/ship_data.h"
+
+/*
+ * Compiled binary cache of a versioned registry directory.
+ *
+ * bc_registry_load_dir parses a dozen JSON files per ship and resolves
+ * serialization lists, extents and the subsystem BVH. The cache stores the
+ * finished bc_game_registry_t as one blob so later starts skip all of it:
+ *
+ *   [bc_regcache_header_t][bc_game_registry_t payload]
+ *
+ *   [bc_regcache_header_t][bc_regcache_source_t x source_count][payload]
+ *
+ * The header is keyed by a hash over every file the JSON loader would read
+ * (manifest.json plus each listed ship and projectile file, by relative path
+ * and content) and carries a checksum of the payload. Any mismatch --
+ * format version, struct layout, source hash, checksum, implausible counts
+ * -- makes the reader refuse the blob and the caller fall back to JSON.
+ *
+ * The source table records each of those files' size, nanosecond mtime and
+ * ctime and inode as they were before hashing. When every one still matches
+ * (and none was written within a second of the cache), a load takes the
+ * blob without reading any JSON; otherwise it hashes the contents.
+ *
+ * The payload is the in-memory struct, so a cache is only valid for the
+ * build that wrote it; the layout fingerprint catches struct changes and
+ * other ABIs. Bump BC_REGCACHE_VERSION when the JSON loaders change what
+ * they compute from the same files. The cache is opt-in ([data]
+ * registry_cache names the file) and belongs outside the data tree.
+ */
+
+#define BC_REGCACHE_MAGIC    0x43524250u   /* "PBRC" little-endian */
+#define BC_REGCACHE_VERSION  2
+
+/* manifest.json, four files per ship, one per projectile */
+#define BC_REGCACHE_MAX_SOURCES  (1 + BC_MAX_SHIPS * 4 + BC_MAX_PROJECTILES)
+#define BC_REGCACHE_ABSENT       (~(u64)0)   /* source size: file missing */
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 layout;          /* fingerprint of the payload's struct layout */
+    u32 payload_size;    /* sizeof(bc_game_registry_t) */
+    u32 source_count;    /* source table entries; 0 = content key only */
+    u32 reserved;
+    u64 source_hash;     /* bc_registry_source_hash of the directory */
+    u64 checksum;        /* FNV-1a 64 of the payload */
+} bc_regcache_header_t;
+
+typedef struct {
+    u64  size;           /* BC_REGCACHE_ABSENT if the file was missing */
+    i64  mtime;          /* ns */
+    i64  ctime;          /* ns; status change (Win32: creation) */
+    u64  ino;
+    char rel[128];       /* relative to the registry dir */
+} bc_regcache_source_t;
+
+typedef enum {
+    BC_REGCACHE_HIT = 0,
+    BC_REGCACHE_MISSING,     /* no cache file */
+    BC_REGCACHE_BAD_HEADER,  /* wrong magic/version/layout, or truncated */
+    BC_REGCACHE_STALE,       /* built from different source files */
+    BC_REGCACHE_CORRUPT,     /* checksum or contents do not hold up */
+} bc_regcache_result_t;
+
+/* Hash of the sources bc_registry_load_dir(dir) reads. Missing optional
+ * files hash as absent, so adding one changes the key. Returns false if
+ * manifest.json cannot be read. */
+bool bc_registry_source_hash(const char *dir, u64 *out);
+
+/* Write reg to path under source_hash, with no source table. Writes a
+ * temporary file and renames it over path, so a crash never leaves a
+ * half-written cache. */
+bool bc_registry_cache_write(const char *path, const bc_game_registry_t *reg,
+                             u64 source_hash);
+
+/* Load a cache written under source_hash into reg. On anything but
+ * BC_REGCACHE_HIT, reg is left zeroed. */
+bc_regcache_result_t bc_registry_cache_read(const char *path, u64 source_hash,
+                                            bc_game_registry_t *reg);
+
+/* True if the cache at path has a source table and every source under dir
+ * still has the recorded size, timestamps and inode. Reads no source. */
+bool bc_registry_cache_fresh(const char *path, const char *dir);
+
+/* bc_registry_load_dir through the cache at cache_path: load the blob if
+ * its sources are unchanged by metadata or, failing that, by content hash;
+ * otherwise parse the JSON and (re)write the blob. cache_path NULL is a
+ * plain JSON load. result, if given, receives the cache outcome
+ * (BC_REGCACHE_MISSING when cache_path is NULL). */
+bool bc_registry_load_dir_cached(bc_game_registry_t *reg, const char *dir,
+                                 const char *cache_path,
+                                 bc_regcache_result_t *result);
+
+const char *bc_regcache_result_str(bc_regcache_result_t r);
+
+#endif /* OPENBC_REGISTRY_CACHE_H */
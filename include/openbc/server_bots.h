@@ -0,0 +1,46 @@
+#ifndef OPENBC_SERVER_BOTS_H
+#define OPENBC_SERVER_BOTS_H
+
+#include "openbc/types.h"
+#include "openbc/bot_ai.h"
+#include "openbc/config.h"
+
+/*
+ * Server-owned headless AI ships ([bots] in server.toml), driven by bot_ai.
+ *
+ * Bots live outside the peer table. Their object IDs come from the game
+ * slots above BC_MAX_PLAYERS, so they never collide with a player's
+ * range, and each bot keeps its own copy of its ship class and of the
+ * projectile defs its torpedo types name, so a live reload never frees or
+ * changes one under it. All bots share BC_TEAM_NONE: they hunt players,
+ * not each other.
+ *
+ * Clients never see a bot. ObjCreateTeam carries a client-serialized ship
+ * blob the server only relays and cannot build, so no ObjCreate or
+ * StateUpdate is ever sent for a bot, and its BeamFire / TorpedoFire
+ * packets are not relayed either. Bot fire lands through the same paths
+ * as client fire (beam hits and the torpedo tracker), so what does reach
+ * clients is its effect: the victim's health updates, damage events,
+ * scoring and kills.
+ */
+
+/* Spawn cfg->bot_count bots from the current registry (cfg->bot_ship by
+ * name, or the first class). Returns false if bots were asked for and
+ * none could be created; 0 bots is a no-op. */
+bool bc_server_bots_init(const obc_server_cfg_t *cfg);
+
+/* One tick, from the main loop's simulation block: sync player ships
+ * into the contact list, run the AI, then each bot's ship systems. */
+void bc_server_bots_tick(f32 dt);
+
+/* Free the bots. Their torpedoes still in flight then miss. */
+void bc_server_bots_shutdown(void);
+
+/* The AI world, or NULL when no bots are running. */
+const bc_bot_world_t *bc_server_bots_world(void);
+
+/* Resolve a bot's ship object ID to its ship and class. */
+bool bc_server_bot_find(i32 object_id, const bc_ship_state_t **ship,
+                        const bc_ship_class_t **cls);
+
+#endif /* OPENBC_SERVER_BOTS_H */
@@ -23,9 +23,26 @@ f32 bc_powered_efficiency(const bc_ship_state_t *ship,
                           const bc_ship_class_t *cls,
                           const char *child_type);
 
+/* One simulation tick of a ship's own systems: collision cooldown,
+ * power, movement, shield recharge, weapon charge, cloak and repair.
+ * Run by the main loop for every live player ship and by the bot tick. */
+void bc_ship_systems_tick(bc_ship_state_t *ship, const bc_ship_class_t *cls,
+                          f32 dt);
+
+/* Periodic 0x20 subsystem-health broadcast for one ship (main loop, every
+ * 3 ticks). Opens the window at the most recent unsent damage/repair on
+ * alternate ticks, otherwise continues the round-robin. */
+void bc_health_broadcast_tick(int slot);
+
+/* Beam hit from a server-owned bot on a player's ship: the same damage,
+ * scoring, repair events and kill handling as a client's beam hit. */
+void bc_bot_beam_hit(const bc_ship_state_t *ship, const bc_ship_class_t *cls,
+                     int target_slot);
+
 /* Torpedo callbacks for bc_torpedo_tick() -- defined in server_dispatch.c,
- * called from the main loop's simulation tick. */
-void bc_torpedo_hit_callback(int shooter_slot, i32 target_id,
+ * called from the main loop's simulation tick. shooter_slot < 0 marks a
+ * bot's torpedo, resolved through shooter_id. */
+void bc_torpedo_hit_callback(int shooter_slot, i32 shooter_id, i32 target_id,
                              f32 damage, f32 damage_radius,
                              bc_vec3_t impact_pos,
                              void *user_data);
@@ -0,0 +1,56 @@
+#ifndef OPENBC_SERVER_EVENTS_H
+#define OPENBC_SERVER_EVENTS_H
+
+#include "openbc/event_bus.h"
+#include "openbc/event_types.h"
+
+/*
+ * Engine-fired events: the stock catalog interned once at startup.
+ *
+ * Every engine call site is guarded by bc_server_event_wanted() so an
+ * event nobody subscribed to costs one flag load -- no payload is built
+ * and the bus is never entered. A vanilla server (no modules) therefore
+ * runs the same code it did before the hooks existed.
+ *
+ * Payload types are in openbc/event_types.h.
+ */
+
+typedef struct {
+    obc_event_id_t chat;                /* obc_chat_event_t */
+    obc_event_id_t team_chat;           /* obc_chat_event_t */
+    obc_event_id_t beam_fire;           /* obc_weapon_fire_event_t */
+    obc_event_id_t torpedo_fire;        /* obc_weapon_fire_event_t */
+    obc_event_id_t ship_damaged;        /* obc_damage_event_t */
+    obc_event_id_t ship_killed;         /* obc_kill_event_t */
+    obc_event_id_t ship_respawned;      /* obc_player_event_t */
+    obc_event_id_t player_connected;    /* obc_player_event_t */
+    obc_event_id_t player_disconnected; /* obc_player_event_t */
+    obc_event_id_t new_player_in_game;  /* obc_player_event_t */
+    obc_event_id_t game_ended;          /* obc_game_end_event_t */
+    obc_event_id_t game_restarted;      /* NULL */
+    obc_event_id_t game_tick;           /* NULL, every tick */
+    obc_event_id_t game_tick_1s;        /* NULL, once per second */
+    obc_event_id_t server_start;        /* NULL */
+    obc_event_id_t server_shutdown;     /* NULL */
+} bc_server_events_t;
+
+extern bc_server_events_t g_ev;
+
+/* API table handed to handlers fired by the engine (NULL until the module
+ * loader has built it; handlers then receive NULL). */
+extern const obc_engine_api_t *g_event_api;
+
+/* Intern the catalog. Call right after obc_event_bus_init(). */
+void bc_server_events_register(void);
+
+/* True if anyone listens to id -- test before building the payload. */
+static inline bool bc_server_event_wanted(obc_event_id_t id)
+{
+    return obc_event_has_subscribers(id);
+}
+
+/* Fire an engine event with g_event_api. */
+obc_event_result_t bc_server_event_fire(obc_event_id_t id, int sender_slot,
+                                        const void *data);
+
+#endif /* OPENBC_SERVER_EVENTS_H */
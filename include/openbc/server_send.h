@@ -23,6 +23,13 @@ void bc_flush_peer(int slot);
 void bc_relay_to_others(int sender_slot, const u8 *payload, int payload_len,
                         bool reliable);
 
+/* Relay an unreliable StateUpdate from sender_slot's ship to every other
+ * peer that interest management says should receive this one (see
+ * openbc/interest.h). dirty is the parsed dirty-flag byte; keyframe bits
+ * always go through. */
+void bc_relay_state_update(int sender_slot, const u8 *payload, int payload_len,
+                           u8 dirty);
+
 /* Send a message to ALL peers (including the sender) reliably. */
 void bc_send_to_all(const u8 *payload, int payload_len, bool reliable);
 
@@ -6,10 +6,20 @@
 #include "openbc/net.h"
 #include "openbc/peer.h"
 #include "openbc/manifest.h"
+#include "openbc/checksum_cache.h"
 #include "openbc/master.h"
 #include "openbc/ship_data.h"
 #include "openbc/torpedo_tracker.h"
 #include "openbc/gamespy.h"
+#include "openbc/interest.h"
+#include "openbc/damage_ledger.h"
+#include "openbc/ship_power.h"
+#include "openbc/timer_wheel.h"
+#include "openbc/job_pool.h"
+#include "openbc/frame_arena.h"
+#include "openbc/ship_snapshot.h"
+#include "openbc/packet_hook.h"
+#include "openbc/combat.h"
 
 #ifdef _WIN32
 #  include <windows.h>
@@ -33,6 +43,8 @@ typedef struct {
     u32  timeouts;
     u32  gamespy_queries;
     u32  reliable_retransmits;
+    u32  state_updates_relayed;   /* per-observer StateUpdate copies queued */
+    u32  state_updates_culled;    /* per-observer copies thinned by interest mgmt */
     u32  opcodes_recv[256];
     u32  opcodes_rejected[256];   /* unhandled or wrong-state opcodes */
     player_record_t players[32];
@@ -62,10 +74,25 @@ extern bool                g_query_socket_open;
 extern bc_peer_mgr_t       g_peers;
 extern bc_server_info_t    g_info;
 
-extern bc_game_registry_t  g_registry;
+/* Current registry generation (heap). Live reload swaps the pointer at a
+ * tick boundary; ships already spawned keep theirs via bc_peer_t.registry,
+ * so look up a ship's class with bc_peer_class, not g_registry. */
+extern bc_game_registry_t *g_registry;
 extern bool                g_registry_loaded;
 extern bc_torpedo_mgr_t    g_torpedoes;
 
+/* Registry generation a peer's class_index and torpedo_type refer to */
+static inline const bc_game_registry_t *bc_peer_registry(const bc_peer_t *p)
+{
+    return p->registry ? p->registry : g_registry;
+}
+
+/* Class of a peer's ship, or NULL (no registry, no class) */
+static inline const bc_ship_class_t *bc_peer_class(const bc_peer_t *p)
+{
+    return bc_registry_get_ship(bc_peer_registry(p), p->class_index);
+}
+
 extern const bc_system_entry_t g_system_table[SYSTEM_TABLE_SIZE];
 
 extern bool        g_collision_dmg;
@@ -85,11 +112,6 @@ extern bool             g_game_ended;
 
 #define BC_TEAM_NONE 0xFF
 
-typedef struct {
-    f32 shield_damage;
-    f32 hull_damage;
-} bc_damage_ledger_entry_t;
-
 typedef struct {
     bool valid;
     char name[32];
@@ -106,14 +128,44 @@ extern i32 g_player_deaths[BC_MAX_PLAYERS];
 extern u8  g_player_teams[BC_MAX_PLAYERS];
 extern i32 g_team_scores[2];
 extern i32 g_team_kills[2];
-extern bc_damage_ledger_entry_t
-    g_damage_ledger[BC_MAX_PLAYERS][BC_MAX_PLAYERS];
+extern bc_damage_ledger_t g_damage_ledger[BC_MAX_PLAYERS];  /* by victim slot */
 extern bc_reconnect_score_t g_reconnect_scores[BC_MAX_PLAYERS];
 
+/* 0x20 health replication tracking, by peer slot */
+extern bc_health_track_t g_health_track[BC_MAX_PLAYERS];
+
 extern bc_manifest_t    g_manifest;
 extern bool             g_manifest_loaded;
 extern bool             g_no_checksum;
+extern bc_checksum_cache_t g_checksum_cache;  /* validated 0x21 responses */
 
 extern bc_master_list_t g_masters;
 
+/* Interest management (unreliable StateUpdate relay thinning) */
+extern bc_interest_cfg_t g_interest_cfg;
+extern bc_interest_t     g_interest;
+
+/* Tick timers (engine housekeeping + module timer_add), advanced once per
+ * main-loop tick */
+extern bc_timer_wheel_t  g_timers;
+
+/* Background worker pool for module jobs; NULL when [jobs].workers = 0
+ * or no worker could start. Completions are delivered once per tick. */
+extern bc_job_pool_t    *g_jobs;
+
+/* Per-tick scratch memory (engine and modules), reset after the outbox
+ * flush. Never keep a pointer from it past the current tick. */
+extern bc_arena_t        g_frame;
+
+/* Fleet snapshot for modules, built lazily and invalidated each tick */
+extern bc_ship_snapshot_t g_ship_snapshot;
+
+/* Module hooks on inbound game messages, checked by opcode before dispatch */
+extern bc_packet_hooks_t  g_packet_hooks;
+
+/* Damage / shield / repair kernels the server calls (module-overridable
+ * until g_combat_kernels_locked is set, after modules have loaded) */
+extern bc_combat_kernels_t g_combat_kernels;
+extern bool                g_combat_kernels_locked;
+
 #endif /* OPENBC_SERVER_STATE_H */
@@ -0,0 +1,31 @@
+#ifndef OPENBC_SHA256_H
+#define OPENBC_SHA256_H
+
+#include "openbc/types.h"
+
+/*
+ * SHA-256 (FIPS 180-4).
+ *
+ * Not part of the BC wire protocol -- StringHash and FileHash are weak by
+ * design and trivially forgeable. This is for server-side keys that must
+ * not collide on attacker-chosen input, e.g. the checksum validation
+ * cache, where a collision would let a client skip validation.
+ */
+
+#define BC_SHA256_SIZE 32
+
+typedef struct {
+    u32    state[8];
+    u64    total;       /* bytes hashed so far */
+    u8     block[64];   /* pending partial block */
+    size_t block_len;
+} bc_sha256_t;
+
+void bc_sha256_init(bc_sha256_t *ctx);
+void bc_sha256_update(bc_sha256_t *ctx, const void *data, size_t len);
+void bc_sha256_final(bc_sha256_t *ctx, u8 out[BC_SHA256_SIZE]);
+
+/* One-shot digest of a single buffer. */
+void bc_sha256(const void *data, size_t len, u8 out[BC_SHA256_SIZE]);
+
+#endif /* OPENBC_SHA256_H */
@@ -92,6 +92,25 @@ typedef struct {
     int reactor_entry_idx;                    /* which entry is the reactor (-1 if none) */
 } bc_ss_list_t;
 
+/* Subsystem bounding-volume hierarchy (damage volume queries).
+ * Built once per ship class at registry load. Each node bounds the centers
+ * of the subsystems beneath it plus the largest radius among them, so the
+ * node box for a given search_radius is [lo - max_r*sr, hi + max_r*sr] and
+ * is always a superset of every child subsystem's expanded AABB.
+ * Leaves hold up to BC_SS_BVH_LEAF_SIZE entries of bvh_order[]; with median
+ * splits every non-root leaf holds at least two, so BC_MAX_SUBSYSTEMS nodes
+ * is always enough. */
+#define BC_SS_BVH_LEAF_SIZE    4
+#define BC_SS_BVH_MAX_NODES    BC_MAX_SUBSYSTEMS
+
+typedef struct {
+    bc_vec3_t lo;       /* min subsystem center under this node */
+    bc_vec3_t hi;       /* max subsystem center under this node */
+    f32     max_radius; /* largest subsystem radius under this node */
+    u8      first;      /* leaf: first bvh_order[] slot; internal: right child node */
+    u8      count;      /* leaf: entry count; 0 = internal (left child is node+1) */
+} bc_ss_bvh_node_t;
+
 typedef struct {
     char    name[32];
     u16     species_id;
@@ -128,6 +147,12 @@ typedef struct {
     f32     backup_battery_limit;
     f32     main_conduit_capacity;
     f32     backup_conduit_capacity;
+
+    /* Subsystem BVH (see bc_ship_class_build_bvh). bvh_node_count == 0 means
+     * no hierarchy was built; damage queries then scan subsystems linearly. */
+    int     bvh_node_count;
+    bc_ss_bvh_node_t bvh_nodes[BC_SS_BVH_MAX_NODES];
+    u8      bvh_order[BC_MAX_SUBSYSTEMS];  /* subsystem indices, leaf-grouped */
 } bc_ship_class_t;
 
 typedef struct {
@@ -159,6 +184,12 @@ bool bc_registry_load(bc_game_registry_t *reg, const char *path);
  * and projectiles/.  Returns true on success. */
 bool bc_registry_load_dir(bc_game_registry_t *reg, const char *dir);
 
+/* (Re)build the subsystem BVH for a ship class from its current subsystem
+ * positions and radii. Called by the registry loaders; call it again after
+ * editing subsystem geometry by hand. Subsystems with radius <= 0 are left
+ * out (they can never be hit). */
+void bc_ship_class_build_bvh(bc_ship_class_t *cls);
+
 /* Lookup by index (0-based). Returns NULL if out of range. */
 const bc_ship_class_t *bc_registry_get_ship(const bc_game_registry_t *reg, int index);
 
@@ -21,6 +21,56 @@ int bc_ship_build_health_update(const bc_ship_state_t *ship,
                                  bool is_own_ship,
                                  u8 *buf, int buf_size);
 
+/* Build the owner (is_own_ship=true) and remote variants of the same 0x20
+ * window in one pass over ser_list. Either buffer may be NULL to skip that
+ * variant (its len/next pointers may then be NULL too). Each variant stops
+ * on its own 10-byte budget, so next_own and next_rmt can differ. */
+void bc_ship_build_health_pair(const bc_ship_state_t *ship,
+                               const bc_ship_class_t *cls,
+                               f32 game_time, u8 start_idx,
+                               u8 *own_buf, int own_size,
+                               int *own_len, u8 *next_own,
+                               u8 *rmt_buf, int rmt_size,
+                               int *rmt_len, u8 *next_rmt);
+
+/* Per-ship health replication state: which ser_list entries changed since
+ * they were last sent, and how recently. Lets the broadcaster open the
+ * 0x20 window at the freshest damage/repair instead of waiting for the
+ * round-robin to reach it. Only entries the ship's change journal marks
+ * (subsystem HP, power) are re-signed. Zero-initialized == reset. */
+typedef struct {
+    u32  seen_sig[BC_SS_MAX_ENTRIES];  /* entry bytes at last observation */
+    u32  sent_sig[BC_SS_MAX_ENTRIES];  /* entry bytes at last send */
+    u32  stamp[BC_SS_MAX_ENTRIES];     /* change sequence (higher = newer) */
+    u32  seq;
+    u64  dirty_subsys;                 /* journaled HP changes not yet observed */
+    bool dirty_power;                  /* journaled power change not yet observed */
+    bool primed;                       /* baseline captured after reset */
+    bool last_priority;                /* last periodic window was a priority one */
+} bc_health_track_t;
+
+/* Forget all tracking (new ship / respawn). */
+void bc_health_track_reset(bc_health_track_t *t);
+
+/* Carry a journal's changes over to the next pick. Call before the
+ * journal is cleared; picks read the ship's live journal themselves. */
+void bc_health_track_note(bc_health_track_t *t, const bc_ship_journal_t *j);
+
+/* Choose the start index for the next 0x20 window. Returns the most
+ * recently changed unsent entry (*priority = true) or rr_idx. Periodic
+ * callers (urgent=false) alternate priority and round-robin windows;
+ * urgent callers (immediate damage feedback) always prefer changes. */
+u8 bc_health_track_pick(bc_health_track_t *t,
+                        const bc_ship_state_t *ship,
+                        const bc_ship_class_t *cls,
+                        u8 rr_idx, bool urgent, bool *priority);
+
+/* Record that `covered` entries starting at start_idx (wrapping) reached
+ * every observer. */
+void bc_health_track_sent(bc_health_track_t *t,
+                          const bc_ship_class_t *cls,
+                          u8 start_idx, int covered);
+
 /* Tick the reactor/power simulation: generate power, distribute to consumers,
  * compute efficiency ratios. Call once per frame. */
 void bc_ship_power_tick(bc_ship_state_t *ship,
@@ -0,0 +1,44 @@
+#ifndef OPENBC_SHIP_SNAPSHOT_H
+#define OPENBC_SHIP_SNAPSHOT_H
+
+#include "openbc/types.h"
+#include "openbc/peer.h"
+#include "openbc/ship_state.h"
+
+/*
+ * Per-tick snapshot of every player ship as one contiguous array of
+ * bc_ship_view_t, in ascending slot order.
+ *
+ * Built on first use in a tick and shared by every reader until the owner
+ * invalidates it (the server: at the end of the tick). Modules that scan
+ * the whole fleet walk this array instead of making several API calls per
+ * slot. It is a copy: damage or movement applied later in the same tick
+ * is not reflected until the next build.
+ */
+
+typedef struct {
+    bc_ship_view_t ships[BC_MAX_PLAYERS];
+    int   count;
+    bool  valid;
+    u32   builds;     /* rebuilds since init */
+} bc_ship_snapshot_t;
+
+/* Fill snap from every slot with a ship (slot 0, the dedicated server, is
+ * skipped). reg may be NULL, leaving class-derived fields unknown.
+ * Returns the number of ships. */
+int bc_ship_snapshot_build(bc_ship_snapshot_t *snap,
+                           const bc_peer_mgr_t *peers,
+                           const bc_game_registry_t *reg);
+
+/* The current snapshot, building it first if it is not valid. */
+const bc_ship_snapshot_t *bc_ship_snapshot_get(bc_ship_snapshot_t *snap,
+                                               const bc_peer_mgr_t *peers,
+                                               const bc_game_registry_t *reg);
+
+/* Mark stale; the next get rebuilds. */
+static inline void bc_ship_snapshot_invalidate(bc_ship_snapshot_t *snap)
+{
+    snap->valid = false;
+}
+
+#endif /* OPENBC_SHIP_SNAPSHOT_H */
@@ -22,6 +22,51 @@
 #define BC_SHIELD_LEFT    4
 #define BC_SHIELD_RIGHT   5
 
+/* --- Change journal ---
+ *
+ * What happened to a ship since the last clear, recorded by the mutation
+ * paths themselves (damage, shield recharge, repair, power, cloak) so
+ * consumers test bits instead of diffing HP arrays. The server clears
+ * every journal once per tick. hit_subsys is scoped tighter: a caller sets
+ * it to 0 before applying one hit and reads the subsystems that hit
+ * damaged afterwards.
+ *
+ * Replacement combat kernels (see bc_combat_kernels_t) may record through
+ * the same helpers; whatever they change without recording, the module
+ * loader journals from an HP diff around the call. */
+
+#define BC_SHIP_CHG_HULL      0x01
+#define BC_SHIP_CHG_SHIELDS   0x02
+#define BC_SHIP_CHG_SUBSYS    0x04
+#define BC_SHIP_CHG_POWER     0x08   /* battery / conduit levels */
+#define BC_SHIP_CHG_CLOAK     0x10
+#define BC_SHIP_CHG_DESTROYED 0x20
+
+/* Journal events: rarer transitions, in order of occurrence */
+#define BC_SHIP_EV_SUBSYS_DESTROYED  1   /* index = subsystem */
+#define BC_SHIP_EV_SUBSYS_REPAIRED   2   /* index = subsystem, back at max */
+#define BC_SHIP_EV_SHIELD_DOWN       3   /* index = facing */
+#define BC_SHIP_EV_CLOAK             4   /* index = new BC_CLOAK_* state */
+#define BC_SHIP_EV_DESTROYED         5
+
+#define BC_SHIP_JOURNAL_EVENTS  16
+
+typedef struct {
+    u8  type;                    /* BC_SHIP_EV_* */
+    u8  index;
+} bc_ship_event_t;
+
+typedef struct {
+    u8   changed;                /* BC_SHIP_CHG_* */
+    u8   shields;                /* changed facings, bit per facing */
+    u8   event_count;
+    u8   events_dropped;         /* events past BC_SHIP_JOURNAL_EVENTS */
+    u64  subsys_damaged;         /* lost HP, bit per subsystem */
+    u64  subsys_repaired;        /* gained HP */
+    u64  hit_subsys;             /* damaged since the caller zeroed it */
+    bc_ship_event_t events[BC_SHIP_JOURNAL_EVENTS];
+} bc_ship_journal_t;
+
 typedef struct {
     int        class_index;      /* index into registry->ships[] */
     i32        object_id;
@@ -84,8 +129,70 @@ typedef struct {
      * allocation range (ship object ID + per-subsystem offsets). */
     i32        subsys_obj_id[BC_MAX_SUBSYSTEMS];
     i32        repair_subsys_obj_id;  /* the repair subsystem's object ID (-1 if none) */
+
+    /* Changes since the last per-tick clear */
+    bc_ship_journal_t journal;
 } bc_ship_state_t;
 
+static inline void bc_ship_journal_clear(bc_ship_journal_t *j)
+{
+    j->changed = 0;
+    j->shields = 0;
+    j->event_count = 0;
+    j->events_dropped = 0;
+    j->subsys_damaged = 0;
+    j->subsys_repaired = 0;
+}
+
+static inline void bc_ship_journal_event(bc_ship_journal_t *j, u8 type, u8 index)
+{
+    if (j->event_count >= BC_SHIP_JOURNAL_EVENTS) {
+        if (j->events_dropped < 255) j->events_dropped++;
+        return;
+    }
+    j->events[j->event_count].type  = type;
+    j->events[j->event_count].index = index;
+    j->event_count++;
+}
+
+static inline void bc_ship_journal_shield(bc_ship_journal_t *j, int facing)
+{
+    j->changed |= BC_SHIP_CHG_SHIELDS;
+    j->shields |= (u8)(1u << facing);
+}
+
+static inline void bc_ship_journal_subsys_damaged(bc_ship_journal_t *j, int idx)
+{
+    j->changed |= BC_SHIP_CHG_SUBSYS;
+    j->subsys_damaged |= (u64)1 << idx;
+    j->hit_subsys     |= (u64)1 << idx;
+}
+
+static inline void bc_ship_journal_subsys_repaired(bc_ship_journal_t *j, int idx)
+{
+    j->changed |= BC_SHIP_CHG_SUBSYS;
+    j->subsys_repaired |= (u64)1 << idx;
+}
+
+/* Compact read-only copy of the fields a whole-fleet scan needs (targeting,
+ * proximity, scoreboards). One element of a ship snapshot. */
+typedef struct {
+    i32        object_id;
+    u8         slot;             /* peer slot */
+    u8         team_id;
+    u8         alive;
+    u8         cloak_state;      /* BC_CLOAK_* */
+    i16        class_index;      /* in the current registry; -1 if unknown */
+    i16        species;          /* -1 if unknown */
+    bc_vec3_t  pos;
+    bc_vec3_t  fwd;
+    f32        speed;
+    f32        hull_hp;
+    f32        hull_max;         /* 0 if the class is unknown */
+    f32        shield_hp;        /* summed over all facings */
+    f32        shield_max;
+} bc_ship_view_t;
+
 /* Initialize a ship state from registry class data.
  * Sets full HP on hull, shields, all subsystems. */
 void bc_ship_init(bc_ship_state_t *ship,
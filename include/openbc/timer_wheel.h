@@ -0,0 +1,107 @@
+#ifndef OPENBC_TIMER_WHEEL_H
+#define OPENBC_TIMER_WHEEL_H
+
+#include "openbc/types.h"
+
+/*
+ * Hierarchical timing wheel, advanced once per main-loop tick (~33 ms).
+ *
+ * Four levels of 64 slots cover 64, 4096, 262144 and 16.7M ticks
+ * (2 s, 2.3 min, 2.4 h, 6.4 days at 30 Hz); longer delays park in the top
+ * level and are re-filed on each pass. Insert and cancel are O(1): timers
+ * live in a fixed node pool linked into per-slot lists by index. When the
+ * level-0 index wraps, the next slot of the level above is redistributed
+ * downward ("cascade"), so each timer moves at most once per level.
+ *
+ * Due timers are moved to a ready list and fired from there. max_expire
+ * bounds callbacks per advance; the remainder stays ready for the next
+ * tick (counted in stats.deferred) rather than stalling one tick.
+ *
+ * Timer IDs carry a generation so a stale ID never cancels a recycled
+ * node. 0 and negative values are never valid IDs.
+ */
+
+#define BC_TIMER_LEVEL_BITS   6
+#define BC_TIMER_SLOTS        (1 << BC_TIMER_LEVEL_BITS)
+#define BC_TIMER_LEVELS       4
+#define BC_TIMER_MAX_DELAY    (1u << (BC_TIMER_LEVEL_BITS * BC_TIMER_LEVELS))
+#define BC_TIMER_MAX          512   /* node pool size */
+#define BC_TIMER_INDEX_BITS   10    /* >= log2(BC_TIMER_MAX) */
+
+/* Server tick length used to convert seconds to wheel ticks */
+#define BC_TIMER_TICK_MS      33
+
+/* Server default for max_expire: room for every engine timer plus a busy
+ * module set, while a runaway timer count cannot eat a whole tick. */
+#define BC_TIMER_DEFAULT_MAX_EXPIRE  64
+
+/* Callback: user is the pointer given to bc_timer_add. A periodic timer
+ * may cancel itself (or others) from inside its callback. */
+typedef void (*bc_timer_fn)(void *user, int timer_id);
+
+typedef struct {
+    u32          expire;    /* absolute tick */
+    u32          period;    /* 0 = one-shot */
+    bc_timer_fn  fn;
+    void        *user;
+    i16          next, prev;
+    u16          list;      /* owning list (see timer_wheel.c), or FREE */
+    u16          gen;
+} bc_timer_node_t;
+
+typedef struct {
+    u32  fired;
+    u32  deferred;      /* timer-ticks left on the ready list after an advance */
+    u32  cascaded;      /* nodes moved down a level */
+    u32  add_failed;    /* pool exhausted */
+    int  active;        /* currently armed (wheel + ready) */
+    int  active_peak;
+} bc_timer_stats_t;
+
+#define BC_TIMER_LISTS  (BC_TIMER_LEVELS * BC_TIMER_SLOTS + 1)  /* + ready */
+
+typedef struct {
+    u32              now;         /* next tick to process */
+    int              max_expire;  /* callbacks per advance, 0 = unlimited */
+    i16              head[BC_TIMER_LISTS];
+    i16              tail[BC_TIMER_LISTS];
+    bc_timer_node_t  nodes[BC_TIMER_MAX];
+    i16              free_head;
+    bc_timer_stats_t stats;
+} bc_timer_wheel_t;
+
+/* Reset to tick 0 with no timers. */
+void bc_timer_wheel_init(bc_timer_wheel_t *w, int max_expire);
+
+/* Arm fn to run after delay ticks (>= 1; 0 is treated as 1), then every
+ * period ticks if period > 0. Returns the timer ID, or -1 if fn is NULL
+ * or the pool is full. */
+int bc_timer_add(bc_timer_wheel_t *w, u32 delay, u32 period,
+                 bc_timer_fn fn, void *user);
+
+/* Disarm a timer. Returns false for unknown, fired one-shot or stale IDs. */
+bool bc_timer_cancel(bc_timer_wheel_t *w, int id);
+
+/* True while id is armed (including a periodic timer inside its callback). */
+bool bc_timer_active(const bc_timer_wheel_t *w, int id);
+
+/* Process one tick: cascade, collect due timers, fire up to max_expire.
+ * Returns the number of callbacks run. */
+int bc_timer_advance(bc_timer_wheel_t *w);
+
+/* Pool index of a valid ID (for callers keeping side tables). */
+static inline int bc_timer_index(int id)
+{
+    return id & ((1 << BC_TIMER_INDEX_BITS) - 1);
+}
+
+/* Seconds -> wheel ticks, rounded to the nearest tick, at least 1. */
+static inline u32 bc_timer_ticks(f32 seconds)
+{
+    f32 t = seconds * (1000.0f / BC_TIMER_TICK_MS) + 0.5f;
+    if (!(t >= 1.0f)) return 1;
+    if (t >= (f32)BC_TIMER_MAX_DELAY) return BC_TIMER_MAX_DELAY - 1;
+    return (u32)t;
+}
+
+#endif /* OPENBC_TIMER_WHEEL_H */
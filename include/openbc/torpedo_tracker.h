@@ -22,8 +22,8 @@ typedef struct {
 } bc_torpedo_t;
 
 /* Hit callback: called when a torpedo hits a target.
- * shooter_slot, target_slot, damage, impact position. */
-typedef void (*bc_torpedo_hit_fn)(int shooter_slot, i32 target_id,
+ * shooter_slot, shooter object ID, target, damage, impact position. */
+typedef void (*bc_torpedo_hit_fn)(int shooter_slot, i32 shooter_id, i32 target_id,
                                    f32 damage, f32 damage_radius,
                                    bc_vec3_t impact_pos,
                                    void *user_data);
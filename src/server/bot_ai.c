@@ -0,0 +1,301 @@
+#include "openbc/bot_ai.h"
+#include "openbc/movement.h"
+#include "openbc/combat.h"
+#include "openbc/log.h"
+
+#include <math.h>
+#include <string.h>
+
+void bc_bot_cfg_defaults(bc_bot_cfg_t *cfg)
+{
+    cfg->think_interval     = BC_BOT_DEFAULT_THINK_INTERVAL;
+    cfg->perceive_interval  = BC_BOT_DEFAULT_PERCEIVE_INTERVAL;
+    cfg->max_decisions      = BC_BOT_DEFAULT_MAX_DECISIONS;
+    cfg->budget_us          = BC_BOT_DEFAULT_BUDGET_US;
+    cfg->engage_range       = BC_BOT_DEFAULT_ENGAGE_RANGE;
+    cfg->torpedo_range      = BC_BOT_DEFAULT_TORPEDO_RANGE;
+    cfg->evade_shield_frac  = BC_BOT_DEFAULT_EVADE_FRAC;
+    cfg->resume_shield_frac = BC_BOT_DEFAULT_RESUME_FRAC;
+}
+
+void bc_bot_world_init(bc_bot_world_t *w, const bc_bot_cfg_t *cfg)
+{
+    memset(w, 0, sizeof(*w));
+    if (cfg) w->cfg = *cfg;
+    else     bc_bot_cfg_defaults(&w->cfg);
+    if (w->cfg.think_interval < 1)    w->cfg.think_interval = 1;
+    if (w->cfg.perceive_interval < 1) w->cfg.perceive_interval = 1;
+    w->cache_stale = true;
+    w->clock_us = bc_us_now;
+}
+
+/* --- Contacts --- */
+
+static int find_contact(const bc_bot_world_t *w, const bc_ship_state_t *ship)
+{
+    for (int i = 0; i < w->contact_count; i++)
+        if (w->contact_ships[i] == ship) return i;
+    return -1;
+}
+
+bool bc_bot_add_contact(bc_bot_world_t *w, const bc_ship_state_t *ship)
+{
+    if (!ship) return false;
+    if (find_contact(w, ship) >= 0) return true;
+    if (w->contact_count >= BC_BOT_MAX_CONTACTS) return false;
+    w->contact_ships[w->contact_count++] = ship;
+    w->cache_stale = true;
+    return true;
+}
+
+void bc_bot_remove_contact(bc_bot_world_t *w, const bc_ship_state_t *ship)
+{
+    int i = find_contact(w, ship);
+    if (i < 0) return;
+    w->contact_ships[i] = w->contact_ships[--w->contact_count];
+    w->cache_stale = true;
+
+    /* The pointer may be freed after this returns: drop it everywhere */
+    for (int b = 0; b < w->bot_count; b++) {
+        if (w->bots[b].target == ship) {
+            w->bots[b].target = NULL;
+            w->bots[b].next_think = w->tick;
+        }
+    }
+}
+
+/* Snapshot every contact into the compact cache decisions scan. */
+static void perceive(bc_bot_world_t *w)
+{
+    for (int i = 0; i < w->contact_count; i++) {
+        const bc_ship_state_t *s = w->contact_ships[i];
+        bc_bot_contact_t *c = &w->cache[i];
+        c->ship       = s;
+        c->pos        = s->pos;
+        c->object_id  = s->object_id;
+        c->team_id    = s->team_id;
+        c->targetable = s->alive && s->cloak_state != BC_CLOAK_CLOAKED;
+    }
+    w->cache_count = w->contact_count;
+    w->cache_stale = false;
+    w->cache_tick  = w->tick;
+    w->stats.perceptions++;
+}
+
+/* --- Bots --- */
+
+int bc_bot_add(bc_bot_world_t *w, bc_ship_state_t *ship,
+               const bc_ship_class_t *cls)
+{
+    if (!ship || !cls || w->bot_count >= BC_BOT_MAX) return -1;
+    if (!bc_bot_add_contact(w, ship)) return -1;
+
+    int b = w->bot_count++;
+    bc_bot_t *bot = &w->bots[b];
+    memset(bot, 0, sizeof(*bot));
+    bot->ship  = ship;
+    bot->cls   = cls;
+    bot->state = BC_BOT_IDLE;
+    /* Stagger first decisions so a batch of new bots does not think
+     * on the same tick forever after. */
+    bot->next_think = w->tick + (u32)(b % w->cfg.think_interval);
+    return b;
+}
+
+void bc_bot_remove(bc_bot_world_t *w, int bot)
+{
+    if (bot < 0 || bot >= w->bot_count) return;
+    int last = w->bot_count - 1;
+    bc_bot_remove_contact(w, w->bots[bot].ship);
+
+    /* Rewrite the think queue: drop `bot`, renumber `last` -> `bot` */
+    int n = 0;
+    for (int k = 0; k < w->queue_len; k++) {
+        int q = w->queue[(w->queue_head + k) % BC_BOT_MAX];
+        if (q == bot) continue;
+        if (q == last) q = bot;
+        w->queue[n++] = (u8)q;
+    }
+    w->queue_head = 0;
+    w->queue_len  = n;
+
+    w->bots[bot] = w->bots[last];
+    w->bot_count--;
+}
+
+static f32 shield_ratio(const bc_ship_state_t *ship, const bc_ship_class_t *cls)
+{
+    f32 cur = 0.0f, max = 0.0f;
+    for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++) {
+        cur += ship->shield_hp[i];
+        max += cls->shield_hp[i];
+    }
+    return max > 0.0f ? cur / max : 1.0f;
+}
+
+/* Nearest targetable hostile in the cache; squared distance in *d2. */
+static const bc_bot_contact_t *pick_target(const bc_bot_world_t *w,
+                                           const bc_ship_state_t *self,
+                                           f32 *d2)
+{
+    const bc_bot_contact_t *best = NULL;
+    f32 best_d2 = 0.0f;
+    for (int i = 0; i < w->cache_count; i++) {
+        const bc_bot_contact_t *c = &w->cache[i];
+        if (c->ship == self || !c->targetable) continue;
+        if (c->team_id == self->team_id) continue;
+        f32 dx = c->pos.x - self->pos.x;
+        f32 dy = c->pos.y - self->pos.y;
+        f32 dz = c->pos.z - self->pos.z;
+        f32 dd = dx*dx + dy*dy + dz*dz;
+        if (!best || dd < best_d2) {
+            best = c;
+            best_d2 = dd;
+        }
+    }
+    *d2 = best_d2;
+    return best;
+}
+
+static void fire_weapons(bc_bot_world_t *w, int b, const bc_bot_contact_t *tgt)
+{
+    bc_bot_t *bot = &w->bots[b];
+    u8 pkt[256];
+
+    if (bot->target_dist <= w->cfg.engage_range) {
+        for (int i = 0; i < bot->cls->phaser_banks; i++) {
+            if (!bc_combat_can_fire_phaser(bot->ship, bot->cls, i)) continue;
+            int n = bc_combat_fire_phaser(bot->ship, bot->cls, i,
+                                          tgt->object_id, pkt, sizeof(pkt));
+            if (n <= 0) continue;
+            w->stats.phasers_fired++;
+            if (w->on_fire) w->on_fire(w->fire_user, b, tgt->ship, false, pkt, n);
+        }
+    }
+
+    if (bot->target_dist <= w->cfg.torpedo_range) {
+        bc_vec3_t dir = bc_vec3_normalize(bc_vec3_sub(tgt->pos, bot->ship->pos));
+        for (int i = 0; i < bot->cls->torpedo_tubes; i++) {
+            if (!bc_combat_can_fire_torpedo(bot->ship, bot->cls, i)) continue;
+            int n = bc_combat_fire_torpedo(bot->ship, bot->cls, i,
+                                           tgt->object_id, dir, pkt, sizeof(pkt));
+            if (n <= 0) continue;
+            w->stats.torpedoes_fired++;
+            if (w->on_fire) w->on_fire(w->fire_user, b, tgt->ship, true, pkt, n);
+        }
+    }
+}
+
+/* One decision: re-target from the cache, pick a state, fire if engaged. */
+static void think(bc_bot_world_t *w, int b)
+{
+    bc_bot_t *bot = &w->bots[b];
+    const bc_ship_state_t *self = bot->ship;
+
+    f32 d2;
+    const bc_bot_contact_t *tgt = self->alive ? pick_target(w, self, &d2) : NULL;
+    if (!tgt) {
+        bot->state = BC_BOT_IDLE;
+        bot->target = NULL;
+        bot->speed_frac = 0.0f;
+        return;
+    }
+    bot->target = tgt->ship;
+    bot->target_dist = sqrtf(d2);
+
+    f32 sr = shield_ratio(self, bot->cls);
+    if (bot->state == BC_BOT_EVADE && sr <= w->cfg.resume_shield_frac) {
+        bot->speed_frac = 1.0f;
+        return;
+    }
+    if (sr < w->cfg.evade_shield_frac) {
+        bot->state = BC_BOT_EVADE;
+        bot->speed_frac = 1.0f;
+        return;
+    }
+    if (bot->target_dist <= w->cfg.engage_range) {
+        bot->state = BC_BOT_ENGAGE;
+        bot->speed_frac = 0.6f;
+    } else {
+        bot->state = BC_BOT_APPROACH;
+        bot->speed_frac = 1.0f;
+    }
+    fire_weapons(w, b, tgt);
+}
+
+/* Per-tick steering toward (or away from) the target's live position. */
+static void act(bc_bot_world_t *w, int b, f32 dt)
+{
+    bc_bot_t *bot = &w->bots[b];
+    bc_ship_state_t *self = bot->ship;
+    if (!self->alive) return;
+
+    const bc_ship_state_t *tgt = bot->target;
+    if (tgt) {
+        bc_vec3_t aim = tgt->pos;
+        if (bot->state == BC_BOT_EVADE) {
+            bc_vec3_t away = bc_vec3_normalize(bc_vec3_sub(self->pos, tgt->pos));
+            aim = bc_vec3_add(self->pos, bc_vec3_scale(away, 100.0f));
+        }
+        bc_ship_turn_toward(self, bot->cls, aim, dt);
+    }
+    bc_ship_set_speed(self, bot->cls, bot->cls->max_speed * bot->speed_frac);
+}
+
+void bc_bot_world_tick(bc_bot_world_t *w, f32 dt)
+{
+    u32 t0 = w->clock_us();
+
+    /* Queue bots whose decision is due (signed compare survives wrap).
+     * A target killed since the last decision makes the bot due now. */
+    for (int b = 0; b < w->bot_count; b++) {
+        bc_bot_t *bot = &w->bots[b];
+        if (bot->target && !bot->target->alive) {
+            bot->target = NULL;
+            bot->next_think = w->tick;
+            w->cache_stale = true;
+        }
+        if (bot->queued || (i32)(w->tick - bot->next_think) < 0) continue;
+        w->queue[(w->queue_head + w->queue_len) % BC_BOT_MAX] = (u8)b;
+        w->queue_len++;
+        bot->queued = true;
+    }
+
+    if (w->queue_len > 0 &&
+        (w->cache_stale ||
+         w->tick - w->cache_tick >= (u32)w->cfg.perceive_interval))
+        perceive(w);
+
+    /* Drain within budget. At least one decision always runs so a tiny
+     * budget cannot starve the queue. */
+    int done = 0;
+    u32 think_t0 = w->clock_us();
+    while (w->queue_len > 0) {
+        if (w->cfg.max_decisions > 0 && done >= w->cfg.max_decisions) break;
+        if (w->cfg.budget_us > 0 && done > 0 &&
+            w->clock_us() - think_t0 >= w->cfg.budget_us) break;
+
+        int b = w->queue[w->queue_head];
+        w->queue_head = (w->queue_head + 1) % BC_BOT_MAX;
+        w->queue_len--;
+
+        bc_bot_t *bot = &w->bots[b];
+        bot->queued = false;
+        think(w, b);
+        bot->next_think = w->tick + (u32)w->cfg.think_interval;
+        done++;
+    }
+
+    for (int b = 0; b < w->bot_count; b++)
+        act(w, b, dt);
+
+    w->stats.decisions += (u32)done;
+    w->stats.deferred  += (u32)w->queue_len;
+    w->stats.ticks++;
+    w->tick++;
+
+    u32 us = w->clock_us() - t0;
+    w->stats.tick_us_last = us;
+    w->stats.tick_us_total += us;
+    if (us > w->stats.tick_us_max) w->stats.tick_us_max = us;
+}
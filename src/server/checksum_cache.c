@@ -0,0 +1,140 @@
+#include "openbc/checksum_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* SHA-256 output is uniform, so the leading bytes make a fine bucket index. */
+static u32 key_bucket(const bc_checksum_cache_t *c, const u8 *key)
+{
+    u32 h = (u32)key[0] | ((u32)key[1] << 8) | ((u32)key[2] << 16) |
+            ((u32)key[3] << 24);
+    return h & c->bucket_mask;
+}
+
+bool bc_checksum_cache_init(bc_checksum_cache_t *c, int capacity)
+{
+    memset(c, 0, sizeof(*c));
+    c->lru_head = -1;
+    c->lru_tail = -1;
+    if (capacity <= 0) return true;
+    if (capacity > BC_CSCACHE_MAX_ENTRIES) capacity = BC_CSCACHE_MAX_ENTRIES;
+
+    /* Power-of-two bucket count at roughly 2x entries keeps chains short */
+    u32 nbuckets = 1;
+    while (nbuckets < (u32)capacity * 2) nbuckets <<= 1;
+
+    c->entries = malloc((size_t)capacity * sizeof(*c->entries));
+    c->buckets = malloc((size_t)nbuckets * sizeof(*c->buckets));
+    if (!c->entries || !c->buckets) {
+        free(c->entries);
+        free(c->buckets);
+        c->entries = NULL;
+        c->buckets = NULL;
+        return false;
+    }
+    c->capacity = capacity;
+    c->bucket_mask = nbuckets - 1;
+    bc_checksum_cache_clear(c);
+    return true;
+}
+
+void bc_checksum_cache_free(bc_checksum_cache_t *c)
+{
+    free(c->entries);
+    free(c->buckets);
+    memset(c, 0, sizeof(*c));
+    c->lru_head = -1;
+    c->lru_tail = -1;
+}
+
+void bc_checksum_cache_clear(bc_checksum_cache_t *c)
+{
+    c->count = 0;
+    c->lru_head = -1;
+    c->lru_tail = -1;
+    if (c->buckets)
+        memset(c->buckets, 0xFF, (size_t)(c->bucket_mask + 1) * sizeof(*c->buckets));
+}
+
+void bc_checksum_cache_key(u8 round, const u8 *payload, int len,
+                           u8 key[BC_SHA256_SIZE])
+{
+    bc_sha256_t ctx;
+    bc_sha256_init(&ctx);
+    bc_sha256_update(&ctx, &round, 1);
+    if (len > 0) bc_sha256_update(&ctx, payload, (size_t)len);
+    bc_sha256_final(&ctx, key);
+}
+
+static void lru_unlink(bc_checksum_cache_t *c, i32 idx)
+{
+    bc_cscache_entry_t *e = &c->entries[idx];
+    if (e->lru_prev >= 0) c->entries[e->lru_prev].lru_next = e->lru_next;
+    else                  c->lru_head = e->lru_next;
+    if (e->lru_next >= 0) c->entries[e->lru_next].lru_prev = e->lru_prev;
+    else                  c->lru_tail = e->lru_prev;
+}
+
+static void lru_push_head(bc_checksum_cache_t *c, i32 idx)
+{
+    bc_cscache_entry_t *e = &c->entries[idx];
+    e->lru_prev = -1;
+    e->lru_next = c->lru_head;
+    if (c->lru_head >= 0) c->entries[c->lru_head].lru_prev = idx;
+    c->lru_head = idx;
+    if (c->lru_tail < 0) c->lru_tail = idx;
+}
+
+static i32 find(const bc_checksum_cache_t *c, const u8 *key)
+{
+    i32 idx = c->buckets[key_bucket(c, key)];
+    while (idx >= 0) {
+        if (memcmp(c->entries[idx].key, key, BC_SHA256_SIZE) == 0)
+            return idx;
+        idx = c->entries[idx].chain;
+    }
+    return -1;
+}
+
+bool bc_checksum_cache_lookup(bc_checksum_cache_t *c,
+                              const u8 key[BC_SHA256_SIZE])
+{
+    if (c->capacity <= 0) return false;
+    i32 idx = find(c, key);
+    if (idx < 0) {
+        c->misses++;
+        return false;
+    }
+    if (idx != c->lru_head) {
+        lru_unlink(c, idx);
+        lru_push_head(c, idx);
+    }
+    c->hits++;
+    return true;
+}
+
+void bc_checksum_cache_insert(bc_checksum_cache_t *c,
+                              const u8 key[BC_SHA256_SIZE])
+{
+    if (c->capacity <= 0 || find(c, key) >= 0) return;
+
+    i32 idx;
+    if (c->count < c->capacity) {
+        idx = c->count++;
+    } else {
+        /* Recycle the least recently used slot: unhook it from its chain */
+        idx = c->lru_tail;
+        lru_unlink(c, idx);
+        i32 *link = &c->buckets[key_bucket(c, c->entries[idx].key)];
+        while (*link != idx) link = &c->entries[*link].chain;
+        *link = c->entries[idx].chain;
+        c->evictions++;
+    }
+
+    bc_cscache_entry_t *e = &c->entries[idx];
+    memcpy(e->key, key, BC_SHA256_SIZE);
+    u32 b = key_bucket(c, key);
+    e->chain = c->buckets[b];
+    c->buckets[b] = idx;
+    lru_push_head(c, idx);
+}
@@ -1,4 +1,6 @@
 #include "openbc/config.h"
+#include "openbc/bot_ai.h"
+#include "openbc/checksum_cache.h"
 #include "toml/toml.h"
 
 #include <errno.h>
@@ -76,6 +78,19 @@ static bool parse_i64_for_u16_range(int64_t value, uint16_t min_value, uint16_t
     return true;
 }
 
+static void read_int_range(toml_table_t *table, const char *key,
+                           const char *field, int min_value, int max_value,
+                           const char *range_desc, int *out)
+{
+    toml_value_t value = toml_table_int(table, key);
+    if (!value.ok) return;
+    int parsed = 0;
+    if (parse_i64_for_int_range(value.u.i, min_value, max_value, &parsed))
+        *out = parsed;
+    else
+        warn_invalid_i64(field, value.u.i, range_desc);
+}
+
 static void process_server_section(toml_table_t *root, obc_server_cfg_t *cfg)
 {
     toml_table_t *server = toml_table_table(root, "server");
@@ -204,6 +219,21 @@ static void process_data_section(toml_table_t *root, obc_server_cfg_t *cfg)
         free(value.u.s);
     }
 
+    value = toml_table_string(data, "registry_cache");
+    if (value.ok) {
+        str_copy(cfg->registry_cache, sizeof(cfg->registry_cache), value.u.s);
+        free(value.u.s);
+    }
+
+    read_int_range(data, "checksum_cache", "[data].checksum_cache",
+                   0, BC_CSCACHE_MAX_ENTRIES, "0..4096", &cfg->checksum_cache);
+
+    value = toml_table_bool(data, "live_reload");
+    if (value.ok) cfg->live_reload = value.u.b;
+
+    read_int_range(data, "reload_poll", "[data].reload_poll",
+                   0, 3600, "0..3600", &cfg->reload_poll);
+
     toml_array_t *packs = toml_table_array(data, "mod_packs");
     if (!packs) return;
 
@@ -266,6 +296,91 @@ static void process_master_section(toml_table_t *root, obc_server_cfg_t *cfg)
         warn_invalid_i64("[master].heartbeat_interval", value.u.i, "10..3600");
 }
 
+/* TOML numbers may be written as 300 or 300.0; accept both. */
+static bool read_number(toml_table_t *table, const char *key, double *out)
+{
+    toml_value_t value = toml_table_double(table, key);
+    if (value.ok) {
+        *out = value.u.d;
+        return true;
+    }
+    value = toml_table_int(table, key);
+    if (value.ok) {
+        *out = (double)value.u.i;
+        return true;
+    }
+    return false;
+}
+
+static void warn_invalid_double(const char *field, double value, const char *range_desc)
+{
+    fprintf(stderr,
+            "config: warning: invalid %s=%g (expected %s); keeping existing value\n",
+            field, value, range_desc);
+}
+
+static void process_interest_section(toml_table_t *root, obc_server_cfg_t *cfg)
+{
+    toml_table_t *interest = toml_table_table(root, "interest");
+    if (!interest) return;
+
+    toml_value_t value = toml_table_bool(interest, "enabled");
+    if (value.ok) cfg->interest_enabled = value.u.b;
+
+    double d = 0.0;
+    if (read_number(interest, "near_distance", &d)) {
+        if (d >= 0.0 && isfinite(d))
+            cfg->interest_near = d;
+        else
+            warn_invalid_double("[interest].near_distance", d, ">= 0");
+    }
+    if (read_number(interest, "far_distance", &d)) {
+        if (d >= 0.0 && isfinite(d))
+            cfg->interest_far = d;
+        else
+            warn_invalid_double("[interest].far_distance", d, ">= 0");
+    }
+    if (read_number(interest, "min_rate", &d)) {
+        if (d >= 0.0 && d <= 1.0)
+            cfg->interest_min_rate = d;
+        else
+            warn_invalid_double("[interest].min_rate", d, "0..1");
+    }
+}
+
+static void process_jobs_section(toml_table_t *root, obc_server_cfg_t *cfg)
+{
+    toml_table_t *jobs = toml_table_table(root, "jobs");
+    if (!jobs) return;
+
+    read_int_range(jobs, "workers", "[jobs].workers", 0, 8, "0..8",
+                   &cfg->job_workers);
+    read_int_range(jobs, "module_max_running", "[jobs].module_max_running",
+                   1, 8, "1..8", &cfg->job_max_running);
+    read_int_range(jobs, "module_max_queued", "[jobs].module_max_queued",
+                   1, 128, "1..128", &cfg->job_max_queued);
+}
+
+static void process_bots_section(toml_table_t *root, obc_server_cfg_t *cfg)
+{
+    toml_table_t *bots = toml_table_table(root, "bots");
+    if (!bots) return;
+
+    read_int_range(bots, "count", "[bots].count", 0, BC_BOT_MAX, "0..32",
+                   &cfg->bot_count);
+    toml_value_t value = toml_table_string(bots, "ship");
+    if (value.ok) {
+        str_copy(cfg->bot_ship, sizeof(cfg->bot_ship), value.u.s);
+        free(value.u.s);
+    }
+    read_int_range(bots, "think_interval", "[bots].think_interval",
+                   1, 300, "1..300", &cfg->bot_think_interval);
+    read_int_range(bots, "max_decisions", "[bots].max_decisions",
+                   0, BC_BOT_MAX, "0..32", &cfg->bot_max_decisions);
+    read_int_range(bots, "budget_us", "[bots].budget_us",
+                   0, 33000, "0..33000", &cfg->bot_budget_us);
+}
+
 static void process_module_table(toml_table_t *module, obc_module_cfg_t *out_module)
 {
     toml_value_t value = toml_table_string(module, "name");
@@ -370,6 +485,9 @@ static void process_toml(toml_table_t *root, obc_server_cfg_t *cfg)
     process_data_section(root, cfg);
     process_gamespy_section(root, cfg);
     process_master_section(root, cfg);
+    process_interest_section(root, cfg);
+    process_jobs_section(root, cfg);
+    process_bots_section(root, cfg);
     process_modules_section(root, cfg);
 }
 
@@ -400,7 +518,10 @@ void obc_config_defaults(obc_server_cfg_t *cfg)
     cfg->difficulty       = 1;
     cfg->respawn_time     = 10;
 
-    /* [data]: empty = auto-detect */
+    /* [data]: empty = auto-detect; registry cache off */
+    cfg->checksum_cache = BC_CSCACHE_DEFAULT_ENTRIES;
+    cfg->live_reload    = false;
+    cfg->reload_poll    = 5;
 
     /* [gamespy] */
     cfg->gamespy_enabled = true;
@@ -408,6 +529,23 @@ void obc_config_defaults(obc_server_cfg_t *cfg)
 
     /* [master] */
     cfg->heartbeat_interval = 60;
+
+    /* [interest] */
+    cfg->interest_enabled  = true;
+    cfg->interest_near     = 300.0;
+    cfg->interest_far      = 1200.0;
+    cfg->interest_min_rate = 0.25;
+
+    /* [jobs] */
+    cfg->job_workers     = 2;
+    cfg->job_max_running = 1;
+    cfg->job_max_queued  = 16;
+
+    /* [bots] */
+    cfg->bot_count          = 0;
+    cfg->bot_think_interval = BC_BOT_DEFAULT_THINK_INTERVAL;
+    cfg->bot_max_decisions  = BC_BOT_DEFAULT_MAX_DECISIONS;
+    cfg->bot_budget_us      = BC_BOT_DEFAULT_BUDGET_US;
 }
 
 bool obc_config_load(const char *path, obc_server_cfg_t *cfg)
@@ -0,0 +1,74 @@
+#include "openbc/damage_ledger.h"
+#include "openbc/log.h"
+
+#include <math.h>
+#include <string.h>
+
+void bc_ledger_clear(bc_damage_ledger_t *l)
+{
+    l->count = 0;
+}
+
+static void ledger_erase_at(bc_damage_ledger_t *l, int idx)
+{
+    memmove(&l->entries[idx], &l->entries[idx + 1],
+            (size_t)(l->count - idx - 1) * sizeof(l->entries[0]));
+    l->count--;
+}
+
+void bc_ledger_add(bc_damage_ledger_t *l, int attacker,
+                   f32 shield_damage, f32 hull_damage)
+{
+    int pos = 0;
+    while (pos < l->count && l->entries[pos].attacker < attacker) pos++;
+
+    if (pos < l->count && l->entries[pos].attacker == attacker) {
+        l->entries[pos].shield_damage += shield_damage;
+        l->entries[pos].hull_damage += hull_damage;
+        return;
+    }
+
+    if (l->count == BC_LEDGER_MAX_ATTACKERS) {
+        /* Full: evict the smallest absolute contributor. */
+        int victim_idx = 0;
+        f32 smallest = INFINITY;
+        for (int i = 0; i < l->count; i++) {
+            f32 t = fabsf(l->entries[i].shield_damage + l->entries[i].hull_damage);
+            if (t < smallest) {
+                smallest = t;
+                victim_idx = i;
+            }
+        }
+        LOG_DEBUG("score", "damage ledger full: attacker %d's %.1f dropped "
+                  "for attacker %d", l->entries[victim_idx].attacker,
+                  smallest, attacker);
+        ledger_erase_at(l, victim_idx);
+        if (victim_idx < pos) pos--;
+    }
+
+    memmove(&l->entries[pos + 1], &l->entries[pos],
+            (size_t)(l->count - pos) * sizeof(l->entries[0]));
+    l->entries[pos].attacker = (u8)attacker;
+    l->entries[pos].shield_damage = shield_damage;
+    l->entries[pos].hull_damage = hull_damage;
+    l->count++;
+}
+
+void bc_ledger_forget(bc_damage_ledger_t *l, int attacker)
+{
+    for (int i = 0; i < l->count; i++) {
+        if (l->entries[i].attacker == attacker) {
+            ledger_erase_at(l, i);
+            return;
+        }
+    }
+}
+
+const bc_damage_ledger_entry_t *bc_ledger_find(const bc_damage_ledger_t *l,
+                                               int attacker)
+{
+    for (int i = 0; i < l->count; i++) {
+        if (l->entries[i].attacker == attacker) return &l->entries[i];
+    }
+    return NULL;
+}
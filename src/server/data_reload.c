@@ -0,0 +1,382 @@
+#include "openbc/data_reload.h"
+#include "openbc/server_state.h"
+#include "openbc/registry_cache.h"
+#include "openbc/sha256.h"
+#include "openbc/log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#  include <dirent.h>
+#  include <errno.h>
+#  include <unistd.h>
+#  include <sys/inotify.h>
+#  include <sys/stat.h>
+#endif
+
+#define POLL_FALLBACK_SECS  5   /* watch requested, no file events here */
+
+/* --- Fingerprints (worker) --- */
+
+/* Leading 64 bits of the file's SHA-256 */
+static bool file_stamp(const char *path, u64 *out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+
+    bc_sha256_t ctx;
+    bc_sha256_init(&ctx);
+    u8 buf[16384];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        bc_sha256_update(&ctx, buf, n);
+    bool ok = !ferror(f);
+    fclose(f);
+    if (!ok) return false;
+
+    u8 digest[BC_SHA256_SIZE];
+    bc_sha256_final(&ctx, digest);
+    u64 h = 0;
+    for (int i = 0; i < 8; i++) h = (h << 8) | digest[i];
+    *out = h;
+    return true;
+}
+
+static bool registry_stamp(const bc_reload_src_t *s, u64 *out)
+{
+    return s->registry_is_dir ? bc_registry_source_hash(s->registry, out)
+                              : file_stamp(s->registry, out);
+}
+
+/* --- File events --- */
+
+#ifdef __linux__
+#define WATCH_MASK  (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | \
+                     IN_CREATE | IN_DELETE)
+
+/* The registry tree is at most dir/ships/<class>/ deep */
+static void watch_tree(int fd, const char *dir, int depth)
+{
+    inotify_add_watch(fd, dir, WATCH_MASK);
+    if (depth <= 0) return;
+
+    DIR *d = opendir(dir);
+    if (!d) return;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        char path[1024];
+        int n = snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        if (n < 0 || (size_t)n >= sizeof(path)) continue;
+        struct stat st;
+        if (stat(path, &st) == 0 && S_ISDIR(st.st_mode))
+            watch_tree(fd, path, depth - 1);
+    }
+    closedir(d);
+}
+
+/* Editors save by writing a new file and renaming it over the old one,
+ * so a single file is watched through its directory. */
+static void watch_parent(int fd, const char *path)
+{
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (!slash) {
+        inotify_add_watch(fd, ".", WATCH_MASK);
+        return;
+    }
+    if (slash == dir) slash++;   /* "/file" */
+    *slash = '\0';
+    inotify_add_watch(fd, dir, WATCH_MASK);
+}
+
+/* Adding an existing watch is a no-op, so this also re-arms: ship folders
+ * created since the last pass get picked up. */
+static void watch_sources(const bc_reload_t *r)
+{
+    if (r->src.registry[0]) {
+        if (r->src.registry_is_dir) watch_tree(r->watch_fd, r->src.registry, 2);
+        else                        watch_parent(r->watch_fd, r->src.registry);
+    }
+    if (r->src.manifest[0])
+        watch_parent(r->watch_fd, r->src.manifest);
+}
+
+/* Any event restarts the settle timer. Unrelated names in a watched
+ * directory (an editor's swap file, say) only cost a fingerprint pass
+ * that finds nothing changed. */
+static void drain_events(bc_reload_t *r)
+{
+    _Alignas(struct inotify_event) char buf[4096];
+    bool seen = false;
+    for (;;) {
+        ssize_t n = read(r->watch_fd, buf, sizeof(buf));
+        if (n > 0) { seen = true; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        break;
+    }
+    if (seen) r->settle_timer = BC_RELOAD_SETTLE;
+}
+#endif
+
+/* --- Job --- */
+
+static void job_discard(bc_reload_job_t *j)
+{
+    free(j->registry);
+    j->registry = NULL;
+    if (j->manifest_ok) bc_manifest_free(&j->manifest);
+    j->manifest_ok = false;
+}
+
+/* Worker: touches only r->src (read-only), r->watch_fd and r->job */
+static void reload_run(void *arg, int job_id)
+{
+    bc_reload_t *r = arg;
+    bc_reload_job_t *j = &r->job;
+    const bc_reload_src_t *s = &r->src;
+
+#ifdef __linux__
+    if (r->watch_fd >= 0) watch_sources(r);
+#endif
+
+    u64 stamp;
+    if (s->registry[0] && registry_stamp(s, &stamp) &&
+        (j->force || stamp != j->registry_stamp)) {
+        j->registry_stamp = stamp;
+        j->registry_changed = !j->baseline;
+    }
+    if (s->manifest[0] && file_stamp(s->manifest, &stamp) &&
+        (j->force || stamp != j->manifest_stamp)) {
+        j->manifest_stamp = stamp;
+        j->manifest_changed = !j->baseline;
+    }
+
+    if (j->registry_changed && !bc_job_cancel_requested(r->pool, job_id)) {
+        j->registry = calloc(1, sizeof(*j->registry));
+        bool ok = false;
+        if (j->registry && s->registry_is_dir) {
+            ok = bc_registry_load_dir_cached(j->registry, s->registry,
+                                             s->registry_cache[0]
+                                                 ? s->registry_cache : NULL,
+                                             NULL);
+        } else if (j->registry) {
+            ok = bc_registry_load(j->registry, s->registry);
+        }
+        if (!ok) {
+            free(j->registry);
+            j->registry = NULL;
+        }
+    }
+
+    if (j->manifest_changed && !bc_job_cancel_requested(r->pool, job_id))
+        j->manifest_ok = bc_manifest_load(&j->manifest, s->manifest);
+}
+
+static void reload_done(void *arg, int job_id, int status)
+{
+    (void)job_id;
+    bc_reload_t *r = arg;
+    bc_reload_job_t *j = &r->job;
+    r->busy = false;
+    if (status != BC_JOB_DONE) {
+        job_discard(j);
+        return;
+    }
+
+    /* A source that failed to load is not retried until it changes again */
+    r->registry_stamp = j->registry_stamp;
+    r->manifest_stamp = j->manifest_stamp;
+    if (j->registry_changed && !j->registry) {
+        r->failures++;
+        LOG_WARN("reload", "Ship registry %s failed to load; keeping the current one",
+                 r->src.registry);
+    }
+    if (j->manifest_changed && !j->manifest_ok) {
+        r->failures++;
+        LOG_WARN("reload", "Manifest %s failed to load; keeping the current one",
+                 r->src.manifest);
+    }
+    r->ready = j->registry || j->manifest_ok;
+}
+
+static void start_job(bc_reload_t *r, bool baseline)
+{
+    bc_reload_job_t *j = &r->job;
+    memset(j, 0, sizeof(*j));
+    j->force = r->force;
+    j->baseline = baseline;
+    j->registry_stamp = r->registry_stamp;
+    j->manifest_stamp = r->manifest_stamp;
+
+    /* Refused (queue full): stays pending, next tick tries again */
+    if (bc_job_submit(r->pool, BC_RELOAD_JOB_GROUP,
+                      reload_run, reload_done, r) < 0)
+        return;
+    r->busy = true;
+    r->pending = false;
+    r->force = false;
+    r->poll_timer = 0.0f;
+}
+
+/* --- Generations (game thread) --- */
+
+static bool generation_in_use(const bc_game_registry_t *gen)
+{
+    for (int k = 0; k < g_peers.active_count; k++) {
+        const bc_peer_t *p = &g_peers.peers[g_peers.active[k]];
+        if (p->has_ship && p->registry == gen) return true;
+    }
+    return false;
+}
+
+static void free_generation(bc_game_registry_t *gen)
+{
+    /* Shipless peers may still name it; they move to the current one,
+     * their class found again by species (-1 if it was dropped) */
+    for (int k = 0; k < g_peers.active_count; k++) {
+        bc_peer_t *p = &g_peers.peers[g_peers.active[k]];
+        if (p->registry != gen) continue;
+        const bc_ship_class_t *cls = bc_registry_get_ship(gen, p->class_index);
+        p->class_index = cls ? bc_registry_find_ship_index(g_registry,
+                                                           cls->species_id)
+                             : -1;
+        p->registry = NULL;
+    }
+    free(gen);
+}
+
+static void retire(bc_reload_t *r, bc_game_registry_t *gen)
+{
+    if (!generation_in_use(gen)) {
+        free_generation(gen);
+        return;
+    }
+    if (r->retired_count == r->retired_cap) {
+        int cap = r->retired_cap ? r->retired_cap * 2 : 4;
+        bc_game_registry_t **grown =
+            realloc(r->retired, (size_t)cap * sizeof(*grown));
+        if (!grown) {
+            /* Ships still point into it: leaking beats a dangling class */
+            LOG_WARN("reload", "Out of memory tracking a replaced registry");
+            return;
+        }
+        r->retired = grown;
+        r->retired_cap = cap;
+    }
+    r->retired[r->retired_count++] = gen;
+}
+
+static void collect_retired(bc_reload_t *r)
+{
+    int kept = 0;
+    for (int i = 0; i < r->retired_count; i++) {
+        if (generation_in_use(r->retired[i]))
+            r->retired[kept++] = r->retired[i];
+        else
+            free_generation(r->retired[i]);
+    }
+    r->retired_count = kept;
+}
+
+static void publish(bc_reload_t *r)
+{
+    bc_reload_job_t *j = &r->job;
+    r->ready = false;
+
+    if (j->registry) {
+        bc_game_registry_t *old = g_registry;
+        g_registry = j->registry;
+        j->registry = NULL;
+        retire(r, old);
+        r->reloads++;
+        LOG_INFO("reload", "Ship registry reloaded: %d ships, %d projectiles from %s "
+                 "(%d older generation(s) still flying)",
+                 g_registry->ship_count, g_registry->projectile_count,
+                 r->src.registry, r->retired_count);
+    }
+
+    if (j->manifest_ok) {
+        bc_manifest_free(&g_manifest);
+        g_manifest = j->manifest;
+        memset(&j->manifest, 0, sizeof(j->manifest));
+        j->manifest_ok = false;
+        /* Responses were validated against the old hashes */
+        bc_checksum_cache_clear(&g_checksum_cache);
+        r->reloads++;
+        LOG_INFO("reload", "Manifest reloaded: %s", r->src.manifest);
+    }
+}
+
+/* --- Public --- */
+
+bool bc_reload_init(bc_reload_t *r, const bc_reload_src_t *src,
+                    bc_job_pool_t *pool, bool watch, int poll_secs)
+{
+    memset(r, 0, sizeof(*r));
+    r->watch_fd = -1;
+    if (!pool) return false;
+    r->src = *src;
+    r->pool = pool;
+
+    if (watch) {
+#ifdef __linux__
+        r->watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (r->watch_fd < 0)
+            LOG_WARN("reload", "inotify unavailable; watching by scan only");
+#endif
+        if (r->watch_fd < 0 && poll_secs <= 0) poll_secs = POLL_FALLBACK_SECS;
+        r->poll_interval = (f32)poll_secs;
+    }
+
+    start_job(r, true);
+    return true;
+}
+
+void bc_reload_request(bc_reload_t *r)
+{
+    if (!r->pool) return;
+    r->pending = true;
+    r->force = true;
+}
+
+void bc_reload_tick(bc_reload_t *r, f32 dt)
+{
+    if (!r->pool) return;
+    if (r->ready) publish(r);
+    if (r->retired_count > 0) collect_retired(r);
+
+#ifdef __linux__
+    if (r->watch_fd >= 0) drain_events(r);
+#endif
+    if (r->settle_timer > 0.0f) {
+        r->settle_timer -= dt;
+        if (r->settle_timer <= 0.0f) {
+            r->settle_timer = 0.0f;
+            r->pending = true;
+        }
+    }
+    if (r->poll_interval > 0.0f && !r->busy) {
+        r->poll_timer += dt;
+        if (r->poll_timer >= r->poll_interval) r->pending = true;
+    }
+
+    if (r->pending && !r->busy && !r->ready) start_job(r, false);
+}
+
+void bc_reload_shutdown(bc_reload_t *r)
+{
+    if (!r->pool) return;   /* never initialized, or inert */
+    bc_job_cancel_group(r->pool, BC_RELOAD_JOB_GROUP);
+    job_discard(&r->job);
+    for (int i = 0; i < r->retired_count; i++) free(r->retired[i]);
+    free(r->retired);
+#ifdef __linux__
+    if (r->watch_fd >= 0) close(r->watch_fd);
+#endif
+    memset(r, 0, sizeof(*r));
+    r->watch_fd = -1;
+}
@@ -1,10 +1,13 @@
 #include "openbc/event_bus.h"
+#include "openbc/types.h"
 
 #include <string.h>
 
 /*
  * Internal storage: one entry per distinct event name, with a sorted list
  * of subscribers (sorted ascending by priority so lower numbers fire first).
+ * An entry's index in g_events is its interned obc_event_id_t; entries are
+ * only ever appended, so IDs stay valid until the next init/shutdown.
  *
  * All state is in static globals -- the event bus is a singleton, matching the
  * single-server-instance model of OpenBC.
@@ -17,6 +20,7 @@ typedef struct {
 
 typedef struct {
     char            name[OBC_EVENT_NAME_MAX];
+    u32             hash;
     obc_event_sub_t subs[OBC_EVENT_MAX_SUBS];
     int             sub_count;
 
@@ -40,52 +44,122 @@ typedef struct {
 static obc_event_entry_t g_events[OBC_EVENT_MAX_EVENTS];
 static int               g_event_count = 0;
 
+/* Name -> entry index (open addressing, linear probing). Holds index + 1
+ * so a zeroed table is empty. Entries are never removed individually, only
+ * by init/shutdown, so no tombstones are needed. Twice OBC_EVENT_MAX_EVENTS
+ * keeps the load factor at or below 0.5; u8 slots cap the bus at 255 names. */
+#define OBC_EVENT_HASH_BUCKETS 256
+static u8 g_event_hash[OBC_EVENT_HASH_BUCKETS];
+
+/* Subscriber presence per event ID (see obc_event_has_subscribers). Kept in
+ * step with sub_count by insert_sub/remove_sub, so deferred adds and
+ * removals only flip the flag once they are actually applied. */
+bool obc_event_subscribed[OBC_EVENT_MAX_EVENTS];
+
+/* Deferred queue (obc_event_post). Two buffers: posts go to g_post[g_post_cur];
+ * a drain flips g_post_cur first, so handlers posting during the drain
+ * fill the other buffer for the next tick. Payloads are copied into
+ * 8-byte-aligned chunks of data[] so handlers can cast them directly. */
+#define OBC_EVENT_POST_HASH  512   /* 2x entries; power of two */
+
+typedef struct {
+    obc_event_id_t id;
+    int            sender_slot;
+    u32            off;        /* in u64 units into data[] */
+    u16            len;        /* payload bytes */
+    u16            cap;        /* bytes reserved at off */
+    int            count;      /* posts merged into this entry */
+    bool           coalesce;
+} obc_event_post_t;
+
+typedef struct {
+    obc_event_post_t items[OBC_EVENT_QUEUE_MAX];
+    int              count;
+    u64              data[OBC_EVENT_QUEUE_BYTES / 8];
+    u32              used;     /* u64 units */
+    i16              index[OBC_EVENT_POST_HASH];  /* coalesce key -> item + 1 */
+} obc_event_post_queue_t;
+
+static obc_event_post_queue_t  g_post[2];
+static int                     g_post_cur;
+static obc_event_queue_stats_t g_post_stats;
+
 /* This bus is single-threaded. fire_depth and deferred queues make recursive
  * calls safe on the same thread, but concurrent calls from multiple threads
  * are data races and require external serialization. */
 
 /* --- Internal helpers ----------------------------------------------------- */
 
-/* Valid names are non-empty and must fit in OBC_EVENT_NAME_MAX (including NUL). */
-static int validate_event_name(const char *name, size_t *out_len)
+/* Valid names are non-empty and must fit in OBC_EVENT_NAME_MAX (including NUL).
+ * Computes the FNV-1a hash in the same pass. */
+static int hash_event_name(const char *name, size_t *out_len, u32 *out_hash)
 {
     if (!name) return 0;
 
+    u32 h = 2166136261u;
     for (size_t len = 0; len < OBC_EVENT_NAME_MAX; len++) {
         if (name[len] == '\0') {
             if (len == 0) return 0;
             if (out_len) *out_len = len;
+            if (out_hash) *out_hash = h;
             return 1;
         }
+        h = (h ^ (u8)name[len]) * 16777619u;
     }
 
     return 0;
 }
 
-static obc_event_entry_t *find_entry(const char *name)
+static obc_event_entry_t *find_entry_hashed(const char *name, u32 hash)
 {
-    for (int i = 0; i < g_event_count; i++) {
-        if (strcmp(g_events[i].name, name) == 0)
-            return &g_events[i];
+    u32 b = hash & (OBC_EVENT_HASH_BUCKETS - 1);
+    for (;;) {
+        int slot = g_event_hash[b];
+        if (slot == 0) return NULL;
+        obc_event_entry_t *e = &g_events[slot - 1];
+        if (e->hash == hash && strcmp(e->name, name) == 0)
+            return e;
+        b = (b + 1) & (OBC_EVENT_HASH_BUCKETS - 1);
     }
-    return NULL;
+}
+
+static obc_event_entry_t *find_entry(const char *name)
+{
+    u32 hash;
+    if (!hash_event_name(name, NULL, &hash)) return NULL;
+    return find_entry_hashed(name, hash);
 }
 
 static obc_event_entry_t *find_or_create_entry(const char *name)
 {
     size_t name_len = 0;
-    if (!validate_event_name(name, &name_len)) return NULL;
+    u32 hash;
+    if (!hash_event_name(name, &name_len, &hash)) return NULL;
 
-    obc_event_entry_t *e = find_entry(name);
+    obc_event_entry_t *e = find_entry_hashed(name, hash);
     if (e) return e;
     if (g_event_count >= OBC_EVENT_MAX_EVENTS) return NULL;
 
-    e = &g_events[g_event_count++];
+    int idx = g_event_count++;
+    e = &g_events[idx];
     memset(e, 0, sizeof(*e));
     memcpy(e->name, name, name_len + 1);
+    e->hash = hash;
+
+    u32 b = hash & (OBC_EVENT_HASH_BUCKETS - 1);
+    while (g_event_hash[b] != 0)
+        b = (b + 1) & (OBC_EVENT_HASH_BUCKETS - 1);
+    g_event_hash[b] = (u8)(idx + 1);
     return e;
 }
 
+/* Resolve an interned ID; NULL for invalid or stale (pre-reset) IDs. */
+static obc_event_entry_t *entry_by_id(obc_event_id_t id)
+{
+    if (id < 0 || id >= g_event_count) return NULL;
+    return &g_events[id];
+}
+
 /* Insert one subscriber into e->subs in sorted priority order. */
 static int insert_sub(obc_event_entry_t *e, obc_event_handler_fn fn, int priority)
 {
@@ -111,6 +185,7 @@ static int insert_sub(obc_event_entry_t *e, obc_event_handler_fn fn, int priorit
     e->subs[insert].fn       = fn;
     e->subs[insert].priority = priority;
     e->sub_count++;
+    obc_event_subscribed[e - g_events] = true;
     return 0;
 }
 
@@ -124,6 +199,7 @@ static void remove_sub(obc_event_entry_t *e, obc_event_handler_fn fn)
                 memmove(&e->subs[i], &e->subs[i + 1],
                         (size_t)tail * sizeof(obc_event_sub_t));
             e->sub_count--;
+            obc_event_subscribed[e - g_events] = e->sub_count > 0;
             return;
         }
     }
@@ -162,7 +238,12 @@ void obc_event_bus_init(void)
     }
 
     memset(g_events, 0, sizeof(g_events));
+    memset(g_event_hash, 0, sizeof(g_event_hash));
+    memset(obc_event_subscribed, 0, sizeof(obc_event_subscribed));
     g_event_count = 0;
+    memset(g_post, 0, sizeof(g_post));
+    memset(&g_post_stats, 0, sizeof(g_post_stats));
+    g_post_cur = 0;
 }
 
 void obc_event_bus_shutdown(void)
@@ -173,19 +254,32 @@ void obc_event_bus_shutdown(void)
     }
 
     memset(g_events, 0, sizeof(g_events));
+    memset(g_event_hash, 0, sizeof(g_event_hash));
+    memset(obc_event_subscribed, 0, sizeof(obc_event_subscribed));
     g_event_count = 0;
+    memset(g_post, 0, sizeof(g_post));
+    memset(&g_post_stats, 0, sizeof(g_post_stats));
+    g_post_cur = 0;
 }
 
-int obc_event_subscribe(const char *event_name, obc_event_handler_fn fn,
-                        int priority)
+obc_event_id_t obc_event_register(const char *event_name)
+{
+    obc_event_entry_t *e = find_or_create_entry(event_name);
+    return e ? (obc_event_id_t)(e - g_events) : OBC_EVENT_ID_INVALID;
+}
+
+const char *obc_event_id_name(obc_event_id_t id)
+{
+    obc_event_entry_t *e = entry_by_id(id);
+    return e ? e->name : NULL;
+}
+
+static int subscribe_entry(obc_event_entry_t *e, obc_event_handler_fn fn,
+                           int priority)
 {
-    if (!validate_event_name(event_name, NULL) || !fn) return -1;
     if (priority < 0)   priority = 0;
     if (priority > 255) priority = 255;
 
-    obc_event_entry_t *e = find_or_create_entry(event_name);
-    if (!e) return -1;
-
     if (e->fire_depth > 0) {
         /* Defer addition: we're currently iterating subs for this event.
          * The new handler will be inserted after the fire cycle completes
@@ -200,13 +294,25 @@ int obc_event_subscribe(const char *event_name, obc_event_handler_fn fn,
     return insert_sub(e, fn, priority);
 }
 
-void obc_event_unsubscribe(const char *event_name, obc_event_handler_fn fn)
+int obc_event_subscribe(const char *event_name, obc_event_handler_fn fn,
+                        int priority)
 {
-    if (!validate_event_name(event_name, NULL) || !fn) return;
+    if (!fn) return -1;
+    obc_event_entry_t *e = find_or_create_entry(event_name);
+    if (!e) return -1;
+    return subscribe_entry(e, fn, priority);
+}
 
-    obc_event_entry_t *e = find_entry(event_name);
-    if (!e) return;
+int obc_event_subscribe_id(obc_event_id_t id, obc_event_handler_fn fn,
+                           int priority)
+{
+    obc_event_entry_t *e = entry_by_id(id);
+    if (!e || !fn) return -1;
+    return subscribe_entry(e, fn, priority);
+}
 
+static void unsubscribe_entry(obc_event_entry_t *e, obc_event_handler_fn fn)
+{
     if (e->fire_depth > 0) {
         /* Defer removal: we're currently iterating subs for this event. */
         if (e->remove_count < OBC_EVENT_MAX_SUBS)
@@ -217,16 +323,27 @@ void obc_event_unsubscribe(const char *event_name, obc_event_handler_fn fn)
     remove_sub(e, fn);
 }
 
-obc_event_result_t obc_event_fire(const obc_engine_api_t *api,
-                                   const char             *event_name,
-                                   int                     sender_slot,
-                                   const void             *data)
+void obc_event_unsubscribe(const char *event_name, obc_event_handler_fn fn)
 {
-    obc_event_result_t result = { false, false };
-    if (!validate_event_name(event_name, NULL)) return result;
-
+    if (!fn) return;
     obc_event_entry_t *e = find_entry(event_name);
-    if (!e || e->sub_count == 0) return result;
+    if (e) unsubscribe_entry(e, fn);
+}
+
+void obc_event_unsubscribe_id(obc_event_id_t id, obc_event_handler_fn fn)
+{
+    obc_event_entry_t *e = entry_by_id(id);
+    if (e && fn) unsubscribe_entry(e, fn);
+}
+
+static obc_event_result_t fire_entry(const obc_engine_api_t *api,
+                                     obc_event_entry_t      *e,
+                                     int                     sender_slot,
+                                     const void             *data,
+                                     int                     post_count)
+{
+    obc_event_result_t result = { false, false };
+    if (e->sub_count == 0) return result;
 
     if (e->fire_depth >= OBC_EVENT_MAX_FIRE_DEPTH) {
         result.cancelled = true;
@@ -234,11 +351,12 @@ obc_event_result_t obc_event_fire(const obc_engine_api_t *api,
     }
 
     obc_event_ctx_t ctx;
-    ctx.event_name     = event_name;
+    ctx.event_name     = e->name;
     ctx.sender_slot    = sender_slot;
     ctx.event_data     = data;
     ctx.cancelled      = false;
     ctx.suppress_relay = false;
+    ctx.post_count     = post_count;
 
     bool cancelled_latched = false;
     bool suppress_latched  = false;
@@ -275,3 +393,152 @@ obc_event_result_t obc_event_fire(const obc_engine_api_t *api,
 
     return result;
 }
+
+obc_event_result_t obc_event_fire(const obc_engine_api_t *api,
+                                   const char             *event_name,
+                                   int                     sender_slot,
+                                   const void             *data)
+{
+    obc_event_entry_t *e = find_entry(event_name);
+    if (!e) {
+        obc_event_result_t none = { false, false };
+        return none;
+    }
+    return fire_entry(api, e, sender_slot, data, 0);
+}
+
+obc_event_result_t obc_event_fire_id(const obc_engine_api_t *api,
+                                      obc_event_id_t          id,
+                                      int                     sender_slot,
+                                      const void             *data)
+{
+    obc_event_entry_t *e = entry_by_id(id);
+    if (!e) {
+        obc_event_result_t none = { false, false };
+        return none;
+    }
+    return fire_entry(api, e, sender_slot, data, 0);
+}
+
+/* --- Deferred queue ------------------------------------------------------- */
+
+static u32 post_hash(obc_event_id_t id, int sender_slot)
+{
+    u32 h = (u32)id * 0x9E3779B1u ^ (u32)(sender_slot + 1) * 0x85EBCA77u;
+    return (h ^ (h >> 15)) & (OBC_EVENT_POST_HASH - 1);
+}
+
+/* Reserve len bytes (rounded up to 8) in q->data. Returns the offset in
+ * u64 units, or -1 if the payload area is full. */
+static int post_alloc(obc_event_post_queue_t *q, int len)
+{
+    u32 units = ((u32)len + 7u) / 8u;
+    if (q->used + units > OBC_EVENT_QUEUE_BYTES / 8) return -1;
+    u32 off = q->used;
+    q->used += units;
+    return (int)off;
+}
+
+int obc_event_post(obc_event_id_t id, int sender_slot,
+                   const void *data, int data_len, int flags)
+{
+    if (!entry_by_id(id) || data_len < 0 ||
+        data_len > OBC_EVENT_POST_MAX_DATA || (data_len > 0 && !data)) {
+        g_post_stats.dropped++;
+        return OBC_EVENT_POST_DROPPED;
+    }
+    if (!obc_event_subscribed[id]) {
+        g_post_stats.skipped++;
+        return OBC_EVENT_POST_MERGED;
+    }
+
+    obc_event_post_queue_t *q = &g_post[g_post_cur];
+    bool coalesce = (flags & OBC_EVENT_POST_COALESCE) != 0;
+    u32 h = 0;
+
+    if (coalesce) {
+        /* Linear probe over the key index; stops at the first empty slot */
+        for (h = post_hash(id, sender_slot); q->index[h] != 0;
+             h = (h + 1) & (OBC_EVENT_POST_HASH - 1)) {
+            obc_event_post_t *p = &q->items[q->index[h] - 1];
+            if (p->id != id || p->sender_slot != sender_slot) continue;
+
+            /* Latest payload wins; reuse the chunk when it fits */
+            if (data_len > p->cap) {
+                int off = post_alloc(q, data_len);
+                if (off < 0) {
+                    g_post_stats.dropped++;
+                    return OBC_EVENT_POST_DROPPED;
+                }
+                p->off = (u32)off;
+                p->cap = (u16)data_len;
+            }
+            if (data_len > 0) memcpy(&q->data[p->off], data, (size_t)data_len);
+            p->len = (u16)data_len;
+            p->count++;
+            g_post_stats.posted++;
+            g_post_stats.coalesced++;
+            return OBC_EVENT_POST_MERGED;
+        }
+    }
+
+    if (q->count >= OBC_EVENT_QUEUE_MAX) {
+        g_post_stats.dropped++;
+        return OBC_EVENT_POST_DROPPED;
+    }
+    int off = post_alloc(q, data_len);
+    if (off < 0) {
+        g_post_stats.dropped++;
+        return OBC_EVENT_POST_DROPPED;
+    }
+
+    obc_event_post_t *p = &q->items[q->count];
+    p->id          = id;
+    p->sender_slot = sender_slot;
+    p->off         = (u32)off;
+    p->len         = (u16)data_len;
+    p->cap         = (u16)data_len;
+    p->count       = 1;
+    p->coalesce    = coalesce;
+    if (data_len > 0) memcpy(&q->data[off], data, (size_t)data_len);
+    q->count++;
+    if (coalesce) q->index[h] = (i16)q->count;   /* item + 1 */
+
+    g_post_stats.posted++;
+    if (q->count > g_post_stats.peak_depth) g_post_stats.peak_depth = q->count;
+    return OBC_EVENT_POST_QUEUED;
+}
+
+int obc_event_queue_drain(const obc_engine_api_t *api)
+{
+    obc_event_post_queue_t *q = &g_post[g_post_cur];
+    if (q->count == 0) return 0;
+
+    /* New posts (from handlers below) go to the other buffer */
+    g_post_cur ^= 1;
+    obc_event_post_queue_t *next = &g_post[g_post_cur];
+    next->count = 0;
+    next->used  = 0;
+    memset(next->index, 0, sizeof(next->index));
+
+    int n = q->count;
+    for (int i = 0; i < n; i++) {
+        const obc_event_post_t *p = &q->items[i];
+        obc_event_entry_t *e = entry_by_id(p->id);
+        if (!e) continue;
+        fire_entry(api, e, p->sender_slot,
+                   p->len > 0 ? (const void *)&q->data[p->off] : NULL,
+                   p->count);
+    }
+    q->count = 0;
+    q->used  = 0;
+    memset(q->index, 0, sizeof(q->index));
+    g_post_stats.dispatched += (unsigned)n;
+    return n;
+}
+
+void obc_event_queue_stats(obc_event_queue_stats_t *out)
+{
+    *out = g_post_stats;
+    out->depth = g_post[g_post_cur].count;
+}
@@ -0,0 +1,74 @@
+#include "openbc/frame_arena.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void bc_arena_init(bc_arena_t *a, void *buf, size_t cap)
+{
+    memset(a, 0, sizeof(*a));
+    a->base   = (u8 *)buf;
+    a->cap    = buf ? cap : 0;
+    a->poison = BC_ARENA_POISON_DEFAULT;
+    if (a->poison && a->base) memset(a->base, BC_ARENA_DEAD, a->cap);
+}
+
+void *bc_arena_alloc_align(bc_arena_t *a, size_t size, size_t align)
+{
+    if (size == 0 || align == 0 || (align & (align - 1)) != 0) return NULL;
+
+    /* Align the address, not the offset: base need not be aligned */
+    uintptr_t at  = (uintptr_t)(a->base + a->used);
+    size_t    pad = (size_t)((align - (at & (align - 1))) & (align - 1));
+    if (pad > a->cap - a->used || size > a->cap - a->used - pad) {
+        a->failed++;
+        return NULL;
+    }
+
+    u8 *p = a->base + a->used + pad;
+    a->used += pad + size;
+    if (a->used > a->peak) a->peak = a->used;
+    if (a->poison) memset(p, BC_ARENA_FRESH, size);
+    return p;
+}
+
+void *bc_arena_alloc(bc_arena_t *a, size_t size)
+{
+    return bc_arena_alloc_align(a, size, BC_ARENA_ALIGN);
+}
+
+char *bc_arena_vprintf(bc_arena_t *a, const char *fmt, va_list ap)
+{
+    va_list ap2;
+    va_copy(ap2, ap);
+    int n = vsnprintf(NULL, 0, fmt, ap2);
+    va_end(ap2);
+    if (n < 0) return NULL;
+
+    char *s = bc_arena_alloc_align(a, (size_t)n + 1, 1);
+    if (!s) return NULL;
+    vsnprintf(s, (size_t)n + 1, fmt, ap);
+    return s;
+}
+
+char *bc_arena_printf(bc_arena_t *a, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    char *s = bc_arena_vprintf(a, fmt, ap);
+    va_end(ap);
+    return s;
+}
+
+void bc_arena_release(bc_arena_t *a, size_t mark)
+{
+    if (mark >= a->used) return;
+    if (a->poison) memset(a->base + mark, BC_ARENA_DEAD, a->used - mark);
+    a->used = mark;
+}
+
+void bc_arena_reset(bc_arena_t *a)
+{
+    a->last_frame = a->used;
+    a->frames++;
+    bc_arena_release(a, 0);
+}
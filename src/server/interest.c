@@ -0,0 +1,73 @@
+#include "openbc/interest.h"
+
+#include <math.h>
+#include <string.h>
+
+void bc_interest_cfg_defaults(bc_interest_cfg_t *cfg)
+{
+    cfg->enabled   = true;
+    cfg->near_dist = BC_INTEREST_DEFAULT_NEAR;
+    cfg->far_dist  = BC_INTEREST_DEFAULT_FAR;
+    cfg->min_rate  = BC_INTEREST_DEFAULT_MIN_RATE;
+}
+
+void bc_interest_init(bc_interest_t *st)
+{
+    memset(st, 0, sizeof(*st));
+}
+
+void bc_interest_reset_slot(bc_interest_t *st, int slot)
+{
+    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    for (int i = 0; i < BC_MAX_PLAYERS; i++) {
+        st->accum[slot][i] = 0.0f;
+        st->accum[i][slot] = 0.0f;
+    }
+}
+
+f32 bc_interest_weight(const bc_interest_cfg_t *cfg,
+                       const bc_ship_state_t *observer,
+                       const bc_ship_state_t *subject)
+{
+    f32 floor_w = cfg->min_rate;
+    if (floor_w < 0.0f) floor_w = 0.0f;
+    if (floor_w > 1.0f) floor_w = 1.0f;
+
+    if (!observer || !subject) return 1.0f;
+
+    /* A fully cloaked ship is invisible; observers only need enough
+     * traffic to keep the object alive client-side. Transitions are
+     * visible (shimmer), so they keep the distance weight. */
+    if (subject->cloak_state == BC_CLOAK_CLOAKED) return floor_w;
+
+    f32 dx = subject->pos.x - observer->pos.x;
+    f32 dy = subject->pos.y - observer->pos.y;
+    f32 dz = subject->pos.z - observer->pos.z;
+    f32 d2 = dx*dx + dy*dy + dz*dz;
+
+    f32 near_d = cfg->near_dist;
+    f32 far_d  = cfg->far_dist;
+    if (d2 <= near_d * near_d) return 1.0f;
+    if (far_d <= near_d || d2 >= far_d * far_d) return floor_w;
+
+    /* Linear falloff from 1.0 at near_dist to floor_w at far_dist */
+    f32 t = (sqrtf(d2) - near_d) / (far_d - near_d);
+    return 1.0f - t * (1.0f - floor_w);
+}
+
+bool bc_interest_should_relay(bc_interest_t *st, const bc_interest_cfg_t *cfg,
+                              int observer, int subject, f32 weight, u8 dirty)
+{
+    if (!cfg->enabled) return true;
+    if (observer < 0 || observer >= BC_MAX_PLAYERS ||
+        subject < 0 || subject >= BC_MAX_PLAYERS) return true;
+
+    f32 *acc = &st->accum[observer][subject];
+    *acc += weight;
+    if (*acc >= 1.0f) {
+        *acc -= 1.0f;
+        if (*acc >= 1.0f) *acc = 0.0f;  /* weight > 1 never banks credit */
+        return true;
+    }
+    return (dirty & BC_INTEREST_KEYFRAME_MASK) != 0;
+}
@@ -0,0 +1,526 @@
+#include "openbc/job_pool.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#  ifndef _WIN32_WINNT
+#    define _WIN32_WINNT 0x0600   /* CONDITION_VARIABLE (Vista+) */
+#  endif
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+/* --- Platform threads ---------------------------------------------------- */
+
+#ifdef _WIN32
+typedef HANDLE             job_thread_t;
+typedef CRITICAL_SECTION   job_mutex_t;
+typedef CONDITION_VARIABLE job_cond_t;
+
+static void mutex_init(job_mutex_t *m)    { InitializeCriticalSection(m); }
+static void mutex_destroy(job_mutex_t *m) { DeleteCriticalSection(m); }
+static void mutex_lock(job_mutex_t *m)    { EnterCriticalSection(m); }
+static void mutex_unlock(job_mutex_t *m)  { LeaveCriticalSection(m); }
+static void cond_init(job_cond_t *c)      { InitializeConditionVariable(c); }
+static void cond_destroy(job_cond_t *c)   { (void)c; }
+static void cond_wait(job_cond_t *c, job_mutex_t *m)
+{
+    SleepConditionVariableCS(c, m, INFINITE);
+}
+static void cond_signal(job_cond_t *c)    { WakeConditionVariable(c); }
+static void cond_broadcast(job_cond_t *c) { WakeAllConditionVariable(c); }
+static void thread_yield(void)            { SwitchToThread(); }
+#else
+typedef pthread_t       job_thread_t;
+typedef pthread_mutex_t job_mutex_t;
+typedef pthread_cond_t  job_cond_t;
+
+static void mutex_init(job_mutex_t *m)    { pthread_mutex_init(m, NULL); }
+static void mutex_destroy(job_mutex_t *m) { pthread_mutex_destroy(m); }
+static void mutex_lock(job_mutex_t *m)    { pthread_mutex_lock(m); }
+static void mutex_unlock(job_mutex_t *m)  { pthread_mutex_unlock(m); }
+static void cond_init(job_cond_t *c)      { pthread_cond_init(c, NULL); }
+static void cond_destroy(job_cond_t *c)   { pthread_cond_destroy(c); }
+static void cond_wait(job_cond_t *c, job_mutex_t *m)
+{
+    pthread_cond_wait(c, m);
+}
+static void cond_signal(job_cond_t *c)    { pthread_cond_signal(c); }
+static void cond_broadcast(job_cond_t *c) { pthread_cond_broadcast(c); }
+static void thread_yield(void)            { sched_yield(); }
+#endif
+
+/* --- Pool state ---------------------------------------------------------- */
+
+/*
+ * Slot states. FREE and PENDING change under the pool lock; a worker moves
+ * a job to ACTIVE under the lock and it stays ACTIVE until bc_job_poll()
+ * delivers it and returns the slot to FREE (game thread, after popping the
+ * job from the completion queue, which orders it after the worker's push).
+ */
+enum { JOB_FREE, JOB_PENDING, JOB_ACTIVE };
+
+/* Intrusive MPSC link; first member of job_t so a node is its job. */
+typedef struct job_node {
+    _Atomic(struct job_node *) next;
+} job_node_t;
+
+typedef struct {
+    job_node_t     node;
+    bc_job_run_fn  run;
+    bc_job_done_fn done;
+    void          *arg;
+    atomic_int     cancel;
+    bool           finished;    /* run() returned before any cancel */
+    int            group;
+    int            state;
+    int            pend_next;   /* pending FIFO, free list or deferred
+                                 * completions link */
+    u16            gen;
+} job_t;
+
+typedef struct {
+    int max_running;   /* lock */
+    int running;       /* lock */
+    int max_queued;    /* game thread */
+    int outstanding;   /* game thread */
+} job_group_t;
+
+struct bc_job_pool {
+    job_t          jobs[BC_JOB_MAX];
+    int            free_head;             /* game thread; linked via pend_next */
+    job_group_t    groups[BC_JOB_MAX_GROUPS];
+
+    job_mutex_t    lock;
+    job_cond_t     work_cv;               /* pending work or stop */
+    job_cond_t     idle_cv;               /* a job finished running */
+    int            pend_head, pend_tail;  /* lock */
+    bool           stopping;              /* lock */
+
+    /* Completion queue (Vyukov intrusive MPSC): producers exchange head,
+     * the game thread consumes from tail. */
+    _Atomic(job_node_t *) done_head;
+    job_node_t    *done_tail;
+    job_node_t     stub;
+
+    /* Completions popped by bc_job_cancel_group for other groups, kept in
+     * order for the next bc_job_poll (game thread; linked via pend_next) */
+    int            defer_head, defer_tail;
+
+    job_thread_t   threads[BC_JOB_MAX_WORKERS];
+    int            worker_count;
+    bc_job_stats_t stats;                 /* game thread */
+};
+
+/* --- Completion queue ---------------------------------------------------- */
+
+static void done_push(bc_job_pool_t *p, job_node_t *n)
+{
+    atomic_store_explicit(&n->next, NULL, memory_order_relaxed);
+    job_node_t *prev = atomic_exchange_explicit(&p->done_head, n,
+                                                memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, n, memory_order_release);
+}
+
+/* Pop the oldest completion, or NULL if empty (or a producer is between
+ * its exchange and its link; the node shows up on a later poll). */
+static job_t *done_pop(bc_job_pool_t *p)
+{
+    job_node_t *tail = p->done_tail;
+    job_node_t *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (tail == &p->stub) {
+        if (!next) return NULL;
+        p->done_tail = next;
+        tail = next;
+        next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    }
+    if (next) {
+        p->done_tail = next;
+        return (job_t *)tail;
+    }
+    if (tail != atomic_load_explicit(&p->done_head, memory_order_acquire))
+        return NULL;
+    done_push(p, &p->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        p->done_tail = next;
+        return (job_t *)tail;
+    }
+    return NULL;
+}
+
+/* --- Workers ------------------------------------------------------------- */
+
+static int make_id(const bc_job_pool_t *p, int idx)
+{
+    return (int)(((u32)p->jobs[idx].gen << BC_JOB_INDEX_BITS) | (u32)idx);
+}
+
+/* Unlink and return the oldest pending job whose group has a free running
+ * slot, or -1. Caller holds the lock. */
+static int take_pending(bc_job_pool_t *p)
+{
+    int prev = -1;
+    for (int i = p->pend_head; i >= 0; prev = i, i = p->jobs[i].pend_next) {
+        job_group_t *g = &p->groups[p->jobs[i].group];
+        if (g->running >= g->max_running) continue;
+        if (prev >= 0) p->jobs[prev].pend_next = p->jobs[i].pend_next;
+        else           p->pend_head = p->jobs[i].pend_next;
+        if (p->pend_tail == i) p->pend_tail = prev;
+        p->jobs[i].pend_next = -1;
+        return i;
+    }
+    return -1;
+}
+
+static void worker_loop(bc_job_pool_t *p)
+{
+    mutex_lock(&p->lock);
+    while (!p->stopping) {
+        int idx = take_pending(p);
+        if (idx < 0) {
+            cond_wait(&p->work_cv, &p->lock);
+            continue;
+        }
+        job_t *j = &p->jobs[idx];
+        int group = j->group;
+        j->state = JOB_ACTIVE;
+        p->groups[group].running++;
+        mutex_unlock(&p->lock);
+
+        j->run(j->arg, make_id(p, idx));
+        /* A cancel after this point found the work already done */
+        j->finished = !atomic_load_explicit(&j->cancel, memory_order_relaxed);
+        done_push(p, &j->node);   /* last touch of j: poll may recycle it */
+
+        mutex_lock(&p->lock);
+        p->groups[group].running--;
+        cond_broadcast(&p->idle_cv);
+        /* A group just dropped below its limit: its next job may be
+         * runnable by a sleeping worker */
+        if (p->pend_head >= 0) cond_broadcast(&p->work_cv);
+    }
+    mutex_unlock(&p->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID arg)
+{
+    worker_loop((bc_job_pool_t *)arg);
+    return 0;
+}
+#else
+static void *worker_main(void *arg)
+{
+    worker_loop((bc_job_pool_t *)arg);
+    return NULL;
+}
+#endif
+
+static bool thread_start(bc_job_pool_t *p, job_thread_t *t)
+{
+#ifdef _WIN32
+    *t = CreateThread(NULL, 0, worker_main, p, 0, NULL);
+    return *t != NULL;
+#else
+    return pthread_create(t, NULL, worker_main, p) == 0;
+#endif
+}
+
+static void thread_join(job_thread_t t)
+{
+#ifdef _WIN32
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+#else
+    pthread_join(t, NULL);
+#endif
+}
+
+/* --- Public API ---------------------------------------------------------- */
+
+bc_job_pool_t *bc_job_pool_create(int workers)
+{
+    if (workers < 1) workers = 1;
+    if (workers > BC_JOB_MAX_WORKERS) workers = BC_JOB_MAX_WORKERS;
+
+    bc_job_pool_t *p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+
+    for (int i = 0; i < BC_JOB_MAX; i++) {
+        p->jobs[i].state = JOB_FREE;
+        p->jobs[i].pend_next = i + 1 < BC_JOB_MAX ? i + 1 : -1;
+    }
+    p->free_head = 0;
+    p->pend_head = p->pend_tail = -1;
+    p->defer_head = p->defer_tail = -1;
+    for (int g = 0; g < BC_JOB_MAX_GROUPS; g++) {
+        p->groups[g].max_running = BC_JOB_DEFAULT_MAX_RUNNING;
+        p->groups[g].max_queued  = BC_JOB_DEFAULT_MAX_QUEUED;
+    }
+    atomic_store(&p->stub.next, NULL);
+    atomic_store(&p->done_head, &p->stub);
+    p->done_tail = &p->stub;
+
+    mutex_init(&p->lock);
+    cond_init(&p->work_cv);
+    cond_init(&p->idle_cv);
+
+    for (int i = 0; i < workers; i++) {
+        if (!thread_start(p, &p->threads[p->worker_count])) break;
+        p->worker_count++;
+    }
+    if (p->worker_count == 0) {
+        cond_destroy(&p->idle_cv);
+        cond_destroy(&p->work_cv);
+        mutex_destroy(&p->lock);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+int bc_job_pool_workers(const bc_job_pool_t *pool)
+{
+    return pool ? pool->worker_count : 0;
+}
+
+void bc_job_group_limit(bc_job_pool_t *pool, int group,
+                        int max_running, int max_queued)
+{
+    if (!pool || group < 0 || group >= BC_JOB_MAX_GROUPS) return;
+    mutex_lock(&pool->lock);
+    pool->groups[group].max_running = max_running < 1 ? 1 : max_running;
+    pool->groups[group].max_queued  = max_queued < 1 ? 1 : max_queued;
+    cond_broadcast(&pool->work_cv);   /* a raised limit may unblock work */
+    mutex_unlock(&pool->lock);
+}
+
+int bc_job_submit(bc_job_pool_t *pool, int group,
+                  bc_job_run_fn run, bc_job_done_fn done, void *arg)
+{
+    if (!pool) return -1;
+    if (!run || group < 0 || group >= BC_JOB_MAX_GROUPS ||
+        pool->groups[group].outstanding >= pool->groups[group].max_queued ||
+        pool->free_head < 0) {
+        pool->stats.rejected++;
+        return -1;
+    }
+
+    int idx = pool->free_head;
+    job_t *j = &pool->jobs[idx];
+    pool->free_head = j->pend_next;
+
+    if (++j->gen == 0) j->gen = 1;   /* keep IDs non-zero */
+    j->run   = run;
+    j->done  = done;
+    j->arg   = arg;
+    j->group = group;
+    j->pend_next = -1;
+    j->finished = false;
+    atomic_store_explicit(&j->cancel, 0, memory_order_relaxed);
+
+    mutex_lock(&pool->lock);
+    j->state = JOB_PENDING;
+    if (pool->pend_tail >= 0) pool->jobs[pool->pend_tail].pend_next = idx;
+    else                      pool->pend_head = idx;
+    pool->pend_tail = idx;
+    cond_signal(&pool->work_cv);
+    mutex_unlock(&pool->lock);
+
+    pool->groups[group].outstanding++;
+    pool->stats.submitted++;
+    pool->stats.outstanding++;
+    if (pool->stats.outstanding > pool->stats.outstanding_peak)
+        pool->stats.outstanding_peak = pool->stats.outstanding;
+    return make_id(pool, idx);
+}
+
+/* Remove a pending job from the FIFO and complete it as cancelled.
+ * Caller holds the lock. */
+static void cancel_pending(bc_job_pool_t *p, int idx)
+{
+    int prev = -1;
+    for (int i = p->pend_head; i >= 0; prev = i, i = p->jobs[i].pend_next) {
+        if (i != idx) continue;
+        if (prev >= 0) p->jobs[prev].pend_next = p->jobs[i].pend_next;
+        else           p->pend_head = p->jobs[i].pend_next;
+        if (p->pend_tail == i) p->pend_tail = prev;
+        break;
+    }
+    job_t *j = &p->jobs[idx];
+    j->pend_next = -1;
+    j->finished = false;
+    j->state = JOB_ACTIVE;   /* never runs; delivered by poll */
+    atomic_store_explicit(&j->cancel, 1, memory_order_relaxed);
+    done_push(p, &j->node);
+}
+
+/* Slot index for a live ID, or -1. Caller holds the lock. */
+static int lookup(const bc_job_pool_t *p, int job_id)
+{
+    if (job_id <= 0) return -1;
+    int idx = bc_job_index(job_id);
+    if (p->jobs[idx].state == JOB_FREE || make_id(p, idx) != job_id) return -1;
+    return idx;
+}
+
+bool bc_job_cancel(bc_job_pool_t *pool, int job_id)
+{
+    if (!pool) return false;
+    mutex_lock(&pool->lock);
+    int idx = lookup(pool, job_id);
+    if (idx < 0) {
+        mutex_unlock(&pool->lock);
+        return false;
+    }
+    if (pool->jobs[idx].state == JOB_PENDING)
+        cancel_pending(pool, idx);
+    else
+        atomic_store_explicit(&pool->jobs[idx].cancel, 1, memory_order_relaxed);
+    mutex_unlock(&pool->lock);
+    return true;
+}
+
+bool bc_job_cancel_requested(const bc_job_pool_t *pool, int job_id)
+{
+    if (!pool || job_id <= 0) return false;
+    const job_t *j = &pool->jobs[bc_job_index(job_id)];
+    return atomic_load_explicit((atomic_int *)&j->cancel,
+                                memory_order_relaxed) != 0;
+}
+
+/* Cancel every job of `group` (all groups if group < 0). Caller holds
+ * the lock. */
+static void cancel_all_locked(bc_job_pool_t *p, int group)
+{
+    for (int i = 0; i < BC_JOB_MAX; i++) {
+        job_t *j = &p->jobs[i];
+        if (j->state == JOB_FREE || (group >= 0 && j->group != group)) continue;
+        if (j->state == JOB_PENDING) cancel_pending(p, i);
+        else atomic_store_explicit(&j->cancel, 1, memory_order_relaxed);
+    }
+}
+
+/* Free a popped job's slot and call its done(). */
+static void deliver(bc_job_pool_t *pool, job_t *j)
+{
+    int idx = (int)(j - pool->jobs);
+    int id = make_id(pool, idx);
+    int status = j->finished ? BC_JOB_DONE : BC_JOB_CANCELLED;
+    bc_job_done_fn done = j->done;
+    void *arg = j->arg;
+
+    /* Free the slot before the callback so it may submit again */
+    pool->groups[j->group].outstanding--;
+    pool->stats.outstanding--;
+    if (status == BC_JOB_DONE) pool->stats.completed++;
+    else                       pool->stats.cancelled++;
+    j->state = JOB_FREE;
+    j->run = NULL;
+    j->done = NULL;
+    j->arg = NULL;
+    j->pend_next = pool->free_head;
+    pool->free_head = idx;
+
+    if (done) done(arg, id, status);
+}
+
+void bc_job_cancel_group(bc_job_pool_t *pool, int group)
+{
+    if (!pool || group < 0 || group >= BC_JOB_MAX_GROUPS) return;
+    mutex_lock(&pool->lock);
+    cancel_all_locked(pool, group);
+    while (pool->groups[group].running > 0)
+        cond_wait(&pool->idle_cv, &pool->lock);
+    mutex_unlock(&pool->lock);
+
+    /* Deliver this group's earlier deferred completions */
+    int prev = -1;
+    for (int i = pool->defer_head; i >= 0; ) {
+        int next = pool->jobs[i].pend_next;
+        if (pool->jobs[i].group == group) {
+            if (prev >= 0) pool->jobs[prev].pend_next = next;
+            else           pool->defer_head = next;
+            if (pool->defer_tail == i) pool->defer_tail = prev;
+            deliver(pool, &pool->jobs[i]);
+        } else {
+            prev = i;
+        }
+        i = next;
+    }
+
+    /* Every push for this group is done, but one may sit behind another
+     * worker's half-finished push; pop until the group is empty. Other
+     * groups' completions wait, in order, for the next bc_job_poll. */
+    while (pool->groups[group].outstanding > 0) {
+        job_t *j = done_pop(pool);
+        if (!j) {
+            thread_yield();
+            continue;
+        }
+        if (j->group == group) {
+            deliver(pool, j);
+            continue;
+        }
+        int idx = (int)(j - pool->jobs);
+        j->pend_next = -1;
+        if (pool->defer_tail >= 0) pool->jobs[pool->defer_tail].pend_next = idx;
+        else                       pool->defer_head = idx;
+        pool->defer_tail = idx;
+    }
+}
+
+int bc_job_poll(bc_job_pool_t *pool, int max)
+{
+    if (!pool) return 0;
+    int n = 0;
+    while (max <= 0 || n < max) {
+        job_t *j;
+        if (pool->defer_head >= 0) {
+            j = &pool->jobs[pool->defer_head];
+            pool->defer_head = j->pend_next;
+            if (pool->defer_head < 0) pool->defer_tail = -1;
+        } else {
+            j = done_pop(pool);
+            if (!j) break;
+        }
+        deliver(pool, j);
+        n++;
+    }
+    return n;
+}
+
+void bc_job_stats(const bc_job_pool_t *pool, bc_job_stats_t *out)
+{
+    if (!pool) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    *out = pool->stats;
+}
+
+void bc_job_pool_destroy(bc_job_pool_t *pool)
+{
+    if (!pool) return;
+    mutex_lock(&pool->lock);
+    cancel_all_locked(pool, -1);
+    pool->stopping = true;
+    cond_broadcast(&pool->work_cv);
+    mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->worker_count; i++)
+        thread_join(pool->threads[i]);
+
+    /* Workers are gone, so every push is complete */
+    bc_job_poll(pool, 0);
+
+    cond_destroy(&pool->idle_cv);
+    cond_destroy(&pool->work_cv);
+    mutex_destroy(&pool->lock);
+    free(pool);
+}
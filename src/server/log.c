@@ -27,6 +27,23 @@ u32 bc_ms_now(void)
 #endif
 }
 
+u32 bc_us_now(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    /* Split to keep counter * 1e6 from overflowing on long uptimes */
+    u64 q = (u64)now.QuadPart, f = (u64)freq.QuadPart;
+    return (u32)((q / f) * 1000000u + (q % f) * 1000000u / f);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u32)((u64)ts.tv_sec * 1000000u + (u64)ts.tv_nsec / 1000u);
+#endif
+}
+
 static const char *level_names[] = {
     "QUIET", "ERROR", "WARN ", "INFO ", "DEBUG", "TRACE"
 };
@@ -9,6 +9,7 @@
 #include "openbc/server_handshake.h"
 #include "openbc/server_dispatch.h"
 #include "openbc/server_stats.h"
+#include "openbc/server_bots.h"
 #include "openbc/transport.h"
 #include "openbc/cipher.h"
 #include "openbc/gamespy.h"
@@ -19,12 +20,15 @@
 #include "openbc/ship_state.h"
 #include "openbc/ship_power.h"
 #include "openbc/combat.h"
+#include "openbc/registry_cache.h"
+#include "openbc/data_reload.h"
 #include "openbc/torpedo_tracker.h"
 #include "openbc/game_builders.h"
 #include "openbc/config.h"
 #include "openbc/log.h"
 #include "openbc/module_loader.h"
 #include "openbc/event_bus.h"
+#include "openbc/server_events.h"
 
 #ifdef _WIN32
 #  include <windows.h>  /* For Sleep(), GetTickCount() */
@@ -39,6 +43,10 @@
 
 static obc_module_loader_t g_module_loader;
 
+/* --- Live data reload --- */
+
+static bc_reload_t g_reload;
+
 /* --- Signal handler --- */
 
 #ifdef _WIN32
@@ -69,6 +77,15 @@ static void posix_signal_handler(int sig)
     (void)sig;
     g_running = false;
 }
+
+/* SIGHUP: reload registry and manifest at the next tick */
+static volatile sig_atomic_t g_reload_signal;
+
+static void posix_reload_handler(int sig)
+{
+    (void)sig;
+    g_reload_signal = 1;
+}
 #endif
 
 /* --- Main --- */
@@ -92,8 +109,13 @@ static void usage(const char *prog)
         "  --no-collision     Disable collision damage\n"
         "  --friendly-fire    Enable friendly fire\n"
         "  --no-friendly-fire Disable friendly fire (default)\n"
+        "  --no-interest      Relay every StateUpdate to every peer (no thinning)\n"
         "  --data <path>      Ship data registry versioned directory\n"
         "                     (e.g. data/vanilla-1.1/)\n"
+        "  --registry-cache <path>\n"
+        "                     Keep a compiled registry cache in this file\n"
+        "  --no-registry-cache\n"
+        "                     Always parse the registry JSON (ignore [data] registry_cache)\n"
         "  --manifest <path>  Hash manifest JSON (e.g. manifests/vanilla-1.1.json)\n"
         "  --master <h:p>     Master server address (repeatable; replaces defaults)\n"
         "  --no-master        Disable all master server heartbeating\n"
@@ -136,7 +158,7 @@ static bool mode_is_team_from_file(const char *path, const char *map_name,
     char json_text[2048];
     if (!read_small_text_file(path, json_text, sizeof(json_text))) return false;
 
-    json_value_t *root = json_parse(json_text);
+    json_value_t *root = json_parse_insitu(json_text);
     if (!root) return false;
 
     bool found = false;
@@ -170,15 +192,103 @@ static bool mode_is_team(const char *map_name)
            strstr(map_name, "Mission3") != NULL;
 }
 
+/* Once a second (timer): retransmit unACKed reliables, drop dead or
+ * silent peers, master server heartbeat. */
+static void housekeeping_tick(void *user, int timer_id)
+{
+    (void)user; (void)timer_id;
+    u32 now = bc_ms_now();
+
+    /* Retransmit unACKed reliable messages (skip slot 0 = dedi).
+     * Walk a snapshot of the live list: disconnects below
+     * compact g_peers.active while we iterate. */
+    u8 live[BC_MAX_PLAYERS];
+    int live_n = g_peers.active_count;
+    memcpy(live, g_peers.active, (size_t)live_n);
+    for (int k = 0; k < live_n; k++) {
+        int i = live[k];
+        if (i == 0) continue;
+        bc_peer_t *peer = &g_peers.peers[i];
+        if (peer->state == PEER_EMPTY) continue;
+
+        /* Check for dead peers (max retries exceeded) */
+        if (bc_reliable_check_timeout(&peer->reliable_out)) {
+            char addr_str[32];
+            bc_addr_to_string(&peer->addr, addr_str, sizeof(addr_str));
+            LOG_INFO("net", "Peer %s (slot %d) timed out (no ACK)",
+                     addr_str, i);
+            bc_handle_peer_disconnect(i);
+            continue;
+        }
+
+        /* Retransmit overdue messages (direct send, not via outbox) */
+        int idx;
+        while ((idx = bc_reliable_check_retransmit(
+                    &peer->reliable_out, now)) >= 0) {
+            g_stats.reliable_retransmits++;
+            bc_reliable_entry_t *e = &peer->reliable_out.entries[idx];
+            u8 pkt[BC_MAX_PACKET_SIZE];
+            int len = bc_transport_build_reliable(
+                pkt, sizeof(pkt), e->payload, e->payload_len, e->seq);
+            if (len > 0) {
+                bc_packet_t trace;
+                if (bc_transport_parse(pkt, len, &trace))
+                    bc_log_packet_trace(&trace, i, "RTXM");
+                alby_cipher_encrypt(pkt, (size_t)len);
+                bc_socket_send(&g_socket, &peer->addr, pkt, len);
+            }
+        }
+    }
+
+    /* Timeout stale peers (skip slot 0 = dedi) */
+    live_n = g_peers.active_count;
+    memcpy(live, g_peers.active, (size_t)live_n);
+    for (int k = 0; k < live_n; k++) {
+        int i = live[k];
+        if (i == 0) continue;
+        if (g_peers.peers[i].state == PEER_EMPTY) continue;
+        if (now - g_peers.peers[i].last_recv_time > 30000) {
+            g_stats.timeouts++;
+            LOG_INFO("net", "Peer slot %d timed out (no packets)", i);
+            bc_handle_peer_disconnect(i);
+        }
+    }
+
+    /* Master server heartbeat */
+    bc_master_tick(&g_masters, &g_socket, now);
+}
+
+/* Once a second (timer): send keepalive to all active peers.
+ * Stock dedi echoes the client's identity data (22 bytes) back
+ * instead of sending a minimal [0x00][0x02] keepalive. */
+static void keepalive_tick(void *user, int timer_id)
+{
+    (void)user; (void)timer_id;
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
+        bc_peer_t *peer = &g_peers.peers[i];
+        if (peer->state < PEER_LOBBY) continue;
+        if (peer->keepalive_len > 0) {
+            bc_outbox_add_keepalive_data(&peer->outbox,
+                                          peer->keepalive_data,
+                                          peer->keepalive_len);
+        } else {
+            bc_outbox_add_keepalive(&peer->outbox);
+        }
+    }
+}
+
 int main(int argc, char **argv)
 {
     /* Defaults */
     u16 port = BC_DEFAULT_PORT;
     const char *name = "OpenBC Server";
     const char *map = "Multiplayer.Episode.Mission1.Mission1";
-    int max_players = BC_MAX_PLAYERS;
+    int max_players = BC_STOCK_PEER_SLOTS;
     const char *manifest_path = NULL;
     const char *data_path = NULL;
+    const char *registry_cache = NULL;
     const char *user_masters[BC_MAX_MASTERS];
     int user_master_count = 0;
     bool cli_master_seen = false;
@@ -218,11 +328,17 @@ int main(int argc, char **argv)
     g_frag_limit  = g_server_cfg.frag_limit;
     g_collision_dmg  = g_server_cfg.collision_damage;
     g_friendly_fire  = g_server_cfg.friendly_fire;
+    g_interest_cfg.enabled   = g_server_cfg.interest_enabled;
+    g_interest_cfg.near_dist = (f32)g_server_cfg.interest_near;
+    g_interest_cfg.far_dist  = (f32)g_server_cfg.interest_far;
+    g_interest_cfg.min_rate  = (f32)g_server_cfg.interest_min_rate;
 
     if (g_server_cfg.manifest_path[0])
         manifest_path = g_server_cfg.manifest_path;
     if (g_server_cfg.registry[0])
         data_path = g_server_cfg.registry;
+    if (g_server_cfg.registry_cache[0])
+        registry_cache = g_server_cfg.registry_cache;
 
     for (int ci = 0; ci < g_server_cfg.master_count &&
                      user_master_count < BC_MAX_MASTERS; ci++) {
@@ -260,6 +376,10 @@ int main(int argc, char **argv)
             g_use_score_limit = false;
         } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
             data_path = argv[++i];
+        } else if (strcmp(argv[i], "--registry-cache") == 0 && i + 1 < argc) {
+            registry_cache = argv[++i];
+        } else if (strcmp(argv[i], "--no-registry-cache") == 0) {
+            registry_cache = NULL;
         } else if (strcmp(argv[i], "--manifest") == 0 && i + 1 < argc) {
             manifest_path = argv[++i];
         } else if (strcmp(argv[i], "--collision") == 0) {
@@ -270,6 +390,8 @@ int main(int argc, char **argv)
             g_friendly_fire = true;
         } else if (strcmp(argv[i], "--no-friendly-fire") == 0) {
             g_friendly_fire = false;
+        } else if (strcmp(argv[i], "--no-interest") == 0) {
+            g_interest_cfg.enabled = false;
         } else if (strcmp(argv[i], "--master") == 0 && i + 1 < argc) {
             /* First CLI --master replaces any masters loaded from server.toml. */
             if (!cli_master_seen) {
@@ -409,11 +531,20 @@ int main(int argc, char **argv)
         g_no_checksum = true;
     }
 
+    /* Validated-response cache; starts empty against this manifest */
+    if (!bc_checksum_cache_init(&g_checksum_cache, g_server_cfg.checksum_cache))
+        LOG_WARN("init", "Checksum cache allocation failed; caching disabled");
+
     /* Load ship data registry for server-authoritative damage.
      * Accepts both a versioned directory (contains manifest.json) and a
      * legacy monolith JSON file.  If --data was not given, scan data/ for
      * a directory with manifest.json first, then fall back to a lone .json. */
-    memset(&g_registry, 0, sizeof(g_registry));
+    g_registry = calloc(1, sizeof(*g_registry));
+    if (!g_registry) {
+        LOG_ERROR("init", "Out of memory allocating the ship registry");
+        bc_log_shutdown();
+        return 1;
+    }
     bc_torpedo_mgr_init(&g_torpedoes);
 
     bool data_is_dir = false;
@@ -516,13 +647,22 @@ int main(int argc, char **argv)
     }
 
     if (data_path) {
+        /* Versioned directories may go through the opt-in compiled
+         * cache: a hit skips the JSON entirely, anything else parses and
+         * rewrites it. */
+        bc_regcache_result_t cache_res = BC_REGCACHE_MISSING;
         bool ok = data_is_dir
-            ? bc_registry_load_dir(&g_registry, data_path)
-            : bc_registry_load(&g_registry, data_path);
+            ? bc_registry_load_dir_cached(g_registry, data_path,
+                                          registry_cache, &cache_res)
+            : bc_registry_load(g_registry, data_path);
         if (ok) {
             g_registry_loaded = true;
             LOG_INFO("init", "Ship registry loaded: %d ships, %d projectiles from %s",
-                     g_registry.ship_count, g_registry.projectile_count, data_path);
+                     g_registry->ship_count, g_registry->projectile_count, data_path);
+            if (data_is_dir && registry_cache)
+                LOG_INFO("init", "  Registry cache: %s%s",
+                         bc_regcache_result_str(cache_res),
+                         cache_res == BC_REGCACHE_HIT ? "" : " (rebuilt from JSON)");
         } else {
             LOG_WARN("init", "Failed to load ship registry: %s", data_path);
             LOG_WARN("init", "  Running in relay-only mode (no damage authority)");
@@ -557,18 +697,31 @@ int main(int argc, char **argv)
         }
     }
 
-    bc_peers_init(&g_peers);
+    /* Peer table: never smaller than the stock 9 slots (the advertised
+     * max_players is a soft cap for the server browser); larger only when
+     * the admin asks for a bigger server. */
+    {
+        int peer_slots = max_players > BC_STOCK_PEER_SLOTS
+                       ? max_players : BC_STOCK_PEER_SLOTS;
+        if (!bc_peers_init(&g_peers, peer_slots)) {
+            LOG_ERROR("init", "Failed to allocate peer table (%d slots)",
+                      peer_slots);
+            if (g_query_socket_open) {
+                bc_socket_close(&g_query_socket);
+                g_query_socket_open = false;
+            }
+            bc_socket_close(&g_socket);
+            bc_net_shutdown();
+            bc_log_shutdown();
+            return 1;
+        }
+    }
 
     /* Reserve slot 0 for the dedicated server itself.
      * The stock BC dedi creates a "Dedicated Server" pseudo-player at slot 0
      * that doesn't count as a joined player.  This ensures joining players
      * start at slot 1 (wire_slot=2, direction=0x02), matching stock behavior. */
-    {
-        bc_peer_t *dedi = &g_peers.peers[0];
-        dedi->state = PEER_LOBBY;  /* Always "connected" */
-        snprintf(dedi->name, sizeof(dedi->name), "Dedicated Server");
-        g_peers.count++;
-    }
+    bc_peers_reserve_dedicated(&g_peers, "Dedicated Server");
 
     /* Server info for GameSpy responses.
      * Fields must match stock BC QR1 callbacks (basic + info + rules).
@@ -627,6 +780,7 @@ int main(int argc, char **argv)
     /* Register POSIX signal handlers */
     signal(SIGINT,  posix_signal_handler);
     signal(SIGTERM, posix_signal_handler);
+    signal(SIGHUP,  posix_reload_handler);
 #endif
 
     /* Startup banner (raw printf, not a log message) */
@@ -638,6 +792,13 @@ int main(int argc, char **argv)
            g_collision_dmg ? "on" : "off",
            g_friendly_fire ? "on" : "off");
     printf("Score mode: %s\n", g_use_score_limit ? "score-limit" : "frag-limit");
+    if (g_interest_cfg.enabled)
+        printf("Interest management: on (full rate < %.0f, %.0f%% beyond %.0f)\n",
+               (double)g_interest_cfg.near_dist,
+               (double)g_interest_cfg.min_rate * 100.0,
+               (double)g_interest_cfg.far_dist);
+    else
+        printf("Interest management: off\n");
     if (g_manifest_loaded) {
         printf("Checksum validation: on (manifest loaded)\n");
     } else {
@@ -645,7 +806,7 @@ int main(int argc, char **argv)
     }
     if (g_registry_loaded) {
         printf("Damage authority: server (%d ships, %d projectiles)\n",
-               g_registry.ship_count, g_registry.projectile_count);
+               g_registry->ship_count, g_registry->projectile_count);
     } else {
         printf("Damage authority: client (relay-only, no registry)\n");
     }
@@ -664,11 +825,37 @@ int main(int argc, char **argv)
     }
     printf("Press Ctrl+C to stop.\n\n");
 
-    /* Initialize event bus and load modules */
+    /* Frame arena: per-tick scratch for the engine and modules */
+    {
+        static u8 frame_buf[BC_FRAME_ARENA_SIZE];
+        bc_arena_init(&g_frame, frame_buf, sizeof(frame_buf));
+    }
+
+    /* Tick timers (before modules: they may call timer_add at load) */
+    bc_timer_wheel_init(&g_timers, BC_TIMER_DEFAULT_MAX_EXPIRE);
+    bc_timer_add(&g_timers, 30, 30, housekeeping_tick, NULL);
+    bc_timer_add(&g_timers, 30, 30, keepalive_tick, NULL);
+
+    /* Initialize event bus and packet hooks, then load modules */
+    bc_packet_hooks_init(&g_packet_hooks);
     obc_event_bus_init();
+    bc_server_events_register();
+    /* Job pool first: modules may submit jobs at load, and data reload
+     * does all of its file work there */
+    if (g_server_cfg.job_workers > 0 &&
+        (g_server_cfg.module_count > 0 || g_registry_loaded || g_manifest_loaded)) {
+        g_jobs = bc_job_pool_create(g_server_cfg.job_workers);
+        if (g_jobs)
+            LOG_INFO("init", "Job pool: %d worker(s)",
+                     bc_job_pool_workers(g_jobs));
+        else
+            LOG_WARN("init", "Job pool failed to start; background jobs disabled");
+    }
     if (g_server_cfg.module_count > 0) {
         if (obc_module_loader_init(&g_module_loader, &g_server_cfg) != 0) {
             LOG_ERROR("init", "Module loading failed -- aborting");
+            bc_job_pool_destroy(g_jobs);
+            g_jobs = NULL;
             obc_event_bus_shutdown();
             if (g_query_socket_open) {
                 bc_socket_close(&g_query_socket);
@@ -679,11 +866,52 @@ int main(int argc, char **argv)
             bc_log_shutdown();
             return 1;
         }
+        g_event_api = &g_module_loader.api;
     }
 
+    /* Data reload: SIGHUP always, file changes with [data] live_reload.
+     * Only sources that loaded above are reloaded. */
+    {
+        bc_reload_src_t src;
+        memset(&src, 0, sizeof(src));
+        if (g_registry_loaded) {
+            snprintf(src.registry, sizeof(src.registry), "%s", data_path);
+            src.registry_is_dir = data_is_dir;
+            if (data_is_dir && registry_cache)
+                snprintf(src.registry_cache, sizeof(src.registry_cache), "%s",
+                         registry_cache);
+        }
+        if (g_manifest_loaded)
+            snprintf(src.manifest, sizeof(src.manifest), "%s", manifest_path);
+        if (src.registry[0] || src.manifest[0]) {
+            if (bc_reload_init(&g_reload, &src, g_jobs, g_server_cfg.live_reload,
+                               g_server_cfg.reload_poll)) {
+                if (g_server_cfg.live_reload)
+                    LOG_INFO("init", "Live reload: watching %s%s%s",
+                             src.registry, src.registry[0] && src.manifest[0] ? ", " : "",
+                             src.manifest);
+            } else if (g_server_cfg.live_reload) {
+                LOG_WARN("init", "Live reload needs a job pool ([jobs] workers > 0); disabled");
+            }
+        }
+    }
+
+    /* Kernel overrides are a load-time decision: no ship exists yet, and
+     * every ship of the session runs under the same rules */
+    g_combat_kernels_locked = true;
+
+    /* Bots: server-owned ships, spawned once the kernels are fixed */
+    if (g_server_cfg.bot_count > 0 && !bc_server_bots_init(&g_server_cfg))
+        LOG_WARN("init", "Bots requested but none spawned");
+
+    if (bc_server_event_wanted(g_ev.server_start))
+        bc_server_event_fire(g_ev.server_start, -1, NULL);
+
     /* Diagnostic: check for ghost peers created during startup/probe.
      * Only slot 0 (dedi) should be non-empty at this point. */
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+    for (int k = g_peers.active_count - 1; k >= 0; k--) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
         if (g_peers.peers[i].state != PEER_EMPTY) {
             LOG_WARN("init", "Ghost peer at slot %d: state=%d, addr=%08X:%u, "
                      "last_recv=%u",
@@ -733,102 +961,39 @@ int main(int argc, char **argv)
             g_game_time += (f32)(now - last_tick) / 1000.0f;
             tick_counter++;
 
-            /* Every 30 ticks (~1 second): retransmit, timeout, master heartbeat */
-            if (tick_counter % 30 == 0) {
-                /* Retransmit unACKed reliable messages (skip slot 0 = dedi) */
-                for (int i = 1; i < BC_MAX_PLAYERS; i++) {
-                    bc_peer_t *peer = &g_peers.peers[i];
-                    if (peer->state == PEER_EMPTY) continue;
-
-                    /* Check for dead peers (max retries exceeded) */
-                    if (bc_reliable_check_timeout(&peer->reliable_out)) {
-                        char addr_str[32];
-                        bc_addr_to_string(&peer->addr, addr_str, sizeof(addr_str));
-                        LOG_INFO("net", "Peer %s (slot %d) timed out (no ACK)",
-                                 addr_str, i);
-                        bc_handle_peer_disconnect(i);
-                        continue;
-                    }
-
-                    /* Retransmit overdue messages (direct send, not via outbox) */
-                    int idx;
-                    while ((idx = bc_reliable_check_retransmit(
-                                &peer->reliable_out, now)) >= 0) {
-                        g_stats.reliable_retransmits++;
-                        bc_reliable_entry_t *e = &peer->reliable_out.entries[idx];
-                        u8 pkt[BC_MAX_PACKET_SIZE];
-                        int len = bc_transport_build_reliable(
-                            pkt, sizeof(pkt), e->payload, e->payload_len, e->seq);
-                        if (len > 0) {
-                            bc_packet_t trace;
-                            if (bc_transport_parse(pkt, len, &trace))
-                                bc_log_packet_trace(&trace, i, "RTXM");
-                            alby_cipher_encrypt(pkt, (size_t)len);
-                            bc_socket_send(&g_socket, &peer->addr, pkt, len);
-                        }
-                    }
-                }
+            /* Delta time for this tick (used by simulation + respawn) */
+            f32 dt = (f32)(now - last_tick) / 1000.0f;
 
-                /* Timeout stale peers (skip slot 0 = dedi) */
-                for (int i = 1; i < BC_MAX_PLAYERS; i++) {
-                    if (g_peers.peers[i].state == PEER_EMPTY) continue;
-                    if (now - g_peers.peers[i].last_recv_time > 30000) {
-                        g_stats.timeouts++;
-                        LOG_INFO("net", "Peer slot %d timed out (no packets)", i);
-                        bc_handle_peer_disconnect(i);
-                    }
+            /* Data reload: a finished background load is published here,
+             * before anything this tick looks at the registry */
+#ifndef _WIN32
+            if (g_reload_signal) {
+                g_reload_signal = 0;
+                if (g_reload.pool) {
+                    LOG_INFO("reload", "SIGHUP: reloading data files");
+                    bc_reload_request(&g_reload);
+                } else {
+                    LOG_WARN("reload", "SIGHUP ignored: data reload unavailable");
                 }
-
-                /* Master server heartbeat */
-                bc_master_tick(&g_masters, &g_socket, now);
             }
-
-            /* Delta time for this tick (used by simulation + respawn) */
-            f32 dt = (f32)(now - last_tick) / 1000.0f;
+#endif
+            bc_reload_tick(&g_reload, dt);
 
             /* === Simulation tick (every 100ms when registry loaded) === */
             if (g_registry_loaded) {
 
-                for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+                for (int k = 0; k < g_peers.active_count; k++) {
+                    int i = g_peers.active[k];
+                    if (i == 0) continue;  /* dedi */
                     bc_peer_t *p = &g_peers.peers[i];
                     if (!p->has_ship || !p->ship.alive) continue;
 
                     const bc_ship_class_t *cls =
-                        bc_registry_get_ship(&g_registry, p->class_index);
+                        bc_peer_class(p);
                     if (!cls) continue;
 
-                    /* Collision cooldown decay */
-                    if (p->ship.collision_cooldown > 0.0f) {
-                        p->ship.collision_cooldown -= dt;
-                        if (p->ship.collision_cooldown < 0.0f)
-                            p->ship.collision_cooldown = 0.0f;
-                    }
-
-                    /* Reactor: generate power, compute per-subsystem efficiency */
-                    bc_ship_power_tick(&p->ship, cls, dt);
-
-                    /* Server-side position estimate for range checks + torpedo targeting */
-                    f32 eng_eff = bc_powered_efficiency(&p->ship, cls, "impulse");
-                    bc_ship_move_tick(&p->ship, eng_eff, dt);
-
-                    /* Shield recharge (shield gen is Base format, eff = 1.0) */
-                    bc_combat_shield_tick(&p->ship, cls, 1.0f, dt);
-
-                    /* Phaser charge + torpedo cooldown (use weapon efficiency) */
-                    f32 wep_eff = bc_powered_efficiency(&p->ship, cls, "phaser");
-                    f32 pulse_eff = bc_powered_efficiency(&p->ship, cls, "pulse_weapon");
-                    f32 min_wep = (pulse_eff < wep_eff) ? pulse_eff : wep_eff;
-                    bc_combat_charge_tick(&p->ship, cls, min_wep, dt);
-                    bc_combat_torpedo_tick(&p->ship, cls, dt);
-
-                    /* Cloak state machine (energy-failure auto-decloak) */
-                    f32 clk_eff = bc_powered_efficiency(&p->ship, cls, "cloak");
-                    bc_cloak_tick(&p->ship, /* cloak_efficiency */ clk_eff,
-                                 /* dt */ dt);
-
-                    /* Repair */
-                    bc_repair_tick(&p->ship, cls, dt);
-                    bc_repair_auto_queue(&p->ship, cls);
+                    /* Power, movement, shields, weapons, cloak, repair */
+                    bc_ship_systems_tick(&p->ship, cls, dt);
 
                     /* Tractor beam physics: drag target if engaged */
                     if (p->ship.tractor_target_id >= 0) {
@@ -844,6 +1009,9 @@ int main(int argc, char **argv)
                     }
                 }
 
+                /* Bots: think within budget, steer, fire, run ship systems */
+                bc_server_bots_tick(dt);
+
                 /* Torpedo tracker tick */
                 if (g_torpedoes.count > 0) {
                     bc_torpedo_tick(&g_torpedoes, dt, 5.0f,
@@ -853,50 +1021,16 @@ int main(int argc, char **argv)
             }
 
             /* Health broadcast: every 3 ticks (~100ms = 10 Hz), send 0x20 StateUpdate.
-             * Stock dedi sends at ~10 Hz.  Uses hierarchical round-robin with
-             * 10-byte budget per tick.  Owner gets is_own_ship=true (no power_pct
-             * bytes in Powered entries), remote observers get is_own_ship=false. */
+             * Stock dedi sends at ~10 Hz with a 10-byte budget per tick.
+             * Each ship's window alternates between the most recent unsent
+             * damage/repair and the hierarchical round-robin; owner and
+             * remote variants are encoded once and shared by all observers
+             * (see bc_health_broadcast_tick in server_dispatch.c). */
             if (g_registry_loaded && (tick_counter % 3 == 0)) {
-                for (int i = 1; i < BC_MAX_PLAYERS; i++) {
-                    bc_peer_t *p = &g_peers.peers[i];
-                    if (!p->has_ship || !p->ship.alive) continue;
-
-                    const bc_ship_class_t *cls =
-                        bc_registry_get_ship(&g_registry, p->class_index);
-                    if (!cls) continue;
-
-                    /* Build owner version (no power data in Powered entries) */
-                    u8 hbuf_own[128];
-                    u8 next_idx;
-                    int hlen_own = bc_ship_build_health_update(
-                        &p->ship, cls, g_game_time,
-                        p->subsys_rr_idx, &next_idx, true,
-                        hbuf_own, sizeof(hbuf_own));
-
-                    /* Build remote version (with power data) using same
-                     * start_idx so both cover the same entries. */
-                    u8 hbuf_rmt[128];
-                    u8 rmt_next;
-                    int hlen_rmt = bc_ship_build_health_update(
-                        &p->ship, cls, g_game_time,
-                        p->subsys_rr_idx, &rmt_next, false,
-                        hbuf_rmt, sizeof(hbuf_rmt));
-
-                    /* Advance cursor using the owner version (smaller budget,
-                     * may cover fewer entries -- that's fine, the remote
-                     * version just sends more data this tick). */
-                    if (hlen_own > 0)
-                        p->subsys_rr_idx = next_idx;
-
-                    /* Send appropriate version to each client */
-                    for (int j = 1; j < BC_MAX_PLAYERS; j++) {
-                        if (g_peers.peers[j].state < PEER_LOBBY) continue;
-                        if (j == i && hlen_own > 0) {
-                            bc_queue_unreliable(j, hbuf_own, hlen_own);
-                        } else if (j != i && hlen_rmt > 0) {
-                            bc_queue_unreliable(j, hbuf_rmt, hlen_rmt);
-                        }
-                    }
+                for (int k = 0; k < g_peers.active_count; k++) {
+                    int i = g_peers.active[k];
+                    if (i == 0) continue;  /* dedi */
+                    bc_health_broadcast_tick(i);
                 }
             }
 
@@ -910,12 +1044,20 @@ int main(int argc, char **argv)
                     g_game_ended = true;
                     g_accept_new_players = false;
                     LOG_INFO("game", "Time limit reached (%.0f sec)", g_game_time);
+
+                    if (bc_server_event_wanted(g_ev.game_ended)) {
+                        obc_game_end_event_t ev = {
+                            .reason = BC_END_REASON_TIME_UP };
+                        bc_server_event_fire(g_ev.game_ended, -1, &ev);
+                    }
                 }
             }
 
             /* Respawn: countdown dead players, re-create ships */
             if (g_registry_loaded && !g_game_ended) {
-                for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+                for (int k = 0; k < g_peers.active_count; k++) {
+                    int i = g_peers.active[k];
+                    if (i == 0) continue;  /* dedi */
                     bc_peer_t *rp = &g_peers.peers[i];
                     if (rp->state < PEER_IN_GAME || rp->has_ship) continue;
                     if (rp->respawn_timer <= 0.0f) continue;
@@ -924,8 +1066,11 @@ int main(int argc, char **argv)
                     if (rp->respawn_timer > 0.0f) continue;
                     rp->respawn_timer = 0.0f;
 
+                    int rcidx = rp->respawn_species < 0 ? -1
+                              : bc_registry_find_ship_index(
+                                    g_registry, (u16)rp->respawn_species);
                     const bc_ship_class_t *rcls =
-                        bc_registry_get_ship(&g_registry, rp->respawn_class);
+                        bc_registry_get_ship(g_registry, rcidx);
                     if (!rcls) continue;
                     if (rp->spawn_len < 24) continue;
 
@@ -934,14 +1079,16 @@ int main(int argc, char **argv)
                     if (team_id == BC_TEAM_NONE) team_id = 0;
 
                     int gs = i > 0 ? i - 1 : 0;
-                    bc_ship_init(&rp->ship, rcls, rp->respawn_class,
+                    bc_ship_init(&rp->ship, rcls, rcidx,
                                  bc_make_ship_id(gs), (u8)i, team_id);
                     rp->ship.pos.x = (f32)(rand() % 4001) - 2000.0f;
                     rp->ship.pos.y = (f32)(rand() % 1001) - 500.0f;
                     rp->ship.pos.z = (f32)(rand() % 4001) - 2000.0f;
-                    rp->class_index = rp->respawn_class;
+                    rp->class_index = rcidx;
+                    rp->registry = g_registry;
                     rp->has_ship = true;
                     rp->subsys_rr_idx = 0;
+                    bc_health_track_reset(&g_health_track[i]);
                     bc_ship_assign_subsystem_ids(&rp->ship, rcls);
 
                     /* Build respawn ObjCreateTeam by patching the cached
@@ -989,32 +1136,56 @@ int main(int argc, char **argv)
 
                     bc_send_to_all(cpkt, clen, true);
                     LOG_INFO("game", "slot=%d respawned as %s", i, rcls->name);
-                }
-            }
 
-            /* Every 30 ticks (~1 second): send keepalive to all active peers.
-             * Stock dedi echoes the client's identity data (22 bytes) back
-             * instead of sending a minimal [0x00][0x02] keepalive. */
-            if (tick_counter % 30 == 0) {
-                for (int i = 1; i < BC_MAX_PLAYERS; i++) {
-                    bc_peer_t *peer = &g_peers.peers[i];
-                    if (peer->state < PEER_LOBBY) continue;
-                    if (peer->keepalive_len > 0) {
-                        bc_outbox_add_keepalive_data(&peer->outbox,
-                                                      peer->keepalive_data,
-                                                      peer->keepalive_len);
-                    } else {
-                        bc_outbox_add_keepalive(&peer->outbox);
+                    if (bc_server_event_wanted(g_ev.ship_respawned)) {
+                        obc_player_event_t ev = { .slot = i, .name = rp->name };
+                        bc_server_event_fire(g_ev.ship_respawned, i, &ev);
                     }
                 }
             }
 
+            /* Tick timers (1 s housekeeping, keepalive, module timers)
+             * after simulation and dispatch, where the once-a-second
+             * keepalive pass has always run, so keepalives and anything
+             * a module timer queues go out in this tick's flush */
+            bc_timer_advance(&g_timers);
+
+            /* Module tick hooks run before the flush so anything they
+             * queue goes out this tick. Events posted since the last tick
+             * are delivered first, in post order, after finished
+             * background jobs. */
+            bc_job_poll(g_jobs, 0);
+            obc_event_queue_drain(g_event_api);
+            if (bc_server_event_wanted(g_ev.game_tick))
+                bc_server_event_fire(g_ev.game_tick, -1, NULL);
+            if (tick_counter % 30 == 0 && bc_server_event_wanted(g_ev.game_tick_1s))
+                bc_server_event_fire(g_ev.game_tick_1s, -1, NULL);
+
             /* Flush all peer outboxes (skip slot 0 = dedi) */
-            for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+            for (int k = 0; k < g_peers.active_count; k++) {
+                int i = g_peers.active[k];
+                if (i == 0) continue;  /* dedi */
                 if (g_peers.peers[i].state == PEER_EMPTY) continue;
                 bc_flush_peer(i);
             }
 
+            /* Everything queued this tick is on the wire: scratch memory
+             * handed out since the last reset is dead now, and so is
+             * this tick's fleet snapshot */
+            bc_arena_reset(&g_frame);
+            bc_ship_snapshot_invalidate(&g_ship_snapshot);
+
+            /* Ship change journals cover one tick; health tracking keeps
+             * what no 0x20 pick has looked at yet */
+            for (int k = 0; k < g_peers.active_count; k++) {
+                int i = g_peers.active[k];
+                if (!g_peers.peers[i].has_ship) continue;
+                bc_ship_journal_t *j = &g_peers.peers[i].ship.journal;
+                if (i < BC_MAX_PLAYERS)
+                    bc_health_track_note(&g_health_track[i], j);
+                bc_ship_journal_clear(j);
+            }
+
             last_tick = now;
         }
 
@@ -1030,14 +1201,37 @@ int main(int argc, char **argv)
 
     /* Shut down modules before network teardown (shutdown callbacks may
      * fire events or send messages that need the network layer alive). */
+    if (bc_server_event_wanted(g_ev.server_shutdown))
+        bc_server_event_fire(g_ev.server_shutdown, -1, NULL);
     obc_module_loader_shutdown(&g_module_loader);
+    bc_server_bots_shutdown();
+    if (g_reload.reloads > 0 || g_reload.failures > 0)
+        LOG_INFO("shutdown", "Data reload: %u published, %u failed",
+                 g_reload.reloads, g_reload.failures);
+    bc_reload_shutdown(&g_reload);
+    bc_job_pool_destroy(g_jobs);
+    g_jobs = NULL;
+    g_event_api = NULL;
+    {
+        obc_event_queue_stats_t qs;
+        obc_event_queue_stats(&qs);
+        if (qs.dropped > 0)
+            LOG_WARN("event", "Event queue dropped %u posts (peak depth %d)",
+                     qs.dropped, qs.peak_depth);
+    }
+    LOG_INFO("shutdown", "Frame arena: peak %zu of %zu bytes over %u ticks",
+             g_frame.peak, g_frame.cap, g_frame.frames);
+    if (g_frame.failed > 0)
+        LOG_WARN("shutdown", "Frame arena refused %u allocations", g_frame.failed);
     obc_event_bus_shutdown();
 
     /* Log session summary before tearing down */
     bc_log_session_summary();
 
     /* Flush all pending outbox data before sending shutdown (skip slot 0 = dedi) */
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
         if (g_peers.peers[i].state == PEER_EMPTY) continue;
         bc_flush_peer(i);
     }
@@ -1045,7 +1239,9 @@ int main(int argc, char **argv)
     /* Send ConnectAck shutdown notification to all connected peers.
      * Real BC server sends ConnectAck (0x05) to each peer on shutdown,
      * NOT BootPlayer or DeletePlayer. (skip slot 0 = dedi) */
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
         bc_peer_t *peer = &g_peers.peers[i];
         if (peer->state == PEER_EMPTY) continue;
 
@@ -1061,10 +1257,12 @@ int main(int argc, char **argv)
             LOG_INFO("shutdown", "Sent shutdown to slot %d", i);
         }
 
-        /* Clear peer state */
-        peer->state = PEER_EMPTY;
     }
-    g_peers.count = 0;
+    bc_peers_free(&g_peers);
+    if (g_manifest_loaded) bc_manifest_free(&g_manifest);
+    bc_checksum_cache_free(&g_checksum_cache);
+    free(g_registry);
+    g_registry = NULL;
 
     /* Unregister from master servers (sends exit heartbeat) */
     bc_master_shutdown(&g_masters, &g_socket);
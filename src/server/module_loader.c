@@ -177,6 +177,40 @@ static obc_event_result_t wrap_event_fire(const char *event_name,
     return obc_event_fire(s_api_self, event_name, sender_slot, data);
 }
 
+static obc_event_id_t wrap_event_register(const char *event_name)
+{
+    return obc_event_register(event_name);
+}
+
+static int wrap_event_subscribe_id(obc_event_id_t id,
+                                   obc_event_handler_fn fn, int priority)
+{
+    return obc_event_subscribe_id(id, fn, priority);
+}
+
+static void wrap_event_unsubscribe_id(obc_event_id_t id,
+                                      obc_event_handler_fn fn)
+{
+    obc_event_unsubscribe_id(id, fn);
+}
+
+static obc_event_result_t wrap_event_fire_id(obc_event_id_t id,
+                                             int sender_slot, const void *data)
+{
+    return obc_event_fire_id(s_api_self, id, sender_slot, data);
+}
+
+static int wrap_event_has_subscribers(obc_event_id_t id)
+{
+    return obc_event_has_subscribers(id) ? 1 : 0;
+}
+
+static int wrap_event_post(obc_event_id_t id, int sender_slot,
+                           const void *data, int data_len, int flags)
+{
+    return obc_event_post(id, sender_slot, data, data_len, flags);
+}
+
 /* --- Config --- */
 
 static const char *wrap_config_string(const obc_module_t *self,
@@ -204,6 +238,265 @@ static int wrap_config_bool(const obc_module_t *self,
     return obc_config_mod_bool(s_cfg, self->name, key, def != 0) ? 1 : 0;
 }
 
+/* --- Timers ---
+ * Module timers run on g_timers. The wheel callback only carries the timer
+ * ID, so the module's handler and user_data live in a side table indexed
+ * by pool slot. */
+
+static struct {
+    int                  id;    /* 0 = unused */
+    obc_event_handler_fn fn;
+    void                *user_data;
+} s_mod_timers[BC_TIMER_MAX];
+
+static void mod_timer_fire(void *user, int timer_id)
+{
+    (void)user;
+    int idx = bc_timer_index(timer_id);
+    obc_event_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.event_name  = "timer";
+    ctx.sender_slot = -1;
+    ctx.event_data  = s_mod_timers[idx].user_data;
+    s_mod_timers[idx].fn(s_api_self, &ctx);
+}
+
+static int wrap_timer_add(float interval_sec, obc_event_handler_fn callback,
+                          void *user_data)
+{
+    if (!callback || !(interval_sec > 0.0f)) return -1;
+    u32 ticks = bc_timer_ticks(interval_sec);
+    int id = bc_timer_add(&g_timers, ticks, ticks, mod_timer_fire, NULL);
+    if (id < 0) return -1;
+    int idx = bc_timer_index(id);
+    s_mod_timers[idx].id        = id;
+    s_mod_timers[idx].fn        = callback;
+    s_mod_timers[idx].user_data = user_data;
+    return id;
+}
+
+static void wrap_timer_remove(int timer_id)
+{
+    if (bc_timer_cancel(&g_timers, timer_id))
+        s_mod_timers[bc_timer_index(timer_id)].id = 0;
+}
+
+/* --- Background jobs ---
+ * Each module is its own job group (its slot in the loader), so the
+ * pool's per-group limits are per-module limits. The pool's done callback
+ * has no api parameter, so the module's done handler lives in a side
+ * table indexed by job slot, next to the group that submitted it (only
+ * that module may cancel the job). */
+
+static obc_module_loader_t *s_loader;
+
+static obc_job_done_fn s_mod_job_done[BC_JOB_MAX];
+static int             s_mod_job_group[BC_JOB_MAX];
+
+_Static_assert(OBC_JOB_DONE == BC_JOB_DONE &&
+               OBC_JOB_CANCELLED == BC_JOB_CANCELLED,
+               "module job status values must match the pool's");
+
+static int module_group(const obc_module_t *self)
+{
+    if (!s_loader || !self) return -1;
+    for (int i = 0; i < OBC_MODULE_MAX; i++)
+        if (&s_loader->modules[i].module == self) return i;
+    return -1;
+}
+
+static void mod_job_done(void *arg, int job_id, int status)
+{
+    obc_job_done_fn done = s_mod_job_done[bc_job_index(job_id)];
+    if (done) done(s_api_self, arg, job_id, status);
+}
+
+static int wrap_job_submit(const obc_module_t *self, obc_job_fn run,
+                           obc_job_done_fn done, void *arg)
+{
+    int group = module_group(self);
+    if (!g_jobs || group < 0) return -1;
+    int id = bc_job_submit(g_jobs, group, run, mod_job_done, arg);
+    if (id < 0) return -1;
+    s_mod_job_done[bc_job_index(id)] = done;
+    s_mod_job_group[bc_job_index(id)] = group;
+    return id;
+}
+
+static int wrap_job_cancel(const obc_module_t *self, int job_id)
+{
+    int group = module_group(self);
+    if (!g_jobs || group < 0 || job_id <= 0) return 0;
+    if (s_mod_job_group[bc_job_index(job_id)] != group) {
+        LOG_WARN("module", "'%s': job_cancel(%d) refused: not its job",
+                 self->name ? self->name : "?", job_id);
+        return 0;
+    }
+    return bc_job_cancel(g_jobs, job_id) ? 1 : 0;
+}
+
+static int wrap_job_cancelled(int job_id)
+{
+    return bc_job_cancel_requested(g_jobs, job_id) ? 1 : 0;
+}
+
+/* --- Frame scratch memory --- */
+
+static void *wrap_frame_alloc(int size)
+{
+    if (size <= 0) return NULL;
+    return bc_arena_alloc(&g_frame, (size_t)size);
+}
+
+static const char *wrap_frame_printf(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    const char *s = bc_arena_vprintf(&g_frame, fmt, ap);
+    va_end(ap);
+    return s;
+}
+
+/* --- Fleet snapshot --- */
+
+static const obc_ship_view_t *wrap_ships_snapshot(int *count)
+{
+    const bc_ship_snapshot_t *snap = bc_ship_snapshot_get(
+        &g_ship_snapshot, &g_peers, g_registry_loaded ? g_registry : NULL);
+    if (count) *count = snap->count;
+    return snap->ships;
+}
+
+/* --- Packet hooks ---
+ * The hook table's callback has no api parameter; the module's function
+ * and user_data sit in a side entry passed as the hook's user pointer. */
+
+typedef struct {
+    int                 id;     /* 0 = unused */
+    obc_packet_hook_fn  fn;
+    void               *user_data;
+} mod_hook_t;
+
+static mod_hook_t s_mod_hooks[BC_PACKET_HOOK_MAX];
+
+_Static_assert(OBC_PACKET_PASS == BC_PACKET_PASS &&
+               OBC_PACKET_DROP == BC_PACKET_DROP &&
+               OBC_PACKET_REWRITE == BC_PACKET_REWRITE,
+               "module packet verdicts must match the hook table's");
+
+static int mod_packet_hook(void *user, int slot, u8 *data, int *len)
+{
+    const mod_hook_t *mh = user;
+    return mh->fn(s_api_self, slot, data, len, mh->user_data);
+}
+
+static int wrap_packet_hook_add(const unsigned char *opcodes, int count,
+                                obc_packet_hook_fn fn, int priority,
+                                void *user_data)
+{
+    if (!fn) return -1;
+    for (int k = 0; k < BC_PACKET_HOOK_MAX; k++) {
+        if (s_mod_hooks[k].id != 0) continue;
+        int id = bc_packet_hook_add(&g_packet_hooks, opcodes, count, priority,
+                                    mod_packet_hook, &s_mod_hooks[k]);
+        if (id < 0) return -1;
+        s_mod_hooks[k].id        = id;
+        s_mod_hooks[k].fn        = fn;
+        s_mod_hooks[k].user_data = user_data;
+        return id;
+    }
+    return -1;
+}
+
+static void wrap_packet_hook_remove(int hook_id)
+{
+    if (hook_id <= 0) return;
+    for (int k = 0; k < BC_PACKET_HOOK_MAX; k++) {
+        if (s_mod_hooks[k].id != hook_id) continue;
+        bc_packet_hook_remove(&g_packet_hooks, hook_id);
+        s_mod_hooks[k].id = 0;
+        return;
+    }
+}
+
+/* --- Combat kernels --- */
+
+/* What modules installed (or the built-ins). The server calls these through
+ * the journaled_* wrappers in g_combat_kernels, which journal whatever a
+ * module kernel changed without recording, so hit/repair tracking never
+ * depends on a module using the journal helpers. */
+static bc_combat_kernels_t s_mod_kernels = {
+    bc_combat_apply_damage, bc_combat_shield_tick, bc_repair_tick,
+};
+
+static void journaled_apply_damage(bc_ship_state_t *target,
+                                   const bc_ship_class_t *cls,
+                                   f32 damage, f32 damage_radius,
+                                   bc_vec3_t impact_dir, bool area_effect,
+                                   f32 search_radius)
+{
+    bc_combat_health_t before;
+    bc_combat_health_save(&before, target);
+    s_mod_kernels.apply_damage(target, cls, damage, damage_radius, impact_dir,
+                               area_effect, search_radius);
+    bc_combat_journal_diff(target, cls, &before);
+}
+
+static void journaled_shield_tick(bc_ship_state_t *ship,
+                                  const bc_ship_class_t *cls,
+                                  f32 power_level, f32 dt)
+{
+    bc_combat_health_t before;
+    bc_combat_health_save(&before, ship);
+    s_mod_kernels.shield_tick(ship, cls, power_level, dt);
+    bc_combat_journal_diff(ship, cls, &before);
+}
+
+static void journaled_repair_tick(bc_ship_state_t *ship,
+                                  const bc_ship_class_t *cls, f32 dt)
+{
+    bc_combat_health_t before;
+    bc_combat_health_save(&before, ship);
+    s_mod_kernels.repair_tick(ship, cls, dt);
+    bc_combat_journal_diff(ship, cls, &before);
+}
+
+/* Modules chain to the kernels they replace, so hand out the raw ones:
+ * a wrapper here would call back into the module that wraps it. */
+static void wrap_combat_kernels_get(obc_combat_kernels_t *out)
+{
+    if (out) *out = s_mod_kernels;
+}
+
+static int wrap_combat_kernels_set(const obc_module_t *self,
+                                   const obc_combat_kernels_t *k)
+{
+    const char *name = (self && self->name) ? self->name : "?";
+    if (!k) return -1;
+    if (g_combat_kernels_locked) {
+        LOG_WARN("module", "'%s': combat kernels can only be replaced at load",
+                 name);
+        return -1;
+    }
+    if (k->apply_damage) {
+        s_mod_kernels.apply_damage = k->apply_damage;
+        g_combat_kernels.apply_damage = journaled_apply_damage;
+    }
+    if (k->shield_tick) {
+        s_mod_kernels.shield_tick = k->shield_tick;
+        g_combat_kernels.shield_tick = journaled_shield_tick;
+    }
+    if (k->repair_tick) {
+        s_mod_kernels.repair_tick = k->repair_tick;
+        g_combat_kernels.repair_tick = journaled_repair_tick;
+    }
+    LOG_INFO("module", "'%s' replaced combat kernels:%s%s%s", name,
+             k->apply_damage ? " damage" : "",
+             k->shield_tick  ? " shield_tick" : "",
+             k->repair_tick  ? " repair_tick" : "");
+    return 0;
+}
+
 /* --- Logging ---
  * bc_log is variadic; we can't forward va_list to it.
  * Format into a stack buffer, then pass as "%s". */
@@ -263,13 +556,13 @@ static int wrap_peer_max(void)
 
 static int wrap_peer_slot_active(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0;
+    if (slot < 0 || slot >= g_peers.capacity) return 0;
     return g_peers.peers[slot].state != PEER_EMPTY ? 1 : 0;
 }
 
 static const char *wrap_peer_name(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return NULL;
+    if (slot < 0 || slot >= g_peers.capacity) return NULL;
     if (g_peers.peers[slot].state == PEER_EMPTY) return NULL;
     return g_peers.peers[slot].name;
 }
@@ -284,50 +577,46 @@ static int wrap_peer_team(int slot)
 
 static const obc_ship_state_t *wrap_ship_get(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return NULL;
+    if (slot < 0 || slot >= g_peers.capacity) return NULL;
     if (!g_peers.peers[slot].has_ship) return NULL;
     return &g_peers.peers[slot].ship;
 }
 
 static float wrap_ship_hull(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0.f;
+    if (slot < 0 || slot >= g_peers.capacity) return 0.f;
     if (!g_peers.peers[slot].has_ship) return 0.f;
     return g_peers.peers[slot].ship.hull_hp;
 }
 
 static float wrap_ship_hull_max(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0.f;
+    if (slot < 0 || slot >= g_peers.capacity) return 0.f;
     if (!g_peers.peers[slot].has_ship) return 0.f;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return 0.f;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return 0.f;
     return cls->hull_hp;
 }
 
 static int wrap_ship_alive(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0;
+    if (slot < 0 || slot >= g_peers.capacity) return 0;
     if (!g_peers.peers[slot].has_ship) return 0;
     return g_peers.peers[slot].ship.alive ? 1 : 0;
 }
 
 static int wrap_ship_species(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return -1;
+    if (slot < 0 || slot >= g_peers.capacity) return -1;
     if (!g_peers.peers[slot].has_ship) return -1;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return -1;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return -1;
     return (int)cls->species_id;
 }
 
 static float wrap_subsystem_hp(int slot, int subsys_index)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0.f;
+    if (slot < 0 || slot >= g_peers.capacity) return 0.f;
     if (!g_peers.peers[slot].has_ship) return 0.f;
     if (subsys_index < 0 || subsys_index >= BC_MAX_SUBSYSTEMS) return 0.f;
     return g_peers.peers[slot].ship.subsystem_hp[subsys_index];
@@ -335,11 +624,9 @@ static float wrap_subsystem_hp(int slot, int subsys_index)
 
 static float wrap_subsystem_hp_max(int slot, int subsys_index)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0.f;
+    if (slot < 0 || slot >= g_peers.capacity) return 0.f;
     if (!g_peers.peers[slot].has_ship) return 0.f;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return 0.f;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return 0.f;
     if (subsys_index < 0 || subsys_index >= cls->subsystem_count) return 0.f;
     return cls->subsystems[subsys_index].max_condition;
@@ -347,11 +634,9 @@ static float wrap_subsystem_hp_max(int slot, int subsys_index)
 
 static int wrap_subsystem_count(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0;
+    if (slot < 0 || slot >= g_peers.capacity) return 0;
     if (!g_peers.peers[slot].has_ship) return 0;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return 0;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return 0;
     return cls->subsystem_count;
 }
@@ -360,44 +645,47 @@ static int wrap_subsystem_count(int slot)
 
 static void wrap_ship_apply_damage(int slot, float amount, int source_slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= g_peers.capacity) return;
     if (!g_peers.peers[slot].has_ship) return;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return;
     (void)source_slot; /* attribution tracked externally */
     bc_vec3_t dir = {0.f, 0.f, 1.f};
-    bc_combat_apply_damage(&g_peers.peers[slot].ship, cls, amount, 0.f,
-                           dir, true, 1.0f);
+    g_combat_kernels.apply_damage(&g_peers.peers[slot].ship, cls, amount, 0.f,
+                                  dir, true, 1.0f);
 }
 
 static void wrap_ship_apply_damage_at(int slot, float amount,
                                       float dir_x, float dir_y, float dir_z,
                                       float radius, int source_slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= g_peers.capacity) return;
     if (!g_peers.peers[slot].has_ship) return;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return;
     (void)source_slot;
     bc_vec3_t dir = {dir_x, dir_y, dir_z};
-    bc_combat_apply_damage(&g_peers.peers[slot].ship, cls, amount, radius,
-                           dir, false, 1.0f);
+    g_combat_kernels.apply_damage(&g_peers.peers[slot].ship, cls, amount, radius,
+                                  dir, false, 1.0f);
 }
 
 static void wrap_ship_apply_subsystem_damage(int slot, int subsys_index,
                                              float amount)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= g_peers.capacity) return;
     if (!g_peers.peers[slot].has_ship) return;
     if (subsys_index < 0 || subsys_index >= BC_MAX_SUBSYSTEMS) return;
-    float hp = g_peers.peers[slot].ship.subsystem_hp[subsys_index];
-    hp -= amount;
+    bc_ship_state_t *ship = &g_peers.peers[slot].ship;
+    float was = ship->subsystem_hp[subsys_index];
+    float hp = was - amount;
     if (hp < 0.f) hp = 0.f;
-    g_peers.peers[slot].ship.subsystem_hp[subsys_index] = hp;
+    ship->subsystem_hp[subsys_index] = hp;
+    if (hp < was) {
+        bc_ship_journal_subsys_damaged(&ship->journal, subsys_index);
+        if (hp <= 0.f)
+            bc_ship_journal_event(&ship->journal, BC_SHIP_EV_SUBSYS_DESTROYED,
+                                  (u8)subsys_index);
+    }
 }
 
 static void wrap_ship_kill(int slot, int killer_slot, int method)
@@ -414,7 +702,7 @@ static void wrap_ship_respawn(int slot)
 
 static void wrap_ship_set_position(int slot, float x, float y, float z)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= g_peers.capacity) return;
     if (!g_peers.peers[slot].has_ship) return;
     g_peers.peers[slot].ship.pos.x = x;
     g_peers.peers[slot].ship.pos.y = y;
@@ -424,7 +712,7 @@ static void wrap_ship_set_position(int slot, float x, float y, float z)
 static void wrap_ship_set_orientation(int slot, float fx, float fy, float fz,
                                       float ux, float uy, float uz)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= g_peers.capacity) return;
     if (!g_peers.peers[slot].has_ship) return;
     g_peers.peers[slot].ship.fwd.x = fx;
     g_peers.peers[slot].ship.fwd.y = fy;
@@ -473,13 +761,13 @@ static void wrap_score_reset_all(void)
 
 static void wrap_send_reliable(int to_slot, const void *data, int len)
 {
-    if (to_slot < 1 || to_slot >= BC_MAX_PLAYERS) return;
+    if (to_slot < 1 || to_slot >= g_peers.capacity) return;
     bc_queue_reliable(to_slot, (const u8 *)data, len);
 }
 
 static void wrap_send_unreliable(int to_slot, const void *data, int len)
 {
-    if (to_slot < 1 || to_slot >= BC_MAX_PLAYERS) return;
+    if (to_slot < 1 || to_slot >= g_peers.capacity) return;
     bc_queue_unreliable(to_slot, (const u8 *)data, len);
 }
 
@@ -527,26 +815,26 @@ static int wrap_game_in_progress(void)
 static const obc_ship_class_t *wrap_ship_class_by_species(int species_id)
 {
     if (!g_registry_loaded) return NULL;
-    return bc_registry_find_ship(&g_registry, (u16)species_id);
+    return bc_registry_find_ship(g_registry, (u16)species_id);
 }
 
 static int wrap_ship_class_count(void)
 {
     if (!g_registry_loaded) return 0;
-    return g_registry.ship_count;
+    return g_registry->ship_count;
 }
 
 static const obc_ship_class_t *wrap_ship_class_by_index(int index)
 {
     if (!g_registry_loaded) return NULL;
-    return bc_registry_get_ship(&g_registry, index);
+    return bc_registry_get_ship(g_registry, index);
 }
 
 /* --- Shield State --- */
 
 static float wrap_ship_shield_hp(int slot, int facing)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0.f;
+    if (slot < 0 || slot >= g_peers.capacity) return 0.f;
     if (!g_peers.peers[slot].has_ship) return 0.f;
     if (facing < 0 || facing >= BC_MAX_SHIELD_FACINGS) return 0.f;
     return g_peers.peers[slot].ship.shield_hp[facing];
@@ -554,12 +842,10 @@ static float wrap_ship_shield_hp(int slot, int facing)
 
 static float wrap_ship_shield_hp_max(int slot, int facing)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return 0.f;
+    if (slot < 0 || slot >= g_peers.capacity) return 0.f;
     if (!g_peers.peers[slot].has_ship) return 0.f;
     if (facing < 0 || facing >= BC_MAX_SHIELD_FACINGS) return 0.f;
-    int ci = g_peers.peers[slot].class_index;
-    if (ci < 0 || !g_registry_loaded) return 0.f;
-    const bc_ship_class_t *cls = bc_registry_get_ship(&g_registry, ci);
+    const bc_ship_class_t *cls = bc_peer_class(&g_peers.peers[slot]);
     if (!cls) return 0.f;
     return cls->shield_hp[facing];
 }
@@ -627,9 +913,9 @@ void obc_module_api_build(obc_engine_api_t *api, const obc_server_cfg_t *cfg)
     api->config_float     = wrap_config_float;
     api->config_bool      = wrap_config_bool;
 
-    /* Timers -- NULL (no timer subsystem yet) */
-    api->timer_add        = NULL;
-    api->timer_remove     = NULL;
+    /* Timers */
+    api->timer_add        = wrap_timer_add;
+    api->timer_remove     = wrap_timer_remove;
 
     /* Logging */
     api->log_info         = wrap_log_info;
@@ -651,6 +937,34 @@ void obc_module_api_build(obc_engine_api_t *api, const obc_server_cfg_t *cfg)
     /* Shield State */
     api->ship_shield_hp        = wrap_ship_shield_hp;
     api->ship_shield_hp_max    = wrap_ship_shield_hp_max;
+
+    /* Event System (interned IDs) */
+    api->event_register       = wrap_event_register;
+    api->event_subscribe_id   = wrap_event_subscribe_id;
+    api->event_unsubscribe_id = wrap_event_unsubscribe_id;
+    api->event_fire_id        = wrap_event_fire_id;
+    api->event_has_subscribers = wrap_event_has_subscribers;
+    api->event_post           = wrap_event_post;
+
+    /* Background jobs */
+    api->job_submit           = wrap_job_submit;
+    api->job_cancel           = wrap_job_cancel;
+    api->job_cancelled        = wrap_job_cancelled;
+
+    /* Frame scratch memory */
+    api->frame_alloc          = wrap_frame_alloc;
+    api->frame_printf         = wrap_frame_printf;
+
+    /* Fleet snapshot */
+    api->ships_snapshot       = wrap_ships_snapshot;
+
+    /* Packet hooks */
+    api->packet_hook_add      = wrap_packet_hook_add;
+    api->packet_hook_remove   = wrap_packet_hook_remove;
+
+    /* Combat kernels */
+    api->combat_kernels_get   = wrap_combat_kernels_get;
+    api->combat_kernels_set   = wrap_combat_kernels_set;
 }
 
 /* =========================================================================
@@ -665,6 +979,10 @@ int obc_module_loader_init(obc_module_loader_t *loader,
     /* Build the engine API table */
     obc_module_api_build(&loader->api, cfg);
     s_api_self = &loader->api;
+    s_loader   = loader;
+
+    for (int i = 0; i < OBC_MODULE_MAX; i++)
+        bc_job_group_limit(g_jobs, i, cfg->job_max_running, cfg->job_max_queued);
 
     for (int i = 0; i < cfg->module_count; i++) {
         const obc_module_cfg_t *mcfg = &cfg->modules[i];
@@ -721,6 +1039,7 @@ int obc_module_loader_init(obc_module_loader_t *loader,
         if (ret != 0) {
             LOG_ERROR("module", "Module '%s' obc_module_load returned %d",
                       mcfg->name, ret);
+            bc_job_cancel_group(g_jobs, loader->count);
             dl_close(handle);
             memset(lm, 0, sizeof(*lm));
             goto fail;
@@ -750,11 +1069,16 @@ void obc_module_loader_shutdown(obc_module_loader_t *loader)
     for (int i = loader->count - 1; i >= 0; i--) {
         obc_loaded_module_t *lm = &loader->modules[i];
 
+        /* Deliver this module's jobs (cancelled) while it can still free
+         * their arguments; again after shutdown for any it submitted
+         * there. No worker may be inside its code once the DLL closes. */
+        bc_job_cancel_group(g_jobs, i);
         if (lm->module.shutdown) {
             LOG_INFO("module", "Shutting down module '%s'",
                      lm->module.name ? lm->module.name : "(unknown)");
             lm->module.shutdown(&loader->api, &lm->module);
         }
+        bc_job_cancel_group(g_jobs, i);
 
         if (lm->dl_handle) {
             dl_close(lm->dl_handle);
@@ -762,5 +1086,21 @@ void obc_module_loader_shutdown(obc_module_loader_t *loader)
         }
     }
 
+    /* Module code is gone: no module timer or packet hook may run now */
+    for (int i = 0; i < BC_TIMER_MAX; i++) {
+        if (s_mod_timers[i].id == 0) continue;
+        bc_timer_cancel(&g_timers, s_mod_timers[i].id);
+        s_mod_timers[i].id = 0;
+    }
+    for (int i = 0; i < OBC_MODULE_MAX; i++)
+        bc_job_cancel_group(g_jobs, i);
+    for (int k = 0; k < BC_PACKET_HOOK_MAX; k++) {
+        if (s_mod_hooks[k].id == 0) continue;
+        bc_packet_hook_remove(&g_packet_hooks, s_mod_hooks[k].id);
+        s_mod_hooks[k].id = 0;
+    }
+    g_combat_kernels = bc_combat_default_kernels;
+    s_mod_kernels = bc_combat_default_kernels;
+
     loader->count = 0;
 }
@@ -1,24 +1,133 @@
 #include "openbc/peer.h"
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-void bc_peers_init(bc_peer_mgr_t *mgr)
+/* --- Address index (open addressing, linear probing) --- */
+
+static u32 addr_bucket(const bc_addr_t *addr)
+{
+    u32 h = addr->ip * 2654435761u;
+    h ^= (u32)addr->port * 40503u;
+    h ^= h >> 16;
+    return h & (BC_PEER_ADDR_BUCKETS - 1);
+}
+
+static void index_insert(bc_peer_mgr_t *mgr, int slot)
+{
+    u32 b = addr_bucket(&mgr->peers[slot].addr);
+    while (mgr->addr_index[b] >= 0)
+        b = (b + 1) & (BC_PEER_ADDR_BUCKETS - 1);
+    mgr->addr_index[b] = (i16)slot;
+}
+
+/* Backward-shift deletion keeps probe chains intact without tombstones.
+ * Must run while peers[slot].addr is still valid. */
+static void index_erase(bc_peer_mgr_t *mgr, int slot)
+{
+    const u32 mask = BC_PEER_ADDR_BUCKETS - 1;
+    u32 b = addr_bucket(&mgr->peers[slot].addr);
+    while (mgr->addr_index[b] >= 0 && mgr->addr_index[b] != slot)
+        b = (b + 1) & mask;
+    if (mgr->addr_index[b] < 0) return;  /* not indexed (dedi slot) */
+
+    u32 hole = b;
+    u32 j = b;
+    for (;;) {
+        j = (j + 1) & mask;
+        int s = mgr->addr_index[j];
+        if (s < 0) break;
+        u32 home = addr_bucket(&mgr->peers[s].addr);
+        /* Move s into the hole unless its home lies cyclically in (hole, j] */
+        bool stays = (hole <= j) ? (home > hole && home <= j)
+                                 : (home > hole || home <= j);
+        if (!stays) {
+            mgr->addr_index[hole] = (i16)s;
+            hole = j;
+        }
+    }
+    mgr->addr_index[hole] = -1;
+}
+
+/* --- Active slot list (ascending) --- */
+
+static void active_insert(bc_peer_mgr_t *mgr, int slot)
+{
+    int i = mgr->active_count;
+    while (i > 0 && mgr->active[i - 1] > slot) {
+        mgr->active[i] = mgr->active[i - 1];
+        i--;
+    }
+    mgr->active[i] = (u8)slot;
+    mgr->active_count++;
+}
+
+static void active_erase(bc_peer_mgr_t *mgr, int slot)
 {
+    for (int i = 0; i < mgr->active_count; i++) {
+        if (mgr->active[i] != slot) continue;
+        memmove(&mgr->active[i], &mgr->active[i + 1],
+                (size_t)(mgr->active_count - i - 1));
+        mgr->active_count--;
+        return;
+    }
+}
+
+bool bc_peers_init(bc_peer_mgr_t *mgr, int capacity)
+{
+    if (capacity < 1) capacity = 1;
+    if (capacity > BC_MAX_PLAYERS) capacity = BC_MAX_PLAYERS;
+
+    bc_peers_free(mgr);
     memset(mgr, 0, sizeof(*mgr));
-    for (int i = 0; i < BC_MAX_PLAYERS; i++) {
+    mgr->peers = calloc((size_t)capacity, sizeof(bc_peer_t));
+    if (!mgr->peers) return false;
+    mgr->capacity = capacity;
+
+    for (int i = 0; i < capacity; i++) {
         mgr->peers[i].state = PEER_EMPTY;
         mgr->peers[i].object_id = -1;
         mgr->peers[i].class_index = -1;
     }
+    for (int b = 0; b < BC_PEER_ADDR_BUCKETS; b++)
+        mgr->addr_index[b] = -1;
     mgr->count = 0;
+    mgr->active_count = 0;
+    return true;
+}
+
+void bc_peers_free(bc_peer_mgr_t *mgr)
+{
+    free(mgr->peers);
+    mgr->peers = NULL;
+    mgr->capacity = 0;
+    mgr->count = 0;
+    mgr->active_count = 0;
+}
+
+void bc_peers_reserve_dedicated(bc_peer_mgr_t *mgr, const char *name)
+{
+    if (mgr->capacity < 1 || mgr->peers[0].state != PEER_EMPTY) return;
+
+    mgr->peers[0].state = PEER_LOBBY;
+    snprintf(mgr->peers[0].name, sizeof(mgr->peers[0].name), "%s",
+             name ? name : "");
+    active_insert(mgr, 0);
+    mgr->count++;
+    mgr->dedicated = true;
 }
 
 int bc_peers_find(const bc_peer_mgr_t *mgr, const bc_addr_t *addr)
 {
-    for (int i = 0; i < BC_MAX_PLAYERS; i++) {
-        if (mgr->peers[i].state != PEER_EMPTY &&
-            bc_addr_equal(&mgr->peers[i].addr, addr)) {
-            return i;
-        }
+    if (mgr->capacity == 0) return -1;
+    u32 b = addr_bucket(addr);
+    for (int n = 0; n < BC_PEER_ADDR_BUCKETS; n++) {
+        int s = mgr->addr_index[b];
+        if (s < 0) return -1;
+        if (mgr->peers[s].state != PEER_EMPTY &&
+            bc_addr_equal(&mgr->peers[s].addr, addr))
+            return s;
+        b = (b + 1) & (BC_PEER_ADDR_BUCKETS - 1);
     }
     return -1;
 }
@@ -26,7 +135,7 @@ int bc_peers_find(const bc_peer_mgr_t *mgr, const bc_addr_t *addr)
 int bc_peers_add(bc_peer_mgr_t *mgr, const bc_addr_t *addr)
 {
     /* Find first empty slot */
-    for (int i = 0; i < BC_MAX_PLAYERS; i++) {
+    for (int i = 0; i < mgr->capacity; i++) {
         if (mgr->peers[i].state == PEER_EMPTY) {
             /* Zero the struct, then set fields.
              *
@@ -59,6 +168,8 @@ int bc_peers_add(bc_peer_mgr_t *mgr, const bc_addr_t *addr)
                 *cid = -1;
             }
             bc_outbox_init(&mgr->peers[i].outbox);
+            index_insert(mgr, i);
+            active_insert(mgr, i);
             mgr->count++;
             return i;
         }
@@ -68,9 +179,12 @@ int bc_peers_add(bc_peer_mgr_t *mgr, const bc_addr_t *addr)
 
 void bc_peers_remove(bc_peer_mgr_t *mgr, int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= mgr->capacity) return;
     if (mgr->peers[slot].state == PEER_EMPTY) return;
 
+    index_erase(mgr, slot);
+    active_erase(mgr, slot);
+
     /* Zero the entire struct to prevent stale data (last_recv_time, reliable
      * queue, etc.) from triggering spurious timeouts if the slot is reused.
      * Use volatile to prevent the -O2 dead-store elimination bug. */
@@ -84,13 +198,16 @@ void bc_peers_remove(bc_peer_mgr_t *mgr, int slot)
         *cid = -1;
     }
     mgr->count--;
+    if (slot == 0) mgr->dedicated = false;
 }
 
 int bc_peers_timeout(bc_peer_mgr_t *mgr, u32 now_ms, u32 timeout_ms)
 {
     int removed = 0;
-    for (int i = 0; i < BC_MAX_PLAYERS; i++) {
-        if (mgr->peers[i].state == PEER_EMPTY) continue;
+    /* Walk backwards: removal compacts active[] above the cursor only. */
+    for (int k = mgr->active_count - 1; k >= 0; k--) {
+        int i = mgr->active[k];
+        if (i == 0 && mgr->dedicated) continue;   /* never hears from itself */
         if (now_ms - mgr->peers[i].last_recv_time > timeout_ms) {
             bc_peers_remove(mgr, i);
             removed++;
@@ -0,0 +1,124 @@
+#include "openbc/packet_hook.h"
+
+#include <string.h>
+
+static bool mask_has(const u64 *mask, u8 opcode)
+{
+    return (mask[opcode >> 6] >> (opcode & 63)) & 1;
+}
+
+static void rebuild_mask(bc_packet_hooks_t *h)
+{
+    memset(h->mask, 0, sizeof(h->mask));
+    for (int i = 0; i < h->count; i++) {
+        if (h->hooks[i].id == 0) continue;
+        for (int w = 0; w < 4; w++) h->mask[w] |= h->hooks[i].mask[w];
+    }
+}
+
+/* Drop removed entries and re-sort hooks appended during a run (stable,
+ * so equal priorities stay in add order). Only outside a run. */
+static void compact(bc_packet_hooks_t *h)
+{
+    int n = 0;
+    for (int i = 0; i < h->count; i++) {
+        if (h->hooks[i].id == 0) continue;
+        bc_packet_hook_t hook = h->hooks[i];
+        int at = n;
+        while (at > 0 && h->hooks[at - 1].priority > hook.priority) {
+            h->hooks[at] = h->hooks[at - 1];
+            at--;
+        }
+        h->hooks[at] = hook;
+        n++;
+    }
+    h->count = n;
+    h->dirty = false;
+}
+
+void bc_packet_hooks_init(bc_packet_hooks_t *h)
+{
+    memset(h, 0, sizeof(*h));
+    h->next_id = 1;
+}
+
+int bc_packet_hook_add(bc_packet_hooks_t *h, const u8 *opcodes, int count,
+                       int priority, bc_packet_hook_fn fn, void *user)
+{
+    if (!fn || !opcodes || count < 1) return -1;
+    if (h->dirty && h->running == 0) compact(h);
+    if (h->count >= BC_PACKET_HOOK_MAX) return -1;
+
+    bc_packet_hook_t hook;
+    memset(&hook, 0, sizeof(hook));
+    for (int i = 0; i < count; i++)
+        hook.mask[opcodes[i] >> 6] |= 1ull << (opcodes[i] & 63);
+    hook.priority = priority;
+    hook.fn       = fn;
+    hook.user     = user;
+    hook.id       = h->next_id++;
+    if (h->next_id <= 0) h->next_id = 1;
+
+    /* After every hook of equal or lower priority value. During a run,
+     * append so no running index shifts; compact() sorts it in after. */
+    int at = h->count;
+    if (h->running == 0)
+        while (at > 0 && h->hooks[at - 1].priority > priority) at--;
+    else
+        h->dirty = true;
+    memmove(&h->hooks[at + 1], &h->hooks[at],
+            (size_t)(h->count - at) * sizeof(hook));
+    h->hooks[at] = hook;
+    h->count++;
+    for (int w = 0; w < 4; w++) h->mask[w] |= hook.mask[w];
+    return hook.id;
+}
+
+bool bc_packet_hook_remove(bc_packet_hooks_t *h, int id)
+{
+    if (id <= 0) return false;
+    for (int i = 0; i < h->count; i++) {
+        if (h->hooks[i].id != id) continue;
+        h->hooks[i].id = 0;
+        h->dirty = true;
+        if (h->running == 0) compact(h);
+        rebuild_mask(h);
+        return true;
+    }
+    return false;
+}
+
+int bc_packet_hook_run(bc_packet_hooks_t *h, int slot, u8 *data, int *len)
+{
+    if (*len < 1) return BC_PACKET_PASS;
+
+    int  verdict = BC_PACKET_PASS;
+    int  n = h->count;       /* hooks added during the run wait */
+    bool seen = false;
+    h->running++;
+    for (int i = 0; i < n; i++) {
+        bc_packet_hook_t *hook = &h->hooks[i];
+        if (hook->id == 0 || !mask_has(hook->mask, data[0])) continue;
+        seen = true;
+
+        int before = *len;
+        int r = hook->fn(hook->user, slot, data, len);
+        if (*len < 1 || *len > before) {
+            *len = before;
+            h->stats.bad_length++;
+            r = BC_PACKET_DROP;
+        }
+        if (r == BC_PACKET_DROP) {
+            verdict = BC_PACKET_DROP;
+            break;
+        }
+        if (r == BC_PACKET_REWRITE) verdict = BC_PACKET_REWRITE;
+    }
+    h->running--;
+    if (h->dirty && h->running == 0) compact(h);
+
+    if (seen) h->stats.seen++;
+    if (verdict == BC_PACKET_DROP) h->stats.dropped++;
+    else if (verdict == BC_PACKET_REWRITE) h->stats.rewritten++;
+    return verdict;
+}
@@ -0,0 +1,174 @@
+#include "openbc/server_bots.h"
+#include "openbc/server_state.h"
+#include "openbc/server_dispatch.h"
+#include "openbc/game_builders.h"
+#include "openbc/torpedo_tracker.h"
+#include "openbc/movement.h"
+#include "openbc/log.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Bots spawn on a ring around the origin, clear of the player spawns */
+#define BOT_SPAWN_RADIUS 1000.0f
+
+typedef struct {
+    bc_bot_world_t  world;
+    bc_ship_state_t ships[BC_BOT_MAX];    /* bot b flies ships[b] */
+    bc_ship_class_t classes[BC_BOT_MAX];  /* copied: reload-proof */
+    bc_projectile_def_t projectiles[BC_MAX_PROJECTILES]; /* ditto: the
+                                           * torpedo_type net IDs' defs */
+    int             projectile_count;
+    int             count;
+    bool            contact[BC_MAX_PLAYERS]; /* peer ship registered */
+} bc_server_bots_t;
+
+static bc_server_bots_t *g_bots;   /* heap; NULL = no bots */
+
+static int find_class(const char *name)
+{
+    if (!name[0]) return g_registry->ship_count > 0 ? 0 : -1;
+    for (int i = 0; i < g_registry->ship_count; i++)
+        if (strcmp(g_registry->ships[i].name, name) == 0) return i;
+    return -1;
+}
+
+/* The AI's fire callback: land the shot like a client's would */
+static void on_bot_fire(void *user, int bot, const bc_ship_state_t *target,
+                        bool torpedo, const u8 *pkt, int len)
+{
+    (void)user; (void)pkt; (void)len;
+    int target_slot = find_peer_by_object(target->object_id);
+    if (target_slot < 0) return;
+
+    const bc_ship_state_t *ship = &g_bots->ships[bot];
+    if (!torpedo) {
+        bc_bot_beam_hit(ship, &g_bots->classes[bot], target_slot);
+        return;
+    }
+
+    const bc_projectile_def_t *proj = NULL;
+    for (int i = 0; i < g_bots->projectile_count; i++)
+        if (g_bots->projectiles[i].net_type_id == ship->torpedo_type)
+            proj = &g_bots->projectiles[i];
+    if (!proj) return;
+    bc_vec3_t dir = bc_vec3_normalize(bc_vec3_sub(target->pos, ship->pos));
+    bc_torpedo_spawn(&g_torpedoes, ship->object_id, -1, target->object_id,
+                     ship->pos, dir, proj->launch_speed,
+                     proj->damage, proj->damage * proj->damage_radius_factor,
+                     proj->lifetime, proj->guidance_lifetime,
+                     proj->max_angular_accel);
+}
+
+bool bc_server_bots_init(const obc_server_cfg_t *cfg)
+{
+    bc_server_bots_shutdown();
+    if (cfg->bot_count <= 0) return true;
+    if (!g_registry_loaded) {
+        LOG_WARN("bots", "No ship registry loaded; bots disabled");
+        return false;
+    }
+
+    int cidx = find_class(cfg->bot_ship);
+    if (cidx < 0) {
+        LOG_WARN("bots", "Unknown bot ship class '%s'; bots disabled",
+                 cfg->bot_ship);
+        return false;
+    }
+
+    g_bots = calloc(1, sizeof(*g_bots));
+    if (!g_bots) {
+        LOG_WARN("bots", "Out of memory; bots disabled");
+        return false;
+    }
+
+    bc_bot_cfg_t bcfg;
+    bc_bot_cfg_defaults(&bcfg);
+    bcfg.think_interval = cfg->bot_think_interval;
+    bcfg.max_decisions  = cfg->bot_max_decisions;
+    bcfg.budget_us      = (u32)cfg->bot_budget_us;
+    bc_bot_world_init(&g_bots->world, &bcfg);
+    g_bots->world.on_fire = on_bot_fire;
+    memcpy(g_bots->projectiles, g_registry->projectiles,
+           sizeof(g_bots->projectiles));
+    g_bots->projectile_count = g_registry->projectile_count;
+
+    int n = cfg->bot_count < BC_BOT_MAX ? cfg->bot_count : BC_BOT_MAX;
+    for (int b = 0; b < n; b++) {
+        bc_ship_class_t *cls = &g_bots->classes[b];
+        bc_ship_state_t *ship = &g_bots->ships[b];
+        *cls = g_registry->ships[cidx];
+        bc_ship_init(ship, cls, cidx, bc_make_ship_id(BC_MAX_PLAYERS + b),
+                     0, BC_TEAM_NONE);
+        bc_ship_assign_subsystem_ids(ship, cls);
+        f32 angle = 6.2831853f * (f32)b / (f32)n;
+        ship->pos.x = BOT_SPAWN_RADIUS * cosf(angle);
+        ship->pos.z = BOT_SPAWN_RADIUS * sinf(angle);
+        if (bc_bot_add(&g_bots->world, ship, cls) != b) break;
+        g_bots->count++;
+    }
+
+    LOG_INFO("bots", "%d bot(s) spawned as %s", g_bots->count,
+             g_registry->ships[cidx].name);
+    return g_bots->count > 0;
+}
+
+/* Register player ships as they spawn, drop them as they die or leave */
+static void sync_contacts(void)
+{
+    int cap = g_peers.capacity < BC_MAX_PLAYERS ? g_peers.capacity
+                                                : BC_MAX_PLAYERS;
+    for (int i = 1; i < cap; i++) {
+        const bc_peer_t *p = &g_peers.peers[i];
+        bool live = p->state >= PEER_IN_GAME && p->has_ship;
+        if (live == g_bots->contact[i]) continue;
+        if (live) {
+            if (!bc_bot_add_contact(&g_bots->world, &p->ship)) continue;
+        } else {
+            bc_bot_remove_contact(&g_bots->world, &p->ship);
+        }
+        g_bots->contact[i] = live;
+    }
+}
+
+void bc_server_bots_tick(f32 dt)
+{
+    if (!g_bots) return;
+
+    sync_contacts();
+    bc_bot_world_tick(&g_bots->world, dt);
+    for (int b = 0; b < g_bots->count; b++) {
+        bc_ship_state_t *ship = &g_bots->ships[b];
+        if (ship->alive)
+            bc_ship_systems_tick(ship, &g_bots->classes[b], dt);
+    }
+}
+
+void bc_server_bots_shutdown(void)
+{
+    if (!g_bots) return;
+    const bc_bot_stats_t *st = &g_bots->world.stats;
+    LOG_INFO("bots", "Bots stopped: %u decisions, %u phaser / %u torpedo shots",
+             st->decisions, st->phasers_fired, st->torpedoes_fired);
+    free(g_bots);
+    g_bots = NULL;
+}
+
+const bc_bot_world_t *bc_server_bots_world(void)
+{
+    return g_bots ? &g_bots->world : NULL;
+}
+
+bool bc_server_bot_find(i32 object_id, const bc_ship_state_t **ship,
+                        const bc_ship_class_t **cls)
+{
+    if (!g_bots) return false;
+    for (int b = 0; b < g_bots->count; b++) {
+        if (g_bots->ships[b].object_id != object_id) continue;
+        *ship = &g_bots->ships[b];
+        *cls = &g_bots->classes[b];
+        return true;
+    }
+    return false;
+}
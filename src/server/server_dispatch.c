@@ -18,6 +18,8 @@
 #include "openbc/torpedo_tracker.h"
 #include "openbc/reliable.h"
 #include "openbc/master.h"
+#include "openbc/server_events.h"
+#include "openbc/server_bots.h"
 #include "openbc/log.h"
 
 #include <stdio.h>
@@ -42,7 +44,10 @@ void bc_handle_gamespy(bc_socket_t *sock, const bc_addr_t *from,
     /* Rebuild player list: player_0 = "Dedicated Server" (always),
      * then one entry per connected human player. */
     g_info.player_count = 1;  /* slot 0 = dedi, already set at init */
-    for (int i = 1; i < BC_MAX_PLAYERS && g_info.player_count < BC_MAX_PLAYERS; i++) {
+    for (int k = 0; k < g_peers.active_count &&
+                    g_info.player_count < BC_MAX_PLAYERS; k++) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
         if (g_peers.peers[i].state != PEER_EMPTY) {
             snprintf(g_info.player_names[g_info.player_count],
                      sizeof(g_info.player_names[0]),
@@ -107,15 +112,19 @@ static int bc_mission_init_total_slots(void)
     return BC_MISSION_INIT_PLAYER_LIMIT;
 }
 
-/* Return a player's name for log output. Falls back to "slot N" if unnamed. */
+/* Return a player's name for log output. Falls back to "slot N" if unnamed.
+ * Fallbacks rotate through two buffers so one log line can name both sides. */
 static const char *peer_name(int slot)
 {
-    static char fallback[24];
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return "???";
+    static char fallback[2][24];
+    static int next;
+    if (slot < 0 || slot >= g_peers.capacity) return "???";
     if (g_peers.peers[slot].name[0] != '\0')
         return g_peers.peers[slot].name;
-    snprintf(fallback, sizeof(fallback), "slot %d", slot);
-    return fallback;
+    char *buf = fallback[next];
+    next ^= 1;
+    snprintf(buf, sizeof(fallback[0]), "slot %d", slot);
+    return buf;
 }
 
 /* Resolve an object ID to its owning player's name.
@@ -126,7 +135,7 @@ static const char *object_owner_name(i32 object_id)
     int game_slot = bc_object_id_to_slot(object_id);
     if (game_slot < 0) return "???";
     int peer_slot = game_slot + 1;
-    if (peer_slot >= BC_MAX_PLAYERS) return "???";
+    if (peer_slot >= g_peers.capacity) return "???";
     return peer_name(peer_slot);
 }
 
@@ -138,7 +147,7 @@ int find_peer_by_object(i32 object_id)
     int game_slot = bc_object_id_to_slot(object_id);
     if (game_slot < 0) return -1;
     int peer_slot = game_slot + 1;
-    if (peer_slot >= BC_MAX_PLAYERS) return -1;
+    if (peer_slot >= g_peers.capacity) return -1;
     if (!g_peers.peers[peer_slot].has_ship) return -1;
     return peer_slot;
 }
@@ -175,68 +184,173 @@ f32 bc_powered_efficiency(const bc_ship_state_t *ship,
     return min_eff;
 }
 
+void bc_ship_systems_tick(bc_ship_state_t *ship, const bc_ship_class_t *cls,
+                          f32 dt)
+{
+    /* Collision cooldown decay */
+    if (ship->collision_cooldown > 0.0f) {
+        ship->collision_cooldown -= dt;
+        if (ship->collision_cooldown < 0.0f)
+            ship->collision_cooldown = 0.0f;
+    }
+
+    /* Reactor: generate power, compute per-subsystem efficiency */
+    bc_ship_power_tick(ship, cls, dt);
+
+    /* Server-side position estimate for range checks + torpedo targeting */
+    f32 eng_eff = bc_powered_efficiency(ship, cls, "impulse");
+    bc_ship_move_tick(ship, eng_eff, dt);
+
+    /* Shield recharge (shield gen is Base format, eff = 1.0) */
+    g_combat_kernels.shield_tick(ship, cls, 1.0f, dt);
+
+    /* Phaser charge + torpedo cooldown (use weapon efficiency) */
+    f32 wep_eff = bc_powered_efficiency(ship, cls, "phaser");
+    f32 pulse_eff = bc_powered_efficiency(ship, cls, "pulse_weapon");
+    f32 min_wep = (pulse_eff < wep_eff) ? pulse_eff : wep_eff;
+    bc_combat_charge_tick(ship, cls, min_wep, dt);
+    bc_combat_torpedo_tick(ship, cls, dt);
+
+    /* Cloak state machine (energy-failure auto-decloak) */
+    f32 clk_eff = bc_powered_efficiency(ship, cls, "cloak");
+    bc_cloak_tick(ship, /* cloak_efficiency */ clk_eff, /* dt */ dt);
+
+    /* Repair */
+    g_combat_kernels.repair_tick(ship, cls, dt);
+    bc_repair_auto_queue(ship, cls);
+}
+
+/* Number of ser_list entries a window from start to next covered
+ * (next == start means the window wrapped the whole list). */
+static int health_window_span(u8 start, u8 next, int count)
+{
+    if (count <= 0) return 0;
+    int d = ((int)next - (int)start + count) % count;
+    return d == 0 ? count : d;
+}
+
 /* Queue one subsystem-health window (flag 0x20) for a ship to all clients.
- * rr_idx is the health round-robin cursor to serialize from. */
-static int queue_health_update_window(int target_slot, u8 rr_idx, u8 *next_idx_out)
+ * start_idx is the ser_list position to serialize from.  Each variant is
+ * encoded once (owner: is_own_ship=true, no power_pct in Powered entries;
+ * remote: with power_pct) and only if someone will receive it; the same
+ * bytes then go to every remote observer.  Entries that reached all
+ * observers are marked sent in the ship's health tracker. */
+static int queue_health_update_window(int target_slot, u8 start_idx,
+                                      u8 *next_idx_out)
 {
     bc_peer_t *target = &g_peers.peers[target_slot];
     if (!target->has_ship || !target->ship.alive) return 0;
 
     const bc_ship_class_t *cls =
-        bc_registry_get_ship(&g_registry, target->class_index);
+        bc_peer_class(target);
     if (!cls) return 0;
 
-    /* Send from the requested round-robin position; cursor is NOT advanced.
-     * Owner gets is_own_ship=true (no power_pct in Powered entries),
-     * remote observers get is_own_ship=false (with power_pct). */
+    bool want_own = target->state >= PEER_LOBBY;
+    bool want_rmt = false;
+    for (int k = 0; k < g_peers.active_count && !want_rmt; k++) {
+        int j = g_peers.active[k];
+        if (j == 0 || j == target_slot) continue;  /* dedi / owner */
+        if (g_peers.peers[j].state >= PEER_LOBBY) want_rmt = true;
+    }
+    if (!want_own && !want_rmt) return 0;
+
     u8 hbuf_own[128], hbuf_rmt[128];
-    u8 next_own, next_rmt;
-    int hlen_own = bc_ship_build_health_update(
-        &target->ship, cls, g_game_time,
-        rr_idx, &next_own, true,
-        hbuf_own, sizeof(hbuf_own));
-    int hlen_rmt = bc_ship_build_health_update(
-        &target->ship, cls, g_game_time,
-        rr_idx, &next_rmt, false,
-        hbuf_rmt, sizeof(hbuf_rmt));
-
-    if (next_idx_out) *next_idx_out = next_own;
-
-    for (int j = 1; j < BC_MAX_PLAYERS; j++) {
-        if (g_peers.peers[j].state < PEER_LOBBY) continue;
-        if (j == target_slot && hlen_own > 0) {
-            bc_queue_unreliable(j, hbuf_own, hlen_own);
-        } else if (j != target_slot && hlen_rmt > 0) {
+    u8 next_own = start_idx, next_rmt = start_idx;
+    int hlen_own = 0, hlen_rmt = 0;
+    bc_ship_build_health_pair(&target->ship, cls, g_game_time, start_idx,
+                              want_own ? hbuf_own : NULL, sizeof(hbuf_own),
+                              &hlen_own, &next_own,
+                              want_rmt ? hbuf_rmt : NULL, sizeof(hbuf_rmt),
+                              &hlen_rmt, &next_rmt);
+
+    /* Round-robin follows the owner variant (smaller budget per entry, so
+     * it may cover more entries -- the remote version just sends more data
+     * this tick). */
+    if (next_idx_out) *next_idx_out = want_own ? next_own : next_rmt;
+
+    if (want_own && hlen_own > 0)
+        bc_queue_unreliable(target_slot, hbuf_own, hlen_own);
+    if (want_rmt && hlen_rmt > 0) {
+        for (int k = 0; k < g_peers.active_count; k++) {
+            int j = g_peers.active[k];
+            if (j == 0 || j == target_slot) continue;
+            if (g_peers.peers[j].state < PEER_LOBBY) continue;
             bc_queue_unreliable(j, hbuf_rmt, hlen_rmt);
         }
     }
 
-    return (hlen_own > 0 || hlen_rmt > 0) ? 1 : 0;
+    if (hlen_own <= 0 && hlen_rmt <= 0) return 0;
+
+    /* Entries are "sent" only once every audience has them. */
+    int count = cls->ser_list.count;
+    int covered = count;
+    if (want_own) {
+        int span = hlen_own > 0 ? health_window_span(start_idx, next_own, count) : 0;
+        if (span < covered) covered = span;
+    }
+    if (want_rmt) {
+        int span = hlen_rmt > 0 ? health_window_span(start_idx, next_rmt, count) : 0;
+        if (span < covered) covered = span;
+    }
+    bc_health_track_sent(&g_health_track[target_slot], cls, start_idx, covered);
+    return 1;
 }
 
 /* Send an immediate subsystem health update (flag 0x20) for a ship to all
  * clients.  Called after server-authoritative damage (collisions, beams,
  * torpedoes) so clients see the HP change without waiting for the periodic
- * health broadcast tick.
+ * health broadcast tick.  The window opens at the most recently changed
+ * entry, so the subsystem that was just hit is in it.
  *
  * Does NOT advance the round-robin cursor (subsys_rr_idx).  The periodic
- * health tick in main.c owns cursor advancement.  If damage handlers also
- * advanced it, the periodic cycle would be disrupted -- entries would be
- * sent out of cadence and the client would see flickering health bars. */
+ * health tick owns cursor advancement.  If damage handlers also advanced
+ * it, the periodic cycle would be disrupted -- entries would be sent out
+ * of cadence and the client would see flickering health bars. */
 static void send_health_update_immediate(int target_slot)
 {
     bc_peer_t *target = &g_peers.peers[target_slot];
     if (!target->has_ship || !target->ship.alive) return;
 
-    u8 next_idx = target->subsys_rr_idx;
-    if (queue_health_update_window(target_slot, target->subsys_rr_idx, &next_idx) <= 0)
+    const bc_ship_class_t *cls =
+        bc_peer_class(target);
+    if (!cls) return;
+
+    bool priority = false;
+    u8 start = bc_health_track_pick(&g_health_track[target_slot],
+                                    &target->ship, cls,
+                                    target->subsys_rr_idx, true, &priority);
+    u8 next_idx = start;
+    if (queue_health_update_window(target_slot, start, &next_idx) <= 0)
         return;
 
-    LOG_DEBUG("health", "slot=%d immediate health (rr=%d)",
-              target_slot, target->subsys_rr_idx);
+    LOG_DEBUG("health", "slot=%d immediate health (start=%d rr=%d%s)",
+              target_slot, start, target->subsys_rr_idx,
+              priority ? " changed" : "");
     /* NOTE: subsys_rr_idx is NOT updated -- periodic tick owns the cursor */
 }
 
+void bc_health_broadcast_tick(int slot)
+{
+    if (slot <= 0 || slot >= g_peers.capacity) return;
+    bc_peer_t *p = &g_peers.peers[slot];
+    if (!p->has_ship || !p->ship.alive) return;
+
+    const bc_ship_class_t *cls =
+        bc_peer_class(p);
+    if (!cls) return;
+
+    bool priority = false;
+    u8 start = bc_health_track_pick(&g_health_track[slot], &p->ship, cls,
+                                    p->subsys_rr_idx, false, &priority);
+    u8 next_idx = start;
+    if (queue_health_update_window(slot, start, &next_idx) <= 0)
+        return;
+
+    /* Priority windows are extra; the round-robin resumes where it was. */
+    if (!priority)
+        p->subsys_rr_idx = next_idx;
+}
+
 /* Queue a full 0x20 health round-robin cycle for one ship, then optionally
  * flush the owner immediately to keep local HUD feedback responsive. */
 static int send_health_update_full_cycle(int target_slot, bool flush_owner)
@@ -245,9 +359,14 @@ static int send_health_update_full_cycle(int target_slot, bool flush_owner)
     if (!target->has_ship || !target->ship.alive) return 0;
 
     const bc_ship_class_t *cls =
-        bc_registry_get_ship(&g_registry, target->class_index);
+        bc_peer_class(target);
     if (!cls || cls->ser_list.count <= 0) return 0;
 
+    /* Refresh the tracker so the burst clears what it carries. */
+    bool priority = false;
+    (void)bc_health_track_pick(&g_health_track[target_slot], &target->ship,
+                               cls, target->subsys_rr_idx, true, &priority);
+
     u8 start_idx = target->subsys_rr_idx;
     u8 cursor = start_idx;
     int sent_packets = 0;
@@ -285,26 +404,29 @@ static int repair_event_bucket_for_type(const char *type)
     return 5;  /* all other subsystem types */
 }
 
-/* Snapshot pre-damage HP, compare after, generate ADD_TO_REPAIR_LIST PythonEvents
- * for newly-damaged primary subsystem buckets. This matches stock-like repair
- * UI behavior and prevents reliable-queue overload on high-subsystem ships. */
+/* Generate ADD_TO_REPAIR_LIST PythonEvents for newly-damaged primary
+ * subsystem buckets, from the subsystems the last hit damaged (the caller
+ * zeroes journal.hit_subsys before applying it). This matches stock-like
+ * repair UI behavior and prevents reliable-queue overload on
+ * high-subsystem ships. */
 static void generate_damage_events(int target_slot,
-                                    const f32 *hp_before,
                                     const bc_ship_class_t *cls)
 {
     bc_peer_t *target = &g_peers.peers[target_slot];
     bc_ship_state_t *ship = &target->ship;
     bool sent_bucket[6] = { false, false, false, false, false, false };
+    u64 hit = ship->journal.hit_subsys;
 
-    for (int i = 0; i < cls->subsystem_count && i < BC_MAX_SUBSYSTEMS; i++) {
+    for (int i = 0; hit != 0 && i < cls->subsystem_count && i < BC_MAX_SUBSYSTEMS; i++) {
+        if (!(hit & ((u64)1 << i))) continue;
+        hit &= ~((u64)1 << i);
         int bucket = repair_event_bucket_for_type(cls->subsystems[i].type);
         if (bucket < 0 || bucket >= (int)(sizeof(sent_bucket) / sizeof(sent_bucket[0])) ||
             sent_bucket[bucket]) {
             continue;
         }
 
-        if (ship->subsystem_hp[i] < hp_before[i] &&
-            ship->subsystem_hp[i] < cls->subsystems[i].max_condition) {
+        if (ship->subsystem_hp[i] < cls->subsystems[i].max_condition) {
             /* Subsystem took damage — try to add to repair queue */
             if (bc_repair_add(ship, (u8)i)) {
                 /* New addition (not duplicate) — send ADD_TO_REPAIR_LIST */
@@ -384,7 +506,7 @@ static f32 class_damage_modifier(const bc_ship_class_t *attacker_cls,
 
 static void sync_peer_score_slot(int slot)
 {
-    if (slot < 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot < 0 || slot >= g_peers.capacity) return;
     if (g_peers.peers[slot].state == PEER_EMPTY) return;
     g_peers.peers[slot].score = g_player_scores[slot];
     g_peers.peers[slot].kills = g_player_kills[slot];
@@ -394,7 +516,7 @@ static void sync_peer_score_slot(int slot)
 static void clear_target_damage_ledger(int target_slot)
 {
     if (target_slot < 0 || target_slot >= BC_MAX_PLAYERS) return;
-    memset(g_damage_ledger[target_slot], 0, sizeof(g_damage_ledger[target_slot]));
+    bc_ledger_clear(&g_damage_ledger[target_slot]);
 }
 
 static void record_damage_ledger(int attacker_slot, int target_slot,
@@ -415,8 +537,45 @@ static void record_damage_ledger(int attacker_slot, int target_slot,
         hull_damage = -hull_damage;
     }
 
-    g_damage_ledger[target_slot][attacker_slot].shield_damage += shield_damage;
-    g_damage_ledger[target_slot][attacker_slot].hull_damage += hull_damage;
+    bc_ledger_add(&g_damage_ledger[target_slot], attacker_slot,
+                  shield_damage, hull_damage);
+}
+
+/* "ship_damaged" for one applied hit (raw, pre-modifier deltas). A hit
+ * is noted when it lands and fired by flush_ship_damaged once its whole
+ * flow -- repair events, health update, kill handling -- has run, so a
+ * handler that changes or despawns the ship never lands mid-flow. */
+#define DAMAGE_NOTE_MAX 4   /* a collision damages at most two ships */
+
+static obc_damage_event_t g_damage_notes[DAMAGE_NOTE_MAX];
+static int g_damage_note_count;
+
+static void flush_ship_damaged(void)
+{
+    /* Copied out first: a handler may land hits of its own */
+    obc_damage_event_t notes[DAMAGE_NOTE_MAX];
+    int n = g_damage_note_count;
+    memcpy(notes, g_damage_notes, (size_t)n * sizeof(notes[0]));
+    g_damage_note_count = 0;
+    for (int i = 0; i < n; i++)
+        bc_server_event_fire(g_ev.ship_damaged, notes[i].attacker_slot, &notes[i]);
+}
+
+static void note_ship_damaged(int target_slot, int attacker_slot, int source,
+                              f32 shield_damage, f32 hull_damage)
+{
+    if (!bc_server_event_wanted(g_ev.ship_damaged)) return;
+    if (shield_damage <= 0.0f && hull_damage <= 0.0f) return;
+    if (attacker_slot <= 0) attacker_slot = -1;
+    if (g_damage_note_count == DAMAGE_NOTE_MAX) flush_ship_damaged();
+    g_damage_notes[g_damage_note_count++] = (obc_damage_event_t){
+        .target_slot    = target_slot,
+        .attacker_slot  = attacker_slot,
+        .source         = source,
+        .shield_damage  = shield_damage,
+        .hull_damage    = hull_damage,
+        .hull_remaining = g_peers.peers[target_slot].ship.hull_hp,
+    };
 }
 
 static void end_game_locked(i32 reason, const char *why)
@@ -428,6 +587,11 @@ static void end_game_locked(i32 reason, const char *why)
     g_game_ended = true;
     g_accept_new_players = false;
     LOG_INFO("game", "EndGame: reason=%d (%s)", (int)reason, why ? why : "?");
+
+    if (bc_server_event_wanted(g_ev.game_ended)) {
+        obc_game_end_event_t ev = { .reason = (int)reason };
+        bc_server_event_fire(g_ev.game_ended, -1, &ev);
+    }
 }
 
 static void broadcast_team_scores(void)
@@ -459,7 +623,9 @@ static void check_limit_after_kill(void)
             }
         }
     } else {
-        for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+        for (int k = 0; k < g_peers.active_count; k++) {
+            int i = g_peers.active[k];
+            if (i == 0) continue;  /* dedi */
             i32 value = g_use_score_limit ? g_player_scores[i] : g_player_kills[i];
             if (value >= threshold) {
                 reached = true;
@@ -476,16 +642,16 @@ static void check_limit_after_kill(void)
     }
 }
 
-static void process_ship_kill(int killer_slot, int victim_slot,
-                              bool self_destruct)
+/* method is OBC_KILL_*; only SELF_DESTRUCT changes scoring. */
+static void process_ship_kill(int killer_slot, int victim_slot, int method)
 {
     if (g_game_ended) return;
-    if (victim_slot <= 0 || victim_slot >= BC_MAX_PLAYERS) return;
+    if (victim_slot <= 0 || victim_slot >= g_peers.capacity) return;
 
     i32 victim_player_id = bc_player_id_from_peer_slot(victim_slot);
     if (!bc_is_valid_player_id(victim_player_id)) return;
 
-    bool has_killer = (killer_slot > 0 && killer_slot < BC_MAX_PLAYERS);
+    bool has_killer = (killer_slot > 0 && killer_slot < g_peers.capacity);
     i32 killer_player_id = 0;
     if (has_killer) {
         killer_player_id = bc_player_id_from_peer_slot(killer_slot);
@@ -507,7 +673,7 @@ static void process_ship_kill(int killer_slot, int victim_slot,
             u8 team = g_player_teams[killer_slot];
             if (g_team_mode && team < 2) g_team_kills[team]++;
         }
-    } else if (self_destruct && g_team_mode) {
+    } else if (method == OBC_KILL_SELF_DESTRUCT && g_team_mode) {
         u8 victim_team = g_player_teams[victim_slot];
         if (victim_team == BC_TEAM_NONE)
             victim_team = g_peers.peers[victim_slot].ship.team_id;
@@ -517,12 +683,15 @@ static void process_ship_kill(int killer_slot, int victim_slot,
         }
     }
 
-    bc_score_entry_t extra[BC_MAX_PLAYERS];
+    bc_score_entry_t extra[BC_LEDGER_MAX_ATTACKERS];
     int extra_count = 0;
 
-    for (int attacker = 1; attacker < BC_MAX_PLAYERS; attacker++) {
-        f32 total_damage = g_damage_ledger[victim_slot][attacker].shield_damage +
-                           g_damage_ledger[victim_slot][attacker].hull_damage;
+    /* Ledger entries are sorted by attacker slot (same order as a full scan). */
+    const bc_damage_ledger_t *ledger = &g_damage_ledger[victim_slot];
+    for (int e = 0; e < ledger->count; e++) {
+        int attacker = ledger->entries[e].attacker;
+        f32 total_damage = ledger->entries[e].shield_damage +
+                           ledger->entries[e].hull_damage;
         if (fabsf(total_damage) < 0.001f) continue;
 
         i32 delta = (i32)(total_damage / 10.0f);
@@ -539,7 +708,7 @@ static void process_ship_kill(int killer_slot, int victim_slot,
         if (!has_killer || attacker != killer_slot) {
             i32 player_id = bc_player_id_from_peer_slot(attacker);
             if (bc_is_valid_player_id(player_id) &&
-                extra_count < BC_MAX_PLAYERS) {
+                extra_count < BC_LEDGER_MAX_ATTACKERS) {
                 extra[extra_count].player_id = player_id;
                 extra[extra_count].score = g_player_scores[attacker];
                 extra_count++;
@@ -565,6 +734,17 @@ static void process_ship_kill(int killer_slot, int victim_slot,
 
     if (g_team_mode) broadcast_team_scores();
     clear_target_damage_ledger(victim_slot);
+
+    if (bc_server_event_wanted(g_ev.ship_killed)) {
+        obc_kill_event_t ev = {
+            .victim_slot = victim_slot,
+            .killer_slot = has_killer ? killer_slot : -1,
+            .method      = method,
+        };
+        bc_server_event_fire(g_ev.ship_killed, has_killer ? killer_slot : -1,
+                             &ev);
+    }
+
     check_limit_after_kill();
 }
 
@@ -579,15 +759,18 @@ static void reset_round_for_restart(void)
     memset(g_reconnect_scores, 0, sizeof(g_reconnect_scores));
     for (int i = 0; i < BC_MAX_PLAYERS; i++) g_player_teams[i] = BC_TEAM_NONE;
 
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
         g_peers.peers[i].score = 0;
         g_peers.peers[i].kills = 0;
         g_peers.peers[i].deaths = 0;
         g_peers.peers[i].respawn_timer = 0.0f;
-        g_peers.peers[i].respawn_class = -1;
+        g_peers.peers[i].respawn_species = -1;
         g_peers.peers[i].has_ship = false;
         g_peers.peers[i].spawn_len = 0;
         g_peers.peers[i].class_index = -1;
+        g_peers.peers[i].registry = NULL;
     }
 
     bc_torpedo_mgr_init(&g_torpedoes);
@@ -599,17 +782,22 @@ static void reset_round_for_restart(void)
                      : -1.0f;
 }
 
-/* Apply beam damage: compute, send Explosion, check kill. */
-static void apply_beam_damage(int shooter_slot, int target_slot)
+/* Log name for a shooter slot; server-owned bots have none (slot < 0) */
+static const char *shooter_name(int slot)
+{
+    return slot < 0 ? "bot" : peer_name(slot);
+}
+
+/* Land one beam hit from shooter (a peer's ship, or a bot's when
+ * shooter_slot < 0): compute, send Explosion, check kill. */
+static void land_beam_hit(int shooter_slot, const bc_ship_state_t *shooter,
+                          const bc_ship_class_t *shooter_cls, int target_slot)
 {
-    bc_peer_t *shooter = &g_peers.peers[shooter_slot];
     bc_peer_t *target = &g_peers.peers[target_slot];
     if (!target->has_ship || !target->ship.alive) return;
 
-    const bc_ship_class_t *shooter_cls =
-        bc_registry_get_ship(&g_registry, shooter->class_index);
     const bc_ship_class_t *target_cls =
-        bc_registry_get_ship(&g_registry, target->class_index);
+        bc_peer_class(target);
     if (!shooter_cls || !target_cls) return;
 
     /* Find the first alive phaser subsystem and use its max_damage.
@@ -618,7 +806,7 @@ static void apply_beam_damage(int shooter_slot, int target_slot)
     for (int i = 0; i < shooter_cls->subsystem_count; i++) {
         const bc_subsystem_def_t *ss = &shooter_cls->subsystems[i];
         if (strcmp(ss->type, "phaser") == 0 || strcmp(ss->type, "pulse_weapon") == 0) {
-            if (shooter->ship.subsystem_hp[i] > 0.0f) {
+            if (shooter->subsystem_hp[i] > 0.0f) {
                 damage = ss->max_damage;
                 break;
             }
@@ -628,17 +816,17 @@ static void apply_beam_damage(int shooter_slot, int target_slot)
 
     /* Compute impact direction: shooter -> target */
     bc_vec3_t impact_dir = bc_vec3_normalize(
-        bc_vec3_sub(target->ship.pos, shooter->ship.pos));
+        bc_vec3_sub(target->ship.pos, shooter->pos));
 
-    /* Snapshot HP before damage for PythonEvent generation + score ledger */
-    f32 hp_snap[BC_MAX_SUBSYSTEMS];
-    memcpy(hp_snap, target->ship.subsystem_hp, sizeof(hp_snap));
+    /* Scope the journal's hit set to this hit (PythonEvent generation);
+     * shield/hull totals before damage feed the score ledger */
+    target->ship.journal.hit_subsys = 0;
     f32 shield_before = total_shields(&target->ship);
     f32 hull_before = target->ship.hull_hp;
 
     /* Apply damage server-side (phaser = directed, no blast radius) */
-    bc_combat_apply_damage(&target->ship, target_cls, damage, 0.0f,
-                           impact_dir, false, 1.0f);
+    g_combat_kernels.apply_damage(&target->ship, target_cls, damage, 0.0f,
+                                  impact_dir, false, 1.0f);
 
     f32 shield_after = total_shields(&target->ship);
     f32 hull_after = target->ship.hull_hp;
@@ -650,9 +838,11 @@ static void apply_beam_damage(int shooter_slot, int target_slot)
     record_damage_ledger(shooter_slot, target_slot,
                          shooter_cls, target_cls,
                          shield_delta, hull_delta);
+    note_ship_damaged(target_slot, shooter_slot, OBC_DAMAGE_BEAM,
+                      shield_delta, hull_delta);
 
     /* Generate ADD_TO_REPAIR_LIST PythonEvents for newly-damaged subsystems */
-    generate_damage_events(target_slot, hp_snap, target_cls);
+    generate_damage_events(target_slot, target_cls);
 
     /* Send authoritative health to all clients.
      * No server-generated Explosion — clients compute beam hit detection
@@ -662,22 +852,22 @@ static void apply_beam_damage(int shooter_slot, int target_slot)
     send_health_update_immediate(target_slot);
 
     LOG_INFO("combat", "Server damage: %s -> %s, %.1f dmg (hull=%.1f)",
-             peer_name(shooter_slot), peer_name(target_slot),
+             shooter_name(shooter_slot), peer_name(target_slot),
              damage, target->ship.hull_hp);
 
     /* Check for kill */
     if (!target->ship.alive) {
         LOG_INFO("combat", "%s destroyed by %s",
-                 peer_name(target_slot), peer_name(shooter_slot));
+                 peer_name(target_slot), shooter_name(shooter_slot));
 
         /* Send OBJECT_EXPLODING PythonEvent */
         {
             u8 expl[25];
             int elen = bc_build_python_exploding_event(
                 expl, sizeof(expl),
-                shooter->ship.object_id,
+                shooter->object_id,
                 target->ship.object_id,
-                shooter->ship.object_id,
+                shooter->object_id,
                 BC_SHIP_DEATH_EXPLODING_EVENT_LIFETIME_SEC);
             if (elen > 0) bc_send_to_all(expl, elen, true);
         }
@@ -698,19 +888,33 @@ static void apply_beam_damage(int shooter_slot, int target_slot)
             if (blen > 0) bc_send_to_all(boom, blen, true);
         }
 
-        process_ship_kill(shooter_slot, target_slot, false);
+        process_ship_kill(shooter_slot, target_slot, OBC_KILL_WEAPON);
 
         /* Clear victim ship state and disable server auto-respawn.
          * Client is responsible for initiating respawn via ObjCreateTeam. */
         target->has_ship = false;
         target->respawn_timer = 0.0f;
-        target->respawn_class = -1;
-
+        target->respawn_species = -1;
     }
+
+    flush_ship_damaged();
+}
+
+static void apply_beam_damage(int shooter_slot, int target_slot)
+{
+    bc_peer_t *shooter = &g_peers.peers[shooter_slot];
+    land_beam_hit(shooter_slot, &shooter->ship, bc_peer_class(shooter),
+                  target_slot);
+}
+
+void bc_bot_beam_hit(const bc_ship_state_t *ship, const bc_ship_class_t *cls,
+                     int target_slot)
+{
+    land_beam_hit(-1, ship, cls, target_slot);
 }
 
 /* Torpedo hit callback -- called from bc_torpedo_tick() */
-void bc_torpedo_hit_callback(int shooter_slot, i32 target_id,
+void bc_torpedo_hit_callback(int shooter_slot, i32 shooter_id, i32 target_id,
                              f32 damage, f32 damage_radius,
                              bc_vec3_t impact_pos,
                              void *user_data)
@@ -720,29 +924,35 @@ void bc_torpedo_hit_callback(int shooter_slot, i32 target_id,
     int target_slot = find_peer_by_object(target_id);
     if (target_slot < 0) return;
 
-    bc_peer_t *shooter = &g_peers.peers[shooter_slot];
     bc_peer_t *target = &g_peers.peers[target_slot];
     if (!target->has_ship || !target->ship.alive) return;
 
+    /* A bot's torpedo (shooter_slot < 0) is a miss once the bot is gone */
+    const bc_ship_state_t *shooter = NULL;
+    const bc_ship_class_t *shooter_cls = NULL;
+    if (shooter_slot >= 0) {
+        shooter = &g_peers.peers[shooter_slot].ship;
+        shooter_cls = bc_peer_class(&g_peers.peers[shooter_slot]);
+    } else if (!bc_server_bot_find(shooter_id, &shooter, &shooter_cls)) {
+        return;
+    }
     const bc_ship_class_t *target_cls =
-        bc_registry_get_ship(&g_registry, target->class_index);
-    const bc_ship_class_t *shooter_cls =
-        bc_registry_get_ship(&g_registry, shooter->class_index);
+        bc_peer_class(target);
     if (!target_cls || !shooter_cls) return;
 
     /* Impact direction from torpedo position to target */
     bc_vec3_t impact_dir = bc_vec3_normalize(
         bc_vec3_sub(target->ship.pos, impact_pos));
 
-    /* Snapshot HP before damage for PythonEvent generation + score ledger */
-    f32 hp_snap[BC_MAX_SUBSYSTEMS];
-    memcpy(hp_snap, target->ship.subsystem_hp, sizeof(hp_snap));
+    /* Scope the journal's hit set to this hit (PythonEvent generation);
+     * shield/hull totals before damage feed the score ledger */
+    target->ship.journal.hit_subsys = 0;
     f32 shield_before = total_shields(&target->ship);
     f32 hull_before = target->ship.hull_hp;
 
     /* Torpedoes are area-effect with a blast radius */
-    bc_combat_apply_damage(&target->ship, target_cls, damage, damage_radius,
-                           impact_dir, (damage_radius > 0.0f), 1.0f);
+    g_combat_kernels.apply_damage(&target->ship, target_cls, damage, damage_radius,
+                                  impact_dir, (damage_radius > 0.0f), 1.0f);
 
     f32 shield_after = total_shields(&target->ship);
     f32 hull_after = target->ship.hull_hp;
@@ -754,32 +964,34 @@ void bc_torpedo_hit_callback(int shooter_slot, i32 target_id,
     record_damage_ledger(shooter_slot, target_slot,
                          shooter_cls, target_cls,
                          shield_delta, hull_delta);
+    note_ship_damaged(target_slot, shooter_slot, OBC_DAMAGE_TORPEDO,
+                      shield_delta, hull_delta);
 
     /* Generate ADD_TO_REPAIR_LIST PythonEvents for newly-damaged subsystems */
-    generate_damage_events(target_slot, hp_snap, target_cls);
+    generate_damage_events(target_slot, target_cls);
 
     /* Send authoritative health to all clients.
      * No server-generated Explosion — clients generate their own
      * visual Explosion events from local torpedo hit detection. */
     send_health_update_immediate(target_slot);
 
-    LOG_INFO("combat", "Torpedo hit: slot %d -> %s, %.1f dmg (hull=%.1f)",
-             shooter_slot, peer_name(target_slot),
+    LOG_INFO("combat", "Torpedo hit: %s -> %s, %.1f dmg (hull=%.1f)",
+             shooter_name(shooter_slot), peer_name(target_slot),
              damage, target->ship.hull_hp);
 
     /* Check for kill */
     if (!target->ship.alive) {
         LOG_INFO("combat", "%s destroyed by torpedo from %s",
-                 peer_name(target_slot), peer_name(shooter_slot));
+                 peer_name(target_slot), shooter_name(shooter_slot));
 
         /* Send OBJECT_EXPLODING PythonEvent */
         {
             u8 expl[25];
             int elen = bc_build_python_exploding_event(
                 expl, sizeof(expl),
-                shooter->ship.object_id,
+                shooter->object_id,
                 target->ship.object_id,
-                shooter->ship.object_id,
+                shooter->object_id,
                 BC_SHIP_DEATH_EXPLODING_EVENT_LIFETIME_SEC);
             if (elen > 0) bc_send_to_all(expl, elen, true);
         }
@@ -797,14 +1009,15 @@ void bc_torpedo_hit_callback(int shooter_slot, i32 target_id,
             if (blen > 0) bc_send_to_all(boom, blen, true);
         }
 
-        process_ship_kill(shooter_slot, target_slot, false);
+        process_ship_kill(shooter_slot, target_slot, OBC_KILL_WEAPON);
 
         /* Disable server auto-respawn; respawn must be client-initiated. */
         target->has_ship = false;
         target->respawn_timer = 0.0f;
-        target->respawn_class = -1;
-
+        target->respawn_species = -1;
     }
+
+    flush_ship_damaged();
 }
 
 /* Torpedo target position callback -- called from bc_torpedo_tick() */
@@ -885,6 +1098,22 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         return;
     }
 
+    /* Module packet hooks: a single mask test unless some module asked for
+     * this opcode. Hooks may drop the message or rewrite it in place. */
+    if (bc_packet_hook_wanted(&g_packet_hooks, opcode)) {
+        int verdict = bc_packet_hook_run(&g_packet_hooks, peer_slot,
+                                         (u8 *)payload, &payload_len);
+        if (verdict == BC_PACKET_DROP) {
+            LOG_DEBUG("game", "slot=%d opcode=0x%02X (%s) dropped by hook",
+                      peer_slot, opcode, name ? name : "?");
+            return;
+        }
+        if (verdict == BC_PACKET_REWRITE && payload[0] != opcode) {
+            opcode = payload[0];
+            name = bc_opcode_name(opcode);
+        }
+    }
+
     switch (opcode) {
 
     /* --- Chat echo to all including sender (reliable) --- */
@@ -900,7 +1129,8 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         }
 
         bc_chat_event_t ev;
-        if (bc_parse_chat_message(chat_payload, payload_len, &ev)) {
+        bool parsed = bc_parse_chat_message(chat_payload, payload_len, &ev);
+        if (parsed) {
             LOG_INFO("chat", "[%s] %s: %s",
                      opcode == BC_MSG_CHAT ? "ALL" : "TEAM",
                      peer_name(peer_slot), ev.message);
@@ -909,6 +1139,18 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                      peer_slot, opcode == BC_MSG_CHAT ? "ALL" : "TEAM",
                      payload_len);
         }
+
+        obc_event_id_t chat_id = opcode == BC_MSG_CHAT ? g_ev.chat
+                                                       : g_ev.team_chat;
+        if (parsed && bc_server_event_wanted(chat_id)) {
+            obc_chat_event_t cev = {
+                .slot      = peer_slot,
+                .team_only = opcode == BC_MSG_TEAM_CHAT,
+                .message   = ev.message,
+            };
+            obc_event_result_t r = bc_server_event_fire(chat_id, peer_slot, &cev);
+            if (r.cancelled || r.suppress_relay) break;
+        }
         bc_send_to_all(chat_payload, payload_len, true);
         break;
     }
@@ -939,7 +1181,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
     case BC_OP_START_CLOAK:
         if (g_registry_loaded && peer->has_ship) {
             const bc_ship_class_t *cls =
-                bc_registry_get_ship(&g_registry, peer->class_index);
+                bc_peer_class(peer);
             if (cls && !bc_cloak_start(&peer->ship, cls)) {
                 LOG_WARN("cheat", "slot=%d invalid cloak start (state=%d)",
                          peer_slot, peer->ship.cloak_state);
@@ -962,7 +1204,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         if (g_registry_loaded && peer->has_ship) {
             /* Verify warp drive subsystem is alive */
             const bc_ship_class_t *cls =
-                bc_registry_get_ship(&g_registry, peer->class_index);
+                bc_peer_class(peer);
             if (cls) {
                 bool warp_alive = false;
                 for (int si = 0; si < cls->subsystem_count; si++) {
@@ -1017,14 +1259,29 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
             LOG_INFO("combat", "%s fired torpedo (no lock)",
                      object_owner_name(ev.shooter_id));
 
+        /* Modules may veto the relay (suppress_relay) and/or the
+         * server-side damage (cancelled). */
+        obc_event_result_t hook = {0};
+        if (bc_server_event_wanted(g_ev.torpedo_fire)) {
+            obc_weapon_fire_event_t fev = {
+                .shooter_slot = peer_slot,
+                .target_slot  = ev.has_target ? find_peer_by_object(ev.target_id) : -1,
+                .shooter_id   = ev.shooter_id,
+                .target_id    = ev.has_target ? ev.target_id : -1,
+            };
+            hook = bc_server_event_fire(g_ev.torpedo_fire, peer_slot, &fev);
+        }
+
         /* Relay torpedo visual to all others (strict N-1:1 ratio, no filtering).
          * Stock BC relays all weapon fire unconditionally. Anti-cheat checks
          * only gate server-side damage computation, not the visual relay. */
-        bc_relay_to_others(peer_slot, payload, payload_len, true);
+        if (!hook.suppress_relay)
+            bc_relay_to_others(peer_slot, payload, payload_len, true);
+        if (hook.cancelled) break;
 
         if (g_registry_loaded && peer->has_ship) {
             const bc_ship_class_t *cls =
-                bc_registry_get_ship(&g_registry, peer->class_index);
+                bc_peer_class(peer);
 
             /* Anti-cheat: cannot fire while cloaked -- skip damage only */
             if (cls && !bc_cloak_can_fire(&peer->ship)) {
@@ -1061,7 +1318,8 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         if (g_registry_loaded && peer->has_ship) {
             /* Look up projectile stats from registry */
             const bc_projectile_def_t *proj =
-                bc_registry_get_projectile(&g_registry, peer->ship.torpedo_type);
+                bc_registry_get_projectile(bc_peer_registry(peer),
+                                           peer->ship.torpedo_type);
             if (proj) {
                 bc_vec3_t vel_dir = bc_vec3_normalize(
                     (bc_vec3_t){ev.vel_x, ev.vel_y, ev.vel_z});
@@ -1094,14 +1352,29 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
             LOG_INFO("combat", "%s fired beam (no target)",
                      object_owner_name(ev.shooter_id));
 
+        /* Modules may veto the relay (suppress_relay) and/or the
+         * server-side damage (cancelled). */
+        obc_event_result_t hook = {0};
+        if (bc_server_event_wanted(g_ev.beam_fire)) {
+            obc_weapon_fire_event_t fev = {
+                .shooter_slot = peer_slot,
+                .target_slot  = ev.has_target ? find_peer_by_object(ev.target_id) : -1,
+                .shooter_id   = ev.shooter_id,
+                .target_id    = ev.has_target ? ev.target_id : -1,
+            };
+            hook = bc_server_event_fire(g_ev.beam_fire, peer_slot, &fev);
+        }
+
         /* Relay beam visual to all others (strict N-1:1 ratio, no filtering).
          * Stock BC relays all weapon fire unconditionally. Anti-cheat checks
          * only gate server-side damage computation, not the visual relay. */
-        bc_relay_to_others(peer_slot, payload, payload_len, true);
+        if (!hook.suppress_relay)
+            bc_relay_to_others(peer_slot, payload, payload_len, true);
+        if (hook.cancelled) break;
 
         if (g_registry_loaded && peer->has_ship) {
             const bc_ship_class_t *cls =
-                bc_registry_get_ship(&g_registry, peer->class_index);
+                bc_peer_class(peer);
 
             /* Anti-cheat: cannot fire while cloaked -- skip damage only */
             if (cls && !bc_cloak_can_fire(&peer->ship)) {
@@ -1217,6 +1490,12 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                               peer_slot);
                     break;
                 }
+
+                /* Per-observer thinning by distance / cloak (interest.h).
+                 * Positions above are the server-tracked ones it uses. */
+                bc_relay_state_update(peer_slot, payload, payload_len,
+                                      su.dirty);
+                break;
             }
         }
         bc_relay_to_others(peer_slot, payload, payload_len, false);
@@ -1274,11 +1553,11 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         /* Initialize server-side ship state from the ship blob */
         if (g_registry_loaded && opcode == BC_OP_OBJ_CREATE_TEAM &&
             have_ship_blob) {
-            int cidx = bc_registry_find_ship_index(&g_registry,
+            int cidx = bc_registry_find_ship_index(g_registry,
                                                    bhdr.species_id);
             if (cidx >= 0) {
                 const bc_ship_class_t *cls =
-                    bc_registry_get_ship(&g_registry, cidx);
+                    bc_registry_get_ship(g_registry, cidx);
                 u8 team_id = (header_ok && hdr.has_team) ? hdr.team_id : 0;
                 if (header_ok && hdr.has_team && team_id < 2) {
                     if (!peer->has_ship) {
@@ -1297,8 +1576,10 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                 peer->ship.pos.y = bhdr.pos_y;
                 peer->ship.pos.z = bhdr.pos_z;
                 peer->class_index = cidx;
+                peer->registry = g_registry;
                 peer->has_ship = true;
                 peer->subsys_rr_idx = 0;
+                bc_health_track_reset(&g_health_track[peer_slot]);
                 memset(peer->last_fire_time, 0, sizeof(peer->last_fire_time));
                 memset(peer->last_torpedo_time, 0, sizeof(peer->last_torpedo_time));
                 peer->fire_violations = 0;
@@ -1387,8 +1668,9 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
             }
 
             /* Tell the joining player about each existing in-game peer */
-            for (int i = 1; i < BC_MAX_PLAYERS; i++) {
-                if (i == peer_slot) continue;
+            for (int k = 0; k < g_peers.active_count; k++) {
+                int i = g_peers.active[k];
+                if (i == 0 || i == peer_slot) continue;
                 if (g_peers.peers[i].state < PEER_IN_GAME) continue;
                 u8 gs = (u8)(i > 0 ? i - 1 : 0);
                 u8 wp = (u8)(i + 1);  /* wire_slot */
@@ -1403,6 +1685,11 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         }
 
         bc_flush_peer(peer_slot);
+
+        if (bc_server_event_wanted(g_ev.new_player_in_game)) {
+            obc_player_event_t pev = { .slot = peer_slot, .name = peer->name };
+            bc_server_event_fire(g_ev.new_player_in_game, peer_slot, &pev);
+        }
         break;
     }
 
@@ -1415,7 +1702,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                                   ((u32)payload[4] << 24));
             u8 team_id = payload[5];
             int team_slot = (int)player_id - 1;
-            if (team_slot > 0 && team_slot < BC_MAX_PLAYERS && team_id < 2) {
+            if (team_slot > 0 && team_slot < g_peers.capacity && team_id < 2) {
                 g_player_teams[team_slot] = team_id;
                 if (g_peers.peers[team_slot].has_ship)
                     g_peers.peers[team_slot].ship.team_id = team_id;
@@ -1441,7 +1728,9 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
 
         /* Explicitly destroy active ships before reset so all clients
          * clear world objects even if they missed local state transitions. */
-        for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+        for (int k = 0; k < g_peers.active_count; k++) {
+            int i = g_peers.active[k];
+            if (i == 0) continue;  /* dedi */
             bc_peer_t *rp = &g_peers.peers[i];
             if (!rp->has_ship) continue;
             i32 obj_id = rp->ship.object_id;
@@ -1456,6 +1745,9 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         int rlen = bc_build_restart_game(rpkt, sizeof(rpkt));
         if (rlen > 0) bc_send_to_all(rpkt, rlen, true);
         reset_round_for_restart();
+
+        if (bc_server_event_wanted(g_ev.game_restarted))
+            bc_server_event_fire(g_ev.game_restarted, peer_slot, NULL);
         break;
     }
 
@@ -1476,7 +1768,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         }
 
         const bc_ship_class_t *cls =
-            bc_registry_get_ship(&g_registry, peer->class_index);
+            bc_peer_class(peer);
         if (!cls) break;
 
         LOG_INFO("combat", "%s self-destructed", peer_name(peer_slot));
@@ -1485,15 +1777,20 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
          * then set hull to 0. We intentionally broadcast zero-health 0x20
          * updates before flipping alive=false so the owner's HUD bars can
          * drain immediately instead of waiting on periodic round-robin. */
-        f32 hp_snap[BC_MAX_SUBSYSTEMS];
-        memcpy(hp_snap, peer->ship.subsystem_hp, sizeof(hp_snap));
-
-        for (int i = 0; i < cls->subsystem_count && i < BC_MAX_SUBSYSTEMS; i++)
+        bc_ship_journal_t *j = &peer->ship.journal;
+        j->hit_subsys = 0;
+        for (int i = 0; i < cls->subsystem_count && i < BC_MAX_SUBSYSTEMS; i++) {
+            if (peer->ship.subsystem_hp[i] <= 0.0f) continue;
             peer->ship.subsystem_hp[i] = 0.0f;
+            bc_ship_journal_subsys_damaged(j, i);
+            bc_ship_journal_event(j, BC_SHIP_EV_SUBSYS_DESTROYED, (u8)i);
+        }
         peer->ship.hull_hp = 0.0f;
+        j->changed |= BC_SHIP_CHG_HULL | BC_SHIP_CHG_DESTROYED;
+        bc_ship_journal_event(j, BC_SHIP_EV_DESTROYED, 0);
 
         /* Generate ADD_TO_REPAIR_LIST PythonEvents for every destroyed subsystem */
-        generate_damage_events(peer_slot, hp_snap, cls);
+        generate_damage_events(peer_slot, cls);
 
         /* Push a full health window burst now (all-zero subsystem conditions)
          * and flush owner immediately for responsive local visual feedback. */
@@ -1514,13 +1811,13 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
         }
 
         /* Score: death for self, no killer player (killer_slot=-1). */
-        process_ship_kill(-1, peer_slot, true);
+        process_ship_kill(-1, peer_slot, OBC_KILL_SELF_DESTRUCT);
 
         /* Clear ship state. For self-destruct, stock BC waits for the
          * client to pick a ship and send ObjCreateTeam (no auto-respawn). */
         peer->has_ship = false;
         peer->respawn_timer = 0.0f;
-        peer->respawn_class = -1;
+        peer->respawn_species = -1;
         break;
     }
 
@@ -1606,7 +1903,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
             if (target_slot >= 0) {
                 bc_peer_t *target = &g_peers.peers[target_slot];
                 const bc_ship_class_t *tcls =
-                    bc_registry_get_ship(&g_registry, target->class_index);
+                    bc_peer_class(target);
 
                 if (tcls && target->ship.alive) {
                     f32 dmg = bc_combat_collision_damage_path2(
@@ -1619,9 +1916,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                         source_attacker_slot = find_peer_by_object(
                             cev.source_object_id);
                         if (source_attacker_slot >= 0) {
-                            source_attacker_cls = bc_registry_get_ship(
-                                &g_registry,
-                                g_peers.peers[source_attacker_slot].class_index);
+                            source_attacker_cls = bc_peer_class(&g_peers.peers[source_attacker_slot]);
                         }
                     }
 
@@ -1642,16 +1937,14 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                     };
                     f32 collision_radius = tcls->bounding_extent * 0.5f;
 
-                    /* Snapshot HP before damage for PythonEvent generation */
-                    f32 thp_snap[BC_MAX_SUBSYSTEMS];
-                    memcpy(thp_snap, target->ship.subsystem_hp,
-                           sizeof(thp_snap));
+                    /* Scope the journal's hit set for PythonEvent generation */
+                    target->ship.journal.hit_subsys = 0;
                     f32 target_shield_before = total_shields(&target->ship);
                     f32 target_hull_before = target->ship.hull_hp;
 
-                    bc_combat_apply_damage(&target->ship, tcls, dmg,
-                                           collision_radius, scaled_impact,
-                                           false, 1.5f);
+                    g_combat_kernels.apply_damage(&target->ship, tcls, dmg,
+                                                  collision_radius, scaled_impact,
+                                                  false, 1.5f);
 
                     f32 target_shield_after = total_shields(&target->ship);
                     f32 target_hull_after = target->ship.hull_hp;
@@ -1665,9 +1958,13 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                                          source_attacker_cls, tcls,
                                          target_shield_delta,
                                          target_hull_delta);
+                    note_ship_damaged(target_slot, source_attacker_slot,
+                                      OBC_DAMAGE_COLLISION,
+                                      target_shield_delta,
+                                      target_hull_delta);
 
                     /* Generate ADD_TO_REPAIR_LIST PythonEvents */
-                    generate_damage_events(target_slot, thp_snap, tcls);
+                    generate_damage_events(target_slot, tcls);
 
                     /* Collision damage is communicated via health update
                      * (flag 0x20), NOT via Explosion events.  The stock host
@@ -1720,7 +2017,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                         /* Disable server auto-respawn; respawn is client-driven. */
                         target->has_ship = false;
                         target->respawn_timer = 0.0f;
-                        target->respawn_class = -1;
+                        target->respawn_species = -1;
 
                         /* Kill credit: if another ship caused this,
                          * credit them */
@@ -1729,13 +2026,15 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                             killer = find_peer_by_object(
                                 cev.source_object_id);
                         if (killer >= 0) {
-                            process_ship_kill(killer, target_slot, false);
+                            process_ship_kill(killer, target_slot,
+                                              OBC_KILL_COLLISION);
                             LOG_INFO("combat",
                                      "%s destroyed in collision with %s",
                                      peer_name(target_slot),
                                      peer_name(killer));
                         } else {
-                            process_ship_kill(-1, target_slot, false);
+                            process_ship_kill(-1, target_slot,
+                                              OBC_KILL_COLLISION);
                             LOG_INFO("combat",
                                      "%s destroyed in collision",
                                      peer_name(target_slot));
@@ -1757,7 +2056,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                 if (src_slot >= 0) {
                     bc_peer_t *source = &g_peers.peers[src_slot];
                     const bc_ship_class_t *scls =
-                        bc_registry_get_ship(&g_registry, source->class_index);
+                        bc_peer_class(source);
 
                     if (scls && source->ship.alive) {
                         f32 sdmg = bc_combat_collision_damage_path2(
@@ -1766,9 +2065,7 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
 
                         const bc_ship_class_t *target_attacker_cls = NULL;
                         if (target_slot >= 0) {
-                            target_attacker_cls = bc_registry_get_ship(
-                                &g_registry,
-                                g_peers.peers[target_slot].class_index);
+                            target_attacker_cls = bc_peer_class(&g_peers.peers[target_slot]);
                         }
 
                         /* Flipped impact direction */
@@ -1787,16 +2084,14 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                         };
                         f32 src_coll_radius = scls->bounding_extent * 0.5f;
 
-                        /* Snapshot HP for PythonEvent generation */
-                        f32 shp_snap[BC_MAX_SUBSYSTEMS];
-                        memcpy(shp_snap, source->ship.subsystem_hp,
-                               sizeof(shp_snap));
+                        /* Scope the journal's hit set for PythonEvent generation */
+                        source->ship.journal.hit_subsys = 0;
                         f32 source_shield_before = total_shields(&source->ship);
                         f32 source_hull_before = source->ship.hull_hp;
 
-                        bc_combat_apply_damage(&source->ship, scls, sdmg,
-                                               src_coll_radius, src_scaled,
-                                               false, 1.5f);
+                        g_combat_kernels.apply_damage(&source->ship, scls, sdmg,
+                                                      src_coll_radius, src_scaled,
+                                                      false, 1.5f);
 
                         f32 source_shield_after = total_shields(&source->ship);
                         f32 source_hull_after = source->ship.hull_hp;
@@ -1813,9 +2108,13 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                                              target_attacker_cls, scls,
                                              source_shield_delta,
                                              source_hull_delta);
+                        note_ship_damaged(src_slot, target_slot,
+                                          OBC_DAMAGE_COLLISION,
+                                          source_shield_delta,
+                                          source_hull_delta);
 
                         /* Generate ADD_TO_REPAIR_LIST PythonEvents */
-                        generate_damage_events(src_slot, shp_snap, scls);
+                        generate_damage_events(src_slot, scls);
 
                         /* No Explosion for collision — see target path comment */
                         send_health_update_immediate(src_slot);
@@ -1854,19 +2153,21 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                             /* Disable server auto-respawn; respawn is client-driven. */
                             source->has_ship = false;
                             source->respawn_timer = 0.0f;
-                            source->respawn_class = -1;
+                            source->respawn_species = -1;
 
                             /* Kill credit: target killed the source */
                             if (target_slot >= 0 &&
                                 g_peers.peers[target_slot].has_ship) {
-                                process_ship_kill(target_slot, src_slot, false);
+                                process_ship_kill(target_slot, src_slot,
+                                                  OBC_KILL_COLLISION);
                                 LOG_INFO("combat",
                                          "%s destroyed in collision "
                                          "with %s",
                                          peer_name(src_slot),
                                          peer_name(target_slot));
                             } else {
-                                process_ship_kill(-1, src_slot, false);
+                                process_ship_kill(-1, src_slot,
+                                                  OBC_KILL_COLLISION);
                                 LOG_INFO("combat",
                                          "%s destroyed in collision",
                                          peer_name(src_slot));
@@ -1918,6 +2219,9 @@ static void handle_game_message(int peer_slot, const bc_transport_msg_t *msg)
                  peer_slot, opcode, name ? name : "?", payload_len);
         break;
     }
+
+    /* Collision hits, once both ships' damage and kills are handled */
+    flush_ship_damaged();
 }
 
 /* --- Packet handler --- */
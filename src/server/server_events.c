@@ -0,0 +1,30 @@
+#include "openbc/server_events.h"
+
+bc_server_events_t g_ev;
+const obc_engine_api_t *g_event_api;
+
+void bc_server_events_register(void)
+{
+    g_ev.chat                = obc_event_register("chat");
+    g_ev.team_chat           = obc_event_register("team_chat");
+    g_ev.beam_fire           = obc_event_register("beam_fire");
+    g_ev.torpedo_fire        = obc_event_register("torpedo_fire");
+    g_ev.ship_damaged        = obc_event_register("ship_damaged");
+    g_ev.ship_killed         = obc_event_register("ship_killed");
+    g_ev.ship_respawned      = obc_event_register("ship_respawned");
+    g_ev.player_connected    = obc_event_register("player_connected");
+    g_ev.player_disconnected = obc_event_register("player_disconnected");
+    g_ev.new_player_in_game  = obc_event_register("new_player_in_game");
+    g_ev.game_ended          = obc_event_register("game_ended");
+    g_ev.game_restarted      = obc_event_register("game_restarted");
+    g_ev.game_tick           = obc_event_register("game_tick");
+    g_ev.game_tick_1s        = obc_event_register("game_tick_1s");
+    g_ev.server_start        = obc_event_register("server_start");
+    g_ev.server_shutdown     = obc_event_register("server_shutdown");
+}
+
+obc_event_result_t bc_server_event_fire(obc_event_id_t id, int sender_slot,
+                                        const void *data)
+{
+    return obc_event_fire_id(g_event_api, id, sender_slot, data);
+}
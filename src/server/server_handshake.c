@@ -7,6 +7,7 @@
 #include "openbc/handshake.h"
 #include "openbc/reliable.h"
 #include "openbc/master.h"
+#include "openbc/server_events.h"
 #include "openbc/game_events.h"
 #include "openbc/game_builders.h"
 #include "openbc/player_ids.h"
@@ -43,6 +44,14 @@ static int reserve_reconnect_score_slot(const char *name)
     return 0; /* Overwrite oldest slot if cache is full. */
 }
 
+/* Drop damage dealt to and by a slot from every victim's ledger. */
+static void forget_slot_damage(int slot)
+{
+    bc_ledger_clear(&g_damage_ledger[slot]);
+    for (int t = 0; t < BC_MAX_PLAYERS; t++)
+        bc_ledger_forget(&g_damage_ledger[t], slot);
+}
+
 static void clear_slot_score_state(int slot)
 {
     if (slot <= 0 || slot >= BC_MAX_PLAYERS) return;
@@ -50,16 +59,12 @@ static void clear_slot_score_state(int slot)
     g_player_kills[slot] = 0;
     g_player_deaths[slot] = 0;
     g_player_teams[slot] = BC_TEAM_NONE;
-    memset(g_damage_ledger[slot], 0, sizeof(g_damage_ledger[slot]));
-    for (int t = 0; t < BC_MAX_PLAYERS; t++) {
-        g_damage_ledger[t][slot].shield_damage = 0.0f;
-        g_damage_ledger[t][slot].hull_damage = 0.0f;
-    }
+    forget_slot_damage(slot);
 }
 
 static void store_reconnect_score(int slot)
 {
-    if (slot <= 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot <= 0 || slot >= g_peers.capacity) return;
     const char *name = g_peers.peers[slot].name;
     if (!name || name[0] == '\0') return;
 
@@ -79,7 +84,7 @@ static void store_reconnect_score(int slot)
 
 void bc_try_restore_reconnect_score(int slot, const char *name)
 {
-    if (slot <= 0 || slot >= BC_MAX_PLAYERS) return;
+    if (slot <= 0 || slot >= g_peers.capacity) return;
     int idx = find_reconnect_score_by_name(name);
     if (idx < 0) return;
 
@@ -95,7 +100,7 @@ void bc_try_restore_reconnect_score(int slot, const char *name)
     g_peers.peers[slot].kills = saved->kills;
     g_peers.peers[slot].deaths = saved->deaths;
 
-    if (old_slot > 0 && old_slot < BC_MAX_PLAYERS &&
+    if (old_slot > 0 && old_slot < g_peers.capacity &&
         old_slot != slot &&
         g_peers.peers[old_slot].state == PEER_EMPTY) {
         clear_slot_score_state(old_slot);
@@ -204,7 +209,9 @@ static void send_settings_and_gameinit(int peer_slot)
      * Team modes: one SCORE_INIT (0x3F) per active player + TEAM_SCORE (0x40) per team. */
     {
         int sent = 0;
-        for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+        for (int k = 0; k < g_peers.active_count; k++) {
+            int i = g_peers.active[k];
+            if (i == 0) continue;  /* dedi */
             if (g_peers.peers[i].state >= PEER_LOBBY) {
                 i32 player_id = bc_player_id_from_peer_slot(i);
                 if (!bc_is_valid_player_id(player_id)) {
@@ -252,8 +259,9 @@ static void send_settings_and_gameinit(int peer_slot)
     }
 
     /* Forward cached ObjCreateTeam for every already-spawned ship */
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
-        if (i == peer_slot) continue;
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0 || i == peer_slot) continue;
         bc_peer_t *other = &g_peers.peers[i];
         if (other->state >= PEER_LOBBY && other->has_ship && other->spawn_len > 0) {
             bc_queue_reliable(peer_slot, other->spawn_payload, other->spawn_len);
@@ -292,12 +300,12 @@ static void send_settings_and_gameinit(int peer_slot)
  *     -- is suppressed, which is exactly the threat described in issue #40.
  *
  * The ring buffer holds the last BC_CONNECT_RATE_SLOTS disconnected IPs.
- * With 16 slots and a 2-second window this comfortably covers every
- * realistic scenario (BC_MAX_PLAYERS is 9).
+ * Sized to BC_MAX_PLAYERS so even a full server dropping at once within
+ * the 2-second window keeps every departing IP.
  * ---------------------------------------------------------------------------
  */
 #define BC_CONNECT_RATE_LIMIT_MS  2000  /* 2-second cooldown after disconnect */
-#define BC_CONNECT_RATE_SLOTS     16    /* ring-buffer size; ≥ BC_MAX_PLAYERS  */
+#define BC_CONNECT_RATE_SLOTS     BC_MAX_PLAYERS  /* ring-buffer size */
 
 typedef struct {
     u32 ip;              /* network-byte-order IPv4 address           */
@@ -337,6 +345,13 @@ void bc_handle_peer_disconnect(int slot)
 {
     if (g_peers.peers[slot].state == PEER_EMPTY) return;
 
+    /* Fired while the slot is still populated so handlers can read it. */
+    if (bc_server_event_wanted(g_ev.player_disconnected)) {
+        obc_player_event_t ev = { .slot = slot,
+                                  .name = g_peers.peers[slot].name };
+        bc_server_event_fire(g_ev.player_disconnected, slot, &ev);
+    }
+
     /* Preserve score/team entries for reconnect by player name. */
     g_player_scores[slot] = g_peers.peers[slot].score;
     g_player_kills[slot] = g_peers.peers[slot].kills;
@@ -346,11 +361,8 @@ void bc_handle_peer_disconnect(int slot)
     store_reconnect_score(slot);
 
     /* Clear any pending damage ledger entries tied to this slot. */
-    memset(g_damage_ledger[slot], 0, sizeof(g_damage_ledger[slot]));
-    for (int t = 0; t < BC_MAX_PLAYERS; t++) {
-        g_damage_ledger[t][slot].shield_damage = 0.0f;
-        g_damage_ledger[t][slot].hull_damage = 0.0f;
-    }
+    forget_slot_damage(slot);
+    bc_interest_reset_slot(&g_interest, slot);
 
     g_stats.disconnects++;
 
@@ -415,7 +427,7 @@ void bc_handle_peer_disconnect(int slot)
     }
 
     g_peers.peers[slot].respawn_timer = 0.0f;
-    g_peers.peers[slot].respawn_class = -1;
+    g_peers.peers[slot].respawn_species = -1;
 
     /* Rate-limit guard: stamp this IP so a rapid reconnect is rejected.
      * Must be called before bc_peers_remove() while the addr is still valid. */
@@ -506,6 +518,12 @@ void bc_handle_connect(const bc_addr_t *from, int len)
         rec->connect_time = bc_ms_now();
     }
 
+    if (bc_server_event_wanted(g_ev.player_connected)) {
+        obc_player_event_t ev = { .slot = slot,
+                                  .name = g_peers.peers[slot].name };
+        bc_server_event_fire(g_ev.player_connected, slot, &ev);
+    }
+
     /* Send Connect response + first ChecksumReq batched in one packet.
      * Stock dedi always batches these (msgs=2).  This reduces round-trip
      * latency and matches trace behavior exactly.
@@ -569,39 +587,100 @@ void bc_handle_connect(const bc_addr_t *from, int len)
     (void)len;
 }
 
+/* Boot a peer whose checksum response failed to parse or validate */
+static void boot_for_checksum(int peer_slot)
+{
+    g_stats.boots_checksum++;
+    u8 boot[4];
+    int blen = bc_bootplayer_build(boot, sizeof(boot), BC_BOOT_CHECKSUM);
+    if (blen > 0) bc_queue_reliable(peer_slot, boot, blen);
+    bc_handle_peer_disconnect(peer_slot);
+}
+
+/* Spare for a full frame arena. The response is already ACKed, so the
+ * client never resends it: dropping it on allocator pressure would leave
+ * the peer stuck in PEER_CHECKSUMMING. One is enough -- the check below
+ * does not nest. */
+static bc_checksum_resp_t g_checksum_resp_spare;
+
+/* Parse a checksum response and, for rounds 0-3, validate it against the
+ * manifest. bc_checksum_resp_t is ~10 KB, so it is scratch in the frame
+ * arena (released before returning, so several responses in one receive
+ * pass do not pile up) rather than on the stack. Logs the outcome; false
+ * means the peer must be booted. */
+static bool check_checksum_response(int peer_slot, int round,
+                                    const bc_transport_msg_t *msg)
+{
+    size_t mark = bc_arena_mark(&g_frame);
+    bc_checksum_resp_t *resp = bc_arena_alloc(&g_frame, sizeof(*resp));
+    if (!resp) resp = &g_checksum_resp_spare;
+
+    bool ok = bc_checksum_response_parse(resp, msg->payload, msg->payload_len);
+    if (!ok && round != 0xFF) {
+        LOG_WARN("handshake", "slot=%d round %d parse error (len=%d)",
+                 peer_slot, round, msg->payload_len);
+    } else if (!ok) {
+        /* Full hex dump for debugging */
+        int dump_len = msg->payload_len < 128 ? msg->payload_len : 128;
+        char hex[128 * 3 + 1];
+        int hpos = 0;
+        for (int i = 0; i < dump_len; i++) {
+            int wrote = snprintf(hex + hpos, sizeof(hex) - (size_t)hpos,
+                                 "%02X ", msg->payload[i]);
+            if (wrote < 0 || hpos + wrote >= (int)sizeof(hex)) break;
+            hpos += wrote;
+        }
+        hex[hpos] = '\0';
+        LOG_WARN("handshake", "slot=%d round 0xFF parse error (len=%d)",
+                 peer_slot, msg->payload_len);
+        LOG_WARN("handshake", "  hex=[%s]", hex);
+    } else if (round == 0xFF) {
+        LOG_DEBUG("handshake", "slot=%d checksum round 0xFF validated "
+                  "(%d files, %d subdirs, dir=0x%08X)",
+                  peer_slot, resp->file_count, resp->subdir_count, resp->dir_hash);
+    } else {
+        bc_checksum_result_t result =
+            bc_checksum_response_validate(resp, &g_manifest.dirs[round]);
+        ok = (result == CHECKSUM_OK);
+        if (!ok)
+            LOG_WARN("handshake", "slot=%d round %d FAILED: %s "
+                     "(dir=0x%08X, %d files)",
+                     peer_slot, round, bc_checksum_result_name(result),
+                     resp->dir_hash, resp->file_count);
+        else
+            LOG_DEBUG("handshake", "slot=%d checksum round %d validated "
+                      "(%d files, dir=0x%08X)",
+                      peer_slot, round, resp->file_count, resp->dir_hash);
+    }
+
+    bc_arena_release(&g_frame, mark);
+    return ok;
+}
+
 void bc_handle_checksum_response(int peer_slot,
                                  const bc_transport_msg_t *msg)
 {
     bc_peer_t *peer = &g_peers.peers[peer_slot];
+    bool use_cache = bc_checksum_cache_enabled(&g_checksum_cache);
+    u8 cache_key[BC_SHA256_SIZE];
+
     /* Handle 0xFF final round response */
     if (peer->state == PEER_CHECKSUMMING_FINAL) {
-        /* Parse the response to verify it's well-formed */
-        bc_checksum_resp_t resp;
-        if (!bc_checksum_response_parse(&resp, msg->payload, msg->payload_len)) {
-            /* Full hex dump for debugging */
-            int dump_len = msg->payload_len < 128 ? msg->payload_len : 128;
-            char hex[128 * 3 + 1];
-            int hpos = 0;
-            for (int i = 0; i < dump_len; i++) {
-                int wrote = snprintf(hex + hpos, sizeof(hex) - (size_t)hpos,
-                                     "%02X ", msg->payload[i]);
-                if (wrote < 0 || hpos + wrote >= (int)sizeof(hex)) break;
-                hpos += wrote;
+        if (use_cache) {
+            bc_checksum_cache_key(0xFF, msg->payload, msg->payload_len, cache_key);
+            if (bc_checksum_cache_lookup(&g_checksum_cache, cache_key)) {
+                LOG_DEBUG("handshake", "slot=%d checksum round 0xFF validated "
+                          "(cached)", peer_slot);
+                send_settings_and_gameinit(peer_slot);
+                return;
             }
-            hex[hpos] = '\0';
-            LOG_WARN("handshake", "slot=%d round 0xFF parse error (len=%d)",
-                     peer_slot, msg->payload_len);
-            LOG_WARN("handshake", "  hex=[%s]", hex);
-            g_stats.boots_checksum++;
-            u8 boot[4];
-            int blen = bc_bootplayer_build(boot, sizeof(boot), BC_BOOT_CHECKSUM);
-            if (blen > 0) bc_queue_reliable(peer_slot, boot, blen);
-            bc_handle_peer_disconnect(peer_slot);
+        }
+        /* Parse the response to verify it's well-formed */
+        if (!check_checksum_response(peer_slot, 0xFF, msg)) {
+            boot_for_checksum(peer_slot);
             return;
         }
-        LOG_DEBUG("handshake", "slot=%d checksum round 0xFF validated "
-                  "(%d files, %d subdirs, dir=0x%08X)",
-                  peer_slot, resp.file_count, resp.subdir_count, resp.dir_hash);
+        if (use_cache) bc_checksum_cache_insert(&g_checksum_cache, cache_key);
         send_settings_and_gameinit(peer_slot);
         return;
     }
@@ -615,44 +694,28 @@ void bc_handle_checksum_response(int peer_slot,
     }
 
     int round = peer->checksum_round;
+    bool permissive = g_no_checksum || !g_manifest_loaded;
+    bool cached = false;
+    if (use_cache && !permissive) {
+        bc_checksum_cache_key((u8)round, msg->payload, msg->payload_len, cache_key);
+        cached = bc_checksum_cache_lookup(&g_checksum_cache, cache_key);
+    }
 
-    if (g_no_checksum || !g_manifest_loaded) {
+    if (permissive) {
         /* Permissive mode: accept without validation */
         LOG_DEBUG("handshake", "slot=%d checksum round %d accepted (permissive, len=%d)",
                   peer_slot, round, msg->payload_len);
+    } else if (cached) {
+        /* Byte-identical to a response that already passed this round */
+        LOG_DEBUG("handshake", "slot=%d checksum round %d validated (cached)",
+                  peer_slot, round);
     } else {
         /* Parse and validate against manifest */
-        bc_checksum_resp_t resp;
-        if (!bc_checksum_response_parse(&resp, msg->payload, msg->payload_len)) {
-            LOG_WARN("handshake", "slot=%d round %d parse error (len=%d)",
-                     peer_slot, round, msg->payload_len);
-            g_stats.boots_checksum++;
-            u8 boot[4];
-            int blen = bc_bootplayer_build(boot, sizeof(boot), BC_BOOT_CHECKSUM);
-            if (blen > 0) bc_queue_reliable(peer_slot, boot, blen);
-            bc_handle_peer_disconnect(peer_slot);
+        if (!check_checksum_response(peer_slot, round, msg)) {
+            boot_for_checksum(peer_slot);
             return;
         }
-
-        bc_checksum_result_t result =
-            bc_checksum_response_validate(&resp, &g_manifest.dirs[round]);
-
-        if (result != CHECKSUM_OK) {
-            LOG_WARN("handshake", "slot=%d round %d FAILED: %s "
-                     "(dir=0x%08X, %d files)",
-                     peer_slot, round, bc_checksum_result_name(result),
-                     resp.dir_hash, resp.file_count);
-            g_stats.boots_checksum++;
-            u8 boot[4];
-            int blen = bc_bootplayer_build(boot, sizeof(boot), BC_BOOT_CHECKSUM);
-            if (blen > 0) bc_queue_reliable(peer_slot, boot, blen);
-            bc_handle_peer_disconnect(peer_slot);
-            return;
-        }
-
-        LOG_DEBUG("handshake", "slot=%d checksum round %d validated "
-                  "(%d files, dir=0x%08X)",
-                  peer_slot, round, resp.file_count, resp.dir_hash);
+        if (use_cache) bc_checksum_cache_insert(&g_checksum_cache, cache_key);
     }
 
     peer->checksum_round++;
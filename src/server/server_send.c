@@ -102,8 +102,9 @@ void bc_flush_peer(int slot)
 void bc_relay_to_others(int sender_slot, const u8 *payload, int payload_len,
                         bool reliable)
 {
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {  /* skip slot 0 = dedi */
-        if (i == sender_slot) continue;
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0 || i == sender_slot) continue;  /* skip slot 0 = dedi */
         if (g_peers.peers[i].state < PEER_LOBBY) continue;
 
         if (reliable) {
@@ -114,9 +115,35 @@ void bc_relay_to_others(int sender_slot, const u8 *payload, int payload_len,
     }
 }
 
+void bc_relay_state_update(int sender_slot, const u8 *payload, int payload_len,
+                           u8 dirty)
+{
+    const bc_peer_t *sender = &g_peers.peers[sender_slot];
+    const bc_ship_state_t *subject = sender->has_ship ? &sender->ship : NULL;
+
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0 || i == sender_slot) continue;  /* skip slot 0 = dedi */
+        const bc_peer_t *obs = &g_peers.peers[i];
+        if (obs->state < PEER_LOBBY) continue;
+
+        f32 w = bc_interest_weight(&g_interest_cfg,
+                                   obs->has_ship ? &obs->ship : NULL, subject);
+        if (!bc_interest_should_relay(&g_interest, &g_interest_cfg,
+                                      i, sender_slot, w, dirty)) {
+            g_stats.state_updates_culled++;
+            continue;
+        }
+        g_stats.state_updates_relayed++;
+        bc_queue_unreliable(i, payload, payload_len);
+    }
+}
+
 void bc_send_to_all(const u8 *payload, int payload_len, bool reliable)
 {
-    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+    for (int k = 0; k < g_peers.active_count; k++) {
+        int i = g_peers.active[k];
+        if (i == 0) continue;  /* dedi */
         if (g_peers.peers[i].state < PEER_LOBBY) continue;
         if (reliable)
             bc_queue_reliable(i, payload, payload_len);
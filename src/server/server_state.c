@@ -22,8 +22,8 @@ bc_peer_mgr_t  g_peers;
 bc_server_info_t g_info;
 
 /* Ship data registry (Phase E: server-authoritative damage) */
-bc_game_registry_t g_registry;
-bool               g_registry_loaded = false;
+bc_game_registry_t *g_registry;            /* heap; live reload swaps it */
+bool                g_registry_loaded = false;
 bc_torpedo_mgr_t   g_torpedoes;
 
 /* System lookup table: index 1-9 maps to SpeciesToSystem key + display name.
@@ -49,7 +49,7 @@ bool        g_collision_dmg = true;
 bool        g_friendly_fire = false;
 const char *g_map_name = "Multiplayer.Episode.Mission1.Mission1";
 int         g_system_index = 1;   /* Star system 1-9 (SpeciesToSystem) */
-int         g_max_players = BC_MAX_PLAYERS;  /* Total slots incl. dedi */
+int         g_max_players = BC_STOCK_PEER_SLOTS;  /* Total slots incl. dedi */
 int         g_time_limit = -1;    /* Minutes, -1 = no limit */
 int         g_frag_limit = -1;    /* Kills, -1 = no limit */
 bool        g_use_score_limit = false;
@@ -67,13 +67,45 @@ i32 g_player_deaths[BC_MAX_PLAYERS];
 u8  g_player_teams[BC_MAX_PLAYERS];
 i32 g_team_scores[2];
 i32 g_team_kills[2];
-bc_damage_ledger_entry_t g_damage_ledger[BC_MAX_PLAYERS][BC_MAX_PLAYERS];
+bc_damage_ledger_t g_damage_ledger[BC_MAX_PLAYERS];
 bc_reconnect_score_t g_reconnect_scores[BC_MAX_PLAYERS];
+bc_health_track_t g_health_track[BC_MAX_PLAYERS];
 
 /* Manifest / checksum validation */
 bc_manifest_t g_manifest;
 bool          g_manifest_loaded = false;
 bool          g_no_checksum = false;  /* auto-set when no manifest */
+bc_checksum_cache_t g_checksum_cache;  /* cleared on every manifest load */
 
 /* Master servers */
 bc_master_list_t g_masters;
+
+/* Interest management */
+bc_interest_cfg_t g_interest_cfg = {
+    true, BC_INTEREST_DEFAULT_NEAR, BC_INTEREST_DEFAULT_FAR,
+    BC_INTEREST_DEFAULT_MIN_RATE
+};
+bc_interest_t     g_interest;
+
+/* Tick timers */
+bc_timer_wheel_t  g_timers;
+
+/* Module job pool (created in main) */
+bc_job_pool_t    *g_jobs;
+
+/* Frame arena (bc_arena_init in main) */
+bc_arena_t        g_frame;
+
+/* Fleet snapshot (module ships_snapshot) */
+bc_ship_snapshot_t g_ship_snapshot;
+
+/* Inbound packet hooks (module packet_hook_add) */
+bc_packet_hooks_t  g_packet_hooks;
+
+/* Combat kernels (module combat_kernels_set) */
+bc_combat_kernels_t g_combat_kernels = {
+    bc_combat_apply_damage,
+    bc_combat_shield_tick,
+    bc_repair_tick,
+};
+bool                g_combat_kernels_locked;
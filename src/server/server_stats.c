@@ -49,6 +49,10 @@ void bc_log_session_summary(void)
              g_stats.disconnects, g_stats.timeouts);
     LOG_INFO("summary", "  Boots: %u (server full), %u (checksum fail)",
              g_stats.boots_full, g_stats.boots_checksum);
+    if (bc_checksum_cache_enabled(&g_checksum_cache))
+        LOG_INFO("summary", "  Checksum cache: %u hits, %u misses, %u evictions",
+                 g_checksum_cache.hits, g_checksum_cache.misses,
+                 g_checksum_cache.evictions);
 
     /* Player history */
     if (g_stats.player_count > 0) {
@@ -137,7 +141,8 @@ void bc_log_session_summary(void)
     }
 
     /* Network stats */
-    if (g_stats.gamespy_queries > 0 || g_stats.reliable_retransmits > 0) {
+    if (g_stats.gamespy_queries > 0 || g_stats.reliable_retransmits > 0 ||
+        g_stats.state_updates_culled > 0) {
         LOG_INFO("summary", "");
         LOG_INFO("summary", "  Network:");
         if (g_stats.gamespy_queries > 0)
@@ -146,6 +151,10 @@ void bc_log_session_summary(void)
         if (g_stats.reliable_retransmits > 0)
             LOG_INFO("summary", "    Reliable retransmits: %u",
                      g_stats.reliable_retransmits);
+        if (g_stats.state_updates_culled > 0)
+            LOG_INFO("summary", "    StateUpdates relayed/culled: %u/%u",
+                     g_stats.state_updates_relayed,
+                     g_stats.state_updates_culled);
     }
 
     /* Master server status */
@@ -0,0 +1,61 @@
+#include "openbc/ship_snapshot.h"
+
+#include <string.h>
+
+int bc_ship_snapshot_build(bc_ship_snapshot_t *snap,
+                           const bc_peer_mgr_t *peers,
+                           const bc_game_registry_t *reg)
+{
+    int n = 0;
+    for (int k = 0; k < peers->active_count; k++) {
+        int i = peers->active[k];
+        if (i == 0) continue;  /* dedi */
+        const bc_peer_t *p = &peers->peers[i];
+        if (!p->has_ship) continue;
+
+        const bc_ship_state_t *s = &p->ship;
+        /* A ship keeps the registry generation it spawned with */
+        const bc_ship_class_t *cls = bc_registry_get_ship(
+            p->registry ? p->registry : reg, p->class_index);
+        bc_ship_view_t *v = &snap->ships[n++];
+        memset(v, 0, sizeof(*v));
+        v->object_id   = s->object_id;
+        v->slot        = (u8)i;
+        v->team_id     = s->team_id;
+        v->alive       = s->alive ? 1 : 0;
+        v->cloak_state = s->cloak_state;
+        /* Published against the current generation, which is what
+         * ship_class_by_index answers from */
+        if (!cls)
+            v->class_index = -1;
+        else if (!p->registry || p->registry == reg)
+            v->class_index = (i16)p->class_index;
+        else
+            v->class_index = (i16)bc_registry_find_ship_index(reg,
+                                                              cls->species_id);
+        v->species     = cls ? (i16)cls->species_id : -1;
+        v->pos         = s->pos;
+        v->fwd         = s->fwd;
+        v->speed       = s->speed;
+        v->hull_hp     = s->hull_hp;
+        for (int f = 0; f < BC_MAX_SHIELD_FACINGS; f++)
+            v->shield_hp += s->shield_hp[f];
+        if (cls) {
+            v->hull_max = cls->hull_hp;
+            for (int f = 0; f < BC_MAX_SHIELD_FACINGS; f++)
+                v->shield_max += cls->shield_hp[f];
+        }
+    }
+    snap->count = n;
+    snap->valid = true;
+    snap->builds++;
+    return n;
+}
+
+const bc_ship_snapshot_t *bc_ship_snapshot_get(bc_ship_snapshot_t *snap,
+                                               const bc_peer_mgr_t *peers,
+                                               const bc_game_registry_t *reg)
+{
+    if (!snap->valid) bc_ship_snapshot_build(snap, peers, reg);
+    return snap;
+}
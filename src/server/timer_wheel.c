@@ -0,0 +1,205 @@
+#include "openbc/timer_wheel.h"
+
+#include <string.h>
+
+/*
+ * List numbering: level L slot S is list L * BC_TIMER_SLOTS + S; the ready
+ * list is READY_LIST. A node not on any list is FREE (in the pool) or
+ * FIRING (detached while its callback runs).
+ */
+#define READY_LIST   (BC_TIMER_LISTS - 1)
+#define LIST_FREE    0xFFFFu
+#define LIST_FIRING  0xFFFEu
+#define SLOT_MASK    (BC_TIMER_SLOTS - 1)
+
+static void list_append(bc_timer_wheel_t *w, int list, int n)
+{
+    bc_timer_node_t *node = &w->nodes[n];
+    node->list = (u16)list;
+    node->next = -1;
+    node->prev = w->tail[list];
+    if (w->tail[list] >= 0) w->nodes[w->tail[list]].next = (i16)n;
+    else                    w->head[list] = (i16)n;
+    w->tail[list] = (i16)n;
+}
+
+static void list_unlink(bc_timer_wheel_t *w, int n)
+{
+    bc_timer_node_t *node = &w->nodes[n];
+    int list = node->list;
+    if (node->prev >= 0) w->nodes[node->prev].next = node->next;
+    else                 w->head[list] = node->next;
+    if (node->next >= 0) w->nodes[node->next].prev = node->prev;
+    else                 w->tail[list] = node->prev;
+    node->next = node->prev = -1;
+}
+
+/* File node n by its distance from w->now. Requires expire >= now. */
+static void wheel_insert(bc_timer_wheel_t *w, int n)
+{
+    u32 expire = w->nodes[n].expire;
+    u32 delta = expire - w->now;
+    if (delta >= BC_TIMER_MAX_DELAY) {
+        /* Park in the top level; re-filed when that slot cascades */
+        delta  = BC_TIMER_MAX_DELAY - 1;
+        expire = w->now + delta;
+    }
+    int level = 0;
+    while (level < BC_TIMER_LEVELS - 1 &&
+           delta >= (1u << (BC_TIMER_LEVEL_BITS * (level + 1))))
+        level++;
+    int slot = (int)((expire >> (BC_TIMER_LEVEL_BITS * level)) & SLOT_MASK);
+    list_append(w, level * BC_TIMER_SLOTS + slot, n);
+}
+
+static int make_id(const bc_timer_wheel_t *w, int n)
+{
+    return (int)(((u32)w->nodes[n].gen << BC_TIMER_INDEX_BITS) | (u32)n);
+}
+
+/* Node index for a live ID, or -1. */
+static int lookup(const bc_timer_wheel_t *w, int id)
+{
+    if (id <= 0) return -1;
+    int n = bc_timer_index(id);
+    if (n >= BC_TIMER_MAX) return -1;
+    const bc_timer_node_t *node = &w->nodes[n];
+    if (node->list == LIST_FREE || make_id(w, n) != id) return -1;
+    return n;
+}
+
+static void node_free(bc_timer_wheel_t *w, int n)
+{
+    bc_timer_node_t *node = &w->nodes[n];
+    node->list = LIST_FREE;
+    node->fn   = NULL;
+    node->user = NULL;
+    node->next = w->free_head;
+    w->free_head = (i16)n;
+    w->stats.active--;
+}
+
+void bc_timer_wheel_init(bc_timer_wheel_t *w, int max_expire)
+{
+    memset(w, 0, sizeof(*w));
+    w->max_expire = max_expire;
+    for (int l = 0; l < BC_TIMER_LISTS; l++)
+        w->head[l] = w->tail[l] = -1;
+    for (int n = 0; n < BC_TIMER_MAX; n++) {
+        w->nodes[n].list = LIST_FREE;
+        w->nodes[n].next = (i16)(n + 1 < BC_TIMER_MAX ? n + 1 : -1);
+        w->nodes[n].prev = -1;
+    }
+    w->free_head = 0;
+}
+
+int bc_timer_add(bc_timer_wheel_t *w, u32 delay, u32 period,
+                 bc_timer_fn fn, void *user)
+{
+    if (!fn) return -1;
+    if (w->free_head < 0) {
+        w->stats.add_failed++;
+        return -1;
+    }
+    int n = w->free_head;
+    bc_timer_node_t *node = &w->nodes[n];
+    w->free_head = node->next;
+
+    if (++node->gen == 0) node->gen = 1;  /* keep IDs non-zero */
+    if (delay == 0) delay = 1;
+    node->expire = w->now + delay - 1;
+    node->period = period;
+    node->fn     = fn;
+    node->user   = user;
+    wheel_insert(w, n);
+
+    w->stats.active++;
+    if (w->stats.active > w->stats.active_peak)
+        w->stats.active_peak = w->stats.active;
+    return make_id(w, n);
+}
+
+bool bc_timer_cancel(bc_timer_wheel_t *w, int id)
+{
+    int n = lookup(w, id);
+    if (n < 0) return false;
+    /* A firing node is already detached; freeing it here also stops a
+     * periodic timer from being re-armed after its callback returns. */
+    if (w->nodes[n].list != LIST_FIRING) list_unlink(w, n);
+    node_free(w, n);
+    return true;
+}
+
+bool bc_timer_active(const bc_timer_wheel_t *w, int id)
+{
+    return lookup(w, id) >= 0;
+}
+
+/* Re-file every node of level `level`, slot `slot` one level down (or
+ * further). Returns the slot index so the caller can chain upward. */
+static int cascade(bc_timer_wheel_t *w, int level, int slot)
+{
+    int list = level * BC_TIMER_SLOTS + slot;
+    int n = w->head[list];
+    w->head[list] = w->tail[list] = -1;
+    while (n >= 0) {
+        int next = w->nodes[n].next;
+        wheel_insert(w, n);
+        w->stats.cascaded++;
+        n = next;
+    }
+    return slot;
+}
+
+int bc_timer_advance(bc_timer_wheel_t *w)
+{
+    u32 t = w->now;
+    int idx = (int)(t & SLOT_MASK);
+
+    /* Level-0 wrap: pull the next block down from each level that wraps */
+    if (idx == 0) {
+        for (int level = 1; level < BC_TIMER_LEVELS; level++) {
+            int s = (int)((t >> (BC_TIMER_LEVEL_BITS * level)) & SLOT_MASK);
+            if (cascade(w, level, s) != 0) break;
+        }
+    }
+
+    /* Everything in the current level-0 slot is due now */
+    int n = w->head[idx];
+    while (n >= 0) {
+        int next = w->nodes[n].next;
+        list_unlink(w, n);
+        list_append(w, READY_LIST, n);
+        n = next;
+    }
+    w->now = t + 1;
+
+    int fired = 0;
+    while (w->head[READY_LIST] >= 0) {
+        if (w->max_expire > 0 && fired >= w->max_expire) break;
+        n = w->head[READY_LIST];
+        bc_timer_node_t *node = &w->nodes[n];
+        list_unlink(w, n);
+        node->list = LIST_FIRING;
+
+        int id = make_id(w, n);
+        node->fn(node->user, id);
+        fired++;
+
+        /* The callback may have cancelled (and even reused) this node */
+        if (node->list != LIST_FIRING || make_id(w, n) != id) continue;
+        if (node->period == 0) {
+            node_free(w, n);
+            continue;
+        }
+        /* Keep the phase; a timer that fell behind fires once, not in a burst */
+        node->expire += node->period;
+        if ((i32)(node->expire - w->now) < 0) node->expire = w->now;
+        wheel_insert(w, n);
+    }
+
+    for (int r = w->head[READY_LIST]; r >= 0; r = w->nodes[r].next)
+        w->stats.deferred++;
+    w->stats.fired += (u32)fired;
+    return fired;
+}
@@ -2,6 +2,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#if !defined(OPENBC_NO_SIMD) && defined(__AVX2__)
+#  include <immintrin.h>
+#  define FH_AVX2 1
+#elif !defined(OPENBC_NO_SIMD) && defined(__SSE2__)
+#  include <emmintrin.h>
+#  define FH_SSE2 1
+#endif
+
 /*
  * FileHash -- rotate-XOR over file contents.
  *
@@ -15,23 +23,89 @@
  *       hash ^= MOVSX(byte)   // sign-extend byte to 32 bits
  *       hash = ROL(hash, 1)
  *   return hash
+ *
+ * ROL distributes over XOR, so after n steps the DWORD taken at step j
+ * contributes ROL(dword, n - j). Rotation is mod 32: DWORDs 32 steps apart
+ * rotate alike. The DWORD loop therefore folds the words into 32 XOR lanes
+ * with no dependency between words (SSE2/AVX2 when the compiler targets
+ * them, portable C otherwise; define OPENBC_NO_SIMD to force the latter),
+ * then rotates each lane once. The tail bytes keep the serial form.
  */
+
+#define FH_LANES 32
+
+static u32 rol32(u32 x, unsigned n)
+{
+    n &= 31;
+    return n ? (x << n) | (x >> (32 - n)) : x;
+}
+
+static u32 load_le32(const u8 *p)
+{
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+/* acc[t] ^= word[t + 32k] for nwords little-endian words at p */
+static void fold_words(u32 acc[FH_LANES], const u8 *p, size_t nwords)
+{
+    size_t blocks = nwords / FH_LANES;
+#if defined(FH_AVX2)
+    __m256i a0 = _mm256_loadu_si256((const __m256i *)(const void *)(acc + 0));
+    __m256i a1 = _mm256_loadu_si256((const __m256i *)(const void *)(acc + 8));
+    __m256i a2 = _mm256_loadu_si256((const __m256i *)(const void *)(acc + 16));
+    __m256i a3 = _mm256_loadu_si256((const __m256i *)(const void *)(acc + 24));
+    for (size_t b = 0; b < blocks; b++, p += FH_LANES * 4) {
+        const __m256i *v = (const __m256i *)(const void *)p;
+        a0 = _mm256_xor_si256(a0, _mm256_loadu_si256(v + 0));
+        a1 = _mm256_xor_si256(a1, _mm256_loadu_si256(v + 1));
+        a2 = _mm256_xor_si256(a2, _mm256_loadu_si256(v + 2));
+        a3 = _mm256_xor_si256(a3, _mm256_loadu_si256(v + 3));
+    }
+    _mm256_storeu_si256((__m256i *)(void *)(acc + 0), a0);
+    _mm256_storeu_si256((__m256i *)(void *)(acc + 8), a1);
+    _mm256_storeu_si256((__m256i *)(void *)(acc + 16), a2);
+    _mm256_storeu_si256((__m256i *)(void *)(acc + 24), a3);
+#elif defined(FH_SSE2)
+    __m128i a[8];
+    for (int k = 0; k < 8; k++)
+        a[k] = _mm_loadu_si128((const __m128i *)(const void *)(acc + k * 4));
+    for (size_t b = 0; b < blocks; b++, p += FH_LANES * 4) {
+        const __m128i *v = (const __m128i *)(const void *)p;
+        a[0] = _mm_xor_si128(a[0], _mm_loadu_si128(v + 0));
+        a[1] = _mm_xor_si128(a[1], _mm_loadu_si128(v + 1));
+        a[2] = _mm_xor_si128(a[2], _mm_loadu_si128(v + 2));
+        a[3] = _mm_xor_si128(a[3], _mm_loadu_si128(v + 3));
+        a[4] = _mm_xor_si128(a[4], _mm_loadu_si128(v + 4));
+        a[5] = _mm_xor_si128(a[5], _mm_loadu_si128(v + 5));
+        a[6] = _mm_xor_si128(a[6], _mm_loadu_si128(v + 6));
+        a[7] = _mm_xor_si128(a[7], _mm_loadu_si128(v + 7));
+    }
+    for (int k = 0; k < 8; k++)
+        _mm_storeu_si128((__m128i *)(void *)(acc + k * 4), a[k]);
+#else
+    for (size_t b = 0; b < blocks; b++, p += FH_LANES * 4)
+        for (int t = 0; t < FH_LANES; t++)
+            acc[t] ^= load_le32(p + t * 4);
+#endif
+    for (size_t t = 0; t < nwords % FH_LANES; t++, p += 4)
+        acc[t] ^= load_le32(p);
+}
+
 u32 file_hash(const u8 *data, size_t len)
 {
     u32 hash = 0;
     size_t dword_count = len / 4;
 
-    for (size_t i = 0; i < dword_count; i++) {
-        if (i == 1) continue;  /* Skip DWORD index 1 (bytes 4-7) */
-
-        /* Read little-endian DWORD */
-        u32 dword = (u32)data[i * 4]
-                  | ((u32)data[i * 4 + 1] << 8)
-                  | ((u32)data[i * 4 + 2] << 16)
-                  | ((u32)data[i * 4 + 3] << 24);
+    if (dword_count >= 1) {
+        /* DWORD 0 is step 0; DWORD 1 (bytes 4-7) is skipped; DWORDs 2.. are
+         * steps 1..m. Lane t holds the words taken at steps 1 + t + 32k. */
+        size_t m = dword_count >= 2 ? dword_count - 2 : 0;
+        u32 acc[FH_LANES] = {0};
+        if (m > 0) fold_words(acc, data + 8, m);
 
-        hash ^= dword;
-        hash = (hash << 1) | (hash >> 31);  /* ROL 1 */
+        hash = rol32(load_le32(data), (unsigned)((m + 1) & 31));
+        for (unsigned t = 0; t < FH_LANES; t++)
+            hash ^= rol32(acc[t], (unsigned)((m - t) & 31));
     }
 
     /* Handle remaining bytes with MOVSX sign-extension */
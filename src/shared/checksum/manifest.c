@@ -5,6 +5,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* The manifest is read with the streaming JSON reader: entries are
+ * collected as they are tokenized, with no tree and only a small read
+ * window in memory, then laid out sorted in one block (build_manifest). */
+
 /* Convert a hex string like "0x7E0CE243" to u32. */
 static u32 hex_to_u32(const char *s)
 {
@@ -12,132 +16,358 @@ static u32 hex_to_u32(const char *s)
     return (u32)strtoul(s, NULL, 16);
 }
 
-/* Parse a JSON file array into manifest file entries.
- * Returns number of files parsed, or -1 on error. */
-static int parse_files(const json_value_t *arr,
-                       bc_manifest_file_t *out, int max_files)
+/* Read the next value as a hex string; 0 if it is not a string. */
+static u32 read_hex(json_reader_t *r)
 {
-    size_t count = json_array_len(arr);
-    if ((int)count > max_files) {
-        LOG_ERROR("manifest", "too many files (%d, max %d)",
-                  (int)count, max_files);
-        return -1;
-    }
+    char buf[32];
+    if (!json_reader_string(r, buf, sizeof(buf))) return 0;
+    return hex_to_u32(buf);
+}
+
+/* While parsing, entries are appended to two growing pools and the
+ * directories refer to them by index range; build_manifest then copies
+ * each range, sorted, into the manifest's single storage block. */
+typedef struct {
+    int off;
+    int count;
+} span_t;
+
+typedef struct {
+    u32    name_hash;
+    span_t files;
+} subdir_src_t;
+
+typedef struct {
+    u32    dir_name_hash;
+    bool   recursive;
+    span_t files;
+    span_t subdirs;
+} dir_src_t;
 
-    for (size_t i = 0; i < count; i++) {
-        const json_value_t *f = json_array_get(arr, i);
-        out[i].name_hash    = hex_to_u32(json_string(json_get(f, "name_hash")));
-        out[i].content_hash = hex_to_u32(json_string(json_get(f, "content_hash")));
+typedef struct {
+    bc_manifest_file_t *files;
+    int                 file_count;
+    int                 file_cap;
+    subdir_src_t       *subdirs;
+    int                 subdir_count;
+    int                 subdir_cap;
+    dir_src_t           dirs[BC_MANIFEST_MAX_DIRS];
+    int                 dir_count;
+} manifest_src_t;
+
+/* Grow *items (elem bytes each) to hold one more; false when out of memory. */
+static bool pool_reserve(void **items, int count, int *cap, size_t elem)
+{
+    if (count < *cap) return true;
+    int ncap = *cap ? *cap * 2 : 64;
+    void *tmp = realloc(*items, (size_t)ncap * elem);
+    if (!tmp) {
+        LOG_ERROR("manifest", "out of memory");
+        return false;
     }
-    return (int)count;
+    *items = tmp;
+    *cap = ncap;
+    return true;
 }
 
-/* Parse a JSON subdirs array. */
-static int parse_subdirs(const json_value_t *arr,
-                         bc_manifest_subdir_t *out, int max_subdirs)
+/* Parse a JSON file array into the file pool.
+ * Returns false on error. */
+static bool parse_files(json_reader_t *r, manifest_src_t *src, span_t *out)
 {
-    size_t count = json_array_len(arr);
-    if ((int)count > max_subdirs) {
-        LOG_ERROR("manifest", "too many subdirs (%d, max %d)",
-                  (int)count, max_subdirs);
-        return -1;
+    out->off = src->file_count;
+    out->count = 0;
+    if (!json_reader_begin_array(r)) return json_reader_ok(r);
+
+    while (json_reader_item(r)) {
+        if (!pool_reserve((void **)&src->files, src->file_count,
+                          &src->file_cap, sizeof(*src->files)))
+            return false;
+        bc_manifest_file_t *f = &src->files[src->file_count++];
+        out->count++;
+        f->name_hash = 0;
+        f->content_hash = 0;
+        if (!json_reader_begin_object(r)) continue;
+        while (json_reader_key(r)) {
+            if (strcmp(r->str, "name_hash") == 0)
+                f->name_hash = read_hex(r);
+            else if (strcmp(r->str, "content_hash") == 0)
+                f->content_hash = read_hex(r);
+            else
+                json_reader_skip(r);
+        }
     }
+    return json_reader_ok(r);
+}
 
-    for (size_t i = 0; i < count; i++) {
-        const json_value_t *sd = json_array_get(arr, i);
-        out[i].name_hash = hex_to_u32(json_string(json_get(sd, "name_hash")));
+/* Parse a JSON subdirs array into the subdir pool. */
+static bool parse_subdirs(json_reader_t *r, manifest_src_t *src, span_t *out)
+{
+    out->off = src->subdir_count;
+    out->count = 0;
+    if (!json_reader_begin_array(r)) return json_reader_ok(r);
 
-        const json_value_t *files = json_get(sd, "files");
-        int fc = parse_files(files, out[i].files, BC_MANIFEST_MAX_SUB_FILES);
-        if (fc < 0) return -1;
-        out[i].file_count = fc;
+    while (json_reader_item(r)) {
+        if (!pool_reserve((void **)&src->subdirs, src->subdir_count,
+                          &src->subdir_cap, sizeof(*src->subdirs)))
+            return false;
+        subdir_src_t *sd = &src->subdirs[src->subdir_count++];
+        out->count++;
+        memset(sd, 0, sizeof(*sd));
+        if (!json_reader_begin_object(r)) continue;
+        while (json_reader_key(r)) {
+            if (strcmp(r->str, "name_hash") == 0) {
+                sd->name_hash = read_hex(r);
+            } else if (strcmp(r->str, "files") == 0) {
+                if (!parse_files(r, src, &sd->files)) return false;
+            } else {
+                json_reader_skip(r);
+            }
+        }
     }
-    return (int)count;
+    return json_reader_ok(r);
 }
 
-bool bc_manifest_load(bc_manifest_t *manifest, const char *path)
+static bool parse_directory(json_reader_t *r, manifest_src_t *src, dir_src_t *md)
 {
-    memset(manifest, 0, sizeof(*manifest));
+    if (!json_reader_begin_object(r)) return json_reader_ok(r);
+    while (json_reader_key(r)) {
+        if (strcmp(r->str, "dir_name_hash") == 0) {
+            md->dir_name_hash = read_hex(r);
+        } else if (strcmp(r->str, "recursive") == 0) {
+            json_reader_bool(r, &md->recursive);
+        } else if (strcmp(r->str, "files") == 0) {
+            if (!parse_files(r, src, &md->files)) return false;
+        } else if (strcmp(r->str, "subdirs") == 0) {
+            if (!parse_subdirs(r, src, &md->subdirs)) return false;
+        } else {
+            json_reader_skip(r);
+        }
+    }
+    return json_reader_ok(r);
+}
 
-    /* Read entire file into memory */
-    FILE *fp = fopen(path, "rb");
-    if (!fp) {
-        LOG_ERROR("manifest", "cannot open '%s'", path);
-        return false;
+static bool parse_manifest(json_reader_t *r, manifest_src_t *src,
+                           bc_manifest_t *manifest)
+{
+    if (!json_reader_begin_object(r)) return false;
+    while (json_reader_key(r)) {
+        if (strcmp(r->str, "version_string_hash") == 0) {
+            manifest->version_hash = read_hex(r);
+        } else if (strcmp(r->str, "directories") == 0) {
+            if (!json_reader_begin_array(r)) continue;
+            while (json_reader_item(r)) {
+                if (src->dir_count >= BC_MANIFEST_MAX_DIRS) {
+                    LOG_ERROR("manifest", "too many directories (more than %d)",
+                              BC_MANIFEST_MAX_DIRS);
+                    return false;
+                }
+                if (!parse_directory(r, src, &src->dirs[src->dir_count++]))
+                    return false;
+            }
+        } else {
+            json_reader_skip(r);
+        }
     }
+    return json_reader_ok(r);
+}
 
-    fseek(fp, 0, SEEK_END);
-    long size = ftell(fp);
-    fseek(fp, 0, SEEK_SET);
+/* Stable merge sort by name_hash, so the first listed of equal hashes
+ * stays first; tmp holds n entries. Then drop the later duplicates,
+ * which a lookup could never return. Returns the new count. */
+static int sort_files(bc_manifest_file_t *a, int n, bc_manifest_file_t *tmp)
+{
+    for (int w = 1; w < n; w *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * w) {
+            int mid = lo + w < n ? lo + w : n;
+            int hi = lo + 2 * w < n ? lo + 2 * w : n;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                tmp[k++] = a[j].name_hash < a[i].name_hash ? a[j++] : a[i++];
+            while (i < mid) tmp[k++] = a[i++];
+            while (j < hi) tmp[k++] = a[j++];
+        }
+        memcpy(a, tmp, (size_t)n * sizeof(*a));
+    }
 
-    if (size <= 0 || size > 1024 * 1024) {
-        LOG_ERROR("manifest", "invalid file size (%ld)", size);
-        fclose(fp);
-        return false;
+    int out = 0;
+    for (int i = 0; i < n; i++) {
+        if (out > 0 && a[out - 1].name_hash == a[i].name_hash) {
+            LOG_WARN("manifest", "duplicate name_hash 0x%08X, keeping the first",
+                     a[i].name_hash);
+            continue;
+        }
+        a[out++] = a[i];
     }
+    return out;
+}
 
-    char *text = malloc((size_t)size + 1);
-    if (!text) {
-        fclose(fp);
-        return false;
+/* Subdirs are few: stable insertion sort, then the same dedup. */
+static int sort_subdirs(bc_manifest_subdir_t *a, int n)
+{
+    for (int i = 1; i < n; i++) {
+        bc_manifest_subdir_t v = a[i];
+        int j = i;
+        while (j > 0 && a[j - 1].name_hash > v.name_hash) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = v;
     }
 
-    size_t nread = fread(text, 1, (size_t)size, fp);
-    fclose(fp);
-    if (nread != (size_t)size) {
-        LOG_ERROR("manifest", "partial read of '%s' (%zu/%ld bytes)", path, nread, size);
-        free(text);
-        return false;
+    int out = 0;
+    for (int i = 0; i < n; i++) {
+        if (out > 0 && a[out - 1].name_hash == a[i].name_hash) {
+            LOG_WARN("manifest", "duplicate subdir name_hash 0x%08X, keeping the first",
+                     a[i].name_hash);
+            continue;
+        }
+        a[out++] = a[i];
     }
-    text[nread] = '\0';
+    return out;
+}
 
-    /* Parse JSON */
-    json_value_t *root = json_parse(text);
-    free(text);
+/* Copy src->files[span] to *next, sorted; advances *next. */
+static int place_files(const manifest_src_t *src, span_t span,
+                       bc_manifest_file_t **next, bc_manifest_file_t *tmp)
+{
+    bc_manifest_file_t *dst = *next;
+    if (span.count > 0)
+        memcpy(dst, &src->files[span.off], (size_t)span.count * sizeof(*dst));
+    int n = sort_files(dst, span.count, tmp);
+    *next += n;
+    return n;
+}
 
-    if (!root) {
-        LOG_ERROR("manifest", "JSON parse error in '%s'", path);
-        return false;
+/* Lay the parsed pools out in one block: all subdir records, then all file
+ * entries, each directory's ranges sorted in place. */
+static bool build_manifest(bc_manifest_t *m, const manifest_src_t *src)
+{
+    size_t total_subdirs = 0, total_files = 0;
+    int max_span = 0;
+    for (int d = 0; d < src->dir_count; d++) {
+        const dir_src_t *ds = &src->dirs[d];
+        total_subdirs += (size_t)ds->subdirs.count;
+        total_files += (size_t)ds->files.count;
+        if (ds->files.count > max_span) max_span = ds->files.count;
+        for (int s = 0; s < ds->subdirs.count; s++) {
+            const subdir_src_t *ss = &src->subdirs[ds->subdirs.off + s];
+            total_files += (size_t)ss->files.count;
+            if (ss->files.count > max_span) max_span = ss->files.count;
+        }
     }
 
-    /* Extract version hash */
-    const char *vh = json_string(json_get(root, "version_string_hash"));
-    manifest->version_hash = hex_to_u32(vh);
-
-    /* Parse directories array */
-    const json_value_t *dirs = json_get(root, "directories");
-    size_t dir_count = json_array_len(dirs);
-    if ((int)dir_count > BC_MANIFEST_MAX_DIRS) {
-        LOG_ERROR("manifest", "too many directories (%d)", (int)dir_count);
-        json_free(root);
+    size_t size = total_subdirs * sizeof(bc_manifest_subdir_t) +
+                  total_files * sizeof(bc_manifest_file_t);
+    u8 *block = size ? (u8 *)malloc(size) : NULL;
+    bc_manifest_file_t *tmp = max_span
+        ? (bc_manifest_file_t *)malloc((size_t)max_span * sizeof(*tmp)) : NULL;
+    if ((size && !block) || (max_span && !tmp)) {
+        LOG_ERROR("manifest", "out of memory");
+        free(block);
+        free(tmp);
         return false;
     }
-    manifest->dir_count = (int)dir_count;
 
-    for (size_t i = 0; i < dir_count; i++) {
-        const json_value_t *d = json_array_get(dirs, i);
-        bc_manifest_dir_t *md = &manifest->dirs[i];
+    bc_manifest_subdir_t *next_sd = (bc_manifest_subdir_t *)block;
+    bc_manifest_file_t *next_f = (bc_manifest_file_t *)(next_sd + total_subdirs);
+
+    m->dir_count = src->dir_count;
+    for (int d = 0; d < src->dir_count; d++) {
+        const dir_src_t *ds = &src->dirs[d];
+        bc_manifest_dir_t *md = &m->dirs[d];
+        md->dir_name_hash = ds->dir_name_hash;
+        md->recursive = ds->recursive;
 
-        md->dir_name_hash = hex_to_u32(json_string(json_get(d, "dir_name_hash")));
-        md->recursive = json_bool(json_get(d, "recursive"));
+        md->files = next_f;
+        md->file_count = place_files(src, ds->files, &next_f, tmp);
 
-        /* Parse files */
-        const json_value_t *files = json_get(d, "files");
-        int fc = parse_files(files, md->files, BC_MANIFEST_MAX_FILES);
-        if (fc < 0) { json_free(root); return false; }
-        md->file_count = fc;
+        md->subdirs = next_sd;
+        for (int s = 0; s < ds->subdirs.count; s++) {
+            const subdir_src_t *ss = &src->subdirs[ds->subdirs.off + s];
+            next_sd[s].name_hash = ss->name_hash;
+            next_sd[s].files = next_f;
+            next_sd[s].file_count = place_files(src, ss->files, &next_f, tmp);
+        }
+        md->subdir_count = sort_subdirs(next_sd, ds->subdirs.count);
+        next_sd += ds->subdirs.count;
 
-        /* Parse subdirs */
-        const json_value_t *subdirs = json_get(d, "subdirs");
-        int sc = parse_subdirs(subdirs, md->subdirs, BC_MANIFEST_MAX_SUBDIRS);
-        if (sc < 0) { json_free(root); return false; }
-        md->subdir_count = sc;
+        if (md->file_count == 0) md->files = NULL;
+        if (md->subdir_count == 0) md->subdirs = NULL;
     }
+    free(tmp);
+    m->storage = block;
+    m->storage_size = size;
+    return true;
+}
 
-    json_free(root);
+/* Directories no checksum response could satisfy (see manifest.h) */
+static bool check_limits(const bc_manifest_t *m, const char *path)
+{
+    for (int d = 0; d < m->dir_count; d++) {
+        const bc_manifest_dir_t *md = &m->dirs[d];
+        if (md->file_count > BC_MANIFEST_MAX_DIR_FILES) {
+            LOG_ERROR("manifest", "'%s': directory 0x%08X lists %d files; a "
+                      "checksum response holds at most %d", path,
+                      md->dir_name_hash, md->file_count,
+                      BC_MANIFEST_MAX_DIR_FILES);
+            return false;
+        }
+        if (md->subdir_count > BC_MANIFEST_MAX_SUBDIRS) {
+            LOG_ERROR("manifest", "'%s': directory 0x%08X lists %d subdirs; a "
+                      "checksum response holds at most %d", path,
+                      md->dir_name_hash, md->subdir_count,
+                      BC_MANIFEST_MAX_SUBDIRS);
+            return false;
+        }
+        for (int s = 0; s < md->subdir_count; s++) {
+            const bc_manifest_subdir_t *sd = &md->subdirs[s];
+            if (sd->file_count > BC_MANIFEST_MAX_SUBDIR_FILES) {
+                LOG_ERROR("manifest", "'%s': subdir 0x%08X lists %d files; a "
+                          "checksum response holds at most %d", path,
+                          sd->name_hash, sd->file_count,
+                          BC_MANIFEST_MAX_SUBDIR_FILES);
+                return false;
+            }
+        }
+    }
     return true;
 }
 
+bool bc_manifest_load(bc_manifest_t *manifest, const char *path)
+{
+    memset(manifest, 0, sizeof(*manifest));
+
+    json_reader_t r;
+    if (!json_reader_open(&r, path)) {
+        LOG_ERROR("manifest", "cannot open '%s'", path);
+        return false;
+    }
+
+    manifest_src_t src;
+    memset(&src, 0, sizeof(src));
+    bool ok = parse_manifest(&r, &src, manifest);
+    if (!json_reader_ok(&r))
+        LOG_ERROR("manifest", "JSON parse error in '%s' (line %d)", path, r.line);
+    json_reader_close(&r);
+
+    if (ok) ok = build_manifest(manifest, &src);
+    free(src.files);
+    free(src.subdirs);
+    if (ok && !check_limits(manifest, path)) {
+        bc_manifest_free(manifest);
+        ok = false;
+    }
+
+    if (!ok) memset(manifest, 0, sizeof(*manifest));
+    return ok;
+}
+
+void bc_manifest_free(bc_manifest_t *manifest)
+{
+    free(manifest->storage);
+    memset(manifest, 0, sizeof(*manifest));
+}
+
 void bc_manifest_print_summary(const bc_manifest_t *manifest)
 {
     int total_files = 0;
@@ -155,35 +385,59 @@ void bc_manifest_print_summary(const bc_manifest_t *manifest)
                  d->recursive ? " (recursive)" : "");
         total_files += dir_total;
     }
-    LOG_INFO("manifest", "  Total: %d files tracked", total_files);
+    LOG_INFO("manifest", "  Total: %d files tracked (%zu bytes)",
+             total_files, manifest->storage_size);
+}
+
+/* Branch-free lower bound: the loop runs log2(count) times whatever the
+ * data, and the step is a conditional move rather than a jump. Files and
+ * subdirs both lead with their u32 name_hash, so one search serves both
+ * arrays, stepping by the element size. Returns the matching index or -1. */
+static inline u32 name_hash_at(const u8 *entries, size_t stride, int i)
+{
+    u32 h;
+    memcpy(&h, entries + (size_t)i * stride, sizeof(h));
+    return h;
+}
+
+static inline int find_name_hash(const void *entries, size_t stride,
+                                 int count, u32 name_hash)
+{
+    if (count <= 0) return -1;
+    int lo = 0;
+    int n = count;
+    while (n > 1) {
+        int half = n / 2;
+        lo += name_hash_at(entries, stride, lo + half - 1) < name_hash ? half : 0;
+        n -= half;
+    }
+    lo += name_hash_at(entries, stride, lo) < name_hash;
+    return lo < count && name_hash_at(entries, stride, lo) == name_hash ? lo : -1;
+}
+
+const bc_manifest_file_t *bc_manifest_find_in(
+    const bc_manifest_file_t *files, int count, u32 name_hash)
+{
+    int i = find_name_hash(files, sizeof(*files), count, name_hash);
+    return i >= 0 ? &files[i] : NULL;
 }
 
 const bc_manifest_file_t *bc_manifest_find_file(
     const bc_manifest_dir_t *dir, u32 name_hash)
 {
-    for (int i = 0; i < dir->file_count; i++) {
-        if (dir->files[i].name_hash == name_hash)
-            return &dir->files[i];
-    }
-    return NULL;
+    return bc_manifest_find_in(dir->files, dir->file_count, name_hash);
 }
 
 const bc_manifest_file_t *bc_manifest_find_subdir_file(
     const bc_manifest_subdir_t *subdir, u32 name_hash)
 {
-    for (int i = 0; i < subdir->file_count; i++) {
-        if (subdir->files[i].name_hash == name_hash)
-            return &subdir->files[i];
-    }
-    return NULL;
+    return bc_manifest_find_in(subdir->files, subdir->file_count, name_hash);
 }
 
 const bc_manifest_subdir_t *bc_manifest_find_subdir(
     const bc_manifest_dir_t *dir, u32 name_hash)
 {
-    for (int i = 0; i < dir->subdir_count; i++) {
-        if (dir->subdirs[i].name_hash == name_hash)
-            return &dir->subdirs[i];
-    }
-    return NULL;
+    int i = find_name_hash(dir->subdirs, sizeof(*dir->subdirs),
+                           dir->subdir_count, name_hash);
+    return i >= 0 ? &dir->subdirs[i] : NULL;
 }
@@ -0,0 +1,108 @@
+#include "openbc/sha256.h"
+#include <string.h>
+
+static const u32 K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static u32 rotr(u32 x, int n) { return (x >> n) | (x << (32 - n)); }
+
+static void compress(u32 state[8], const u8 *p)
+{
+    u32 w[64];
+    for (int i = 0; i < 16; i++)
+        w[i] = ((u32)p[i * 4] << 24) | ((u32)p[i * 4 + 1] << 16) |
+               ((u32)p[i * 4 + 2] << 8) | (u32)p[i * 4 + 3];
+    for (int i = 16; i < 64; i++) {
+        u32 s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        u32 s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    u32 a = state[0], b = state[1], c = state[2], d = state[3];
+    u32 e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        u32 t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) +
+                 ((e & f) ^ (~e & g)) + K[i] + w[i];
+        u32 t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) +
+                 ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void bc_sha256_init(bc_sha256_t *ctx)
+{
+    static const u32 iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->total = 0;
+    ctx->block_len = 0;
+}
+
+void bc_sha256_update(bc_sha256_t *ctx, const void *data, size_t len)
+{
+    const u8 *p = data;
+    ctx->total += len;
+
+    if (ctx->block_len > 0) {
+        size_t take = 64 - ctx->block_len;
+        if (take > len) take = len;
+        memcpy(ctx->block + ctx->block_len, p, take);
+        ctx->block_len += take;
+        p += take;
+        len -= take;
+        if (ctx->block_len < 64) return;
+        compress(ctx->state, ctx->block);
+        ctx->block_len = 0;
+    }
+    for (; len >= 64; p += 64, len -= 64)
+        compress(ctx->state, p);
+    if (len > 0) {
+        memcpy(ctx->block, p, len);
+        ctx->block_len = len;
+    }
+}
+
+void bc_sha256_final(bc_sha256_t *ctx, u8 out[BC_SHA256_SIZE])
+{
+    u64 bits = ctx->total * 8;
+
+    /* 0x80 terminator, zero pad to 56 mod 64, then the 64-bit length */
+    ctx->block[ctx->block_len++] = 0x80;
+    if (ctx->block_len > 56) {
+        memset(ctx->block + ctx->block_len, 0, 64 - ctx->block_len);
+        compress(ctx->state, ctx->block);
+        ctx->block_len = 0;
+    }
+    memset(ctx->block + ctx->block_len, 0, 56 - ctx->block_len);
+    for (int i = 0; i < 8; i++)
+        ctx->block[56 + i] = (u8)(bits >> (56 - i * 8));
+    compress(ctx->state, ctx->block);
+
+    for (int i = 0; i < 8; i++) {
+        out[i * 4]     = (u8)(ctx->state[i] >> 24);
+        out[i * 4 + 1] = (u8)(ctx->state[i] >> 16);
+        out[i * 4 + 2] = (u8)(ctx->state[i] >> 8);
+        out[i * 4 + 3] = (u8)ctx->state[i];
+    }
+}
+
+void bc_sha256(const void *data, size_t len, u8 out[BC_SHA256_SIZE])
+{
+    bc_sha256_t ctx;
+    bc_sha256_init(&ctx);
+    bc_sha256_update(&ctx, data, len);
+    bc_sha256_final(&ctx, out);
+}
@@ -257,10 +257,35 @@ int bc_combat_shield_facing(const bc_ship_state_t *target,
     }
 }
 
+/* Per-subsystem overlap test shared by the linear and BVH paths so both
+ * evaluate the exact same float expressions. */
+static bool subsys_overlaps(const bc_subsystem_def_t *ss,
+                            bc_vec3_t local_impact, f32 damage_radius,
+                            f32 search_radius)
+{
+    /* Subsystem AABB expanded by search_radius: [pos - r*sr, pos + r*sr] */
+    /* Damage AABB: [impact - damage_radius, impact + damage_radius]       */
+    /* Overlap requires all 3 axes to overlap                               */
+    f32 ss_r = ss->radius * search_radius;
+    bool overlap_x = (local_impact.x - damage_radius) <= (ss->position.x + ss_r) &&
+                      (local_impact.x + damage_radius) >= (ss->position.x - ss_r);
+    bool overlap_y = (local_impact.y - damage_radius) <= (ss->position.y + ss_r) &&
+                      (local_impact.y + damage_radius) >= (ss->position.y - ss_r);
+    bool overlap_z = (local_impact.z - damage_radius) <= (ss->position.z + ss_r) &&
+                      (local_impact.z + damage_radius) >= (ss->position.z - ss_r);
+    return overlap_x && overlap_y && overlap_z;
+}
+
 /* Bug 1: AABB overlap test — find ALL subsystems whose bounding box overlaps
  * the damage volume, not just the nearest point-sphere hit.
  * search_radius scales each subsystem's effective bounding radius in the test,
- * expanding the set of eligible subsystems (1.5 = 50% wider search per subsystem). */
+ * expanding the set of eligible subsystems (1.5 = 50% wider search per subsystem).
+ *
+ * Uses the class BVH when one was built. A node's box [lo - max_r*sr,
+ * hi + max_r*sr] contains every child's expanded AABB (float add/mul are
+ * monotonic for sr >= 0), so culling never drops a hit. Hits are collected
+ * in a bitmask and emitted lowest-index first, so the result — including
+ * max_out truncation — matches the linear scan exactly. */
 int bc_combat_find_hit_subsystems(const bc_ship_class_t *cls,
                                   bc_vec3_t local_impact, f32 damage_radius,
                                   f32 search_radius,
@@ -268,23 +293,54 @@ int bc_combat_find_hit_subsystems(const bc_ship_class_t *cls,
 {
     int count = 0;
 
-    for (int i = 0; i < cls->subsystem_count && count < max_out; i++) {
-        const bc_subsystem_def_t *ss = &cls->subsystems[i];
-        if (ss->radius <= 0.0f) continue;
-
-        /* Subsystem AABB expanded by search_radius: [pos - r*sr, pos + r*sr] */
-        /* Damage AABB: [impact - damage_radius, impact + damage_radius]       */
-        /* Overlap requires all 3 axes to overlap                               */
-        f32 ss_r = ss->radius * search_radius;
-        bool overlap_x = (local_impact.x - damage_radius) <= (ss->position.x + ss_r) &&
-                          (local_impact.x + damage_radius) >= (ss->position.x - ss_r);
-        bool overlap_y = (local_impact.y - damage_radius) <= (ss->position.y + ss_r) &&
-                          (local_impact.y + damage_radius) >= (ss->position.y - ss_r);
-        bool overlap_z = (local_impact.z - damage_radius) <= (ss->position.z + ss_r) &&
-                          (local_impact.z + damage_radius) >= (ss->position.z - ss_r);
-
-        if (overlap_x && overlap_y && overlap_z) {
+    if (cls->bvh_node_count <= 0 || !(search_radius >= 0.0f)) {
+        for (int i = 0; i < cls->subsystem_count && count < max_out; i++) {
+            const bc_subsystem_def_t *ss = &cls->subsystems[i];
+            if (ss->radius <= 0.0f) continue;
+            if (subsys_overlaps(ss, local_impact, damage_radius, search_radius))
+                out_indices[count++] = i;
+        }
+        return count;
+    }
+
+    f32 dmin_x = local_impact.x - damage_radius;
+    f32 dmax_x = local_impact.x + damage_radius;
+    f32 dmin_y = local_impact.y - damage_radius;
+    f32 dmax_y = local_impact.y + damage_radius;
+    f32 dmin_z = local_impact.z - damage_radius;
+    f32 dmax_z = local_impact.z + damage_radius;
+
+    u64 hits = 0;
+    int stack[BC_SS_BVH_MAX_NODES];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0) {
+        const bc_ss_bvh_node_t *node = &cls->bvh_nodes[stack[--sp]];
+        f32 r = node->max_radius * search_radius;
+        if (dmin_x > node->hi.x + r || dmax_x < node->lo.x - r ||
+            dmin_y > node->hi.y + r || dmax_y < node->lo.y - r ||
+            dmin_z > node->hi.z + r || dmax_z < node->lo.z - r)
+            continue;
+
+        if (node->count > 0) {
+            for (int k = node->first; k < node->first + node->count; k++) {
+                int i = cls->bvh_order[k];
+                if (subsys_overlaps(&cls->subsystems[i], local_impact,
+                                    damage_radius, search_radius))
+                    hits |= (u64)1 << i;
+            }
+        } else {
+            int self = (int)(node - cls->bvh_nodes);
+            stack[sp++] = node->first;  /* right */
+            stack[sp++] = self + 1;     /* left  */
+        }
+    }
+
+    for (int i = 0; hits != 0 && count < max_out; i++) {
+        if (hits & ((u64)1 << i)) {
             out_indices[count++] = i;
+            hits &= ~((u64)1 << i);
         }
     }
     return count;
@@ -319,7 +375,13 @@ void bc_combat_apply_damage(bc_ship_state_t *target,
             f32 absorbed = per_facing;
             if (absorbed > target->shield_hp[i])
                 absorbed = target->shield_hp[i];
-            target->shield_hp[i] -= absorbed;
+            if (absorbed > 0.0f) {
+                target->shield_hp[i] -= absorbed;
+                bc_ship_journal_shield(&target->journal, i);
+                if (target->shield_hp[i] <= 0.0f)
+                    bc_ship_journal_event(&target->journal,
+                                          BC_SHIP_EV_SHIELD_DOWN, (u8)i);
+            }
             total_absorbed += absorbed;
         }
         overflow = damage - total_absorbed;
@@ -327,12 +389,16 @@ void bc_combat_apply_damage(bc_ship_state_t *target,
         /* Directed: single facing absorbs */
         int facing = bc_combat_shield_facing(target, impact_dir);
         if (target->shield_hp[facing] > 0.0f) {
-            if (damage <= target->shield_hp[facing]) {
+            bc_ship_journal_shield(&target->journal, facing);
+            if (damage < target->shield_hp[facing]) {
                 target->shield_hp[facing] -= damage;
                 return; /* fully absorbed */
             }
             overflow = damage - target->shield_hp[facing];
             target->shield_hp[facing] = 0.0f;
+            bc_ship_journal_event(&target->journal, BC_SHIP_EV_SHIELD_DOWN,
+                                  (u8)facing);
+            if (overflow <= 0.0f) return;  /* exactly absorbed */
         } else {
             overflow = damage;
         }
@@ -372,6 +438,11 @@ void bc_combat_apply_damage(bc_ship_state_t *target,
                 if (target->subsystem_hp[ss_idx] < 0.0f)
                     target->subsystem_hp[ss_idx] = 0.0f;
                 total_sub_absorbed += absorbed;
+                bc_ship_journal_subsys_damaged(&target->journal, ss_idx);
+                if (target->subsystem_hp[ss_idx] <= 0.0f)
+                    bc_ship_journal_event(&target->journal,
+                                          BC_SHIP_EV_SUBSYS_DESTROYED,
+                                          (u8)ss_idx);
             }
         }
     }
@@ -381,9 +452,12 @@ void bc_combat_apply_damage(bc_ship_state_t *target,
     if (hull_damage <= 0.0f) return;
 
     target->hull_hp -= hull_damage;
+    target->journal.changed |= BC_SHIP_CHG_HULL;
     if (target->hull_hp <= 0.0f) {
         target->hull_hp = 0.0f;
         target->alive = false;
+        target->journal.changed |= BC_SHIP_CHG_DESTROYED;
+        bc_ship_journal_event(&target->journal, BC_SHIP_EV_DESTROYED, 0);
     }
 }
 
@@ -414,12 +488,10 @@ f32 bc_combat_collision_damage_path2(f32 collision_energy, f32 ship_mass,
 /* --- Shield recharge --- */
 
 /* Bug 6: power budget with overflow redistribution */
-void bc_combat_shield_tick(bc_ship_state_t *ship,
-                           const bc_ship_class_t *cls,
-                           f32 power_level, f32 dt)
+static void shield_recharge(bc_ship_state_t *ship,
+                            const bc_ship_class_t *cls,
+                            f32 power_level, f32 dt)
 {
-    if (!ship->alive || dt <= 0.0f) return;
-    if (ship->cloak_state != BC_CLOAK_DECLOAKED) return;
 
     /* Special recovery path: if shield subsystem is destroyed/disabled,
      * recharge surviving facings using backup battery directly. */
@@ -555,8 +627,29 @@ void bc_combat_shield_tick(bc_ship_state_t *ship,
     }
 }
 
+void bc_combat_shield_tick(bc_ship_state_t *ship,
+                           const bc_ship_class_t *cls,
+                           f32 power_level, f32 dt)
+{
+    if (!ship->alive || dt <= 0.0f) return;
+    if (ship->cloak_state != BC_CLOAK_DECLOAKED) return;
+
+    f32 before[BC_MAX_SHIELD_FACINGS];
+    memcpy(before, ship->shield_hp, sizeof(before));
+    shield_recharge(ship, cls, power_level, dt);
+    for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++)
+        if (ship->shield_hp[i] != before[i])
+            bc_ship_journal_shield(&ship->journal, i);
+}
+
 /* --- Cloaking device --- */
 
+static void journal_cloak(bc_ship_state_t *ship)
+{
+    ship->journal.changed |= BC_SHIP_CHG_CLOAK;
+    bc_ship_journal_event(&ship->journal, BC_SHIP_EV_CLOAK, ship->cloak_state);
+}
+
 /* Find the cloaking subsystem index, or -1 */
 static int find_cloak_subsys(const bc_ship_class_t *cls)
 {
@@ -576,6 +669,7 @@ bool bc_cloak_start(bc_ship_state_t *ship, const bc_ship_class_t *cls)
 
     ship->cloak_state = BC_CLOAK_CLOAKING;
     ship->cloak_timer = BC_CLOAK_TRANSITION_TIME;
+    journal_cloak(ship);
 
     /* Shield HP preserved — shields are functionally disabled via
      * bc_cloak_shields_active() returning false, which causes
@@ -591,6 +685,7 @@ bool bc_cloak_stop(bc_ship_state_t *ship)
 
     ship->cloak_state = BC_CLOAK_DECLOAKING;
     ship->cloak_timer = BC_CLOAK_TRANSITION_TIME;
+    journal_cloak(ship);
     return true;
 }
 
@@ -612,6 +707,7 @@ void bc_cloak_tick(bc_ship_state_t *ship, f32 cloak_efficiency, f32 dt)
         if (ship->cloak_timer <= 0.0f) {
             ship->cloak_timer = 0.0f;
             ship->cloak_state = BC_CLOAK_CLOAKED;
+            journal_cloak(ship);
         }
         break;
     case BC_CLOAK_CLOAKED:
@@ -619,6 +715,7 @@ void bc_cloak_tick(bc_ship_state_t *ship, f32 cloak_efficiency, f32 dt)
         if (cloak_efficiency < BC_CLOAK_ENERGY_THRESHOLD) {
             ship->cloak_state = BC_CLOAK_DECLOAKING;
             ship->cloak_timer = BC_CLOAK_TRANSITION_TIME;
+            journal_cloak(ship);
         }
         break;
     case BC_CLOAK_DECLOAKING:
@@ -626,10 +723,13 @@ void bc_cloak_tick(bc_ship_state_t *ship, f32 cloak_efficiency, f32 dt)
         if (ship->cloak_timer <= 0.0f) {
             ship->cloak_timer = 0.0f;
             ship->cloak_state = BC_CLOAK_DECLOAKED;
+            journal_cloak(ship);
             /* Any shield facing at 0 HP gets reset to 1.0 */
             for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++) {
-                if (ship->shield_hp[i] <= 0.0f)
+                if (ship->shield_hp[i] <= 0.0f) {
                     ship->shield_hp[i] = 1.0f;
+                    bc_ship_journal_shield(&ship->journal, i);
+                }
             }
         }
         break;
@@ -849,8 +949,11 @@ void bc_repair_tick(bc_ship_state_t *ship,
 
         f32 max_hp = cls->subsystems[ss_idx].max_condition;
         ship->subsystem_hp[ss_idx] += gain;
+        bc_ship_journal_subsys_repaired(&ship->journal, ss_idx);
         if (ship->subsystem_hp[ss_idx] >= max_hp) {
             ship->subsystem_hp[ss_idx] = max_hp;
+            bc_ship_journal_event(&ship->journal, BC_SHIP_EV_SUBSYS_REPAIRED,
+                                  ss_idx);
             /* Mark for removal (defer to avoid modifying while iterating) */
             ship->repair_queue[q] = 0xFF; /* sentinel */
             repaired++;
@@ -882,3 +985,59 @@ void bc_repair_auto_queue(bc_ship_state_t *ship,
         }
     }
 }
+
+/* --- Kernel table --- */
+
+void bc_combat_health_save(bc_combat_health_t *h, const bc_ship_state_t *ship)
+{
+    h->hull_hp = ship->hull_hp;
+    memcpy(h->shield_hp, ship->shield_hp, sizeof(h->shield_hp));
+    memcpy(h->subsystem_hp, ship->subsystem_hp, sizeof(h->subsystem_hp));
+    h->alive = ship->alive;
+    h->event_count = ship->journal.event_count;
+    h->events_dropped = ship->journal.events_dropped;
+}
+
+void bc_combat_journal_diff(bc_ship_state_t *ship, const bc_ship_class_t *cls,
+                            const bc_combat_health_t *before)
+{
+    bc_ship_journal_t *j = &ship->journal;
+    bool events = j->event_count == before->event_count &&
+                  j->events_dropped == before->events_dropped;
+
+    for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++) {
+        if (ship->shield_hp[i] == before->shield_hp[i]) continue;
+        bc_ship_journal_shield(j, i);
+        if (events && ship->shield_hp[i] <= 0.0f && before->shield_hp[i] > 0.0f)
+            bc_ship_journal_event(j, BC_SHIP_EV_SHIELD_DOWN, (u8)i);
+    }
+
+    int count = cls->subsystem_count < BC_MAX_SUBSYSTEMS
+              ? cls->subsystem_count : BC_MAX_SUBSYSTEMS;
+    for (int i = 0; i < count; i++) {
+        f32 hp = ship->subsystem_hp[i];
+        f32 was = before->subsystem_hp[i];
+        if (hp < was) {
+            bc_ship_journal_subsys_damaged(j, i);
+            if (events && hp <= 0.0f)
+                bc_ship_journal_event(j, BC_SHIP_EV_SUBSYS_DESTROYED, (u8)i);
+        } else if (hp > was) {
+            bc_ship_journal_subsys_repaired(j, i);
+            if (events && hp >= cls->subsystems[i].max_condition)
+                bc_ship_journal_event(j, BC_SHIP_EV_SUBSYS_REPAIRED, (u8)i);
+        }
+    }
+
+    if (ship->hull_hp != before->hull_hp)
+        j->changed |= BC_SHIP_CHG_HULL;
+    if (before->alive && !ship->alive) {
+        j->changed |= BC_SHIP_CHG_DESTROYED;
+        if (events) bc_ship_journal_event(j, BC_SHIP_EV_DESTROYED, 0);
+    }
+}
+
+const bc_combat_kernels_t bc_combat_default_kernels = {
+    bc_combat_apply_damage,
+    bc_combat_shield_tick,
+    bc_repair_tick,
+};
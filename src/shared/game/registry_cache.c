@@ -0,0 +1,438 @@
+#include "openbc/registry_cache.h"
+#include "openbc/json_parse.h"
+#include "openbc/log.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#endif
+
+#define FNV64_INIT   14695981039346656037ULL
+#define FNV64_PRIME  1099511628211ULL
+
+static u64 fnv64(u64 h, const void *data, size_t len)
+{
+    const u8 *p = (const u8 *)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= FNV64_PRIME;
+    }
+    return h;
+}
+
+/* Read a whole file into a NUL-terminated heap buffer. */
+static char *read_file(const char *path, size_t *len_out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0) { fclose(f); return NULL; }
+
+    char *text = (char *)malloc((size_t)size + 1);
+    if (!text) { fclose(f); return NULL; }
+
+    size_t nread = fread(text, 1, (size_t)size, f);
+    fclose(f);
+    text[nread] = '\0';
+    *len_out = nread;
+    return text;
+}
+
+/* --- Source metadata --- */
+
+/* A source whose mtime is within this of the cache's own write time may
+ * have changed again without its timestamps moving (coarse filesystem
+ * clocks), so it never counts as unchanged. */
+#define REGCACHE_RACY_NS  1000000000LL
+
+/* Size, nanosecond timestamps and inode of path; false if it is absent. */
+static bool stat_source(const char *path, bc_regcache_source_t *out)
+{
+    struct stat st;
+    if (stat(path, &st) != 0) return false;
+    out->size = (u64)st.st_size;
+#if defined(_WIN32)
+    /* FILETIME: 100 ns ticks since 1601 */
+    WIN32_FILE_ATTRIBUTE_DATA fa;
+    if (GetFileAttributesExA(path, GetFileExInfoStandard, &fa)) {
+        const i64 epoch = 116444736000000000LL;
+        i64 w = ((i64)fa.ftLastWriteTime.dwHighDateTime << 32) |
+                fa.ftLastWriteTime.dwLowDateTime;
+        i64 c = ((i64)fa.ftCreationTime.dwHighDateTime << 32) |
+                fa.ftCreationTime.dwLowDateTime;
+        out->mtime = (w - epoch) * 100;
+        out->ctime = (c - epoch) * 100;
+    } else {
+        out->mtime = (i64)st.st_mtime * 1000000000LL;
+        out->ctime = (i64)st.st_ctime * 1000000000LL;
+    }
+    out->ino = 0;
+#elif defined(__APPLE__)
+    out->mtime = (i64)st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+    out->ctime = (i64)st.st_ctimespec.tv_sec * 1000000000LL + st.st_ctimespec.tv_nsec;
+    out->ino = (u64)st.st_ino;
+#else
+    out->mtime = (i64)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    out->ctime = (i64)st.st_ctim.tv_sec * 1000000000LL + st.st_ctim.tv_nsec;
+    out->ino = (u64)st.st_ino;
+#endif
+    return true;
+}
+
+/* What one pass over the sources produces: the content key, and (if
+ * table is set) each file's metadata taken before its content was read */
+typedef struct {
+    u64                   hash;
+    bc_regcache_source_t *table;   /* BC_REGCACHE_MAX_SOURCES entries */
+    int                   count;
+    bool                  complete; /* every source fit in the table */
+} source_scan_t;
+
+/* Fold one source file into the scan: its path relative to the registry
+ * dir, then its length and bytes, or an absent marker. */
+static void scan_source(source_scan_t *sc, const char *dir, const char *rel)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, rel);
+
+    if (sc->table) {
+        size_t rlen = strlen(rel);
+        if (sc->count >= BC_REGCACHE_MAX_SOURCES ||
+            rlen >= sizeof(sc->table[0].rel)) {
+            sc->complete = false;
+        } else {
+            bc_regcache_source_t *e = &sc->table[sc->count++];
+            memset(e, 0, sizeof(*e));
+            memcpy(e->rel, rel, rlen + 1);
+            if (!stat_source(path, e)) e->size = BC_REGCACHE_ABSENT;
+        }
+    }
+
+    u64 h = fnv64(sc->hash, rel, strlen(rel) + 1);
+
+    size_t len = 0;
+    char *text = read_file(path, &len);
+    if (!text) {
+        const u8 absent = 0xFF;
+        sc->hash = fnv64(h, &absent, 1);
+        return;
+    }
+    u64 n = (u64)len;
+    h = fnv64(h, &n, sizeof(n));
+    sc->hash = fnv64(h, text, len);
+    free(text);
+}
+
+/* Every file bc_registry_load_dir(dir) reads, manifest.json first. Returns
+ * false if manifest.json cannot be read. */
+static bool scan_sources(const char *dir, source_scan_t *sc)
+{
+    sc->hash = FNV64_INIT;
+    sc->count = 0;
+    sc->complete = true;
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/manifest.json", dir);
+    scan_source(sc, dir, "manifest.json");
+    size_t len = 0;
+    char *text = read_file(path, &len);
+    if (!text) return false;
+
+    json_value_t *manifest = json_parse_insitu(text);
+    if (!manifest) {
+        /* The loader will fail on it too; still a stable key */
+        free(text);
+        return true;
+    }
+
+    /* Same files, same caps as bc_registry_load_dir */
+    static const char *const ship_files[] = {
+        "ship.json", "subsystems.json", "serialization.json", "power.json",
+    };
+    json_value_t *ships = json_get(manifest, "ships");
+    size_t n = json_array_len(ships);
+    if (n > BC_MAX_SHIPS) n = BC_MAX_SHIPS;
+    for (size_t i = 0; i < n; i++) {
+        const char *folder = json_string(json_array_get(ships, i));
+        if (!folder) continue;
+        for (size_t k = 0; k < sizeof(ship_files) / sizeof(ship_files[0]); k++) {
+            char rel[384];
+            snprintf(rel, sizeof(rel), "ships/%s/%s", folder, ship_files[k]);
+            scan_source(sc, dir, rel);
+        }
+    }
+
+    json_value_t *projs = json_get(manifest, "projectiles");
+    n = json_array_len(projs);
+    if (n > BC_MAX_PROJECTILES) n = BC_MAX_PROJECTILES;
+    for (size_t i = 0; i < n; i++) {
+        const char *base = json_string(json_array_get(projs, i));
+        if (!base) continue;
+        char rel[384];
+        snprintf(rel, sizeof(rel), "projectiles/%s.json", base);
+        scan_source(sc, dir, rel);
+    }
+
+    json_free(manifest);
+    free(text);
+    return true;
+}
+
+bool bc_registry_source_hash(const char *dir, u64 *out)
+{
+    source_scan_t sc;
+    memset(&sc, 0, sizeof(sc));
+    if (!scan_sources(dir, &sc)) return false;
+    *out = sc.hash;
+    return true;
+}
+
+/* Changes whenever the payload structs, limits or byte order differ from
+ * the build that wrote the cache. */
+static u32 layout_fingerprint(void)
+{
+    const u32 one = 1;
+    const u64 parts[] = {
+        sizeof(bc_game_registry_t), sizeof(bc_ship_class_t),
+        sizeof(bc_subsystem_def_t), sizeof(bc_ss_list_t),
+        sizeof(bc_ss_bvh_node_t),   sizeof(bc_projectile_def_t),
+        sizeof(bool),
+        offsetof(bc_game_registry_t, projectiles),
+        offsetof(bc_game_registry_t, loaded),
+        offsetof(bc_ship_class_t, subsystems),
+        offsetof(bc_ship_class_t, ser_list),
+        offsetof(bc_ship_class_t, bvh_nodes),
+        BC_MAX_SHIPS, BC_MAX_SUBSYSTEMS, BC_SS_MAX_ENTRIES,
+        *(const u8 *)&one,
+    };
+    u64 h = fnv64(FNV64_INIT, parts, sizeof(parts));
+    return (u32)(h ^ (h >> 32));
+}
+
+static bool str_terminated(const char *s, size_t size)
+{
+    return memchr(s, '\0', size) != NULL;
+}
+
+/* Counts and strings the rest of the server indexes or prints without
+ * further checks. */
+static bool registry_plausible(const bc_game_registry_t *reg)
+{
+    if (!reg->loaded) return false;
+    if (reg->ship_count < 1 || reg->ship_count > BC_MAX_SHIPS) return false;
+    if (reg->projectile_count < 0 || reg->projectile_count > BC_MAX_PROJECTILES)
+        return false;
+
+    for (int i = 0; i < reg->ship_count; i++) {
+        const bc_ship_class_t *s = &reg->ships[i];
+        if (s->subsystem_count < 0 || s->subsystem_count > BC_MAX_SUBSYSTEMS)
+            return false;
+        if (s->ser_list.count < 0 || s->ser_list.count > BC_SS_MAX_ENTRIES)
+            return false;
+        if (s->bvh_node_count < 0 || s->bvh_node_count > BC_SS_BVH_MAX_NODES)
+            return false;
+        if (!str_terminated(s->name, sizeof(s->name)) ||
+            !str_terminated(s->faction, sizeof(s->faction)))
+            return false;
+        for (int j = 0; j < s->subsystem_count; j++) {
+            if (!str_terminated(s->subsystems[j].name, sizeof(s->subsystems[j].name)) ||
+                !str_terminated(s->subsystems[j].type, sizeof(s->subsystems[j].type)))
+                return false;
+        }
+    }
+    for (int i = 0; i < reg->projectile_count; i++) {
+        const bc_projectile_def_t *p = &reg->projectiles[i];
+        if (!str_terminated(p->name, sizeof(p->name)) ||
+            !str_terminated(p->script, sizeof(p->script)))
+            return false;
+    }
+    return true;
+}
+
+static bool cache_write(const char *path, const bc_game_registry_t *reg,
+                        u64 source_hash, const bc_regcache_source_t *sources,
+                        int source_count)
+{
+    bc_regcache_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic        = BC_REGCACHE_MAGIC;
+    hdr.version      = BC_REGCACHE_VERSION;
+    hdr.layout       = layout_fingerprint();
+    hdr.payload_size = (u32)sizeof(*reg);
+    hdr.source_count = (u32)source_count;
+    hdr.source_hash  = source_hash;
+    hdr.checksum     = fnv64(FNV64_INIT, reg, sizeof(*reg));
+
+    char tmp[520];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return false;
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              (source_count == 0 ||
+               fwrite(sources, sizeof(*sources), (size_t)source_count, f) ==
+                   (size_t)source_count) &&
+              fwrite(reg, sizeof(*reg), 1, f) == 1;
+    if (fclose(f) != 0) ok = false;
+    if (!ok) {
+        remove(tmp);
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(path);   /* rename() does not replace on Windows */
+#endif
+    if (rename(tmp, path) != 0) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+bool bc_registry_cache_write(const char *path, const bc_game_registry_t *reg,
+                             u64 source_hash)
+{
+    return cache_write(path, reg, source_hash, NULL, 0);
+}
+
+static bool header_ok(const bc_regcache_header_t *hdr)
+{
+    return hdr->magic == BC_REGCACHE_MAGIC &&
+           hdr->version == BC_REGCACHE_VERSION &&
+           hdr->layout == layout_fingerprint() &&
+           hdr->payload_size == (u32)sizeof(bc_game_registry_t) &&
+           hdr->source_count <= BC_REGCACHE_MAX_SOURCES;
+}
+
+/* source_hash NULL: the caller has already matched the sources by
+ * metadata (bc_registry_cache_fresh) */
+static bc_regcache_result_t cache_read(const char *path, const u64 *source_hash,
+                                       bc_game_registry_t *reg)
+{
+    memset(reg, 0, sizeof(*reg));
+
+    FILE *f = fopen(path, "rb");
+    if (!f) return BC_REGCACHE_MISSING;
+
+    bc_regcache_header_t hdr;
+    bc_regcache_result_t r = BC_REGCACHE_HIT;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 || !header_ok(&hdr)) {
+        r = BC_REGCACHE_BAD_HEADER;
+    } else if (source_hash && hdr.source_hash != *source_hash) {
+        r = BC_REGCACHE_STALE;
+    } else if (fseek(f, (long)(hdr.source_count * sizeof(bc_regcache_source_t)),
+                     SEEK_CUR) != 0 ||
+               fread(reg, sizeof(*reg), 1, f) != 1 ||
+               fnv64(FNV64_INIT, reg, sizeof(*reg)) != hdr.checksum ||
+               !registry_plausible(reg)) {
+        r = BC_REGCACHE_CORRUPT;
+    }
+    fclose(f);
+
+    if (r != BC_REGCACHE_HIT) memset(reg, 0, sizeof(*reg));
+    return r;
+}
+
+bc_regcache_result_t bc_registry_cache_read(const char *path, u64 source_hash,
+                                            bc_game_registry_t *reg)
+{
+    return cache_read(path, &source_hash, reg);
+}
+
+bool bc_registry_cache_fresh(const char *path, const char *dir)
+{
+    bc_regcache_source_t self;
+    if (!stat_source(path, &self)) return false;
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+
+    bc_regcache_header_t hdr;
+    bc_regcache_source_t *table = NULL;
+    bool fresh = fread(&hdr, sizeof(hdr), 1, f) == 1 && header_ok(&hdr) &&
+                 hdr.source_count > 0;
+    if (fresh) {
+        table = (bc_regcache_source_t *)malloc(hdr.source_count * sizeof(*table));
+        fresh = table && fread(table, sizeof(*table), hdr.source_count, f) ==
+                         hdr.source_count;
+    }
+    fclose(f);
+
+    for (u32 i = 0; fresh && i < hdr.source_count; i++) {
+        const bc_regcache_source_t *e = &table[i];
+        if (!str_terminated(e->rel, sizeof(e->rel))) {
+            fresh = false;
+            break;
+        }
+        char spath[512];
+        snprintf(spath, sizeof(spath), "%s/%s", dir, e->rel);
+        bc_regcache_source_t now;
+        memset(&now, 0, sizeof(now));
+        if (!stat_source(spath, &now)) now.size = BC_REGCACHE_ABSENT;
+        if (now.size != e->size) fresh = false;
+        else if (now.size != BC_REGCACHE_ABSENT)
+            fresh = now.mtime == e->mtime && now.ctime == e->ctime &&
+                    now.ino == e->ino && now.mtime < self.mtime - REGCACHE_RACY_NS;
+    }
+    free(table);
+    return fresh;
+}
+
+bool bc_registry_load_dir_cached(bc_game_registry_t *reg, const char *dir,
+                                 const char *cache_path,
+                                 bc_regcache_result_t *result)
+{
+    if (result) *result = BC_REGCACHE_MISSING;
+    if (!cache_path) return bc_registry_load_dir(reg, dir);
+
+    /* Sources untouched since the cache was written: no JSON is read */
+    if (bc_registry_cache_fresh(cache_path, dir) &&
+        cache_read(cache_path, NULL, reg) == BC_REGCACHE_HIT) {
+        if (result) *result = BC_REGCACHE_HIT;
+        return true;
+    }
+
+    source_scan_t sc;
+    memset(&sc, 0, sizeof(sc));
+    sc.table = (bc_regcache_source_t *)malloc(BC_REGCACHE_MAX_SOURCES *
+                                              sizeof(*sc.table));
+    bool have_hash = scan_sources(dir, &sc);
+    int count = sc.table && sc.complete ? sc.count : 0;
+
+    bc_regcache_result_t r = BC_REGCACHE_MISSING;
+    bool ok = true;
+    if (have_hash) {
+        r = cache_read(cache_path, &sc.hash, reg);
+        if (result) *result = r;
+    }
+    if (r == BC_REGCACHE_HIT) {
+        /* Same content, new metadata (a checkout, a copy): record it so
+         * the next start takes the metadata path */
+        cache_write(cache_path, reg, sc.hash, sc.table, count);
+    } else if (!bc_registry_load_dir(reg, dir)) {
+        ok = false;
+    } else if (have_hash &&
+               !cache_write(cache_path, reg, sc.hash, sc.table, count)) {
+        LOG_WARN("registry", "Could not write registry cache %s", cache_path);
+    }
+    free(sc.table);
+    return ok;
+}
+
+const char *bc_regcache_result_str(bc_regcache_result_t r)
+{
+    switch (r) {
+    case BC_REGCACHE_HIT:        return "hit";
+    case BC_REGCACHE_MISSING:    return "missing";
+    case BC_REGCACHE_BAD_HEADER: return "incompatible";
+    case BC_REGCACHE_STALE:      return "stale";
+    case BC_REGCACHE_CORRUPT:    return "corrupt";
+    }
+    return "unknown";
+}
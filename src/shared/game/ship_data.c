@@ -5,85 +5,164 @@
 #include <stdlib.h>
 #include <string.h>
 
-/* Helper: copy string from JSON value into fixed buffer */
-static void copy_str(char *dst, size_t dst_size, const json_value_t *val)
+/* Registry files are read with the streaming JSON reader: each value is
+ * copied into the target struct as it is tokenized, so loading a ship never
+ * builds a tree. Keys are matched by name in any order; a value of the
+ * wrong type is treated like a missing key. */
+
+/* Helpers: read the next value as a number or bool, 0/false on mismatch */
+static f32 read_f32(json_reader_t *r)
 {
-    const char *s = json_string(val);
-    if (s) {
-        strncpy(dst, s, dst_size - 1);
-        dst[dst_size - 1] = '\0';
-    }
+    double d = 0.0;
+    json_reader_number(r, &d);
+    return (f32)d;
+}
+
+static int read_int(json_reader_t *r)
+{
+    double d = 0.0;
+    json_reader_number(r, &d);
+    return (int)d;
+}
+
+static bool read_bool(json_reader_t *r)
+{
+    bool b = false;
+    json_reader_bool(r, &b);
+    return b;
 }
 
 /* Helper: read a JSON array of floats into a C array */
-static void read_float_array(const json_value_t *arr, f32 *out, int max_count)
+static void read_float_array(json_reader_t *r, f32 *out, int max_count)
 {
-    if (!arr || arr->type != JSON_ARRAY) return;
-    size_t n = json_array_len(arr);
-    if ((int)n > max_count) n = (size_t)max_count;
-    for (size_t i = 0; i < n; i++) {
-        out[i] = (f32)json_number(json_array_get(arr, i));
+    if (!json_reader_begin_array(r)) return;
+    int i = 0;
+    while (json_reader_item(r)) {
+        if (i < max_count) out[i++] = read_f32(r);
+        else json_reader_skip(r);
     }
 }
 
 /* Helper: read bc_vec3_t from JSON array [x, y, z] */
-static bc_vec3_t read_vec3(const json_value_t *arr)
+static bc_vec3_t read_vec3(json_reader_t *r)
 {
     bc_vec3_t v = {0, 0, 0};
-    if (!arr || arr->type != JSON_ARRAY || json_array_len(arr) < 3) return v;
-    v.x = (f32)json_number(json_array_get(arr, 0));
-    v.y = (f32)json_number(json_array_get(arr, 1));
-    v.z = (f32)json_number(json_array_get(arr, 2));
+    f32 xyz[3] = {0, 0, 0};
+    int n = 0;
+    if (!json_reader_begin_array(r)) return v;
+    while (json_reader_item(r)) {
+        if (n < 3) xyz[n] = read_f32(r);
+        else json_reader_skip(r);
+        n++;
+    }
+    if (n < 3) return v;
+    v.x = xyz[0];
+    v.y = xyz[1];
+    v.z = xyz[2];
     return v;
 }
 
-static bool load_subsystem(bc_subsystem_def_t *ss, const json_value_t *obj)
+/* Read the next value as a name to match against subsystem names. Names
+ * that cannot fit never match, as no stored name can be that long. */
+static bool read_name(json_reader_t *r, char *dst, size_t dst_size)
 {
-    memset(ss, 0, sizeof(*ss));
-    copy_str(ss->name, sizeof(ss->name), json_get(obj, "name"));
-    copy_str(ss->type, sizeof(ss->type), json_get(obj, "type"));
-    ss->position = read_vec3(json_get(obj, "position"));
-    ss->radius = (f32)json_number(json_get(obj, "radius"));
-    ss->max_condition = (f32)json_number(json_get(obj, "max_condition"));
-    ss->disabled_pct = (f32)json_number(json_get(obj, "disabled_pct"));
-    ss->is_critical = json_bool(json_get(obj, "is_critical"));
-    ss->is_targetable = json_bool(json_get(obj, "is_targetable"));
-    ss->repair_complexity = (f32)json_number(json_get(obj, "repair_complexity"));
-
-    /* Weapon fields (phaser, pulse, tractor) */
-    ss->max_damage = (f32)json_number(json_get(obj, "max_damage"));
-    ss->max_charge = (f32)json_number(json_get(obj, "max_charge"));
-    ss->min_firing_charge = (f32)json_number(json_get(obj, "min_firing_charge"));
-    ss->recharge_rate = (f32)json_number(json_get(obj, "recharge_rate"));
-    ss->discharge_rate = (f32)json_number(json_get(obj, "discharge_rate"));
-    ss->max_damage_distance = (f32)json_number(json_get(obj, "max_damage_distance"));
-    ss->weapon_id = (u8)json_int(json_get(obj, "weapon_id"));
-
-    /* Orientation */
-    ss->forward = read_vec3(json_get(obj, "forward"));
-    ss->up = read_vec3(json_get(obj, "up"));
-    read_float_array(json_get(obj, "arc_width"), ss->arc_width, 2);
-    read_float_array(json_get(obj, "arc_height"), ss->arc_height, 2);
-
-    /* Torpedo tube */
-    ss->reload_delay = (f32)json_number(json_get(obj, "reload_delay"));
-    ss->max_ready = json_int(json_get(obj, "max_ready"));
-    ss->immediate_delay = (f32)json_number(json_get(obj, "immediate_delay"));
-    ss->direction = read_vec3(json_get(obj, "direction"));
-
-    /* Tractor */
-    ss->normal_power = (f32)json_number(json_get(obj, "normal_power"));
-
-    /* Cloak */
-    ss->cloak_strength = (f32)json_number(json_get(obj, "cloak_strength"));
-
-    /* Repair */
-    ss->max_repair_points = (f32)json_number(json_get(obj, "max_repair_points"));
-    ss->num_repair_teams = json_int(json_get(obj, "num_repair_teams"));
+    return json_reader_string(r, dst, dst_size) && r->str_len < dst_size;
+}
 
+static void load_subsystem(bc_subsystem_def_t *ss, json_reader_t *r)
+{
+    memset(ss, 0, sizeof(*ss));
     ss->parent_idx = -1; /* set during serialization list loading */
+    if (!json_reader_begin_object(r)) return;
+
+    while (json_reader_key(r)) {
+        const char *k = r->str;
+        if (strcmp(k, "name") == 0)
+            json_reader_string(r, ss->name, sizeof(ss->name));
+        else if (strcmp(k, "type") == 0)
+            json_reader_string(r, ss->type, sizeof(ss->type));
+        else if (strcmp(k, "position") == 0)
+            ss->position = read_vec3(r);
+        else if (strcmp(k, "radius") == 0)
+            ss->radius = read_f32(r);
+        else if (strcmp(k, "max_condition") == 0)
+            ss->max_condition = read_f32(r);
+        else if (strcmp(k, "disabled_pct") == 0)
+            ss->disabled_pct = read_f32(r);
+        else if (strcmp(k, "is_critical") == 0)
+            ss->is_critical = read_bool(r);
+        else if (strcmp(k, "is_targetable") == 0)
+            ss->is_targetable = read_bool(r);
+        else if (strcmp(k, "repair_complexity") == 0)
+            ss->repair_complexity = read_f32(r);
+
+        /* Weapon fields (phaser, pulse, tractor) */
+        else if (strcmp(k, "max_damage") == 0)
+            ss->max_damage = read_f32(r);
+        else if (strcmp(k, "max_charge") == 0)
+            ss->max_charge = read_f32(r);
+        else if (strcmp(k, "min_firing_charge") == 0)
+            ss->min_firing_charge = read_f32(r);
+        else if (strcmp(k, "recharge_rate") == 0)
+            ss->recharge_rate = read_f32(r);
+        else if (strcmp(k, "discharge_rate") == 0)
+            ss->discharge_rate = read_f32(r);
+        else if (strcmp(k, "max_damage_distance") == 0)
+            ss->max_damage_distance = read_f32(r);
+        else if (strcmp(k, "weapon_id") == 0)
+            ss->weapon_id = (u8)read_int(r);
+
+        /* Orientation */
+        else if (strcmp(k, "forward") == 0)
+            ss->forward = read_vec3(r);
+        else if (strcmp(k, "up") == 0)
+            ss->up = read_vec3(r);
+        else if (strcmp(k, "arc_width") == 0)
+            read_float_array(r, ss->arc_width, 2);
+        else if (strcmp(k, "arc_height") == 0)
+            read_float_array(r, ss->arc_height, 2);
+
+        /* Torpedo tube */
+        else if (strcmp(k, "reload_delay") == 0)
+            ss->reload_delay = read_f32(r);
+        else if (strcmp(k, "max_ready") == 0)
+            ss->max_ready = read_int(r);
+        else if (strcmp(k, "immediate_delay") == 0)
+            ss->immediate_delay = read_f32(r);
+        else if (strcmp(k, "direction") == 0)
+            ss->direction = read_vec3(r);
+
+        /* Tractor */
+        else if (strcmp(k, "normal_power") == 0)
+            ss->normal_power = read_f32(r);
+
+        /* Cloak */
+        else if (strcmp(k, "cloak_strength") == 0)
+            ss->cloak_strength = read_f32(r);
+
+        /* Repair */
+        else if (strcmp(k, "max_repair_points") == 0)
+            ss->max_repair_points = read_f32(r);
+        else if (strcmp(k, "num_repair_teams") == 0)
+            ss->num_repair_teams = read_int(r);
+
+        else
+            json_reader_skip(r);
+    }
+}
 
-    return true;
+/* Read an array of subsystem objects into ship->subsystems. */
+static void load_subsystem_array(bc_ship_class_t *ship, json_reader_t *r)
+{
+    ship->subsystem_count = 0;
+    if (!json_reader_begin_array(r)) return;
+    while (json_reader_item(r)) {
+        if (ship->subsystem_count >= BC_MAX_SUBSYSTEMS) {
+            json_reader_skip(r);
+            continue;
+        }
+        load_subsystem(&ship->subsystems[ship->subsystem_count++], r);
+    }
 }
 
 /* Find a subsystem in the flat array by name. Returns index or -1. */
@@ -96,10 +175,8 @@ static int find_subsys_by_name(const bc_ship_class_t *ship, const char *name)
 }
 
 /* Parse format string ("base", "powered", "power") to enum. */
-static u8 parse_ss_format(const json_value_t *val)
+static u8 parse_ss_format(const char *s)
 {
-    const char *s = json_string(val);
-    if (!s) return BC_SS_FORMAT_BASE;
     if (strcmp(s, "powered") == 0) return BC_SS_FORMAT_POWERED;
     if (strcmp(s, "power") == 0)   return BC_SS_FORMAT_POWER;
     return BC_SS_FORMAT_BASE;
@@ -107,51 +184,140 @@ static u8 parse_ss_format(const json_value_t *val)
 
 /* Parse power_mode (0=main-first, 1=backup-first, 2=backup-only).
  * Invalid/missing values default to mode 0. */
-static u8 parse_power_mode(const json_value_t *val)
+static u8 parse_power_mode(int mode)
 {
-    int mode = json_int(val);
     if (mode < BC_POWER_MODE_MAIN_FIRST || mode > BC_POWER_MODE_BACKUP_ONLY)
         return BC_POWER_MODE_MAIN_FIRST;
     return (u8)mode;
 }
 
-/* Load the hierarchical serialization list from JSON.
+/* Serialization list as read from JSON, before names are matched. Kept
+ * until the enclosing document is done, since name matching needs the
+ * subsystem array and a monolith ship may list it after the entries. */
+typedef struct {
+    bool  named;
+    char  name[64];
+    f32   max_condition;
+} ss_child_src_t;
+
+typedef struct {
+    bool  named;
+    char  name[64];
+    u8    format;
+    int   power_mode;
+    f32   max_condition;
+    f32   normal_power;
+    int   child_count;
+    ss_child_src_t children[BC_SS_MAX_CHILDREN];
+} ss_entry_src_t;
+
+typedef struct {
+    bool  present;          /* the value was an array */
+    int   count;
+    ss_entry_src_t entries[BC_SS_MAX_ENTRIES];
+} ss_list_src_t;
+
+static void read_ss_child(ss_child_src_t *c, json_reader_t *r)
+{
+    memset(c, 0, sizeof(*c));
+    if (!json_reader_begin_object(r)) return;
+    while (json_reader_key(r)) {
+        if (strcmp(r->str, "name") == 0)
+            c->named = read_name(r, c->name, sizeof(c->name));
+        else if (strcmp(r->str, "max_condition") == 0)
+            c->max_condition = read_f32(r);
+        else
+            json_reader_skip(r);
+    }
+}
+
+static void read_ss_entry(ss_entry_src_t *e, json_reader_t *r)
+{
+    memset(e, 0, sizeof(*e));
+    e->format = BC_SS_FORMAT_BASE;
+    if (!json_reader_begin_object(r)) return;
+
+    while (json_reader_key(r)) {
+        const char *k = r->str;
+        if (strcmp(k, "name") == 0) {
+            e->named = read_name(r, e->name, sizeof(e->name));
+        } else if (strcmp(k, "format") == 0) {
+            char fmt[16];
+            e->format = json_reader_string(r, fmt, sizeof(fmt))
+                ? parse_ss_format(fmt) : BC_SS_FORMAT_BASE;
+        } else if (strcmp(k, "power_mode") == 0) {
+            e->power_mode = read_int(r);
+        } else if (strcmp(k, "max_condition") == 0) {
+            e->max_condition = read_f32(r);
+        } else if (strcmp(k, "normal_power") == 0) {
+            e->normal_power = read_f32(r);
+        } else if (strcmp(k, "children") == 0) {
+            e->child_count = 0;
+            if (!json_reader_begin_array(r)) continue;
+            while (json_reader_item(r)) {
+                if (e->child_count >= BC_SS_MAX_CHILDREN) {
+                    json_reader_skip(r);
+                    continue;
+                }
+                read_ss_child(&e->children[e->child_count++], r);
+            }
+        } else {
+            json_reader_skip(r);
+        }
+    }
+}
+
+static void read_serialization_src(ss_list_src_t *src, json_reader_t *r)
+{
+    src->present = false;
+    src->count = 0;
+    if (!json_reader_begin_array(r)) return;
+    src->present = true;
+    while (json_reader_item(r)) {
+        if (src->count >= BC_SS_MAX_ENTRIES) {
+            json_reader_skip(r);
+            continue;
+        }
+        read_ss_entry(&src->entries[src->count++], r);
+    }
+}
+
+/* Build the hierarchical serialization list from its JSON form.
  * Matches entries/children to the flat subsystem array by name.
- * New container entries get HP slots beyond subsystem_count. */
-static void load_serialization_list(bc_ship_class_t *ship, const json_value_t *arr)
+ * New container entries get HP slots beyond subsystem_count.
+ * src NULL (or not an array) means the ship has no list. */
+static void resolve_serialization_list(bc_ship_class_t *ship,
+                                       const ss_list_src_t *src)
 {
     bc_ss_list_t *sl = &ship->ser_list;
     memset(sl, 0, sizeof(*sl));
     sl->reactor_entry_idx = -1;
 
-    if (!arr || arr->type != JSON_ARRAY) {
+    if (!src || !src->present) {
         sl->total_hp_slots = ship->subsystem_count;
         return;
     }
 
-    size_t n = json_array_len(arr);
-    if ((int)n > BC_SS_MAX_ENTRIES) n = BC_SS_MAX_ENTRIES;
-    sl->count = (int)n;
+    sl->count = src->count;
 
     /* Next available HP slot for containers not in the flat array */
     int next_hp_slot = ship->subsystem_count;
 
-    for (size_t i = 0; i < n; i++) {
-        const json_value_t *entry_obj = json_array_get(arr, i);
+    for (int i = 0; i < src->count; i++) {
+        const ss_entry_src_t *es = &src->entries[i];
         bc_ss_entry_t *e = &sl->entries[i];
         memset(e, 0, sizeof(*e));
 
-        e->format = parse_ss_format(json_get(entry_obj, "format"));
-        e->max_condition = (f32)json_number(json_get(entry_obj, "max_condition"));
-        e->normal_power = (f32)json_number(json_get(entry_obj, "normal_power"));
+        e->format = es->format;
+        e->max_condition = es->max_condition;
+        e->normal_power = es->normal_power;
         e->power_mode = BC_POWER_MODE_MAIN_FIRST;
         if (e->format == BC_SS_FORMAT_POWERED) {
-            e->power_mode = parse_power_mode(json_get(entry_obj, "power_mode"));
+            e->power_mode = parse_power_mode(es->power_mode);
         }
 
         /* Match entry name to flat subsystem array */
-        const char *ename = json_string(json_get(entry_obj, "name"));
-        int flat_idx = ename ? find_subsys_by_name(ship, ename) : -1;
+        int flat_idx = es->named ? find_subsys_by_name(ship, es->name) : -1;
         if (flat_idx >= 0) {
             e->hp_index = flat_idx;
             /* Use the flat subsystem's max_condition as the canonical value.
@@ -170,32 +336,24 @@ static void load_serialization_list(bc_ship_class_t *ship, const json_value_t *a
 
         /* Track reactor entry */
         if (e->format == BC_SS_FORMAT_POWER) {
-            sl->reactor_entry_idx = (int)i;
+            sl->reactor_entry_idx = i;
         }
 
         /* Children */
-        const json_value_t *children = json_get(entry_obj, "children");
-        if (children && children->type == JSON_ARRAY) {
-            size_t cn = json_array_len(children);
-            if ((int)cn > BC_SS_MAX_CHILDREN) cn = BC_SS_MAX_CHILDREN;
-            e->child_count = (int)cn;
-
-            for (size_t c = 0; c < cn; c++) {
-                const json_value_t *child_obj = json_array_get(children, c);
-                const char *cname = json_string(json_get(child_obj, "name"));
-                int cidx = cname ? find_subsys_by_name(ship, cname) : -1;
-                if (cidx >= 0) {
-                    e->child_hp_index[c] = cidx;
-                    e->child_max_condition[c] = ship->subsystems[cidx].max_condition;
-                    /* Set parent_idx on the child subsystem */
-                    ship->subsystems[cidx].parent_idx = e->hp_index;
-                } else {
-                    /* Child not found — allocate slot (shouldn't happen with correct data) */
-                    e->child_hp_index[c] = next_hp_slot;
-                    e->child_max_condition[c] = (f32)json_number(
-                        json_get(child_obj, "max_condition"));
-                    if (next_hp_slot < BC_MAX_SUBSYSTEMS) next_hp_slot++;
-                }
+        e->child_count = es->child_count;
+        for (int c = 0; c < es->child_count; c++) {
+            const ss_child_src_t *cs = &es->children[c];
+            int cidx = cs->named ? find_subsys_by_name(ship, cs->name) : -1;
+            if (cidx >= 0) {
+                e->child_hp_index[c] = cidx;
+                e->child_max_condition[c] = ship->subsystems[cidx].max_condition;
+                /* Set parent_idx on the child subsystem */
+                ship->subsystems[cidx].parent_idx = e->hp_index;
+            } else {
+                /* Child not found — allocate slot (shouldn't happen with correct data) */
+                e->child_hp_index[c] = next_hp_slot;
+                e->child_max_condition[c] = cs->max_condition;
+                if (next_hp_slot < BC_MAX_SUBSYSTEMS) next_hp_slot++;
             }
         }
     }
@@ -203,278 +361,451 @@ static void load_serialization_list(bc_ship_class_t *ship, const json_value_t *a
     sl->total_hp_slots = next_hp_slot;
 }
 
-static bool load_ship(bc_ship_class_t *ship, const json_value_t *obj)
+/* --- Subsystem BVH --- */
+
+static f32 vec3_axis(bc_vec3_t v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+/* Build the subtree over bvh_order[first .. first+count) and return its node
+ * index, or -1 if the node array is exhausted. Nodes are laid out depth-first
+ * so an internal node's left child is always the next node. */
+static int bvh_build_node(bc_ship_class_t *cls, int first, int count)
 {
-    memset(ship, 0, sizeof(*ship));
-    copy_str(ship->name, sizeof(ship->name), json_get(obj, "name"));
-    ship->species_id = (u16)json_int(json_get(obj, "species_id"));
-    copy_str(ship->faction, sizeof(ship->faction), json_get(obj, "faction"));
-    ship->hull_hp = (f32)json_number(json_get(obj, "hull_hp"));
-    ship->mass = (f32)json_number(json_get(obj, "mass"));
-    ship->rotational_inertia = (f32)json_number(json_get(obj, "rotational_inertia"));
-    ship->max_speed = (f32)json_number(json_get(obj, "max_speed"));
-    ship->max_accel = (f32)json_number(json_get(obj, "max_accel"));
-    ship->max_angular_accel = (f32)json_number(json_get(obj, "max_angular_accel"));
-    ship->max_angular_velocity = (f32)json_number(json_get(obj, "max_angular_velocity"));
-    read_float_array(json_get(obj, "shield_hp"), ship->shield_hp, BC_MAX_SHIELD_FACINGS);
-    read_float_array(json_get(obj, "shield_recharge"), ship->shield_recharge, BC_MAX_SHIELD_FACINGS);
-    ship->can_cloak = json_bool(json_get(obj, "can_cloak"));
-    ship->has_tractor = json_bool(json_get(obj, "has_tractor"));
-    ship->torpedo_tubes = (u8)json_int(json_get(obj, "torpedo_tubes"));
-    ship->phaser_banks = (u8)json_int(json_get(obj, "phaser_banks"));
-    ship->pulse_weapons = (u8)json_int(json_get(obj, "pulse_weapons"));
-    ship->tractor_beams = (u8)json_int(json_get(obj, "tractor_beams"));
-    ship->max_repair_points = (f32)json_number(json_get(obj, "max_repair_points"));
-    ship->num_repair_teams = json_int(json_get(obj, "num_repair_teams"));
-    ship->damage_radius_multiplier = 1.0f;
-    ship->damage_falloff_multiplier = 1.0f;
+    if (cls->bvh_node_count >= BC_SS_BVH_MAX_NODES) return -1;
+    int ni = cls->bvh_node_count++;
+    bc_ss_bvh_node_t *node = &cls->bvh_nodes[ni];
+
+    const bc_subsystem_def_t *ss0 = &cls->subsystems[cls->bvh_order[first]];
+    node->lo = ss0->position;
+    node->hi = ss0->position;
+    node->max_radius = ss0->radius;
+    for (int i = first + 1; i < first + count; i++) {
+        const bc_subsystem_def_t *ss = &cls->subsystems[cls->bvh_order[i]];
+        if (ss->position.x < node->lo.x) node->lo.x = ss->position.x;
+        if (ss->position.y < node->lo.y) node->lo.y = ss->position.y;
+        if (ss->position.z < node->lo.z) node->lo.z = ss->position.z;
+        if (ss->position.x > node->hi.x) node->hi.x = ss->position.x;
+        if (ss->position.y > node->hi.y) node->hi.y = ss->position.y;
+        if (ss->position.z > node->hi.z) node->hi.z = ss->position.z;
+        if (ss->radius > node->max_radius) node->max_radius = ss->radius;
+    }
 
-    /* Subsystems */
-    json_value_t *subs = json_get(obj, "subsystems");
-    if (subs && subs->type == JSON_ARRAY) {
-        size_t n = json_array_len(subs);
-        if ((int)n > BC_MAX_SUBSYSTEMS) n = BC_MAX_SUBSYSTEMS;
-        ship->subsystem_count = (int)n;
-        for (size_t i = 0; i < n; i++) {
-            load_subsystem(&ship->subsystems[i], json_array_get(subs, i));
-        }
+    if (count <= BC_SS_BVH_LEAF_SIZE) {
+        node->first = (u8)first;
+        node->count = (u8)count;
+        return ni;
     }
 
-    /* Compute bounding extent from subsystem positions */
-    {
-        f32 max_dist = 0.0f;
-        for (int i = 0; i < ship->subsystem_count; i++) {
-            bc_vec3_t p = ship->subsystems[i].position;
-            f32 d = sqrtf(p.x*p.x + p.y*p.y + p.z*p.z);
-            if (d > max_dist) max_dist = d;
+    /* Median split along the widest axis of the center bounds.
+     * Insertion sort is plenty for at most BC_MAX_SUBSYSTEMS entries. */
+    f32 ex = node->hi.x - node->lo.x;
+    f32 ey = node->hi.y - node->lo.y;
+    f32 ez = node->hi.z - node->lo.z;
+    int axis = (ex >= ey && ex >= ez) ? 0 : (ey >= ez ? 1 : 2);
+
+    u8 *ord = &cls->bvh_order[first];
+    for (int i = 1; i < count; i++) {
+        u8 key = ord[i];
+        f32 kv = vec3_axis(cls->subsystems[key].position, axis);
+        int j = i - 1;
+        while (j >= 0) {
+            f32 jv = vec3_axis(cls->subsystems[ord[j]].position, axis);
+            if (jv < kv || (jv == kv && ord[j] < key)) break;
+            ord[j + 1] = ord[j];
+            j--;
         }
-        ship->bounding_extent = max_dist > 0.0f ? max_dist : 1.0f;
+        ord[j + 1] = key;
     }
 
-    /* Serialization list (must be after subsystems are loaded) */
-    load_serialization_list(ship, json_get(obj, "serialization_list"));
+    int half = count / 2;
+    node->count = 0;
+    if (bvh_build_node(cls, first, half) < 0) return -1;
+    int right = bvh_build_node(cls, first + half, count - half);
+    if (right < 0) return -1;
+    node->first = (u8)right;
+    return ni;
+}
 
-    /* Power plant parameters */
-    ship->power_output = (f32)json_number(json_get(obj, "power_output"));
-    ship->main_battery_limit = (f32)json_number(json_get(obj, "main_battery_limit"));
-    ship->backup_battery_limit = (f32)json_number(json_get(obj, "backup_battery_limit"));
-    ship->main_conduit_capacity = (f32)json_number(json_get(obj, "main_conduit_capacity"));
-    ship->backup_conduit_capacity = (f32)json_number(json_get(obj, "backup_conduit_capacity"));
+void bc_ship_class_build_bvh(bc_ship_class_t *cls)
+{
+    cls->bvh_node_count = 0;
 
-    return true;
+    int n = 0;
+    for (int i = 0; i < cls->subsystem_count && i < BC_MAX_SUBSYSTEMS; i++) {
+        /* Mirrors the linear scan's skip: radius <= 0 (or NaN) never hits */
+        if (cls->subsystems[i].radius > 0.0f)
+            cls->bvh_order[n++] = (u8)i;
+    }
+    if (n == 0) return;
+
+    if (bvh_build_node(cls, 0, n) < 0)
+        cls->bvh_node_count = 0;  /* fall back to linear scan */
 }
 
-static bool load_projectile(bc_projectile_def_t *proj, const json_value_t *obj)
+/* Ship identity/physics fields, shared by ship.json and the monolith ship
+ * object. Returns false if the current key is not one of them (the value
+ * is then still unread). */
+static bool load_identity_field(bc_ship_class_t *ship, json_reader_t *r)
 {
-    memset(proj, 0, sizeof(*proj));
-    copy_str(proj->name, sizeof(proj->name), json_get(obj, "name"));
-    copy_str(proj->script, sizeof(proj->script), json_get(obj, "script"));
-    proj->net_type_id = (u8)json_int(json_get(obj, "net_type_id"));
-    proj->damage = (f32)json_number(json_get(obj, "damage"));
-    proj->launch_speed = (f32)json_number(json_get(obj, "launch_speed"));
-    proj->power_cost = (f32)json_number(json_get(obj, "power_cost"));
-    proj->guidance_lifetime = (f32)json_number(json_get(obj, "guidance_lifetime"));
-    proj->max_angular_accel = (f32)json_number(json_get(obj, "max_angular_accel"));
-    proj->lifetime = (f32)json_number(json_get(obj, "lifetime"));
-    proj->damage_radius_factor = (f32)json_number(json_get(obj, "damage_radius_factor"));
+    const char *k = r->str;
+    if (strcmp(k, "name") == 0)
+        json_reader_string(r, ship->name, sizeof(ship->name));
+    else if (strcmp(k, "species_id") == 0)
+        ship->species_id = (u16)read_int(r);
+    else if (strcmp(k, "faction") == 0)
+        json_reader_string(r, ship->faction, sizeof(ship->faction));
+    else if (strcmp(k, "hull_hp") == 0)
+        ship->hull_hp = read_f32(r);
+    else if (strcmp(k, "mass") == 0)
+        ship->mass = read_f32(r);
+    else if (strcmp(k, "rotational_inertia") == 0)
+        ship->rotational_inertia = read_f32(r);
+    else if (strcmp(k, "max_speed") == 0)
+        ship->max_speed = read_f32(r);
+    else if (strcmp(k, "max_accel") == 0)
+        ship->max_accel = read_f32(r);
+    else if (strcmp(k, "max_angular_accel") == 0)
+        ship->max_angular_accel = read_f32(r);
+    else if (strcmp(k, "max_angular_velocity") == 0)
+        ship->max_angular_velocity = read_f32(r);
+    else if (strcmp(k, "shield_hp") == 0)
+        read_float_array(r, ship->shield_hp, BC_MAX_SHIELD_FACINGS);
+    else if (strcmp(k, "shield_recharge") == 0)
+        read_float_array(r, ship->shield_recharge, BC_MAX_SHIELD_FACINGS);
+    else if (strcmp(k, "can_cloak") == 0)
+        ship->can_cloak = read_bool(r);
+    else if (strcmp(k, "has_tractor") == 0)
+        ship->has_tractor = read_bool(r);
+    else if (strcmp(k, "torpedo_tubes") == 0)
+        ship->torpedo_tubes = (u8)read_int(r);
+    else if (strcmp(k, "phaser_banks") == 0)
+        ship->phaser_banks = (u8)read_int(r);
+    else if (strcmp(k, "pulse_weapons") == 0)
+        ship->pulse_weapons = (u8)read_int(r);
+    else if (strcmp(k, "tractor_beams") == 0)
+        ship->tractor_beams = (u8)read_int(r);
+    else if (strcmp(k, "max_repair_points") == 0)
+        ship->max_repair_points = read_f32(r);
+    else if (strcmp(k, "num_repair_teams") == 0)
+        ship->num_repair_teams = read_int(r);
+    else
+        return false;
     return true;
 }
 
-/* Open and parse a JSON file from disk. Returns NULL on error.
- * Caller must call json_free() on the returned value. */
-static json_value_t *json_open(const char *path)
+/* Power plant fields, shared by power.json and the monolith ship object. */
+static bool load_power_field(bc_ship_class_t *ship, json_reader_t *r)
 {
-    FILE *f = fopen(path, "rb");
-    if (!f) return NULL;
+    const char *k = r->str;
+    if (strcmp(k, "power_output") == 0)
+        ship->power_output = read_f32(r);
+    else if (strcmp(k, "main_battery_limit") == 0)
+        ship->main_battery_limit = read_f32(r);
+    else if (strcmp(k, "backup_battery_limit") == 0)
+        ship->backup_battery_limit = read_f32(r);
+    else if (strcmp(k, "main_conduit_capacity") == 0)
+        ship->main_conduit_capacity = read_f32(r);
+    else if (strcmp(k, "backup_conduit_capacity") == 0)
+        ship->backup_conduit_capacity = read_f32(r);
+    else
+        return false;
+    return true;
+}
 
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fseek(f, 0, SEEK_SET);
+/* Compute bounding extent from subsystem positions and build the BVH. */
+static void finish_subsystems(bc_ship_class_t *ship)
+{
+    f32 max_dist = 0.0f;
+    for (int i = 0; i < ship->subsystem_count; i++) {
+        bc_vec3_t p = ship->subsystems[i].position;
+        f32 d = sqrtf(p.x*p.x + p.y*p.y + p.z*p.z);
+        if (d > max_dist) max_dist = d;
+    }
+    ship->bounding_extent = max_dist > 0.0f ? max_dist : 1.0f;
+    bc_ship_class_build_bvh(ship);
+}
 
-    if (size <= 0) { fclose(f); return NULL; }
+/* One ship object of the monolith registry file. ser is scratch space. */
+static void load_ship(bc_ship_class_t *ship, json_reader_t *r,
+                      ss_list_src_t *ser)
+{
+    memset(ship, 0, sizeof(*ship));
+    ship->damage_radius_multiplier = 1.0f;
+    ship->damage_falloff_multiplier = 1.0f;
+    ser->present = false;
+
+    if (json_reader_begin_object(r)) {
+        while (json_reader_key(r)) {
+            if (load_identity_field(ship, r) || load_power_field(ship, r))
+                continue;
+            if (strcmp(r->str, "subsystems") == 0)
+                load_subsystem_array(ship, r);
+            else if (strcmp(r->str, "serialization_list") == 0)
+                read_serialization_src(ser, r);
+            else
+                json_reader_skip(r);
+        }
+    }
 
-    char *text = (char *)malloc((size_t)size + 1);
-    if (!text) { fclose(f); return NULL; }
+    finish_subsystems(ship);
 
-    size_t nread = fread(text, 1, (size_t)size, f);
-    fclose(f);
-    text[nread] = '\0';
+    /* Serialization list (must be after subsystems are loaded) */
+    resolve_serialization_list(ship, ser);
+}
 
-    json_value_t *root = json_parse(text);
-    free(text);
-    return root;
+static void load_projectile(bc_projectile_def_t *proj, json_reader_t *r)
+{
+    memset(proj, 0, sizeof(*proj));
+    if (!json_reader_begin_object(r)) return;
+
+    while (json_reader_key(r)) {
+        const char *k = r->str;
+        if (strcmp(k, "name") == 0)
+            json_reader_string(r, proj->name, sizeof(proj->name));
+        else if (strcmp(k, "script") == 0)
+            json_reader_string(r, proj->script, sizeof(proj->script));
+        else if (strcmp(k, "net_type_id") == 0)
+            proj->net_type_id = (u8)read_int(r);
+        else if (strcmp(k, "damage") == 0)
+            proj->damage = read_f32(r);
+        else if (strcmp(k, "launch_speed") == 0)
+            proj->launch_speed = read_f32(r);
+        else if (strcmp(k, "power_cost") == 0)
+            proj->power_cost = read_f32(r);
+        else if (strcmp(k, "guidance_lifetime") == 0)
+            proj->guidance_lifetime = read_f32(r);
+        else if (strcmp(k, "max_angular_accel") == 0)
+            proj->max_angular_accel = read_f32(r);
+        else if (strcmp(k, "lifetime") == 0)
+            proj->lifetime = read_f32(r);
+        else if (strcmp(k, "damage_radius_factor") == 0)
+            proj->damage_radius_factor = read_f32(r);
+        else
+            json_reader_skip(r);
+    }
 }
 
 bool bc_registry_load(bc_game_registry_t *reg, const char *path)
 {
     memset(reg, 0, sizeof(*reg));
 
-    json_value_t *root = json_open(path);
-    if (!root) return false;
-
-    /* Ships */
-    json_value_t *ships = json_get(root, "ships");
-    if (ships && ships->type == JSON_ARRAY) {
-        size_t n = json_array_len(ships);
-        if ((int)n > BC_MAX_SHIPS) n = BC_MAX_SHIPS;
-        reg->ship_count = (int)n;
-        for (size_t i = 0; i < n; i++) {
-            load_ship(&reg->ships[i], json_array_get(ships, i));
-        }
+    json_reader_t r;
+    if (!json_reader_open(&r, path)) return false;
+
+    ss_list_src_t *ser = (ss_list_src_t *)malloc(sizeof(*ser));
+    if (!ser) {
+        json_reader_close(&r);
+        return false;
     }
 
-    /* Projectiles */
-    json_value_t *projs = json_get(root, "projectiles");
-    if (projs && projs->type == JSON_ARRAY) {
-        size_t n = json_array_len(projs);
-        if ((int)n > BC_MAX_PROJECTILES) n = BC_MAX_PROJECTILES;
-        reg->projectile_count = (int)n;
-        for (size_t i = 0; i < n; i++) {
-            load_projectile(&reg->projectiles[i], json_array_get(projs, i));
+    /* Duplicate keys: the first "ships"/"projectiles" wins */
+    bool seen_ships = false, seen_projs = false;
+    if (json_reader_begin_object(&r)) {
+        while (json_reader_key(&r)) {
+            if (strcmp(r.str, "ships") == 0 && !seen_ships) {
+                seen_ships = true;
+                if (!json_reader_begin_array(&r)) continue;
+                int n = 0;
+                while (json_reader_item(&r)) {
+                    if (n >= BC_MAX_SHIPS) { json_reader_skip(&r); continue; }
+                    load_ship(&reg->ships[n++], &r, ser);
+                }
+                reg->ship_count = n;
+            } else if (strcmp(r.str, "projectiles") == 0 && !seen_projs) {
+                seen_projs = true;
+                if (!json_reader_begin_array(&r)) continue;
+                int n = 0;
+                while (json_reader_item(&r)) {
+                    if (n >= BC_MAX_PROJECTILES) { json_reader_skip(&r); continue; }
+                    load_projectile(&reg->projectiles[n++], &r);
+                }
+                reg->projectile_count = n;
+            } else {
+                json_reader_skip(&r);
+            }
         }
     }
 
-    json_free(root);
+    bool ok = json_reader_ok(&r);
+    json_reader_close(&r);
+    free(ser);
+    if (!ok) {
+        memset(reg, 0, sizeof(*reg));
+        return false;
+    }
     reg->loaded = true;
     return true;
 }
 
 /* Load ship identity/physics fields from ship.json into an already-zeroed
- * bc_ship_class_t.  Does not touch subsystems, ser_list, or power fields. */
-static void load_ship_identity(bc_ship_class_t *ship, const json_value_t *obj)
-{
-    copy_str(ship->name, sizeof(ship->name), json_get(obj, "name"));
-    ship->species_id = (u16)json_int(json_get(obj, "species_id"));
-    copy_str(ship->faction, sizeof(ship->faction), json_get(obj, "faction"));
-    ship->hull_hp = (f32)json_number(json_get(obj, "hull_hp"));
-    ship->mass = (f32)json_number(json_get(obj, "mass"));
-    ship->rotational_inertia = (f32)json_number(json_get(obj, "rotational_inertia"));
-    ship->max_speed = (f32)json_number(json_get(obj, "max_speed"));
-    ship->max_accel = (f32)json_number(json_get(obj, "max_accel"));
-    ship->max_angular_accel = (f32)json_number(json_get(obj, "max_angular_accel"));
-    ship->max_angular_velocity = (f32)json_number(json_get(obj, "max_angular_velocity"));
-    read_float_array(json_get(obj, "shield_hp"), ship->shield_hp, BC_MAX_SHIELD_FACINGS);
-    read_float_array(json_get(obj, "shield_recharge"), ship->shield_recharge, BC_MAX_SHIELD_FACINGS);
-    ship->can_cloak = json_bool(json_get(obj, "can_cloak"));
-    ship->has_tractor = json_bool(json_get(obj, "has_tractor"));
-    ship->torpedo_tubes = (u8)json_int(json_get(obj, "torpedo_tubes"));
-    ship->phaser_banks = (u8)json_int(json_get(obj, "phaser_banks"));
-    ship->pulse_weapons = (u8)json_int(json_get(obj, "pulse_weapons"));
-    ship->tractor_beams = (u8)json_int(json_get(obj, "tractor_beams"));
-    ship->max_repair_points = (f32)json_number(json_get(obj, "max_repair_points"));
-    ship->num_repair_teams = json_int(json_get(obj, "num_repair_teams"));
+ * bc_ship_class_t.  Does not touch subsystems, ser_list, or power fields.
+ * Returns false if the file is missing or malformed. */
+static bool load_ship_identity(bc_ship_class_t *ship, const char *path)
+{
+    json_reader_t r;
+    if (!json_reader_open(&r, path)) return false;
+    if (json_reader_begin_object(&r)) {
+        while (json_reader_key(&r)) {
+            if (!load_identity_field(ship, &r)) json_reader_skip(&r);
+        }
+    }
+    bool ok = json_reader_ok(&r);
+    json_reader_close(&r);
     ship->damage_radius_multiplier = 1.0f;
     ship->damage_falloff_multiplier = 1.0f;
+    return ok;
+}
+
+/* subsystems.json: no subsystems if the file is missing or malformed. */
+static void load_subsystems_file(bc_ship_class_t *ship, const char *path)
+{
+    json_reader_t r;
+    if (!json_reader_open(&r, path)) return;
+    load_subsystem_array(ship, &r);
+    if (!json_reader_ok(&r)) {
+        memset(ship->subsystems, 0, sizeof(ship->subsystems));
+        ship->subsystem_count = 0;
+    }
+    json_reader_close(&r);
+}
+
+/* serialization.json -- must come after subsystems are loaded */
+static void load_serialization_file(bc_ship_class_t *ship, const char *path,
+                                    ss_list_src_t *ser)
+{
+    json_reader_t r;
+    bool ok = false;
+    if (json_reader_open(&r, path)) {
+        read_serialization_src(ser, &r);
+        ok = json_reader_ok(&r);
+        json_reader_close(&r);
+    }
+    resolve_serialization_list(ship, ok ? ser : NULL);
+}
+
+/* power.json: fields stay zero if the file is missing or malformed. */
+static void load_power_file(bc_ship_class_t *ship, const char *path)
+{
+    json_reader_t r;
+    if (!json_reader_open(&r, path)) return;
+    if (json_reader_begin_object(&r)) {
+        while (json_reader_key(&r)) {
+            if (!load_power_field(ship, &r)) json_reader_skip(&r);
+        }
+    }
+    if (!json_reader_ok(&r)) {
+        ship->power_output = 0.0f;
+        ship->main_battery_limit = 0.0f;
+        ship->backup_battery_limit = 0.0f;
+        ship->main_conduit_capacity = 0.0f;
+        ship->backup_conduit_capacity = 0.0f;
+    }
+    json_reader_close(&r);
+}
+
+/* Load ships/<folder>/ into the next free ship slot. Ships with a missing
+ * or unreadable ship.json are skipped. */
+static void load_ship_dir(bc_game_registry_t *reg, const char *dir,
+                          const char *folder, ss_list_src_t *ser)
+{
+    bc_ship_class_t *ship = &reg->ships[reg->ship_count];
+    memset(ship, 0, sizeof(*ship));
+
+    char path[512];
+
+    /* ship.json -- identity + physics */
+    snprintf(path, sizeof(path), "%s/ships/%s/ship.json", dir, folder);
+    if (!load_ship_identity(ship, path)) {
+        memset(ship, 0, sizeof(*ship));
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/ships/%s/subsystems.json", dir, folder);
+    load_subsystems_file(ship, path);
+    finish_subsystems(ship);
+
+    snprintf(path, sizeof(path), "%s/ships/%s/serialization.json", dir, folder);
+    load_serialization_file(ship, path, ser);
+
+    snprintf(path, sizeof(path), "%s/ships/%s/power.json", dir, folder);
+    load_power_file(ship, path);
+
+    reg->ship_count++;
+}
+
+/* Load projectiles/<base>.json into the next free projectile slot. */
+static void load_projectile_file(bc_game_registry_t *reg, const char *dir,
+                                 const char *base)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/projectiles/%s.json", dir, base);
+
+    json_reader_t r;
+    if (!json_reader_open(&r, path)) return;
+    bc_projectile_def_t *proj = &reg->projectiles[reg->projectile_count];
+    load_projectile(proj, &r);
+    if (json_reader_ok(&r))
+        reg->projectile_count++;
+    else
+        memset(proj, 0, sizeof(*proj));
+    json_reader_close(&r);
 }
 
 bool bc_registry_load_dir(bc_game_registry_t *reg, const char *dir)
 {
     memset(reg, 0, sizeof(*reg));
 
-    /* Load manifest.json */
+    /* manifest.json is streamed too: each listed ship or projectile is
+     * loaded as soon as its name is read. */
     char manifest_path[512];
     snprintf(manifest_path, sizeof(manifest_path), "%s/manifest.json", dir);
-    json_value_t *manifest = json_open(manifest_path);
-    if (!manifest) return false;
-
-    /* --- Ships --- */
-    json_value_t *ships_arr = json_get(manifest, "ships");
-    if (ships_arr && ships_arr->type == JSON_ARRAY) {
-        size_t n = json_array_len(ships_arr);
-        if ((int)n > BC_MAX_SHIPS) n = BC_MAX_SHIPS;
-
-        for (size_t i = 0; i < n; i++) {
-            const char *folder = json_string(json_array_get(ships_arr, i));
-            if (!folder) continue;
-
-            bc_ship_class_t *ship = &reg->ships[reg->ship_count];
-            memset(ship, 0, sizeof(*ship));
-
-            char path[512];
-
-            /* ship.json -- identity + physics */
-            snprintf(path, sizeof(path), "%s/ships/%s/ship.json", dir, folder);
-            json_value_t *ship_obj = json_open(path);
-            if (!ship_obj) continue; /* skip ships with missing ship.json */
-            load_ship_identity(ship, ship_obj);
-            json_free(ship_obj);
-
-            /* subsystems.json */
-            snprintf(path, sizeof(path), "%s/ships/%s/subsystems.json", dir, folder);
-            json_value_t *subs_arr = json_open(path);
-            if (subs_arr && subs_arr->type == JSON_ARRAY) {
-                size_t sn = json_array_len(subs_arr);
-                if ((int)sn > BC_MAX_SUBSYSTEMS) sn = BC_MAX_SUBSYSTEMS;
-                ship->subsystem_count = (int)sn;
-                for (size_t j = 0; j < sn; j++)
-                    load_subsystem(&ship->subsystems[j], json_array_get(subs_arr, j));
-                json_free(subs_arr);
-            }
+    json_reader_t m;
+    if (!json_reader_open(&m, manifest_path)) return false;
 
-            /* Compute bounding extent from subsystem positions */
-            {
-                f32 max_dist = 0.0f;
-                for (int j = 0; j < ship->subsystem_count; j++) {
-                    bc_vec3_t p = ship->subsystems[j].position;
-                    f32 d = sqrtf(p.x*p.x + p.y*p.y + p.z*p.z);
-                    if (d > max_dist) max_dist = d;
-                }
-                ship->bounding_extent = max_dist > 0.0f ? max_dist : 1.0f;
-            }
+    ss_list_src_t *ser = (ss_list_src_t *)malloc(sizeof(*ser));
+    if (!ser) {
+        json_reader_close(&m);
+        return false;
+    }
 
-            /* serialization.json -- must come after subsystems are loaded */
-            snprintf(path, sizeof(path), "%s/ships/%s/serialization.json", dir, folder);
-            json_value_t *ser_arr = json_open(path);
-            if (ser_arr) {
-                load_serialization_list(ship, ser_arr);
-                json_free(ser_arr);
+    /* Duplicate keys: the first "ships"/"projectiles" wins */
+    bool seen_ships = false, seen_projs = false;
+    char name[256];
+    if (json_reader_begin_object(&m)) {
+        while (json_reader_key(&m)) {
+            if (strcmp(m.str, "ships") == 0 && !seen_ships) {
+                seen_ships = true;
+                if (!json_reader_begin_array(&m)) continue;
+                int listed = 0;
+                while (json_reader_item(&m)) {
+                    if (listed++ >= BC_MAX_SHIPS) { json_reader_skip(&m); continue; }
+                    if (json_reader_string(&m, name, sizeof(name)))
+                        load_ship_dir(reg, dir, name, ser);
+                }
+            } else if (strcmp(m.str, "projectiles") == 0 && !seen_projs) {
+                seen_projs = true;
+                if (!json_reader_begin_array(&m)) continue;
+                int listed = 0;
+                while (json_reader_item(&m)) {
+                    if (listed++ >= BC_MAX_PROJECTILES) { json_reader_skip(&m); continue; }
+                    if (json_reader_string(&m, name, sizeof(name)))
+                        load_projectile_file(reg, dir, name);
+                }
             } else {
-                ship->ser_list.total_hp_slots = ship->subsystem_count;
-                ship->ser_list.reactor_entry_idx = -1;
+                json_reader_skip(&m);
             }
-
-            /* power.json */
-            snprintf(path, sizeof(path), "%s/ships/%s/power.json", dir, folder);
-            json_value_t *pow_obj = json_open(path);
-            if (pow_obj) {
-                ship->power_output =
-                    (f32)json_number(json_get(pow_obj, "power_output"));
-                ship->main_battery_limit =
-                    (f32)json_number(json_get(pow_obj, "main_battery_limit"));
-                ship->backup_battery_limit =
-                    (f32)json_number(json_get(pow_obj, "backup_battery_limit"));
-                ship->main_conduit_capacity =
-                    (f32)json_number(json_get(pow_obj, "main_conduit_capacity"));
-                ship->backup_conduit_capacity =
-                    (f32)json_number(json_get(pow_obj, "backup_conduit_capacity"));
-                json_free(pow_obj);
-            }
-
-            reg->ship_count++;
         }
     }
 
-    /* --- Projectiles --- */
-    json_value_t *projs_arr = json_get(manifest, "projectiles");
-    if (projs_arr && projs_arr->type == JSON_ARRAY) {
-        size_t n = json_array_len(projs_arr);
-        if ((int)n > BC_MAX_PROJECTILES) n = BC_MAX_PROJECTILES;
-
-        for (size_t i = 0; i < n; i++) {
-            const char *file_base = json_string(json_array_get(projs_arr, i));
-            if (!file_base) continue;
-
-            char path[512];
-            snprintf(path, sizeof(path), "%s/projectiles/%s.json", dir, file_base);
-            json_value_t *proj_obj = json_open(path);
-            if (!proj_obj) continue;
-            load_projectile(&reg->projectiles[reg->projectile_count], proj_obj);
-            json_free(proj_obj);
-            reg->projectile_count++;
-        }
+    bool ok = json_reader_ok(&m);
+    json_reader_close(&m);
+    free(ser);
+    if (!ok) {
+        memset(reg, 0, sizeof(*reg));
+        return false;
     }
-
-    json_free(manifest);
     reg->loaded = true;
     return reg->ship_count > 0;
 }
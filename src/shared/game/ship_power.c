@@ -2,6 +2,8 @@
 #include "openbc/buffer.h"
 #include "openbc/game_builders.h"
 
+#include <string.h>
+
 /* --- Hierarchical health serializer (flag 0x20) --- */
 
 /* Encode condition as u8: truncate(current / max * 255) */
@@ -14,6 +16,104 @@ static u8 encode_condition(f32 current, f32 max)
     return (u8)(ratio * 255.0f);
 }
 
+/* Append one ser_list entry to fb in the 0x20 wire layout. */
+static void encode_health_entry(bc_buffer_t *fb,
+                                const bc_ship_state_t *ship,
+                                const bc_ship_class_t *cls,
+                                int cursor, bool is_own_ship)
+{
+    const bc_ss_entry_t *e = &cls->ser_list.entries[cursor];
+
+    /* Write condition byte */
+    bc_buf_write_u8(fb, encode_condition(
+        ship->subsystem_hp[e->hp_index], e->max_condition));
+
+    /* Write children condition bytes */
+    for (int c = 0; c < e->child_count; c++) {
+        bc_buf_write_u8(fb, encode_condition(
+            ship->subsystem_hp[e->child_hp_index[c]],
+            e->child_max_condition[c]));
+    }
+
+    /* Format-specific extras.
+     * Consecutive Powered entries share their has_power_data bits
+     * in a single [count:3][values:5] byte.  Only reset bit_count
+     * when transitioning OUT of the Powered format (Base or Power). */
+    if (e->format == BC_SS_FORMAT_POWERED) {
+        if (is_own_ship) {
+            /* Owner's client has local power state; send false
+             * (no power_pct byte follows). */
+            bc_buf_write_bit(fb, false);
+        } else {
+            /* Remote observers need the power allocation data.
+             * Sign-bit encoding: positive = ON, negative = OFF.
+             * Disabled subsystem at pct%: write -(i8)pct so the
+             * client recovers both the slider position and the
+             * off state.  See power-system.md §Sign Bit. */
+            bc_buf_write_bit(fb, true);
+            u8 pct = ship->power_pct[cursor];
+            if (!ship->subsys_enabled[cursor])
+                pct = (u8)(-(i8)pct);
+            bc_buf_write_u8(fb, pct);
+        }
+    } else if (e->format == BC_SS_FORMAT_POWER) {
+        /* Non-Powered entry: flush any accumulated Powered bits */
+        fb->bit_count = 0;
+        /* Battery percentages: truncate(current / limit * 255) */
+        u8 main_pct = (cls->main_battery_limit > 0.0f)
+            ? (u8)(ship->main_battery / cls->main_battery_limit * 255.0f)
+            : 0;
+        u8 backup_pct = (cls->backup_battery_limit > 0.0f)
+            ? (u8)(ship->backup_battery / cls->backup_battery_limit * 255.0f)
+            : 0;
+        bc_buf_write_u8(fb, main_pct);
+        bc_buf_write_u8(fb, backup_pct);
+    } else {
+        /* BC_SS_FORMAT_BASE: flush any accumulated Powered bits */
+        fb->bit_count = 0;
+    }
+}
+
+/* One walk of the ser_list from start_idx feeding up to two variants.
+ * Each variant stops on its own budget; entries are encoded for whichever
+ * variants are still open. fb[v] == NULL skips variant v. */
+static void build_health_fields(const bc_ship_state_t *ship,
+                                const bc_ship_class_t *cls,
+                                u8 start_idx, bc_buffer_t *fb[2],
+                                const bool is_own[2], u8 next[2])
+{
+    const int count = cls->ser_list.count;
+    bool open[2];
+    for (int v = 0; v < 2; v++) {
+        open[v] = (fb[v] != NULL);
+        /* Write start_index byte (counts toward 10-byte budget) */
+        if (open[v]) bc_buf_write_u8(fb[v], start_idx);
+        next[v] = start_idx;
+    }
+
+    int cursor = (int)start_idx;
+    bool first = true;
+
+    while (open[0] || open[1]) {
+        int after = cursor + 1;
+        if (after >= count) after = 0;
+
+        for (int v = 0; v < 2; v++) {
+            if (!open[v]) continue;
+            encode_health_entry(fb[v], ship, cls, cursor, is_own[v]);
+            next[v] = (u8)after;
+
+            /* Stop conditions: full cycle, or budget exhausted */
+            if (after == (int)start_idx ||
+                (!first && (int)fb[v]->pos >= 10))
+                open[v] = false;
+        }
+
+        cursor = after;
+        first = false;
+    }
+}
+
 int bc_ship_build_health_update(const bc_ship_state_t *ship,
                                  const bc_ship_class_t *cls,
                                  f32 game_time,
@@ -21,95 +121,186 @@ int bc_ship_build_health_update(const bc_ship_state_t *ship,
                                  bool is_own_ship,
                                  u8 *buf, int buf_size)
 {
+    int len = 0;
+    bc_ship_build_health_pair(ship, cls, game_time, start_idx,
+                              is_own_ship ? buf : NULL, buf_size,
+                              is_own_ship ? &len : NULL,
+                              is_own_ship ? next_idx : NULL,
+                              is_own_ship ? NULL : buf, buf_size,
+                              is_own_ship ? NULL : &len,
+                              is_own_ship ? NULL : next_idx);
+    return len;
+}
+
+void bc_ship_build_health_pair(const bc_ship_state_t *ship,
+                               const bc_ship_class_t *cls,
+                               f32 game_time, u8 start_idx,
+                               u8 *own_buf, int own_size,
+                               int *own_len, u8 *next_own,
+                               u8 *rmt_buf, int rmt_size,
+                               int *rmt_len, u8 *next_rmt)
+{
+    if (own_len) *own_len = 0;
+    if (rmt_len) *rmt_len = 0;
+
     const bc_ss_list_t *sl = &cls->ser_list;
     if (!ship->alive || sl->count == 0) {
-        *next_idx = 0;
-        return 0;
+        if (next_own) *next_own = 0;
+        if (next_rmt) *next_rmt = 0;
+        return;
     }
 
     /* Clamp start_idx */
     if ((int)start_idx >= sl->count)
         start_idx = 0;
 
-    u8 field[128];
-    bc_buffer_t fb;
-    bc_buf_init(&fb, field, sizeof(field));
+    u8 field_own[128], field_rmt[128];
+    bc_buffer_t fb_own, fb_rmt;
+    bc_buf_init(&fb_own, field_own, sizeof(field_own));
+    bc_buf_init(&fb_rmt, field_rmt, sizeof(field_rmt));
+
+    bc_buffer_t *fb[2] = { own_buf ? &fb_own : NULL,
+                           rmt_buf ? &fb_rmt : NULL };
+    const bool is_own[2] = { true, false };
+    u8 next[2];
+    build_health_fields(ship, cls, start_idx, fb, is_own, next);
+
+    if (own_buf) {
+        if (next_own) *next_own = next[0];
+        int len = bc_build_state_update(own_buf, own_size,
+                                        ship->object_id, game_time, 0x20,
+                                        field_own, (int)fb_own.pos);
+        if (own_len) *own_len = len;
+    }
+    if (rmt_buf) {
+        if (next_rmt) *next_rmt = next[1];
+        int len = bc_build_state_update(rmt_buf, rmt_size,
+                                        ship->object_id, game_time, 0x20,
+                                        field_rmt, (int)fb_rmt.pos);
+        if (rmt_len) *rmt_len = len;
+    }
+}
 
-    /* Write start_index byte (counts toward 10-byte budget) */
-    bc_buf_write_u8(&fb, start_idx);
+/* --- Health replication: per-entry change tracking --- */
 
-    int cursor = (int)start_idx;
-    int initial = cursor;
-    bool first = true;
+/* Signature of one entry's remote-variant bytes (FNV-1a). */
+static u32 health_entry_sig(const bc_ship_state_t *ship,
+                            const bc_ship_class_t *cls, int idx)
+{
+    u8 tmp[2 + BC_SS_MAX_CHILDREN + 2];
+    bc_buffer_t b;
+    bc_buf_init(&b, tmp, sizeof(tmp));
+    encode_health_entry(&b, ship, cls, idx, false);
+
+    u32 h = 2166136261u;
+    for (size_t i = 0; i < b.pos; i++) {
+        h ^= tmp[i];
+        h *= 16777619u;
+    }
+    return h;
+}
 
-    while (1) {
-        const bc_ss_entry_t *e = &sl->entries[cursor];
+void bc_health_track_reset(bc_health_track_t *t)
+{
+    memset(t, 0, sizeof(*t));
+}
 
-        /* Write condition byte */
-        bc_buf_write_u8(&fb, encode_condition(
-            ship->subsystem_hp[e->hp_index], e->max_condition));
+void bc_health_track_note(bc_health_track_t *t, const bc_ship_journal_t *j)
+{
+    t->dirty_subsys |= j->subsys_damaged | j->subsys_repaired;
+    if (j->changed & BC_SHIP_CHG_POWER) t->dirty_power = true;
+}
 
-        /* Write children condition bytes */
-        for (int c = 0; c < e->child_count; c++) {
-            bc_buf_write_u8(&fb, encode_condition(
-                ship->subsystem_hp[e->child_hp_index[c]],
-                e->child_max_condition[c]));
-        }
+/* Subsystems whose HP an entry's bytes carry. */
+static u64 health_entry_mask(const bc_ss_entry_t *e)
+{
+    u64 m = (u64)1 << e->hp_index;
+    for (int c = 0; c < e->child_count; c++)
+        m |= (u64)1 << e->child_hp_index[c];
+    return m;
+}
 
-        /* Format-specific extras.
-         * Consecutive Powered entries share their has_power_data bits
-         * in a single [count:3][values:5] byte.  Only reset bit_count
-         * when transitioning OUT of the Powered format (Base or Power). */
-        if (e->format == BC_SS_FORMAT_POWERED) {
-            if (is_own_ship) {
-                /* Owner's client has local power state; send false
-                 * (no power_pct byte follows). */
-                bc_buf_write_bit(&fb, false);
-            } else {
-                /* Remote observers need the power allocation data.
-                 * Sign-bit encoding: positive = ON, negative = OFF.
-                 * Disabled subsystem at pct%: write -(i8)pct so the
-                 * client recovers both the slider position and the
-                 * off state.  See power-system.md §Sign Bit. */
-                bc_buf_write_bit(&fb, true);
-                u8 pct = ship->power_pct[cursor];
-                if (!ship->subsys_enabled[cursor])
-                    pct = (u8)(-(i8)pct);
-                bc_buf_write_u8(&fb, pct);
-            }
-        } else if (e->format == BC_SS_FORMAT_POWER) {
-            /* Non-Powered entry: flush any accumulated Powered bits */
-            fb.bit_count = 0;
-            /* Battery percentages: truncate(current / limit * 255) */
-            u8 main_pct = (cls->main_battery_limit > 0.0f)
-                ? (u8)(ship->main_battery / cls->main_battery_limit * 255.0f)
-                : 0;
-            u8 backup_pct = (cls->backup_battery_limit > 0.0f)
-                ? (u8)(ship->backup_battery / cls->backup_battery_limit * 255.0f)
-                : 0;
-            bc_buf_write_u8(&fb, main_pct);
-            bc_buf_write_u8(&fb, backup_pct);
-        } else {
-            /* BC_SS_FORMAT_BASE: flush any accumulated Powered bits */
-            fb.bit_count = 0;
+/* Re-sign the entries the journal marks dirty; those whose bytes moved
+ * since the last look get a new recency stamp. First call after reset
+ * primes everything as already sent (ObjCreateTeam carried the initial
+ * state). */
+static void health_track_observe(bc_health_track_t *t,
+                                 const bc_ship_state_t *ship,
+                                 const bc_ship_class_t *cls)
+{
+    int count = cls->ser_list.count;
+    if (count > BC_SS_MAX_ENTRIES) count = BC_SS_MAX_ENTRIES;
+
+    bc_health_track_note(t, &ship->journal);
+    if (t->primed && t->dirty_subsys == 0 && !t->dirty_power) return;
+
+    for (int i = 0; i < count; i++) {
+        const bc_ss_entry_t *e = &cls->ser_list.entries[i];
+        if (!t->primed) {
+            u32 sig = health_entry_sig(ship, cls, i);
+            t->seen_sig[i] = sig;
+            t->sent_sig[i] = sig;
+            t->stamp[i] = 0;
+            continue;
         }
+        bool dirty = (health_entry_mask(e) & t->dirty_subsys) != 0 ||
+                     (t->dirty_power && e->format != BC_SS_FORMAT_BASE);
+        if (!dirty) continue;
+        u32 sig = health_entry_sig(ship, cls, i);
+        if (sig != t->seen_sig[i]) {
+            t->seen_sig[i] = sig;
+            t->stamp[i] = ++t->seq;
+        }
+    }
+    t->dirty_subsys = 0;
+    t->dirty_power = false;
+    t->primed = true;
+}
 
-        /* Advance cursor */
-        cursor++;
-        if (cursor >= sl->count) cursor = 0;
-
-        /* Stop conditions */
-        if (cursor == initial) break; /* full cycle */
-
-        if (!first && (int)fb.pos >= 10) break; /* budget exhausted */
-        first = false;
+u8 bc_health_track_pick(bc_health_track_t *t,
+                        const bc_ship_state_t *ship,
+                        const bc_ship_class_t *cls,
+                        u8 rr_idx, bool urgent, bool *priority)
+{
+    *priority = false;
+    if (cls->ser_list.count <= 0) return rr_idx;
+
+    health_track_observe(t, ship, cls);
+
+    /* Periodic windows alternate with the round-robin so a subsystem that
+     * changes every tick (repair) cannot starve the rest of the list. */
+    bool allow = urgent || !t->last_priority;
+
+    int best = -1;
+    if (allow) {
+        int count = cls->ser_list.count;
+        if (count > BC_SS_MAX_ENTRIES) count = BC_SS_MAX_ENTRIES;
+        for (int i = 0; i < count; i++) {
+            if (t->seen_sig[i] == t->sent_sig[i]) continue;
+            if (best < 0 || t->stamp[i] > t->stamp[best]) best = i;
+        }
     }
 
-    *next_idx = (u8)cursor;
+    if (!urgent) t->last_priority = (best >= 0);
+    if (best < 0) return rr_idx;
+    *priority = true;
+    return (u8)best;
+}
 
-    return bc_build_state_update(buf, buf_size,
-                                  ship->object_id, game_time, 0x20,
-                                  field, (int)fb.pos);
+void bc_health_track_sent(bc_health_track_t *t,
+                          const bc_ship_class_t *cls,
+                          u8 start_idx, int covered)
+{
+    int count = cls->ser_list.count;
+    if (count > BC_SS_MAX_ENTRIES) count = BC_SS_MAX_ENTRIES;
+    if (count <= 0 || (int)start_idx >= count) return;
+    if (covered > count) covered = count;
+
+    int idx = (int)start_idx;
+    for (int n = 0; n < covered; n++) {
+        t->sent_sig[idx] = t->seen_sig[idx];
+        if (++idx >= count) idx = 0;
+    }
 }
 
 /* --- Reactor / power simulation --- */
@@ -142,6 +333,7 @@ void bc_ship_power_tick(bc_ship_state_t *ship,
 
         /* Fill main battery first, overflow to backup */
         f32 main_before = ship->main_battery;
+        f32 backup_before = ship->backup_battery;
         ship->main_battery += generated;
         if (ship->main_battery > cls->main_battery_limit)
             ship->main_battery = cls->main_battery_limit;
@@ -152,6 +344,9 @@ void bc_ship_power_tick(bc_ship_state_t *ship,
             if (ship->backup_battery > cls->backup_battery_limit)
                 ship->backup_battery = cls->backup_battery_limit;
         }
+        if (ship->main_battery != main_before ||
+            ship->backup_battery != backup_before)
+            ship->journal.changed |= BC_SHIP_CHG_POWER;
 
         /* Recompute conduit limits */
         ship->main_conduit_remaining = cls->main_conduit_capacity * condition_pct;
@@ -80,7 +80,7 @@ void bc_torpedo_tick(bc_torpedo_mgr_t *mgr, f32 dt,
                 if (dist < hit_radius) {
                     /* HIT */
                     if (on_hit) {
-                        on_hit(t->shooter_slot, t->target_id,
+                        on_hit(t->shooter_slot, t->shooter_id, t->target_id,
                                t->damage, t->damage_radius,
                                t->pos, user_data);
                     }
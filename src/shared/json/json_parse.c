@@ -2,13 +2,109 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* --- Arena --- */
+
+/* Arena documents live in a chain of chunks. The first chunk's first
+ * allocation is always the root value, so json_free can find the chain
+ * from the root alone. */
+typedef struct json_chunk {
+    struct json_chunk *next;
+    size_t             used;
+    size_t             cap;
+    max_align_t        data[];
+} json_chunk_t;
+
+#define JSON_CHUNK_MIN  4096
+
+/* Everything in the arena (values, item and member vectors) needs at most
+ * a value's alignment; chunk data itself is max-aligned. */
+#define JSON_ALIGN          _Alignof(json_value_t)
+#define JSON_ROUND(n)       (((n) + JSON_ALIGN - 1) & ~(size_t)(JSON_ALIGN - 1))
+
+static json_chunk_t *chunk_new(size_t cap)
+{
+    if (cap < JSON_CHUNK_MIN) cap = JSON_CHUNK_MIN;
+    json_chunk_t *c = malloc(sizeof(json_chunk_t) + cap);
+    if (!c) return NULL;
+    c->next = NULL;
+    c->used = 0;
+    c->cap  = cap;
+    return c;
+}
+
+static void chunks_free(json_chunk_t *c)
+{
+    while (c) {
+        json_chunk_t *next = c->next;
+        free(c);
+        c = next;
+    }
+}
 
 /* --- Tokenizer --- */
 
 typedef struct {
-    const char *pos;
+    const char   *pos;
+
+    /* Arena mode only (head == NULL in heap mode) */
+    json_chunk_t *head;
+    json_chunk_t *cur;
+
+    /* Scratch stack: a container's children collect here until it closes,
+     * then move to one exact-size vector. Shared by every nesting level. */
+    u8           *stack;
+    size_t        top;
+    size_t        stack_cap;
 } parser_t;
 
+static void *arena_alloc(parser_t *p, size_t size)
+{
+    size = JSON_ROUND(size);
+    json_chunk_t *c = p->cur;
+    if (c->cap - c->used < size) {
+        /* New chunks go after the head so the root stays first */
+        json_chunk_t *n = chunk_new(size > c->cap * 2 ? size : c->cap * 2);
+        if (!n) return NULL;
+        n->next = p->head->next;
+        p->head->next = n;
+        p->cur = c = n;
+    }
+    void *mem = (u8 *)c->data + c->used;
+    c->used += size;
+    return mem;
+}
+
+static bool stack_push(parser_t *p, const void *item, size_t size)
+{
+    if (p->stack_cap - p->top < size) {
+        size_t cap = p->stack_cap ? p->stack_cap * 2 : 256;
+        while (cap - p->top < size) cap *= 2;
+        u8 *tmp = realloc(p->stack, cap);
+        if (!tmp) return false;
+        p->stack = tmp;
+        p->stack_cap = cap;
+    }
+    memcpy(p->stack + p->top, item, size);
+    p->top += size;
+    return true;
+}
+
+/* Move everything pushed since mark into one vector (NULL when empty). */
+static void *stack_pop_vector(parser_t *p, size_t mark, bool *ok)
+{
+    size_t bytes = p->top - mark;
+    *ok = true;
+    if (bytes == 0) return NULL;
+    void *vec = p->head ? arena_alloc(p, bytes) : malloc(bytes);
+    if (!vec) { *ok = false; return NULL; }
+    memcpy(vec, p->stack + mark, bytes);
+    p->top = mark;
+    return vec;
+}
+
 static void skip_ws(parser_t *p)
 {
     while (*p->pos && isspace((unsigned char)*p->pos)) p->pos++;
@@ -21,14 +117,44 @@ static bool match_str(parser_t *p, const char *s)
     return false;
 }
 
+static char unescape(char c)
+{
+    switch (c) {
+        case 'n':  return '\n';
+        case 't':  return '\t';
+        case 'r':  return '\r';
+        default:   return c;    /* '"', '\\', '/' and anything else */
+    }
+}
+
 /* Parse a JSON string (expects opening " already consumed or about to be).
- * Returns malloc'd string or NULL on error. */
+ * Heap mode returns a malloc'd copy. Arena mode unescapes in place and
+ * NUL-terminates over the closing quote. NULL on error. */
 static char *parse_string_raw(parser_t *p)
 {
     skip_ws(p);
     if (*p->pos != '"') return NULL;
     p->pos++; /* skip opening " */
 
+    if (p->head) {
+        char *out = (char *)p->pos;   /* arena mode: text is mutable */
+        char *w = out;
+        const char *r = p->pos;
+        while (*r && *r != '"') {
+            if (*r == '\\') {
+                r++;
+                if (!*r) return NULL;
+                *w++ = unescape(*r++);
+            } else {
+                *w++ = *r++;
+            }
+        }
+        if (*r != '"') return NULL;
+        p->pos = r + 1;
+        *w = '\0';
+        return out;
+    }
+
     /* Find length first (simple: no unicode escapes) */
     const char *start = p->pos;
     size_t len = 0;
@@ -47,15 +173,7 @@ static char *parse_string_raw(parser_t *p)
     while (*p->pos != '"') {
         if (*p->pos == '\\') {
             p->pos++;
-            switch (*p->pos) {
-                case '"':  result[i++] = '"';  break;
-                case '\\': result[i++] = '\\'; break;
-                case '/':  result[i++] = '/';  break;
-                case 'n':  result[i++] = '\n'; break;
-                case 't':  result[i++] = '\t'; break;
-                case 'r':  result[i++] = '\r'; break;
-                default:   result[i++] = *p->pos; break;
-            }
+            result[i++] = unescape(*p->pos);
         } else {
             result[i++] = *p->pos;
         }
@@ -66,22 +184,42 @@ static char *parse_string_raw(parser_t *p)
     return result;
 }
 
+static void free_string(parser_t *p, char *s)
+{
+    if (!p->head) free(s);
+}
+
 /* Forward declaration */
 static json_value_t *parse_value(parser_t *p);
 
-static json_value_t *alloc_value(json_type_t type)
+static json_value_t *alloc_value(parser_t *p, json_type_t type)
 {
-    json_value_t *v = calloc(1, sizeof(json_value_t));
-    if (v) v->type = type;
+    json_value_t *v;
+    if (p->head) {
+        v = arena_alloc(p, sizeof(json_value_t));
+        if (!v) return NULL;
+        memset(v, 0, sizeof(*v));
+        v->arena = JSON_ARENA_NODE;
+    } else {
+        v = calloc(1, sizeof(json_value_t));
+        if (!v) return NULL;
+    }
+    v->type = type;
     return v;
 }
 
+/* Heap mode error path: a node that never made it into a tree. */
+static void discard_value(parser_t *p, json_value_t *v)
+{
+    if (!p->head) json_free(v);
+}
+
 static json_value_t *parse_string(parser_t *p)
 {
     char *s = parse_string_raw(p);
     if (!s) return NULL;
-    json_value_t *v = alloc_value(JSON_STRING);
-    if (!v) { free(s); return NULL; }
+    json_value_t *v = alloc_value(p, JSON_STRING);
+    if (!v) { free_string(p, s); return NULL; }
     v->string = s;
     return v;
 }
@@ -92,87 +230,114 @@ static json_value_t *parse_number(parser_t *p)
     double d = strtod(p->pos, &end);
     if (end == p->pos) return NULL;
     p->pos = end;
-    json_value_t *v = alloc_value(JSON_NUMBER);
+    json_value_t *v = alloc_value(p, JSON_NUMBER);
     if (!v) return NULL;
     v->number = d;
     return v;
 }
 
+/* Drop the children of a failed container still on the scratch stack. */
+static void unwind_items(parser_t *p, size_t mark)
+{
+    if (!p->head) {
+        for (size_t at = mark; at < p->top; at += sizeof(json_value_t *)) {
+            json_value_t *item;
+            memcpy(&item, p->stack + at, sizeof(item));
+            json_free(item);
+        }
+    }
+    p->top = mark;
+}
+
+static void unwind_members(parser_t *p, size_t mark)
+{
+    if (!p->head) {
+        for (size_t at = mark; at < p->top; at += sizeof(json_member_t)) {
+            json_member_t m;
+            memcpy(&m, p->stack + at, sizeof(m));
+            free(m.key);
+            json_free(m.value);
+        }
+    }
+    p->top = mark;
+}
+
 static json_value_t *parse_array(parser_t *p)
 {
     /* Opening [ already consumed */
-    json_value_t *v = alloc_value(JSON_ARRAY);
+    json_value_t *v = alloc_value(p, JSON_ARRAY);
     if (!v) return NULL;
 
-    size_t cap = 8;
-    v->array.items = malloc(cap * sizeof(json_value_t *));
-    v->array.count = 0;
-    if (!v->array.items) { free(v); return NULL; }
-
     skip_ws(p);
     if (*p->pos == ']') { p->pos++; return v; }
 
+    size_t mark = p->top;
     for (;;) {
         json_value_t *item = parse_value(p);
-        if (!item) { json_free(v); return NULL; }
-
-        if (v->array.count >= cap) {
-            cap *= 2;
-            json_value_t **tmp = realloc(v->array.items, cap * sizeof(json_value_t *));
-            if (!tmp) { json_free(item); json_free(v); return NULL; }
-            v->array.items = tmp;
-        }
-        v->array.items[v->array.count++] = item;
+        if (!item) break;
+        if (!stack_push(p, &item, sizeof(item))) { discard_value(p, item); break; }
 
         skip_ws(p);
         if (*p->pos == ',') { p->pos++; continue; }
-        if (*p->pos == ']') { p->pos++; return v; }
-        json_free(v);
-        return NULL;
+        if (*p->pos != ']') break;
+        p->pos++;
+
+        size_t count = (p->top - mark) / sizeof(json_value_t *);
+        bool ok;
+        json_value_t **items = stack_pop_vector(p, mark, &ok);
+        if (!ok) break;
+        v->array.items = items;
+        v->array.count = count;
+        return v;
     }
+    unwind_items(p, mark);
+    discard_value(p, v);
+    return NULL;
 }
 
 static json_value_t *parse_object(parser_t *p)
 {
     /* Opening { already consumed */
-    json_value_t *v = alloc_value(JSON_OBJECT);
+    json_value_t *v = alloc_value(p, JSON_OBJECT);
     if (!v) return NULL;
 
-    size_t cap = 8;
-    v->object.members = malloc(cap * sizeof(json_member_t));
-    v->object.count = 0;
-    if (!v->object.members) { free(v); return NULL; }
-
     skip_ws(p);
     if (*p->pos == '}') { p->pos++; return v; }
 
+    size_t mark = p->top;
     for (;;) {
-        char *key = parse_string_raw(p);
-        if (!key) { json_free(v); return NULL; }
+        json_member_t m;
+        m.key = parse_string_raw(p);
+        if (!m.key) break;
 
         skip_ws(p);
-        if (*p->pos != ':') { free(key); json_free(v); return NULL; }
+        if (*p->pos != ':') { free_string(p, m.key); break; }
         p->pos++;
 
-        json_value_t *val = parse_value(p);
-        if (!val) { free(key); json_free(v); return NULL; }
-
-        if (v->object.count >= cap) {
-            cap *= 2;
-            json_member_t *tmp = realloc(v->object.members, cap * sizeof(json_member_t));
-            if (!tmp) { free(key); json_free(val); json_free(v); return NULL; }
-            v->object.members = tmp;
+        m.value = parse_value(p);
+        if (!m.value) { free_string(p, m.key); break; }
+        if (!stack_push(p, &m, sizeof(m))) {
+            free_string(p, m.key);
+            discard_value(p, m.value);
+            break;
         }
-        v->object.members[v->object.count].key = key;
-        v->object.members[v->object.count].value = val;
-        v->object.count++;
 
         skip_ws(p);
         if (*p->pos == ',') { p->pos++; continue; }
-        if (*p->pos == '}') { p->pos++; return v; }
-        json_free(v);
-        return NULL;
+        if (*p->pos != '}') break;
+        p->pos++;
+
+        size_t count = (p->top - mark) / sizeof(json_member_t);
+        bool ok;
+        json_member_t *members = stack_pop_vector(p, mark, &ok);
+        if (!ok) break;
+        v->object.members = members;
+        v->object.count = count;
+        return v;
     }
+    unwind_members(p, mark);
+    discard_value(p, v);
+    return NULL;
 }
 
 static json_value_t *parse_value(parser_t *p)
@@ -190,20 +355,20 @@ static json_value_t *parse_value(parser_t *p)
         return parse_array(p);
     case 't':
         if (match_str(p, "true")) {
-            json_value_t *v = alloc_value(JSON_BOOL);
+            json_value_t *v = alloc_value(p, JSON_BOOL);
             if (v) v->boolean = true;
             return v;
         }
         return NULL;
     case 'f':
         if (match_str(p, "false")) {
-            json_value_t *v = alloc_value(JSON_BOOL);
+            json_value_t *v = alloc_value(p, JSON_BOOL);
             if (v) v->boolean = false;
             return v;
         }
         return NULL;
     case 'n':
-        if (match_str(p, "null")) return alloc_value(JSON_NULL);
+        if (match_str(p, "null")) return alloc_value(p, JSON_NULL);
         return NULL;
     default:
         if (*p->pos == '-' || isdigit((unsigned char)*p->pos))
@@ -212,18 +377,91 @@ static json_value_t *parse_value(parser_t *p)
     }
 }
 
+/* Parse text in place into an arena whose first chunk is head, with the
+ * root slot already reserved at head->data. Consumes head. */
+static json_value_t *parse_into_arena(json_chunk_t *head, char *text)
+{
+    parser_t p;
+    memset(&p, 0, sizeof(p));
+    p.pos  = text;
+    p.head = head;
+    p.cur  = head;
+
+    json_value_t *parsed = parse_value(&p);
+    free(p.stack);
+    if (!parsed) {
+        chunks_free(head);
+        return NULL;
+    }
+
+    json_value_t *root = (json_value_t *)head->data;
+    *root = *parsed;
+    root->arena = JSON_ARENA_ROOT;
+    return root;
+}
+
 /* --- Public API --- */
 
 json_value_t *json_parse(const char *text)
 {
-    parser_t p = { .pos = text };
+    parser_t p;
+    memset(&p, 0, sizeof(p));
+    p.pos = text;
     json_value_t *root = parse_value(&p);
+    free(p.stack);
     return root;
 }
 
+/* Arena sizing: nodes take a few times the bytes of the text they came
+ * from in dense JSON, less in indented files. Anything beyond this first
+ * guess goes into further (doubling) chunks. */
+static size_t arena_estimate(size_t text_len)
+{
+    return sizeof(json_value_t) + text_len * 2;
+}
+
+json_value_t *json_parse_insitu(char *text)
+{
+    json_chunk_t *head = chunk_new(arena_estimate(strlen(text)));
+    if (!head) return NULL;
+    head->used = JSON_ROUND(sizeof(json_value_t));
+    return parse_into_arena(head, text);
+}
+
+json_value_t *json_load_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) { fclose(f); return NULL; }
+
+    /* [root slot][text][nodes...] in one allocation */
+    size_t root_slot = JSON_ROUND(sizeof(json_value_t));
+    size_t text_size = JSON_ROUND((size_t)size + 1);
+    json_chunk_t *head = chunk_new(root_slot + text_size +
+                                   arena_estimate((size_t)size));
+    if (!head) { fclose(f); return NULL; }
+
+    char *text = (char *)head->data + root_slot;
+    size_t nread = fread(text, 1, (size_t)size, f);
+    fclose(f);
+    text[nread] = '\0';
+    head->used = root_slot + text_size;
+    return parse_into_arena(head, text);
+}
+
 void json_free(json_value_t *val)
 {
     if (!val) return;
+    if (val->arena == JSON_ARENA_ROOT) {
+        chunks_free((json_chunk_t *)((u8 *)val - offsetof(json_chunk_t, data)));
+        return;
+    }
+    if (val->arena == JSON_ARENA_NODE) return;
+
     switch (val->type) {
     case JSON_STRING:
         free(val->string);
@@ -246,6 +484,406 @@ void json_free(json_value_t *val)
     free(val);
 }
 
+/* --- Streaming reader --- */
+
+/* What the reader expects next */
+enum {
+    RD_VALUE,          /* a value (after ':' or ',' in an array) */
+    RD_VALUE_OR_END,   /* just after '[' */
+    RD_KEY,            /* after ',' in an object */
+    RD_KEY_OR_END,     /* just after '{' */
+    RD_COMMA_OR_END,   /* after a value inside a container */
+    RD_DONE,           /* top-level value complete */
+};
+
+#define RD_IN_OBJECT  1
+#define RD_IN_ARRAY   2
+
+static void rd_reset(json_reader_t *r)
+{
+    memset(r, 0, offsetof(json_reader_t, window));
+    r->line  = 1;
+    r->state = RD_VALUE;
+}
+
+void json_reader_init(json_reader_t *r, const char *text)
+{
+    rd_reset(r);
+    r->src = text;
+    r->src_len = strlen(text);
+}
+
+bool json_reader_open(json_reader_t *r, const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    rd_reset(r);
+    r->file = f;
+    r->src  = r->window;
+    return true;
+}
+
+void json_reader_close(json_reader_t *r)
+{
+    if (r->file) fclose(r->file);
+    r->file = NULL;
+    free(r->str);
+    r->str = NULL;
+    r->str_cap = 0;
+}
+
+/* Current character without consuming it; 0 at end of input. */
+static int rd_peek(json_reader_t *r)
+{
+    if (r->at >= r->src_len) {
+        if (!r->file) return 0;
+        r->src_len = fread(r->window, 1, sizeof(r->window), r->file);
+        r->at = 0;
+        if (r->src_len == 0) return 0;
+    }
+    return (unsigned char)r->src[r->at];
+}
+
+/* Consume the character rd_peek just returned (non-zero). */
+static void rd_advance(json_reader_t *r)
+{
+    if (r->src[r->at] == '\n') r->line++;
+    r->at++;
+}
+
+static int rd_get(json_reader_t *r)
+{
+    int c = rd_peek(r);
+    if (c) rd_advance(r);
+    return c;
+}
+
+/* isspace() in the C locale, without the call */
+static int rd_is_space(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static int rd_is_num(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+           c == 'e' || c == 'E';
+}
+
+/* Whitespace, string and number runs are scanned a window span at a time. */
+static void rd_skip_ws(json_reader_t *r)
+{
+    while (rd_peek(r)) {
+        const char *p = r->src + r->at;
+        const char *end = r->src + r->src_len;
+        while (p < end && rd_is_space(*p)) {
+            if (*p == '\n') r->line++;
+            p++;
+        }
+        r->at = (size_t)(p - r->src);
+        if (p < end) return;
+    }
+}
+
+static json_tok_t rd_fail(json_reader_t *r)
+{
+    r->error = true;
+    return JSON_TOK_ERROR;
+}
+
+/* Append n bytes to str, keeping room for the terminator. */
+static bool rd_str_put(json_reader_t *r, const char *p, size_t n)
+{
+    if (r->str_len + n + 1 > r->str_cap) {
+        size_t cap = r->str_cap ? r->str_cap : 128;
+        while (r->str_len + n + 1 > cap) cap *= 2;
+        char *tmp = realloc(r->str, cap);
+        if (!tmp) return false;
+        r->str = tmp;
+        r->str_cap = cap;
+    }
+    memcpy(r->str + r->str_len, p, n);
+    r->str_len += n;
+    return true;
+}
+
+/* Opening quote already consumed. */
+static bool rd_string(json_reader_t *r)
+{
+    r->str_len = 0;
+    for (;;) {
+        if (!rd_peek(r)) return false;
+        const char *p = r->src + r->at;
+        const char *end = r->src + r->src_len;
+        const char *q = p;
+        while (q < end && *q != '"' && *q != '\\' && *q != '\0') {
+            if (*q == '\n') r->line++;
+            q++;
+        }
+        if (q > p) {
+            if (!rd_str_put(r, p, (size_t)(q - p))) return false;
+            r->at += (size_t)(q - p);
+            continue;
+        }
+
+        int c = rd_get(r);
+        if (c == 0) return false;
+        if (c == '"') break;
+        if (c == '\\') {
+            c = rd_get(r);
+            if (c == 0) return false;
+            c = unescape((char)c);
+        }
+        char ch = (char)c;
+        if (!rd_str_put(r, &ch, 1)) return false;
+    }
+    if (!rd_str_put(r, "", 0)) return false;
+    r->str[r->str_len] = '\0';
+    return true;
+}
+
+static bool rd_number(json_reader_t *r)
+{
+    char buf[64];
+    size_t n = 0;
+    while (rd_peek(r)) {
+        const char *p = r->src + r->at;
+        const char *end = r->src + r->src_len;
+        const char *q = p;
+        while (q < end && rd_is_num(*q)) q++;
+        size_t k = (size_t)(q - p);
+        if (n + k >= sizeof(buf)) return false;
+        memcpy(buf + n, p, k);
+        n += k;
+        r->at += k;
+        if (q < end) break;
+    }
+    buf[n] = '\0';
+    char *end;
+    r->number = strtod(buf, &end);
+    return n > 0 && end == buf + n;
+}
+
+static bool rd_literal(json_reader_t *r, const char *word)
+{
+    for (; *word; word++)
+        if (rd_get(r) != *word) return false;
+    return true;
+}
+
+static void rd_after_value(json_reader_t *r)
+{
+    r->state = r->depth == 0 ? RD_DONE : RD_COMMA_OR_END;
+}
+
+static json_tok_t rd_open(json_reader_t *r, u8 kind)
+{
+    if (r->depth >= JSON_READER_MAX_DEPTH) return rd_fail(r);
+    rd_advance(r);
+    r->stack[r->depth++] = kind;
+    if (kind == RD_IN_OBJECT) {
+        r->state = RD_KEY_OR_END;
+        return JSON_TOK_OBJECT;
+    }
+    r->state = RD_VALUE_OR_END;
+    return JSON_TOK_ARRAY;
+}
+
+/* c must close the innermost container. */
+static json_tok_t rd_close(json_reader_t *r, int c)
+{
+    if (r->depth == 0) return rd_fail(r);
+    u8 kind = r->stack[r->depth - 1];
+    if (!(c == '}' && kind == RD_IN_OBJECT) && !(c == ']' && kind == RD_IN_ARRAY))
+        return rd_fail(r);
+    rd_advance(r);
+    r->depth--;
+    rd_after_value(r);
+    return kind == RD_IN_OBJECT ? JSON_TOK_OBJECT_END : JSON_TOK_ARRAY_END;
+}
+
+static json_tok_t rd_value(json_reader_t *r, int c)
+{
+    json_tok_t t;
+    switch (c) {
+    case '{':
+        return rd_open(r, RD_IN_OBJECT);
+    case '[':
+        return rd_open(r, RD_IN_ARRAY);
+    case '"':
+        rd_advance(r);
+        if (!rd_string(r)) return rd_fail(r);
+        t = JSON_TOK_STRING;
+        break;
+    case 't':
+    case 'f':
+        r->boolean = c == 't';
+        if (!rd_literal(r, r->boolean ? "true" : "false")) return rd_fail(r);
+        t = JSON_TOK_BOOL;
+        break;
+    case 'n':
+        if (!rd_literal(r, "null")) return rd_fail(r);
+        t = JSON_TOK_NULL;
+        break;
+    default:
+        if (c != '-' && !isdigit(c)) return rd_fail(r);
+        if (!rd_number(r)) return rd_fail(r);
+        t = JSON_TOK_NUMBER;
+        break;
+    }
+    rd_after_value(r);
+    return t;
+}
+
+static json_tok_t rd_key(json_reader_t *r, int c)
+{
+    if (c != '"') return rd_fail(r);
+    rd_advance(r);
+    if (!rd_string(r)) return rd_fail(r);
+    rd_skip_ws(r);
+    if (rd_get(r) != ':') return rd_fail(r);
+    r->state = RD_VALUE;
+    return JSON_TOK_KEY;
+}
+
+json_tok_t json_reader_next(json_reader_t *r)
+{
+    if (r->error) return JSON_TOK_ERROR;
+    for (;;) {
+        rd_skip_ws(r);
+        int c = rd_peek(r);
+        switch (r->state) {
+        case RD_DONE:
+            return JSON_TOK_END;
+        case RD_COMMA_OR_END:
+            if (c != ',') return rd_close(r, c);
+            rd_advance(r);
+            r->state = r->stack[r->depth - 1] == RD_IN_OBJECT ? RD_KEY : RD_VALUE;
+            continue;
+        case RD_KEY_OR_END:
+            return c == '}' ? rd_close(r, c) : rd_key(r, c);
+        case RD_KEY:
+            return rd_key(r, c);
+        case RD_VALUE_OR_END:
+            return c == ']' ? rd_close(r, c) : rd_value(r, c);
+        default:
+            return rd_value(r, c);
+        }
+    }
+}
+
+/* t was just read: consume the rest of its value. */
+static bool rd_finish(json_reader_t *r, json_tok_t t)
+{
+    switch (t) {
+    case JSON_TOK_STRING:
+    case JSON_TOK_NUMBER:
+    case JSON_TOK_BOOL:
+    case JSON_TOK_NULL:
+        return true;
+    case JSON_TOK_OBJECT:
+    case JSON_TOK_ARRAY: {
+        int depth = 1;
+        while (depth > 0) {
+            t = json_reader_next(r);
+            if (t == JSON_TOK_OBJECT || t == JSON_TOK_ARRAY) depth++;
+            else if (t == JSON_TOK_OBJECT_END || t == JSON_TOK_ARRAY_END) depth--;
+            else if (t == JSON_TOK_ERROR || t == JSON_TOK_END) return false;
+        }
+        return true;
+    }
+    default:
+        /* Not at a value: the caller lost its place */
+        r->error = true;
+        return false;
+    }
+}
+
+bool json_reader_skip(json_reader_t *r)
+{
+    return rd_finish(r, json_reader_next(r));
+}
+
+bool json_reader_begin_object(json_reader_t *r)
+{
+    json_tok_t t = json_reader_next(r);
+    if (t == JSON_TOK_OBJECT) return true;
+    rd_finish(r, t);
+    return false;
+}
+
+bool json_reader_begin_array(json_reader_t *r)
+{
+    json_tok_t t = json_reader_next(r);
+    if (t == JSON_TOK_ARRAY) return true;
+    rd_finish(r, t);
+    return false;
+}
+
+bool json_reader_key(json_reader_t *r)
+{
+    json_tok_t t = json_reader_next(r);
+    if (t == JSON_TOK_KEY) return true;
+    if (t != JSON_TOK_OBJECT_END) r->error = true;
+    return false;
+}
+
+bool json_reader_item(json_reader_t *r)
+{
+    if (r->error) return false;
+    rd_skip_ws(r);
+    int c = rd_peek(r);
+    if (r->state == RD_VALUE_OR_END ||
+        (r->state == RD_COMMA_OR_END && r->stack[r->depth - 1] == RD_IN_ARRAY)) {
+        if (c == ']') {
+            rd_close(r, c);
+            return false;
+        }
+        if (r->state == RD_COMMA_OR_END) {
+            if (c != ',') {
+                rd_fail(r);
+                return false;
+            }
+            rd_advance(r);
+        }
+        r->state = RD_VALUE;
+        return true;
+    }
+    r->error = true;
+    return false;
+}
+
+bool json_reader_number(json_reader_t *r, double *out)
+{
+    json_tok_t t = json_reader_next(r);
+    if (t == JSON_TOK_NUMBER) { *out = r->number; return true; }
+    rd_finish(r, t);
+    return false;
+}
+
+bool json_reader_bool(json_reader_t *r, bool *out)
+{
+    json_tok_t t = json_reader_next(r);
+    if (t == JSON_TOK_BOOL) { *out = r->boolean; return true; }
+    rd_finish(r, t);
+    return false;
+}
+
+bool json_reader_string(json_reader_t *r, char *dst, size_t dst_size)
+{
+    json_tok_t t = json_reader_next(r);
+    if (t != JSON_TOK_STRING) {
+        rd_finish(r, t);
+        return false;
+    }
+    if (dst_size > 0) {
+        size_t n = r->str_len < dst_size - 1 ? r->str_len : dst_size - 1;
+        memcpy(dst, r->str, n);
+        dst[n] = '\0';
+    }
+    return true;
+}
+
 json_value_t *json_get(const json_value_t *obj, const char *key)
 {
     if (!obj || obj->type != JSON_OBJECT) return NULL;
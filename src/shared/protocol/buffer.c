@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
 
 void bc_buf_init(bc_buffer_t *buf, u8 *data, size_t capacity)
 {
@@ -227,60 +228,107 @@ bool bc_buf_read_bit(bc_buffer_t *buf, bool *out)
 #define CF16_BASE  0.001f
 #define CF16_MULT  10.0f
 
+/* Decade bounds as the original threshold walk produces them: BASE times
+ * MULT, rounded to f32 at every step (hence 1.00000012, not 1.0). Scale s
+ * covers [cf16_lo[s], cf16_lo[s] + cf16_span[s]). */
+static const f32 cf16_lo[8] = {
+    0.0f,            0x1.0624dep-10f, 0x1.47ae16p-7f,  0x1.99999cp-4f,
+    0x1.000002p+0f,  0x1.400002p+3f,  0x1.900002p+6f,  0x1.f40002p+9f,
+};
+static const f32 cf16_hi[8] = {
+    0x1.0624dep-10f, 0x1.47ae16p-7f,  0x1.99999cp-4f,  0x1.000002p+0f,
+    0x1.400002p+3f,  0x1.900002p+6f,  0x1.f40002p+9f,  0x1.388002p+13f,
+};
+static const f32 cf16_span[8] = {   /* cf16_hi[s] - cf16_lo[s] in f32 */
+    0x1.0624dep-10f, 0x1.26e97ap-7f,  0x1.70a3dap-4f,  0x1.ccccdp-1f,
+    0x1.200002p+3f,  0x1.680002p+6f,  0x1.c20002p+9f,  0x1.194002p+13f,
+};
+
 u16 bc_cf16_encode(f32 value)
 {
-    u32 sign_flag = 0;
-    if (value < 0.0f) {
-        sign_flag = 8;
-        value = -value;
-    }
+    u32 sign = value < 0.0f ? 0x8000u : 0u;
+    f32 mag  = value < 0.0f ? -value : value;
 
-    /* Find scale: smallest s such that value < BASE * MULT^s.
-     * Track both lo (previous threshold) and hi (current threshold)
-     * so we can compute the mantissa relative to the sub-range. */
+    /* Scale = number of bounds at or below mag. NaN fails every compare
+     * and, like +inf, lands on 8: past the top decade. */
     u32 scale = 0;
-    f32 lo = 0.0f;
-    f32 hi = CF16_BASE;
-    while (scale < 8) {
-        if (value < hi) break;
-        lo = hi;
-        hi *= CF16_MULT;
-        scale++;
-    }
+    for (int i = 0; i < 8; i++) scale += !(mag < cf16_hi[i]);
 
-    /* Overflow: clamp to scale=7 max mantissa */
-    if (scale >= 8) {
-        return (u16)((sign_flag | 7) * 0x1000 + 0xFFF);
-    }
+    /* Overflow encodes as scale 7, full mantissa. The substitute keeps
+     * inf/NaN away from the float-to-int conversion. */
+    u32 over = scale >> 3;
+    u32 s = scale - over;
+    f32 v = over ? cf16_lo[7] : mag;
 
-    /* Compute mantissa relative to sub-range [lo, hi).
-     * Matches decode: result = lo + mantissa/4095 * (hi - lo) */
-    f32 range = hi - lo;
-    i32 mantissa = (range > 0.0f) ? (i32)((value - lo) / range * 4095.0f) : 0;
+    /* Mantissa within [lo, hi); decode: lo + mantissa/4095 * (hi - lo) */
+    i32 mantissa = (i32)((v - cf16_lo[s]) / cf16_span[s] * 4095.0f);
     if (mantissa > 0xFFF) mantissa = 0xFFF;
     if (mantissa < 0) mantissa = 0;
+    mantissa |= -(i32)over & 0xFFF;
 
-    return (u16)((sign_flag | scale) * 0x1000 + mantissa);
+    return (u16)(sign | (s << 12) | (u32)mantissa);
 }
 
-f32 bc_cf16_decode(u16 encoded)
+/* The interpolation every decoded value has always come from. The table
+ * below is filled by this exact expression, so it is bit-identical to
+ * calling it on any platform (x87 excess precision included). */
+static f32 cf16_decode_direct(u16 encoded)
 {
     u16 mantissa = encoded & 0xFFF;
-    u8 raw_scale = (u8)(encoded >> 12);
-    bool is_neg = (raw_scale >> 3) & 1;
-    u8 scale = raw_scale & 0x7;
+    u8 scale = (u8)(encoded >> 12) & 0x7;
 
-    /* Compute range boundaries */
     f32 range_lo = 0.0f;
     f32 range_hi = CF16_BASE;
     for (u8 i = 0; i < scale; i++) {
         range_lo = range_hi;
         range_hi *= CF16_MULT;
     }
+    return range_lo + ((f32)mantissa / 4095.0f) * (range_hi - range_lo);
+}
+
+/* Magnitudes for all 32768 sign-less codes (128 KB), built on first use.
+ * One caller builds; anyone arriving meanwhile computes directly. */
+static f32 cf16_table[0x8000];
+static atomic_int cf16_table_state;   /* 0 = empty, 1 = building, 2 = ready */
+
+static const f32 *cf16_decode_table(void)
+{
+    int st = atomic_load_explicit(&cf16_table_state, memory_order_acquire);
+    if (st == 2) return cf16_table;
+    if (st == 0 && atomic_compare_exchange_strong(&cf16_table_state, &st, 1)) {
+        for (u32 e = 0; e < 0x8000; e++)
+            cf16_table[e] = cf16_decode_direct((u16)e);
+        atomic_store_explicit(&cf16_table_state, 2, memory_order_release);
+        return cf16_table;
+    }
+    return NULL;
+}
+
+f32 bc_cf16_decode(u16 encoded)
+{
+    const f32 *t = cf16_decode_table();
+    f32 result = t ? t[encoded & 0x7FFF] : cf16_decode_direct(encoded);
+    return (encoded & 0x8000) ? -result : result;
+}
 
-    /* Interpolate within range */
-    f32 result = range_lo + ((f32)mantissa / 4095.0f) * (range_hi - range_lo);
-    return is_neg ? -result : result;
+void bc_cf16_encode_many(const f32 *values, u16 *out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = bc_cf16_encode(values[i]);
+}
+
+void bc_cf16_decode_many(const u16 *encoded, f32 *out, size_t count)
+{
+    const f32 *t = cf16_decode_table();
+    if (!t) {
+        for (size_t i = 0; i < count; i++)
+            out[i] = bc_cf16_decode(encoded[i]);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        f32 m = t[encoded[i] & 0x7FFF];
+        out[i] = (encoded[i] & 0x8000) ? -m : m;
+    }
 }
 
 bool bc_buf_write_cf16(bc_buffer_t *buf, f32 value)
@@ -288,6 +336,11 @@ bool bc_buf_write_cf16(bc_buffer_t *buf, f32 value)
     return bc_buf_write_u16(buf, bc_cf16_encode(value));
 }
 
+void bc_buf_put_cf16(bc_buffer_t *buf, f32 value)
+{
+    bc_buf_put_u16(buf, bc_cf16_encode(value));
+}
+
 bool bc_buf_read_cf16(bc_buffer_t *buf, f32 *out)
 {
     u16 raw;
@@ -319,6 +372,20 @@ bool bc_buf_write_cv3(bc_buffer_t *buf, f32 x, f32 y, f32 z)
         && bc_buf_write_u8(buf, (u8)dz);
 }
 
+void bc_buf_put_cv3(bc_buffer_t *buf, f32 x, f32 y, f32 z)
+{
+    u8 *p = buf->data + buf->pos;
+    buf->pos += 3;
+    f32 mag = sqrtf(x * x + y * y + z * z);
+    if (mag < 1e-6f) {
+        p[0] = p[1] = p[2] = 0;
+        return;
+    }
+    p[0] = (u8)(i8)(x / mag * 127.0f);
+    p[1] = (u8)(i8)(y / mag * 127.0f);
+    p[2] = (u8)(i8)(z / mag * 127.0f);
+}
+
 bool bc_buf_read_cv3(bc_buffer_t *buf, f32 *x, f32 *y, f32 *z)
 {
     u8 raw_x, raw_y, raw_z;
@@ -338,34 +405,68 @@ bool bc_buf_read_cv3(bc_buffer_t *buf, f32 *x, f32 *y, f32 *z)
  * Decoded: xyz = direction * magnitude.
  */
 
-bool bc_buf_write_cv4(bc_buffer_t *buf, f32 x, f32 y, f32 z)
+/* One CV4 into p[0..4]; the caller has checked the room */
+static void cv4_store(u8 *p, f32 x, f32 y, f32 z)
 {
     f32 mag = sqrtf(x * x + y * y + z * z);
     if (mag < 1e-6f) {
-        return bc_buf_write_u8(buf, 0)
-            && bc_buf_write_u8(buf, 0)
-            && bc_buf_write_u8(buf, 0)
-            && bc_buf_write_u16(buf, 0);
+        memset(p, 0, 5);
+        return;
     }
-    i8 dx = (i8)(x / mag * 127.0f);
-    i8 dy = (i8)(y / mag * 127.0f);
-    i8 dz = (i8)(z / mag * 127.0f);
-    return bc_buf_write_u8(buf, (u8)dx)
-        && bc_buf_write_u8(buf, (u8)dy)
-        && bc_buf_write_u8(buf, (u8)dz)
-        && bc_buf_write_cf16(buf, mag);
+    p[0] = (u8)(i8)(x / mag * 127.0f);
+    p[1] = (u8)(i8)(y / mag * 127.0f);
+    p[2] = (u8)(i8)(z / mag * 127.0f);
+    u16 m = bc_cf16_encode(mag);
+    p[3] = (u8)(m & 0xFF);
+    p[4] = (u8)(m >> 8);
+}
+
+static void cv4_load(const u8 *p, f32 *x, f32 *y, f32 *z)
+{
+    f32 mag = bc_cf16_decode((u16)(p[3] | (p[4] << 8)));
+    *x = (f32)(i8)p[0] / 127.0f * mag;
+    *y = (f32)(i8)p[1] / 127.0f * mag;
+    *z = (f32)(i8)p[2] / 127.0f * mag;
+}
+
+bool bc_buf_write_cv4(bc_buffer_t *buf, f32 x, f32 y, f32 z)
+{
+    if (buf->pos + 5 > buf->capacity) return false;
+    cv4_store(buf->data + buf->pos, x, y, z);
+    buf->pos += 5;
+    return true;
+}
+
+void bc_buf_put_cv4(bc_buffer_t *buf, f32 x, f32 y, f32 z)
+{
+    cv4_store(buf->data + buf->pos, x, y, z);
+    buf->pos += 5;
 }
 
 bool bc_buf_read_cv4(bc_buffer_t *buf, f32 *x, f32 *y, f32 *z)
 {
-    u8 raw_x, raw_y, raw_z;
-    if (!bc_buf_read_u8(buf, &raw_x)) return false;
-    if (!bc_buf_read_u8(buf, &raw_y)) return false;
-    if (!bc_buf_read_u8(buf, &raw_z)) return false;
-    f32 mag;
-    if (!bc_buf_read_cf16(buf, &mag)) return false;
-    *x = (f32)(i8)raw_x / 127.0f * mag;
-    *y = (f32)(i8)raw_y / 127.0f * mag;
-    *z = (f32)(i8)raw_z / 127.0f * mag;
+    if (buf->pos + 5 > buf->capacity) return false;
+    cv4_load(buf->data + buf->pos, x, y, z);
+    buf->pos += 5;
+    return true;
+}
+
+bool bc_buf_write_cv4_many(bc_buffer_t *buf, const f32 *xyz, size_t count)
+{
+    if (count > bc_buf_remaining(buf) / 5) return false;
+    u8 *p = buf->data + buf->pos;
+    for (size_t i = 0; i < count; i++, p += 5, xyz += 3)
+        cv4_store(p, xyz[0], xyz[1], xyz[2]);
+    buf->pos += count * 5;
+    return true;
+}
+
+bool bc_buf_read_cv4_many(bc_buffer_t *buf, f32 *xyz, size_t count)
+{
+    if (count > bc_buf_remaining(buf) / 5) return false;
+    const u8 *p = buf->data + buf->pos;
+    for (size_t i = 0; i < count; i++, p += 5, xyz += 3)
+        cv4_load(p, &xyz[0], &xyz[1], &xyz[2]);
+    buf->pos += count * 5;
     return true;
 }
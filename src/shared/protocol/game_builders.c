@@ -3,6 +3,11 @@
 #include "openbc/opcodes.h"
 #include <string.h>
 
+/* The per-tick builders (torpedo, beam, explosion, state update, score
+ * change) know their size before writing: they reserve it once and use
+ * the unchecked bc_buf_put_* stores. Too small a buffer returns -1 with
+ * nothing written. */
+
 /* Object ID formula:
  * base=0x3FFFFFFF, each slot owns 2^18 (0x40000) consecutive IDs.
  * sub_index selects within the slot's range (0 = primary ship). */
@@ -38,20 +43,23 @@ int bc_build_torpedo_fire(u8 *buf, int buf_size,
                            bool has_target, i32 target_id,
                            f32 ix, f32 iy, f32 iz)
 {
+    /* Wire: [0x19][shooter:i32][subsys:u8][flags:u8][vel:cv3]
+     *   [if has_target: target:i32, impact:cv4] */
     bc_buffer_t b;
     bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_reserve(&b, has_target ? 19 : 10)) return -1;
 
-    if (!bc_buf_write_u8(&b, BC_OP_TORPEDO_FIRE)) return -1;
-    if (!bc_buf_write_i32(&b, shooter_id)) return -1;
-    if (!bc_buf_write_u8(&b, subsys_index)) return -1;
+    bc_buf_put_u8(&b, BC_OP_TORPEDO_FIRE);
+    bc_buf_put_i32(&b, shooter_id);
+    bc_buf_put_u8(&b, subsys_index);
 
     u8 flags = has_target ? 0x02 : 0x00;
-    if (!bc_buf_write_u8(&b, flags)) return -1;
-    if (!bc_buf_write_cv3(&b, vx, vy, vz)) return -1;
+    bc_buf_put_u8(&b, flags);
+    bc_buf_put_cv3(&b, vx, vy, vz);
 
     if (has_target) {
-        if (!bc_buf_write_i32(&b, target_id)) return -1;
-        if (!bc_buf_write_cv4(&b, ix, iy, iz)) return -1;
+        bc_buf_put_i32(&b, target_id);
+        bc_buf_put_cv4(&b, ix, iy, iz);
     }
 
     return (int)b.pos;
@@ -62,22 +70,24 @@ int bc_build_beam_fire(u8 *buf, int buf_size,
                         f32 dx, f32 dy, f32 dz,
                         bool has_target, i32 target_id)
 {
+    /* Wire: [0x1A][shooter:i32][flags:u8][dir:cv3][more_flags:u8]
+     *   [if has_target: target:i32] */
     bc_buffer_t b;
     bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_reserve(&b, has_target ? 14 : 10)) return -1;
 
-    if (!bc_buf_write_u8(&b, BC_OP_BEAM_FIRE)) return -1;
-    if (!bc_buf_write_i32(&b, shooter_id)) return -1;
-    if (!bc_buf_write_u8(&b, flags)) return -1;
-    if (!bc_buf_write_cv3(&b, dx, dy, dz)) return -1;
+    bc_buf_put_u8(&b, BC_OP_BEAM_FIRE);
+    bc_buf_put_i32(&b, shooter_id);
+    bc_buf_put_u8(&b, flags);
+    bc_buf_put_cv3(&b, dx, dy, dz);
 
     /* bit 1 = hasSecondaryObject (extra i32 follows).
      * bit 0 = hasShieldEffect (visual only, caller controls via flags). */
     u8 more_flags = has_target ? 0x02 : 0x00;
-    if (!bc_buf_write_u8(&b, more_flags)) return -1;
+    bc_buf_put_u8(&b, more_flags);
 
-    if (has_target) {
-        if (!bc_buf_write_i32(&b, target_id)) return -1;
-    }
+    if (has_target)
+        bc_buf_put_i32(&b, target_id);
 
     return (int)b.pos;
 }
@@ -87,14 +97,16 @@ int bc_build_explosion(u8 *buf, int buf_size,
                         f32 ix, f32 iy, f32 iz,
                         f32 damage, f32 radius)
 {
+    /* Wire: [0x29][obj:i32][impact:cv4][radius:cf16][damage:cf16] */
     bc_buffer_t b;
     bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_reserve(&b, 14)) return -1;
 
-    if (!bc_buf_write_u8(&b, BC_OP_EXPLOSION)) return -1;
-    if (!bc_buf_write_i32(&b, object_id)) return -1;
-    if (!bc_buf_write_cv4(&b, ix, iy, iz)) return -1;
-    if (!bc_buf_write_cf16(&b, radius)) return -1;
-    if (!bc_buf_write_cf16(&b, damage)) return -1;
+    bc_buf_put_u8(&b, BC_OP_EXPLOSION);
+    bc_buf_put_i32(&b, object_id);
+    bc_buf_put_cv4(&b, ix, iy, iz);
+    bc_buf_put_cf16(&b, radius);
+    bc_buf_put_cf16(&b, damage);
 
     return (int)b.pos;
 }
@@ -175,22 +187,25 @@ int bc_build_score_change(u8 *buf, int buf_size,
      */
     bc_buffer_t b;
     bc_buf_init(&b, buf, (size_t)buf_size);
+    size_t entries = extra_count > 0 ? (size_t)extra_count : 0;
+    if (!bc_buf_reserve(&b, (killer_id != 0 ? 22 : 14) + entries * 8))
+        return -1;
 
-    if (!bc_buf_write_u8(&b, BC_MSG_SCORE_CHANGE)) return -1;
-    if (!bc_buf_write_i32(&b, killer_id)) return -1;
+    bc_buf_put_u8(&b, BC_MSG_SCORE_CHANGE);
+    bc_buf_put_i32(&b, killer_id);
 
     if (killer_id != 0) {
-        if (!bc_buf_write_i32(&b, killer_kills)) return -1;
-        if (!bc_buf_write_i32(&b, killer_score)) return -1;
+        bc_buf_put_i32(&b, killer_kills);
+        bc_buf_put_i32(&b, killer_score);
     }
 
-    if (!bc_buf_write_i32(&b, victim_id)) return -1;
-    if (!bc_buf_write_i32(&b, victim_deaths)) return -1;
-    if (!bc_buf_write_u8(&b, (u8)extra_count)) return -1;
+    bc_buf_put_i32(&b, victim_id);
+    bc_buf_put_i32(&b, victim_deaths);
+    bc_buf_put_u8(&b, (u8)extra_count);
 
-    for (int i = 0; i < extra_count; i++) {
-        if (!bc_buf_write_i32(&b, extra[i].player_id)) return -1;
-        if (!bc_buf_write_i32(&b, extra[i].score)) return -1;
+    for (size_t i = 0; i < entries; i++) {
+        bc_buf_put_i32(&b, extra[i].player_id);
+        bc_buf_put_i32(&b, extra[i].score);
     }
 
     return (int)b.pos;
@@ -297,17 +312,18 @@ int bc_build_state_update(u8 *buf, int buf_size,
                            i32 object_id, f32 game_time, u8 dirty_flags,
                            const u8 *field_data, int field_data_len)
 {
+    /* Wire: [0x1C][obj:i32][game_time:f32][dirty:u8][fields...] */
     bc_buffer_t b;
     bc_buf_init(&b, buf, (size_t)buf_size);
-
-    if (!bc_buf_write_u8(&b, BC_OP_STATE_UPDATE)) return -1;
-    if (!bc_buf_write_i32(&b, object_id)) return -1;
-    if (!bc_buf_write_f32(&b, game_time)) return -1;
-    if (!bc_buf_write_u8(&b, dirty_flags)) return -1;
-    if (field_data_len > 0) {
-        if (!bc_buf_write_bytes(&b, field_data, (size_t)field_data_len))
-            return -1;
-    }
+    size_t fields = field_data_len > 0 ? (size_t)field_data_len : 0;
+    if (!bc_buf_reserve(&b, 10 + fields)) return -1;
+
+    bc_buf_put_u8(&b, BC_OP_STATE_UPDATE);
+    bc_buf_put_i32(&b, object_id);
+    bc_buf_put_f32(&b, game_time);
+    bc_buf_put_u8(&b, dirty_flags);
+    if (fields > 0)
+        bc_buf_put_bytes(&b, field_data, fields);
 
     return (int)b.pos;
 }
@@ -361,6 +361,43 @@ bool bc_checksum_response_parse(bc_checksum_resp_t *resp,
     return true;
 }
 
+/* Check reported files against a sorted manifest file array: a content
+ * mismatch on any listed file fails, then every manifest file must have
+ * been reported. Manifest entries are unique, so the second part is a
+ * count of distinct hits, tracked in a bitmap indexed by manifest
+ * position. bc_manifest_load refuses arrays longer than a response can
+ * hold, so the bitmap covers every loaded manifest. */
+static bc_checksum_result_t validate_files(const bc_checksum_file_t *files,
+                                           int count,
+                                           const bc_manifest_file_t *mfiles,
+                                           int mcount)
+{
+    u32 seen[(BC_CHECKSUM_MAX_RESP_FILES + 31) / 32];
+    if (mcount > BC_CHECKSUM_MAX_RESP_FILES) return CHECKSUM_FILE_MISSING;
+    int hits = 0;
+    memset(seen, 0, (size_t)((mcount + 31) / 32) * sizeof(u32));
+
+    for (int i = 0; i < count; i++) {
+        const bc_manifest_file_t *mf =
+            bc_manifest_find_in(mfiles, mcount, files[i].name_hash);
+        if (!mf) {
+            /* Extra file not in manifest -- that's OK (could be a mod file) */
+            continue;
+        }
+        if (files[i].content_hash != mf->content_hash)
+            return CHECKSUM_FILE_MISMATCH;
+        int k = (int)(mf - mfiles);
+        u32 bit = 1u << (k & 31);
+        if (!(seen[k >> 5] & bit)) {
+            seen[k >> 5] |= bit;
+            hits++;
+        }
+    }
+
+    /* Check all manifest files were present in the response */
+    return hits < mcount ? CHECKSUM_FILE_MISSING : CHECKSUM_OK;
+}
+
 bc_checksum_result_t bc_checksum_response_validate(
     const bc_checksum_resp_t *resp,
     const bc_manifest_dir_t *manifest_dir)
@@ -377,70 +414,34 @@ bc_checksum_result_t bc_checksum_response_validate(
         return CHECKSUM_DIR_MISMATCH;
 
     /* Validate each file in the response against the manifest */
-    for (int i = 0; i < resp->file_count; i++) {
-        const bc_manifest_file_t *mf =
-            bc_manifest_find_file(manifest_dir, resp->files[i].name_hash);
-        if (!mf) {
-            /* Extra file not in manifest -- that's OK (could be a mod file) */
-            continue;
-        }
-        if (resp->files[i].content_hash != mf->content_hash)
-            return CHECKSUM_FILE_MISMATCH;
-    }
-
-    /* Check all manifest files were present in the response */
-    for (int i = 0; i < manifest_dir->file_count; i++) {
-        bool found = false;
-        for (int j = 0; j < resp->file_count; j++) {
-            if (resp->files[j].name_hash == manifest_dir->files[i].name_hash) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) return CHECKSUM_FILE_MISSING;
-    }
+    bc_checksum_result_t r = validate_files(resp->files, resp->file_count,
+                                            manifest_dir->files,
+                                            manifest_dir->file_count);
+    if (r != CHECKSUM_OK) return r;
 
     /* Validate subdirectory files */
+    u32 seen_subdirs = 0;
+    int subdir_hits = 0;
     for (int s = 0; s < resp->subdir_count; s++) {
         const bc_manifest_subdir_t *ms =
             bc_manifest_find_subdir(manifest_dir, resp->subdirs[s].name_hash);
         if (!ms) continue; /* Extra subdir not in manifest -- OK */
 
         const bc_checksum_subdir_resp_t *rs = &resp->subdirs[s].data;
-
-        /* Validate each file in this subdir */
-        for (int i = 0; i < rs->file_count; i++) {
-            const bc_manifest_file_t *mf =
-                bc_manifest_find_subdir_file(ms, rs->files[i].name_hash);
-            if (!mf) continue;
-            if (rs->files[i].content_hash != mf->content_hash)
-                return CHECKSUM_FILE_MISMATCH;
-        }
-
-        /* Check all manifest subdir files were present */
-        for (int i = 0; i < ms->file_count; i++) {
-            bool found = false;
-            for (int j = 0; j < rs->file_count; j++) {
-                if (rs->files[j].name_hash == ms->files[i].name_hash) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) return CHECKSUM_FILE_MISSING;
+        r = validate_files(rs->files, rs->file_count, ms->files, ms->file_count);
+        if (r != CHECKSUM_OK) return r;
+
+        /* Loaded manifests have at most BC_CHECKSUM_MAX_RESP_SUBDIRS */
+        int k = (int)(ms - manifest_dir->subdirs);
+        if (k < 32 && !(seen_subdirs & (1u << k))) {
+            seen_subdirs |= 1u << k;
+            subdir_hits++;
         }
     }
 
     /* Check all manifest subdirs were present in response */
-    for (int s = 0; s < manifest_dir->subdir_count; s++) {
-        bool found = false;
-        for (int j = 0; j < resp->subdir_count; j++) {
-            if (resp->subdirs[j].name_hash == manifest_dir->subdirs[s].name_hash) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) return CHECKSUM_FILE_MISSING;
-    }
+    if (subdir_hits < manifest_dir->subdir_count)
+        return CHECKSUM_FILE_MISSING;
 
     return CHECKSUM_OK;
 }
@@ -0,0 +1,149 @@
+/*
+ * bench_bot_ai.c -- tick-time cost of the time-sliced bot AI
+ *
+ * Runs a 10-vs-10 bot battle (20 bots, registry classes round-robin) at the
+ * server's 30 Hz tick for BENCH_TICKS ticks, alongside the same per-ship
+ * simulation main.c runs (power, movement, shields, weapon charge). Fire
+ * callbacks apply damage like the server's beam/torpedo handlers, and dead
+ * ships are respawned so the load stays constant.
+ *
+ * Reported per configuration: mean/max bot time per tick (from
+ * bc_bot_stats_t), mean simulation time, decisions per tick and the share
+ * of the 33 ms tick consumed. "unsliced" thinks for every bot every tick
+ * with no budget, as a naive AI loop would. Fails if any tick exceeds 33 ms.
+ *
+ * Usage: make bench   (or build/tests/bench_bot_ai [registry_dir])
+ */
+
+#include "openbc/bot_ai.h"
+#include "openbc/ship_data.h"
+#include "openbc/ship_state.h"
+#include "openbc/ship_power.h"
+#include "openbc/movement.h"
+#include "openbc/combat.h"
+#include "openbc/game_builders.h"
+#include "openbc/log.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_BOTS   20
+#define BENCH_TICKS  9000          /* 5 minutes of game time */
+#define TICK_DT      0.033f
+#define TICK_US      33000u
+
+static bc_game_registry_t g_reg;
+static bc_ship_state_t    g_ships[BENCH_BOTS];
+static const bc_ship_class_t *g_cls[BENCH_BOTS];
+static int                g_cls_idx[BENCH_BOTS];
+static int                g_kills;
+
+static u32 g_rng = 0xB07B07u;
+static f32 rand_range(f32 lo, f32 hi)
+{
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (f32)(g_rng >> 8) / (f32)(1u << 24);
+}
+
+static void spawn(int i)
+{
+    bc_ship_init(&g_ships[i], g_cls[i], g_cls_idx[i], bc_make_ship_id(i),
+                 (u8)(i + 1), (u8)(i & 1));
+    g_ships[i].pos.x = rand_range(-600.0f, 600.0f);
+    g_ships[i].pos.y = rand_range(-100.0f, 100.0f);
+    g_ships[i].pos.z = rand_range(-600.0f, 600.0f);
+}
+
+static void on_fire(void *user, int bot, const bc_ship_state_t *target,
+                    bool torpedo, const u8 *pkt, int len)
+{
+    (void)user; (void)pkt; (void)len;
+    int t = (int)(target - g_ships);
+    if (t < 0 || t >= BENCH_BOTS) return;
+    bc_vec3_t dir = bc_vec3_normalize(bc_vec3_sub(g_ships[t].pos,
+                                                  g_ships[bot].pos));
+    bc_combat_apply_damage(&g_ships[t], g_cls[t], torpedo ? 500.0f : 150.0f,
+                           torpedo ? 1.0f : 0.0f, dir, false, 1.0f);
+    if (!g_ships[t].alive) g_kills++;
+}
+
+static int run(const char *label, const bc_bot_cfg_t *cfg)
+{
+    static bc_bot_world_t w;
+    bc_bot_world_init(&w, cfg);
+    w.on_fire = on_fire;
+    g_rng = 0xB07B07u;
+    g_kills = 0;
+
+    for (int i = 0; i < BENCH_BOTS; i++) {
+        spawn(i);
+        bc_bot_add(&w, &g_ships[i], g_cls[i]);
+    }
+
+    u64 sim_us = 0;
+    u32 worst_total = 0;
+    for (int t = 0; t < BENCH_TICKS; t++) {
+        u32 s0 = bc_us_now();
+        for (int i = 0; i < BENCH_BOTS; i++) {
+            bc_ship_state_t *s = &g_ships[i];
+            if (!s->alive) { spawn(i); continue; }
+            bc_ship_power_tick(s, g_cls[i], TICK_DT);
+            bc_ship_move_tick(s, 1.0f, TICK_DT);
+            bc_combat_shield_tick(s, g_cls[i], 1.0f, TICK_DT);
+            bc_combat_charge_tick(s, g_cls[i], 1.0f, TICK_DT);
+            bc_combat_torpedo_tick(s, g_cls[i], TICK_DT);
+        }
+        u32 sim = bc_us_now() - s0;
+        sim_us += sim;
+
+        bc_bot_world_tick(&w, TICK_DT);
+        u32 total = sim + w.stats.tick_us_last;
+        if (total > worst_total) worst_total = total;
+    }
+
+    double ai_mean = (double)w.stats.tick_us_total / BENCH_TICKS;
+    printf("  %-9s ai %7.1f us/tick (max %5u)  sim %6.1f us  "
+           "decisions %5.2f/tick  deferred %5.2f  fires %u/%u  kills %d  "
+           "%.2f%% of tick\n",
+           label, ai_mean, w.stats.tick_us_max,
+           (double)sim_us / BENCH_TICKS,
+           (double)w.stats.decisions / BENCH_TICKS,
+           (double)w.stats.deferred / BENCH_TICKS,
+           w.stats.phasers_fired, w.stats.torpedoes_fired, g_kills,
+           100.0 * ai_mean / TICK_US);
+
+    if (worst_total > TICK_US) {
+        printf("  %s: worst tick %u us exceeds the 33 ms budget\n",
+               label, worst_total);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : "data/vanilla-1.1";
+
+    if (!bc_registry_load_dir(&g_reg, dir) || g_reg.ship_count == 0) {
+        printf("bench_bot_ai: registry %s not found, skipping\n", dir);
+        return 0;
+    }
+    for (int i = 0; i < BENCH_BOTS; i++) {
+        g_cls_idx[i] = i % g_reg.ship_count;
+        g_cls[i] = &g_reg.ships[g_cls_idx[i]];
+    }
+
+    printf("bench_bot_ai: %d bots, %d ticks @ 30 Hz\n", BENCH_BOTS, BENCH_TICKS);
+
+    bc_bot_cfg_t cfg;
+    int fail = 0;
+
+    bc_bot_cfg_defaults(&cfg);
+    fail |= run("sliced", &cfg);
+
+    cfg.think_interval = 1;
+    cfg.max_decisions  = 0;
+    cfg.budget_us      = 0;
+    fail |= run("unsliced", &cfg);
+
+    return fail;
+}
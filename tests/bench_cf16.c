@@ -0,0 +1,136 @@
+/*
+ * bench_cf16.c -- table decode and compare-count encode vs the original
+ *                 CompressedFloat16 threshold walk, plus the batch calls
+ *
+ * Decode runs over every u16 code; encode over 64K pseudo-random speeds,
+ * damage values and distances spread across all eight decades. Results
+ * of the old and new paths are cross-checked.
+ *
+ * Usage: make bench   (or build/tests/bench_cf16)
+ */
+
+#include "openbc/buffer.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define N       0x10000
+#define ROUNDS  200
+
+/* The pre-table codec */
+static u16 encode_walk(f32 value)
+{
+    u32 sign_flag = 0;
+    if (value < 0.0f) {
+        sign_flag = 8;
+        value = -value;
+    }
+    u32 scale = 0;
+    f32 lo = 0.0f;
+    f32 hi = 0.001f;
+    while (scale < 8) {
+        if (value < hi) break;
+        lo = hi;
+        hi *= 10.0f;
+        scale++;
+    }
+    if (scale >= 8)
+        return (u16)((sign_flag | 7) * 0x1000 + 0xFFF);
+    f32 range = hi - lo;
+    i32 mantissa = (range > 0.0f) ? (i32)((value - lo) / range * 4095.0f) : 0;
+    if (mantissa > 0xFFF) mantissa = 0xFFF;
+    if (mantissa < 0) mantissa = 0;
+    return (u16)((sign_flag | scale) * 0x1000 + mantissa);
+}
+
+static f32 decode_walk(u16 encoded)
+{
+    u16 mantissa = encoded & 0xFFF;
+    u8 raw_scale = (u8)(encoded >> 12);
+    bool is_neg = (raw_scale >> 3) & 1;
+    u8 scale = raw_scale & 0x7;
+    f32 range_lo = 0.0f;
+    f32 range_hi = 0.001f;
+    for (u8 i = 0; i < scale; i++) {
+        range_lo = range_hi;
+        range_hi *= 10.0f;
+    }
+    f32 result = range_lo + ((f32)mantissa / 4095.0f) * (range_hi - range_lo);
+    return is_neg ? -result : result;
+}
+
+/* Both codecs are called out of line, as callers in other files see them */
+static u16 (*volatile encode_old)(f32) = encode_walk;
+static f32 (*volatile decode_old)(u16) = decode_walk;
+static u16 (*volatile encode_new)(f32) = bc_cf16_encode;
+static f32 (*volatile decode_new)(u16) = bc_cf16_decode;
+
+static double elapsed_ns(clock_t t0, clock_t t1)
+{
+    return (double)(t1 - t0) * 1e9 / CLOCKS_PER_SEC / ((double)ROUNDS * N);
+}
+
+int main(void)
+{
+    static u16 codes[N], enc_a[N], enc_b[N];
+    static f32 vals[N], dec_a[N], dec_b[N];
+
+    u32 x = 0xC0FFEEu;
+    for (u32 i = 0; i < N; i++) {
+        codes[i] = (u16)i;
+        x = x * 1664525u + 1013904223u;
+        /* exponent 2^-11 .. 2^14: the codec's whole range and a bit past */
+        u32 bits = (x & 0x807FFFFFu) | ((116u + (x >> 23) % 26u) << 23);
+        memcpy(&vals[i], &bits, sizeof(bits));
+    }
+    bc_cf16_decode(0);   /* build the table outside the timing */
+
+    f32 (*dec_old)(u16) = decode_old;
+    f32 (*dec_new)(u16) = decode_new;
+    clock_t t0 = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        for (u32 i = 0; i < N; i++) dec_a[i] = dec_old(codes[i]);
+    clock_t t1 = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        for (u32 i = 0; i < N; i++) dec_b[i] = dec_new(codes[i]);
+    clock_t t2 = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        bc_cf16_decode_many(codes, dec_b, N);
+    clock_t t3 = clock();
+    if (memcmp(dec_a, dec_b, sizeof(dec_a)) != 0) {
+        printf("bench_cf16: decode MISMATCH\n");
+        return 1;
+    }
+    double walk_ns = elapsed_ns(t0, t1);
+    double table_ns = elapsed_ns(t1, t2);
+    double batch_ns = elapsed_ns(t2, t3);
+    printf("bench_cf16: decode %d codes, %d rounds\n", N, ROUNDS);
+    printf("  walk     %6.2f ns/value\n", walk_ns);
+    printf("  table    %6.2f ns/value  x%.2f\n", table_ns, walk_ns / table_ns);
+    printf("  batch    %6.2f ns/value  x%.2f\n", batch_ns, walk_ns / batch_ns);
+
+    u16 (*enc_old)(f32) = encode_old;
+    u16 (*enc_new)(f32) = encode_new;
+    t0 = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        for (u32 i = 0; i < N; i++) enc_a[i] = enc_old(vals[i]);
+    t1 = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        for (u32 i = 0; i < N; i++) enc_b[i] = enc_new(vals[i]);
+    t2 = clock();
+    for (int r = 0; r < ROUNDS; r++)
+        bc_cf16_encode_many(vals, enc_b, N);
+    t3 = clock();
+    if (memcmp(enc_a, enc_b, sizeof(enc_a)) != 0) {
+        printf("bench_cf16: encode MISMATCH\n");
+        return 1;
+    }
+    walk_ns = elapsed_ns(t0, t1);
+    double cmp_ns = elapsed_ns(t1, t2);
+    batch_ns = elapsed_ns(t2, t3);
+    printf("bench_cf16: encode %d values, %d rounds\n", N, ROUNDS);
+    printf("  walk     %6.2f ns/value\n", walk_ns);
+    printf("  compare  %6.2f ns/value  x%.2f\n", cmp_ns, walk_ns / cmp_ns);
+    printf("  batch    %6.2f ns/value  x%.2f\n", batch_ns, walk_ns / batch_ns);
+    return 0;
+}
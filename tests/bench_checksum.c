@@ -0,0 +1,112 @@
+/*
+ * bench_checksum.c -- lane-folded file_hash vs the serial FileHash loop,
+ *                     string_hash_many vs one string_hash per name
+ *
+ * FileHash runs over a 4 MB pseudo-random buffer (a large .pyc set's worth
+ * of bytes); StringHash over 4096 generated .pyc filenames. Results of the
+ * two paths are cross-checked every round.
+ *
+ * Usage: make bench   (or build/tests/bench_checksum)
+ */
+
+#include "openbc/checksum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define FILE_BYTES    (4u << 20)
+#define FILE_ROUNDS   50
+#define NAME_COUNT    4096
+#define NAME_ROUNDS   500
+
+/* The pre-vectorization loop: one dependent XOR/ROL per DWORD */
+static u32 file_hash_serial(const u8 *data, size_t len)
+{
+    u32 hash = 0;
+    for (size_t i = 0; i < len / 4; i++) {
+        if (i == 1) continue;
+        u32 dword = (u32)data[i * 4] | ((u32)data[i * 4 + 1] << 8)
+                  | ((u32)data[i * 4 + 2] << 16) | ((u32)data[i * 4 + 3] << 24);
+        hash ^= dword;
+        hash = (hash << 1) | (hash >> 31);
+    }
+    for (size_t i = len & ~(size_t)3; i < len; i++) {
+        hash ^= (u32)(i32)(i8)data[i];
+        hash = (hash << 1) | (hash >> 31);
+    }
+    return hash;
+}
+
+static double elapsed_us(clock_t t0, clock_t t1)
+{
+    return (double)(t1 - t0) * 1e6 / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+    u8 *buf = malloc(FILE_BYTES + 3);
+    if (!buf) return 1;
+    u32 x = 0xC0FFEEu;
+    for (size_t i = 0; i < FILE_BYTES + 3; i++) {
+        x = x * 1664525u + 1013904223u;
+        buf[i] = (u8)(x >> 24);
+    }
+
+    /* Odd length: exercises the tail bytes too */
+    size_t len = FILE_BYTES + 3;
+    u32 a = 0, b = 0;
+    clock_t t0 = clock();
+    for (int r = 0; r < FILE_ROUNDS; r++) a ^= file_hash_serial(buf, len) + (u32)r;
+    clock_t t1 = clock();
+    for (int r = 0; r < FILE_ROUNDS; r++) b ^= file_hash(buf, len) + (u32)r;
+    clock_t t2 = clock();
+    if (a != b) {
+        printf("bench_checksum: file_hash MISMATCH (0x%08X vs 0x%08X)\n", a, b);
+        free(buf);
+        return 1;
+    }
+    double serial_us = elapsed_us(t0, t1) / FILE_ROUNDS;
+    double folded_us = elapsed_us(t1, t2) / FILE_ROUNDS;
+    double mb = (double)len / (1024.0 * 1024.0);
+    printf("bench_checksum: file_hash %zu bytes, %d rounds\n", len, FILE_ROUNDS);
+    printf("  serial   %8.1f us  %8.1f MB/s\n", serial_us, mb / (serial_us * 1e-6));
+    printf("  folded   %8.1f us  %8.1f MB/s  x%.2f\n", folded_us,
+           mb / (folded_us * 1e-6), serial_us / folded_us);
+    free(buf);
+
+    static char store[NAME_COUNT][40];
+    static const char *names[NAME_COUNT];
+    static u32 out[NAME_COUNT];
+    for (int i = 0; i < NAME_COUNT; i++) {
+        x = x * 1664525u + 1013904223u;
+        /* 5..24 characters of filename before ".pyc" */
+        int n = 5 + (int)((x >> 16) % 20);
+        for (int k = 0; k < n; k++) {
+            x = x * 1664525u + 1013904223u;
+            store[i][k] = (char)('a' + (x >> 24) % 26);
+        }
+        snprintf(store[i] + n, sizeof(store[i]) - (size_t)n, ".pyc");
+        names[i] = store[i];
+    }
+
+    a = b = 0;
+    t0 = clock();
+    for (int r = 0; r < NAME_ROUNDS; r++)
+        for (int i = 0; i < NAME_COUNT; i++) a += string_hash(names[i]);
+    t1 = clock();
+    for (int r = 0; r < NAME_ROUNDS; r++) {
+        string_hash_many(names, NAME_COUNT, out);
+        for (int i = 0; i < NAME_COUNT; i++) b += out[i];
+    }
+    t2 = clock();
+    if (a != b) {
+        printf("bench_checksum: string_hash_many MISMATCH\n");
+        return 1;
+    }
+    double single_ns = elapsed_us(t0, t1) * 1e3 / ((double)NAME_ROUNDS * NAME_COUNT);
+    double batch_ns = elapsed_us(t1, t2) * 1e3 / ((double)NAME_ROUNDS * NAME_COUNT);
+    printf("bench_checksum: string_hash %d names, %d rounds\n", NAME_COUNT, NAME_ROUNDS);
+    printf("  single   %8.1f ns/name\n", single_ns);
+    printf("  batch    %8.1f ns/name  x%.2f\n", batch_ns, single_ns / batch_ns);
+    return 0;
+}
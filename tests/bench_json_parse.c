@@ -0,0 +1,186 @@
+/*
+ * bench_json_parse.c -- json_parse (heap) vs json_parse_insitu (arena)
+ *                       vs json_reader (streaming, no tree)
+ *
+ * Loads every JSON file the registry loader reads from a versioned data
+ * directory (manifest, per-ship files, projectiles) into memory once, then
+ * parses and frees the whole set repeatedly in each mode. The in-situ pass
+ * includes copying each document into a scratch buffer first, since the
+ * parse consumes its text. Trees from both modes are cross-checked. The
+ * streaming pass pulls every token without building anything.
+ *
+ * Usage: make bench   (or build/tests/bench_json_parse [registry_dir])
+ */
+
+#include "openbc/json_parse.h"
+#include "openbc/ship_data.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ROUNDS  200
+#define MAX_DOCS      (1 + BC_MAX_SHIPS * 4 + BC_MAX_PROJECTILES)
+
+static char  *g_docs[MAX_DOCS];
+static size_t g_lens[MAX_DOCS];
+static int    g_doc_count;
+static size_t g_total_bytes;
+
+static void add_doc(const char *path)
+{
+    if (g_doc_count >= MAX_DOCS) return;
+    FILE *f = fopen(path, "rb");
+    if (!f) return;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) { fclose(f); return; }
+    char *text = malloc((size_t)size + 1);
+    size_t n = text ? fread(text, 1, (size_t)size, f) : 0;
+    fclose(f);
+    if (!text) return;
+    text[n] = '\0';
+    g_docs[g_doc_count] = text;
+    g_lens[g_doc_count] = n;
+    g_doc_count++;
+    g_total_bytes += n;
+}
+
+static bool load_set(const char *dir)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/manifest.json", dir);
+    add_doc(path);
+    if (g_doc_count == 0) return false;
+
+    json_value_t *m = json_parse(g_docs[0]);
+    if (!m) return false;
+    static const char *const files[] = {
+        "ship.json", "subsystems.json", "serialization.json", "power.json",
+    };
+    json_value_t *ships = json_get(m, "ships");
+    for (size_t i = 0; i < json_array_len(ships); i++) {
+        const char *folder = json_string(json_array_get(ships, i));
+        if (!folder) continue;
+        for (size_t k = 0; k < 4; k++) {
+            snprintf(path, sizeof(path), "%s/ships/%s/%s", dir, folder, files[k]);
+            add_doc(path);
+        }
+    }
+    json_value_t *projs = json_get(m, "projectiles");
+    for (size_t i = 0; i < json_array_len(projs); i++) {
+        const char *base = json_string(json_array_get(projs, i));
+        if (!base) continue;
+        snprintf(path, sizeof(path), "%s/projectiles/%s.json", dir, base);
+        add_doc(path);
+    }
+    json_free(m);
+    return true;
+}
+
+/* Node count, strings included, so both modes can be compared. */
+static long count_nodes(const json_value_t *v)
+{
+    if (!v) return 0;
+    long n = 1;
+    if (v->type == JSON_ARRAY)
+        for (size_t i = 0; i < v->array.count; i++) n += count_nodes(v->array.items[i]);
+    if (v->type == JSON_OBJECT)
+        for (size_t i = 0; i < v->object.count; i++)
+            n += (long)strlen(v->object.members[i].key) +
+                 count_nodes(v->object.members[i].value);
+    if (v->type == JSON_STRING) n += (long)strlen(v->string);
+    return n;
+}
+
+static double now_sec(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : "data/vanilla-1.1";
+    if (!load_set(dir)) {
+        printf("bench_json_parse: registry %s not found, skipping\n", dir);
+        return 0;
+    }
+
+    char *scratch = malloc(65536);
+    size_t scratch_cap = 65536;
+    for (int d = 0; d < g_doc_count; d++) {
+        if (g_lens[d] + 1 > scratch_cap) {
+            scratch_cap = g_lens[d] + 1;
+            scratch = realloc(scratch, scratch_cap);
+        }
+    }
+    if (!scratch) return 1;
+
+    /* Cross-check once */
+    long nodes_heap = 0, nodes_arena = 0;
+    for (int d = 0; d < g_doc_count; d++) {
+        json_value_t *a = json_parse(g_docs[d]);
+        memcpy(scratch, g_docs[d], g_lens[d] + 1);
+        json_value_t *b = json_parse_insitu(scratch);
+        nodes_heap += count_nodes(a);
+        nodes_arena += count_nodes(b);
+        json_free(a);
+        json_free(b);
+    }
+
+    long sink = 0;
+    double t0 = now_sec();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int d = 0; d < g_doc_count; d++) {
+            json_value_t *v = json_parse(g_docs[d]);
+            sink += v ? (long)v->type : -1;
+            json_free(v);
+        }
+    }
+    double t_heap = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int d = 0; d < g_doc_count; d++) {
+            memcpy(scratch, g_docs[d], g_lens[d] + 1);
+            json_value_t *v = json_parse_insitu(scratch);
+            sink += v ? (long)v->type : -1;
+            json_free(v);
+        }
+    }
+    double t_arena = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int d = 0; d < g_doc_count; d++) {
+            json_reader_t rd;
+            json_reader_init(&rd, g_docs[d]);
+            json_tok_t t;
+            do {
+                t = json_reader_next(&rd);
+                sink += (long)t;
+            } while (t != JSON_TOK_END && t != JSON_TOK_ERROR);
+            json_reader_close(&rd);
+        }
+    }
+    double t_stream = now_sec() - t0;
+
+    double mb = (double)g_total_bytes * BENCH_ROUNDS / (1024.0 * 1024.0);
+    printf("bench_json_parse: %d documents, %zu bytes, %d rounds\n",
+           g_doc_count, g_total_bytes, BENCH_ROUNDS);
+    printf("  heap     %8.1f us/set  %7.1f MB/s\n",
+           t_heap * 1e6 / BENCH_ROUNDS, t_heap > 0.0 ? mb / t_heap : 0.0);
+    printf("  in-situ  %8.1f us/set  %7.1f MB/s  x%.2f%s\n",
+           t_arena * 1e6 / BENCH_ROUNDS, t_arena > 0.0 ? mb / t_arena : 0.0,
+           t_arena > 0.0 ? t_heap / t_arena : 0.0,
+           nodes_heap == nodes_arena ? "" : "  MISMATCH");
+    printf("  stream   %8.1f us/set  %7.1f MB/s  x%.2f\n",
+           t_stream * 1e6 / BENCH_ROUNDS, t_stream > 0.0 ? mb / t_stream : 0.0,
+           t_stream > 0.0 ? t_heap / t_stream : 0.0);
+    if (sink == 0) printf("  (no documents parsed)\n");
+
+    free(scratch);
+    for (int d = 0; d < g_doc_count; d++) free(g_docs[d]);
+    return nodes_heap == nodes_arena ? 0 : 1;
+}
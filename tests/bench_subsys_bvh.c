@@ -0,0 +1,104 @@
+/*
+ * bench_subsys_bvh.c -- bc_combat_find_hit_subsystems: linear scan vs BVH
+ *
+ * Runs the same pseudo-random damage queries against each registry ship
+ * class and a synthetic 64-hardpoint class, once through the per-class BVH
+ * and once with bvh_node_count forced to 0 (linear scan). Collision-sized
+ * (search_radius 1.5) and beam-sized (1.0) queries are interleaved.
+ *
+ * Usage: make bench   (or build/tests/bench_subsys_bvh [registry_dir])
+ */
+
+#include "openbc/ship_data.h"
+#include "openbc/combat.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_QUERIES 200000
+
+static bc_game_registry_t g_reg;
+static bc_ship_class_t    g_linear;
+static bc_ship_class_t    g_big;
+static bc_vec3_t          g_points[1024];
+static f32                g_radii[1024];
+
+static u32 g_rng = 0xC0FFEEu;
+static f32 rand_range(f32 lo, f32 hi)
+{
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (f32)(g_rng >> 8) / (f32)(1u << 24);
+}
+
+/* Returns elapsed nanoseconds per query; *sink accumulates hit counts so the
+ * calls cannot be optimized away and both paths can be cross-checked. */
+static double run(const bc_ship_class_t *cls, long *sink)
+{
+    int out[BC_MAX_SUBSYSTEMS];
+    long total = 0;
+    clock_t t0 = clock();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int k = q & 1023;
+        total += bc_combat_find_hit_subsystems(cls, g_points[k], g_radii[k],
+                                               (q & 1) ? 1.5f : 1.0f,
+                                               out, BC_MAX_SUBSYSTEMS);
+    }
+    clock_t t1 = clock();
+    *sink = total;
+    return (double)(t1 - t0) * 1e9 / CLOCKS_PER_SEC / BENCH_QUERIES;
+}
+
+static int bench_class(const char *label, const bc_ship_class_t *cls)
+{
+    f32 ext = cls->bounding_extent * 1.25f;
+    for (int i = 0; i < 1024; i++) {
+        g_points[i].x = rand_range(-ext, ext);
+        g_points[i].y = rand_range(-ext, ext);
+        g_points[i].z = rand_range(-ext, ext);
+        g_radii[i] = rand_range(0.0f, ext * 0.25f);
+    }
+
+    g_linear = *cls;
+    g_linear.bvh_node_count = 0;
+
+    long hits_lin = 0, hits_bvh = 0;
+    double ns_lin = run(&g_linear, &hits_lin);
+    double ns_bvh = run(cls, &hits_bvh);
+
+    printf("  %-24s ss=%2d nodes=%2d  linear %7.1f ns  bvh %7.1f ns  x%.2f%s\n",
+           label, cls->subsystem_count, cls->bvh_node_count, ns_lin, ns_bvh,
+           ns_bvh > 0.0 ? ns_lin / ns_bvh : 0.0,
+           hits_lin == hits_bvh ? "" : "  MISMATCH");
+    return hits_lin == hits_bvh ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : "data/vanilla-1.1";
+    int fail = 0;
+
+    printf("bench_subsys_bvh: %d queries per path\n", BENCH_QUERIES);
+
+    if (bc_registry_load_dir(&g_reg, dir)) {
+        for (int c = 0; c < g_reg.ship_count; c++)
+            fail |= bench_class(g_reg.ships[c].name, &g_reg.ships[c]);
+    } else {
+        printf("  (registry %s not found, skipping real classes)\n", dir);
+    }
+
+    /* Large hardpoint file: every slot populated */
+    memset(&g_big, 0, sizeof(g_big));
+    snprintf(g_big.name, sizeof(g_big.name), "synthetic-64");
+    g_big.subsystem_count = BC_MAX_SUBSYSTEMS;
+    for (int i = 0; i < BC_MAX_SUBSYSTEMS; i++) {
+        g_big.subsystems[i].position.x = rand_range(-2.0f, 2.0f);
+        g_big.subsystems[i].position.y = rand_range(-4.0f, 4.0f);
+        g_big.subsystems[i].position.z = rand_range(-1.0f, 1.0f);
+        g_big.subsystems[i].radius = rand_range(0.05f, 0.4f);
+    }
+    g_big.bounding_extent = 4.0f;
+    bc_ship_class_build_bvh(&g_big);
+    fail |= bench_class(g_big.name, &g_big);
+
+    return fail;
+}
@@ -0,0 +1,258 @@
+#include "test_util.h"
+#include "openbc/bot_ai.h"
+#include "openbc/ship_data.h"
+#include "openbc/ship_state.h"
+#include "openbc/movement.h"
+#include "openbc/combat.h"
+#include "openbc/game_builders.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the time-sliced bot AI (src/server/bot_ai.c).
+ *
+ * Covers the work queue (decision cap, CPU budget with an injected clock,
+ * FIFO fairness, swap-remove renumbering), cached perception (team and
+ * cloak filtering, stale targets) and the act/think split driving the
+ * real movement and combat primitives.
+ */
+
+#define REGISTRY_DIR "data/vanilla-1.1"
+#define NBOTS 20
+
+static bc_game_registry_t     g_reg;
+static bool                   g_reg_loaded;
+static const bc_ship_class_t *g_cls;
+static int                    g_cls_idx;
+static bc_ship_state_t        g_ships[NBOTS + 2];
+static bc_bot_world_t         g_world;
+
+static int g_fires;
+static int g_torps;
+static i32 g_last_target_id;
+
+static void on_fire(void *user, int bot, const bc_ship_state_t *target,
+                    bool torpedo, const u8 *pkt, int len)
+{
+    (void)user; (void)bot; (void)pkt;
+    if (len <= 0) return;
+    if (torpedo) g_torps++;
+    else         g_fires++;
+    g_last_target_id = target->object_id;
+}
+
+/* Fake clock: every read advances 100 us */
+static u32 g_fake_us;
+static u32 fake_clock(void)
+{
+    g_fake_us += 100;
+    return g_fake_us;
+}
+
+static bool load_registry(void)
+{
+    if (!g_reg_loaded) {
+        g_reg_loaded = bc_registry_load_dir(&g_reg, REGISTRY_DIR);
+        if (!g_reg_loaded) return false;
+        /* First class with both phasers and torpedoes */
+        for (int i = 0; i < g_reg.ship_count; i++) {
+            const bc_ship_class_t *c = bc_registry_get_ship(&g_reg, i);
+            if (c && c->phaser_banks > 0 && c->torpedo_tubes > 0) {
+                g_cls = c;
+                g_cls_idx = i;
+                break;
+            }
+        }
+    }
+    return g_cls != NULL;
+}
+
+static void spawn(int i, u8 team, f32 x, f32 z)
+{
+    bc_ship_init(&g_ships[i], g_cls, g_cls_idx, bc_make_ship_id(i),
+                 (u8)(i + 1), team);
+    g_ships[i].pos.x = x;
+    g_ships[i].pos.z = z;
+}
+
+static void reset_world(const bc_bot_cfg_t *cfg)
+{
+    bc_bot_world_init(&g_world, cfg);
+    g_world.on_fire = on_fire;
+    g_fires = g_torps = 0;
+    g_last_target_id = -1;
+}
+
+TEST(decision_cap_and_fairness)
+{
+    ASSERT(load_registry());
+    bc_bot_cfg_t cfg;
+    bc_bot_cfg_defaults(&cfg);
+    cfg.think_interval = 1;
+    cfg.max_decisions  = 3;
+    cfg.budget_us      = 0;
+    reset_world(&cfg);
+
+    for (int i = 0; i < NBOTS; i++) {
+        spawn(i, (u8)(i & 1), (f32)(i * 10), 0.0f);
+        ASSERT(bc_bot_add(&g_world, &g_ships[i], g_cls) == i);
+    }
+
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT_EQ_INT(g_world.stats.decisions, 3);
+    ASSERT_EQ_INT(g_world.queue_len, NBOTS - 3);
+
+    /* FIFO: every bot gets a decision within ceil(20/3) ticks */
+    for (int t = 1; t < 7; t++)
+        bc_bot_world_tick(&g_world, 0.033f);
+    for (int i = 0; i < NBOTS; i++)
+        ASSERT(g_world.bots[i].state != BC_BOT_IDLE);
+    ASSERT(g_world.stats.deferred > 0);
+}
+
+TEST(budget_limits_think_time)
+{
+    ASSERT(load_registry());
+    bc_bot_cfg_t cfg;
+    bc_bot_cfg_defaults(&cfg);
+    cfg.think_interval = 1;
+    cfg.max_decisions  = 0;
+    cfg.budget_us      = 350;
+    reset_world(&cfg);
+    g_world.clock_us = fake_clock;
+
+    for (int i = 0; i < NBOTS; i++) {
+        spawn(i, (u8)(i & 1), (f32)(i * 10), 0.0f);
+        bc_bot_add(&g_world, &g_ships[i], g_cls);
+    }
+
+    bc_bot_world_tick(&g_world, 0.033f);
+    /* 100 us per clock read: checks after decisions 1..4 see 100..400 us */
+    ASSERT_EQ_INT(g_world.stats.decisions, 4);
+    ASSERT(g_world.stats.tick_us_last > 0);
+
+    /* A budget smaller than one decision still makes progress */
+    g_world.cfg.budget_us = 1;
+    u32 before = g_world.stats.decisions;
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT_EQ_INT(g_world.stats.decisions - before, 1);
+}
+
+TEST(approach_then_engage_and_fire)
+{
+    ASSERT(load_registry());
+    reset_world(NULL);
+    spawn(0, 0, 0.0f, 0.0f);
+    spawn(1, 1, 0.0f, 1000.0f);
+    bc_bot_add(&g_world, &g_ships[0], g_cls);
+    bc_bot_add_contact(&g_world, &g_ships[1]);
+
+    /* First decision: far away, close at full speed */
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT_EQ_INT(g_world.bots[0].state, BC_BOT_APPROACH);
+    ASSERT(g_world.bots[0].target == &g_ships[1]);
+    ASSERT(g_ships[0].speed > 0.0f);
+
+    f32 d0 = bc_vec3_dist(g_ships[0].pos, g_ships[1].pos);
+    for (int t = 0; t < 30; t++) {
+        bc_bot_world_tick(&g_world, 0.1f);
+        bc_ship_move_tick(&g_ships[0], 1.0f, 0.1f);
+    }
+    ASSERT(bc_vec3_dist(g_ships[0].pos, g_ships[1].pos) < d0);
+
+    /* Move the target into range: next decision engages and fires */
+    g_ships[1].pos = g_ships[0].pos;
+    g_ships[1].pos.x += 40.0f;
+    for (int t = 0; t < g_world.cfg.think_interval + g_world.cfg.perceive_interval; t++)
+        bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT_EQ_INT(g_world.bots[0].state, BC_BOT_ENGAGE);
+    ASSERT(g_fires > 0);
+    ASSERT(g_torps > 0);
+    ASSERT_EQ_INT(g_last_target_id, g_ships[1].object_id);
+    ASSERT(g_world.stats.phasers_fired == (u32)g_fires);
+}
+
+TEST(perception_filters_team_and_cloak)
+{
+    ASSERT(load_registry());
+    reset_world(NULL);
+    spawn(0, 0, 0.0f, 0.0f);
+    spawn(1, 0, 0.0f, 20.0f);      /* friendly, nearest */
+    spawn(2, 1, 0.0f, 60.0f);      /* hostile, cloaked */
+    spawn(3, 1, 0.0f, 500.0f);     /* hostile, visible */
+    g_ships[2].cloak_state = BC_CLOAK_CLOAKED;
+    bc_bot_add(&g_world, &g_ships[0], g_cls);
+    bc_bot_add_contact(&g_world, &g_ships[1]);
+    bc_bot_add_contact(&g_world, &g_ships[2]);
+    bc_bot_add_contact(&g_world, &g_ships[3]);
+
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT(g_world.bots[0].target == &g_ships[3]);
+
+    /* Decloak: picked up at the next rebuild + decision */
+    g_ships[2].cloak_state = BC_CLOAK_DECLOAKED;
+    for (int t = 0; t < g_world.cfg.think_interval; t++)
+        bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT(g_world.bots[0].target == &g_ships[2]);
+}
+
+TEST(dead_or_removed_target_replans)
+{
+    ASSERT(load_registry());
+    reset_world(NULL);
+    spawn(0, 0, 0.0f, 0.0f);
+    spawn(1, 1, 0.0f, 300.0f);
+    spawn(2, 1, 0.0f, 600.0f);
+    bc_bot_add(&g_world, &g_ships[0], g_cls);
+    bc_bot_add_contact(&g_world, &g_ships[1]);
+    bc_bot_add_contact(&g_world, &g_ships[2]);
+
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT(g_world.bots[0].target == &g_ships[1]);
+
+    /* Kill between decisions: the very next tick re-targets */
+    g_ships[1].alive = false;
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT(g_world.bots[0].target == &g_ships[2]);
+
+    /* Removing the contact clears the pointer; nothing left -> idle */
+    bc_bot_remove_contact(&g_world, &g_ships[2]);
+    ASSERT(g_world.bots[0].target == NULL);
+    bc_bot_world_tick(&g_world, 0.033f);
+    ASSERT_EQ_INT(g_world.bots[0].state, BC_BOT_IDLE);
+    ASSERT(g_ships[0].speed == 0.0f);
+}
+
+TEST(remove_renumbers_queue)
+{
+    ASSERT(load_registry());
+    bc_bot_cfg_t cfg;
+    bc_bot_cfg_defaults(&cfg);
+    cfg.think_interval = 1;
+    cfg.max_decisions  = 1;
+    cfg.budget_us      = 0;
+    reset_world(&cfg);
+    for (int i = 0; i < 4; i++) {
+        spawn(i, (u8)(i & 1), (f32)(i * 10), 0.0f);
+        bc_bot_add(&g_world, &g_ships[i], g_cls);
+    }
+    bc_bot_world_tick(&g_world, 0.033f);      /* bot 0 thinks; 1,2,3 wait */
+    ASSERT_EQ_INT(g_world.queue_len, 3);
+
+    bc_bot_remove(&g_world, 1);               /* bot 3 becomes bot 1 */
+    ASSERT_EQ_INT(g_world.bot_count, 3);
+    ASSERT(g_world.bots[1].ship == &g_ships[3]);
+    ASSERT_EQ_INT(g_world.queue_len, 2);
+    ASSERT_EQ_INT(g_world.contact_count, 3);
+    for (int k = 0; k < g_world.queue_len; k++)
+        ASSERT(g_world.queue[(g_world.queue_head + k) % BC_BOT_MAX] < 3);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(decision_cap_and_fairness);
+    RUN(budget_limits_think_time);
+    RUN(approach_then_engage_and_fire);
+    RUN(perception_filters_team_and_cloak);
+    RUN(dead_or_removed_target_replans);
+    RUN(remove_renumbers_queue);
+TEST_MAIN_END()
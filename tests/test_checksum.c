@@ -1,6 +1,9 @@
 #include "test_util.h"
 #include "openbc/checksum.h"
 #include "openbc/manifest.h"
+#include "openbc/json_parse.h"
+#include <stdio.h>
+#include <stdlib.h>
 
 /* === StringHash tests === */
 
@@ -46,6 +49,23 @@ TEST(string_hash_different_inputs)
     ASSERT(h1 != h2);  /* Case-sensitive */
 }
 
+TEST(string_hash_many_matches_single)
+{
+    /* Mixed lengths (incl. empty) so lockstep pairs end at different
+     * bytes; an odd count leaves one string unpaired */
+    const char *names[] = {
+        "App.pyc", "", "Autoexec.pyc", "galaxy.pyc", "60",
+        "ships", "x", "MainMenu.pyc", "a_much_longer_file_name_here.pyc",
+        "Sovereign.pyc", "",
+    };
+    size_t n = sizeof(names) / sizeof(names[0]);
+    u32 out[sizeof(names) / sizeof(names[0])];
+    string_hash_many(names, n, out);
+    for (size_t i = 0; i < n; i++)
+        ASSERT_EQ(out[i], string_hash(names[i]));
+    string_hash_many(names, 0, out);   /* no-op */
+}
+
 /* === FileHash tests === */
 
 TEST(file_hash_empty)
@@ -127,6 +147,43 @@ TEST(file_hash_deterministic)
     ASSERT_EQ(h1, h2);
 }
 
+/* Serial definition of FileHash, as the client computes it */
+static u32 file_hash_ref(const u8 *data, size_t len)
+{
+    u32 hash = 0;
+    for (size_t i = 0; i < len / 4; i++) {
+        if (i == 1) continue;
+        u32 dword = (u32)data[i * 4] | ((u32)data[i * 4 + 1] << 8)
+                  | ((u32)data[i * 4 + 2] << 16) | ((u32)data[i * 4 + 3] << 24);
+        hash ^= dword;
+        hash = (hash << 1) | (hash >> 31);
+    }
+    for (size_t i = len & ~(size_t)3; i < len; i++) {
+        hash ^= (u32)(i32)(i8)data[i];
+        hash = (hash << 1) | (hash >> 31);
+    }
+    return hash;
+}
+
+TEST(file_hash_matches_serial_definition)
+{
+    /* Every length through several 128-byte lane blocks, at odd offsets
+     * so the vector loads are unaligned, plus one large buffer */
+    size_t big = 1 << 20;
+    u8 *buf = malloc(big + 3);
+    ASSERT(buf != NULL);
+    u32 x = 0x12345678u;
+    for (size_t i = 0; i < big + 3; i++) {
+        x = x * 1664525u + 1013904223u;
+        buf[i] = (u8)(x >> 24);
+    }
+    for (size_t len = 0; len <= 600; len++)
+        for (size_t off = 0; off < 3; off++)
+            ASSERT_EQ(file_hash(buf + off, len), file_hash_ref(buf + off, len));
+    ASSERT_EQ(file_hash(buf + 1, big + 1), file_hash_ref(buf + 1, big + 1));
+    free(buf);
+}
+
 /* === Manifest tests === */
 
 TEST(manifest_load_vanilla)
@@ -135,6 +192,7 @@ TEST(manifest_load_vanilla)
     ASSERT(bc_manifest_load(&m, "manifests/vanilla-1.1.json"));
     ASSERT_EQ_INT(m.dir_count, 4);
     ASSERT_EQ(m.version_hash, 0x7E0CE243);
+    bc_manifest_free(&m);
 }
 
 TEST(manifest_dir_hashes)
@@ -147,6 +205,7 @@ TEST(manifest_dir_hashes)
     ASSERT_EQ(m.dirs[2].dir_name_hash, 0xB831D315);
     /* Round 3: scripts/mainmenu/ */
     ASSERT_EQ(m.dirs[3].dir_name_hash, 0x3F7BF00A);
+    bc_manifest_free(&m);
 }
 
 TEST(manifest_file_count)
@@ -159,6 +218,7 @@ TEST(manifest_file_count)
     ASSERT_EQ_INT(m.dirs[1].file_count, 1);
     /* Round 3: 4 files */
     ASSERT_EQ_INT(m.dirs[3].file_count, 4);
+    bc_manifest_free(&m);
 }
 
 TEST(manifest_known_hashes)
@@ -171,6 +231,7 @@ TEST(manifest_known_hashes)
     /* Autoexec.pyc in round 1 */
     ASSERT_EQ(m.dirs[1].files[0].name_hash, 0x8501E6A1);
     ASSERT_EQ(m.dirs[1].files[0].content_hash, 0x17930067);
+    bc_manifest_free(&m);
 }
 
 TEST(manifest_subdirs)
@@ -181,6 +242,7 @@ TEST(manifest_subdirs)
     ASSERT_EQ_INT(m.dirs[2].subdir_count, 1);
     ASSERT_EQ(m.dirs[2].subdirs[0].name_hash, 0xCAAFFDD4);
     ASSERT(m.dirs[2].subdirs[0].file_count > 0);
+    bc_manifest_free(&m);
 }
 
 TEST(manifest_find_file)
@@ -193,6 +255,7 @@ TEST(manifest_find_file)
     ASSERT_EQ(f->content_hash, 0xF8A0A740);
     /* Non-existent file */
     ASSERT(bc_manifest_find_file(&m.dirs[0], 0xDEADBEEF) == NULL);
+    bc_manifest_free(&m);
 }
 
 TEST(manifest_find_subdir)
@@ -205,6 +268,150 @@ TEST(manifest_find_subdir)
     ASSERT(sd->file_count > 0);
     /* Non-existent subdir */
     ASSERT(bc_manifest_find_subdir(&m.dirs[2], 0xDEADBEEF) == NULL);
+    bc_manifest_free(&m);
+}
+
+/* Every entry of the JSON is reachable through the index with its own
+ * content hash, arrays are strictly sorted, and storage is exact. */
+static bool dir_index_matches_json(const bc_manifest_file_t *files, int count,
+                                   const json_value_t *jfiles)
+{
+    if ((int)json_array_len(jfiles) != count) return false;
+    for (int i = 1; i < count; i++)
+        if (files[i - 1].name_hash >= files[i].name_hash) return false;
+    for (size_t i = 0; i < json_array_len(jfiles); i++) {
+        const json_value_t *jf = json_array_get(jfiles, i);
+        u32 name = (u32)strtoul(json_string(json_get(jf, "name_hash")), NULL, 16);
+        u32 content = (u32)strtoul(json_string(json_get(jf, "content_hash")), NULL, 16);
+        const bc_manifest_file_t *f = bc_manifest_find_in(files, count, name);
+        if (!f || f->content_hash != content) return false;
+    }
+    return true;
+}
+
+TEST(manifest_index_matches_json)
+{
+    bc_manifest_t m;
+    ASSERT(bc_manifest_load(&m, "manifests/vanilla-1.1.json"));
+    json_value_t *root = json_load_file("manifests/vanilla-1.1.json");
+    ASSERT(root != NULL);
+    json_value_t *dirs = json_get(root, "directories");
+    ASSERT_EQ_INT((int)json_array_len(dirs), m.dir_count);
+
+    size_t entries = 0, subdirs = 0;
+    for (int d = 0; d < m.dir_count; d++) {
+        const bc_manifest_dir_t *md = &m.dirs[d];
+        const json_value_t *jd = json_array_get(dirs, (size_t)d);
+        ASSERT(dir_index_matches_json(md->files, md->file_count,
+                                      json_get(jd, "files")));
+        entries += (size_t)md->file_count;
+        subdirs += (size_t)md->subdir_count;
+        for (int s = 0; s < md->subdir_count; s++) {
+            const bc_manifest_subdir_t *sd = &md->subdirs[s];
+            ASSERT(bc_manifest_find_subdir(md, sd->name_hash) == sd);
+            entries += (size_t)sd->file_count;
+        }
+        const json_value_t *jsubs = json_get(jd, "subdirs");
+        for (size_t s = 0; s < json_array_len(jsubs); s++) {
+            const json_value_t *js = json_array_get(jsubs, s);
+            u32 name = (u32)strtoul(json_string(json_get(js, "name_hash")), NULL, 16);
+            const bc_manifest_subdir_t *sd = bc_manifest_find_subdir(md, name);
+            ASSERT(sd != NULL);
+            ASSERT(dir_index_matches_json(sd->files, sd->file_count,
+                                          json_get(js, "files")));
+        }
+    }
+    ASSERT(m.storage_size == entries * sizeof(bc_manifest_file_t) +
+                             subdirs * sizeof(bc_manifest_subdir_t));
+    json_free(root);
+    bc_manifest_free(&m);
+    ASSERT(m.storage == NULL);
+    ASSERT_EQ_INT(m.dir_count, 0);
+}
+
+TEST(manifest_unsorted_and_duplicates)
+{
+    const char *path = "build/tests/test_manifest_dups.json";
+    FILE *f = fopen(path, "wb");
+    ASSERT(f != NULL);
+    fputs("{\"version_string_hash\": \"0x1\", \"directories\": [\n"
+          " {\"dir_name_hash\": \"0xA\", \"files\": [\n"
+          "   {\"name_hash\": \"0x30\", \"content_hash\": \"0x3\"},\n"
+          "   {\"name_hash\": \"0x10\", \"content_hash\": \"0x1\"},\n"
+          "   {\"name_hash\": \"0x30\", \"content_hash\": \"0x99\"},\n"
+          "   {\"name_hash\": \"0x20\", \"content_hash\": \"0x2\"}],\n"
+          "  \"subdirs\": [\n"
+          "   {\"name_hash\": \"0x9\", \"files\": []},\n"
+          "   {\"name_hash\": \"0x5\", \"files\": [{\"name_hash\": \"0x7\", \"content_hash\": \"0x8\"}]}]},\n"
+          " {\"dir_name_hash\": \"0xB\"}]}\n", f);
+    fclose(f);
+
+    bc_manifest_t m;
+    ASSERT(bc_manifest_load(&m, path));
+    ASSERT_EQ_INT(m.dir_count, 2);
+    const bc_manifest_dir_t *d = &m.dirs[0];
+    ASSERT_EQ_INT(d->file_count, 3);
+    ASSERT_EQ(d->files[0].name_hash, 0x10);
+    ASSERT_EQ(d->files[2].name_hash, 0x30);
+    ASSERT_EQ(bc_manifest_find_file(d, 0x30)->content_hash, 0x3);  /* first wins */
+    ASSERT(bc_manifest_find_file(d, 0x15) == NULL);
+    ASSERT(bc_manifest_find_file(d, 0x40) == NULL);
+    ASSERT(bc_manifest_find_file(d, 0x01) == NULL);
+
+    ASSERT_EQ_INT(d->subdir_count, 2);
+    ASSERT_EQ(d->subdirs[0].name_hash, 0x5);
+    const bc_manifest_subdir_t *sd = bc_manifest_find_subdir(d, 0x5);
+    ASSERT(sd != NULL);
+    ASSERT_EQ(bc_manifest_find_subdir_file(sd, 0x7)->content_hash, 0x8);
+    ASSERT(bc_manifest_find_subdir(d, 0x9)->file_count == 0);
+
+    ASSERT_EQ_INT(m.dirs[1].file_count, 0);
+    ASSERT(bc_manifest_find_file(&m.dirs[1], 0x10) == NULL);
+    ASSERT(bc_manifest_find_subdir(&m.dirs[1], 0x5) == NULL);
+    bc_manifest_free(&m);
+    remove(path);
+}
+
+/* Write a one-directory manifest with `files` files at the top level, or
+ * in a single subdir when in_subdir is set. */
+static bool write_wide_manifest(const char *path, int files, bool in_subdir)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    fputs("{\"version_string_hash\": \"0x1\", \"directories\": [\n"
+          " {\"dir_name_hash\": \"0xA\", ", f);
+    fputs(in_subdir ? "\"subdirs\": [{\"name_hash\": \"0x5\", \"files\": ["
+                    : "\"files\": [", f);
+    for (int i = 0; i < files; i++)
+        fprintf(f, "%s{\"name_hash\": \"0x%X\", \"content_hash\": \"0x1\"}",
+                i ? ",\n" : "", 0x100 + i);
+    fputs(in_subdir ? "]}]}]}\n" : "]}]}\n", f);
+    fclose(f);
+    return true;
+}
+
+TEST(manifest_over_response_limits_refused)
+{
+    const char *path = "build/tests/test_manifest_wide.json";
+    bc_manifest_t m;
+
+    ASSERT(write_wide_manifest(path, BC_MANIFEST_MAX_DIR_FILES, false));
+    ASSERT(bc_manifest_load(&m, path));
+    ASSERT_EQ_INT(m.dirs[0].file_count, BC_MANIFEST_MAX_DIR_FILES);
+    bc_manifest_free(&m);
+
+    /* One more could never be reported in full: fail the load */
+    ASSERT(write_wide_manifest(path, BC_MANIFEST_MAX_DIR_FILES + 1, false));
+    ASSERT(!bc_manifest_load(&m, path));
+    ASSERT(m.storage == NULL);
+    ASSERT_EQ_INT(m.dir_count, 0);
+
+    ASSERT(write_wide_manifest(path, BC_MANIFEST_MAX_SUBDIR_FILES, true));
+    ASSERT(bc_manifest_load(&m, path));
+    bc_manifest_free(&m);
+    ASSERT(write_wide_manifest(path, BC_MANIFEST_MAX_SUBDIR_FILES + 1, true));
+    ASSERT(!bc_manifest_load(&m, path));
+    remove(path);
 }
 
 /* === Run all tests === */
@@ -217,6 +424,7 @@ TEST_MAIN_BEGIN()
     RUN(string_hash_single_char);
     RUN(string_hash_deterministic);
     RUN(string_hash_different_inputs);
+    RUN(string_hash_many_matches_single);
 
     /* FileHash */
     RUN(file_hash_empty);
@@ -227,6 +435,7 @@ TEST_MAIN_BEGIN()
     RUN(file_hash_remainder_sign_extension);
     RUN(file_hash_remainder_positive_byte);
     RUN(file_hash_deterministic);
+    RUN(file_hash_matches_serial_definition);
 
     /* Manifest */
     RUN(manifest_load_vanilla);
@@ -236,4 +445,7 @@ TEST_MAIN_BEGIN()
     RUN(manifest_subdirs);
     RUN(manifest_find_file);
     RUN(manifest_find_subdir);
+    RUN(manifest_index_matches_json);
+    RUN(manifest_unsorted_and_duplicates);
+    RUN(manifest_over_response_limits_refused);
 TEST_MAIN_END()
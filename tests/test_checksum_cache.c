@@ -0,0 +1,182 @@
+#include "test_util.h"
+#include "openbc/checksum_cache.h"
+#include "openbc/sha256.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the validated checksum response cache and the SHA-256
+ * digest that keys it. The handshake wiring (hit skips parse/validate) is
+ * exercised by the join-flow tests against a live server.
+ */
+
+static void hex_digest(const u8 *d, char out[BC_SHA256_SIZE * 2 + 1])
+{
+    static const char hex[] = "0123456789abcdef";
+    for (int i = 0; i < BC_SHA256_SIZE; i++) {
+        out[i * 2]     = hex[d[i] >> 4];
+        out[i * 2 + 1] = hex[d[i] & 0xF];
+    }
+    out[BC_SHA256_SIZE * 2] = '\0';
+}
+
+TEST(sha256_vectors)
+{
+    u8 d[BC_SHA256_SIZE];
+    char s[BC_SHA256_SIZE * 2 + 1];
+
+    bc_sha256("", 0, d);
+    hex_digest(d, s);
+    ASSERT(strcmp(s, "e3b0c44298fc1c149afbf4c8996fb924"
+                     "27ae41e4649b934ca495991b7852b855") == 0);
+
+    bc_sha256("abc", 3, d);
+    hex_digest(d, s);
+    ASSERT(strcmp(s, "ba7816bf8f01cfea414140de5dae2223"
+                     "b00361a396177a9cb410ff61f20015ad") == 0);
+
+    const char *m = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    bc_sha256(m, strlen(m), d);
+    hex_digest(d, s);
+    ASSERT(strcmp(s, "248d6a61d20638b8e5c026930c3e6039"
+                     "a33ce45964ff2167f6ecedd419db06c1") == 0);
+}
+
+TEST(sha256_incremental_matches_oneshot)
+{
+    u8 buf[300];
+    for (int i = 0; i < (int)sizeof(buf); i++) buf[i] = (u8)(i * 7 + 3);
+
+    u8 whole[BC_SHA256_SIZE];
+    bc_sha256(buf, sizeof(buf), whole);
+
+    /* Split points straddle the 55/56/64-byte padding boundaries */
+    static const size_t steps[] = { 1, 55, 1, 7, 64, 100, 72 };
+    bc_sha256_t ctx;
+    bc_sha256_init(&ctx);
+    size_t off = 0;
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        bc_sha256_update(&ctx, buf + off, steps[i]);
+        off += steps[i];
+    }
+    ASSERT_EQ(sizeof(buf), off);
+    u8 parts[BC_SHA256_SIZE];
+    bc_sha256_final(&ctx, parts);
+    ASSERT(memcmp(whole, parts, BC_SHA256_SIZE) == 0);
+}
+
+static void key_for(int n, u8 round, u8 key[BC_SHA256_SIZE])
+{
+    u8 payload[8] = { 0x21, round, (u8)n, (u8)(n >> 8), 1, 2, 3, 4 };
+    bc_checksum_cache_key(round, payload, (int)sizeof(payload), key);
+}
+
+TEST(hit_after_insert)
+{
+    bc_checksum_cache_t c;
+    ASSERT(bc_checksum_cache_init(&c, 8));
+    u8 k[BC_SHA256_SIZE];
+    key_for(1, 0, k);
+
+    ASSERT(!bc_checksum_cache_lookup(&c, k));
+    bc_checksum_cache_insert(&c, k);
+    ASSERT(bc_checksum_cache_lookup(&c, k));
+    bc_checksum_cache_insert(&c, k);   /* duplicate is a no-op */
+    ASSERT_EQ_INT(1, c.count);
+    ASSERT_EQ_INT(1, (int)c.hits);
+    ASSERT_EQ_INT(1, (int)c.misses);
+    bc_checksum_cache_free(&c);
+}
+
+TEST(round_is_part_of_key)
+{
+    /* Same payload bytes validated for round 0 must not pass round 2 */
+    u8 payload[4] = { 0x21, 0x00, 0xAA, 0xBB };
+    u8 k0[BC_SHA256_SIZE], k2[BC_SHA256_SIZE];
+    bc_checksum_cache_key(0, payload, 4, k0);
+    bc_checksum_cache_key(2, payload, 4, k2);
+    ASSERT(memcmp(k0, k2, BC_SHA256_SIZE) != 0);
+
+    bc_checksum_cache_t c;
+    ASSERT(bc_checksum_cache_init(&c, 4));
+    bc_checksum_cache_insert(&c, k0);
+    ASSERT(bc_checksum_cache_lookup(&c, k0));
+    ASSERT(!bc_checksum_cache_lookup(&c, k2));
+    bc_checksum_cache_free(&c);
+}
+
+TEST(lru_eviction)
+{
+    bc_checksum_cache_t c;
+    ASSERT(bc_checksum_cache_init(&c, 3));
+    u8 k[5][BC_SHA256_SIZE];
+    for (int i = 0; i < 5; i++) key_for(i, 1, k[i]);
+
+    bc_checksum_cache_insert(&c, k[0]);
+    bc_checksum_cache_insert(&c, k[1]);
+    bc_checksum_cache_insert(&c, k[2]);
+    ASSERT(bc_checksum_cache_lookup(&c, k[0]));   /* 1 is now oldest */
+
+    bc_checksum_cache_insert(&c, k[3]);           /* evicts 1 */
+    ASSERT(!bc_checksum_cache_lookup(&c, k[1]));
+    ASSERT(bc_checksum_cache_lookup(&c, k[0]));
+    ASSERT(bc_checksum_cache_lookup(&c, k[2]));
+    ASSERT(bc_checksum_cache_lookup(&c, k[3]));
+
+    bc_checksum_cache_insert(&c, k[4]);           /* evicts 0 */
+    ASSERT(!bc_checksum_cache_lookup(&c, k[0]));
+    ASSERT(bc_checksum_cache_lookup(&c, k[4]));
+    ASSERT_EQ_INT(3, c.count);
+    ASSERT_EQ_INT(2, (int)c.evictions);
+    bc_checksum_cache_free(&c);
+}
+
+TEST(churn_keeps_chains_consistent)
+{
+    /* Far more distinct keys than slots: every resident key stays findable */
+    bc_checksum_cache_t c;
+    ASSERT(bc_checksum_cache_init(&c, 16));
+    u8 k[BC_SHA256_SIZE];
+    for (int i = 0; i < 1000; i++) {
+        key_for(i, (u8)(i & 3), k);
+        bc_checksum_cache_insert(&c, k);
+    }
+    ASSERT_EQ_INT(16, c.count);
+    for (int i = 1000 - 16; i < 1000; i++) {
+        key_for(i, (u8)(i & 3), k);
+        ASSERT(bc_checksum_cache_lookup(&c, k));
+    }
+    key_for(1000 - 17, (u8)((1000 - 17) & 3), k);
+    ASSERT(!bc_checksum_cache_lookup(&c, k));
+    bc_checksum_cache_free(&c);
+}
+
+TEST(clear_and_disabled)
+{
+    bc_checksum_cache_t c;
+    ASSERT(bc_checksum_cache_init(&c, 4));
+    u8 k[BC_SHA256_SIZE];
+    key_for(7, 0xFF, k);
+    bc_checksum_cache_insert(&c, k);
+    bc_checksum_cache_clear(&c);      /* manifest changed */
+    ASSERT(!bc_checksum_cache_lookup(&c, k));
+    ASSERT_EQ_INT(0, c.count);
+    bc_checksum_cache_free(&c);
+
+    ASSERT(bc_checksum_cache_init(&c, 0));
+    ASSERT(!bc_checksum_cache_enabled(&c));
+    bc_checksum_cache_insert(&c, k);
+    ASSERT(!bc_checksum_cache_lookup(&c, k));
+    ASSERT_EQ_INT(0, (int)c.misses);
+    bc_checksum_cache_free(&c);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(sha256_vectors);
+    RUN(sha256_incremental_matches_oneshot);
+    RUN(hit_after_insert);
+    RUN(round_is_part_of_key);
+    RUN(lru_eviction);
+    RUN(churn_keeps_chains_consistent);
+    RUN(clear_and_disabled);
+TEST_MAIN_END()
@@ -13,6 +13,9 @@
  *   C. search_radius parameter expands each subsystem's effective AABB radius
  *      for the hit test (was incorrectly used as shield HP multiplier).
  *
+ * Also checks that the per-class subsystem BVH returns exactly the same hit
+ * list as the linear scan (bvh_node_count = 0 forces the linear path).
+ *
  * Test ship: Galaxy-class (species_id=3, loaded from registry).
  * Subsystems referenced:
  *   Forward Torpedo 1..4  torpedo_tube  pos=[0,-0.25,-0.25]  r=0.20  HP=2400
@@ -209,9 +212,104 @@ TEST(search_radius_expands_hit_set)
     }
 }
 
+/* Deterministic LCG so BVH equivalence sweeps are reproducible. */
+static u32 g_rng = 0x1234567u;
+static f32 rand_range(f32 lo, f32 hi)
+{
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (f32)(g_rng >> 8) / (f32)(1u << 24);
+}
+
+/* Compare BVH and linear hit lists for one query. Returns 1 if identical. */
+static bc_ship_class_t g_linear_cls;
+static int hits_match(const bc_ship_class_t *cls, bc_vec3_t p, f32 dr, f32 sr,
+                      int max_out)
+{
+    int a[BC_MAX_SUBSYSTEMS], b[BC_MAX_SUBSYSTEMS];
+    int na = bc_combat_find_hit_subsystems(cls, p, dr, sr, a, max_out);
+    int nb = bc_combat_find_hit_subsystems(&g_linear_cls, p, dr, sr, b, max_out);
+    if (na != nb) return 0;
+    for (int i = 0; i < na; i++)
+        if (a[i] != b[i]) return 0;
+    return 1;
+}
+
+TEST(bvh_matches_linear_scan_registry)
+{
+    for (int c = 0; c < g_reg.ship_count; c++) {
+        const bc_ship_class_t *cls = bc_registry_get_ship(&g_reg, c);
+        ASSERT(cls != NULL);
+        if (cls->subsystem_count > 0) ASSERT(cls->bvh_node_count > 0);
+
+        g_linear_cls = *cls;
+        g_linear_cls.bvh_node_count = 0;
+
+        f32 ext = cls->bounding_extent * 1.25f;
+        static const f32 srs[] = { 0.0f, 1.0f, 1.5f, 3.0f };
+        for (int q = 0; q < 2000; q++) {
+            bc_vec3_t p = { rand_range(-ext, ext), rand_range(-ext, ext),
+                            rand_range(-ext, ext) };
+            f32 dr = rand_range(0.0f, ext * 0.5f);
+            f32 sr = srs[q % 4];
+            ASSERT(hits_match(cls, p, dr, sr, BC_MAX_SUBSYSTEMS));
+            ASSERT(hits_match(cls, p, dr, sr, 3));
+        }
+
+        /* Exact subsystem centers, including boundary-touching queries */
+        for (int i = 0; i < cls->subsystem_count; i++) {
+            bc_vec3_t p = cls->subsystems[i].position;
+            ASSERT(hits_match(cls, p, 0.0f, 1.0f, BC_MAX_SUBSYSTEMS));
+            p.x += cls->subsystems[i].radius;
+            ASSERT(hits_match(cls, p, 0.0f, 1.0f, BC_MAX_SUBSYSTEMS));
+        }
+    }
+}
+
+/* Synthetic 64-hardpoint class: full-size tree, zero-radius entries skipped,
+ * ascending output order and max_out truncation preserved. */
+static bc_ship_class_t g_big_cls;
+
+TEST(bvh_matches_linear_scan_full_hardpoints)
+{
+    memset(&g_big_cls, 0, sizeof(g_big_cls));
+    g_big_cls.subsystem_count = BC_MAX_SUBSYSTEMS;
+    for (int i = 0; i < BC_MAX_SUBSYSTEMS; i++) {
+        bc_subsystem_def_t *ss = &g_big_cls.subsystems[i];
+        ss->position.x = rand_range(-2.0f, 2.0f);
+        ss->position.y = rand_range(-4.0f, 4.0f);
+        ss->position.z = rand_range(-1.0f, 1.0f);
+        ss->radius = (i % 9 == 0) ? 0.0f : rand_range(0.05f, 0.6f);
+    }
+    bc_ship_class_build_bvh(&g_big_cls);
+    ASSERT(g_big_cls.bvh_node_count > 1);
+    ASSERT(g_big_cls.bvh_node_count <= BC_SS_BVH_MAX_NODES);
+
+    g_linear_cls = g_big_cls;
+    g_linear_cls.bvh_node_count = 0;
+
+    for (int q = 0; q < 5000; q++) {
+        bc_vec3_t p = { rand_range(-3.0f, 3.0f), rand_range(-5.0f, 5.0f),
+                        rand_range(-2.0f, 2.0f) };
+        f32 dr = rand_range(0.0f, 1.5f);
+        f32 sr = (q & 1) ? 1.5f : 1.0f;
+        ASSERT(hits_match(&g_big_cls, p, dr, sr, BC_MAX_SUBSYSTEMS));
+        ASSERT(hits_match(&g_big_cls, p, dr, sr, 1 + q % 8));
+    }
+
+    /* Damage volume covering the whole ship: every non-zero-radius index */
+    int out[BC_MAX_SUBSYSTEMS];
+    bc_vec3_t origin = { 0.0f, 0.0f, 0.0f };
+    int n = bc_combat_find_hit_subsystems(&g_big_cls, origin, 100.0f, 1.0f,
+                                          out, BC_MAX_SUBSYSTEMS);
+    ASSERT_EQ_INT(n, BC_MAX_SUBSYSTEMS - (BC_MAX_SUBSYSTEMS + 8) / 9);
+    for (int i = 1; i < n; i++) ASSERT(out[i] > out[i - 1]);
+}
+
 TEST_MAIN_BEGIN()
     RUN(load_registry);
     RUN(subsystem_absorbs_full_before_hull);
     RUN(no_parent_propagation);
     RUN(search_radius_expands_hit_set);
+    RUN(bvh_matches_linear_scan_registry);
+    RUN(bvh_matches_linear_scan_full_hardpoints);
 TEST_MAIN_END()
@@ -82,6 +82,10 @@ TEST(test_defaults)
 
     ASSERT(cfg.registry[0]       == '\0');
     ASSERT(cfg.manifest_path[0]  == '\0');
+    ASSERT(cfg.registry_cache[0] == '\0');
+    ASSERT_EQ_INT(64, cfg.checksum_cache);
+    ASSERT(cfg.live_reload       == false);
+    ASSERT_EQ_INT(5, cfg.reload_poll);
     ASSERT_EQ_INT(0, cfg.mod_pack_count);
 
     ASSERT(cfg.gamespy_enabled == true);
@@ -212,10 +216,19 @@ TEST(test_load_str_data_section)
         "[data]\n"
         "registry  = \"data/vanilla-1.1/\"\n"
         "manifest  = \"manifests/vanilla-1.1.json\"\n"
+        "registry_cache = \"cache/registry.cache\"\n"
+        "checksum_cache = 256\n"
+        "live_reload = true\n"
+        "reload_poll = 0\n"
         "mod_packs = [\"mods/pack1/\", \"mods/pack2/\"]\n";
 
     ASSERT(obc_config_load_str(toml, &cfg) == true);
 
+    ASSERT(strcmp(cfg.registry_cache, "cache/registry.cache") == 0);
+    ASSERT_EQ_INT(256, cfg.checksum_cache);
+    ASSERT(cfg.live_reload == true);
+    ASSERT_EQ_INT(0, cfg.reload_poll);
+
     ASSERT(strcmp(cfg.registry,      "data/vanilla-1.1/") == 0);
     ASSERT(strcmp(cfg.manifest_path, "manifests/vanilla-1.1.json") == 0);
     ASSERT_EQ_INT(2, cfg.mod_pack_count);
@@ -247,6 +260,83 @@ TEST(test_load_str_gamespy_section)
     ASSERT_EQ_INT(120, cfg.heartbeat_interval);
 }
 
+TEST(test_load_str_interest_section)
+{
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    ASSERT(cfg.interest_enabled == true);
+    ASSERT(cfg.interest_near < cfg.interest_far);
+
+    const char *toml =
+        "[interest]\n"
+        "enabled       = false\n"
+        "near_distance = 150\n"      /* integer form accepted */
+        "far_distance  = 900.5\n"
+        "min_rate      = 0.5\n";
+
+    ASSERT(obc_config_load_str(toml, &cfg) == true);
+    ASSERT(cfg.interest_enabled == false);
+    ASSERT(fabs(cfg.interest_near - 150.0) < 1e-9);
+    ASSERT(fabs(cfg.interest_far - 900.5) < 1e-9);
+    ASSERT(fabs(cfg.interest_min_rate - 0.5) < 1e-9);
+
+    /* Out-of-range values keep the previous value */
+    ASSERT(obc_config_load_str("[interest]\nmin_rate = 1.5\n"
+                               "near_distance = -1.0\n", &cfg) == true);
+    ASSERT(fabs(cfg.interest_min_rate - 0.5) < 1e-9);
+    ASSERT(fabs(cfg.interest_near - 150.0) < 1e-9);
+}
+
+TEST(test_load_str_jobs_section)
+{
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    ASSERT_EQ_INT(2, cfg.job_workers);
+    ASSERT_EQ_INT(1, cfg.job_max_running);
+    ASSERT_EQ_INT(16, cfg.job_max_queued);
+
+    ASSERT(obc_config_load_str("[jobs]\n"
+                               "workers = 0\n"
+                               "module_max_running = 3\n"
+                               "module_max_queued = 64\n", &cfg) == true);
+    ASSERT_EQ_INT(0, cfg.job_workers);
+    ASSERT_EQ_INT(3, cfg.job_max_running);
+    ASSERT_EQ_INT(64, cfg.job_max_queued);
+
+    /* Out-of-range values keep the previous value */
+    ASSERT(obc_config_load_str("[jobs]\nworkers = 99\n"
+                               "module_max_queued = 0\n", &cfg) == true);
+    ASSERT_EQ_INT(0, cfg.job_workers);
+    ASSERT_EQ_INT(64, cfg.job_max_queued);
+}
+
+TEST(test_load_str_bots_section)
+{
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    ASSERT_EQ_INT(0, cfg.bot_count);
+    ASSERT(cfg.bot_ship[0] == '\0');
+    ASSERT_EQ_INT(5, cfg.bot_think_interval);
+
+    ASSERT(obc_config_load_str("[bots]\n"
+                               "count = 4\n"
+                               "ship = \"Galaxy\"\n"
+                               "think_interval = 10\n"
+                               "max_decisions = 0\n"
+                               "budget_us = 500\n", &cfg) == true);
+    ASSERT_EQ_INT(4, cfg.bot_count);
+    ASSERT(strcmp(cfg.bot_ship, "Galaxy") == 0);
+    ASSERT_EQ_INT(10, cfg.bot_think_interval);
+    ASSERT_EQ_INT(0, cfg.bot_max_decisions);
+    ASSERT_EQ_INT(500, cfg.bot_budget_us);
+
+    /* Out-of-range values keep the previous value */
+    ASSERT(obc_config_load_str("[bots]\ncount = 33\n"
+                               "think_interval = 0\n", &cfg) == true);
+    ASSERT_EQ_INT(4, cfg.bot_count);
+    ASSERT_EQ_INT(10, cfg.bot_think_interval);
+}
+
 TEST(test_load_str_modules)
 {
     obc_server_cfg_t cfg;
@@ -513,6 +603,9 @@ int main(void)
     RUN(test_load_str_int_range_valid_boundaries);
     RUN(test_load_str_data_section);
     RUN(test_load_str_gamespy_section);
+    RUN(test_load_str_interest_section);
+    RUN(test_load_str_jobs_section);
+    RUN(test_load_str_bots_section);
     RUN(test_load_str_modules);
     RUN(test_load_str_absent_fields_unchanged);
     RUN(test_load_nonexistent_returns_false);
@@ -0,0 +1,68 @@
+#include "test_util.h"
+#include "openbc/damage_ledger.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the sparse per-victim damage ledger
+ * (src/server/damage_ledger.c).
+ */
+
+static bc_damage_ledger_t g_l;
+
+TEST(accumulates_per_attacker_sorted)
+{
+    bc_ledger_clear(&g_l);
+    bc_ledger_add(&g_l, 5, 10.0f, 0.0f);
+    bc_ledger_add(&g_l, 2, 0.0f, 4.0f);
+    bc_ledger_add(&g_l, 5, 1.0f, 2.0f);
+    bc_ledger_add(&g_l, 3, -3.0f, -3.0f);  /* team damage */
+
+    ASSERT_EQ_INT(3, g_l.count);
+    ASSERT_EQ_INT(2, g_l.entries[0].attacker);
+    ASSERT_EQ_INT(3, g_l.entries[1].attacker);
+    ASSERT_EQ_INT(5, g_l.entries[2].attacker);
+
+    const bc_damage_ledger_entry_t *e = bc_ledger_find(&g_l, 5);
+    ASSERT(e != NULL);
+    ASSERT(e->shield_damage == 11.0f);
+    ASSERT(e->hull_damage == 2.0f);
+    ASSERT(bc_ledger_find(&g_l, 4) == NULL);
+}
+
+TEST(forget_and_clear)
+{
+    bc_ledger_clear(&g_l);
+    for (int a = 1; a <= 4; a++) bc_ledger_add(&g_l, a, (f32)a, 0.0f);
+    bc_ledger_forget(&g_l, 2);
+    bc_ledger_forget(&g_l, 7);  /* absent: no-op */
+    ASSERT_EQ_INT(3, g_l.count);
+    ASSERT(bc_ledger_find(&g_l, 2) == NULL);
+    ASSERT_EQ_INT(3, g_l.entries[1].attacker);
+
+    bc_ledger_clear(&g_l);
+    ASSERT_EQ_INT(0, g_l.count);
+    ASSERT(bc_ledger_find(&g_l, 1) == NULL);
+}
+
+TEST(full_ledger_evicts_smallest_contributor)
+{
+    bc_ledger_clear(&g_l);
+    for (int a = 1; a <= BC_LEDGER_MAX_ATTACKERS; a++)
+        bc_ledger_add(&g_l, a * 2, 100.0f + (f32)a, 0.0f);
+    /* Make attacker 6 the smallest absolute contribution */
+    bc_ledger_add(&g_l, 6, -102.0f, 0.0f);
+
+    bc_ledger_add(&g_l, 1, 50.0f, 0.0f);
+    ASSERT_EQ_INT(BC_LEDGER_MAX_ATTACKERS, g_l.count);
+    ASSERT(bc_ledger_find(&g_l, 6) == NULL);
+    ASSERT(bc_ledger_find(&g_l, 1) != NULL);
+    for (int i = 1; i < g_l.count; i++)
+        ASSERT(g_l.entries[i].attacker > g_l.entries[i - 1].attacker);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(accumulates_per_attacker_sorted);
+    RUN(forget_and_clear);
+    RUN(full_ledger_evicts_smallest_contributor);
+TEST_MAIN_END()
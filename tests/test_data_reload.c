@@ -0,0 +1,303 @@
+#include "test_util.h"
+#include "openbc/data_reload.h"
+#include "openbc/server_state.h"
+#include "openbc/ship_snapshot.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for live data reload (src/server/data_reload.c).
+ *
+ * Uses a real job pool and small monolith registries written under
+ * build/tests. Covers forced reloads, change scans that find nothing,
+ * a failed load keeping the current data, ships pinned to the generation
+ * they spawned with, class indices carried across a reload that reorders
+ * the ships, and the manifest swap emptying the checksum cache.
+ */
+
+#define REG_PATH       "build/tests/test_data_reload_registry.json"
+#define MANIFEST_PATH  "build/tests/test_data_reload_manifest.json"
+
+static void write_text(const char *path, const char *text)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return;
+    fputs(text, f);
+    fclose(f);
+}
+
+static void write_registry(int species)
+{
+    char text[512];
+    snprintf(text, sizeof(text),
+             "{\"projectiles\": [{\"name\": \"Probe Torpedo\", \"net_type_id\": 9}],\n"
+             " \"ships\": [{\"name\": \"Probe\", \"species_id\": %d,\n"
+             "   \"subsystems\": [{\"name\": \"Hull\", \"type\": \"hull\","
+             " \"max_condition\": 900}]}]}\n", species);
+    write_text(REG_PATH, text);
+}
+
+/* Two one-subsystem ships, in the given order */
+static void write_registry_pair(int first, int second)
+{
+    char text[768];
+    snprintf(text, sizeof(text),
+             "{\"ships\": [\n"
+             "  {\"name\": \"S%d\", \"species_id\": %d, \"subsystems\":"
+             " [{\"name\": \"Hull\", \"type\": \"hull\", \"max_condition\": 900}]},\n"
+             "  {\"name\": \"S%d\", \"species_id\": %d, \"subsystems\":"
+             " [{\"name\": \"Hull\", \"type\": \"hull\", \"max_condition\": 900}]}]}\n",
+             first, first, second, second);
+    write_text(REG_PATH, text);
+}
+
+static bool copy_file(const char *from, const char *to)
+{
+    FILE *in = fopen(from, "rb");
+    if (!in) return false;
+    FILE *out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return false;
+    }
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) fwrite(buf, 1, n, out);
+    fclose(in);
+    fclose(out);
+    return true;
+}
+
+/* Tick until no pass is due, running or waiting to be published */
+static void run_until_idle(bc_reload_t *r)
+{
+    do {
+        bc_job_poll(r->pool, 0);
+        bc_reload_tick(r, 0.0f);
+    } while (r->busy || r->pending || r->ready);
+}
+
+static bool setup_registry(int species)
+{
+    write_registry(species);
+    g_registry = calloc(1, sizeof(*g_registry));
+    if (!g_registry || !bc_registry_load(g_registry, REG_PATH)) return false;
+    g_registry_loaded = true;
+    return bc_peers_init(&g_peers, 4);
+}
+
+static void teardown(bc_reload_t *r, bc_job_pool_t *pool)
+{
+    bc_reload_shutdown(r);
+    bc_job_pool_destroy(pool);
+    free(g_registry);
+    g_registry = NULL;
+    g_registry_loaded = false;
+    bc_peers_free(&g_peers);
+    remove(REG_PATH);
+}
+
+static int add_peer(void)
+{
+    bc_addr_t a;
+    memset(&a, 0, sizeof(a));
+    a.ip = 0x0100007F;
+    a.port = 22101;
+    return bc_peers_add(&g_peers, &a);
+}
+
+TEST(no_pool_is_inert)
+{
+    bc_reload_t r;
+    bc_reload_src_t src;
+    memset(&src, 0, sizeof(src));
+    snprintf(src.registry, sizeof(src.registry), "%s", REG_PATH);
+    ASSERT(!bc_reload_init(&r, &src, NULL, true, 1));
+    bc_reload_request(&r);
+    bc_reload_tick(&r, 10.0f);
+    ASSERT(!r.busy && !r.pending);
+    bc_reload_shutdown(&r);
+}
+
+TEST(request_publishes_and_pins_spawned_ships)
+{
+    ASSERT(setup_registry(77));
+    bc_job_pool_t *pool = bc_job_pool_create(1);
+    ASSERT(pool != NULL);
+
+    bc_reload_t r;
+    bc_reload_src_t src;
+    memset(&src, 0, sizeof(src));
+    snprintf(src.registry, sizeof(src.registry), "%s", REG_PATH);
+    ASSERT(bc_reload_init(&r, &src, pool, false, 0));
+    run_until_idle(&r);                 /* baseline fingerprint */
+    ASSERT_EQ_INT(0, (int)r.reloads);
+
+    /* A ship flying on the first generation */
+    const bc_game_registry_t *first = g_registry;
+    int slot = add_peer();
+    ASSERT(slot >= 0);
+    bc_peer_t *p = &g_peers.peers[slot];
+    p->has_ship = true;
+    p->class_index = 0;
+    p->registry = first;
+
+    write_registry(78);
+    bc_reload_request(&r);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(1, (int)r.reloads);
+    ASSERT(g_registry != first);
+    ASSERT(bc_registry_find_ship(g_registry, 78) != NULL);
+    ASSERT(bc_registry_find_ship(g_registry, 77) == NULL);
+
+    /* The spawned ship keeps its class until it respawns */
+    ASSERT_EQ_INT(1, r.retired_count);
+    ASSERT_EQ_INT(77, bc_peer_class(p)->species_id);
+
+    /* Ship gone: the old generation is freed and forgotten */
+    p->has_ship = false;
+    bc_reload_tick(&r, 0.0f);
+    ASSERT_EQ_INT(0, r.retired_count);
+    ASSERT(p->registry == NULL);
+
+    /* A forced reload of identical files still publishes */
+    bc_reload_request(&r);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(2, (int)r.reloads);
+    ASSERT_EQ_INT(0, r.retired_count);
+
+    teardown(&r, pool);
+}
+
+TEST(reordered_reload_keeps_class_indices_straight)
+{
+    ASSERT(setup_registry(77));
+    write_registry_pair(77, 78);
+    memset(g_registry, 0, sizeof(*g_registry));
+    ASSERT(bc_registry_load(g_registry, REG_PATH));
+    bc_job_pool_t *pool = bc_job_pool_create(1);
+    ASSERT(pool != NULL);
+
+    bc_reload_t r;
+    bc_reload_src_t src;
+    memset(&src, 0, sizeof(src));
+    snprintf(src.registry, sizeof(src.registry), "%s", REG_PATH);
+    ASSERT(bc_reload_init(&r, &src, pool, false, 0));
+    run_until_idle(&r);
+
+    /* Flying species 78, index 1 of the first generation */
+    const bc_game_registry_t *first = g_registry;
+    bc_peers_reserve_dedicated(&g_peers, "Dedi");
+    int slot = add_peer();
+    ASSERT(slot > 0);
+    bc_peer_t *p = &g_peers.peers[slot];
+    p->state = PEER_IN_GAME;
+    p->has_ship = true;
+    p->class_index = 1;
+    p->registry = first;
+
+    write_registry_pair(78, 77);
+    bc_reload_request(&r);
+    run_until_idle(&r);
+    ASSERT(g_registry != first);
+
+    /* Snapshot class_index is where the class sits now */
+    static bc_ship_snapshot_t snap;
+    ASSERT_EQ_INT(1, bc_ship_snapshot_build(&snap, &g_peers, g_registry));
+    ASSERT_EQ_INT(78, snap.ships[0].species);
+    ASSERT_EQ_INT(0, snap.ships[0].class_index);
+
+    /* Ship gone, generation freed: the peer's index follows its species */
+    p->has_ship = false;
+    bc_reload_tick(&r, 0.0f);
+    ASSERT_EQ_INT(0, r.retired_count);
+    ASSERT(p->registry == NULL);
+    ASSERT_EQ_INT(0, p->class_index);
+    ASSERT_EQ_INT(78, bc_peer_class(p)->species_id);
+
+    teardown(&r, pool);
+}
+
+TEST(scan_reloads_changes_only)
+{
+    ASSERT(setup_registry(77));
+    bc_job_pool_t *pool = bc_job_pool_create(1);
+    ASSERT(pool != NULL);
+
+    bc_reload_t r;
+    bc_reload_src_t src;
+    memset(&src, 0, sizeof(src));
+    snprintf(src.registry, sizeof(src.registry), "%s", REG_PATH);
+    ASSERT(bc_reload_init(&r, &src, pool, true, 1));
+    run_until_idle(&r);
+
+    /* Due scan, nothing changed */
+    const bc_game_registry_t *first = g_registry;
+    bc_reload_tick(&r, 1.0f);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(0, (int)r.reloads);
+    ASSERT(g_registry == first);
+
+    /* Half-written file: current data stays, not retried until it changes */
+    write_text(REG_PATH, "{\"ships\": [{\"name\": \"Probe\",");
+    bc_reload_tick(&r, 1.0f);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(0, (int)r.reloads);
+    ASSERT_EQ_INT(1, (int)r.failures);
+    ASSERT(g_registry == first);
+    bc_reload_tick(&r, 1.0f);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(1, (int)r.failures);
+
+    write_registry(79);
+    bc_reload_tick(&r, 1.0f);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(1, (int)r.reloads);
+    ASSERT(bc_registry_find_ship(g_registry, 79) != NULL);
+
+    teardown(&r, pool);
+}
+
+TEST(manifest_swap_clears_checksum_cache)
+{
+    ASSERT(copy_file("tests/fixtures/manifest.json", MANIFEST_PATH));
+    ASSERT(bc_manifest_load(&g_manifest, MANIFEST_PATH));
+    g_manifest_loaded = true;
+    ASSERT(bc_checksum_cache_init(&g_checksum_cache, 4));
+    u8 key[BC_SHA256_SIZE];
+    u8 payload[2] = { 0x21, 0 };
+    bc_checksum_cache_key(0, payload, 2, key);
+    bc_checksum_cache_insert(&g_checksum_cache, key);
+
+    bc_job_pool_t *pool = bc_job_pool_create(1);
+    ASSERT(pool != NULL);
+    bc_reload_t r;
+    bc_reload_src_t src;
+    memset(&src, 0, sizeof(src));
+    snprintf(src.manifest, sizeof(src.manifest), "%s", MANIFEST_PATH);
+    ASSERT(bc_reload_init(&r, &src, pool, false, 0));
+    run_until_idle(&r);
+
+    const void *old_storage = g_manifest.storage;
+    bc_reload_request(&r);
+    run_until_idle(&r);
+    ASSERT_EQ_INT(1, (int)r.reloads);
+    ASSERT(g_manifest.storage != old_storage);
+    ASSERT(g_manifest.dir_count > 0);
+    ASSERT_EQ_INT(0, g_checksum_cache.count);
+
+    bc_reload_shutdown(&r);
+    bc_job_pool_destroy(pool);
+    bc_manifest_free(&g_manifest);
+    g_manifest_loaded = false;
+    bc_checksum_cache_free(&g_checksum_cache);
+    remove(MANIFEST_PATH);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(no_pool_is_inert);
+    RUN(request_publishes_and_pins_spawned_ships);
+    RUN(reordered_reload_keeps_class_indices_straight);
+    RUN(scan_reloads_changes_only);
+    RUN(manifest_swap_clears_checksum_cache);
+TEST_MAIN_END()
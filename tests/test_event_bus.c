@@ -1,5 +1,6 @@
 #include "test_util.h"
 #include "openbc/event_bus.h"
+#include "openbc/server_events.h"
 
 #include <string.h>
 
@@ -116,6 +117,19 @@ static void handler_sub_during_fire(const obc_engine_api_t *api,
     g_call_count++;
 }
 
+/* Unsubscribes itself from "probe" and records whether the presence flag
+ * was still set afterwards (removal is deferred until the fire returns). */
+static bool g_flag_seen = false;
+static void handler_unsub_probe(const obc_engine_api_t *api,
+                                obc_event_ctx_t        *ctx)
+{
+    (void)api;
+    (void)ctx;
+    obc_event_unsubscribe("probe", handler_unsub_probe);
+    g_flag_seen = obc_event_has_subscribers(obc_event_register("probe"));
+    g_call_count++;
+}
+
 static void handler_shutdown_during_fire(const obc_engine_api_t *api,
                                          obc_event_ctx_t        *ctx)
 {
@@ -463,6 +477,328 @@ TEST(shutdown_during_fire_is_ignored)
     ASSERT_EQ_INT(g_call_count, 0);
 }
 
+TEST(register_returns_stable_ids)
+{
+    reset_state();
+    obc_event_id_t a = obc_event_register("ship_killed");
+    obc_event_id_t b = obc_event_register("chat_message");
+    ASSERT(a != OBC_EVENT_ID_INVALID);
+    ASSERT(b != OBC_EVENT_ID_INVALID);
+    ASSERT(a != b);
+    ASSERT_EQ_INT(obc_event_register("ship_killed"), a);
+    ASSERT(strcmp(obc_event_id_name(a), "ship_killed") == 0);
+
+    /* Subscribing by name reuses the interned entry */
+    obc_event_subscribe("chat_message", handler_a, 50);
+    ASSERT_EQ_INT(obc_event_register("chat_message"), b);
+
+    ASSERT_EQ_INT(obc_event_register(NULL), OBC_EVENT_ID_INVALID);
+    ASSERT_EQ_INT(obc_event_register(""), OBC_EVENT_ID_INVALID);
+    ASSERT(obc_event_id_name(OBC_EVENT_ID_INVALID) == NULL);
+    ASSERT(obc_event_id_name(1000) == NULL);
+}
+
+TEST(id_and_name_apis_interoperate)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("mixed");
+    ASSERT_EQ_INT(obc_event_subscribe_id(id, handler_b, 50), 0);
+    obc_event_subscribe("mixed", handler_a, 10);
+
+    /* Name fire reaches the ID subscriber and vice versa, in priority order */
+    obc_event_fire(NULL, "mixed", -1, NULL);
+    obc_event_fire_id(NULL, id, -1, NULL);
+    ASSERT_EQ_INT(g_call_count, 4);
+    ASSERT_EQ_INT(g_call_order[0], 'A');
+    ASSERT_EQ_INT(g_call_order[1], 'B');
+    ASSERT_EQ_INT(g_call_order[2], 'A');
+    ASSERT_EQ_INT(g_call_order[3], 'B');
+
+    obc_event_unsubscribe_id(id, handler_a);
+    g_call_count = 0;
+    obc_event_fire(NULL, "mixed", -1, NULL);
+    ASSERT_EQ_INT(g_call_count, 1);
+    ASSERT_EQ_INT(g_call_order[0], 'B');
+}
+
+TEST(invalid_and_stale_ids_rejected)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("stale");
+    ASSERT_EQ_INT(obc_event_subscribe_id(OBC_EVENT_ID_INVALID, handler_a, 50), -1);
+    ASSERT_EQ_INT(obc_event_subscribe_id(id, NULL, 50), -1);
+    obc_event_unsubscribe_id(12345, handler_a);            /* no crash */
+
+    obc_event_result_t r = obc_event_fire_id(NULL, -7, -1, NULL);
+    ASSERT(!r.cancelled && !r.suppress_relay);
+
+    /* IDs do not survive a bus reset */
+    obc_event_bus_init();
+    ASSERT_EQ_INT(obc_event_subscribe_id(id, handler_a, 50), -1);
+    obc_event_fire_id(NULL, id, -1, NULL);
+    ASSERT_EQ_INT(g_call_count, 0);
+}
+
+TEST(hashed_lookup_at_capacity)
+{
+    /* Fill the table, then make sure every name still resolves to its own
+     * entry (probe chains stay intact at full load). */
+    reset_state();
+    char name[32];
+    for (int i = 0; i < OBC_EVENT_MAX_EVENTS; i++) {
+        snprintf(name, sizeof(name), "evt_%d", i);
+        ASSERT_EQ_INT(obc_event_register(name), i);
+    }
+    ASSERT_EQ_INT(obc_event_register("one_too_many"), OBC_EVENT_ID_INVALID);
+    for (int i = 0; i < OBC_EVENT_MAX_EVENTS; i++) {
+        snprintf(name, sizeof(name), "evt_%d", i);
+        ASSERT_EQ_INT(obc_event_register(name), i);
+    }
+
+    obc_event_subscribe("evt_77", handler_c, 50);
+    obc_event_fire_id(NULL, 77, -1, NULL);
+    obc_event_fire(NULL, "evt_76", -1, NULL);
+    ASSERT_EQ_INT(g_call_count, 1);
+    ASSERT_EQ_INT(g_call_order[0], 'C');
+}
+
+TEST(presence_flag_tracks_subscriptions)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("flagged");
+    ASSERT(!obc_event_has_subscribers(id));
+
+    obc_event_subscribe("flagged", handler_a, 10);
+    obc_event_subscribe_id(id, handler_b, 50);
+    ASSERT(obc_event_has_subscribers(id));
+
+    /* Stays set while any subscriber remains */
+    obc_event_unsubscribe("flagged", handler_a);
+    ASSERT(obc_event_has_subscribers(id));
+    obc_event_unsubscribe_id(id, handler_b);
+    ASSERT(!obc_event_has_subscribers(id));
+
+    /* Unknown handler / invalid IDs never flip anything */
+    obc_event_unsubscribe_id(id, handler_c);
+    ASSERT(!obc_event_has_subscribers(id));
+    ASSERT(!obc_event_has_subscribers(OBC_EVENT_ID_INVALID));
+    ASSERT(!obc_event_has_subscribers(OBC_EVENT_MAX_EVENTS));
+
+    obc_event_subscribe_id(id, handler_a, 50);
+    obc_event_bus_init();
+    ASSERT(!obc_event_has_subscribers(id));
+}
+
+TEST(presence_flag_follows_deferred_changes)
+{
+    reset_state();
+    obc_event_id_t probe = obc_event_register("probe");
+    obc_event_subscribe("probe", handler_unsub_probe, 50);
+    g_flag_seen = false;
+    obc_event_fire_id(NULL, probe, -1, NULL);
+    ASSERT(g_flag_seen);                       /* still set mid-fire */
+    ASSERT(!obc_event_has_subscribers(probe)); /* cleared once flushed */
+
+    /* A deferred add keeps the flag set after its subscriber leaves */
+    g_call_count = 0;
+    obc_event_id_t sub = obc_event_register("sub_during");
+    obc_event_subscribe("sub_during", handler_sub_during_fire, 10);
+    obc_event_fire_id(NULL, sub, -1, NULL);
+    obc_event_unsubscribe("sub_during", handler_sub_during_fire);
+    ASSERT(obc_event_has_subscribers(sub));    /* handler_b was added */
+    obc_event_unsubscribe("sub_during", handler_b);
+    ASSERT(!obc_event_has_subscribers(sub));
+}
+
+TEST(server_event_catalog_registered)
+{
+    reset_state();
+    bc_server_events_register();
+    const obc_event_id_t *ids = (const obc_event_id_t *)&g_ev;
+    int n = (int)(sizeof(g_ev) / sizeof(obc_event_id_t));
+    for (int i = 0; i < n; i++) {
+        ASSERT(ids[i] != OBC_EVENT_ID_INVALID);
+        ASSERT(!obc_event_has_subscribers(ids[i]));
+        for (int j = 0; j < i; j++)
+            ASSERT(ids[i] != ids[j]);
+    }
+    ASSERT(strcmp(obc_event_id_name(g_ev.ship_killed), "ship_killed") == 0);
+
+    /* Name-based subscribers light up the engine's guard */
+    obc_event_subscribe("ship_damaged", handler_a, 50);
+    ASSERT(bc_server_event_wanted(g_ev.ship_damaged));
+    ASSERT(!bc_server_event_wanted(g_ev.ship_killed));
+}
+
+/* --- Deferred queue ------------------------------------------------------ */
+
+/* Records sender, first payload int and post_count of each dispatch. */
+static int g_post_seen[16][3];
+static void handler_post_record(const obc_engine_api_t *api, obc_event_ctx_t *ctx)
+{
+    (void)api;
+    if (g_call_count < 16) {
+        g_post_seen[g_call_count][0] = ctx->sender_slot;
+        g_post_seen[g_call_count][1] = ctx->event_data ? *(const int *)ctx->event_data : -1;
+        g_post_seen[g_call_count][2] = ctx->post_count;
+    }
+    g_call_count++;
+}
+
+/* Re-posts itself once per dispatch, payload incremented. */
+static obc_event_id_t g_chain_id;
+static void handler_post_again(const obc_engine_api_t *api, obc_event_ctx_t *ctx)
+{
+    (void)api;
+    int v = *(const int *)ctx->event_data + 1;
+    g_call_count++;
+    obc_event_post(g_chain_id, -1, &v, (int)sizeof(v), 0);
+}
+
+TEST(post_deferred_until_drain)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("posted");
+    obc_event_subscribe_id(id, handler_post_record, 50);
+
+    int v = 7;
+    ASSERT_EQ_INT(obc_event_post(id, 3, &v, (int)sizeof(v), 0), OBC_EVENT_POST_QUEUED);
+    v = 8;  /* payload was copied */
+    ASSERT_EQ_INT(obc_event_post(id, 4, &v, (int)sizeof(v), 0), OBC_EVENT_POST_QUEUED);
+    ASSERT_EQ_INT(obc_event_post(id, 5, NULL, 0, 0), OBC_EVENT_POST_QUEUED);
+    ASSERT_EQ_INT(g_call_count, 0);
+
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 3);
+    ASSERT_EQ_INT(g_call_count, 3);
+    ASSERT_EQ_INT(g_post_seen[0][0], 3);
+    ASSERT_EQ_INT(g_post_seen[0][1], 7);
+    ASSERT_EQ_INT(g_post_seen[0][2], 1);
+    ASSERT_EQ_INT(g_post_seen[1][1], 8);
+    ASSERT_EQ_INT(g_post_seen[2][1], -1);
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 0);
+
+    /* Direct fires report post_count 0 */
+    obc_event_fire_id(NULL, id, 1, &v);
+    ASSERT_EQ_INT(g_post_seen[3][2], 0);
+}
+
+TEST(post_coalesces_by_event_and_slot)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("coalesced");
+    obc_event_subscribe_id(id, handler_post_record, 50);
+
+    int v;
+    for (v = 1; v <= 5; v++)
+        obc_event_post(id, 2, &v, (int)sizeof(v), OBC_EVENT_POST_COALESCE);
+    v = 100;
+    obc_event_post(id, 6, &v, (int)sizeof(v), OBC_EVENT_POST_COALESCE);
+    v = 200;  /* no COALESCE flag: always its own entry */
+    ASSERT_EQ_INT(obc_event_post(id, 2, &v, (int)sizeof(v), 0), OBC_EVENT_POST_QUEUED);
+
+    /* A larger payload replacing a small one still lands intact */
+    unsigned char big[64];
+    memset(big, 0, sizeof(big));
+    v = 300;
+    memcpy(big, &v, sizeof(v));
+    ASSERT_EQ_INT(obc_event_post(id, 6, big, (int)sizeof(big), OBC_EVENT_POST_COALESCE),
+                  OBC_EVENT_POST_MERGED);
+
+    obc_event_queue_stats_t st;
+    obc_event_queue_stats(&st);
+    ASSERT_EQ_INT(st.depth, 3);
+    ASSERT_EQ_INT(st.coalesced, 5);
+
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 3);
+    ASSERT_EQ_INT(g_post_seen[0][0], 2);   /* first post's position */
+    ASSERT_EQ_INT(g_post_seen[0][1], 5);   /* latest payload */
+    ASSERT_EQ_INT(g_post_seen[0][2], 5);
+    ASSERT_EQ_INT(g_post_seen[1][0], 6);
+    ASSERT_EQ_INT(g_post_seen[1][1], 300);
+    ASSERT_EQ_INT(g_post_seen[1][2], 2);
+    ASSERT_EQ_INT(g_post_seen[2][1], 200);
+    ASSERT_EQ_INT(g_post_seen[2][2], 1);
+
+    /* Keys reset after a drain */
+    v = 9;
+    ASSERT_EQ_INT(obc_event_post(id, 2, &v, (int)sizeof(v), OBC_EVENT_POST_COALESCE),
+                  OBC_EVENT_POST_QUEUED);
+}
+
+TEST(posts_during_drain_wait_for_next)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("chain");
+    g_chain_id = id;
+    obc_event_subscribe_id(id, handler_post_again, 50);
+
+    int v = 0;
+    obc_event_post(id, -1, &v, (int)sizeof(v), 0);
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 1);
+    ASSERT_EQ_INT(g_call_count, 1);
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 1);
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 1);
+    ASSERT_EQ_INT(g_call_count, 3);
+
+    obc_event_queue_stats_t st;
+    obc_event_queue_stats(&st);
+    ASSERT_EQ_INT(st.depth, 1);
+    ASSERT_EQ_INT(st.dispatched, 3);
+}
+
+TEST(post_overflow_dropped_and_counted)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("flood");
+    obc_event_subscribe_id(id, handler_a, 50);
+
+    int v = 1;
+    for (int i = 0; i < OBC_EVENT_QUEUE_MAX; i++)
+        ASSERT_EQ_INT(obc_event_post(id, i, &v, (int)sizeof(v), 0), OBC_EVENT_POST_QUEUED);
+    ASSERT_EQ_INT(obc_event_post(id, 0, &v, (int)sizeof(v), 0), OBC_EVENT_POST_DROPPED);
+
+    /* Payload area bounds independently of the entry count */
+    obc_event_queue_drain(NULL);
+    static unsigned char blob[OBC_EVENT_POST_MAX_DATA];
+    int fit = OBC_EVENT_QUEUE_BYTES / OBC_EVENT_POST_MAX_DATA;
+    for (int i = 0; i < fit; i++)
+        ASSERT_EQ_INT(obc_event_post(id, i, blob, (int)sizeof(blob), 0), OBC_EVENT_POST_QUEUED);
+    ASSERT_EQ_INT(obc_event_post(id, 0, blob, (int)sizeof(blob), 0), OBC_EVENT_POST_DROPPED);
+
+    /* Oversized, invalid and inconsistent posts */
+    ASSERT_EQ_INT(obc_event_post(id, 0, blob, OBC_EVENT_POST_MAX_DATA + 1, 0),
+                  OBC_EVENT_POST_DROPPED);
+    ASSERT_EQ_INT(obc_event_post(OBC_EVENT_ID_INVALID, 0, NULL, 0, 0),
+                  OBC_EVENT_POST_DROPPED);
+    ASSERT_EQ_INT(obc_event_post(id, 0, NULL, 4, 0), OBC_EVENT_POST_DROPPED);
+
+    obc_event_queue_stats_t st;
+    obc_event_queue_stats(&st);
+    ASSERT_EQ_INT(st.dropped, 5);
+    ASSERT_EQ_INT(st.peak_depth, OBC_EVENT_QUEUE_MAX);
+    ASSERT_EQ_INT(st.depth, fit);
+}
+
+TEST(post_without_subscribers_skipped)
+{
+    reset_state();
+    obc_event_id_t id = obc_event_register("nobody");
+    int v = 1;
+    ASSERT_EQ_INT(obc_event_post(id, 0, &v, (int)sizeof(v), 0), OBC_EVENT_POST_MERGED);
+
+    obc_event_queue_stats_t st;
+    obc_event_queue_stats(&st);
+    ASSERT_EQ_INT(st.skipped, 1);
+    ASSERT_EQ_INT(st.posted, 0);
+    ASSERT_EQ_INT(st.depth, 0);
+
+    /* Bus reset clears pending posts */
+    obc_event_subscribe_id(id, handler_a, 50);
+    obc_event_post(id, 0, &v, (int)sizeof(v), 0);
+    obc_event_bus_init();
+    ASSERT_EQ_INT(obc_event_queue_drain(NULL), 0);
+}
+
 TEST_MAIN_BEGIN()
     RUN(single_handler_fires);
     RUN(no_subscribers_no_crash);
@@ -488,5 +824,17 @@ TEST_MAIN_BEGIN()
     RUN(duplicate_handler_fires_twice);
     RUN(subscribe_during_fire_deferred);
     RUN(recursive_fire_depth_guard);
+    RUN(register_returns_stable_ids);
+    RUN(id_and_name_apis_interoperate);
+    RUN(invalid_and_stale_ids_rejected);
+    RUN(hashed_lookup_at_capacity);
     RUN(shutdown_during_fire_is_ignored);
+    RUN(presence_flag_tracks_subscriptions);
+    RUN(presence_flag_follows_deferred_changes);
+    RUN(server_event_catalog_registered);
+    RUN(post_deferred_until_drain);
+    RUN(post_coalesces_by_event_and_slot);
+    RUN(posts_during_drain_wait_for_next);
+    RUN(post_overflow_dropped_and_counted);
+    RUN(post_without_subscribers_skipped);
 TEST_MAIN_END()
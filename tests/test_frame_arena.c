@@ -0,0 +1,131 @@
+#include "test_util.h"
+#include "openbc/frame_arena.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the per-tick bump arena (src/server/frame_arena.c).
+ *
+ * Covers alignment (including an unaligned backing buffer), exhaustion and
+ * the failure count, mark/release, reset bookkeeping (high-water mark,
+ * last frame), poisoning of fresh and dead memory, and printf.
+ */
+
+static u8 g_buf[4096 + 16];
+
+TEST(alloc_aligned_and_bounded)
+{
+    bc_arena_t a;
+    bc_arena_init(&a, g_buf, 4096);
+
+    u8 *p = bc_arena_alloc(&a, 1);
+    u8 *q = bc_arena_alloc(&a, 24);
+    ASSERT(p != NULL && q != NULL);
+    ASSERT(((uintptr_t)p % BC_ARENA_ALIGN) == 0);
+    ASSERT(((uintptr_t)q % BC_ARENA_ALIGN) == 0);
+    ASSERT(q >= p + 1);
+
+    u8 *c = bc_arena_alloc_align(&a, 3, 1);
+    ASSERT(c == q + 24);
+    ASSERT(bc_arena_alloc_align(&a, 8, 3) == NULL);   /* not a power of two */
+    ASSERT(bc_arena_alloc(&a, 0) == NULL);
+
+    /* Fill to the byte, then one more */
+    size_t left = a.cap - a.used;
+    ASSERT(bc_arena_alloc_align(&a, left, 1) != NULL);
+    ASSERT_EQ_INT(a.used, a.cap);
+    ASSERT(bc_arena_alloc_align(&a, 1, 1) == NULL);
+    ASSERT(bc_arena_alloc(&a, (size_t)-1) == NULL);   /* no overflow wrap */
+    ASSERT_EQ_INT(a.failed, 2);
+}
+
+TEST(unaligned_backing_buffer)
+{
+    bc_arena_t a;
+    bc_arena_init(&a, g_buf + 3, 256);
+    u8 *p = bc_arena_alloc(&a, 10);
+    ASSERT(p != NULL);
+    ASSERT(((uintptr_t)p % BC_ARENA_ALIGN) == 0);
+    size_t pad = (size_t)(p - (g_buf + 3));
+    ASSERT(pad < BC_ARENA_ALIGN);
+    ASSERT_EQ_INT(a.used, pad + 10);
+
+    /* Padding counts against capacity */
+    ASSERT(bc_arena_alloc_align(&a, 256 - a.used + 1, 1) == NULL);
+    ASSERT(bc_arena_alloc_align(&a, 256 - a.used, 1) != NULL);
+}
+
+TEST(mark_release_and_reset)
+{
+    bc_arena_t a;
+    bc_arena_init(&a, g_buf, 4096);
+
+    bc_arena_alloc(&a, 100);
+    size_t m = bc_arena_mark(&a);
+    u8 *tmp = bc_arena_alloc(&a, 1000);
+    ASSERT(tmp != NULL);
+    bc_arena_release(&a, m);
+    ASSERT_EQ_INT(a.used, m);
+    ASSERT(bc_arena_alloc(&a, 1000) == tmp);   /* tail handed back */
+    bc_arena_release(&a, a.used + 50);         /* past the end: no-op */
+
+    size_t used = a.used;
+    bc_arena_reset(&a);
+    ASSERT_EQ_INT(a.used, 0);
+    ASSERT_EQ_INT(a.last_frame, used);
+    ASSERT_EQ_INT(a.frames, 1);
+
+    bc_arena_alloc(&a, 64);
+    bc_arena_reset(&a);
+    ASSERT_EQ_INT(a.last_frame, 64);
+    ASSERT_EQ_INT(a.peak, used);               /* high-water mark kept */
+    ASSERT_EQ_INT(a.frames, 2);
+}
+
+TEST(poison_marks_fresh_and_dead_memory)
+{
+    bc_arena_t a;
+    bc_arena_init(&a, g_buf, 256);
+    a.poison = true;
+
+    u8 *p = bc_arena_alloc(&a, 32);
+    for (int i = 0; i < 32; i++) ASSERT_EQ_INT(p[i], BC_ARENA_FRESH);
+    memset(p, 0x11, 32);
+    bc_arena_reset(&a);
+    for (int i = 0; i < 32; i++) ASSERT_EQ_INT(p[i], BC_ARENA_DEAD);
+
+    /* Off: memory is left as the caller wrote it */
+    a.poison = false;
+    p = bc_arena_alloc(&a, 32);
+    memset(p, 0x22, 32);
+    bc_arena_reset(&a);
+    p = bc_arena_alloc(&a, 32);
+    ASSERT_EQ_INT(p[0], 0x22);
+}
+
+TEST(printf_into_arena)
+{
+    bc_arena_t a;
+    bc_arena_init(&a, g_buf, 64);
+
+    char *s = bc_arena_printf(&a, "%s killed %s (%d)", "Alpha", "Beta", 7);
+    ASSERT(s != NULL);
+    ASSERT(strcmp(s, "Alpha killed Beta (7)") == 0);
+    ASSERT_EQ_INT(a.used, strlen(s) + 1);
+
+    ASSERT(bc_arena_printf(&a, "%060d", 1) == NULL);   /* 61 bytes, 42 left */
+    ASSERT_EQ_INT(a.failed, 1);
+
+    bc_arena_t empty;
+    bc_arena_init(&empty, NULL, 100);
+    ASSERT_EQ_INT(empty.cap, 0);
+    ASSERT(bc_arena_alloc(&empty, 1) == NULL);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(alloc_aligned_and_bounded);
+    RUN(unaligned_backing_buffer);
+    RUN(mark_release_and_reset);
+    RUN(poison_marks_fresh_and_dead_memory);
+    RUN(printf_into_arena);
+TEST_MAIN_END()
@@ -488,6 +488,245 @@ TEST(event_forward_buffer_overflow)
     ASSERT(len == -1);
 }
 
+/* === Reserved fast path vs the checked writes ===
+ *
+ * The per-tick builders reserve their size once and store unchecked. The
+ * reference builders below are the field-by-field checked versions they
+ * replaced; random inputs and buffer sizes (many too small) must give the
+ * same length and bytes, and a refused build must leave the buffer alone.
+ */
+
+static u32 fuzz_state = 0xB1DE5EEDu;
+
+static u32 fuzz_u32(void)
+{
+    fuzz_state = fuzz_state * 1664525u + 1013904223u;
+    return fuzz_state;
+}
+
+static f32 fuzz_f32(f32 range)
+{
+    return ((f32)(i32)fuzz_u32() / 2147483648.0f) * range;
+}
+
+/* 0..max inclusive */
+static int fuzz_size(int max)
+{
+    return (int)(fuzz_u32() >> 8) % (max + 1);
+}
+
+static int ref_torpedo_fire(u8 *buf, int buf_size, i32 shooter_id, u8 subsys,
+                            f32 vx, f32 vy, f32 vz, bool has_target,
+                            i32 target_id, f32 ix, f32 iy, f32 iz)
+{
+    bc_buffer_t b;
+    bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_write_u8(&b, BC_OP_TORPEDO_FIRE)) return -1;
+    if (!bc_buf_write_i32(&b, shooter_id)) return -1;
+    if (!bc_buf_write_u8(&b, subsys)) return -1;
+    if (!bc_buf_write_u8(&b, has_target ? 0x02 : 0x00)) return -1;
+    if (!bc_buf_write_cv3(&b, vx, vy, vz)) return -1;
+    if (has_target) {
+        if (!bc_buf_write_i32(&b, target_id)) return -1;
+        if (!bc_buf_write_cv4(&b, ix, iy, iz)) return -1;
+    }
+    return (int)b.pos;
+}
+
+static int ref_beam_fire(u8 *buf, int buf_size, i32 shooter_id, u8 flags,
+                         f32 dx, f32 dy, f32 dz, bool has_target, i32 target_id)
+{
+    bc_buffer_t b;
+    bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_write_u8(&b, BC_OP_BEAM_FIRE)) return -1;
+    if (!bc_buf_write_i32(&b, shooter_id)) return -1;
+    if (!bc_buf_write_u8(&b, flags)) return -1;
+    if (!bc_buf_write_cv3(&b, dx, dy, dz)) return -1;
+    if (!bc_buf_write_u8(&b, has_target ? 0x02 : 0x00)) return -1;
+    if (has_target) {
+        if (!bc_buf_write_i32(&b, target_id)) return -1;
+    }
+    return (int)b.pos;
+}
+
+static int ref_explosion(u8 *buf, int buf_size, i32 object_id,
+                         f32 ix, f32 iy, f32 iz, f32 damage, f32 radius)
+{
+    bc_buffer_t b;
+    bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_write_u8(&b, BC_OP_EXPLOSION)) return -1;
+    if (!bc_buf_write_i32(&b, object_id)) return -1;
+    if (!bc_buf_write_cv4(&b, ix, iy, iz)) return -1;
+    if (!bc_buf_write_cf16(&b, radius)) return -1;
+    if (!bc_buf_write_cf16(&b, damage)) return -1;
+    return (int)b.pos;
+}
+
+static int ref_state_update(u8 *buf, int buf_size, i32 object_id,
+                            f32 game_time, u8 dirty,
+                            const u8 *fields, int fields_len)
+{
+    bc_buffer_t b;
+    bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_write_u8(&b, BC_OP_STATE_UPDATE)) return -1;
+    if (!bc_buf_write_i32(&b, object_id)) return -1;
+    if (!bc_buf_write_f32(&b, game_time)) return -1;
+    if (!bc_buf_write_u8(&b, dirty)) return -1;
+    if (fields_len > 0) {
+        if (!bc_buf_write_bytes(&b, fields, (size_t)fields_len)) return -1;
+    }
+    return (int)b.pos;
+}
+
+static int ref_score_change(u8 *buf, int buf_size,
+                            i32 killer_id, i32 kills, i32 score,
+                            i32 victim_id, i32 deaths,
+                            const bc_score_entry_t *extra, int extra_count)
+{
+    bc_buffer_t b;
+    bc_buf_init(&b, buf, (size_t)buf_size);
+    if (!bc_buf_write_u8(&b, BC_MSG_SCORE_CHANGE)) return -1;
+    if (!bc_buf_write_i32(&b, killer_id)) return -1;
+    if (killer_id != 0) {
+        if (!bc_buf_write_i32(&b, kills)) return -1;
+        if (!bc_buf_write_i32(&b, score)) return -1;
+    }
+    if (!bc_buf_write_i32(&b, victim_id)) return -1;
+    if (!bc_buf_write_i32(&b, deaths)) return -1;
+    if (!bc_buf_write_u8(&b, (u8)extra_count)) return -1;
+    for (int i = 0; i < extra_count; i++) {
+        if (!bc_buf_write_i32(&b, extra[i].player_id)) return -1;
+        if (!bc_buf_write_i32(&b, extra[i].score)) return -1;
+    }
+    return (int)b.pos;
+}
+
+#define FUZZ_ROUNDS  5000
+#define FUZZ_FILL    0xCD
+
+/* Same result as the reference; a refused build wrote nothing */
+static bool fuzz_agrees(int got, const u8 *fast, int want, const u8 *ref,
+                        int buf_size)
+{
+    if (got != want) return false;
+    if (got > 0) return memcmp(fast, ref, (size_t)got) == 0;
+    for (int i = 0; i < buf_size; i++)
+        if (fast[i] != FUZZ_FILL) return false;
+    return true;
+}
+
+TEST(fuzz_torpedo_fire_matches_checked)
+{
+    u8 fast[32], ref[32];
+    for (int round = 0; round < FUZZ_ROUNDS; round++) {
+        int size = fuzz_size(24);
+        i32 shooter = (i32)fuzz_u32();
+        u8 subsys = (u8)fuzz_u32();
+        bool has_target = (fuzz_u32() & 0x100) != 0;
+        i32 target = (i32)fuzz_u32();
+        f32 v[3] = { fuzz_f32(100.0f), fuzz_f32(100.0f), fuzz_f32(100.0f) };
+        f32 im[3] = { fuzz_f32(5000.0f), fuzz_f32(5000.0f), fuzz_f32(5000.0f) };
+        if ((round & 15) == 0) v[0] = v[1] = v[2] = 0.0f;
+
+        memset(fast, FUZZ_FILL, sizeof(fast));
+        memset(ref, FUZZ_FILL, sizeof(ref));
+        int got = bc_build_torpedo_fire(fast, size, shooter, subsys,
+                                        v[0], v[1], v[2], has_target, target,
+                                        im[0], im[1], im[2]);
+        int want = ref_torpedo_fire(ref, size, shooter, subsys,
+                                    v[0], v[1], v[2], has_target, target,
+                                    im[0], im[1], im[2]);
+        ASSERT(fuzz_agrees(got, fast, want, ref, size));
+    }
+}
+
+TEST(fuzz_beam_fire_matches_checked)
+{
+    u8 fast[32], ref[32];
+    for (int round = 0; round < FUZZ_ROUNDS; round++) {
+        int size = fuzz_size(18);
+        i32 shooter = (i32)fuzz_u32();
+        u8 flags = (u8)fuzz_u32();
+        bool has_target = (fuzz_u32() & 0x100) != 0;
+        i32 target = (i32)fuzz_u32();
+        f32 d[3] = { fuzz_f32(1.0f), fuzz_f32(1.0f), fuzz_f32(1.0f) };
+
+        memset(fast, FUZZ_FILL, sizeof(fast));
+        memset(ref, FUZZ_FILL, sizeof(ref));
+        int got = bc_build_beam_fire(fast, size, shooter, flags,
+                                     d[0], d[1], d[2], has_target, target);
+        int want = ref_beam_fire(ref, size, shooter, flags,
+                                 d[0], d[1], d[2], has_target, target);
+        ASSERT(fuzz_agrees(got, fast, want, ref, size));
+    }
+}
+
+TEST(fuzz_explosion_matches_checked)
+{
+    u8 fast[32], ref[32];
+    for (int round = 0; round < FUZZ_ROUNDS; round++) {
+        int size = fuzz_size(18);
+        i32 obj = (i32)fuzz_u32();
+        f32 im[3] = { fuzz_f32(50.0f), fuzz_f32(50.0f), fuzz_f32(50.0f) };
+        f32 damage = fuzz_f32(20000.0f);
+        f32 radius = fuzz_f32(2.0f);
+
+        memset(fast, FUZZ_FILL, sizeof(fast));
+        memset(ref, FUZZ_FILL, sizeof(ref));
+        int got = bc_build_explosion(fast, size, obj, im[0], im[1], im[2],
+                                     damage, radius);
+        int want = ref_explosion(ref, size, obj, im[0], im[1], im[2],
+                                 damage, radius);
+        ASSERT(fuzz_agrees(got, fast, want, ref, size));
+    }
+}
+
+TEST(fuzz_state_update_matches_checked)
+{
+    u8 fields[64], fast[96], ref[96];
+    for (int round = 0; round < FUZZ_ROUNDS; round++) {
+        int fields_len = fuzz_size(64);
+        for (int i = 0; i < fields_len; i++) fields[i] = (u8)(fuzz_u32() >> 24);
+        int size = fuzz_size(80);
+        i32 obj = (i32)fuzz_u32();
+        f32 t = fuzz_f32(10000.0f);
+        u8 dirty = (u8)fuzz_u32();
+
+        memset(fast, FUZZ_FILL, sizeof(fast));
+        memset(ref, FUZZ_FILL, sizeof(ref));
+        int got = bc_build_state_update(fast, size, obj, t, dirty,
+                                        fields, fields_len);
+        int want = ref_state_update(ref, size, obj, t, dirty,
+                                    fields, fields_len);
+        ASSERT(fuzz_agrees(got, fast, want, ref, size));
+    }
+}
+
+TEST(fuzz_score_change_matches_checked)
+{
+    bc_score_entry_t extra[16];
+    u8 fast[160], ref[160];
+    for (int round = 0; round < FUZZ_ROUNDS; round++) {
+        int count = fuzz_size(16);
+        for (int i = 0; i < count; i++) {
+            extra[i].player_id = (i32)fuzz_u32();
+            extra[i].score = (i32)fuzz_u32();
+        }
+        int size = fuzz_size(150);
+        i32 killer = (fuzz_u32() & 0x300) ? (i32)fuzz_u32() : 0;
+        i32 kills = (i32)fuzz_u32(), score = (i32)fuzz_u32();
+        i32 victim = (i32)fuzz_u32(), deaths = (i32)fuzz_u32();
+
+        memset(fast, FUZZ_FILL, sizeof(fast));
+        memset(ref, FUZZ_FILL, sizeof(ref));
+        int got = bc_build_score_change(fast, size, killer, kills, score,
+                                        victim, deaths, extra, count);
+        int want = ref_score_change(ref, size, killer, kills, score,
+                                    victim, deaths, extra, count);
+        ASSERT(fuzz_agrees(got, fast, want, ref, size));
+    }
+}
+
 /* === Run all tests === */
 
 TEST_MAIN_BEGIN()
@@ -548,4 +787,11 @@ TEST_MAIN_BEGIN()
     RUN(event_forward_add_repair_list);
     RUN(event_forward_repair_priority);
     RUN(event_forward_buffer_overflow);
+
+    /* Reserved fast path vs checked writes */
+    RUN(fuzz_torpedo_fire_matches_checked);
+    RUN(fuzz_beam_fire_matches_checked);
+    RUN(fuzz_explosion_matches_checked);
+    RUN(fuzz_state_update_matches_checked);
+    RUN(fuzz_score_change_matches_checked);
 TEST_MAIN_END()
@@ -0,0 +1,261 @@
+#include "test_util.h"
+#include "openbc/checksum.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <time.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#define make_dir(p) _mkdir(p)
+#define set_times(p, t) _utime((p), (t))
+#define open_pipe(c) _popen((c), "r")
+#define close_pipe(f) _pclose(f)
+#define HASH_BIN "build\\openbc-hash.exe"
+typedef struct _utimbuf utimbuf_t;
+#else
+#include <sys/stat.h>
+#include <utime.h>
+#define make_dir(p) mkdir((p), 0755)
+#define set_times(p, t) utime((p), (t))
+#define open_pipe(c) popen((c), "r")
+#define close_pipe(f) pclose(f)
+#define HASH_BIN "build/openbc-hash"
+typedef struct utimbuf utimbuf_t;
+#endif
+
+/*
+ * End-to-end tests for `openbc-hash generate` (tools/manifest.c).
+ *
+ * Runs the built tool on a copy of the tests/fixtures game tree and
+ * compares its output with the checked-in manifest_generated.json.
+ * Covers the cold run, an --incremental run that reuses every hash, a
+ * touched file with the same bytes being rehashed to the same manifest,
+ * and an edit changing exactly that file's content_hash.
+ */
+
+#define FIXTURE_DIR  "tests/fixtures"
+#define EXPECTED     FIXTURE_DIR "/manifest_generated.json"
+#define TREE_DIR     "build/tests/hash_tool_tree"
+#define OUTPUT       "build/tests/hash_tool_manifest.json"
+#define EDITED_FILE  "scripts/ships/Galaxy.pyc"
+
+static const char *const FIXTURE_FILES[] = {
+    "scripts/App.pyc",
+    "scripts/Autoexec.pyc",
+    "scripts/mainmenu/MainMenu.pyc",
+    "scripts/ships/Galaxy.pyc",
+    "scripts/ships/Klingon/BirdOfPrey.pyc",
+};
+#define FIXTURE_COUNT (int)(sizeof(FIXTURE_FILES) / sizeof(FIXTURE_FILES[0]))
+
+/* Read a whole file into a malloc'd, NUL-terminated buffer. */
+static char *read_all(const char *path, long *len_out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = malloc((size_t)len + 1);
+    if (buf && fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (!buf) return NULL;
+    buf[len] = '\0';
+    if (len_out) *len_out = len;
+    return buf;
+}
+
+static bool write_all(const char *path, const char *data, long len)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, (size_t)len, f) == (size_t)len;
+    fclose(f);
+    return ok;
+}
+
+/* Move a file's mtime out of the tool's racy window; `age` seconds back,
+ * so each touch can land on a different time. */
+static void backdate(const char *path, long age)
+{
+    utimbuf_t t;
+    t.actime = t.modtime = time(NULL) - age;
+    set_times(path, &t);
+}
+
+static void tree_path(char *out, size_t size, const char *rel)
+{
+    snprintf(out, size, "%s/%s", TREE_DIR, rel);
+}
+
+static bool copy_fixture_tree(void)
+{
+    make_dir(TREE_DIR);
+    make_dir(TREE_DIR "/scripts");
+    make_dir(TREE_DIR "/scripts/mainmenu");
+    make_dir(TREE_DIR "/scripts/ships");
+    make_dir(TREE_DIR "/scripts/ships/Klingon");
+    for (int i = 0; i < FIXTURE_COUNT; i++) {
+        char src[256], dst[256];
+        snprintf(src, sizeof(src), "%s/%s", FIXTURE_DIR, FIXTURE_FILES[i]);
+        tree_path(dst, sizeof(dst), FIXTURE_FILES[i]);
+        long len = 0;
+        char *data = read_all(src, &len);
+        if (!data) return false;
+        bool ok = write_all(dst, data, len);
+        free(data);
+        if (!ok) return false;
+        backdate(dst, 3600);
+    }
+    return true;
+}
+
+/* Run `generate` on the copied tree; fills the hashed/unchanged counts
+ * from its summary line. Returns false if the tool fails. */
+static bool run_generate(bool incremental, int *hashed, int *unchanged)
+{
+    char cmd[512];
+    snprintf(cmd, sizeof(cmd), "%s generate %s -o %s%s", HASH_BIN,
+             TREE_DIR, OUTPUT, incremental ? " --incremental" : "");
+    FILE *p = open_pipe(cmd);
+    if (!p) return false;
+
+    char line[512];
+    int files = -1;
+    *hashed = *unchanged = -1;
+    while (fgets(line, sizeof(line), p)) {
+        const char *s = strstr(line, " files, ");
+        if (s) {
+            const char *open = strrchr(line, '(');
+            if (open) files = atoi(open + 1);
+            sscanf(s, " files, %d hashed, %d unchanged", hashed, unchanged);
+        }
+    }
+    return close_pipe(p) == 0 && files == FIXTURE_COUNT;
+}
+
+static bool output_matches_expected(void)
+{
+    char *want = read_all(EXPECTED, NULL);
+    char *got = read_all(OUTPUT, NULL);
+    bool same = want && got && strcmp(want, got) == 0;
+    free(want);
+    free(got);
+    return same;
+}
+
+static void remove_outputs(void)
+{
+    remove(OUTPUT);
+    remove(OUTPUT ".cache");
+}
+
+TEST(cold_run_matches_expected)
+{
+    ASSERT(copy_fixture_tree());
+    remove_outputs();
+
+    int hashed, unchanged;
+    ASSERT(run_generate(false, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, FIXTURE_COUNT);
+    ASSERT_EQ_INT(unchanged, 0);
+    ASSERT(output_matches_expected());
+
+    /* Without --incremental no cache is left behind */
+    FILE *f = fopen(OUTPUT ".cache", "rb");
+    ASSERT(f == NULL);
+}
+
+TEST(incremental_reuses_unchanged_hashes)
+{
+    ASSERT(copy_fixture_tree());
+    remove_outputs();
+
+    int hashed, unchanged;
+    ASSERT(run_generate(true, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, FIXTURE_COUNT);      /* no cache yet */
+    ASSERT_EQ_INT(unchanged, 0);
+    ASSERT(output_matches_expected());
+
+    ASSERT(run_generate(true, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, 0);
+    ASSERT_EQ_INT(unchanged, FIXTURE_COUNT);
+    ASSERT(output_matches_expected());
+}
+
+TEST(touched_file_is_rehashed)
+{
+    ASSERT(copy_fixture_tree());
+    remove_outputs();
+
+    int hashed, unchanged;
+    ASSERT(run_generate(true, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, FIXTURE_COUNT);
+
+    char path[256];
+    tree_path(path, sizeof(path), EDITED_FILE);
+    long len = 0;
+    char *orig = read_all(path, &len);
+    ASSERT(orig != NULL);
+
+    /* Same bytes, new mtime: only that file is hashed, manifest unchanged */
+    ASSERT(write_all(path, orig, len));
+    backdate(path, 1800);
+    ASSERT(run_generate(true, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, 1);
+    ASSERT_EQ_INT(unchanged, FIXTURE_COUNT - 1);
+    ASSERT(output_matches_expected());
+
+    /* Edited bytes: the new content_hash appears, the old one is gone */
+    char *edited = malloc((size_t)len + 1);
+    ASSERT(edited != NULL);
+    memcpy(edited, orig, (size_t)len + 1);
+    edited[0] ^= 0x5A;
+    ASSERT(write_all(path, edited, len));
+    backdate(path, 900);
+
+    bool ok = false;
+    u32 want = file_hash_from_path(path, &ok);
+    ASSERT(ok);
+    char src[256];
+    snprintf(src, sizeof(src), "%s/%s", FIXTURE_DIR, EDITED_FILE);
+    u32 old = file_hash_from_path(src, &ok);
+    ASSERT(ok);
+    ASSERT(want != old);
+
+    ASSERT(run_generate(true, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, 1);
+    ASSERT_EQ_INT(unchanged, FIXTURE_COUNT - 1);
+    ASSERT(!output_matches_expected());
+
+    char want_hex[32], old_hex[32];
+    snprintf(want_hex, sizeof(want_hex), "\"0x%08X\"", want);
+    snprintf(old_hex, sizeof(old_hex), "\"0x%08X\"", old);
+    char *got = read_all(OUTPUT, NULL);
+    ASSERT(got != NULL);
+    ASSERT(strstr(got, want_hex) != NULL);
+    ASSERT(strstr(got, old_hex) == NULL);
+    free(got);
+
+    /* Restored bytes: back to the expected manifest */
+    ASSERT(write_all(path, orig, len));
+    backdate(path, 600);
+    ASSERT(run_generate(true, &hashed, &unchanged));
+    ASSERT_EQ_INT(hashed, 1);
+    ASSERT(output_matches_expected());
+    free(edited);
+    free(orig);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(cold_run_matches_expected);
+    RUN(incremental_reuses_unchanged_hashes);
+    RUN(touched_file_is_rehashed);
+TEST_MAIN_END()
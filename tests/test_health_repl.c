@@ -0,0 +1,265 @@
+/*
+ * test_health_repl.c -- 0x20 subsystem-health replication
+ *
+ * Covers bc_ship_build_health_pair() (owner + remote variants from one walk
+ * of the serialization list, checked against the previous serializer's
+ * output) and bc_health_track_t (journal-driven changed-entry tracking that
+ * lets the broadcaster open the window at the freshest damage).
+ */
+
+#include "test_util.h"
+#include "openbc/ship_data.h"
+#include "openbc/ship_state.h"
+#include "openbc/ship_power.h"
+#include <string.h>
+
+#define REGISTRY_DIR "data/vanilla-1.1"
+
+static bc_game_registry_t g_reg;
+
+TEST(load_registry)
+{
+    ASSERT(bc_registry_load_dir(&g_reg, REGISTRY_DIR));
+    ASSERT(g_reg.ship_count >= 16);
+}
+
+/* Building both variants together must give the same bytes and cursors as
+ * building each alone, for every ship and every window start. */
+TEST(pair_matches_single_variants)
+{
+    for (int s = 0; s < g_reg.ship_count; s++) {
+        const bc_ship_class_t *cls = &g_reg.ships[s];
+        bc_ship_state_t ship;
+        bc_ship_init(&ship, cls, s, 0x3FFFFFFF, 1, 0);
+        bc_ship_power_tick(&ship, cls, 1.0f);
+        /* Uneven damage so condition bytes differ per entry */
+        for (int i = 0; i < cls->subsystem_count; i++)
+            ship.subsystem_hp[i] *= (f32)(i % 5) / 5.0f;
+
+        for (int start = 0; start < cls->ser_list.count; start++) {
+            u8 own_a[128], rmt_a[128], own_b[128], rmt_b[128];
+            int own_len_a = 0, rmt_len_a = 0, own_len_b = 0, rmt_len_b = 0;
+            u8 next_own_a = 0, next_rmt_a = 0, next_own_b = 0, next_rmt_b = 0;
+
+            bc_ship_build_health_pair(&ship, cls, 1.0f, (u8)start,
+                                      own_a, sizeof(own_a), &own_len_a, &next_own_a,
+                                      rmt_a, sizeof(rmt_a), &rmt_len_a, &next_rmt_a);
+            bc_ship_build_health_pair(&ship, cls, 1.0f, (u8)start,
+                                      own_b, sizeof(own_b), &own_len_b, &next_own_b,
+                                      NULL, 0, NULL, NULL);
+            bc_ship_build_health_pair(&ship, cls, 1.0f, (u8)start,
+                                      NULL, 0, NULL, NULL,
+                                      rmt_b, sizeof(rmt_b), &rmt_len_b, &next_rmt_b);
+
+            ASSERT(own_len_a > 0 && rmt_len_a > 0);
+            ASSERT_EQ_INT(own_len_b, own_len_a);
+            ASSERT_EQ_INT(rmt_len_b, rmt_len_a);
+            ASSERT(memcmp(own_a, own_b, (size_t)own_len_a) == 0);
+            ASSERT(memcmp(rmt_a, rmt_b, (size_t)rmt_len_a) == 0);
+            ASSERT_EQ_INT(next_own_b, next_own_a);
+            ASSERT_EQ_INT(next_rmt_b, next_rmt_a);
+        }
+    }
+}
+
+/* Output of the single-variant serializer this replaced (one full walk per
+ * variant), for a damaged Galaxy: every window of the round-robin, and the
+ * bytes of the first. */
+static const struct { u8 start, next; int len; } k_galaxy_rmt[] = {
+    { 0, 5, 27 }, { 5, 7, 27 }, { 7, 9, 22 }, { 9, 3, 20 },
+};
+static const struct { u8 start, next; int len; } k_galaxy_own[] = {
+    { 0, 5, 25 }, { 5, 7, 25 }, { 7, 9, 20 }, { 9, 4, 21 },
+};
+static const u8 k_galaxy_rmt0[] = {
+    0x1C, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x80, 0x3F, 0x20, 0x00, 0xCC,
+    0x66, 0xFF, 0xFF, 0x33, 0x00, 0x43, 0x64, 0xFF, 0x00, 0x33, 0x66, 0x99,
+    0xCC, 0x00, 0x64,
+};
+static const u8 k_galaxy_own0[] = {
+    0x1C, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x80, 0x3F, 0x20, 0x00, 0xCC,
+    0x66, 0xFF, 0xFF, 0x33, 0x00, 0x40, 0xFF, 0x00, 0x33, 0x66, 0x99, 0xCC,
+    0x00,
+};
+
+TEST(pair_matches_previous_serializer)
+{
+    int s = bc_registry_find_ship_index(&g_reg, 3);
+    const bc_ship_class_t *cls = bc_registry_get_ship(&g_reg, s);
+    ASSERT(cls != NULL);
+    ASSERT_EQ_INT(cls->ser_list.count, 11);
+    bc_ship_state_t ship;
+    bc_ship_init(&ship, cls, s, 0x3FFFFFFF, 1, 0);
+    for (int i = 0; i < cls->subsystem_count; i++)
+        ship.subsystem_hp[i] *= (f32)(i % 5) / 5.0f;
+
+    for (int w = 0; w < 4; w++) {
+        u8 own[128], rmt[128];
+        int own_len = 0, rmt_len = 0;
+        u8 next_own = 0, next_rmt = 0;
+
+        bc_ship_build_health_pair(&ship, cls, 1.0f, k_galaxy_rmt[w].start,
+                                  NULL, 0, NULL, NULL,
+                                  rmt, sizeof(rmt), &rmt_len, &next_rmt);
+        ASSERT_EQ_INT(rmt_len, k_galaxy_rmt[w].len);
+        ASSERT_EQ_INT(next_rmt, k_galaxy_rmt[w].next);
+
+        bc_ship_build_health_pair(&ship, cls, 1.0f, k_galaxy_own[w].start,
+                                  own, sizeof(own), &own_len, &next_own,
+                                  NULL, 0, NULL, NULL);
+        ASSERT_EQ_INT(own_len, k_galaxy_own[w].len);
+        ASSERT_EQ_INT(next_own, k_galaxy_own[w].next);
+
+        if (w == 0) {
+            ASSERT(memcmp(rmt, k_galaxy_rmt0, sizeof(k_galaxy_rmt0)) == 0);
+            ASSERT(memcmp(own, k_galaxy_own0, sizeof(k_galaxy_own0)) == 0);
+        }
+    }
+}
+
+/* Find a ship with a long enough serialization list for window tests. */
+static const bc_ship_class_t *long_list_ship(void)
+{
+    for (int s = 0; s < g_reg.ship_count; s++)
+        if (g_reg.ships[s].ser_list.count >= 8) return &g_reg.ships[s];
+    return NULL;
+}
+
+/* Scale one subsystem's HP the way a damage kernel would, journal and all */
+static void damage(bc_ship_state_t *ship, int hp_index, f32 scale)
+{
+    ship->subsystem_hp[hp_index] *= scale;
+    bc_ship_journal_subsys_damaged(&ship->journal, hp_index);
+}
+
+TEST(fresh_track_follows_round_robin)
+{
+    const bc_ship_class_t *cls = long_list_ship();
+    ASSERT(cls != NULL);
+    bc_ship_state_t ship;
+    bc_ship_init(&ship, cls, 0, 0x3FFFFFFF, 1, 0);
+
+    bc_health_track_t t;
+    bc_health_track_reset(&t);
+    bool pri = true;
+    ASSERT_EQ_INT(5, bc_health_track_pick(&t, &ship, cls, 5, false, &pri));
+    ASSERT(!pri);
+    ASSERT_EQ_INT(2, bc_health_track_pick(&t, &ship, cls, 2, true, &pri));
+    ASSERT(!pri);
+}
+
+TEST(latest_change_wins)
+{
+    const bc_ship_class_t *cls = long_list_ship();
+    ASSERT(cls != NULL);
+    const bc_ss_list_t *sl = &cls->ser_list;
+    bc_ship_state_t ship;
+    bc_ship_init(&ship, cls, 0, 0x3FFFFFFF, 1, 0);
+
+    bc_health_track_t t;
+    bc_health_track_reset(&t);
+    bool pri = false;
+    bc_health_track_pick(&t, &ship, cls, 0, true, &pri);  /* prime */
+
+    damage(&ship, sl->entries[2].hp_index, 0.5f);
+    ASSERT_EQ_INT(2, bc_health_track_pick(&t, &ship, cls, 0, true, &pri));
+    ASSERT(pri);
+
+    damage(&ship, sl->entries[6].hp_index, 0.5f);
+    ASSERT_EQ_INT(6, bc_health_track_pick(&t, &ship, cls, 0, true, &pri));
+    ASSERT(pri);
+
+    /* Entry 6 delivered alone: the older change at 2 is next */
+    bc_health_track_sent(&t, cls, 6, 1);
+    ASSERT_EQ_INT(2, bc_health_track_pick(&t, &ship, cls, 0, true, &pri));
+    ASSERT(pri);
+
+    /* A window wrapping the whole list clears everything */
+    bc_health_track_sent(&t, cls, 4, sl->count);
+    ASSERT_EQ_INT(0, bc_health_track_pick(&t, &ship, cls, 0, true, &pri));
+    ASSERT(!pri);
+}
+
+/* Only journaled entries are looked at; a journal cleared before any pick
+ * saw it still counts once noted into the tracker. */
+TEST(journal_drives_observation)
+{
+    const bc_ship_class_t *cls = long_list_ship();
+    ASSERT(cls != NULL);
+    const bc_ss_list_t *sl = &cls->ser_list;
+    bc_ship_state_t ship;
+    bc_ship_init(&ship, cls, 0, 0x3FFFFFFF, 1, 0);
+
+    bc_health_track_t t;
+    bc_health_track_reset(&t);
+    bool pri = true;
+    bc_health_track_pick(&t, &ship, cls, 0, true, &pri);  /* prime */
+
+    /* Unjournaled write: not re-signed */
+    int hp4 = sl->entries[4].hp_index;
+    f32 hp4_was = ship.subsystem_hp[hp4];
+    ship.subsystem_hp[hp4] *= 0.5f;
+    ASSERT_EQ_INT(1, bc_health_track_pick(&t, &ship, cls, 1, true, &pri));
+    ASSERT(!pri);
+    ship.subsystem_hp[hp4] = hp4_was;
+
+    /* Journaled at the end of a tick with no pick, then cleared */
+    damage(&ship, sl->entries[5].hp_index, 0.5f);
+    bc_health_track_note(&t, &ship.journal);
+    bc_ship_journal_clear(&ship.journal);
+    ASSERT_EQ_INT(5, bc_health_track_pick(&t, &ship, cls, 1, true, &pri));
+    ASSERT(pri);
+
+    /* Battery change reaches the POWER-format entry */
+    int power = -1;
+    for (int i = 0; i < sl->count; i++)
+        if (sl->entries[i].format == BC_SS_FORMAT_POWER) power = i;
+    ASSERT(power >= 0);
+    bc_health_track_sent(&t, cls, 0, sl->count);
+    ship.main_battery = cls->main_battery_limit * 0.25f;
+    ship.journal.changed |= BC_SHIP_CHG_POWER;
+    ASSERT_EQ_INT(power, bc_health_track_pick(&t, &ship, cls, 1, true, &pri));
+    ASSERT(pri);
+}
+
+TEST(periodic_alternates_with_round_robin)
+{
+    const bc_ship_class_t *cls = long_list_ship();
+    ASSERT(cls != NULL);
+    const bc_ss_list_t *sl = &cls->ser_list;
+    bc_ship_state_t ship;
+    bc_ship_init(&ship, cls, 0, 0x3FFFFFFF, 1, 0);
+
+    bc_health_track_t t;
+    bc_health_track_reset(&t);
+    bool pri = false;
+    bc_health_track_pick(&t, &ship, cls, 0, false, &pri);  /* prime */
+
+    /* Entry 3 changes before every broadcast (e.g. under repair) */
+    int hp = sl->entries[3].hp_index;
+    int priority_windows = 0;
+    for (int tick = 0; tick < 10; tick++) {
+        ship.subsystem_hp[hp] = sl->entries[3].max_condition *
+                                (0.1f + 0.05f * (f32)tick);
+        bc_ship_journal_subsys_repaired(&ship.journal, hp);
+        u8 start = bc_health_track_pick(&t, &ship, cls, 7, false, &pri);
+        if (pri) {
+            ASSERT_EQ_INT(3, start);
+            priority_windows++;
+            bc_health_track_sent(&t, cls, start, 1);
+        } else {
+            ASSERT_EQ_INT(7, start);
+        }
+    }
+    ASSERT_EQ_INT(5, priority_windows);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(load_registry);
+    RUN(pair_matches_single_variants);
+    RUN(pair_matches_previous_serializer);
+    RUN(fresh_track_follows_round_robin);
+    RUN(latest_change_wins);
+    RUN(journal_drives_observation);
+    RUN(periodic_alternates_with_round_robin);
+TEST_MAIN_END()
@@ -0,0 +1,131 @@
+#include "test_util.h"
+#include "openbc/interest.h"
+
+#include <string.h>
+#include <math.h>
+
+/*
+ * Unit tests for interest management (unreliable StateUpdate thinning).
+ *
+ * Covers the pure policy in src/server/interest.c: distance/cloak weights,
+ * the priority accumulator's relay rate, and keyframe bypass. The relay
+ * loop itself (bc_relay_state_update) is exercised by the live-server
+ * battle tests.
+ */
+
+static bc_interest_cfg_t g_cfg;
+static bc_interest_t     g_st;
+
+static void reset_state(void)
+{
+    bc_interest_cfg_defaults(&g_cfg);
+    g_cfg.near_dist = 100.0f;
+    g_cfg.far_dist  = 500.0f;
+    g_cfg.min_rate  = 0.25f;
+    bc_interest_init(&g_st);
+}
+
+static void place(bc_ship_state_t *s, f32 x, f32 y, f32 z)
+{
+    memset(s, 0, sizeof(*s));
+    s->pos.x = x; s->pos.y = y; s->pos.z = z;
+    s->cloak_state = BC_CLOAK_DECLOAKED;
+}
+
+/* Count relayed updates out of n for a fixed weight / dirty byte. */
+static int relay_count(int n, f32 w, u8 dirty)
+{
+    int sent = 0;
+    for (int i = 0; i < n; i++)
+        if (bc_interest_should_relay(&g_st, &g_cfg, 1, 2, w, dirty)) sent++;
+    return sent;
+}
+
+TEST(weight_by_distance)
+{
+    reset_state();
+    bc_ship_state_t obs, sub;
+    place(&obs, 0, 0, 0);
+
+    place(&sub, 50, 0, 0);
+    ASSERT(bc_interest_weight(&g_cfg, &obs, &sub) == 1.0f);
+    place(&sub, 100, 0, 0);                  /* boundary is inclusive */
+    ASSERT(bc_interest_weight(&g_cfg, &obs, &sub) == 1.0f);
+
+    place(&sub, 300, 0, 0);                  /* halfway: 1 - 0.5*0.75 */
+    ASSERT(fabsf(bc_interest_weight(&g_cfg, &obs, &sub) - 0.625f) < 1e-4f);
+
+    place(&sub, 0, 0, -5000);
+    ASSERT(bc_interest_weight(&g_cfg, &obs, &sub) == 0.25f);
+}
+
+TEST(weight_cloak_and_missing_ship)
+{
+    reset_state();
+    bc_ship_state_t obs, sub;
+    place(&obs, 0, 0, 0);
+    place(&sub, 10, 0, 0);
+
+    sub.cloak_state = BC_CLOAK_CLOAKED;
+    ASSERT(bc_interest_weight(&g_cfg, &obs, &sub) == 0.25f);
+    sub.cloak_state = BC_CLOAK_DECLOAKING;   /* visible shimmer: full rate */
+    ASSERT(bc_interest_weight(&g_cfg, &obs, &sub) == 1.0f);
+
+    /* Observer without a ship (dead / spectating) sees everything */
+    sub.cloak_state = BC_CLOAK_CLOAKED;
+    ASSERT(bc_interest_weight(&g_cfg, NULL, &sub) == 1.0f);
+}
+
+TEST(accumulator_rate)
+{
+    reset_state();
+    ASSERT_EQ_INT(relay_count(100, 1.0f,  BC_DIRTY_POS_DELTA), 100);
+    bc_interest_init(&g_st);
+    ASSERT_EQ_INT(relay_count(100, 0.25f, BC_DIRTY_POS_DELTA), 25);
+    bc_interest_init(&g_st);
+    ASSERT_EQ_INT(relay_count(100, 0.625f, BC_DIRTY_FWD | BC_DIRTY_SPEED), 62);
+}
+
+TEST(keyframes_always_relayed)
+{
+    reset_state();
+    /* Absolute position and cloak state reset client baselines */
+    ASSERT_EQ_INT(relay_count(40, 0.25f, BC_DIRTY_POS_ABS), 40);
+    ASSERT_EQ_INT(relay_count(40, 0.25f, BC_DIRTY_CLOAK | BC_DIRTY_SPEED), 40);
+    /* Keyframes do not starve the accumulator: deltas keep their share */
+    bc_interest_init(&g_st);
+    int sent = 0;
+    for (int i = 0; i < 100; i++) {
+        u8 dirty = (i % 10 == 0) ? BC_DIRTY_POS_ABS : BC_DIRTY_POS_DELTA;
+        if (bc_interest_should_relay(&g_st, &g_cfg, 1, 2, 0.25f, dirty)) sent++;
+    }
+    ASSERT(sent >= 25 && sent <= 10 + 25);
+}
+
+TEST(disabled_relays_everything)
+{
+    reset_state();
+    g_cfg.enabled = false;
+    ASSERT_EQ_INT(relay_count(50, 0.0f, BC_DIRTY_POS_DELTA), 50);
+}
+
+TEST(reset_slot_clears_both_roles)
+{
+    reset_state();
+    bc_interest_should_relay(&g_st, &g_cfg, 1, 2, 0.5f, 0);
+    bc_interest_should_relay(&g_st, &g_cfg, 2, 3, 0.5f, 0);
+    bc_interest_should_relay(&g_st, &g_cfg, 4, 5, 0.5f, 0);
+    bc_interest_reset_slot(&g_st, 2);
+    ASSERT(g_st.accum[1][2] == 0.0f);
+    ASSERT(g_st.accum[2][3] == 0.0f);
+    ASSERT(g_st.accum[4][5] == 0.5f);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(weight_by_distance);
+    RUN(weight_cloak_and_missing_ship);
+    RUN(accumulator_rate);
+    RUN(keyframes_always_relayed);
+    RUN(disabled_relays_everything);
+    RUN(reset_slot_clears_both_roles);
+TEST_MAIN_END()
@@ -0,0 +1,281 @@
+#include "test_util.h"
+#include "openbc/job_pool.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+/*
+ * Unit tests for the background job pool (src/server/job_pool.c).
+ *
+ * Covers completion delivery only from bc_job_poll, cancellation of pending,
+ * running and already-finished jobs, per-group running and queue limits,
+ * draining one group before its code goes away without delivering any
+ * other's, stale IDs and teardown with work in flight.
+ * Jobs that must stay "running" spin on a gate the test opens.
+ */
+
+static atomic_int g_gate;           /* 0 = blocking jobs keep spinning */
+static atomic_int g_ran;
+static atomic_int g_running[4];     /* per group, inside run() */
+static atomic_int g_peak[4];
+
+static int g_done_count;
+static int g_done_status[64];
+static int g_done_arg[64];
+
+static void reset(void)
+{
+    atomic_store(&g_gate, 0);
+    atomic_store(&g_ran, 0);
+    for (int i = 0; i < 4; i++) {
+        atomic_store(&g_running[i], 0);
+        atomic_store(&g_peak[i], 0);
+    }
+    g_done_count = 0;
+    memset(g_done_status, 0, sizeof(g_done_status));
+    memset(g_done_arg, 0, sizeof(g_done_arg));
+}
+
+static void run_count(void *arg, int job_id)
+{
+    (void)arg; (void)job_id;
+    atomic_fetch_add(&g_ran, 1);
+}
+
+/* arg = group; tracks concurrency, spins until the gate opens */
+static void run_blocking(void *arg, int job_id)
+{
+    (void)job_id;
+    int g = (int)(size_t)arg;
+    int now = atomic_fetch_add(&g_running[g], 1) + 1;
+    int peak = atomic_load(&g_peak[g]);
+    while (now > peak && !atomic_compare_exchange_weak(&g_peak[g], &peak, now)) {}
+    while (!atomic_load(&g_gate)) {}
+    atomic_fetch_sub(&g_running[g], 1);
+    atomic_fetch_add(&g_ran, 1);
+}
+
+static bc_job_pool_t *g_pool;
+
+/* Spins until it sees its own cancellation */
+static void run_until_cancelled(void *arg, int job_id)
+{
+    (void)arg;
+    atomic_fetch_add(&g_running[0], 1);
+    while (!bc_job_cancel_requested(g_pool, job_id)) {}
+    atomic_fetch_add(&g_ran, 1);
+}
+
+static void on_done(void *arg, int job_id, int status)
+{
+    (void)job_id;
+    if (g_done_count < 64) {
+        g_done_status[g_done_count] = status;
+        g_done_arg[g_done_count] = (int)(size_t)arg;
+    }
+    g_done_count++;
+}
+
+/* Poll until n completions have been delivered in total. */
+static void poll_until(int n)
+{
+    while (g_done_count < n) bc_job_poll(g_pool, 0);
+}
+
+static void wait_running(int group, int n)
+{
+    while (atomic_load(&g_running[group]) < n) {}
+}
+
+TEST(completions_delivered_by_poll)
+{
+    reset();
+    g_pool = bc_job_pool_create(2);
+    ASSERT(g_pool != NULL);
+    ASSERT_EQ_INT(bc_job_pool_workers(g_pool), 2);
+    bc_job_group_limit(g_pool, 0, 2, 32);
+
+    for (int i = 0; i < 10; i++)
+        ASSERT(bc_job_submit(g_pool, 0, run_count, on_done, (void *)(size_t)i) > 0);
+    while (atomic_load(&g_ran) < 10) {}
+    ASSERT_EQ_INT(g_done_count, 0);        /* nothing without a poll */
+
+    poll_until(10);
+    for (int i = 0; i < 10; i++)
+        ASSERT_EQ_INT(g_done_status[i], BC_JOB_DONE);
+
+    bc_job_stats_t st;
+    bc_job_stats(g_pool, &st);
+    ASSERT_EQ_INT(st.submitted, 10);
+    ASSERT_EQ_INT(st.completed, 10);
+    ASSERT_EQ_INT(st.outstanding, 0);
+    ASSERT(st.outstanding_peak >= 1);
+    ASSERT_EQ_INT(bc_job_poll(g_pool, 0), 0);
+    bc_job_pool_destroy(g_pool);
+}
+
+TEST(cancel_pending_and_running)
+{
+    reset();
+    g_pool = bc_job_pool_create(1);
+    int busy = bc_job_submit(g_pool, 0, run_until_cancelled, on_done, (void *)1);
+    bc_job_group_limit(g_pool, 1, 1, 8);
+    int queued = bc_job_submit(g_pool, 1, run_count, on_done, (void *)2);
+    ASSERT(busy > 0 && queued > 0);
+    wait_running(0, 1);
+
+    /* The only worker is busy: `queued` never starts */
+    ASSERT(bc_job_cancel(g_pool, queued));
+    poll_until(1);
+    ASSERT_EQ_INT(g_done_arg[0], 2);
+    ASSERT_EQ_INT(g_done_status[0], BC_JOB_CANCELLED);
+    ASSERT(!bc_job_cancel(g_pool, queued));    /* delivered: stale */
+
+    ASSERT(!bc_job_cancel_requested(g_pool, busy));
+    ASSERT(bc_job_cancel(g_pool, busy));
+    poll_until(2);
+    ASSERT_EQ_INT(g_done_arg[1], 1);
+    ASSERT_EQ_INT(g_done_status[1], BC_JOB_CANCELLED);
+    ASSERT_EQ_INT(atomic_load(&g_ran), 1);     /* only the running one ran */
+
+    /* run() already returned: a late cancel cannot undo it */
+    int late = bc_job_submit(g_pool, 1, run_count, on_done, (void *)3);
+    while (atomic_load(&g_ran) < 2) {}
+    ASSERT(bc_job_cancel(g_pool, late));
+    poll_until(3);
+    ASSERT_EQ_INT(g_done_arg[2], 3);
+    ASSERT_EQ_INT(g_done_status[2], BC_JOB_DONE);
+
+    ASSERT(!bc_job_cancel(g_pool, 0));
+    ASSERT(!bc_job_cancel(g_pool, -1));
+    ASSERT_EQ_INT(bc_job_submit(g_pool, 0, NULL, on_done, NULL), -1);
+    ASSERT_EQ_INT(bc_job_submit(g_pool, BC_JOB_MAX_GROUPS, run_count, NULL, NULL), -1);
+    bc_job_pool_destroy(g_pool);
+}
+
+TEST(group_running_limit_shares_workers)
+{
+    reset();
+    g_pool = bc_job_pool_create(4);
+    bc_job_group_limit(g_pool, 0, 1, 16);
+    bc_job_group_limit(g_pool, 1, 2, 16);
+
+    /* Group 0 floods first, yet group 1 still gets workers */
+    for (int i = 0; i < 6; i++)
+        bc_job_submit(g_pool, 0, run_blocking, on_done, (void *)0);
+    for (int i = 0; i < 3; i++)
+        bc_job_submit(g_pool, 1, run_blocking, on_done, (void *)1);
+    wait_running(0, 1);
+    wait_running(1, 2);
+    ASSERT_EQ_INT(atomic_load(&g_running[0]), 1);
+    ASSERT_EQ_INT(atomic_load(&g_running[1]), 2);
+
+    atomic_store(&g_gate, 1);
+    poll_until(9);
+    ASSERT_EQ_INT(atomic_load(&g_peak[0]), 1);
+    ASSERT_EQ_INT(atomic_load(&g_peak[1]), 2);
+    bc_job_pool_destroy(g_pool);
+}
+
+TEST(group_queue_limit_rejects)
+{
+    reset();
+    g_pool = bc_job_pool_create(1);
+    bc_job_group_limit(g_pool, 2, 1, 3);
+    for (int i = 0; i < 3; i++)
+        ASSERT(bc_job_submit(g_pool, 2, run_blocking, on_done, (void *)2) > 0);
+    ASSERT_EQ_INT(bc_job_submit(g_pool, 2, run_blocking, on_done, (void *)2), -1);
+    ASSERT(bc_job_submit(g_pool, 3, run_count, on_done, (void *)3) > 0);
+
+    bc_job_stats_t st;
+    bc_job_stats(g_pool, &st);
+    ASSERT_EQ_INT(st.rejected, 1);
+
+    /* Slots free up only once completions are delivered */
+    atomic_store(&g_gate, 1);
+    poll_until(4);
+    ASSERT(bc_job_submit(g_pool, 2, run_count, on_done, (void *)2) > 0);
+    poll_until(5);
+    bc_job_pool_destroy(g_pool);
+}
+
+TEST(cancel_group_waits_and_delivers)
+{
+    reset();
+    g_pool = bc_job_pool_create(2);
+    bc_job_group_limit(g_pool, 0, 1, 8);
+    bc_job_submit(g_pool, 0, run_until_cancelled, on_done, (void *)0);
+    bc_job_submit(g_pool, 0, run_count, on_done, (void *)0);
+    bc_job_submit(g_pool, 1, run_count, on_done, (void *)1);
+    wait_running(0, 1);
+    while (atomic_load(&g_ran) < 1) {}   /* group 1's job has finished */
+
+    /* Only group 0 is delivered; group 1's completion waits for a poll */
+    bc_job_cancel_group(g_pool, 0);
+    ASSERT_EQ_INT(g_done_count, 2);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ_INT(g_done_arg[i], 0);
+        ASSERT_EQ_INT(g_done_status[i], BC_JOB_CANCELLED);
+    }
+    ASSERT_EQ_INT(atomic_load(&g_running[0]), 1);   /* returned, not killed */
+
+    ASSERT_EQ_INT(bc_job_poll(g_pool, 0), 1);
+    ASSERT_EQ_INT(g_done_arg[2], 1);
+    ASSERT_EQ_INT(g_done_status[2], BC_JOB_DONE);
+    bc_job_pool_destroy(g_pool);
+}
+
+TEST(destroy_delivers_everything)
+{
+    reset();
+    g_pool = bc_job_pool_create(1);
+    bc_job_submit(g_pool, 0, run_until_cancelled, on_done, (void *)0);
+    for (int i = 0; i < 5; i++)
+        bc_job_submit(g_pool, 1, run_count, on_done, (void *)1);
+    wait_running(0, 1);
+
+    bc_job_pool_destroy(g_pool);
+    ASSERT_EQ_INT(g_done_count, 6);
+    for (int i = 0; i < 6; i++)
+        ASSERT_EQ_INT(g_done_status[i], BC_JOB_CANCELLED);
+
+    /* NULL pool is inert */
+    ASSERT_EQ_INT(bc_job_submit(NULL, 0, run_count, NULL, NULL), -1);
+    ASSERT(!bc_job_cancel(NULL, 1));
+    ASSERT_EQ_INT(bc_job_poll(NULL, 0), 0);
+    bc_job_pool_destroy(NULL);
+}
+
+TEST(slots_recycle_with_new_ids)
+{
+    reset();
+    g_pool = bc_job_pool_create(2);
+    bc_job_group_limit(g_pool, 0, 2, BC_JOB_MAX);
+    int first = bc_job_submit(g_pool, 0, run_count, on_done, NULL);
+    poll_until(1);
+
+    /* Every slot, then one more */
+    int ids[BC_JOB_MAX];
+    atomic_store(&g_gate, 0);
+    for (int i = 0; i < BC_JOB_MAX; i++) {
+        ids[i] = bc_job_submit(g_pool, 0, run_blocking, on_done, (void *)0);
+        ASSERT(ids[i] > 0);
+        ASSERT(ids[i] != first);
+    }
+    ASSERT_EQ_INT(bc_job_submit(g_pool, 0, run_count, NULL, NULL), -1);
+    ASSERT(!bc_job_cancel(g_pool, first));
+
+    atomic_store(&g_gate, 1);
+    poll_until(1 + BC_JOB_MAX);
+    bc_job_pool_destroy(g_pool);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(completions_delivered_by_poll);
+    RUN(cancel_pending_and_running);
+    RUN(group_running_limit_shares_workers);
+    RUN(group_queue_limit_rejects);
+    RUN(cancel_group_waits_and_delivers);
+    RUN(destroy_delivers_everything);
+    RUN(slots_recycle_with_new_ids);
+TEST_MAIN_END()
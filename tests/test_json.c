@@ -1,5 +1,7 @@
 #include "test_util.h"
 #include "openbc/json_parse.h"
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* === JSON parser tests === */
@@ -162,6 +164,356 @@ TEST(json_parse_invalid)
     ASSERT(json_parse("[1, 2,]") == NULL);  /* trailing comma */
 }
 
+/* === Arena / in-situ mode === */
+
+static bool json_equal(const json_value_t *a, const json_value_t *b)
+{
+    if (!a || !b || a->type != b->type) return false;
+    switch (a->type) {
+    case JSON_NULL:   return true;
+    case JSON_BOOL:   return a->boolean == b->boolean;
+    case JSON_NUMBER: return a->number == b->number;
+    case JSON_STRING: return strcmp(a->string, b->string) == 0;
+    case JSON_ARRAY:
+        if (a->array.count != b->array.count) return false;
+        for (size_t i = 0; i < a->array.count; i++)
+            if (!json_equal(a->array.items[i], b->array.items[i])) return false;
+        return true;
+    case JSON_OBJECT:
+        if (a->object.count != b->object.count) return false;
+        for (size_t i = 0; i < a->object.count; i++) {
+            if (strcmp(a->object.members[i].key, b->object.members[i].key) != 0)
+                return false;
+            if (!json_equal(a->object.members[i].value, b->object.members[i].value))
+                return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+static const char *k_doc =
+    "{\"name\": \"Gal\\\"axy\\n\", \"ids\": [1, -2.5, 3e2], \"empty\": [],"
+    " \"obj\": {}, \"nested\": {\"a\": [true, false, null, \"x\\\\y\"]}}";
+
+TEST(json_insitu_matches_heap)
+{
+    char buf[256];
+    strcpy(buf, k_doc);
+    json_value_t *heap = json_parse(k_doc);
+    json_value_t *arena = json_parse_insitu(buf);
+    ASSERT(heap != NULL && arena != NULL);
+    ASSERT(json_equal(heap, arena));
+    ASSERT_EQ_INT(arena->arena, JSON_ARENA_ROOT);
+    ASSERT_EQ_INT(heap->arena, JSON_ARENA_NONE);
+    json_free(heap);
+    json_free(arena);
+}
+
+TEST(json_insitu_strings_live_in_text)
+{
+    char buf[] = "{\"key\": \"a\\tb\\\"c\"}";
+    json_value_t *v = json_parse_insitu(buf);
+    ASSERT(v != NULL);
+    const char *s = json_string(json_get(v, "key"));
+    ASSERT(s != NULL);
+    ASSERT(strcmp(s, "a\tb\"c") == 0);
+    ASSERT(s >= buf && s < buf + sizeof(buf));
+    ASSERT(v->object.members[0].key >= buf);
+
+    /* Interior nodes are owned by the document */
+    json_value_t *inner = json_get(v, "key");
+    ASSERT_EQ_INT(inner->arena, JSON_ARENA_NODE);
+    json_free(inner);                        /* no-op */
+    ASSERT(strcmp(json_string(json_get(v, "key")), "a\tb\"c") == 0);
+    json_free(v);
+}
+
+TEST(json_insitu_invalid)
+{
+    char a[] = "";
+    char b[] = "{broken";
+    char c[] = "[1, 2,]";
+    char d[] = "{\"k\": \"unterminated}";
+    char e[] = "[{\"a\": [1, {\"b\": }]}]";
+    ASSERT(json_parse_insitu(a) == NULL);
+    ASSERT(json_parse_insitu(b) == NULL);
+    ASSERT(json_parse_insitu(c) == NULL);
+    ASSERT(json_parse_insitu(d) == NULL);
+    ASSERT(json_parse_insitu(e) == NULL);
+    ASSERT(json_parse(e) == NULL);           /* heap unwind path */
+}
+
+TEST(json_insitu_grows_past_first_chunk)
+{
+    /* Dense enough to outgrow the initial size estimate */
+    size_t cap = 64 * 1024;
+    char *text = malloc(cap);
+    char *heap_text = malloc(cap);
+    ASSERT(text != NULL && heap_text != NULL);
+    size_t n = 0;
+    text[n++] = '[';
+    for (int i = 0; i < 8000; i++)
+        n += (size_t)snprintf(text + n, cap - n, i ? ",[%d]" : "[%d]", i % 10);
+    text[n++] = ']';
+    text[n] = '\0';
+    memcpy(heap_text, text, n + 1);
+
+    json_value_t *heap = json_parse(heap_text);
+    json_value_t *arena = json_parse_insitu(text);
+    ASSERT(heap != NULL && arena != NULL);
+    ASSERT_EQ_INT((int)json_array_len(arena), 8000);
+    ASSERT(json_equal(heap, arena));
+    ASSERT_EQ_INT(json_int(json_array_get(json_array_get(arena, 7999), 0)), 9);
+    json_free(heap);
+    json_free(arena);
+    free(heap_text);
+    free(text);
+}
+
+TEST(json_load_file_owns_text)
+{
+    const char *path = "data/vanilla-1.1/ships/galaxy/subsystems.json";
+    json_value_t *v = json_load_file(path);
+    ASSERT(v != NULL);
+    ASSERT_EQ_INT(v->type, JSON_ARRAY);
+    ASSERT(json_array_len(v) > 10);
+
+    FILE *f = fopen(path, "rb");
+    ASSERT(f != NULL);
+    static char text[256 * 1024];
+    size_t n = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+    text[n] = '\0';
+    json_value_t *heap = json_parse(text);
+    ASSERT(json_equal(heap, v));
+    json_free(heap);
+    json_free(v);
+
+    ASSERT(json_load_file("data/no_such_file.json") == NULL);
+}
+
+/* === Streaming reader === */
+
+TEST(json_reader_tokens)
+{
+    json_reader_t r;
+    json_reader_init(&r, "{\"a\": [1.5, true, null, \"x\\ny\"], \"b\": {}}");
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_OBJECT);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_KEY);
+    ASSERT(strcmp(r.str, "a") == 0);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_ARRAY);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_NUMBER);
+    ASSERT(r.number == 1.5);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_BOOL);
+    ASSERT(r.boolean == true);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_NULL);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_STRING);
+    ASSERT(strcmp(r.str, "x\ny") == 0);
+    ASSERT_EQ_INT((int)r.str_len, 3);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_ARRAY_END);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_KEY);
+    ASSERT(strcmp(r.str, "b") == 0);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_OBJECT);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_OBJECT_END);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_OBJECT_END);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_END);
+    ASSERT(json_reader_ok(&r));
+    json_reader_close(&r);
+}
+
+TEST(json_reader_keys_items_and_mismatch)
+{
+    json_reader_t r;
+    json_reader_init(&r,
+        "{\"skip\": {\"deep\": [[1], {\"k\": 2}]}, \"n\": \"not a number\","
+        " \"list\": [10, 20, 30], \"flag\": false, \"name\": \"Galaxy\"}");
+    double n = -1.0, sum = 0.0;
+    bool flag = true;
+    char name[4] = "";
+    int items = 0;
+
+    ASSERT(json_reader_begin_object(&r));
+    while (json_reader_key(&r)) {
+        if (strcmp(r.str, "n") == 0) {
+            ASSERT(!json_reader_number(&r, &n));   /* consumed, untouched */
+        } else if (strcmp(r.str, "list") == 0) {
+            ASSERT(json_reader_begin_array(&r));
+            while (json_reader_item(&r)) {
+                double d = 0.0;
+                ASSERT(json_reader_number(&r, &d));
+                sum += d;
+                items++;
+            }
+        } else if (strcmp(r.str, "flag") == 0) {
+            ASSERT(json_reader_bool(&r, &flag));
+        } else if (strcmp(r.str, "name") == 0) {
+            ASSERT(json_reader_string(&r, name, sizeof(name)));
+        } else {
+            ASSERT(json_reader_skip(&r));
+        }
+    }
+    ASSERT(json_reader_ok(&r));
+    ASSERT(n == -1.0);
+    ASSERT_EQ_INT(items, 3);
+    ASSERT(sum == 60.0);
+    ASSERT(flag == false);
+    ASSERT(strcmp(name, "Gal") == 0);   /* truncated */
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_END);
+    json_reader_close(&r);
+
+    /* begin_* on the wrong type skips the value */
+    json_reader_init(&r, "[{\"a\": 1}, 5]");
+    ASSERT(json_reader_begin_array(&r));
+    ASSERT(json_reader_item(&r));
+    ASSERT(!json_reader_begin_array(&r));
+    ASSERT(json_reader_item(&r));
+    ASSERT(!json_reader_begin_object(&r));
+    ASSERT(!json_reader_item(&r));
+    ASSERT(json_reader_ok(&r));
+    json_reader_close(&r);
+}
+
+/* Drain every token; true if the document reads cleanly to the end. */
+static bool reader_accepts(const char *text)
+{
+    json_reader_t r;
+    json_reader_init(&r, text);
+    json_tok_t t;
+    do {
+        t = json_reader_next(&r);
+    } while (t != JSON_TOK_END && t != JSON_TOK_ERROR);
+    bool ok = t == JSON_TOK_END && json_reader_ok(&r);
+    json_reader_close(&r);
+    return ok;
+}
+
+TEST(json_reader_errors)
+{
+    ASSERT(reader_accepts("{\"a\": [1, 2], \"b\": null}"));
+    ASSERT(reader_accepts("  \"s\"  "));
+    ASSERT(!reader_accepts(""));
+    ASSERT(!reader_accepts("[1, 2,]"));
+    ASSERT(!reader_accepts("{\"a\": 1,}"));
+    ASSERT(!reader_accepts("{\"a\" 1}"));
+    ASSERT(!reader_accepts("{1: 2}"));
+    ASSERT(!reader_accepts("[1 2]"));
+    ASSERT(!reader_accepts("[1}"));
+    ASSERT(!reader_accepts("\"open"));
+    ASSERT(reader_accepts("{} x"));   /* like json_parse: text after the value is ignored */
+    ASSERT(!reader_accepts("tru"));
+    ASSERT(!reader_accepts("1.2.3"));
+
+    /* Nesting limit */
+    char deep[2 * JSON_READER_MAX_DEPTH + 8];
+    int n = 0;
+    for (int i = 0; i < JSON_READER_MAX_DEPTH; i++) deep[n++] = '[';
+    for (int i = 0; i < JSON_READER_MAX_DEPTH; i++) deep[n++] = ']';
+    deep[n] = '\0';
+    ASSERT(reader_accepts(deep));
+    memmove(deep + 1, deep, (size_t)n + 1);
+    deep[0] = '[';
+    deep[n + 1] = ']';
+    deep[n + 2] = '\0';
+    ASSERT(!reader_accepts(deep));
+
+    /* Errors are sticky and carry the line */
+    json_reader_t r;
+    json_reader_init(&r, "{\n  \"a\": 1,\n  \"b\": oops\n}");
+    ASSERT(json_reader_begin_object(&r));
+    while (json_reader_key(&r)) json_reader_skip(&r);
+    ASSERT(!json_reader_ok(&r));
+    ASSERT_EQ_INT(r.line, 3);
+    ASSERT_EQ_INT(json_reader_next(&r), JSON_TOK_ERROR);
+    ASSERT(!json_reader_skip(&r));
+    json_reader_close(&r);
+}
+
+/* Fold a DOM into the token stream the reader would produce. */
+static unsigned long fold_dom(unsigned long h, const json_value_t *v)
+{
+    h = h * 31 + (unsigned long)v->type;
+    switch (v->type) {
+    case JSON_NUMBER: h = h * 31 + (unsigned long)(long)(v->number * 1000.0); break;
+    case JSON_BOOL:   h = h * 31 + (v->boolean ? 1u : 0u); break;
+    case JSON_STRING: h = h * 31 + strlen(v->string); break;
+    case JSON_ARRAY:
+        for (size_t i = 0; i < v->array.count; i++) h = fold_dom(h, v->array.items[i]);
+        h = h * 31 + 99;
+        break;
+    case JSON_OBJECT:
+        for (size_t i = 0; i < v->object.count; i++) {
+            h = h * 31 + strlen(v->object.members[i].key);
+            h = fold_dom(h, v->object.members[i].value);
+        }
+        h = h * 31 + 99;
+        break;
+    default:
+        break;
+    }
+    return h;
+}
+
+/* The same fold over the reader's token stream. */
+static unsigned long fold_reader(json_reader_t *r)
+{
+    unsigned long h = 0;
+    for (;;) {
+        json_tok_t t = json_reader_next(r);
+        switch (t) {
+        case JSON_TOK_END:        return h;
+        case JSON_TOK_ERROR:      return 0;
+        case JSON_TOK_OBJECT:     h = h * 31 + JSON_OBJECT; break;
+        case JSON_TOK_ARRAY:      h = h * 31 + JSON_ARRAY; break;
+        case JSON_TOK_OBJECT_END:
+        case JSON_TOK_ARRAY_END:  h = h * 31 + 99; break;
+        case JSON_TOK_KEY:        h = h * 31 + r->str_len; break;
+        case JSON_TOK_NULL:       h = h * 31 + JSON_NULL; break;
+        case JSON_TOK_NUMBER:
+            h = (h * 31 + JSON_NUMBER) * 31 + (unsigned long)(long)(r->number * 1000.0);
+            break;
+        case JSON_TOK_BOOL:
+            h = (h * 31 + JSON_BOOL) * 31 + (r->boolean ? 1u : 0u);
+            break;
+        case JSON_TOK_STRING:
+            h = (h * 31 + JSON_STRING) * 31 + r->str_len;
+            break;
+        }
+    }
+}
+
+TEST(json_reader_file_matches_dom)
+{
+    /* Larger than the read window, so tokens straddle refills */
+    const char *path = "data/vanilla-1.1/ships/galaxy/subsystems.json";
+    json_value_t *dom = json_load_file(path);
+    ASSERT(dom != NULL);
+    unsigned long expect = fold_dom(0, dom);
+    json_free(dom);
+
+    json_reader_t r;
+    ASSERT(json_reader_open(&r, path));
+    unsigned long got = fold_reader(&r);
+    ASSERT(json_reader_ok(&r));
+    ASSERT(r.line > 100);
+    json_reader_close(&r);
+    ASSERT(got == expect);
+
+    /* Same document from memory */
+    FILE *f = fopen(path, "rb");
+    ASSERT(f != NULL);
+    static char text[256 * 1024];
+    size_t n = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+    text[n] = '\0';
+    ASSERT(n > JSON_READER_WINDOW);
+    json_reader_init(&r, text);
+    ASSERT(fold_reader(&r) == expect);
+    json_reader_close(&r);
+
+    ASSERT(!json_reader_open(&r, "data/no_such_file.json"));
+}
+
 /* === Run all tests === */
 
 TEST_MAIN_BEGIN()
@@ -180,4 +532,13 @@ TEST_MAIN_BEGIN()
     RUN(json_parse_bool_values);
     RUN(json_accessor_type_mismatch);
     RUN(json_parse_invalid);
+    RUN(json_insitu_matches_heap);
+    RUN(json_insitu_strings_live_in_text);
+    RUN(json_insitu_invalid);
+    RUN(json_insitu_grows_past_first_chunk);
+    RUN(json_load_file_owns_text);
+    RUN(json_reader_tokens);
+    RUN(json_reader_keys_items_and_mismatch);
+    RUN(json_reader_errors);
+    RUN(json_reader_file_matches_dom);
 TEST_MAIN_END()
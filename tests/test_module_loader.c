@@ -2,6 +2,7 @@
 #include "openbc/module_loader.h"
 #include "openbc/event_bus.h"
 #include "openbc/config.h"
+#include "openbc/server_state.h"
 
 #include <string.h>
 
@@ -195,6 +196,13 @@ TEST(api_build_event_ptrs_non_null)
     ASSERT(api.event_subscribe   != NULL);
     ASSERT(api.event_unsubscribe != NULL);
     ASSERT(api.event_fire        != NULL);
+
+    ASSERT(api.event_register       != NULL);
+    ASSERT(api.event_subscribe_id   != NULL);
+    ASSERT(api.event_unsubscribe_id != NULL);
+    ASSERT(api.event_fire_id        != NULL);
+    ASSERT(api.event_has_subscribers != NULL);
+    ASSERT(api.event_post           != NULL);
 }
 
 TEST(api_build_config_ptrs_non_null)
@@ -326,16 +334,368 @@ TEST(api_build_shield_ptrs_non_null)
     ASSERT(api.ship_shield_hp_max != NULL);
 }
 
-TEST(api_build_timer_ptrs_null)
+static int         s_timer_calls;
+static const void *s_timer_data;
+static void timer_handler(const obc_engine_api_t *api, obc_event_ctx_t *ctx)
+{
+    (void)api;
+    s_timer_calls++;
+    s_timer_data = ctx->event_data;
+}
+
+TEST(api_build_timer_ptrs_set)
+{
+    obc_engine_api_t api;
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    obc_module_api_build(&api, &cfg);
+
+    ASSERT(api.timer_add    != NULL);
+    ASSERT(api.timer_remove != NULL);
+}
+
+TEST(api_timer_fires_on_wheel)
+{
+    obc_engine_api_t api;
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    obc_module_api_build(&api, &cfg);
+    bc_timer_wheel_init(&g_timers, 0);
+
+    static int cookie;
+    s_timer_calls = 0;
+    s_timer_data = NULL;
+    ASSERT_EQ_INT(api.timer_add(0.0f, timer_handler, &cookie), -1);
+    ASSERT_EQ_INT(api.timer_add(1.0f, NULL, &cookie), -1);
+    api.timer_remove(-1);                                     /* no crash */
+
+    int id = api.timer_add(1.0f, timer_handler, &cookie);     /* 30 ticks */
+    ASSERT(id > 0);
+    for (int t = 0; t < 29; t++) bc_timer_advance(&g_timers);
+    ASSERT_EQ_INT(s_timer_calls, 0);
+    bc_timer_advance(&g_timers);
+    ASSERT_EQ_INT(s_timer_calls, 1);
+    ASSERT(s_timer_data == &cookie);
+
+    /* Periodic until removed */
+    for (int t = 0; t < 30; t++) bc_timer_advance(&g_timers);
+    ASSERT_EQ_INT(s_timer_calls, 2);
+    api.timer_remove(id);
+    for (int t = 0; t < 90; t++) bc_timer_advance(&g_timers);
+    ASSERT_EQ_INT(s_timer_calls, 2);
+    ASSERT_EQ_INT(g_timers.stats.active, 0);
+
+    /* Loader shutdown disarms whatever modules left behind */
+    ASSERT(api.timer_add(0.5f, timer_handler, NULL) > 0);
+    obc_module_loader_t loader;
+    memset(&loader, 0, sizeof(loader));
+    obc_module_loader_shutdown(&loader);
+    ASSERT_EQ_INT(g_timers.stats.active, 0);
+}
+
+static const obc_engine_api_t *s_job_api;
+static int   s_job_status;
+static void *s_job_arg;
+static int   s_job_done_calls;
+
+static void job_run(void *arg, int job_id)
+{
+    (void)job_id;
+    *(int *)arg = 42;                  /* worker thread */
+}
+
+/* Holds its worker until cancelled, so the cancel cannot arrive late */
+static const obc_engine_api_t *s_spin_api;
+static void job_run_until_cancelled(void *arg, int job_id)
+{
+    (void)arg;
+    while (!s_spin_api->job_cancelled(job_id)) {}
+}
+
+static void job_done(const obc_engine_api_t *api, void *arg, int job_id,
+                     int status)
+{
+    (void)job_id;
+    s_job_api    = api;
+    s_job_arg    = arg;
+    s_job_status = status;
+    s_job_done_calls++;
+}
+
+TEST(api_job_runs_and_completes_on_poll)
+{
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    cfg.module_count = 0;
+    obc_event_bus_init();
+
+    /* No pool: submissions are refused */
+    obc_module_loader_t loader;
+    ASSERT_EQ_INT(0, obc_module_loader_init(&loader, &cfg));
+    ASSERT(loader.api.job_submit    != NULL);
+    ASSERT(loader.api.job_cancel    != NULL);
+    ASSERT(loader.api.job_cancelled != NULL);
+    const obc_module_t *self = &loader.modules[0].module;
+    static int result;
+    ASSERT_EQ_INT(loader.api.job_submit(self, job_run, job_done, &result), -1);
+
+    g_jobs = bc_job_pool_create(1);
+    ASSERT(g_jobs != NULL);
+    obc_module_loader_shutdown(&loader);
+    ASSERT_EQ_INT(0, obc_module_loader_init(&loader, &cfg));
+
+    /* Unknown module handle */
+    obc_module_t stranger;
+    memset(&stranger, 0, sizeof(stranger));
+    ASSERT_EQ_INT(loader.api.job_submit(&stranger, job_run, job_done, &result), -1);
+
+    s_job_done_calls = 0;
+    result = 0;
+    int id = loader.api.job_submit(self, job_run, job_done, &result);
+    ASSERT(id > 0);
+    ASSERT(!loader.api.job_cancelled(id));
+    while (s_job_done_calls == 0) bc_job_poll(g_jobs, 0);
+    ASSERT_EQ_INT(result, 42);
+    ASSERT(s_job_api == &loader.api);
+    ASSERT(s_job_arg == &result);
+    ASSERT_EQ_INT(s_job_status, OBC_JOB_DONE);
+    ASSERT_EQ_INT(loader.api.job_cancel(self, id), 0); /* already delivered */
+
+    /* Only the submitting module may cancel */
+    const obc_module_t *other = &loader.modules[1].module;
+    s_job_done_calls = 0;
+    s_spin_api = &loader.api;
+    id = loader.api.job_submit(self, job_run_until_cancelled, job_done, &result);
+    ASSERT(id > 0);
+    ASSERT_EQ_INT(loader.api.job_cancel(other, id), 0);
+    ASSERT_EQ_INT(loader.api.job_cancel(&stranger, id), 0);
+    ASSERT(!loader.api.job_cancelled(id));
+    ASSERT_EQ_INT(loader.api.job_cancel(self, id), 1);
+    ASSERT(loader.api.job_cancelled(id));
+    while (s_job_done_calls == 0) bc_job_poll(g_jobs, 0);
+    ASSERT_EQ_INT(s_job_status, OBC_JOB_CANCELLED);
+
+    /* Per-module queue limit from [jobs] */
+    for (int i = 0; i < cfg.job_max_queued; i++)
+        ASSERT(loader.api.job_submit(self, job_run, job_done, &result) > 0);
+    ASSERT_EQ_INT(loader.api.job_submit(self, job_run, job_done, &result), -1);
+
+    /* Loader shutdown delivers whatever the module left outstanding */
+    s_job_done_calls = 0;
+    obc_module_loader_shutdown(&loader);
+    ASSERT_EQ_INT(s_job_done_calls, cfg.job_max_queued);
+
+    bc_job_pool_destroy(g_jobs);
+    g_jobs = NULL;
+    obc_event_bus_shutdown();
+}
+
+TEST(api_frame_memory_from_arena)
+{
+    obc_engine_api_t api;
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    obc_module_api_build(&api, &cfg);
+    ASSERT(api.frame_alloc  != NULL);
+    ASSERT(api.frame_printf != NULL);
+
+    static u8 buf[1024];
+    bc_arena_init(&g_frame, buf, sizeof(buf));
+    u8 *p = api.frame_alloc(100);
+    ASSERT(p != NULL);
+    ASSERT(((uintptr_t)p & 15) == 0);
+    ASSERT(api.frame_alloc(0) == NULL);
+    ASSERT(api.frame_alloc(-4) == NULL);
+    ASSERT(api.frame_alloc(4096) == NULL);
+
+    const char *s = api.frame_printf("slot %d: %s", 3, "Kirk");
+    ASSERT(s != NULL && strcmp(s, "slot 3: Kirk") == 0);
+    ASSERT(g_frame.used > 100);
+
+    bc_arena_reset(&g_frame);
+    ASSERT_EQ_INT(g_frame.used, 0);
+    bc_arena_init(&g_frame, NULL, 0);
+}
+
+TEST(api_ships_snapshot_shared_per_tick)
 {
     obc_engine_api_t api;
     obc_server_cfg_t cfg;
     obc_config_defaults(&cfg);
     obc_module_api_build(&api, &cfg);
+    ASSERT(api.ships_snapshot != NULL);
+
+    ASSERT(bc_peers_init(&g_peers, 4));
+    bc_peers_reserve_dedicated(&g_peers, "Dedicated Server");
+    bc_addr_t a;
+    memset(&a, 0, sizeof(a));
+    a.ip = 0x0100007F;
+    a.port = 22101;
+    int slot = bc_peers_add(&g_peers, &a);
+    ASSERT(slot > 0);
+    g_peers.peers[slot].has_ship = true;
+    g_peers.peers[slot].ship.object_id = 0x3FFF;
+    g_peers.peers[slot].ship.alive = true;
+
+    int n = -1;
+    const obc_ship_view_t *v = api.ships_snapshot(&n);
+    ASSERT(v != NULL);
+    ASSERT_EQ_INT(n, 1);
+    ASSERT_EQ_INT(v[0].slot, slot);
+    ASSERT_EQ_INT(v[0].object_id, 0x3FFF);
+    ASSERT_EQ_INT(v[0].class_index, -1);
+    ASSERT(api.ships_snapshot(NULL) == v);
+    ASSERT_EQ_INT(g_ship_snapshot.builds, 1);   /* shared, not rebuilt */
+
+    bc_ship_snapshot_invalidate(&g_ship_snapshot);
+    g_peers.peers[slot].has_ship = false;
+    api.ships_snapshot(&n);
+    ASSERT_EQ_INT(n, 0);
+    bc_ship_snapshot_invalidate(&g_ship_snapshot);
+    bc_peers_free(&g_peers);
+}
+
+static int g_hook_slot;
+static const obc_engine_api_t *g_hook_api;
+
+static int test_packet_hook(const obc_engine_api_t *api, int slot,
+                            unsigned char *data, int *len, void *user_data)
+{
+    g_hook_api  = api;
+    g_hook_slot = slot;
+    if (user_data) return OBC_PACKET_DROP;
+    data[1] = 0x42;
+    *len = 2;
+    return OBC_PACKET_REWRITE;
+}
+
+TEST(api_packet_hook_filters_and_rewrites)
+{
+    obc_engine_api_t api;
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    obc_module_api_build(&api, &cfg);
+    ASSERT(api.packet_hook_add != NULL);
+    ASSERT(api.packet_hook_remove != NULL);
+
+    bc_packet_hooks_init(&g_packet_hooks);
+    static const unsigned char ops[] = { 0x2C };
+    int id = api.packet_hook_add(ops, 1, test_packet_hook, 0, NULL);
+    ASSERT(id > 0);
+    ASSERT(bc_packet_hook_wanted(&g_packet_hooks, 0x2C));
+    ASSERT(!bc_packet_hook_wanted(&g_packet_hooks, 0x2D));
+
+    u8 msg[4] = { 0x2C, 0, 0, 0 };
+    int len = 4;
+    ASSERT_EQ_INT(bc_packet_hook_run(&g_packet_hooks, 3, msg, &len),
+                  BC_PACKET_REWRITE);
+    ASSERT(g_hook_api == &api);
+    ASSERT_EQ_INT(g_hook_slot, 3);
+    ASSERT_EQ_INT(msg[1], 0x42);
+    ASSERT_EQ_INT(len, 2);
+
+    int drop = api.packet_hook_add(ops, 1, test_packet_hook, -1, (void *)1);
+    ASSERT_EQ_INT(bc_packet_hook_run(&g_packet_hooks, 3, msg, &len),
+                  BC_PACKET_DROP);
+
+    api.packet_hook_remove(drop);
+    api.packet_hook_remove(id);
+    api.packet_hook_remove(id);       /* stale: no-op */
+    ASSERT(!bc_packet_hook_wanted(&g_packet_hooks, 0x2C));
+    ASSERT_EQ_INT(api.packet_hook_add(ops, 1, NULL, 0, NULL), -1);
+}
+
+static int g_kernel_calls;
+static f32 g_kernel_damage;
+
+static void flat_hull_damage(bc_ship_state_t *target, const bc_ship_class_t *cls,
+                             f32 damage, f32 damage_radius, bc_vec3_t impact_dir,
+                             bool area_effect, f32 search_radius)
+{
+    (void)cls; (void)damage_radius; (void)impact_dir;
+    (void)area_effect; (void)search_radius;
+    g_kernel_calls++;
+    g_kernel_damage = damage;
+    target->hull_hp -= damage;
+}
+
+TEST(api_combat_kernels_replaced_at_load_only)
+{
+    obc_engine_api_t api;
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    obc_module_api_build(&api, &cfg);
+    ASSERT(api.combat_kernels_get != NULL);
+    ASSERT(api.combat_kernels_set != NULL);
+
+    obc_combat_kernels_t k;
+    api.combat_kernels_get(&k);
+    ASSERT(k.apply_damage == bc_combat_apply_damage);
+    ASSERT(k.repair_tick == bc_repair_tick);
+
+    /* Only the damage kernel: the others stay built-in */
+    obc_module_t self = { .name = "rules" };
+    obc_combat_kernels_t mine = { .apply_damage = flat_hull_damage };
+    g_combat_kernels_locked = false;
+    ASSERT_EQ_INT(api.combat_kernels_set(&self, &mine), 0);
+    ASSERT_EQ_INT(api.combat_kernels_set(&self, NULL), -1);
+    api.combat_kernels_get(&k);
+    ASSERT(k.apply_damage == flat_hull_damage);
+    ASSERT(k.shield_tick == bc_combat_shield_tick);
+
+    /* Engine damage paths go through the table */
+    static bc_game_registry_t reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ship_count = 1;
+    reg.ships[0].hull_hp = 1000.0f;
+    g_registry = &reg;
+    g_registry_loaded = true;
+    ASSERT(bc_peers_init(&g_peers, 4));
+    bc_peers_reserve_dedicated(&g_peers, "Dedicated Server");
+    bc_addr_t a;
+    memset(&a, 0, sizeof(a));
+    a.ip = 0x0100007F;
+    a.port = 22101;
+    int slot = bc_peers_add(&g_peers, &a);
+    g_peers.peers[slot].has_ship = true;
+    g_peers.peers[slot].class_index = 0;
+    g_peers.peers[slot].ship.hull_hp = 1000.0f;
+    g_kernel_calls = 0;
+    api.ship_apply_damage(slot, 250.0f, -1);
+    ASSERT_EQ_INT(g_kernel_calls, 1);
+    ASSERT(g_kernel_damage == 250.0f);
+    ASSERT(g_peers.peers[slot].ship.hull_hp == 750.0f);
+    /* The kernel never journaled: the engine did it for the kernel */
+    ASSERT(g_peers.peers[slot].ship.journal.changed & BC_SHIP_CHG_HULL);
+
+    /* Direct subsystem damage is journaled like a hit */
+    reg.ships[0].subsystem_count = 2;
+    g_peers.peers[slot].ship.subsystem_hp[1] = 30.0f;
+    g_peers.peers[slot].ship.journal.hit_subsys = 0;
+    api.ship_apply_subsystem_damage(slot, 1, 50.0f);
+    ASSERT(g_peers.peers[slot].ship.subsystem_hp[1] == 0.0f);
+    ASSERT(g_peers.peers[slot].ship.journal.hit_subsys == 2);
+    ASSERT_EQ_INT(g_peers.peers[slot].ship.journal.event_count, 1);
+    ASSERT_EQ_INT(g_peers.peers[slot].ship.journal.events[0].type,
+                  BC_SHIP_EV_SUBSYS_DESTROYED);
+
+    /* After loading, replacement is refused */
+    g_combat_kernels_locked = true;
+    obc_combat_kernels_t other = { .repair_tick = bc_repair_tick };
+    ASSERT_EQ_INT(api.combat_kernels_set(&self, &other), -1);
+
+    /* Loader shutdown restores the built-in kernels */
+    obc_module_loader_t loader;
+    memset(&loader, 0, sizeof(loader));
+    obc_module_loader_shutdown(&loader);
+    ASSERT(g_combat_kernels.apply_damage == bc_combat_apply_damage);
+    api.combat_kernels_get(&k);
+    ASSERT(k.apply_damage == bc_combat_apply_damage);
 
-    /* No timer subsystem exists yet */
-    ASSERT(api.timer_add    == NULL);
-    ASSERT(api.timer_remove == NULL);
+    g_combat_kernels_locked = false;
+    g_registry_loaded = false;
+    g_registry = NULL;
+    bc_peers_free(&g_peers);
 }
 
 /* -------------------------------------------------------------------------
@@ -553,7 +913,13 @@ int main(void)
     RUN(api_build_game_ptrs_non_null);
     RUN(api_build_registry_ptrs_non_null);
     RUN(api_build_shield_ptrs_non_null);
-    RUN(api_build_timer_ptrs_null);
+    RUN(api_build_timer_ptrs_set);
+    RUN(api_timer_fires_on_wheel);
+    RUN(api_job_runs_and_completes_on_poll);
+    RUN(api_frame_memory_from_arena);
+    RUN(api_ships_snapshot_shared_per_tick);
+    RUN(api_packet_hook_filters_and_rewrites);
+    RUN(api_combat_kernels_replaced_at_load_only);
 
     /* Loader lifecycle */
     RUN(loader_zero_modules_succeeds);
@@ -0,0 +1,189 @@
+#include "test_util.h"
+#include "openbc/packet_hook.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for opcode-filtered packet hooks (src/server/packet_hook.c).
+ *
+ * Covers the union mask, priority order, drop short-circuit, in-place
+ * rewrite (including a changed opcode and bad lengths), and adding or
+ * removing hooks from inside a running hook.
+ */
+
+static bc_packet_hooks_t g_h;
+
+static int  g_calls[8];
+static int  g_order[16];
+static int  g_order_n;
+
+static void reset(void)
+{
+    bc_packet_hooks_init(&g_h);
+    memset(g_calls, 0, sizeof(g_calls));
+    g_order_n = 0;
+}
+
+/* user = tag; records the call and passes */
+static int hook_pass(void *user, int slot, u8 *data, int *len)
+{
+    (void)slot; (void)data; (void)len;
+    int tag = (int)(size_t)user;
+    g_calls[tag]++;
+    if (g_order_n < 16) g_order[g_order_n++] = tag;
+    return BC_PACKET_PASS;
+}
+
+static int hook_drop(void *user, int slot, u8 *data, int *len)
+{
+    hook_pass(user, slot, data, len);
+    return BC_PACKET_DROP;
+}
+
+/* Replaces the opcode with 0x2D and trims the last byte */
+static int hook_rewrite(void *user, int slot, u8 *data, int *len)
+{
+    hook_pass(user, slot, data, len);
+    data[0] = 0x2D;
+    (*len)--;
+    return BC_PACKET_REWRITE;
+}
+
+static int hook_grow(void *user, int slot, u8 *data, int *len)
+{
+    hook_pass(user, slot, data, len);
+    (*len)++;
+    return BC_PACKET_REWRITE;
+}
+
+static int g_self_id;
+static int hook_remove_self(void *user, int slot, u8 *data, int *len)
+{
+    hook_pass(user, slot, data, len);
+    bc_packet_hook_remove(&g_h, g_self_id);
+    return BC_PACKET_PASS;
+}
+
+static int hook_add_another(void *user, int slot, u8 *data, int *len)
+{
+    hook_pass(user, slot, data, len);
+    static const u8 op = 0x2C;
+    bc_packet_hook_add(&g_h, &op, 1, 0, hook_pass, (void *)7);
+    return BC_PACKET_PASS;
+}
+
+TEST(mask_tracks_subscriptions)
+{
+    reset();
+    static const u8 ops_a[] = { 0x2C, 0xFF };
+    static const u8 ops_b[] = { 0x00, 0x2C };
+    int a = bc_packet_hook_add(&g_h, ops_a, 2, 0, hook_pass, (void *)1);
+    int b = bc_packet_hook_add(&g_h, ops_b, 2, 0, hook_pass, (void *)2);
+    ASSERT(a > 0 && b > 0 && a != b);
+    ASSERT(bc_packet_hook_wanted(&g_h, 0x2C));
+    ASSERT(bc_packet_hook_wanted(&g_h, 0xFF));
+    ASSERT(bc_packet_hook_wanted(&g_h, 0x00));
+    ASSERT(!bc_packet_hook_wanted(&g_h, 0x2D));
+
+    ASSERT(bc_packet_hook_remove(&g_h, a));
+    ASSERT(!bc_packet_hook_remove(&g_h, a));
+    ASSERT(!bc_packet_hook_wanted(&g_h, 0xFF));
+    ASSERT(bc_packet_hook_wanted(&g_h, 0x2C));   /* still b */
+
+    /* Only hooks subscribed to the opcode run */
+    u8 msg[4] = { 0x00, 1, 2, 3 };
+    int len = 4;
+    ASSERT_EQ_INT(bc_packet_hook_run(&g_h, 1, msg, &len), BC_PACKET_PASS);
+    ASSERT_EQ_INT(g_calls[1], 0);
+    ASSERT_EQ_INT(g_calls[2], 1);
+
+    ASSERT_EQ_INT(bc_packet_hook_add(&g_h, ops_a, 0, 0, hook_pass, NULL), -1);
+    ASSERT_EQ_INT(bc_packet_hook_add(&g_h, ops_a, 1, 0, NULL, NULL), -1);
+}
+
+TEST(priority_order_and_drop)
+{
+    reset();
+    static const u8 op = 0x2C;
+    bc_packet_hook_add(&g_h, &op, 1, 50, hook_pass, (void *)3);
+    bc_packet_hook_add(&g_h, &op, 1, 10, hook_pass, (void *)1);
+    bc_packet_hook_add(&g_h, &op, 1, 50, hook_pass, (void *)4);
+    bc_packet_hook_add(&g_h, &op, 1, 20, hook_pass, (void *)2);
+
+    u8 msg[2] = { 0x2C, 0 };
+    int len = 2;
+    bc_packet_hook_run(&g_h, 1, msg, &len);
+    ASSERT_EQ_INT(g_order_n, 4);
+    for (int i = 0; i < 4; i++) ASSERT_EQ_INT(g_order[i], i + 1);
+
+    /* A drop stops later hooks */
+    bc_packet_hook_add(&g_h, &op, 1, 15, hook_drop, (void *)5);
+    g_order_n = 0;
+    ASSERT_EQ_INT(bc_packet_hook_run(&g_h, 1, msg, &len), BC_PACKET_DROP);
+    ASSERT_EQ_INT(g_order_n, 2);
+    ASSERT_EQ_INT(g_order[1], 5);
+    ASSERT_EQ_INT(g_h.stats.dropped, 1);
+
+    /* Table full */
+    for (int i = g_h.count; i < BC_PACKET_HOOK_MAX; i++)
+        ASSERT(bc_packet_hook_add(&g_h, &op, 1, 0, hook_pass, NULL) > 0);
+    ASSERT_EQ_INT(bc_packet_hook_add(&g_h, &op, 1, 0, hook_pass, NULL), -1);
+}
+
+TEST(rewrite_in_place)
+{
+    reset();
+    static const u8 op_a = 0x2C, op_b = 0x2D;
+    bc_packet_hook_add(&g_h, &op_a, 1, 0, hook_rewrite, (void *)1);
+    bc_packet_hook_add(&g_h, &op_a, 1, 5, hook_pass, (void *)2);   /* skipped */
+    bc_packet_hook_add(&g_h, &op_b, 1, 5, hook_pass, (void *)3);   /* sees it */
+
+    u8 msg[4] = { 0x2C, 9, 9, 9 };
+    int len = 4;
+    ASSERT_EQ_INT(bc_packet_hook_run(&g_h, 1, msg, &len), BC_PACKET_REWRITE);
+    ASSERT_EQ_INT(msg[0], 0x2D);
+    ASSERT_EQ_INT(len, 3);
+    ASSERT_EQ_INT(g_calls[2], 0);
+    ASSERT_EQ_INT(g_calls[3], 1);
+    ASSERT_EQ_INT(g_h.stats.rewritten, 1);
+
+    /* Growing the message is refused as a drop */
+    reset();
+    bc_packet_hook_add(&g_h, &op_a, 1, 0, hook_grow, (void *)1);
+    msg[0] = 0x2C;
+    len = 4;
+    ASSERT_EQ_INT(bc_packet_hook_run(&g_h, 1, msg, &len), BC_PACKET_DROP);
+    ASSERT_EQ_INT(len, 4);
+    ASSERT_EQ_INT(g_h.stats.bad_length, 1);
+}
+
+TEST(add_and_remove_during_run)
+{
+    reset();
+    static const u8 op = 0x2C;
+    g_self_id = bc_packet_hook_add(&g_h, &op, 1, 0, hook_remove_self, (void *)1);
+    bc_packet_hook_add(&g_h, &op, 1, 5, hook_add_another, (void *)2);
+    bc_packet_hook_add(&g_h, &op, 1, 9, hook_pass, (void *)3);
+
+    u8 msg[2] = { 0x2C, 0 };
+    int len = 2;
+    bc_packet_hook_run(&g_h, 1, msg, &len);
+    ASSERT_EQ_INT(g_calls[1], 1);
+    ASSERT_EQ_INT(g_calls[3], 1);     /* later hooks still ran */
+    ASSERT_EQ_INT(g_calls[7], 0);     /* added mid-run: next message */
+    ASSERT_EQ_INT(g_h.count, 3);
+
+    /* The added hook (priority 0) now runs first; the removed one is gone */
+    g_order_n = 0;
+    bc_packet_hook_run(&g_h, 1, msg, &len);
+    ASSERT_EQ_INT(g_calls[1], 1);
+    ASSERT_EQ_INT(g_order[0], 7);
+    ASSERT_EQ_INT(g_order[1], 2);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(mask_tracks_subscriptions);
+    RUN(priority_order_and_drop);
+    RUN(rewrite_in_place);
+    RUN(add_and_remove_during_run);
+TEST_MAIN_END()
@@ -0,0 +1,173 @@
+#include "test_util.h"
+#include "openbc/peer.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the peer table (src/server/network/peer.c): startup
+ * sizing, the ascending active-slot list, and the address -> slot index
+ * (including hash collisions and backward-shift deletion).
+ */
+
+static bc_peer_mgr_t g_mgr;
+
+static bc_addr_t mkaddr(u32 ip, u16 port)
+{
+    bc_addr_t a;
+    memset(&a, 0, sizeof(a));
+    a.ip = ip;
+    a.port = port;
+    return a;
+}
+
+/* active[] must be strictly ascending and list exactly the non-empty slots. */
+static bool active_consistent(const bc_peer_mgr_t *m)
+{
+    int n = 0;
+    for (int i = 0; i < m->capacity; i++)
+        if (m->peers[i].state != PEER_EMPTY) n++;
+    if (n != m->active_count || n != m->count) return false;
+    for (int k = 0; k < m->active_count; k++) {
+        if (m->peers[m->active[k]].state == PEER_EMPTY) return false;
+        if (k > 0 && m->active[k] <= m->active[k - 1]) return false;
+    }
+    return true;
+}
+
+TEST(init_sizes_and_clamps)
+{
+    ASSERT(bc_peers_init(&g_mgr, BC_STOCK_PEER_SLOTS));
+    ASSERT_EQ_INT(BC_STOCK_PEER_SLOTS, g_mgr.capacity);
+    ASSERT_EQ_INT(0, g_mgr.count);
+    ASSERT_EQ_INT(0, g_mgr.active_count);
+    ASSERT_EQ_INT(-1, g_mgr.peers[3].object_id);
+
+    ASSERT(bc_peers_init(&g_mgr, BC_MAX_PLAYERS + 100));
+    ASSERT_EQ_INT(BC_MAX_PLAYERS, g_mgr.capacity);
+    ASSERT(bc_peers_init(&g_mgr, 0));
+    ASSERT_EQ_INT(1, g_mgr.capacity);
+
+    bc_peers_free(&g_mgr);
+    ASSERT(g_mgr.peers == NULL);
+    ASSERT_EQ_INT(0, g_mgr.capacity);
+    bc_addr_t a = mkaddr(1, 1);
+    ASSERT_EQ_INT(-1, bc_peers_find(&g_mgr, &a));
+}
+
+TEST(dedicated_slot_not_addressable)
+{
+    ASSERT(bc_peers_init(&g_mgr, BC_STOCK_PEER_SLOTS));
+    bc_peers_reserve_dedicated(&g_mgr, "Dedicated Server");
+    ASSERT_EQ_INT(PEER_LOBBY, g_mgr.peers[0].state);
+    ASSERT(strcmp(g_mgr.peers[0].name, "Dedicated Server") == 0);
+    ASSERT_EQ_INT(1, g_mgr.count);
+    ASSERT_EQ_INT(1, g_mgr.active_count);
+
+    /* Slot 0 has a zero address but must never match a lookup */
+    bc_addr_t zero = mkaddr(0, 0);
+    ASSERT_EQ_INT(-1, bc_peers_find(&g_mgr, &zero));
+
+    bc_addr_t a = mkaddr(0x0100007F, 22101);
+    ASSERT_EQ_INT(1, bc_peers_add(&g_mgr, &a));
+    ASSERT_EQ_INT(1, bc_peers_find(&g_mgr, &a));
+    bc_peers_free(&g_mgr);
+}
+
+TEST(add_find_remove_full_table)
+{
+    ASSERT(bc_peers_init(&g_mgr, BC_MAX_PLAYERS));
+    bc_peers_reserve_dedicated(&g_mgr, "Dedicated Server");
+
+    /* Same IP, consecutive ports: worst case for a weak hash */
+    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+        bc_addr_t a = mkaddr(0x0A000001, (u16)(30000 + i));
+        ASSERT_EQ_INT(i, bc_peers_add(&g_mgr, &a));
+    }
+    bc_addr_t extra = mkaddr(0x0A000002, 1);
+    ASSERT_EQ_INT(-1, bc_peers_add(&g_mgr, &extra));
+    ASSERT(active_consistent(&g_mgr));
+
+    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+        bc_addr_t a = mkaddr(0x0A000001, (u16)(30000 + i));
+        ASSERT_EQ_INT(i, bc_peers_find(&g_mgr, &a));
+    }
+
+    /* Remove every third peer; the rest must stay reachable */
+    for (int i = 1; i < BC_MAX_PLAYERS; i += 3)
+        bc_peers_remove(&g_mgr, i);
+    ASSERT(active_consistent(&g_mgr));
+    for (int i = 1; i < BC_MAX_PLAYERS; i++) {
+        bc_addr_t a = mkaddr(0x0A000001, (u16)(30000 + i));
+        int expect = ((i - 1) % 3 == 0) ? -1 : i;
+        ASSERT_EQ_INT(expect, bc_peers_find(&g_mgr, &a));
+    }
+
+    /* Freed slots are reused lowest-first */
+    bc_addr_t b = mkaddr(0x0B000001, 5);
+    ASSERT_EQ_INT(1, bc_peers_add(&g_mgr, &b));
+    ASSERT_EQ_INT(1, bc_peers_find(&g_mgr, &b));
+    ASSERT(active_consistent(&g_mgr));
+    bc_peers_free(&g_mgr);
+}
+
+TEST(index_matches_linear_scan_under_churn)
+{
+    ASSERT(bc_peers_init(&g_mgr, BC_MAX_PLAYERS));
+    u32 seed = 12345u;
+    for (int step = 0; step < 4000; step++) {
+        seed = seed * 1103515245u + 12345u;
+        bc_addr_t a = mkaddr(0xC0A80000u | ((seed >> 16) & 0x3F),
+                             (u16)(22100 + ((seed >> 8) & 0x3)));
+        int slot = bc_peers_find(&g_mgr, &a);
+
+        int linear = -1;
+        for (int i = 0; i < g_mgr.capacity; i++) {
+            if (g_mgr.peers[i].state != PEER_EMPTY &&
+                bc_addr_equal(&g_mgr.peers[i].addr, &a)) {
+                linear = i;
+                break;
+            }
+        }
+        ASSERT_EQ_INT(linear, slot);
+
+        if (slot >= 0) bc_peers_remove(&g_mgr, slot);
+        else bc_peers_add(&g_mgr, &a);
+    }
+    ASSERT(active_consistent(&g_mgr));
+    bc_peers_free(&g_mgr);
+}
+
+TEST(timeout_removes_only_stale)
+{
+    ASSERT(bc_peers_init(&g_mgr, BC_STOCK_PEER_SLOTS));
+    for (int i = 0; i < 4; i++) {
+        bc_addr_t a = mkaddr(0x01020304, (u16)(1000 + i));
+        int s = bc_peers_add(&g_mgr, &a);
+        g_mgr.peers[s].last_recv_time = (i % 2) ? 9000 : 1000;
+    }
+    ASSERT_EQ_INT(2, bc_peers_timeout(&g_mgr, 10000, 5000));
+    ASSERT_EQ_INT(2, g_mgr.count);
+    ASSERT_EQ_INT(1, g_mgr.active[0]);
+    ASSERT_EQ_INT(3, g_mgr.active[1]);
+    ASSERT(active_consistent(&g_mgr));
+    bc_peers_free(&g_mgr);
+
+    /* The dedicated slot never hears anything, yet stays */
+    ASSERT(bc_peers_init(&g_mgr, BC_STOCK_PEER_SLOTS));
+    bc_peers_reserve_dedicated(&g_mgr, "Dedicated Server");
+    bc_addr_t a = mkaddr(0x01020304, 1000);
+    ASSERT_EQ_INT(1, bc_peers_add(&g_mgr, &a));
+    ASSERT_EQ_INT(1, bc_peers_timeout(&g_mgr, 10000, 5000));
+    ASSERT_EQ_INT(PEER_LOBBY, g_mgr.peers[0].state);
+    ASSERT_EQ_INT(1, g_mgr.count);
+    ASSERT(active_consistent(&g_mgr));
+    bc_peers_free(&g_mgr);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(init_sizes_and_clamps);
+    RUN(dedicated_slot_not_addressable);
+    RUN(add_find_remove_full_table);
+    RUN(index_matches_linear_scan_under_churn);
+    RUN(timeout_removes_only_stale);
+TEST_MAIN_END()
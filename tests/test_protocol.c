@@ -429,6 +429,106 @@ TEST(cf16_buffer_round_trip)
     ASSERT(fabsf(v - 120.5f) < 0.5f);
 }
 
+/* The original threshold-walk codec, kept verbatim as the reference the
+ * table decode and compare-count encode must match bit for bit. */
+static u16 cf16_encode_ref(f32 value)
+{
+    u32 sign_flag = 0;
+    if (value < 0.0f) {
+        sign_flag = 8;
+        value = -value;
+    }
+    u32 scale = 0;
+    f32 lo = 0.0f;
+    f32 hi = 0.001f;
+    while (scale < 8) {
+        if (value < hi) break;
+        lo = hi;
+        hi *= 10.0f;
+        scale++;
+    }
+    if (scale >= 8)
+        return (u16)((sign_flag | 7) * 0x1000 + 0xFFF);
+    f32 range = hi - lo;
+    i32 mantissa = (range > 0.0f) ? (i32)((value - lo) / range * 4095.0f) : 0;
+    if (mantissa > 0xFFF) mantissa = 0xFFF;
+    if (mantissa < 0) mantissa = 0;
+    return (u16)((sign_flag | scale) * 0x1000 + mantissa);
+}
+
+static f32 cf16_decode_ref(u16 encoded)
+{
+    u16 mantissa = encoded & 0xFFF;
+    u8 raw_scale = (u8)(encoded >> 12);
+    bool is_neg = (raw_scale >> 3) & 1;
+    u8 scale = raw_scale & 0x7;
+    f32 range_lo = 0.0f;
+    f32 range_hi = 0.001f;
+    for (u8 i = 0; i < scale; i++) {
+        range_lo = range_hi;
+        range_hi *= 10.0f;
+    }
+    f32 result = range_lo + ((f32)mantissa / 4095.0f) * (range_hi - range_lo);
+    return is_neg ? -result : result;
+}
+
+static bool same_bits(f32 a, f32 b)
+{
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+TEST(cf16_decode_exact_full_domain)
+{
+    static f32 batch[0x10000];
+    static u16 codes[0x10000];
+    for (u32 e = 0; e < 0x10000; e++) codes[e] = (u16)e;
+    bc_cf16_decode_many(codes, batch, 0x10000);
+    for (u32 e = 0; e < 0x10000; e++) {
+        f32 ref = cf16_decode_ref((u16)e);
+        ASSERT(same_bits(bc_cf16_decode((u16)e), ref));
+        ASSERT(same_bits(batch[e], ref));
+    }
+}
+
+TEST(cf16_encode_exact)
+{
+    /* Every decodable value, its float neighbours (the rounding edges) and
+     * the decade bounds, in both signs */
+    for (u32 e = 0; e < 0x8000; e++) {
+        f32 v = cf16_decode_ref((u16)e);
+        f32 probes[4] = { v, nextafterf(v, 0.0f), nextafterf(v, 1e30f),
+                          (v + cf16_decode_ref((u16)(e + 1))) * 0.5f };
+        for (int k = 0; k < 4; k++) {
+            ASSERT_EQ(bc_cf16_encode(probes[k]), cf16_encode_ref(probes[k]));
+            ASSERT_EQ(bc_cf16_encode(-probes[k]), cf16_encode_ref(-probes[k]));
+        }
+    }
+
+    /* Off the ends and the non-finite values */
+    static const f32 edge[] = { 0.0f, -0.0f, 9999.0f, 10000.0f, 10000.002f,
+                                1e9f, 1e-30f, 1e-45f };
+    for (size_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++)
+        ASSERT_EQ(bc_cf16_encode(edge[i]), cf16_encode_ref(edge[i]));
+    ASSERT_EQ(bc_cf16_encode(INFINITY), cf16_encode_ref(INFINITY));
+    ASSERT_EQ(bc_cf16_encode(-INFINITY), cf16_encode_ref(-INFINITY));
+    ASSERT_EQ(bc_cf16_encode(NAN), cf16_encode_ref(NAN));
+
+    /* Pseudo-random floats across the whole range */
+    u32 x = 12345u;
+    f32 vals[1024];
+    u16 batch[1024];
+    for (int i = 0; i < 1024; i++) {
+        x = x * 1664525u + 1013904223u;
+        u32 bits = (x & 0x807FFFFFu) | ((100u + (x >> 23) % 45u) << 23);
+        memcpy(&vals[i], &bits, sizeof(bits));
+    }
+    bc_cf16_encode_many(vals, batch, 1024);
+    for (int i = 0; i < 1024; i++) {
+        ASSERT_EQ(batch[i], cf16_encode_ref(vals[i]));
+        ASSERT_EQ(bc_cf16_encode(vals[i]), cf16_encode_ref(vals[i]));
+    }
+}
+
 /* === CompressedVector3 tests === */
 
 TEST(cv3_unit_x)
@@ -537,6 +637,114 @@ TEST(cv4_zero)
     ASSERT(fabsf(z) < 0.01f);
 }
 
+TEST(cv4_batch_matches_single)
+{
+    static const f32 xyz[4 * 3] = {
+        10.0f, -20.0f, 30.0f,   0.0f, 0.0f, 0.0f,
+        -0.5f, 0.25f, 0.0f,     1500.0f, 2.0f, -800.0f,
+    };
+    u8 one[20], many[20];
+    bc_buffer_t a, b;
+    bc_buf_init(&a, one, sizeof(one));
+    bc_buf_init(&b, many, sizeof(many));
+    for (int i = 0; i < 4; i++)
+        ASSERT(bc_buf_write_cv4(&a, xyz[i * 3], xyz[i * 3 + 1], xyz[i * 3 + 2]));
+    ASSERT(bc_buf_write_cv4_many(&b, xyz, 4));
+    ASSERT_EQ_INT((int)b.pos, 20);
+    ASSERT(memcmp(one, many, sizeof(one)) == 0);
+
+    /* Short buffer: nothing written */
+    ASSERT(!bc_buf_write_cv4_many(&b, xyz, 1));
+    ASSERT_EQ_INT((int)b.pos, 20);
+
+    f32 got[4 * 3];
+    bc_buf_reset(&a);
+    bc_buf_reset(&b);
+    ASSERT(bc_buf_read_cv4_many(&b, got, 4));
+    for (int i = 0; i < 4; i++) {
+        f32 x, y, z;
+        ASSERT(bc_buf_read_cv4(&a, &x, &y, &z));
+        ASSERT(same_bits(got[i * 3], x));
+        ASSERT(same_bits(got[i * 3 + 1], y));
+        ASSERT(same_bits(got[i * 3 + 2], z));
+    }
+    ASSERT(!bc_buf_read_cv4_many(&b, got, 1));
+}
+
+/* Reserved puts write the same bytes as the checked writes */
+TEST(put_matches_checked_write)
+{
+    u8 checked[64], put[64];
+    u32 x = 0x5EED1234u;
+    for (int round = 0; round < 2000; round++) {
+        memset(checked, 0xAA, sizeof(checked));
+        memset(put, 0xAA, sizeof(put));
+        bc_buffer_t a, b;
+        bc_buf_init(&a, checked, sizeof(checked));
+        bc_buf_init(&b, put, sizeof(put));
+        ASSERT(bc_buf_reserve(&b, sizeof(put)));
+
+        while (a.pos + 5 <= sizeof(checked)) {
+            x = x * 1664525u + 1013904223u;
+            u32 v = x;
+            x = x * 1664525u + 1013904223u;
+            f32 f = ((f32)(i32)x / 2147483648.0f) * 2000.0f;
+            switch ((v >> 29) & 7) {
+            case 0:
+                ASSERT(bc_buf_write_u8(&a, (u8)v));
+                bc_buf_put_u8(&b, (u8)v);
+                break;
+            case 1:
+                ASSERT(bc_buf_write_u16(&a, (u16)v));
+                bc_buf_put_u16(&b, (u16)v);
+                break;
+            case 2:
+                ASSERT(bc_buf_write_i32(&a, (i32)v));
+                bc_buf_put_i32(&b, (i32)v);
+                break;
+            case 3:
+                ASSERT(bc_buf_write_f32(&a, f));
+                bc_buf_put_f32(&b, f);
+                break;
+            case 4:
+                ASSERT(bc_buf_write_cf16(&a, f));
+                bc_buf_put_cf16(&b, f);
+                break;
+            case 5:
+                ASSERT(bc_buf_write_cv3(&a, f, (f32)(i8)v, -f * 0.5f));
+                bc_buf_put_cv3(&b, f, (f32)(i8)v, -f * 0.5f);
+                break;
+            case 6:
+                ASSERT(bc_buf_write_cv4(&a, (f32)(i8)v, f, 3.0f));
+                bc_buf_put_cv4(&b, (f32)(i8)v, f, 3.0f);
+                break;
+            default:
+                ASSERT(bc_buf_write_bytes(&a, (const u8 *)&v, 3));
+                bc_buf_put_bytes(&b, (const u8 *)&v, 3);
+                break;
+            }
+            ASSERT_EQ_INT((int)a.pos, (int)b.pos);
+        }
+        ASSERT(memcmp(checked, put, sizeof(put)) == 0);
+    }
+}
+
+TEST(reserve_bounds)
+{
+    u8 data[8];
+    bc_buffer_t b;
+    bc_buf_init(&b, data, sizeof(data));
+    ASSERT(bc_buf_reserve(&b, 8));
+    ASSERT(!bc_buf_reserve(&b, 9));
+    b.pos = 5;
+    ASSERT(bc_buf_reserve(&b, 3));
+    ASSERT(!bc_buf_reserve(&b, 4));
+    ASSERT(!bc_buf_reserve(&b, (size_t)-1));
+    b.pos = 8;
+    ASSERT(bc_buf_reserve(&b, 0));
+    ASSERT(!bc_buf_reserve(&b, 1));
+}
+
 /* === Handshake / Checksum request tests === */
 
 TEST(checksum_request_round0)
@@ -848,9 +1056,9 @@ TEST(checksum_resp_validate_ok)
     bc_manifest_dir_t dir;
     memset(&dir, 0, sizeof(dir));
     dir.dir_name_hash = 0x4DAFCB2F;
+    bc_manifest_file_t file = { 0x373EB677, 0xF8A0A740 };
     dir.file_count = 1;
-    dir.files[0].name_hash = 0x373EB677;
-    dir.files[0].content_hash = 0xF8A0A740;
+    dir.files = &file;
 
     u8 buf[256];
     int len = build_round0_response(buf, sizeof(buf),
@@ -865,9 +1073,9 @@ TEST(checksum_resp_validate_content_mismatch)
     bc_manifest_dir_t dir;
     memset(&dir, 0, sizeof(dir));
     dir.dir_name_hash = 0x4DAFCB2F;
+    bc_manifest_file_t file = { 0x373EB677, 0xF8A0A740 };
     dir.file_count = 1;
-    dir.files[0].name_hash = 0x373EB677;
-    dir.files[0].content_hash = 0xF8A0A740;
+    dir.files = &file;
 
     /* Send wrong content hash */
     u8 buf[256];
@@ -883,9 +1091,9 @@ TEST(checksum_resp_validate_dir_mismatch)
     bc_manifest_dir_t dir;
     memset(&dir, 0, sizeof(dir));
     dir.dir_name_hash = 0x4DAFCB2F;
+    bc_manifest_file_t file = { 0x373EB677, 0xF8A0A740 };
     dir.file_count = 1;
-    dir.files[0].name_hash = 0x373EB677;
-    dir.files[0].content_hash = 0xF8A0A740;
+    dir.files = &file;
 
     /* Send wrong dir hash */
     u8 buf[256];
@@ -901,9 +1109,9 @@ TEST(checksum_resp_validate_file_missing)
     bc_manifest_dir_t dir;
     memset(&dir, 0, sizeof(dir));
     dir.dir_name_hash = 0x4DAFCB2F;
+    bc_manifest_file_t file = { 0x373EB677, 0xF8A0A740 };
     dir.file_count = 1;
-    dir.files[0].name_hash = 0x373EB677;
-    dir.files[0].content_hash = 0xF8A0A740;
+    dir.files = &file;
 
     /* Send response with no files */
     u8 buf[256];
@@ -921,6 +1129,70 @@ TEST(checksum_resp_validate_file_missing)
     ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_FILE_MISSING);
 }
 
+TEST(checksum_resp_validate_large_dir)
+{
+    /* Full-size round: 256 files plus a 128-file subdir, reported out of
+     * order. Manifest arrays are sorted by name_hash. */
+    static bc_manifest_file_t files[BC_CHECKSUM_MAX_RESP_FILES + 1];
+    static bc_manifest_file_t sub_files[BC_CHECKSUM_MAX_SUB_FILES];
+    for (int i = 0; i < BC_CHECKSUM_MAX_RESP_FILES + 1; i++) {
+        files[i].name_hash = 0x1000u + (u32)i * 7u;
+        files[i].content_hash = 0xC0000000u + (u32)i;
+    }
+    for (int i = 0; i < BC_CHECKSUM_MAX_SUB_FILES; i++) {
+        sub_files[i].name_hash = 0x9000u + (u32)i;
+        sub_files[i].content_hash = 0xD0000000u + (u32)i;
+    }
+    bc_manifest_subdir_t sub = { 0xCAAFFDD4, sub_files, BC_CHECKSUM_MAX_SUB_FILES };
+
+    bc_manifest_dir_t dir;
+    memset(&dir, 0, sizeof(dir));
+    dir.dir_name_hash = 0xB831D315;
+    dir.files = files;
+    dir.file_count = BC_CHECKSUM_MAX_RESP_FILES;
+    dir.subdirs = &sub;
+    dir.subdir_count = 1;
+
+    static bc_checksum_resp_t resp;
+    memset(&resp, 0, sizeof(resp));
+    resp.dir_hash = 0xB831D315;
+    resp.file_count = BC_CHECKSUM_MAX_RESP_FILES;
+    for (int i = 0; i < resp.file_count; i++) {
+        int k = resp.file_count - 1 - i;
+        resp.files[i].name_hash = files[k].name_hash;
+        resp.files[i].content_hash = files[k].content_hash;
+    }
+    resp.subdir_count = 1;
+    resp.subdirs[0].name_hash = 0xCAAFFDD4;
+    resp.subdirs[0].data.file_count = BC_CHECKSUM_MAX_SUB_FILES;
+    for (int i = 0; i < BC_CHECKSUM_MAX_SUB_FILES; i++) {
+        resp.subdirs[0].data.files[i].name_hash = sub_files[(i * 5) % 128].name_hash;
+        resp.subdirs[0].data.files[i].content_hash = sub_files[(i * 5) % 128].content_hash;
+    }
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_OK);
+
+    /* A repeated report does not stand in for a missing file */
+    resp.files[3] = resp.files[4];
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_FILE_MISSING);
+    resp.files[3].name_hash = files[resp.file_count - 4].name_hash;
+    resp.files[3].content_hash = 0;
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_FILE_MISMATCH);
+    resp.files[3].content_hash = files[resp.file_count - 4].content_hash;
+
+    /* Subdir: bad content, then absent */
+    resp.subdirs[0].data.files[10].content_hash ^= 1;
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_FILE_MISMATCH);
+    resp.subdirs[0].data.files[10].content_hash ^= 1;
+    resp.subdirs[0].name_hash = 0x12345678;
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_FILE_MISSING);
+    resp.subdirs[0].name_hash = 0xCAAFFDD4;
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_OK);
+
+    /* More manifest files than a response can carry */
+    dir.file_count = BC_CHECKSUM_MAX_RESP_FILES + 1;
+    ASSERT_EQ_INT(bc_checksum_response_validate(&resp, &dir), CHECKSUM_FILE_MISSING);
+}
+
 TEST(checksum_resp_parse_depth_limit)
 {
     /* Build a crafted payload with 18 nesting levels (beyond BC_MAX_TREE_DEPTH=16).
@@ -1722,6 +1994,8 @@ TEST_MAIN_BEGIN()
     RUN(cf16_negative);
     RUN(cf16_sign_bit);
     RUN(cf16_buffer_round_trip);
+    RUN(cf16_decode_exact_full_domain);
+    RUN(cf16_encode_exact);
 
     /* CompressedVector3 */
     RUN(cv3_unit_x);
@@ -1732,6 +2006,9 @@ TEST_MAIN_BEGIN()
     RUN(cv4_simple);
     RUN(cv4_diagonal);
     RUN(cv4_zero);
+    RUN(cv4_batch_matches_single);
+    RUN(put_matches_checked_write);
+    RUN(reserve_bounds);
 
     /* Handshake: Checksum requests */
     RUN(checksum_request_round0);
@@ -1758,6 +2035,7 @@ TEST_MAIN_BEGIN()
     RUN(checksum_resp_validate_content_mismatch);
     RUN(checksum_resp_validate_dir_mismatch);
     RUN(checksum_resp_validate_file_missing);
+    RUN(checksum_resp_validate_large_dir);
     RUN(checksum_resp_parse_depth_limit);
 
     /* Fragment reassembly -- error paths */
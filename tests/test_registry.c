@@ -5,6 +5,7 @@
 #include "openbc/combat.h"
 #include "openbc/game_builders.h"
 #include "openbc/opcodes.h"
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
 
@@ -126,6 +127,64 @@ TEST(load_registry_power_modes)
     ASSERT_EQ(bop->ser_list.entries[cloak].power_mode, BC_POWER_MODE_BACKUP_ONLY);
 }
 
+TEST(load_monolith_any_key_order)
+{
+    /* Serialization list ahead of the subsystems it names */
+    static const char text[] =
+        "{\"projectiles\": [{\"name\": \"Probe Torpedo\", \"net_type_id\": 9}],\n"
+        " \"ships\": [{\n"
+        "   \"serialization_list\": [\n"
+        "     {\"name\": \"Hull\", \"format\": \"base\"},\n"
+        "     {\"name\": \"Phasers\", \"format\": \"powered\", \"power_mode\": 1,\n"
+        "      \"children\": [{\"name\": \"Phaser 1\"}, {\"name\": \"Spare\", \"max_condition\": 40}]}],\n"
+        "   \"name\": \"Probe\", \"species_id\": 77, \"power_output\": 500,\n"
+        "   \"shield_hp\": [1, 2, 3, 4, 5, 6, 7],\n"
+        "   \"subsystems\": [\n"
+        "     {\"name\": \"Hull\", \"type\": \"hull\", \"max_condition\": 900},\n"
+        "     {\"name\": \"Phaser 1\", \"type\": \"phaser\", \"max_condition\": 300,\n"
+        "      \"position\": [0, 3, 4]}]}]}\n";
+    const char *path = "build/tests/test_registry_monolith.json";
+    FILE *f = fopen(path, "wb");
+    ASSERT(f != NULL);
+    fputs(text, f);
+    fclose(f);
+
+    static bc_game_registry_t reg;
+    ASSERT(bc_registry_load(&reg, path));
+    ASSERT_EQ_INT(reg.ship_count, 1);
+    ASSERT_EQ_INT(reg.projectile_count, 1);
+    ASSERT_EQ_INT(reg.projectiles[0].net_type_id, 9);
+
+    const bc_ship_class_t *cls = &reg.ships[0];
+    ASSERT_EQ_INT(cls->species_id, 77);
+    ASSERT(cls->power_output == 500.0f);
+    ASSERT(cls->shield_hp[5] == 6.0f);
+    ASSERT_EQ_INT(cls->subsystem_count, 2);
+    ASSERT(cls->bounding_extent == 5.0f);
+
+    const bc_ss_list_t *sl = &cls->ser_list;
+    ASSERT_EQ_INT(sl->count, 2);
+    ASSERT_EQ_INT(sl->entries[0].hp_index, 0);
+    ASSERT(sl->entries[0].max_condition == 900.0f);
+    ASSERT_EQ_INT(sl->entries[1].hp_index, 2);          /* container slot */
+    ASSERT_EQ(sl->entries[1].power_mode, BC_POWER_MODE_BACKUP_FIRST);
+    ASSERT_EQ_INT(sl->entries[1].child_count, 2);
+    ASSERT_EQ_INT(sl->entries[1].child_hp_index[0], 1);
+    ASSERT_EQ_INT(cls->subsystems[1].parent_idx, 2);
+    ASSERT_EQ_INT(sl->entries[1].child_hp_index[1], 3);  /* unmatched child */
+    ASSERT(sl->entries[1].child_max_condition[1] == 40.0f);
+    ASSERT_EQ_INT(sl->total_hp_slots, 4);
+
+    /* Malformed file: nothing loaded */
+    f = fopen(path, "wb");
+    ASSERT(f != NULL);
+    fputs("{\"ships\": [{\"name\": \"Probe\",}]}", f);
+    fclose(f);
+    ASSERT(!bc_registry_load(&reg, path));
+    ASSERT_EQ_INT(reg.ship_count, 0);
+    remove(path);
+}
+
 /* === Ship lookups === */
 
 TEST(galaxy_stats)
@@ -984,6 +1043,7 @@ TEST_MAIN_BEGIN()
     RUN(load_registry);
     RUN(load_registry_power);
     RUN(load_registry_power_modes);
+    RUN(load_monolith_any_key_order);
     RUN(galaxy_stats);
     RUN(shuttle_stats);
     RUN(bop_cloak);
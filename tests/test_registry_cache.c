@@ -0,0 +1,253 @@
+#include "test_util.h"
+#include "openbc/registry_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <time.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#define make_dir(p) _mkdir(p)
+#define set_times(p, t) _utime((p), (t))
+typedef struct _utimbuf utimbuf_t;
+#else
+#include <sys/stat.h>
+#include <utime.h>
+#define make_dir(p) mkdir((p), 0755)
+#define set_times(p, t) utime((p), (t))
+typedef struct utimbuf utimbuf_t;
+#endif
+
+/*
+ * Unit tests for the compiled registry cache (src/shared/game/registry_cache.c).
+ *
+ * Covers a round trip that matches the JSON load byte for byte, every
+ * rejection path (missing, foreign header, stale key, corrupt payload,
+ * truncation), the load-through path writing then hitting the cache,
+ * source-hash sensitivity to file edits and to optional files appearing,
+ * and the metadata check: untouched sources hit without hashing, a touched
+ * but identical file rehashes to a hit, an edit is stale, and a file
+ * written within the racy second never counts as unchanged.
+ */
+
+#define REGISTRY_DIR  "data/vanilla-1.1"
+#define CACHE_PATH    "build/tests/test_registry.cache"
+#define FIXTURE_DIR   "build/tests/regcache_fixture"
+#define META_DIR      "build/tests/regcache_meta"
+#define META_CACHE    "build/tests/regcache_meta.cache"
+
+static bc_game_registry_t g_json;
+static bc_game_registry_t g_reg;
+
+static bool write_text(const char *path, const char *text)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    fputs(text, f);
+    fclose(f);
+    return true;
+}
+
+/* Flip one byte of the cache file at offset. */
+static void poke_byte(const char *path, long offset)
+{
+    FILE *f = fopen(path, "r+b");
+    if (!f) return;
+    fseek(f, offset, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, offset, SEEK_SET);
+    fputc(c ^ 0x5A, f);
+    fclose(f);
+}
+
+TEST(round_trip_matches_json)
+{
+    ASSERT(bc_registry_load_dir(&g_json, REGISTRY_DIR));
+    u64 h = 0;
+    ASSERT(bc_registry_source_hash(REGISTRY_DIR, &h));
+
+    remove(CACHE_PATH);
+    ASSERT(bc_registry_cache_write(CACHE_PATH, &g_json, h));
+    ASSERT_EQ_INT(bc_registry_cache_read(CACHE_PATH, h, &g_reg), BC_REGCACHE_HIT);
+    ASSERT(memcmp(&g_reg, &g_json, sizeof(g_reg)) == 0);
+    ASSERT(bc_registry_find_ship(&g_reg, 3) != NULL);
+}
+
+TEST(rejects_mismatches)
+{
+    u64 h = 0;
+    ASSERT(bc_registry_source_hash(REGISTRY_DIR, &h));
+    ASSERT(bc_registry_cache_write(CACHE_PATH, &g_json, h));
+
+    ASSERT_EQ_INT(bc_registry_cache_read(CACHE_PATH, h + 1, &g_reg), BC_REGCACHE_STALE);
+    ASSERT_EQ_INT(g_reg.ship_count, 0);   /* left zeroed */
+    ASSERT_EQ_INT(bc_registry_cache_read("build/tests/no_such.cache", h, &g_reg),
+                  BC_REGCACHE_MISSING);
+
+    /* Payload bit flip */
+    poke_byte(CACHE_PATH, (long)sizeof(bc_regcache_header_t) + 100);
+    ASSERT_EQ_INT(bc_registry_cache_read(CACHE_PATH, h, &g_reg), BC_REGCACHE_CORRUPT);
+
+    /* Version field */
+    ASSERT(bc_registry_cache_write(CACHE_PATH, &g_json, h));
+    poke_byte(CACHE_PATH, 4);
+    ASSERT_EQ_INT(bc_registry_cache_read(CACHE_PATH, h, &g_reg), BC_REGCACHE_BAD_HEADER);
+
+    /* Truncated payload */
+    ASSERT(bc_registry_cache_write(CACHE_PATH, &g_json, h));
+    {
+        FILE *f = fopen(CACHE_PATH, "rb");
+        ASSERT(f != NULL);
+        size_t half = sizeof(bc_regcache_header_t) + sizeof(g_json) / 2;
+        u8 *buf = (u8 *)malloc(half);
+        ASSERT(fread(buf, 1, half, f) == half);
+        fclose(f);
+        f = fopen(CACHE_PATH, "wb");
+        fwrite(buf, 1, half, f);
+        fclose(f);
+        free(buf);
+    }
+    ASSERT_EQ_INT(bc_registry_cache_read(CACHE_PATH, h, &g_reg), BC_REGCACHE_CORRUPT);
+
+    /* Checksum fine but contents impossible */
+    static bc_game_registry_t bad;
+    bad = g_json;
+    bad.ship_count = BC_MAX_SHIPS + 1;
+    ASSERT(bc_registry_cache_write(CACHE_PATH, &bad, h));
+    ASSERT_EQ_INT(bc_registry_cache_read(CACHE_PATH, h, &g_reg), BC_REGCACHE_CORRUPT);
+}
+
+TEST(load_through_writes_then_hits)
+{
+    bc_regcache_result_t r = BC_REGCACHE_HIT;
+    remove(CACHE_PATH);
+    ASSERT(bc_registry_load_dir_cached(&g_reg, REGISTRY_DIR, CACHE_PATH, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_MISSING);
+    ASSERT(memcmp(&g_reg, &g_json, sizeof(g_reg)) == 0);
+
+    ASSERT(bc_registry_load_dir_cached(&g_reg, REGISTRY_DIR, CACHE_PATH, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_HIT);
+    ASSERT(memcmp(&g_reg, &g_json, sizeof(g_reg)) == 0);
+
+    /* A stale cache is replaced */
+    ASSERT(bc_registry_cache_write(CACHE_PATH, &g_json, 1234));
+    ASSERT(bc_registry_load_dir_cached(&g_reg, REGISTRY_DIR, CACHE_PATH, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_STALE);
+    ASSERT(bc_registry_load_dir_cached(&g_reg, REGISTRY_DIR, CACHE_PATH, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_HIT);
+
+    /* No cache path: plain JSON */
+    ASSERT(bc_registry_load_dir_cached(&g_reg, REGISTRY_DIR, NULL, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_MISSING);
+    ASSERT(!bc_registry_load_dir_cached(&g_reg, "build/tests/no_such_dir",
+                                        CACHE_PATH, &r));
+    remove(CACHE_PATH);
+}
+
+TEST(source_hash_tracks_files)
+{
+    make_dir(FIXTURE_DIR);
+    make_dir(FIXTURE_DIR "/ships");
+    make_dir(FIXTURE_DIR "/ships/probe");
+    remove(FIXTURE_DIR "/ships/probe/power.json");
+    ASSERT(write_text(FIXTURE_DIR "/manifest.json",
+                      "{\"ships\": [\"probe\"], \"projectiles\": []}"));
+    ASSERT(write_text(FIXTURE_DIR "/ships/probe/ship.json",
+                      "{\"name\": \"Probe\", \"species_id\": 1, \"hull_hp\": 100}"));
+
+    u64 a = 0, b = 0, c = 0, d = 0;
+    ASSERT(bc_registry_source_hash(FIXTURE_DIR, &a));
+    ASSERT(bc_registry_source_hash(FIXTURE_DIR, &b));
+    ASSERT(a == b);
+
+    ASSERT(write_text(FIXTURE_DIR "/ships/probe/ship.json",
+                      "{\"name\": \"Probe\", \"species_id\": 1, \"hull_hp\": 101}"));
+    ASSERT(bc_registry_source_hash(FIXTURE_DIR, &c));
+    ASSERT(c != a);
+
+    /* An optional file appearing changes the key too */
+    ASSERT(write_text(FIXTURE_DIR "/ships/probe/power.json", "{}"));
+    ASSERT(bc_registry_source_hash(FIXTURE_DIR, &d));
+    ASSERT(d != c);
+
+    ASSERT(!bc_registry_source_hash("build/tests/no_such_dir", &d));
+}
+
+/* Move a file's mtime a minute into the past (clear of the racy second) */
+static void backdate(const char *path)
+{
+    utimbuf_t t;
+    t.actime = t.modtime = time(NULL) - 60;
+    set_times(path, &t);
+}
+
+static bool write_meta_ship(int hull)
+{
+    char text[128];
+    snprintf(text, sizeof(text),
+             "{\"name\": \"Probe\", \"species_id\": 1, \"hull_hp\": %d}", hull);
+    if (!write_text(META_DIR "/ships/probe/ship.json", text)) return false;
+    backdate(META_DIR "/ships/probe/ship.json");
+    return true;
+}
+
+TEST(metadata_check_skips_hashing)
+{
+    make_dir(META_DIR);
+    make_dir(META_DIR "/ships");
+    make_dir(META_DIR "/ships/probe");
+    ASSERT(write_text(META_DIR "/manifest.json",
+                      "{\"ships\": [\"probe\"], \"projectiles\": []}"));
+    backdate(META_DIR "/manifest.json");
+    ASSERT(write_meta_ship(100));
+    remove(META_CACHE);
+
+    bc_regcache_result_t r = BC_REGCACHE_HIT;
+    ASSERT(bc_registry_load_dir_cached(&g_reg, META_DIR, META_CACHE, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_MISSING);
+    ASSERT(bc_registry_cache_fresh(META_CACHE, META_DIR));
+    ASSERT(bc_registry_load_dir_cached(&g_reg, META_DIR, META_CACHE, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_HIT);
+    ASSERT_EQ_INT(g_reg.ships[0].species_id, 1);
+
+    /* Rewritten with the same bytes: metadata differs, content hits, and
+     * the refreshed table makes the next start cheap again */
+    ASSERT(write_meta_ship(100));
+    ASSERT(!bc_registry_cache_fresh(META_CACHE, META_DIR));
+    ASSERT(bc_registry_load_dir_cached(&g_reg, META_DIR, META_CACHE, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_HIT);
+    ASSERT(bc_registry_cache_fresh(META_CACHE, META_DIR));
+
+    /* Same size, new content */
+    ASSERT(write_meta_ship(101));
+    ASSERT(!bc_registry_cache_fresh(META_CACHE, META_DIR));
+    ASSERT(bc_registry_load_dir_cached(&g_reg, META_DIR, META_CACHE, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_STALE);
+    ASSERT(bc_registry_cache_fresh(META_CACHE, META_DIR));
+
+    /* Written just now: inside the racy second, so always hashed */
+    ASSERT(write_text(META_DIR "/ships/probe/ship.json",
+                      "{\"name\": \"Probe\", \"species_id\": 1, \"hull_hp\": 102}"));
+    ASSERT(bc_registry_load_dir_cached(&g_reg, META_DIR, META_CACHE, &r));
+    ASSERT_EQ_INT(r, BC_REGCACHE_STALE);
+    ASSERT(!bc_registry_cache_fresh(META_CACHE, META_DIR));
+
+    /* A cache written without a table is never fresh */
+    u64 h = 0;
+    ASSERT(bc_registry_source_hash(META_DIR, &h));
+    ASSERT(bc_registry_cache_write(META_CACHE, &g_reg, h));
+    ASSERT(!bc_registry_cache_fresh(META_CACHE, META_DIR));
+    ASSERT(!bc_registry_cache_fresh("build/tests/no_such.cache", META_DIR));
+    remove(META_CACHE);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(round_trip_matches_json);
+    RUN(rejects_mismatches);
+    RUN(load_through_writes_then_hits);
+    RUN(source_hash_tracks_files);
+    RUN(metadata_check_skips_hashing);
+TEST_MAIN_END()
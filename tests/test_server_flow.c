@@ -0,0 +1,364 @@
+/* Server-flow tests: engine hit handling driven in-process.
+ *
+ * Links the server objects (everything but main.o) so the real dispatch
+ * callbacks run against g_peers/g_registry without a socket. Covers the
+ * order engine events fire in around a hit ("ship_damaged" lands after
+ * the hit's repair/health/kill handling, so on a lethal hit it follows
+ * "ship_killed" and sees the victim without a ship), checksum responses
+ * parsed in frame-arena scratch without ever being dropped, a module
+ * damage kernel that never touches the journal still queueing repairs,
+ * and a [bots] bot run through the server tick until its fire lands on a
+ * player, with the wire carrying the victim's health but nothing that
+ * names the (headless) bot, and a ninth attacker scoring the kill after
+ * the victim's damage ledger evicted its smallest contributor. */
+
+#include "test_util.h"
+#include "openbc/server_state.h"
+#include "openbc/server_dispatch.h"
+#include "openbc/server_events.h"
+#include "openbc/server_bots.h"
+#include "openbc/server_handshake.h"
+#include "openbc/handshake.h"
+#include "openbc/client_transport.h"
+#include "openbc/torpedo_tracker.h"
+#include "openbc/game_builders.h"
+#include "openbc/module_loader.h"
+#include "openbc/combat.h"
+#include "openbc/opcodes.h"
+#include "openbc/transport.h"
+#include <string.h>
+
+#define REGISTRY_DIR "data/vanilla-1.1"
+
+/* Galaxy (species 3) in slots 1..ships, dedi in slot 0 */
+#define SHOOTER 1
+#define VICTIM  2
+
+static bool setup_ships(int ships)
+{
+    g_registry = calloc(1, sizeof(*g_registry));
+    if (!g_registry || !bc_registry_load_dir(g_registry, REGISTRY_DIR))
+        return false;
+    g_registry_loaded = true;
+
+    obc_event_bus_init();
+    bc_server_events_register();
+
+    bc_torpedo_mgr_init(&g_torpedoes);
+    if (!bc_peers_init(&g_peers, ships + 2)) return false;
+    bc_peers_reserve_dedicated(&g_peers, "Dedi");
+    int cidx = bc_registry_find_ship_index(g_registry, 3);
+    const bc_ship_class_t *cls = bc_registry_get_ship(g_registry, cidx);
+    if (!cls) return false;
+    for (int s = 1; s <= ships; s++) {
+        bc_addr_t addr = { .ip = 0x0100007Fu, .port = (u16)(40000 + s) };
+        if (bc_peers_add(&g_peers, &addr) != s) return false;
+        bc_peer_t *p = &g_peers.peers[s];
+        p->state = PEER_IN_GAME;
+        bc_ship_init(&p->ship, cls, cidx, bc_make_ship_id(s - 1), (u8)s, 0);
+        bc_ship_assign_subsystem_ids(&p->ship, cls);
+        p->ship.pos.x = (f32)(s * 100);
+        p->class_index = cidx;
+        p->registry = g_registry;
+        p->has_ship = true;
+    }
+    return true;
+}
+
+static bool setup(void)
+{
+    return setup_ships(VICTIM);
+}
+
+static void teardown(void)
+{
+    obc_event_bus_shutdown();
+    bc_peers_free(&g_peers);
+    free(g_registry);
+    g_registry = NULL;
+    g_registry_loaded = false;
+}
+
+/* --- Event recorder --- */
+
+static char g_order[8];
+static int  g_order_len;
+static bool g_victim_had_ship;
+static obc_damage_event_t g_last_damage;
+
+static void on_killed(const obc_engine_api_t *api, obc_event_ctx_t *ctx)
+{
+    (void)api; (void)ctx;
+    if (g_order_len < (int)sizeof(g_order) - 1) g_order[g_order_len++] = 'K';
+}
+
+static void on_damaged(const obc_engine_api_t *api, obc_event_ctx_t *ctx)
+{
+    (void)api;
+    g_last_damage = *(const obc_damage_event_t *)ctx->event_data;
+    g_victim_had_ship = g_peers.peers[g_last_damage.target_slot].has_ship;
+    if (g_order_len < (int)sizeof(g_order) - 1) g_order[g_order_len++] = 'D';
+}
+
+static void record_events(void)
+{
+    memset(g_order, 0, sizeof(g_order));
+    g_order_len = 0;
+    obc_event_subscribe("ship_killed", on_killed, 100);
+    obc_event_subscribe("ship_damaged", on_damaged, 100);
+}
+
+static void torpedo_hit_from(int shooter, f32 damage)
+{
+    bc_torpedo_hit_callback(shooter, g_peers.peers[shooter].ship.object_id,
+                            g_peers.peers[VICTIM].ship.object_id,
+                            damage, 0.0f, g_peers.peers[shooter].ship.pos,
+                            NULL);
+}
+
+static void torpedo_hit(f32 damage)
+{
+    torpedo_hit_from(SHOOTER, damage);
+}
+
+/* --- Tests --- */
+
+TEST(nonlethal_hit_fires_damaged_once)
+{
+    ASSERT(setup());
+    record_events();
+
+    torpedo_hit(50.0f);
+
+    ASSERT(strcmp(g_order, "D") == 0);
+    ASSERT(g_victim_had_ship);
+    ASSERT_EQ_INT(g_last_damage.target_slot, VICTIM);
+    ASSERT_EQ_INT(g_last_damage.attacker_slot, SHOOTER);
+    ASSERT_EQ_INT(g_last_damage.source, OBC_DAMAGE_TORPEDO);
+    ASSERT(g_last_damage.shield_damage + g_last_damage.hull_damage > 0.0f);
+    teardown();
+}
+
+TEST(lethal_hit_fires_damaged_after_kill)
+{
+    ASSERT(setup());
+    record_events();
+
+    torpedo_hit(1.0e6f);
+
+    ASSERT(strcmp(g_order, "KD") == 0);
+    ASSERT(!g_victim_had_ship);
+    ASSERT(g_last_damage.hull_remaining <= 0.0f);
+    ASSERT_EQ_INT(g_player_kills[SHOOTER], 1);
+    teardown();
+}
+
+/* Feed slot a well-formed final-round (0xFF) checksum response */
+static void final_checksum_response(int slot)
+{
+    u8 buf[16];
+    bc_transport_msg_t msg = { 0 };
+    msg.payload = buf;
+    msg.payload_len = bc_client_build_checksum_final(buf, sizeof(buf), 0);
+    g_peers.peers[slot].state = PEER_CHECKSUMMING_FINAL;
+    bc_handle_checksum_response(slot, &msg);
+}
+
+TEST(checksum_response_survives_full_arena)
+{
+    ASSERT(setup());
+    static u8 tiny[64];
+    bc_arena_init(&g_frame, tiny, sizeof(tiny));
+
+    /* The ~10 KB parse scratch cannot fit: the handshake still advances */
+    final_checksum_response(SHOOTER);
+    ASSERT_EQ_INT(g_peers.peers[SHOOTER].state, PEER_LOBBY);
+    ASSERT(g_frame.failed > 0);
+    teardown();
+}
+
+TEST(checksum_scratch_released_per_response)
+{
+    ASSERT(setup());
+    static u8 arena[BC_FRAME_ARENA_SIZE];
+    bc_arena_init(&g_frame, arena, sizeof(arena));
+
+    /* Two responses in one receive pass: neither keeps its scratch */
+    final_checksum_response(SHOOTER);
+    final_checksum_response(VICTIM);
+    ASSERT_EQ_INT(g_peers.peers[SHOOTER].state, PEER_LOBBY);
+    ASSERT_EQ_INT(g_peers.peers[VICTIM].state, PEER_LOBBY);
+    ASSERT(g_frame.used == 0);
+    ASSERT(g_frame.peak >= sizeof(bc_checksum_resp_t));
+    ASSERT_EQ_INT((int)g_frame.failed, 0);
+    teardown();
+}
+
+/* A module kernel that knows nothing about the change journal */
+static void raw_subsystem_damage(bc_ship_state_t *target,
+                                 const bc_ship_class_t *cls,
+                                 f32 damage, f32 damage_radius,
+                                 bc_vec3_t impact_dir, bool area_effect,
+                                 f32 search_radius)
+{
+    (void)cls; (void)damage_radius; (void)impact_dir;
+    (void)area_effect; (void)search_radius;
+    target->subsystem_hp[0] -= damage;
+    target->hull_hp -= damage;
+}
+
+TEST(module_kernel_damage_queues_repair)
+{
+    ASSERT(setup());
+    obc_engine_api_t api;
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    obc_module_api_build(&api, &cfg);
+    obc_module_t self = { .name = "rules" };
+    obc_combat_kernels_t k = { .apply_damage = raw_subsystem_damage };
+    ASSERT_EQ_INT(api.combat_kernels_set(&self, &k), 0);
+
+    bc_ship_state_t *victim = &g_peers.peers[VICTIM].ship;
+    ASSERT_EQ_INT(victim->repair_count, 0);
+    torpedo_hit(10.0f);
+
+    ASSERT(victim->journal.hit_subsys & 1);
+    ASSERT(victim->journal.changed & BC_SHIP_CHG_HULL);
+    ASSERT_EQ_INT(victim->repair_count, 1);
+    ASSERT_EQ_INT(victim->repair_queue[0], 0);
+
+    obc_module_loader_t loader;
+    memset(&loader, 0, sizeof(loader));
+    obc_module_loader_shutdown(&loader);
+    ASSERT(g_combat_kernels.apply_damage == bc_combat_apply_damage);
+    teardown();
+}
+
+/* --- Wire recorder: what one peer's outbox carried --- */
+
+typedef struct {
+    int creates;          /* ObjCreate / ObjCreateTeam */
+    int fire;             /* BeamFire / TorpedoFire */
+    int updates_of_bot;   /* StateUpdate naming the bot */
+    int updates_of_victim;
+} wire_seen_t;
+
+static void drain_outbox(int slot, i32 bot_id, i32 victim_id, wire_seen_t *seen)
+{
+    u8 pkt[BC_MAX_PACKET_SIZE];
+    int len = bc_outbox_flush_to_buf(&g_peers.peers[slot].outbox, pkt, sizeof(pkt));
+    bc_packet_t parsed;
+    if (len <= 0 || !bc_transport_parse(pkt, len, &parsed)) return;
+    for (int m = 0; m < parsed.msg_count; m++) {
+        const bc_transport_msg_t *msg = &parsed.msgs[m];
+        if (!msg->payload || msg->payload_len < 1) continue;
+        u8 op = msg->payload[0];
+        if (op == BC_OP_OBJ_CREATE || op == BC_OP_OBJ_CREATE_TEAM) seen->creates++;
+        if (op == BC_OP_BEAM_FIRE || op == BC_OP_TORPEDO_FIRE) seen->fire++;
+        if (op != BC_OP_STATE_UPDATE || msg->payload_len < 5) continue;
+        i32 obj;
+        memcpy(&obj, msg->payload + 1, sizeof(obj));
+        if (obj == bot_id)    seen->updates_of_bot++;
+        if (obj == victim_id) seen->updates_of_victim++;
+    }
+}
+
+TEST(bot_engages_player_through_server_tick)
+{
+    ASSERT(setup());
+    obc_server_cfg_t cfg;
+    obc_config_defaults(&cfg);
+    cfg.bot_count = 1;
+    ASSERT(bc_server_bots_init(&cfg));
+
+    const bc_bot_world_t *w = bc_server_bots_world();
+    ASSERT(w != NULL);
+    ASSERT_EQ_INT(w->bot_count, 1);
+    const bc_ship_state_t *bot = w->bots[0].ship;
+    ASSERT(find_peer_by_object(bot->object_id) < 0);
+
+    /* Victim parked inside phaser range, shooter far away */
+    bc_ship_state_t *victim = &g_peers.peers[VICTIM].ship;
+    victim->pos = bc_vec3_add(bot->pos, (bc_vec3_t){ 60.0f, 0.0f, 0.0f });
+    g_peers.peers[SHOOTER].ship.pos = (bc_vec3_t){ -5000.0f, 0.0f, 0.0f };
+    f32 hp_before = victim->hull_hp;
+    for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++)
+        hp_before += victim->shield_hp[i];
+    record_events();
+
+    wire_seen_t seen[VICTIM + 1];
+    memset(seen, 0, sizeof(seen));
+    const f32 dt = 1.0f / 30.0f;
+    for (int t = 0; t < 90; t++) {
+        bc_server_bots_tick(dt);
+        bc_torpedo_tick(&g_torpedoes, dt, 5.0f, bc_torpedo_target_pos,
+                        bc_torpedo_hit_callback, NULL);
+        for (int s = SHOOTER; s <= VICTIM; s++)
+            drain_outbox(s, bot->object_id, victim->object_id, &seen[s]);
+    }
+
+    ASSERT(w->stats.decisions > 0);
+    ASSERT(w->bots[0].target == victim);
+    ASSERT(w->stats.phasers_fired + w->stats.torpedoes_fired > 0);
+
+    /* The fire landed: damage applied and reported with no attacker slot */
+    f32 hp_after = victim->hull_hp;
+    for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++)
+        hp_after += victim->shield_hp[i];
+    ASSERT(hp_after < hp_before);
+    ASSERT(g_order_len > 0);
+    ASSERT_EQ_INT(g_last_damage.target_slot, VICTIM);
+    ASSERT_EQ_INT(g_last_damage.attacker_slot, -1);
+
+    /* Bots are headless: both players get the victim's health, but no
+     * packet creates, moves or fires from the bot */
+    for (int s = SHOOTER; s <= VICTIM; s++) {
+        ASSERT(seen[s].updates_of_victim > 0);
+        ASSERT_EQ_INT(seen[s].creates, 0);
+        ASSERT_EQ_INT(seen[s].fire, 0);
+        ASSERT_EQ_INT(seen[s].updates_of_bot, 0);
+    }
+
+    bc_server_bots_shutdown();
+    ASSERT(bc_server_bots_world() == NULL);
+    teardown();
+}
+
+TEST(ninth_attacker_kills_after_ledger_eviction)
+{
+    /* Nine attackers: slot 1 and slots 3..10 */
+    ASSERT(setup_ships(BC_LEDGER_MAX_ATTACKERS + 2));
+    memset(g_player_scores, 0, sizeof(g_player_scores));
+    memset(g_player_kills, 0, sizeof(g_player_kills));
+    const int ninth = BC_LEDGER_MAX_ATTACKERS + 2;
+
+    /* Eight fill the ledger; slot 3 contributes least */
+    for (int s = 1; s < ninth; s++) {
+        if (s == VICTIM) continue;
+        torpedo_hit_from(s, s == 3 ? 20.0f : 60.0f);
+    }
+    ASSERT_EQ_INT(g_damage_ledger[VICTIM].count, BC_LEDGER_MAX_ATTACKERS);
+    ASSERT(g_peers.peers[VICTIM].has_ship);
+
+    /* The ninth evicts slot 3 and lands the kill */
+    torpedo_hit_from(ninth, 1.0e6f);
+    ASSERT(!g_peers.peers[VICTIM].has_ship);
+    ASSERT_EQ_INT(g_player_kills[ninth], 1);
+    ASSERT(g_player_scores[ninth] > 0);
+    ASSERT_EQ_INT(g_player_scores[3], 0);
+    for (int s = 4; s < ninth; s++)
+        ASSERT(g_player_scores[s] > 0);
+    ASSERT(g_player_scores[1] > 0);
+    ASSERT_EQ_INT(g_damage_ledger[VICTIM].count, 0);
+    teardown();
+}
+
+TEST_MAIN_BEGIN()
+    RUN(nonlethal_hit_fires_damaged_once);
+    RUN(lethal_hit_fires_damaged_after_kill);
+    RUN(checksum_response_survives_full_arena);
+    RUN(checksum_scratch_released_per_response);
+    RUN(module_kernel_damage_queues_repair);
+    RUN(bot_engages_player_through_server_tick);
+    RUN(ninth_attacker_kills_after_ledger_eviction);
+TEST_MAIN_END()
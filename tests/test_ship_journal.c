@@ -0,0 +1,202 @@
+#include "test_util.h"
+#include "openbc/ship_data.h"
+#include "openbc/ship_state.h"
+#include "openbc/combat.h"
+#include "openbc/ship_power.h"
+#include "openbc/game_builders.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the per-ship change journal (bc_ship_journal_t).
+ *
+ * Covers what the mutation paths record: shield facings, subsystem hits
+ * (per-tick and per-hit sets), hull and destruction from damage; repairs
+ * and the repaired event; shield recharge; cloak transitions; battery
+ * changes from the power tick; event overflow and clearing.
+ *
+ * Test ship: Galaxy-class (species_id=3), default orientation.
+ */
+
+#define REGISTRY_DIR "data/vanilla-1.1"
+
+static bc_game_registry_t g_reg;
+static const bc_ship_class_t *g_cls;
+
+static void fresh_ship(bc_ship_state_t *ship)
+{
+    bc_ship_init(ship, g_cls, 2, bc_make_ship_id(0), 0, 0);
+    ship->fwd = (bc_vec3_t){ 0.0f, 1.0f, 0.0f };
+    ship->up  = (bc_vec3_t){ 0.0f, 0.0f, 1.0f };
+}
+
+static int count_events(const bc_ship_journal_t *j, u8 type)
+{
+    int n = 0;
+    for (int i = 0; i < j->event_count; i++)
+        if (j->events[i].type == type) n++;
+    return n;
+}
+
+TEST(load_registry)
+{
+    ASSERT(bc_registry_load_dir(&g_reg, REGISTRY_DIR));
+    g_cls = bc_registry_find_ship(&g_reg, 3);
+    ASSERT(g_cls != NULL);
+}
+
+TEST(fresh_ship_has_empty_journal)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    ASSERT_EQ_INT(ship.journal.changed, 0);
+    ASSERT_EQ_INT(ship.journal.event_count, 0);
+    ASSERT(ship.journal.subsys_damaged == 0);
+}
+
+TEST(directed_hit_on_shield_marks_one_facing)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    bc_vec3_t from_front = { 0.0f, 1.0f, 0.0f };
+    bc_combat_apply_damage(&ship, g_cls, 10.0f, 0.0f, from_front, false, 1.0f);
+
+    ASSERT_EQ_INT(ship.journal.changed, BC_SHIP_CHG_SHIELDS);
+    ASSERT_EQ_INT(ship.journal.shields, 1 << BC_SHIELD_FRONT);
+    ASSERT(ship.journal.subsys_damaged == 0);
+    ASSERT_EQ_INT(ship.journal.event_count, 0);
+
+    /* Overflow the facing: it goes down, the rest reaches the hull */
+    f32 front = ship.shield_hp[BC_SHIELD_FRONT];
+    bc_combat_apply_damage(&ship, g_cls, front + 50.0f, 0.0f, from_front,
+                           false, 1.0f);
+    ASSERT(ship.journal.changed & BC_SHIP_CHG_HULL);
+    ASSERT_EQ_INT(count_events(&ship.journal, BC_SHIP_EV_SHIELD_DOWN), 1);
+    ASSERT_EQ_INT(ship.journal.events[0].index, BC_SHIELD_FRONT);
+}
+
+TEST(subsystem_hits_scoped_per_hit_and_per_tick)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    for (int i = 0; i < BC_MAX_SHIELD_FACINGS; i++) ship.shield_hp[i] = 0.0f;
+
+    /* Forward torpedo cluster */
+    bc_vec3_t at_torps = { 0.0f, -0.25f, -0.25f };
+    ship.journal.hit_subsys = 0;
+    bc_combat_apply_damage(&ship, g_cls, 100.0f, 0.1f, at_torps, false, 1.0f);
+    u64 first = ship.journal.hit_subsys;
+    ASSERT(first != 0);
+    ASSERT(ship.journal.subsys_damaged == first);
+    ASSERT(ship.journal.changed & BC_SHIP_CHG_SUBSYS);
+    for (int i = 0; i < g_cls->subsystem_count; i++) {
+        bool hit = (first >> i) & 1;
+        ASSERT(hit == (ship.subsystem_hp[i] < g_cls->subsystems[i].max_condition));
+    }
+
+    /* A second hit elsewhere: the hit set restarts, the tick set grows */
+    bc_vec3_t at_hull = { 0.0f, -1.5f, -0.5f };
+    ship.journal.hit_subsys = 0;
+    bc_combat_apply_damage(&ship, g_cls, 100.0f, 0.1f, at_hull, false, 1.0f);
+    ASSERT(ship.journal.hit_subsys != 0);
+    ASSERT(ship.journal.subsys_damaged == (first | ship.journal.hit_subsys));
+
+    bc_ship_journal_clear(&ship.journal);
+    ASSERT_EQ_INT(ship.journal.changed, 0);
+    ASSERT(ship.journal.subsys_damaged == 0);
+}
+
+TEST(lethal_hit_records_destruction)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    bc_vec3_t dir = { 0.0f, 1.0f, 0.0f };
+    bc_combat_apply_damage(&ship, g_cls, 1.0e9f, 0.0f, dir, true, 1.0f);
+    ASSERT(!ship.alive);
+    ASSERT(ship.journal.changed & BC_SHIP_CHG_DESTROYED);
+    ASSERT_EQ_INT(count_events(&ship.journal, BC_SHIP_EV_DESTROYED), 1);
+    ASSERT_EQ_INT(count_events(&ship.journal, BC_SHIP_EV_SHIELD_DOWN),
+                  BC_MAX_SHIELD_FACINGS);
+}
+
+TEST(repair_records_progress_and_completion)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    int ss = -1;
+    for (int i = 0; i < g_cls->subsystem_count; i++)
+        if (strcmp(g_cls->subsystems[i].type, "sensor") == 0) { ss = i; break; }
+    ASSERT(ss >= 0);
+
+    ship.subsystem_hp[ss] = g_cls->subsystems[ss].max_condition - 1.0f;
+    ASSERT(bc_repair_add(&ship, (u8)ss));
+    bc_repair_tick(&ship, g_cls, 10.0f);
+
+    ASSERT(ship.subsystem_hp[ss] == g_cls->subsystems[ss].max_condition);
+    ASSERT(ship.journal.subsys_repaired == ((u64)1 << ss));
+    ASSERT(ship.journal.subsys_damaged == 0);
+    ASSERT_EQ_INT(count_events(&ship.journal, BC_SHIP_EV_SUBSYS_REPAIRED), 1);
+    ASSERT_EQ_INT(ship.journal.events[0].index, ss);
+}
+
+TEST(shield_tick_marks_recharged_facings)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    ship.shield_hp[BC_SHIELD_REAR] = 1.0f;
+    bc_combat_shield_tick(&ship, g_cls, 1.0f, 0.1f);
+    ASSERT(ship.journal.shields & (1 << BC_SHIELD_REAR));
+    ASSERT(!(ship.journal.shields & (1 << BC_SHIELD_FRONT)));  /* was full */
+}
+
+TEST(cloak_transitions_are_events)
+{
+    const bc_ship_class_t *cloaker = NULL;
+    for (int i = 0; i < g_reg.ship_count && !cloaker; i++)
+        if (g_reg.ships[i].can_cloak) cloaker = &g_reg.ships[i];
+    ASSERT(cloaker != NULL);
+
+    bc_ship_state_t ship;
+    bc_ship_init(&ship, cloaker, 0, bc_make_ship_id(0), 0, 0);
+    ASSERT(bc_cloak_start(&ship, cloaker));
+    bc_cloak_tick(&ship, 1.0f, BC_CLOAK_TRANSITION_TIME + 0.1f);
+    ASSERT(ship.journal.changed & BC_SHIP_CHG_CLOAK);
+    ASSERT_EQ_INT(count_events(&ship.journal, BC_SHIP_EV_CLOAK), 2);
+    ASSERT_EQ_INT(ship.journal.events[0].index, BC_CLOAK_CLOAKING);
+    ASSERT_EQ_INT(ship.journal.events[1].index, BC_CLOAK_CLOAKED);
+}
+
+TEST(power_tick_marks_battery_change)
+{
+    bc_ship_state_t ship;
+    fresh_ship(&ship);
+    ship.main_battery = 0.0f;
+    bc_ship_power_tick(&ship, g_cls, 1.0f);
+    ASSERT(ship.journal.changed & BC_SHIP_CHG_POWER);
+}
+
+TEST(event_overflow_is_counted)
+{
+    bc_ship_journal_t j;
+    memset(&j, 0, sizeof(j));
+    for (int i = 0; i < BC_SHIP_JOURNAL_EVENTS + 3; i++)
+        bc_ship_journal_event(&j, BC_SHIP_EV_SUBSYS_DESTROYED, (u8)i);
+    ASSERT_EQ_INT(j.event_count, BC_SHIP_JOURNAL_EVENTS);
+    ASSERT_EQ_INT(j.events_dropped, 3);
+    bc_ship_journal_clear(&j);
+    ASSERT_EQ_INT(j.event_count, 0);
+    ASSERT_EQ_INT(j.events_dropped, 0);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(load_registry);
+    RUN(fresh_ship_has_empty_journal);
+    RUN(directed_hit_on_shield_marks_one_facing);
+    RUN(subsystem_hits_scoped_per_hit_and_per_tick);
+    RUN(lethal_hit_records_destruction);
+    RUN(repair_records_progress_and_completion);
+    RUN(shield_tick_marks_recharged_facings);
+    RUN(cloak_transitions_are_events);
+    RUN(power_tick_marks_battery_change);
+    RUN(event_overflow_is_counted);
+TEST_MAIN_END()
@@ -0,0 +1,152 @@
+#include "test_util.h"
+#include "openbc/ship_snapshot.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the per-tick fleet snapshot (src/server/ship_snapshot.c).
+ *
+ * Covers slot order and filtering (dedicated slot, peers without a ship),
+ * the copied fields and class-derived maxima, a missing registry, and the
+ * lazy build / invalidate cycle.
+ */
+
+static bc_peer_mgr_t      g_mgr;
+static bc_game_registry_t g_reg;
+static bc_ship_snapshot_t g_snap;
+
+static int add_peer(u16 port)
+{
+    bc_addr_t a;
+    memset(&a, 0, sizeof(a));
+    a.ip = 0x0100007F;
+    a.port = port;
+    return bc_peers_add(&g_mgr, &a);
+}
+
+static void give_ship(int slot, int class_index, i32 object_id, u8 team)
+{
+    bc_peer_t *p = &g_mgr.peers[slot];
+    memset(&p->ship, 0, sizeof(p->ship));
+    p->has_ship          = true;
+    p->class_index       = class_index;
+    p->ship.class_index  = class_index;
+    p->ship.object_id    = object_id;
+    p->ship.team_id      = team;
+    p->ship.alive        = true;
+    p->ship.hull_hp      = 300.0f;
+    p->ship.speed        = 4.0f;
+    p->ship.pos          = (bc_vec3_t){ (f32)slot, 2.0f, 3.0f };
+    p->ship.fwd          = (bc_vec3_t){ 0.0f, 1.0f, 0.0f };
+    for (int f = 0; f < BC_MAX_SHIELD_FACINGS; f++)
+        p->ship.shield_hp[f] = 10.0f;
+}
+
+static void setup(void)
+{
+    ASSERT(bc_peers_init(&g_mgr, 8));
+    bc_peers_reserve_dedicated(&g_mgr, "Dedicated Server");
+    g_mgr.peers[0].has_ship = true;     /* never listed */
+
+    memset(&g_reg, 0, sizeof(g_reg));
+    g_reg.ship_count = 1;
+    g_reg.ships[0].species_id = 5;
+    g_reg.ships[0].hull_hp = 500.0f;
+    for (int f = 0; f < BC_MAX_SHIELD_FACINGS; f++)
+        g_reg.ships[0].shield_hp[f] = 100.0f;
+
+    memset(&g_snap, 0, sizeof(g_snap));
+}
+
+TEST(build_lists_ships_in_slot_order)
+{
+    setup();
+    int a = add_peer(1), b = add_peer(2), c = add_peer(3);
+    ASSERT(a == 1 && b == 2 && c == 3);
+    give_ship(c, 0, 0x4000, 1);
+    give_ship(a, 0, 0x3FFF, 0);         /* b has no ship yet */
+    g_mgr.peers[c].ship.alive = false;
+    g_mgr.peers[c].ship.cloak_state = BC_CLOAK_CLOAKED;
+
+    ASSERT_EQ_INT(bc_ship_snapshot_build(&g_snap, &g_mgr, &g_reg), 2);
+    ASSERT_EQ_INT(g_snap.count, 2);
+
+    const bc_ship_view_t *v = &g_snap.ships[0];
+    ASSERT_EQ_INT(v->slot, 1);
+    ASSERT_EQ_INT(v->object_id, 0x3FFF);
+    ASSERT_EQ_INT(v->alive, 1);
+    ASSERT_EQ_INT(v->class_index, 0);
+    ASSERT_EQ_INT(v->species, 5);
+    ASSERT(v->pos.x == 1.0f && v->pos.z == 3.0f && v->fwd.y == 1.0f);
+    ASSERT(v->speed == 4.0f);
+    ASSERT(v->hull_hp == 300.0f && v->hull_max == 500.0f);
+    ASSERT(v->shield_hp == 60.0f && v->shield_max == 600.0f);
+
+    v = &g_snap.ships[1];
+    ASSERT_EQ_INT(v->slot, 3);
+    ASSERT_EQ_INT(v->team_id, 1);
+    ASSERT_EQ_INT(v->alive, 0);         /* dead ships stay listed */
+    ASSERT_EQ_INT(v->cloak_state, BC_CLOAK_CLOAKED);
+    bc_peers_free(&g_mgr);
+}
+
+TEST(unknown_class_leaves_maxima_zero)
+{
+    setup();
+    int a = add_peer(1), b = add_peer(2);
+    give_ship(a, 0, 0x3FFF, 0);
+    give_ship(b, 7, 0x4000, 0);         /* out of registry range */
+
+    bc_ship_snapshot_build(&g_snap, &g_mgr, &g_reg);
+    ASSERT_EQ_INT(g_snap.ships[1].class_index, -1);
+    ASSERT_EQ_INT(g_snap.ships[1].species, -1);
+    ASSERT(g_snap.ships[1].hull_max == 0.0f && g_snap.ships[1].shield_max == 0.0f);
+    ASSERT(g_snap.ships[1].hull_hp == 300.0f);
+
+    /* No registry at all */
+    bc_ship_snapshot_build(&g_snap, &g_mgr, NULL);
+    ASSERT_EQ_INT(g_snap.count, 2);
+    ASSERT_EQ_INT(g_snap.ships[0].species, -1);
+    ASSERT(g_snap.ships[0].hull_max == 0.0f);
+    bc_peers_free(&g_mgr);
+}
+
+TEST(get_builds_once_until_invalidated)
+{
+    setup();
+    int a = add_peer(1);
+    give_ship(a, 0, 0x3FFF, 0);
+
+    const bc_ship_snapshot_t *s = bc_ship_snapshot_get(&g_snap, &g_mgr, &g_reg);
+    ASSERT(s == &g_snap && s->valid);
+    ASSERT_EQ_INT(s->builds, 1);
+
+    /* Later changes in the same tick are not seen */
+    g_mgr.peers[a].ship.hull_hp = 1.0f;
+    int b = add_peer(2);
+    give_ship(b, 0, 0x4000, 0);
+    s = bc_ship_snapshot_get(&g_snap, &g_mgr, &g_reg);
+    ASSERT_EQ_INT(s->builds, 1);
+    ASSERT_EQ_INT(s->count, 1);
+    ASSERT(s->ships[0].hull_hp == 300.0f);
+
+    bc_ship_snapshot_invalidate(&g_snap);
+    s = bc_ship_snapshot_get(&g_snap, &g_mgr, &g_reg);
+    ASSERT_EQ_INT(s->builds, 2);
+    ASSERT_EQ_INT(s->count, 2);
+    ASSERT(s->ships[0].hull_hp == 1.0f);
+
+    /* A removed peer drops out on the next build */
+    bc_peers_remove(&g_mgr, a);
+    bc_ship_snapshot_invalidate(&g_snap);
+    s = bc_ship_snapshot_get(&g_snap, &g_mgr, &g_reg);
+    ASSERT_EQ_INT(s->count, 1);
+    ASSERT_EQ_INT(s->ships[0].slot, 2);
+    bc_peers_free(&g_mgr);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(build_lists_ships_in_slot_order);
+    RUN(unknown_class_leaves_maxima_zero);
+    RUN(get_builds_once_until_invalidated);
+TEST_MAIN_END()
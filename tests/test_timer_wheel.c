@@ -0,0 +1,202 @@
+#include "test_util.h"
+#include "openbc/timer_wheel.h"
+
+#include <string.h>
+
+/*
+ * Unit tests for the hierarchical timing wheel (src/server/timer_wheel.c).
+ *
+ * Covers exact expiry across every level boundary and beyond the wheel's
+ * span, periodic phase keeping, cancel (including from inside callbacks),
+ * stale-ID rejection after node reuse, pool exhaustion and the per-advance
+ * expiry budget.
+ */
+
+static bc_timer_wheel_t g_w;
+
+/* Records the tick (w->now after the advance) of every call, per timer. */
+#define MAX_REC 16
+static u32 g_fired_at[MAX_REC][8];
+static int g_fire_count[MAX_REC];
+static int g_total;
+
+static void reset(int max_expire)
+{
+    bc_timer_wheel_init(&g_w, max_expire);
+    memset(g_fired_at, 0, sizeof(g_fired_at));
+    memset(g_fire_count, 0, sizeof(g_fire_count));
+    g_total = 0;
+}
+
+static void record(void *user, int timer_id)
+{
+    (void)timer_id;
+    int k = (int)(size_t)user;
+    if (k >= 0 && k < MAX_REC && g_fire_count[k] < 8)
+        g_fired_at[k][g_fire_count[k]] = g_w.now;
+    if (k >= 0 && k < MAX_REC) g_fire_count[k]++;
+    g_total++;
+}
+
+static void advance_n(u32 n)
+{
+    for (u32 i = 0; i < n; i++) bc_timer_advance(&g_w);
+}
+
+TEST(one_shot_fires_once_on_time)
+{
+    reset(0);
+    int a = bc_timer_add(&g_w, 1, 0, record, (void *)0);
+    int b = bc_timer_add(&g_w, 5, 0, record, (void *)1);
+    int c = bc_timer_add(&g_w, 0, 0, record, (void *)2);  /* 0 -> 1 */
+    ASSERT(a > 0 && b > 0 && c > 0);
+    ASSERT(bc_timer_active(&g_w, b));
+
+    advance_n(10);
+    ASSERT_EQ_INT(g_fire_count[0], 1);
+    ASSERT_EQ_INT(g_fired_at[0][0], 1);
+    ASSERT_EQ_INT(g_fire_count[1], 1);
+    ASSERT_EQ_INT(g_fired_at[1][0], 5);
+    ASSERT_EQ_INT(g_fire_count[2], 1);
+    ASSERT(!bc_timer_active(&g_w, b));
+    ASSERT_EQ_INT(g_w.stats.active, 0);
+}
+
+TEST(delays_across_levels_are_exact)
+{
+    static const u32 delays[] = {
+        63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145,
+        BC_TIMER_MAX_DELAY + 100
+    };
+    int n = (int)(sizeof(delays) / sizeof(delays[0]));
+    reset(0);
+    advance_n(37);  /* start off a level boundary */
+    u32 base = g_w.now;
+    for (int i = 0; i < n; i++)
+        ASSERT(bc_timer_add(&g_w, delays[i], 0, record, (void *)(size_t)i) > 0);
+
+    advance_n(BC_TIMER_MAX_DELAY + 200);
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ_INT(g_fire_count[i], 1);
+        ASSERT_EQ_INT(g_fired_at[i][0], base + delays[i]);
+    }
+    ASSERT(g_w.stats.cascaded > 0);
+}
+
+TEST(periodic_keeps_phase)
+{
+    reset(0);
+    int id = bc_timer_add(&g_w, 30, 30, record, (void *)0);
+    bc_timer_add(&g_w, 7, 100, record, (void *)1);
+    advance_n(100);
+    ASSERT_EQ_INT(g_fire_count[0], 3);
+    ASSERT_EQ_INT(g_fired_at[0][0], 30);
+    ASSERT_EQ_INT(g_fired_at[0][1], 60);
+    ASSERT_EQ_INT(g_fired_at[0][2], 90);
+    ASSERT_EQ_INT(g_fire_count[1], 1);
+    ASSERT(bc_timer_active(&g_w, id));
+
+    ASSERT(bc_timer_cancel(&g_w, id));
+    ASSERT(!bc_timer_cancel(&g_w, id));
+    advance_n(100);
+    ASSERT_EQ_INT(g_fire_count[0], 3);
+    ASSERT_EQ_INT(g_fire_count[1], 2);
+}
+
+TEST(stale_ids_rejected_after_reuse)
+{
+    reset(0);
+    int a = bc_timer_add(&g_w, 3, 0, record, (void *)0);
+    ASSERT(bc_timer_cancel(&g_w, a));
+    int b = bc_timer_add(&g_w, 3, 0, record, (void *)1);
+    ASSERT_EQ_INT(bc_timer_index(a), bc_timer_index(b));  /* same node */
+    ASSERT(a != b);
+    ASSERT(!bc_timer_cancel(&g_w, a));
+    ASSERT(bc_timer_active(&g_w, b));
+
+    ASSERT(!bc_timer_cancel(&g_w, 0));
+    ASSERT(!bc_timer_cancel(&g_w, -1));
+    ASSERT(!bc_timer_active(&g_w, 12345));
+    ASSERT_EQ_INT(bc_timer_add(&g_w, 1, 0, NULL, NULL), -1);
+
+    advance_n(5);
+    ASSERT_EQ_INT(g_fire_count[0], 0);
+    ASSERT_EQ_INT(g_fire_count[1], 1);
+}
+
+/* Periodic callback that cancels itself on its third run and arms a
+ * one-shot follow-up. */
+static int  g_self_runs;
+static bool g_self_cancelled;
+static void self_cancel(void *user, int timer_id)
+{
+    (void)user;
+    if (++g_self_runs == 3) {
+        g_self_cancelled = bc_timer_cancel(&g_w, timer_id);
+        bc_timer_add(&g_w, 2, 0, record, (void *)5);
+    }
+}
+
+TEST(callback_may_cancel_itself_and_add)
+{
+    reset(0);
+    g_self_runs = 0;
+    g_self_cancelled = false;
+    bc_timer_add(&g_w, 1, 1, self_cancel, NULL);
+    advance_n(10);
+    ASSERT_EQ_INT(g_self_runs, 3);
+    ASSERT(g_self_cancelled);
+    ASSERT_EQ_INT(g_fire_count[5], 1);
+    ASSERT_EQ_INT(g_fired_at[5][0], 5);
+    ASSERT_EQ_INT(g_w.stats.active, 0);
+}
+
+TEST(expiry_budget_defers_remainder)
+{
+    reset(10);
+    for (int i = 0; i < 95; i++)
+        bc_timer_add(&g_w, 4, 0, record, (void *)(size_t)MAX_REC);
+    advance_n(3);
+    ASSERT_EQ_INT(g_total, 0);
+
+    ASSERT_EQ_INT(bc_timer_advance(&g_w), 10);
+    ASSERT_EQ_INT(g_w.stats.deferred, 85);
+    advance_n(9);
+    ASSERT_EQ_INT(g_total, 95);
+    ASSERT_EQ_INT(g_w.stats.active, 0);
+    ASSERT_EQ_INT(bc_timer_advance(&g_w), 0);
+}
+
+TEST(pool_exhaustion_reported)
+{
+    reset(0);
+    for (int i = 0; i < BC_TIMER_MAX; i++)
+        ASSERT(bc_timer_add(&g_w, 10, 0, record, NULL) > 0);
+    ASSERT_EQ_INT(bc_timer_add(&g_w, 10, 0, record, NULL), -1);
+    ASSERT_EQ_INT(g_w.stats.add_failed, 1);
+    ASSERT_EQ_INT(g_w.stats.active_peak, BC_TIMER_MAX);
+
+    advance_n(10);
+    ASSERT_EQ_INT(g_total, BC_TIMER_MAX);
+    ASSERT(bc_timer_add(&g_w, 1, 0, record, NULL) > 0);
+}
+
+TEST(seconds_to_ticks)
+{
+    ASSERT_EQ_INT(bc_timer_ticks(1.0f), 30);
+    ASSERT_EQ_INT(bc_timer_ticks(0.0f), 1);
+    ASSERT_EQ_INT(bc_timer_ticks(-5.0f), 1);
+    ASSERT_EQ_INT(bc_timer_ticks(0.5f), 15);
+    ASSERT(bc_timer_ticks(1e12f) < BC_TIMER_MAX_DELAY);
+}
+
+TEST_MAIN_BEGIN()
+    RUN(one_shot_fires_once_on_time);
+    RUN(delays_across_levels_are_exact);
+    RUN(periodic_keeps_phase);
+    RUN(stale_ids_rejected_after_reuse);
+    RUN(callback_may_cancel_itself_and_add);
+    RUN(expiry_budget_defers_remainder);
+    RUN(pool_exhaustion_reported);
+    RUN(seconds_to_ticks);
+TEST_MAIN_END()
@@ -2,19 +2,37 @@
 #include <stdlib.h>
 #include <string.h>
 #include <dirent.h>
+#include <stdatomic.h>
 #include <sys/stat.h>
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <pthread.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
 #include "openbc/checksum.h"
 #include "openbc/json_parse.h"
 
+#define MAX_HASH_THREADS 64
+
 static void usage(const char *prog)
 {
     fprintf(stderr,
         "Usage:\n"
-        "  %s generate <game_dir> -o <output.json>\n"
+        "  %s generate <game_dir> -o <output.json> [-j <threads>] [--incremental]\n"
         "  %s verify <manifest.json> <game_dir>\n"
         "  %s hash-string <string>\n"
         "  %s hash-file <path>\n",
         prog, prog, prog, prog);
+    fprintf(stderr,
+        "\n"
+        "generate options:\n"
+        "  -j <threads>     Hash on this many threads (default: CPU count)\n"
+        "  --incremental    Reuse hashes of unchanged files (same size, mtime,\n"
+        "                   ctime and inode) from <output.json>.cache, then\n"
+        "                   rewrite it\n");
 }
 
 /* Forward declarations */
@@ -120,6 +138,29 @@ static void json_end_arr(json_writer_t *w)
     w->first_item = false;
 }
 
+/* Read an entire file into a malloc'd buffer. Sets *out_len. Returns NULL on error. */
+static char *read_file(const char *path, size_t *out_len)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (len < 0) { fclose(fp); return NULL; }
+
+    char *buf = malloc((size_t)len + 1);
+    if (!buf) { fclose(fp); return NULL; }
+
+    size_t read = fread(buf, 1, (size_t)len, fp);
+    fclose(fp);
+
+    buf[read] = '\0';
+    if (out_len) *out_len = read;
+    return buf;
+}
+
 /* --- Checksum directory definitions (stock BC 1.1) --- */
 
 typedef struct {
@@ -147,20 +188,195 @@ static bool match_filter(const char *filename, const char *filter)
     return strcmp(filename, filter) == 0;
 }
 
-/* Hash files in a directory, write JSON */
-static void hash_directory_files(json_writer_t *w, const char *dirpath,
-                                  const char *filter, bool recursive)
+/* --- Content hashing --- */
+
+/* Hash a file through a read-only mapping instead of a malloc'd copy.
+ * Falls back to file_hash_from_path if the file cannot be mapped. */
+static u32 hash_path(const char *path, bool *ok)
+{
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fh == INVALID_HANDLE_VALUE) {
+        *ok = false;
+        return 0;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fh, &size) || (u64)size.QuadPart > (u64)SIZE_MAX) {
+        CloseHandle(fh);
+        return file_hash_from_path(path, ok);
+    }
+    if (size.QuadPart == 0) {   /* nothing to map */
+        CloseHandle(fh);
+        *ok = true;
+        return 0;
+    }
+    HANDLE map = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+    const u8 *data = map ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!data) {
+        if (map) CloseHandle(map);
+        CloseHandle(fh);
+        return file_hash_from_path(path, ok);
+    }
+    u32 h = file_hash(data, (size_t)size.QuadPart);
+    UnmapViewOfFile(data);
+    CloseHandle(map);
+    CloseHandle(fh);
+    *ok = true;
+    return h;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        *ok = false;
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return file_hash_from_path(path, ok);
+    }
+    if (st.st_size == 0) {      /* nothing to map */
+        close(fd);
+        *ok = true;
+        return 0;
+    }
+    size_t len = (size_t)st.st_size;
+    void *data = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return file_hash_from_path(path, ok);
+    u32 h = file_hash(data, len);
+    munmap(data, len);
+    *ok = true;
+    return h;
+#endif
+}
+
+/* --- Directory scan ---
+ *
+ * generate walks the tree once to collect every matching file, hashes the
+ * collected files on worker threads, then writes the JSON from the scan.
+ * Files of one directory are contiguous in scan_t.files, in readdir order,
+ * so the output is the same as hashing inline during the walk. */
+
+typedef struct {
+    char       *path;      /* <game_dir>/<rel>, malloc'd */
+    const char *rel;       /* path relative to game_dir (cache key) */
+    const char *name;      /* basename */
+    u64         size;
+    i64         mtime;     /* ns since the epoch */
+    i64         ctime;     /* ns; status change (Win32: creation) */
+    u64         ino;       /* 0 where the platform has none */
+    u32         name_hash;
+    u32         hash;
+    bool        ok;
+    bool        cached;    /* hash reused from the incremental cache */
+} scan_file_t;
+
+typedef struct {
+    char *name;            /* NULL for a top-level checksum directory */
+    bool  opened;          /* opendir succeeded; else no files/subdirs keys */
+    int   first_file;
+    int   file_count;
+    int   first_child;     /* -1 terminated sibling list */
+    int   last_child;
+    int   next_sibling;
+} scan_dir_t;
+
+typedef struct {
+    scan_file_t *files;
+    int          file_count, file_cap;
+    scan_dir_t  *dirs;
+    int          dir_count, dir_cap;
+    size_t       root_len;  /* strlen(game_dir) + 1 */
+} scan_t;
+
+static void *grow(void *arr, int *cap, size_t elem)
+{
+    int n = *cap ? *cap * 2 : 64;
+    void *p = realloc(arr, (size_t)n * elem);
+    if (!p) {
+        fprintf(stderr, "Error: out of memory\n");
+        exit(1);
+    }
+    *cap = n;
+    return p;
+}
+
+static char *dup_str(const char *s)
+{
+    size_t n = strlen(s) + 1;
+    char *p = malloc(n);
+    if (!p) {
+        fprintf(stderr, "Error: out of memory\n");
+        exit(1);
+    }
+    return memcpy(p, s, n);
+}
+
+static int scan_new_dir(scan_t *s, const char *name)
+{
+    if (s->dir_count == s->dir_cap)
+        s->dirs = grow(s->dirs, &s->dir_cap, sizeof(*s->dirs));
+    int di = s->dir_count++;
+    scan_dir_t *d = &s->dirs[di];
+    d->name = name ? dup_str(name) : NULL;
+    d->opened = false;
+    d->first_file = s->file_count;
+    d->file_count = 0;
+    d->first_child = d->last_child = d->next_sibling = -1;
+    return di;
+}
+
+/* Nanosecond timestamps and inode of a stat'ed file. Whole seconds are
+ * too coarse for the cache: a file rewritten within the second it was
+ * last hashed would keep its old hash. */
+static void stat_stamps(const char *path, const struct stat *st,
+                        i64 *mtime, i64 *ctime, u64 *ino)
+{
+#if defined(_WIN32)
+    /* FILETIME: 100 ns ticks since 1601 */
+    WIN32_FILE_ATTRIBUTE_DATA fa;
+    if (GetFileAttributesExA(path, GetFileExInfoStandard, &fa)) {
+        const i64 epoch = 116444736000000000LL;
+        i64 w = ((i64)fa.ftLastWriteTime.dwHighDateTime << 32) |
+                fa.ftLastWriteTime.dwLowDateTime;
+        i64 c = ((i64)fa.ftCreationTime.dwHighDateTime << 32) |
+                fa.ftCreationTime.dwLowDateTime;
+        *mtime = (w - epoch) * 100;
+        *ctime = (c - epoch) * 100;
+    } else {
+        *mtime = (i64)st->st_mtime * 1000000000LL;
+        *ctime = (i64)st->st_ctime * 1000000000LL;
+    }
+    *ino = 0;
+#elif defined(__APPLE__)
+    (void)path;
+    *mtime = (i64)st->st_mtimespec.tv_sec * 1000000000LL + st->st_mtimespec.tv_nsec;
+    *ctime = (i64)st->st_ctimespec.tv_sec * 1000000000LL + st->st_ctimespec.tv_nsec;
+    *ino = (u64)st->st_ino;
+#else
+    (void)path;
+    *mtime = (i64)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+    *ctime = (i64)st->st_ctim.tv_sec * 1000000000LL + st->st_ctim.tv_nsec;
+    *ino = (u64)st->st_ino;
+#endif
+}
+
+/* Collect matching files (and, if recursive, subdirectories) of dirpath
+ * into node di. */
+static void scan_directory(scan_t *s, int di, const char *dirpath,
+                           const char *filter, bool recursive)
 {
     DIR *d = opendir(dirpath);
     if (!d) return;
+    s->dirs[di].opened = true;
+    s->dirs[di].first_file = s->file_count;
 
-    struct dirent *ent;
-    bool has_files = false;
-    bool has_subdirs = false;
+    /* Subdirectory names, recursed into after the directory is closed */
+    char **subs = NULL;
+    int nsubs = 0, sub_cap = 0;
 
-    /* First pass: files */
-    json_begin_arr(w, "files");
-    rewinddir(d);
+    struct dirent *ent;
     while ((ent = readdir(d)) != NULL) {
         if (ent->d_name[0] == '.') continue;
 
@@ -171,54 +387,326 @@ static void hash_directory_files(json_writer_t *w, const char *dirpath,
         if (stat(fullpath, &st) != 0) continue;
 
         if (S_ISREG(st.st_mode) && match_filter(ent->d_name, filter)) {
-            bool ok;
-            u32 name_h = string_hash(ent->d_name);
-            u32 content_h = file_hash_from_path(fullpath, &ok);
-
-            json_begin_arr_obj(w);
-            json_key_str(w, "filename", ent->d_name);
-            json_key_hex(w, "name_hash", name_h);
-            if (ok) {
-                json_key_hex(w, "content_hash", content_h);
-            } else {
-                json_key_str(w, "content_hash", "ERROR");
-            }
-            json_end_obj(w);
-            has_files = true;
+            if (s->file_count == s->file_cap)
+                s->files = grow(s->files, &s->file_cap, sizeof(*s->files));
+            scan_file_t *f = &s->files[s->file_count++];
+            memset(f, 0, sizeof(*f));
+            f->path = dup_str(fullpath);
+            f->rel = f->path + (strlen(f->path) > s->root_len ? s->root_len : 0);
+            f->name = f->path + strlen(dirpath) + 1;
+            f->size = (u64)st.st_size;
+            stat_stamps(fullpath, &st, &f->mtime, &f->ctime, &f->ino);
+        } else if (recursive && S_ISDIR(st.st_mode)) {
+            if (nsubs == sub_cap)
+                subs = grow(subs, &sub_cap, sizeof(*subs));
+            subs[nsubs++] = dup_str(ent->d_name);
+        }
+    }
+    closedir(d);
+    s->dirs[di].file_count = s->file_count - s->dirs[di].first_file;
+
+    for (int i = 0; i < nsubs; i++) {
+        int ci = scan_new_dir(s, subs[i]);
+        /* s->dirs may have moved */
+        if (s->dirs[di].last_child >= 0)
+            s->dirs[s->dirs[di].last_child].next_sibling = ci;
+        else
+            s->dirs[di].first_child = ci;
+        s->dirs[di].last_child = ci;
+
+        char fullpath[1024];
+        snprintf(fullpath, sizeof(fullpath), "%s/%s", dirpath, subs[i]);
+        scan_directory(s, ci, fullpath, filter, true);
+        free(subs[i]);
+    }
+    free(subs);
+}
+
+static void scan_free(scan_t *s)
+{
+    for (int i = 0; i < s->file_count; i++) free(s->files[i].path);
+    for (int i = 0; i < s->dir_count; i++) free(s->dirs[i].name);
+    free(s->files);
+    free(s->dirs);
+    memset(s, 0, sizeof(*s));
+}
+
+/* Write the files/subdirs arrays of node di */
+static void write_scan_dir(json_writer_t *w, const scan_t *s, int di)
+{
+    const scan_dir_t *d = &s->dirs[di];
+    if (!d->opened) return;
+
+    json_begin_arr(w, "files");
+    for (int i = 0; i < d->file_count; i++) {
+        const scan_file_t *f = &s->files[d->first_file + i];
+        json_begin_arr_obj(w);
+        json_key_str(w, "filename", f->name);
+        json_key_hex(w, "name_hash", f->name_hash);
+        if (f->ok) {
+            json_key_hex(w, "content_hash", f->hash);
+        } else {
+            json_key_str(w, "content_hash", "ERROR");
         }
+        json_end_obj(w);
     }
     json_end_arr(w);
-    (void)has_files;
 
-    /* Second pass: subdirectories (if recursive) */
     json_begin_arr(w, "subdirs");
-    if (recursive) {
-        rewinddir(d);
-        while ((ent = readdir(d)) != NULL) {
-            if (ent->d_name[0] == '.') continue;
-
-            char fullpath[1024];
-            snprintf(fullpath, sizeof(fullpath), "%s/%s", dirpath, ent->d_name);
-
-            struct stat st;
-            if (stat(fullpath, &st) != 0) continue;
-
-            if (S_ISDIR(st.st_mode)) {
-                json_begin_arr_obj(w);
-                json_key_str(w, "name", ent->d_name);
-                json_key_hex(w, "name_hash", string_hash(ent->d_name));
-                hash_directory_files(w, fullpath, filter, true);
-                json_end_obj(w);
-                has_subdirs = true;
-            }
-        }
+    for (int ci = d->first_child; ci >= 0; ci = s->dirs[ci].next_sibling) {
+        json_begin_arr_obj(w);
+        json_key_str(w, "name", s->dirs[ci].name);
+        json_key_hex(w, "name_hash", string_hash(s->dirs[ci].name));
+        write_scan_dir(w, s, ci);
+        json_end_obj(w);
     }
     json_end_arr(w);
-    (void)has_subdirs;
+}
 
-    closedir(d);
+/* StringHash every collected filename in one batch */
+static void hash_scan_names(scan_t *s)
+{
+    const char **names = malloc((size_t)(s->file_count ? s->file_count : 1) *
+                                sizeof(*names));
+    u32 *hashes = malloc((size_t)(s->file_count ? s->file_count : 1) *
+                         sizeof(*hashes));
+    if (!names || !hashes) {
+        fprintf(stderr, "Error: out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < s->file_count; i++) names[i] = s->files[i].name;
+    string_hash_many(names, (size_t)s->file_count, hashes);
+    for (int i = 0; i < s->file_count; i++) s->files[i].name_hash = hashes[i];
+    free(names);
+    free(hashes);
+}
+
+/* --- Incremental cache ---
+ *
+ * Sidecar text file next to the manifest (<output>.cache), one line per
+ * file hashed by the previous run:
+ *
+ *   openbc-hash-cache 2
+ *   <content_hash hex> <size> <mtime ns> <ctime ns> <inode> <path relative to game_dir>
+ *
+ * A file whose size, mtime, ctime and inode all match reuses the stored
+ * hash, unless its mtime is within a second of the cache's own write time:
+ * on filesystems with coarse timestamps it may have changed again in that
+ * second without its mtime moving. Unknown or malformed lines (and version
+ * 1 caches, which kept whole-second mtimes) are skipped, which only costs
+ * a rehash. */
+
+#define HASH_CACHE_HEADER "openbc-hash-cache 2"
+#define HASH_CACHE_RACY_NS 1000000000LL
+
+typedef struct {
+    const char *rel;
+    u64         size;
+    i64         mtime;
+    i64         ctime;
+    u64         ino;
+    u32         hash;
+} cache_entry_t;
+
+typedef struct {
+    char          *text;      /* file contents; rel strings point into it */
+    cache_entry_t *entries;   /* sorted by rel */
+    int            count, cap;
+    i64            written;   /* the cache file's own mtime, ns */
+} hash_cache_t;
+
+static int cache_entry_cmp(const void *a, const void *b)
+{
+    return strcmp(((const cache_entry_t *)a)->rel,
+                  ((const cache_entry_t *)b)->rel);
+}
+
+static void hash_cache_load(hash_cache_t *c, const char *path)
+{
+    memset(c, 0, sizeof(*c));
+    c->text = read_file(path, NULL);
+    if (!c->text) return;
+
+    struct stat st;
+    if (stat(path, &st) == 0) {
+        i64 ctime;
+        u64 ino;
+        stat_stamps(path, &st, &c->written, &ctime, &ino);
+    }
+
+    char *line = c->text;
+    char *nl = strchr(line, '\n');
+    if (!nl || (size_t)(nl - line) != strlen(HASH_CACHE_HEADER) ||
+        strncmp(line, HASH_CACHE_HEADER, strlen(HASH_CACHE_HEADER)) != 0) {
+        fprintf(stderr, "Warning: ignoring unrecognized cache '%s'\n", path);
+        return;
+    }
+
+    for (line = nl + 1; *line; line = nl + 1) {
+        nl = strchr(line, '\n');
+        if (!nl) break;               /* truncated last line */
+        *nl = '\0';
+
+        char *end;
+        unsigned long h = strtoul(line, &end, 16);
+        if (*end != ' ') continue;
+        unsigned long long size = strtoull(end + 1, &end, 10);
+        if (*end != ' ') continue;
+        long long mtime = strtoll(end + 1, &end, 10);
+        if (*end != ' ') continue;
+        long long ctime = strtoll(end + 1, &end, 10);
+        if (*end != ' ') continue;
+        unsigned long long ino = strtoull(end + 1, &end, 10);
+        if (*end != ' ' || end[1] == '\0') continue;
+
+        if (c->count == c->cap)
+            c->entries = grow(c->entries, &c->cap, sizeof(*c->entries));
+        cache_entry_t *e = &c->entries[c->count++];
+        e->rel = end + 1;
+        e->size = (u64)size;
+        e->mtime = (i64)mtime;
+        e->ctime = (i64)ctime;
+        e->ino = (u64)ino;
+        e->hash = (u32)h;
+    }
+    if (c->count > 0)
+        qsort(c->entries, (size_t)c->count, sizeof(*c->entries), cache_entry_cmp);
+}
+
+static void hash_cache_free(hash_cache_t *c)
+{
+    free(c->entries);
+    free(c->text);
+    memset(c, 0, sizeof(*c));
+}
+
+/* Take hashes for unchanged files from the cache. Returns how many hit. */
+static int hash_cache_apply(const hash_cache_t *c, scan_t *s)
+{
+    int hits = 0;
+    for (int i = 0; i < s->file_count && c->count > 0; i++) {
+        scan_file_t *f = &s->files[i];
+        cache_entry_t key = { .rel = f->rel };
+        const cache_entry_t *e = bsearch(&key, c->entries, (size_t)c->count,
+                                         sizeof(*c->entries), cache_entry_cmp);
+        if (e && e->size == f->size && e->mtime == f->mtime &&
+            e->ctime == f->ctime && e->ino == f->ino &&
+            f->mtime < c->written - HASH_CACHE_RACY_NS) {
+            f->hash = e->hash;
+            f->ok = true;
+            f->cached = true;
+            hits++;
+        }
+    }
+    return hits;
 }
 
+static bool hash_cache_write(const scan_t *s, const char *path)
+{
+    FILE *fp = fopen(path, "w");
+    if (!fp) return false;
+    fprintf(fp, "%s\n", HASH_CACHE_HEADER);
+    for (int i = 0; i < s->file_count; i++) {
+        const scan_file_t *f = &s->files[i];
+        if (!f->ok || strchr(f->rel, '\n')) continue;
+        fprintf(fp, "%08X %llu %lld %lld %llu %s\n", f->hash,
+                (unsigned long long)f->size, (long long)f->mtime,
+                (long long)f->ctime, (unsigned long long)f->ino, f->rel);
+    }
+    return fclose(fp) == 0;
+}
+
+/* --- Parallel hashing --- */
+
+typedef struct {
+    scan_t     *scan;
+    int        *todo;        /* indices into scan->files still to hash */
+    int         todo_count;
+    atomic_int  next;
+} hash_work_t;
+
+static void hash_worker(hash_work_t *hw)
+{
+    for (;;) {
+        int i = atomic_fetch_add(&hw->next, 1);
+        if (i >= hw->todo_count) break;
+        scan_file_t *f = &hw->scan->files[hw->todo[i]];
+        f->hash = hash_path(f->path, &f->ok);
+    }
+}
+
+#ifdef _WIN32
+typedef HANDLE hash_thread_t;
+static DWORD WINAPI hash_thread_main(LPVOID arg)
+{
+    hash_worker((hash_work_t *)arg);
+    return 0;
+}
+#else
+typedef pthread_t hash_thread_t;
+static void *hash_thread_main(void *arg)
+{
+    hash_worker((hash_work_t *)arg);
+    return NULL;
+}
+#endif
+
+static int cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+/* Hash every file not already taken from the cache, on up to `threads`
+ * threads (the calling thread included). */
+static void hash_scan(scan_t *s, int threads)
+{
+    hash_work_t hw = { .scan = s };
+    hw.todo = malloc((size_t)(s->file_count ? s->file_count : 1) * sizeof(int));
+    if (!hw.todo) {
+        fprintf(stderr, "Error: out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < s->file_count; i++)
+        if (!s->files[i].cached) hw.todo[hw.todo_count++] = i;
+    atomic_init(&hw.next, 0);
+
+    if (threads > hw.todo_count) threads = hw.todo_count;
+    if (threads > MAX_HASH_THREADS) threads = MAX_HASH_THREADS;
+
+    hash_thread_t tids[MAX_HASH_THREADS];
+    int started = 0;
+    for (int i = 1; i < threads; i++) {
+#ifdef _WIN32
+        tids[started] = CreateThread(NULL, 0, hash_thread_main, &hw, 0, NULL);
+        if (!tids[started]) break;
+#else
+        if (pthread_create(&tids[started], NULL, hash_thread_main, &hw) != 0)
+            break;
+#endif
+        started++;
+    }
+
+    /* The calling thread works too; it finishes the queue alone if no
+     * worker could start. */
+    hash_worker(&hw);
+
+    for (int i = 0; i < started; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(tids[i], INFINITE);
+        CloseHandle(tids[i]);
+#else
+        pthread_join(tids[i], NULL);
+#endif
+    }
+    free(hw.todo);
+}
 /* --- Command implementations --- */
 
 static int cmd_hash_string(int argc, char **argv)
@@ -239,7 +727,7 @@ static int cmd_hash_file(int argc, char **argv)
         return 1;
     }
     bool ok;
-    u32 h = file_hash_from_path(argv[0], &ok);
+    u32 h = hash_path(argv[0], &ok);
     if (!ok) {
         fprintf(stderr, "Error: could not read file '%s'\n", argv[0]);
         return 1;
@@ -252,10 +740,17 @@ static int cmd_generate(int argc, char **argv)
 {
     const char *game_dir = NULL;
     const char *output   = NULL;
+    int  threads     = cpu_count();
+    bool incremental = false;
 
     for (int i = 0; i < argc; i++) {
         if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
             output = argv[++i];
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            if (threads < 1) threads = 1;
+        } else if (strcmp(argv[i], "--incremental") == 0) {
+            incremental = true;
         } else if (!game_dir) {
             game_dir = argv[i];
         }
@@ -266,9 +761,33 @@ static int cmd_generate(int argc, char **argv)
         return 1;
     }
 
+    /* Scan all checksum directories, then hash everything at once */
+    scan_t scan = { .root_len = strlen(game_dir) + 1 };
+    int roots[NUM_CHECKSUM_DIRS];
+    for (int i = 0; i < NUM_CHECKSUM_DIRS; i++) {
+        const checksum_dir_t *cd = &CHECKSUM_DIRS[i];
+        char dirpath[1024];
+        snprintf(dirpath, sizeof(dirpath), "%s/%s", game_dir, cd->path);
+        roots[i] = scan_new_dir(&scan, NULL);
+        scan_directory(&scan, roots[i], dirpath, cd->filter, cd->recursive);
+    }
+
+    char cache_path[1040];
+    snprintf(cache_path, sizeof(cache_path), "%s.cache", output);
+    int reused = 0;
+    if (incremental) {
+        hash_cache_t cache;
+        hash_cache_load(&cache, cache_path);
+        reused = hash_cache_apply(&cache, &scan);
+        hash_cache_free(&cache);
+    }
+    hash_scan(&scan, threads);
+    hash_scan_names(&scan);
+
     FILE *fp = fopen(output, "w");
     if (!fp) {
         fprintf(stderr, "Error: cannot open '%s' for writing\n", output);
+        scan_free(&scan);
         return 1;
     }
 
@@ -293,9 +812,6 @@ static int cmd_generate(int argc, char **argv)
     for (int i = 0; i < NUM_CHECKSUM_DIRS; i++) {
         const checksum_dir_t *cd = &CHECKSUM_DIRS[i];
 
-        char dirpath[1024];
-        snprintf(dirpath, sizeof(dirpath), "%s/%s", game_dir, cd->path);
-
         /* Extract the last component of the path for dir_name_hash */
         const char *dirname = strrchr(cd->path, '/');
         dirname = dirname ? dirname + 1 : cd->path;
@@ -307,7 +823,7 @@ static int cmd_generate(int argc, char **argv)
         json_key_bool(&w, "recursive", cd->recursive);
         json_key_hex(&w, "dir_name_hash", string_hash(dirname));
 
-        hash_directory_files(&w, dirpath, cd->filter, cd->recursive);
+        write_scan_dir(&w, &scan, roots[i]);
 
         json_end_obj(&w);
     }
@@ -318,7 +834,12 @@ static int cmd_generate(int argc, char **argv)
     fprintf(fp, "\n");
     fclose(fp);
 
-    printf("Manifest written to %s\n", output);
+    if (incremental && !hash_cache_write(&scan, cache_path))
+        fprintf(stderr, "Warning: cannot write cache '%s'\n", cache_path);
+
+    printf("Manifest written to %s (%d files, %d hashed, %d unchanged)\n",
+           output, scan.file_count, scan.file_count - reused, reused);
+    scan_free(&scan);
     return 0;
 }
 
@@ -329,29 +850,6 @@ static u32 parse_hex(const char *s)
     return (u32)strtoul(s, NULL, 16);
 }
 
-/* Read an entire file into a malloc'd buffer. Sets *out_len. Returns NULL on error. */
-static char *read_file(const char *path, size_t *out_len)
-{
-    FILE *fp = fopen(path, "rb");
-    if (!fp) return NULL;
-
-    fseek(fp, 0, SEEK_END);
-    long len = ftell(fp);
-    fseek(fp, 0, SEEK_SET);
-
-    if (len < 0) { fclose(fp); return NULL; }
-
-    char *buf = malloc((size_t)len + 1);
-    if (!buf) { fclose(fp); return NULL; }
-
-    size_t read = fread(buf, 1, (size_t)len, fp);
-    fclose(fp);
-
-    buf[read] = '\0';
-    if (out_len) *out_len = read;
-    return buf;
-}
-
 /* Verify files in a manifest directory entry against disk.
  * Returns number of mismatches found. */
 static int verify_files(const json_value_t *files_arr, const char *dirpath,
@@ -372,7 +870,7 @@ static int verify_files(const json_value_t *files_arr, const char *dirpath,
         snprintf(fullpath, sizeof(fullpath), "%s/%s", dirpath, filename);
 
         bool ok;
-        u32 actual = file_hash_from_path(fullpath, &ok);
+        u32 actual = hash_path(fullpath, &ok);
         (*checked)++;
 
         if (!ok) {
@@ -427,10 +925,10 @@ static int cmd_verify(int argc, char **argv)
     }
 
     /* Parse JSON */
-    json_value_t *root = json_parse(text);
-    free(text);
+    json_value_t *root = json_parse_insitu(text);
     if (!root) {
         fprintf(stderr, "Error: failed to parse JSON from '%s'\n", manifest_path);
+        free(text);
         return 1;
     }
 
@@ -471,6 +969,7 @@ static int cmd_verify(int argc, char **argv)
     }
 
     json_free(root);
+    free(text);
 
     printf("\n=== %d files checked, %d mismatches ===\n",
            total_checked, total_mismatches);